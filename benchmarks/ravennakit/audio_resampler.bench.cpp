@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_resampler.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+#include <nanobench.h>
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("AudioResampler Benchmark") {
+    constexpr size_t k_block_size = 256;
+
+    for (const size_t num_channels : {2, 8, 64}) {
+        rav::AudioResampler resampler;
+        resampler.resize(num_channels, k_block_size, 1.01);
+        resampler.set_ratio(1.0001);
+
+        std::vector<std::vector<float>> output(num_channels, std::vector<float>(k_block_size));
+        std::vector<float*> output_channels;
+        for (auto& channel : output) {
+            output_channels.push_back(channel.data());
+        }
+
+        ankerl::nanobench::Bench b;
+        b.title(fmt::format("Resample {} channels", num_channels))
+            .warmup(10)
+            .minEpochIterations(1000)
+            .batch(k_block_size * num_channels)
+            .unit("sample");
+
+        b.run(fmt::format("{} frames", k_block_size), [&] {
+            const auto num_input_frames = resampler.get_num_input_frames_needed(k_block_size);
+            auto* const* input = resampler.prepare_input(num_input_frames);
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                std::fill_n(input[ch], num_input_frames, 0.25f);
+            }
+            resampler.process(output_channels.data(), 0, k_block_size);
+            ankerl::nanobench::doNotOptimizeAway(output[0][0]);
+        });
+    }
+}
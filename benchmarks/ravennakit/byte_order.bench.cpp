@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/byte_order.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+#include <nanobench.h>
+
+namespace {
+
+/// Compares the byte swap kernels of each supported instruction set, in place and out of place, for buffers ranging
+/// from one packet of 1 ms to a block of a file.
+void run_byte_swap_benchmark(const size_t stride) {
+    constexpr size_t k_packet_size = 48 * 2;  // Samples in 1 ms of stereo at 48 kHz
+    for (const auto num_samples : {k_packet_size, k_packet_size * 64, size_t {1024 * 1024}, size_t {4 * 1024 * 1024}}) {
+        const auto size = num_samples * stride;
+        std::vector<uint8_t> src(size, 0x5a);
+        std::vector<uint8_t> dst(size);
+
+        ankerl::nanobench::Bench b;
+        b.title(fmt::format("Swap {}-bit {} bytes", stride * 8, size))
+            .warmup(10)
+            .relative(true)
+            .minEpochIterations(size < 1024 * 1024 ? 1000 : 10)
+            .batch(size)
+            .unit("byte");
+
+        b.run("Per sample", [&] {
+            for (size_t i = 0; i < size; i += stride) {
+                for (size_t j = 0; j < stride / 2; ++j) {
+                    std::swap(dst[i + j], dst[i + stride - j - 1]);
+                }
+            }
+            ankerl::nanobench::doNotOptimizeAway(dst[0]);
+        });
+
+        for (const auto& kernels : rav::get_supported_byte_swap_kernels()) {
+            const auto swap = stride == 2 ? kernels.swap_16 : stride == 3 ? kernels.swap_24 : kernels.swap_32;
+
+            b.run(fmt::format("{} in place", kernels.name), [&] {
+                swap(dst.data(), dst.data(), size);
+                ankerl::nanobench::doNotOptimizeAway(dst[0]);
+            });
+
+            b.run(fmt::format("{} out of place", kernels.name), [&] {
+                swap(src.data(), dst.data(), size);
+                ankerl::nanobench::doNotOptimizeAway(dst[0]);
+            });
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Byte swap Benchmark") {
+    run_byte_swap_benchmark(2);
+    run_byte_swap_benchmark(3);
+    run_byte_swap_benchmark(4);
+}
@@ -0,0 +1,377 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/env.hpp"
+#include "ravennakit/core/string.hpp"
+#include "ravennakit/core/containers/byte_buffer.hpp"
+#include "ravennakit/core/net/http/http_server.hpp"
+#include "ravennakit/core/net/interfaces/network_interface_list.hpp"
+#include "ravennakit/ptp/ptp_instance.hpp"
+#include "ravennakit/ptp/messages/ptp_announce_message.hpp"
+#include "ravennakit/ptp/messages/ptp_sync_message.hpp"
+
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/json.hpp>
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t k_default_duration_ms = 10'000;
+constexpr uint64_t k_lock_timeout_ms = 20'000;
+constexpr size_t k_num_http_clients = 4;
+constexpr size_t k_http_response_items = 20'000;
+constexpr int8_t k_log_sync_interval = -3;     // 125ms
+constexpr int8_t k_log_announce_interval = 0;  // 1s
+constexpr double k_master_offset_seconds = 1000.0;  // Forces the slave to step to the timescale of the master
+constexpr uint16_t k_ptp_event_port = 319;
+constexpr uint16_t k_ptp_general_port = 320;
+
+const auto k_ptp_multicast_address = boost::asio::ip::make_address_v4("224.0.1.129");
+
+/**
+ * @return The time of the fake master, which is the monotonic host time plus an offset.
+ */
+rav::ptp::Timestamp master_now() {
+    rav::ptp::Timestamp now(rav::clock::now_monotonic_high_resolution_ns());
+    now.add_seconds(k_master_offset_seconds);
+    return now;
+}
+
+/**
+ * @param sorted_values Values sorted in ascending order.
+ * @param percentile The percentile to get [0, 100].
+ * @return The value at given percentile (nearest rank), or 0 if there are no values.
+ */
+double percentile(const std::vector<double>& sorted_values, const double percentile) {
+    if (sorted_values.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted_values.size() - 1) + 0.5);
+    return sorted_values[std::min(rank, sorted_values.size() - 1)];
+}
+
+/**
+ * @return The address of the interface to run the benchmark on, taken from RAV_PTP_BENCH_INTERFACE or otherwise the
+ * first interface with a MAC address and an IPv4 address. The PTP instance needs a MAC address for its clock identity,
+ * which rules out the loopback interface.
+ */
+std::optional<boost::asio::ip::address_v4> find_interface_address() {
+    if (const auto env = rav::get_env("RAV_PTP_BENCH_INTERFACE")) {
+        boost::system::error_code ec;
+        const auto address = boost::asio::ip::make_address_v4(*env, ec);
+        if (!ec) {
+            return address;
+        }
+    }
+    for (const auto& iface : rav::NetworkInterfaceList::get_system_interfaces().get_interfaces()) {
+        if (!iface.get_mac_address()) {
+            continue;
+        }
+        for (const auto& address : iface.get_addresses()) {
+            if (address.is_v4() && !address.is_loopback()) {
+                return address.to_v4();
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * A minimal PTP master which multicasts Announce and one-step Sync messages with multicast loopback enabled, so that a
+ * PTP instance in the same process can lock to it. It doesn't answer Delay_Req messages, so the mean path delay of the
+ * slave stays zero and the loopback delay ends up in the offset.
+ */
+class FakeMaster {
+  public:
+    explicit FakeMaster(const boost::asio::ip::address_v4& interface_address) : socket_(io_context_) {
+        socket_.open(boost::asio::ip::udp::v4());
+        socket_.set_option(boost::asio::ip::multicast::outbound_interface(interface_address));
+        socket_.set_option(boost::asio::ip::multicast::enable_loopback(true));
+
+        port_identity_.clock_identity.data = {0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01};
+        port_identity_.port_number = 1;
+    }
+
+    void send_announce() {
+        rav::ptp::AnnounceMessage announce;
+        announce.header = make_header(rav::ptp::MessageType::announce, announce_sequence_id_++, k_log_announce_interval);
+        announce.header.message_length = rav::ptp::MessageHeader::k_header_size + rav::ptp::AnnounceMessage::k_message_size;
+        announce.header.flags.ptp_timescale = true;
+        announce.origin_timestamp = master_now();
+        announce.current_utc_offset = 37;
+        announce.grandmaster_priority1 = 128;
+        announce.grandmaster_clock_quality.clock_class = 6;
+        announce.grandmaster_clock_quality.clock_accuracy = rav::ptp::ClockAccuracy::lt_100_ns;
+        announce.grandmaster_clock_quality.offset_scaled_log_variance = 0x4e5d;
+        announce.grandmaster_priority2 = 128;
+        announce.grandmaster_identity = port_identity_.clock_identity;
+        announce.time_source = rav::ptp::TimeSource::gnss;
+
+        buffer_.clear();
+        announce.write_to(buffer_);
+        socket_.send_to(boost::asio::buffer(buffer_.data(), buffer_.size()), {k_ptp_multicast_address, k_ptp_general_port});
+    }
+
+    void send_sync() {
+        rav::ptp::SyncMessage sync;
+        sync.header = make_header(rav::ptp::MessageType::sync, sync_sequence_id_++, k_log_sync_interval);
+        sync.header.message_length = rav::ptp::SyncMessage::k_message_length;
+        sync.origin_timestamp = master_now();
+
+        buffer_.clear();
+        sync.write_to(buffer_);
+        socket_.send_to(boost::asio::buffer(buffer_.data(), buffer_.size()), {k_ptp_multicast_address, k_ptp_event_port});
+    }
+
+  private:
+    boost::asio::io_context io_context_;
+    boost::asio::ip::udp::socket socket_;
+    rav::ptp::PortIdentity port_identity_;
+    rav::ByteBuffer buffer_ {128};
+    uint16_t announce_sequence_id_ {};
+    uint16_t sync_sequence_id_ {};
+
+    [[nodiscard]] rav::ptp::MessageHeader make_header(const rav::ptp::MessageType type, const uint16_t sequence_id, const int8_t log_interval) const {
+        rav::ptp::MessageHeader header;
+        header.message_type = type;
+        header.version = {2, 1};
+        header.source_port_identity = port_identity_;
+        header.sequence_id = sequence_id;
+        header.log_message_interval = log_interval;
+        return header;
+    }
+};
+
+/**
+ * Receives the local clock of the PTP instance, which is how the audio side of the library sees PTP time.
+ */
+class LocalClockProbe: public rav::ptp::Instance::Subscriber {};
+
+struct LoadResult {
+    bool locked {};
+    uint64_t http_requests {};
+    uint64_t duration_ns {};
+    std::vector<double> offset_errors_us;
+};
+
+/**
+ * Runs a PTP instance against the fake master, while HTTP clients load a server on the same io_context (like the NMOS
+ * API on the maintenance thread of RavennaNode). When dedicated_event_thread is true, the event messages are received
+ * on a separate io_context and thread.
+ */
+LoadResult run_ptp_under_http_load(
+    const boost::asio::ip::address_v4& interface_address, const bool dedicated_event_thread, const bool http_load, const uint64_t duration_ms
+) {
+    LoadResult result;
+
+    boost::asio::io_context io_context;
+    boost::asio::io_context event_io_context;
+    std::atomic keep_going {true};
+
+    rav::HttpServer server(io_context);
+    REQUIRE(!server.start("127.0.0.1", 0).has_error());
+    const auto endpoint = server.get_local_endpoint();
+
+    server.get("/load", [](const rav::HttpServer::Request&, rav::HttpServer::Response& response, rav::PathMatcher::Parameters&) {
+        // Mimics serializing a large NMOS resource list
+        boost::json::array array;
+        for (size_t i = 0; i < k_http_response_items; ++i) {
+            array.push_back(boost::json::object {{"id", i}, {"label", "Sender"}, {"enabled", true}});
+        }
+        response.result(boost::beast::http::status::ok);
+        response.body() = boost::json::serialize(array);
+        response.prepare_payload();
+    });
+
+    auto ptp_instance = dedicated_event_thread ? std::make_unique<rav::ptp::Instance>(io_context, event_io_context)
+                                               : std::make_unique<rav::ptp::Instance>(io_context);
+    LocalClockProbe probe;
+    REQUIRE(ptp_instance->subscribe(&probe));
+
+    try {
+        if (const auto added = ptp_instance->add_port(1, interface_address); !added) {
+            WARN("Failed to add PTP port: " << rav::ptp::to_string(added.error()));
+            return result;
+        }
+    } catch (const std::exception& e) {
+        WARN("Failed to add PTP port (binding to port 319 and 320 might need elevated privileges): " << e.what());
+        return result;
+    }
+
+    std::thread maintenance_thread([&] {
+        const auto work_guard = boost::asio::make_work_guard(io_context);
+        io_context.run();
+    });
+
+    std::thread event_thread([&] {
+        const auto work_guard = boost::asio::make_work_guard(event_io_context);
+        event_io_context.run();
+    });
+
+    std::thread master_thread([&] {
+        FakeMaster master(interface_address);
+        const auto sync_interval_ns = static_cast<uint64_t>(1'000'000'000 * std::pow(2.0, k_log_sync_interval));
+        const auto syncs_per_announce = static_cast<uint64_t>(std::pow(2.0, k_log_announce_interval - k_log_sync_interval));
+        auto next = rav::clock::now_monotonic_high_resolution_ns();
+        for (uint64_t i = 0; keep_going.load(std::memory_order_relaxed); ++i) {
+            if (i % syncs_per_announce == 0) {
+                master.send_announce();
+            }
+            master.send_sync();
+            next += sync_interval_ns;
+            if (const auto now = rav::clock::now_monotonic_high_resolution_ns(); now < next) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(next - now));
+            }
+        }
+    });
+
+    std::atomic<uint64_t> http_requests {0};
+    std::atomic measuring {false};
+    std::vector<std::thread> http_clients;
+    for (size_t i = 0; http_load && i < k_num_http_clients; ++i) {
+        http_clients.emplace_back([&] {
+            try {
+                boost::asio::io_context client_io_context;
+                boost::beast::tcp_stream stream(client_io_context);
+                stream.connect(endpoint);
+                boost::beast::http::request<boost::beast::http::empty_body> request {boost::beast::http::verb::get, "/load", 11};
+                request.set(boost::beast::http::field::host, "127.0.0.1");
+                boost::beast::flat_buffer buffer;
+                while (keep_going.load(std::memory_order_relaxed)) {
+                    boost::beast::http::write(stream, request);
+                    boost::beast::http::response<boost::beast::http::string_body> response;
+                    boost::beast::http::read(stream, buffer, response);
+                    if (measuring.load(std::memory_order_relaxed)) {
+                        http_requests.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            } catch (const std::exception& e) {
+                RAV_LOG_ERROR("HTTP client error: {}", e.what());
+            }
+        });
+    }
+
+    // Wait for the slave to lock to the master
+    const auto lock_deadline = rav::clock::now_monotonic_high_resolution_ns() + k_lock_timeout_ms * 1'000'000;
+    while (rav::clock::now_monotonic_high_resolution_ns() < lock_deadline) {
+        if (probe.get_local_clock().is_locked()) {
+            result.locked = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (result.locked) {
+        measuring.store(true, std::memory_order_relaxed);
+        const auto start = rav::clock::now_monotonic_high_resolution_ns();
+        const auto end = start + duration_ms * 1'000'000;
+        while (rav::clock::now_monotonic_high_resolution_ns() < end) {
+            const auto& local_clock = probe.get_local_clock();
+            const auto error = local_clock.now().to_seconds_double() - master_now().to_seconds_double();
+            result.offset_errors_us.push_back(error * 1'000'000.0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        result.duration_ns = rav::clock::now_monotonic_high_resolution_ns() - start;
+        result.http_requests = http_requests.load(std::memory_order_relaxed);
+    }
+
+    keep_going.store(false, std::memory_order_relaxed);
+    for (auto& client : http_clients) {
+        client.join();
+    }
+    master_thread.join();
+
+    io_context.stop();
+    maintenance_thread.join();
+    std::ignore = ptp_instance->unsubscribe(&probe);
+    ptp_instance.reset();
+
+    event_io_context.stop();
+    event_thread.join();
+
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("PTP offset under HTTP load", "[ptp]") {
+    const auto interface_address = find_interface_address();
+    if (!interface_address) {
+        WARN("No suitable network interface found, set RAV_PTP_BENCH_INTERFACE to the IPv4 address of an interface");
+        return;
+    }
+
+    uint64_t duration_ms = k_default_duration_ms;
+    if (const auto env = rav::get_env("RAV_PTP_BENCH_DURATION_MS")) {
+        duration_ms = rav::string_to_int<uint64_t>(*env).value_or(k_default_duration_ms);
+    }
+
+    fmt::println(
+        "| {:>10} | {:>9} | {:>8} | {:>11} | {:>11} | {:>11} | {:>11} |", "event recv", "http load", "req/s", "offset us",
+        "dev p50 us", "dev p99 us", "dev max us"
+    );
+
+    for (const auto dedicated_event_thread : {false, true}) {
+        for (const auto http_load : {false, true}) {
+            auto result = run_ptp_under_http_load(*interface_address, dedicated_event_thread, http_load, duration_ms);
+            const auto* mode = dedicated_event_thread ? "dedicated" : "shared";
+
+            if (!result.locked) {
+                fmt::println("| {:>10} | {:>9} | {:>8} | PTP did not lock |", mode, http_load ? "yes" : "no", "-");
+                continue;
+            }
+
+            double mean = 0.0;
+            for (const auto error : result.offset_errors_us) {
+                mean += error;
+            }
+            mean /= static_cast<double>(std::max<size_t>(result.offset_errors_us.size(), 1));
+
+            // Deviation from the mean, since the mean contains the uncompensated loopback delay
+            std::vector<double> deviations;
+            deviations.reserve(result.offset_errors_us.size());
+            for (const auto error : result.offset_errors_us) {
+                deviations.push_back(std::fabs(error - mean));
+            }
+            std::sort(deviations.begin(), deviations.end());
+
+            const auto duration_s = static_cast<double>(result.duration_ns) / 1'000'000'000.0;
+            fmt::println(
+                "| {:>10} | {:>9} | {:>8.1f} | {:>11.1f} | {:>11.1f} | {:>11.1f} | {:>11.1f} |", mode, http_load ? "yes" : "no",
+                static_cast<double>(result.http_requests) / duration_s, mean, percentile(deviations, 50.0), percentile(deviations, 99.0),
+                deviations.empty() ? 0.0 : deviations.back()
+            );
+        }
+    }
+}
@@ -0,0 +1,454 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/env.hpp"
+#include "ravennakit/core/string.hpp"
+#include "ravennakit/core/audio/audio_buffer.hpp"
+#include "ravennakit/core/platform/thread_affinity.hpp"
+#include "ravennakit/rtp/detail/rtp_audio_receiver.hpp"
+#include "ravennakit/rtp/detail/rtp_audio_sender.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#if RAV_WINDOWS
+    #include <windows.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t k_sample_rate = 48'000;
+constexpr uint32_t k_num_channels = 2;
+constexpr uint16_t k_base_port = 5004;
+constexpr uint64_t k_default_duration_ms = 1000;
+constexpr uint64_t k_warmup_ms = 250;
+
+/**
+ * @return The CPU time consumed by the calling thread in nanoseconds, or 0 if not supported on this platform.
+ */
+uint64_t thread_cpu_time_ns() {
+#if RAV_POSIX
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+#elif RAV_WINDOWS
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        return 0;
+    }
+    const auto to_ns = [](const FILETIME& ft) {
+        return ((static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime) * 100;
+    };
+    return to_ns(kernel_time) + to_ns(user_time);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @param sorted_values Values sorted in ascending order.
+ * @param percentile The percentile to get [0, 100].
+ * @return The value at given percentile (nearest rank), or 0 if there are no values.
+ */
+double percentile(const std::vector<double>& sorted_values, const double percentile) {
+    if (sorted_values.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted_values.size() - 1) + 0.5);
+    return sorted_values[std::min(rank, sorted_values.size() - 1)];
+}
+
+/**
+ * @return The duration of a single measurement from RAV_LOOPBACK_BENCH_DURATION_MS, or k_default_duration_ms if not set.
+ */
+uint64_t get_duration_ms() {
+    if (const auto env = rav::get_env("RAV_LOOPBACK_BENCH_DURATION_MS")) {
+        return rav::string_to_int<uint64_t>(*env).value_or(k_default_duration_ms);
+    }
+    return k_default_duration_ms;
+}
+
+struct LoopbackConfig {
+    /// The number of writers, and as many readers.
+    size_t num_streams {1};
+    /// The packet time of the streams, which is also the interval of the audio callback.
+    uint16_t packet_time_frames {48};
+    /// How long to measure, after the warmup.
+    uint64_t duration_ms {get_duration_ms()};
+    /// The number of network threads, each serving its own shard of the readers and writers.
+    size_t num_shards {1};
+    /// When true, every stream gets its own port so that the streams can be distributed over the shards.
+    bool port_per_stream {};
+    /// When true, network thread n is pinned to core n + 1, leaving core 0 for the audio thread.
+    bool pin_to_cores {};
+    /// When set, the packets are received and sent through io_uring.
+    std::optional<rav::rtp::IoUringOptions> io_uring;
+    /// When set, the packets are received from AF_PACKET rings.
+    std::optional<rav::rtp::PacketMmapOptions> packet_mmap;
+};
+
+/**
+ * @return The name of the network backend used by given config.
+ */
+const char* get_backend_name(const LoopbackConfig& config) {
+    if (config.io_uring.has_value()) {
+        return config.io_uring->sqpoll ? "io_uring sqpoll" : "io_uring";
+    }
+    if (config.packet_mmap.has_value()) {
+        return "AF_PACKET";
+    }
+    return "recvmsg";
+}
+
+struct LoopbackMeasurements {
+    bool backend_available {true};
+    uint64_t frames_received {};
+    uint64_t network_thread_cpu_ns {};
+    uint64_t network_thread_wall_ns {};
+    uint64_t duration_ns {};
+    std::vector<double> callback_durations_us;
+    std::vector<double> latencies_ms;
+};
+
+struct LoopbackResult {
+    bool backend_available {true};
+    double packets_per_second {};
+    double callback_avg_us {};
+    double callback_max_us {};
+    double network_cpu_percent {};
+    double latency_p50_ms {};
+    double latency_p99_ms {};
+    double latency_p999_ms {};
+    double latency_max_ms {};
+};
+
+LoopbackMeasurements run_loopback(const LoopbackConfig& config) {
+    const auto num_streams = config.num_streams;
+    const auto packet_time_frames = config.packet_time_frames;
+    const auto duration_ms = config.duration_ms;
+
+    boost::asio::io_context io_context;
+    rav::Id::Generator id_generator;
+
+    const auto interface_address = boost::asio::ip::address_v4::loopback();
+    const rav::rtp::AudioReceiver::ArrayOfAddresses interfaces {interface_address, {}};
+    const rav::AudioFormat audio_format {
+        rav::AudioFormat::ByteOrder::be, rav::AudioEncoding::pcm_s24, rav::AudioFormat::ChannelOrdering::interleaved, k_sample_rate,
+        k_num_channels
+    };
+
+    constexpr auto k_streams_per_instance = std::min<size_t>(
+        rav::rtp::AudioReceiver::k_max_num_readers, rav::rtp::AudioSender::k_max_num_writers
+    );
+    const auto num_instances = (num_streams + k_streams_per_instance - 1) / k_streams_per_instance;
+
+    std::vector<std::unique_ptr<rav::rtp::AudioReceiver>> receivers;
+    std::vector<std::unique_ptr<rav::rtp::AudioSender>> senders;
+    std::vector<std::pair<rav::rtp::AudioSender*, rav::Id>> writer_ids;
+    std::vector<std::pair<rav::rtp::AudioReceiver*, rav::Id>> reader_ids;
+
+    for (size_t instance = 0; instance < num_instances; ++instance) {
+        auto& receiver = receivers.emplace_back(std::make_unique<rav::rtp::AudioReceiver>(io_context));
+        auto& sender = senders.emplace_back(std::make_unique<rav::rtp::AudioSender>(io_context));
+        REQUIRE(receiver->set_num_shards(config.num_shards));
+        REQUIRE(sender->set_num_shards(config.num_shards));
+        const auto io_uring_failed =
+            config.io_uring.has_value() && (!receiver->enable_io_uring(*config.io_uring) || !sender->enable_io_uring(*config.io_uring));
+        const auto packet_mmap_failed = config.packet_mmap.has_value() && !receiver->enable_packet_mmap(*config.packet_mmap);
+        if (io_uring_failed || packet_mmap_failed) {
+            for (auto& [r, id] : reader_ids) {
+                std::ignore = r->remove_reader(id);
+            }
+            for (auto& [w, id] : writer_ids) {
+                std::ignore = w->remove_writer(id);
+            }
+            LoopbackMeasurements result;
+            result.backend_available = false;
+            return result;
+        }
+
+        for (size_t i = 0; i < k_streams_per_instance && writer_ids.size() < num_streams; ++i) {
+            const auto stream_index = static_cast<uint32_t>(writer_ids.size());
+            const auto port = static_cast<uint16_t>(k_base_port + (config.port_per_stream ? stream_index : instance) * 2);
+            const auto group = boost::asio::ip::address_v4(boost::asio::ip::make_address_v4("239.15.0.1").to_uint() + stream_index);
+
+            rav::rtp::AudioSender::WriterParameters writer_parameters;
+            writer_parameters.audio_format = audio_format;
+            writer_parameters.destinations = {rav::udp_endpoint {group, port}, {}};
+            writer_parameters.packet_time_frames = packet_time_frames;
+            writer_parameters.payload_type = 98;
+
+            const auto writer_id = id_generator.next();
+            REQUIRE(sender->add_writer(writer_id, writer_parameters, interfaces));
+
+            // The sender disables multicast loopback by default, which we need here to receive our own packets.
+            for (auto& writer : sender->writers) {
+                if (writer.id == writer_id) {
+                    for (auto& socket : writer.sockets) {
+                        socket.set_option(boost::asio::ip::multicast::enable_loopback(true));
+                    }
+                }
+            }
+
+            rav::rtp::AudioReceiver::ReaderParameters reader_parameters;
+            reader_parameters.audio_format = audio_format;
+            reader_parameters.streams[0].session = {group, port, static_cast<uint16_t>(port + 1)};
+            reader_parameters.streams[0].filter = rav::rtp::Filter(group);
+            reader_parameters.streams[0].packet_time_frames = packet_time_frames;
+
+            const auto reader_id = id_generator.next();
+            REQUIRE(receiver->add_reader(reader_id, reader_parameters, interfaces));
+
+            writer_ids.emplace_back(sender.get(), writer_id);
+            reader_ids.emplace_back(receiver.get(), reader_id);
+        }
+    }
+
+    const auto packet_time_ns = static_cast<uint64_t>(packet_time_frames) * 1'000'000'000 / k_sample_rate;
+    const auto expected_num_callbacks = (duration_ms + k_warmup_ms) * 1'000'000 / packet_time_ns + 1;
+
+    LoopbackMeasurements result;
+    result.callback_durations_us.reserve(expected_num_callbacks);
+    result.latencies_ms.reserve(expected_num_callbacks * num_streams * 2);
+
+    std::atomic keep_going {true};
+
+    std::vector<uint64_t> network_thread_cpu_ns(config.num_shards);
+    std::vector<uint64_t> network_thread_wall_ns(config.num_shards);
+    std::vector<std::thread> network_threads;
+
+    for (size_t shard = 0; shard < config.num_shards; ++shard) {
+        network_threads.emplace_back([&, shard] {
+            if (config.pin_to_cores && !rav::set_current_thread_affinity(shard + 1)) {
+                fmt::println("Failed to pin network thread {}", shard);
+            }
+            const auto cpu_start = thread_cpu_time_ns();
+            const auto wall_start = rav::clock::now_monotonic_high_resolution_ns();
+            while (keep_going.load(std::memory_order_relaxed)) {
+                for (auto& receiver : receivers) {
+                    receiver->read_incoming_packets(shard);
+                }
+                for (auto& sender : senders) {
+                    sender->send_outgoing_packets(shard);
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(10));  // Same as RavennaNode
+            }
+            network_thread_cpu_ns[shard] = thread_cpu_time_ns() - cpu_start;
+            network_thread_wall_ns[shard] = rav::clock::now_monotonic_high_resolution_ns() - wall_start;
+        });
+    }
+
+    rav::AudioBuffer<float> input_buffer(k_num_channels, packet_time_frames, 0.25f);
+    rav::AudioBuffer<float> output_buffer(k_num_channels, packet_time_frames);
+
+    const auto start = rav::clock::now_monotonic_high_resolution_ns();
+    const auto measure_from = start + k_warmup_ms * 1'000'000;
+    const auto end = measure_from + duration_ms * 1'000'000;
+    uint64_t frame_position = 0;
+
+    while (true) {
+        frame_position += packet_time_frames;
+        const auto callback_time = start + frame_position * 1'000'000'000 / k_sample_rate;
+        if (const auto now = rav::clock::now_monotonic_high_resolution_ns(); now < callback_time) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(callback_time - now));
+        }
+
+        const auto callback_start = rav::clock::now_monotonic_high_resolution_ns();
+        if (callback_start >= end) {
+            break;
+        }
+        const auto measuring = callback_start >= measure_from;
+
+        // Send the block which just completed
+        const auto send_ts = static_cast<uint32_t>(frame_position - packet_time_frames);
+        for (auto& [sender, id] : writer_ids) {
+            std::ignore = sender->send_audio_data_realtime(id, input_buffer.const_view(), send_ts);
+        }
+
+        // Read everything which is available
+        for (auto& [receiver, id] : reader_ids) {
+            while (const auto read_ts = receiver->read_audio_data_realtime(id, output_buffer, std::nullopt, 0u)) {
+                if (!measuring) {
+                    continue;
+                }
+                const auto now = rav::clock::now_monotonic_high_resolution_ns();
+                const auto block_end_time = start + (static_cast<uint64_t>(*read_ts) + packet_time_frames) * 1'000'000'000 / k_sample_rate;
+                result.latencies_ms.push_back(static_cast<double>(static_cast<int64_t>(now - block_end_time)) / 1'000'000.0);
+                result.frames_received += packet_time_frames;
+            }
+        }
+
+        if (measuring) {
+            const auto callback_end = rav::clock::now_monotonic_high_resolution_ns();
+            result.callback_durations_us.push_back(static_cast<double>(callback_end - callback_start) / 1'000.0);
+        }
+    }
+
+    result.duration_ns = rav::clock::now_monotonic_high_resolution_ns() - measure_from;
+    keep_going.store(false, std::memory_order_relaxed);
+    for (size_t shard = 0; shard < config.num_shards; ++shard) {
+        network_threads[shard].join();
+        result.network_thread_cpu_ns += network_thread_cpu_ns[shard];
+        result.network_thread_wall_ns = std::max(result.network_thread_wall_ns, network_thread_wall_ns[shard]);
+    }
+
+    for (auto& [receiver, id] : reader_ids) {
+        std::ignore = receiver->remove_reader(id);
+    }
+    for (auto& [sender, id] : writer_ids) {
+        std::ignore = sender->remove_writer(id);
+    }
+
+    return result;
+}
+
+/**
+ * Runs the loopback with given config and summarizes the measurements.
+ */
+LoopbackResult benchmark_loopback(const LoopbackConfig& config) {
+    auto measurements = run_loopback(config);
+
+    LoopbackResult result;
+    result.backend_available = measurements.backend_available;
+    if (!result.backend_available) {
+        return result;
+    }
+
+    auto& callback_durations_us = measurements.callback_durations_us;
+    auto& latencies_ms = measurements.latencies_ms;
+    std::sort(callback_durations_us.begin(), callback_durations_us.end());
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+
+    if (!callback_durations_us.empty()) {
+        double total_us = 0.0;
+        for (const auto d : callback_durations_us) {
+            total_us += d;
+        }
+        result.callback_avg_us = total_us / static_cast<double>(callback_durations_us.size());
+        result.callback_max_us = callback_durations_us.back();
+    }
+
+    const auto duration_s = static_cast<double>(measurements.duration_ns) / 1'000'000'000.0;
+    result.packets_per_second = static_cast<double>(measurements.frames_received / config.packet_time_frames) / duration_s;
+    result.network_cpu_percent = static_cast<double>(measurements.network_thread_cpu_ns) /
+        static_cast<double>(std::max<uint64_t>(measurements.network_thread_wall_ns, 1)) * 100.0;
+    result.latency_p50_ms = percentile(latencies_ms, 50.0);
+    result.latency_p99_ms = percentile(latencies_ms, 99.0);
+    result.latency_p999_ms = percentile(latencies_ms, 99.9);
+    result.latency_max_ms = latencies_ms.empty() ? 0.0 : latencies_ms.back();
+    return result;
+}
+
+void print_result_header() {
+    fmt::println(
+        "| {:>15} | {:>6} | {:>7} | {:>8} | {:>10} | {:>10} | {:>10} | {:>8} | {:>8} | {:>8} | {:>9} | {:>8} |", "backend", "shards",
+        "streams", "ptime us", "packets/s", "cb avg us", "cb max us", "net cpu%", "lat p50", "lat p99", "lat p99.9", "lat max"
+    );
+}
+
+void print_result(const LoopbackConfig& config, const LoopbackResult& result) {
+    if (!result.backend_available) {
+        fmt::println("| {:>15} | {:>6} | {:>7} | not available", get_backend_name(config), config.num_shards, config.num_streams);
+        return;
+    }
+    fmt::println(
+        "| {:>15} | {:>6} | {:>7} | {:>8} | {:>10.0f} | {:>10.2f} | {:>10.2f} | {:>8.1f} | {:>8.3f} | {:>8.3f} | {:>9.3f} | {:>8.3f} |",
+        get_backend_name(config), config.num_shards, config.num_streams, config.packet_time_frames * 1'000'000 / k_sample_rate,
+        result.packets_per_second, result.callback_avg_us, result.callback_max_us, result.network_cpu_percent, result.latency_p50_ms,
+        result.latency_p99_ms, result.latency_p999_ms, result.latency_max_ms
+    );
+}
+
+}  // namespace
+
+TEST_CASE("AudioSender to AudioReceiver Loopback Benchmark", "[loopback]") {
+    const std::vector<size_t> stream_counts {1, 16, 64, 256};
+    const std::vector<uint16_t> packet_times_frames {6, 12, 24, 48, 96, 192};  // 125us .. 4ms at 48kHz
+
+    print_result_header();
+
+    for (const auto num_streams : stream_counts) {
+        for (const auto packet_time_frames : packet_times_frames) {
+            LoopbackConfig config;
+            config.num_streams = num_streams;
+            config.packet_time_frames = packet_time_frames;
+            print_result(config, benchmark_loopback(config));
+        }
+    }
+}
+
+TEST_CASE("AudioSender to AudioReceiver Sharded Loopback Benchmark", "[loopback]") {
+    // Leave one core for the audio thread
+    const auto max_num_shards = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, rav::rtp::AudioReceiver::k_max_num_shards + 1) - 1;
+
+    print_result_header();
+
+    for (size_t num_shards = 1; num_shards <= max_num_shards; num_shards *= 2) {
+        LoopbackConfig config;
+        config.num_streams = 128;
+        config.packet_time_frames = 6;  // 125us at 48kHz
+        config.num_shards = num_shards;
+        config.port_per_stream = true;
+        config.pin_to_cores = true;
+        print_result(config, benchmark_loopback(config));
+    }
+}
+
+TEST_CASE("AudioSender to AudioReceiver Network Backend Loopback Benchmark", "[loopback]") {
+    const std::vector<size_t> stream_counts {1, 16, 64};
+
+    rav::rtp::IoUringOptions sqpoll;
+    sqpoll.sqpoll = true;
+
+    struct Backend {
+        std::optional<rav::rtp::IoUringOptions> io_uring;
+        std::optional<rav::rtp::PacketMmapOptions> packet_mmap;
+    };
+
+    const std::vector<Backend> backends {
+        {std::nullopt, std::nullopt},
+        {rav::rtp::IoUringOptions {}, std::nullopt},
+        {sqpoll, std::nullopt},
+        {std::nullopt, rav::rtp::PacketMmapOptions {}},
+    };
+
+    print_result_header();
+
+    for (const auto num_streams : stream_counts) {
+        for (const auto& [io_uring, packet_mmap] : backends) {
+            LoopbackConfig config;
+            config.num_streams = num_streams;
+            config.packet_time_frames = 6;  // 125us at 48kHz
+            config.io_uring = io_uring;
+            config.packet_mmap = packet_mmap;
+            print_result(config, benchmark_loopback(config));
+        }
+    }
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_audio_pipeline.hpp"
+#include "ravennakit/core/audio/audio_buffer.hpp"
+#include "ravennakit/core/audio/audio_data.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+#include <nanobench.h>
+
+namespace {
+
+/// Compares the runtime dispatched conversion of AudioData with the generic and specialized pipelines, for one packet
+/// of 1 ms.
+template<class T>
+void run_pipeline_benchmark(const rav::AudioEncoding encoding, const char* encoding_name) {
+    for (const auto sample_rate : {48000u, 96000u}) {
+        for (const auto num_channels : rav::rtp::AudioPipeline::k_specialized_num_channels) {
+            const rav::AudioFormat format {
+                rav::AudioFormat::ByteOrder::be, encoding, rav::AudioFormat::ChannelOrdering::interleaved, sample_rate, num_channels
+            };
+            const size_t num_frames = sample_rate / 1000;
+
+            std::vector<uint8_t> payload(num_frames * format.bytes_per_frame());
+            rav::AudioBuffer<float> audio(num_channels, num_frames, 0.5f);
+
+            const auto generic = rav::rtp::AudioPipeline::get_generic(format);
+            const auto specialized = rav::rtp::AudioPipeline::get(format);
+            REQUIRE(specialized.specialized);
+
+            ankerl::nanobench::Bench b;
+            b.title(fmt::format("{} {}ch {}Hz", encoding_name, num_channels, sample_rate))
+                .warmup(100)
+                .relative(true)
+                .minEpochIterations(1000)
+                .batch(num_frames * num_channels)
+                .unit("sample");
+
+            b.run("Decode AudioData", [&] {
+                rav::AudioData::convert<T, rav::AudioData::ByteOrder::Be, rav::AudioData::Interleaving::Interleaved, float, rav::AudioData::ByteOrder::Ne>(
+                    reinterpret_cast<const T*>(payload.data()), num_frames, num_channels, audio.data()
+                );
+                ankerl::nanobench::doNotOptimizeAway(audio[0][0]);
+            });
+
+            b.run("Decode generic", [&] {
+                generic.decode(payload.data(), num_frames, num_channels, audio.data());
+                ankerl::nanobench::doNotOptimizeAway(audio[0][0]);
+            });
+
+            b.run("Decode specialized", [&] {
+                specialized.decode(payload.data(), num_frames, num_channels, audio.data());
+                ankerl::nanobench::doNotOptimizeAway(audio[0][0]);
+            });
+
+            b.run("Encode AudioData", [&] {
+                rav::AudioData::convert<float, rav::AudioData::ByteOrder::Ne, T, rav::AudioData::ByteOrder::Be, rav::AudioData::Interleaving::Interleaved>(
+                    audio.data(), num_frames, num_channels, reinterpret_cast<T*>(payload.data()), 0, 0
+                );
+                ankerl::nanobench::doNotOptimizeAway(payload[0]);
+            });
+
+            b.run("Encode generic", [&] {
+                generic.encode(audio.data(), num_frames, num_channels, payload.data());
+                ankerl::nanobench::doNotOptimizeAway(payload[0]);
+            });
+
+            b.run("Encode specialized", [&] {
+                specialized.encode(audio.data(), num_frames, num_channels, payload.data());
+                ankerl::nanobench::doNotOptimizeAway(payload[0]);
+            });
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("AudioPipeline Benchmark") {
+    run_pipeline_benchmark<int16_t>(rav::AudioEncoding::pcm_s16, "L16");
+    run_pipeline_benchmark<rav::int24_t>(rav::AudioEncoding::pcm_s24, "L24");
+}
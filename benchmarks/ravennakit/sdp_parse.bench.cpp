@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/sdp/sdp_session_description.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+
+namespace {
+
+constexpr auto k_ravenna_sdp =
+    "v=0\r\n"
+    "o=- 13 0 IN IP4 192.168.15.52\r\n"
+    "s=Anubis_610120_13\r\n"
+    "c=IN IP4 239.1.15.52/15\r\n"
+    "t=0 0\r\n"
+    "a=group:DUP primary secondary\r\n"
+    "a=clock-domain:PTPv2 0\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-51-9E-F7:0\r\n"
+    "a=mediaclk:direct=0\r\n"
+    "m=audio 5004 RTP/AVP 98\r\n"
+    "c=IN IP4 239.1.15.52/15\r\n"
+    "a=rtpmap:98 L24/48000/8\r\n"
+    "a=source-filter: incl IN IP4 239.1.15.52 192.168.15.52\r\n"
+    "a=clock-domain:PTPv2 0\r\n"
+    "a=sync-time:0\r\n"
+    "a=framecount:48\r\n"
+    "a=palign:0\r\n"
+    "a=ptime:1\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-51-9E-F7:0\r\n"
+    "a=mediaclk:direct=0\r\n"
+    "a=mid:primary\r\n"
+    "a=recvonly\r\n"
+    "m=audio 5004 RTP/AVP 98\r\n"
+    "c=IN IP4 239.2.15.52/15\r\n"
+    "a=rtpmap:98 L24/48000/8\r\n"
+    "a=source-filter: incl IN IP4 239.2.15.52 192.168.16.52\r\n"
+    "a=clock-domain:PTPv2 0\r\n"
+    "a=sync-time:0\r\n"
+    "a=framecount:48\r\n"
+    "a=ptime:1\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-51-9E-F7:0\r\n"
+    "a=mediaclk:direct=0\r\n"
+    "a=mid:secondary\r\n"
+    "a=recvonly\r\n";
+
+constexpr auto k_dante_sdp =
+    "v=0\r\n"
+    "o=- 1423986 1423994 IN IP4 169.254.98.63\r\n"
+    "s=AOIP44-serial-1614 : 2\r\n"
+    "c=IN IP4 239.65.125.63/32\r\n"
+    "t=0 0\r\n"
+    "a=keywds:Dante\r\n"
+    "m=audio 5004 RTP/AVP 97\r\n"
+    "i=2 channels: TxChan 0, TxChan 1\r\n"
+    "a=recvonly\r\n"
+    "a=rtpmap:97 L24/48000/2\r\n"
+    "a=ptime:1\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-0E-10-C4:0\r\n"
+    "a=mediaclk:direct=2216659908\r\n";
+
+void run_sdp_parse_benchmark(ankerl::nanobench::Bench& b, const char* name, const char* sdp_text) {
+    b.run(fmt::format("{}: parse_session_description", name), [&] {
+        auto result = rav::sdp::parse_session_description(sdp_text);
+        ankerl::nanobench::doNotOptimizeAway(result);
+    });
+
+    b.run(fmt::format("{}: parse_session_description_view", name), [&] {
+        auto result = rav::sdp::parse_session_description_view(sdp_text);
+        ankerl::nanobench::doNotOptimizeAway(result);
+    });
+}
+
+}  // namespace
+
+TEST_CASE("SDP parse Benchmark") {
+    REQUIRE(rav::sdp::parse_session_description_view(k_ravenna_sdp));
+    REQUIRE(rav::sdp::parse_session_description_view(k_dante_sdp));
+
+    ankerl::nanobench::Bench b;
+    b.title("SDP parse Benchmark").warmup(100).relative(false).minEpochIterations(5000).performanceCounters(true);
+
+    run_sdp_parse_benchmark(b, "RAVENNA", k_ravenna_sdp);
+    run_sdp_parse_benchmark(b, "Dante", k_dante_sdp);
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/random.hpp"
+#include "ravennakit/rtp/rtp_shared_audio_buffer.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+#include <nanobench.h>
+
+#include <algorithm>
+#include <vector>
+
+#if RAV_POSIX
+
+    #include <csignal>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+namespace {
+
+/// Copies every block which appears in the ping buffer to the pong buffer, like a process reading from a receiver and
+/// feeding a sender.
+[[noreturn]] void run_echo_process(const std::string& ping_name, const std::string& pong_name, const size_t block_size_bytes) {
+    auto ping = rav::rtp::SharedAudioBuffer::open(ping_name);
+    auto pong = rav::rtp::SharedAudioBuffer::open(pong_name);
+    if (ping == nullptr || pong == nullptr) {
+        _exit(1);
+    }
+
+    const auto bytes_per_frame = ping->get_audio_format().bytes_per_frame();
+    const auto block_size_frames = static_cast<uint32_t>(block_size_bytes / bytes_per_frame);
+    std::vector<uint8_t> block(block_size_bytes);
+    std::optional<rav::rtp::SharedAudioBuffer::Position> last_position;
+
+    while (true) {
+        const auto position = ping->get_write_position();
+        if (!position || position == last_position) {
+            continue;  // Spins, like an audio thread polling for the next block
+        }
+        last_position = position;
+        const auto timestamp = position->end_timestamp - block_size_frames;
+        if (ping->read(timestamp, block.data(), block.size())) {
+            pong->write(timestamp, rav::BufferView(block.data(), block.size()).const_view());
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("SharedAudioBuffer Benchmark") {
+    constexpr uint32_t k_block_size_frames = 48;
+
+    const rav::AudioFormat audio_format {
+        rav::AudioFormat::ByteOrder::be, rav::AudioEncoding::pcm_s24, rav::AudioFormat::ChannelOrdering::interleaved, 48000, 8,
+    };
+    const auto block_size_bytes = k_block_size_frames * audio_format.bytes_per_frame();
+    std::vector<uint8_t> block(block_size_bytes, 0x55);
+
+    SECTION("Write and read in one process") {
+        const auto name = fmt::format("ravennakit_bench_{}", rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+        auto buffer = rav::rtp::SharedAudioBuffer::create(name, audio_format, 4800);
+        REQUIRE(buffer != nullptr);
+        auto client = rav::rtp::SharedAudioBuffer::open(name);
+        REQUIRE(client != nullptr);
+        std::vector<uint8_t> output(block_size_bytes);
+
+        uint32_t timestamp = 0;
+        ankerl::nanobench::Bench b;
+        b.title("SharedAudioBuffer").warmup(100).minEpochIterations(100'000).batch(k_block_size_frames).unit("frame");
+        b.run(fmt::format("write and read {} frames of {} channels", k_block_size_frames, audio_format.num_channels), [&] {
+            buffer->write(timestamp, rav::BufferView(block.data(), block.size()).const_view());
+            ankerl::nanobench::doNotOptimizeAway(client->read(timestamp, output.data(), output.size()));
+            timestamp += k_block_size_frames;
+        });
+    }
+
+    SECTION("Round trip through another process") {
+        const auto name = fmt::format("ravennakit_bench_{}", rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+        auto ping = rav::rtp::SharedAudioBuffer::create(name + "_ping", audio_format, 4800);
+        auto pong = rav::rtp::SharedAudioBuffer::create(name + "_pong", audio_format, 4800);
+        REQUIRE(ping != nullptr);
+        REQUIRE(pong != nullptr);
+
+        const auto pid = fork();
+        REQUIRE(pid >= 0);
+        if (pid == 0) {
+            run_echo_process(ping->get_name(), pong->get_name(), block_size_bytes);
+        }
+
+        std::vector<uint64_t> one_way_ns;
+        one_way_ns.reserve(1'000'000);
+        uint32_t timestamp = 0;
+
+        ankerl::nanobench::Bench b;
+        b.title("SharedAudioBuffer across processes").warmup(100).minEpochIterations(10'000);
+        b.run(fmt::format("round trip of {} frames of {} channels", k_block_size_frames, audio_format.num_channels), [&] {
+            ping->write(timestamp, rav::BufferView(block.data(), block.size()).const_view());
+            timestamp += k_block_size_frames;
+            while (true) {
+                const auto position = pong->get_write_position();
+                if (position && position->end_timestamp == timestamp) {
+                    break;
+                }
+            }
+            one_way_ns.push_back(pong->get_write_time_ns() - ping->get_write_time_ns());
+        });
+
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+
+        std::sort(one_way_ns.begin(), one_way_ns.end());
+        const auto percentile = [&one_way_ns](const double p) {
+            return one_way_ns[std::min(one_way_ns.size() - 1, static_cast<size_t>(p * static_cast<double>(one_way_ns.size())))];
+        };
+        fmt::println(
+            "One way latency (write to write of the other process) over {} blocks: p50 {} ns, p99 {} ns, p99.9 {} ns, max {} ns",
+            one_way_ns.size(), percentile(0.5), percentile(0.99), percentile(0.999), one_way_ns.back()
+        );
+    }
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "ravennakit/ravenna/ravenna_sender.hpp"
 #include "ravennakit/rtp/detail/rtp_sender.hpp"
 #include "ravennakit/rtsp/rtsp_server.hpp"
+#include "ravennakit/core/util/tracy.hpp"
 
 #include <CLI/App.hpp>
 
@@ -141,6 +142,8 @@ int main(int const argc, char* argv[]) {
 
     std::atomic keep_going = true;
     std::thread audio_thread([&]() mutable {
+        TRACY_SET_THREAD_NAME("ravenna_loopback_audio");
+
         while (keep_going.load(std::memory_order_relaxed)) {
             if (!ptp_subscriber.get_local_clock().is_calibrated()) {
                 std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -25,9 +25,8 @@
 #include "ravennakit/core/file.hpp"
 #include "ravennakit/core/log.hpp"
 #include "ravennakit/core/system.hpp"
-#include "ravennakit/core/audio/formats/wav_audio_format.hpp"
+#include "ravennakit/core/audio/audio_playout.hpp"
 #include "ravennakit/core/platform/apple/priority.hpp"
-#include "ravennakit/core/streams/file_input_stream.hpp"
 #include "ravennakit/dnssd/dnssd_advertiser.hpp"
 #include "ravennakit/ptp/ptp_instance.hpp"
 #include "ravennakit/ravenna/ravenna_node.hpp"
@@ -40,8 +39,6 @@
 
 namespace examples {
 
-static constexpr uint32_t k_frames_per_read = 1024;
-
 /**
  * Holds the logic for transmitting a wav file over the network.
  */
@@ -53,15 +50,13 @@ class WavFilePlayer {
             throw std::runtime_error("File does not exist: " + file_to_play.string());
         }
 
-        auto file_input_stream = std::make_unique<rav::FileInputStream>(file_to_play);
-        auto reader = std::make_unique<rav::WavAudioFormat::Reader>(std::move(file_input_stream));
-
-        const auto format = reader->get_audio_format();
-        if (!format) {
-            throw std::runtime_error("Failed to read audio format from file: " + file_to_play.string());
+        playout_ = rav::AudioPlayout::create(file_to_play);
+        if (playout_ == nullptr) {
+            throw std::runtime_error("Failed to open file: " + file_to_play.string());
         }
+        playout_->set_looping(true);
 
-        audio_format_ = *format;
+        audio_format_ = playout_->get_audio_format();
 
         rav::RavennaSender::Configuration config;
         config.session_name = session_name;
@@ -78,9 +73,6 @@ class WavFilePlayer {
         }
         id_ = *result;
 
-        reader_ = std::move(reader);
-        audio_buffer_.resize(k_frames_per_read * audio_format_.bytes_per_frame());
-
         ravenna_node_.subscribe_to_ptp_instance(&ptp_subscriber_).wait();
     }
 
@@ -97,43 +89,17 @@ class WavFilePlayer {
         }
 
         const auto ptp_ts = clock.now().to_rtp_timestamp32(audio_format_.sample_rate);
-        // Positive means audio device is ahead of the PTP clock, negative means behind
-        const auto drift = rav::WrappingUint32(ptp_ts).diff(rav::WrappingUint32(rtp_ts_));
-
-        if (static_cast<uint32_t>(std::abs(drift)) > k_frames_per_read) {
-            rtp_ts_ = ptp_ts;
-        }
-
-        TRACY_PLOT("drift", static_cast<int64_t>(drift));
-
-        if (ptp_ts < rtp_ts_) {
-            return;  // Not yet time to send
-        }
-
-        if (reader_->remaining_audio_data() == 0) {
-            reader_->set_read_position(0);
-        }
 
-        auto result = reader_->read_audio_data(audio_buffer_.data(), audio_buffer_.size());
-        if (!result) {
-            RAV_LOG_ERROR("Failed to read audio data: {}", rav::InputStream::to_string(result.error()));
-            return;
-        }
-        const auto num_read = result.value();
-        if (num_read == 0) {
-            RAV_LOG_ERROR("No bytes read");
+        if (!playout_->is_playing()) {
+            playout_->start(ptp_ts);
         }
 
-        if (audio_format_.byte_order == rav::AudioFormat::ByteOrder::le) {
-            // Convert to big endian
-            rav::swap_bytes(audio_buffer_.data(), num_read, audio_format_.bytes_per_sample());
-        }
-
-        if (!ravenna_node_.send_data_realtime(id_, rav::BufferView(audio_buffer_.data(), num_read).const_view(), rtp_ts_)) {
-            RAV_LOG_ERROR("Failed to send audio data");
-        }
-
-        rtp_ts_ += static_cast<uint32_t>(num_read) / audio_format_.bytes_per_frame();
+        // The samples are swapped to network byte order while they are copied into the send buffer of the sender.
+        std::ignore = playout_->process(ptp_ts, [this](const rav::BufferView<const uint8_t> data, const uint32_t timestamp) {
+            if (!ravenna_node_.send_data_realtime(id_, data, timestamp, audio_format_.byte_order)) {
+                RAV_LOG_ERROR("Failed to send audio data");
+            }
+        });
     }
 
   private:
@@ -141,9 +107,7 @@ class WavFilePlayer {
     rav::ptp::Instance::Subscriber ptp_subscriber_;
     rav::Id id_;
     rav::AudioFormat audio_format_;
-    std::vector<uint8_t> audio_buffer_;
-    uint32_t rtp_ts_ {};
-    std::unique_ptr<rav::WavAudioFormat::Reader> reader_;
+    std::unique_ptr<rav::AudioPlayout> playout_;
 };
 
 }  // namespace examples
@@ -33,6 +33,8 @@
 #include <portaudio.h>
 #include <CLI/App.hpp>
 #include <boost/asio/io_context.hpp>
+#include <atomic>
+#include <thread>
 #include <utility>
 
 namespace {
@@ -189,12 +191,16 @@ class PortaudioStream {
 
 class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public rav::ptp::Instance::Subscriber {
   public:
-    explicit RavennaReceiverExample(rav::RavennaNode& ravenna_node, const std::string& stream_name, std::string audio_device_name) :
-        ravenna_node_(ravenna_node), audio_device_name_(std::move(audio_device_name)) {
+    explicit RavennaReceiverExample(
+        rav::RavennaNode& ravenna_node, const std::string& stream_name, std::string audio_device_name, const bool asrc
+    ) :
+        ravenna_node_(ravenna_node), audio_device_name_(std::move(audio_device_name)), asrc_(asrc) {
         rav::RavennaReceiver::Configuration config;
         config.enabled = true;
         config.session_name = stream_name;
-        // No need to set the delay, because RAVENNAKIT doesn't use this value
+        // The delay is only used by the ASRC, which keeps this many frames buffered
+        config.delay_frames = k_delay;
+        config.asrc = asrc;
 
         auto id = ravenna_node_.create_receiver(config).get();
         if (!id) {
@@ -204,9 +210,26 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
 
         ravenna_node_.subscribe_to_receiver(receiver_id_, this).wait();
         ravenna_node_.subscribe_to_ptp_instance(this).wait();
+
+        if (asrc_) {
+            // Not on the audio thread, since the status is queried through the maintenance thread of the node
+            asrc_status_thread_ = std::thread([this] {
+                while (keep_plotting_asrc_status_.load(std::memory_order_relaxed)) {
+                    if (const auto status = ravenna_node_.get_asrc_status(receiver_id_).get()) {
+                        TRACY_PLOT("ASRC fill", status->fill_frames);
+                        TRACY_PLOT("ASRC ratio (ppm)", status->ratio_deviation_ppm);
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            });
+        }
     }
 
     ~RavennaReceiverExample() override {
+        keep_plotting_asrc_status_.store(false, std::memory_order_relaxed);
+        if (asrc_status_thread_.joinable()) {
+            asrc_status_thread_.join();
+        }
         ravenna_node_.unsubscribe_from_ptp_instance(this).wait();
         if (receiver_id_.is_valid()) {
             ravenna_node_.unsubscribe_from_receiver(receiver_id_, this).wait();
@@ -225,7 +248,10 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
         }
 
         audio_format_ = parameters.audio_format;
-        const auto sample_format = portaudio_get_sample_format_for_audio_format(audio_format_);
+        auto sample_format = portaudio_get_sample_format_for_audio_format(audio_format_);
+        if (asrc_) {
+            sample_format = paFloat32 | paNonInterleaved;  // The format of read_audio_data_realtime
+        }
         if (!sample_format.has_value()) {
             RAV_LOG_TRACE("Skipping stream update because audio format is invalid: {}", audio_format_.to_string());
             return;
@@ -242,6 +268,21 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
     PortaudioStream portaudio_stream_;
     rav::AudioFormat audio_format_;
     rav::Id receiver_id_;
+    bool asrc_ {};
+    std::atomic<bool> keep_plotting_asrc_status_ {true};
+    std::thread asrc_status_thread_;
+
+    /**
+     * Reads through the ASRC of the receiver, which follows the clock of the audio device. No PTP clock is needed.
+     */
+    int asrc_stream_callback(void* output, const unsigned long frame_count) {
+        rav::AudioBufferView<float> buffer(static_cast<float* const*>(output), audio_format_.num_channels, frame_count);
+        if (!ravenna_node_.read_audio_data_realtime(receiver_id_, buffer, {}, {})) {
+            buffer.clear();
+        }
+
+        return paContinue;
+    }
 
     int stream_callback(
         const void* input, void* output, const unsigned long frame_count, const PaStreamCallbackTimeInfo* time_info,
@@ -253,6 +294,10 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
         std::ignore = time_info;
         std::ignore = status_flags;
 
+        if (asrc_) {
+            return asrc_stream_callback(output, frame_count);
+        }
+
         const auto buffer_size = frame_count * audio_format_.bytes_per_frame();
 
         auto& local_clock = get_local_clock();
@@ -277,7 +322,8 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
         auto drift = rav::WrappingUint32(ptp_ts).diff(rav::WrappingUint32(*rtp_ts));
 
         // If the drift becomes too big, we reset the timestamp to the current time to realign incoming data with the
-        // audio callbacks
+        // audio callbacks. Note that with the adaptive delay enabled, the returned timestamp includes the frames it
+        // skipped and repeated, which would have to be accounted for here. This example doesn't enable it.
         if (static_cast<uint32_t>(std::abs(drift)) > frame_count * 2) {
             rtp_ts = ravenna_node_.read_data_realtime(receiver_id_, static_cast<uint8_t*>(output), buffer_size, ptp_ts, {});
             RAV_LOG_WARNING("Re-aligned stream by {} samples", -drift);
@@ -308,8 +354,8 @@ class RavennaReceiverExample: public rav::RavennaReceiver::Subscriber, public ra
  * This examples demonstrates how to receive audio streams from a RAVENNA device. It sets up a RAVENNA sink that listens
  * for announcements from a RAVENNA device and starts receiving audio data. It will play the audio to the selected audio
  * device using portaudio.
- * Warning! No drift correction is done between the sender and receiver. At some point buffers will overflow or
- * underflow.
+ * Warning! Without --asrc no drift correction is done between the sender and receiver. At some point buffers will
+ * overflow or underflow. With --asrc the stream is resampled to follow the clock of the audio device.
  * Note: this examples shows custom implementation of sending streams, the easier, higher level and recommended approach
  * is to use the RavennaNode class (see ravenna_node_example).
  */
@@ -334,6 +380,9 @@ int main(int const argc, char* argv[]) {
         "The interface address to use. The value can be the identifier, display name, description, MAC or an ip address."
     );
 
+    bool asrc = false;
+    app.add_flag("--asrc", asrc, "Resample the stream to the clock of the audio device instead of aligning it to PTP");
+
     CLI11_PARSE(app, argc, argv);
 
     auto* iface = rav::NetworkInterfaceList::get_system_interfaces().find_by_string(interface);
@@ -350,7 +399,7 @@ int main(int const argc, char* argv[]) {
     rav::RavennaNode node;
     node.set_network_interface_config(network_interface_config).wait();
 
-    RavennaReceiverExample example(node, stream_name, audio_output_device);
+    RavennaReceiverExample example(node, stream_name, audio_output_device, asrc);
 
     fmt::println("Press return key to stop...");
     std::string line;
@@ -25,12 +25,12 @@
 #include "ravennakit/core/file.hpp"
 #include "ravennakit/core/log.hpp"
 #include "ravennakit/core/system.hpp"
-#include "ravennakit/core/audio/formats/wav_audio_format.hpp"
-#include "ravennakit/core/streams/file_output_stream.hpp"
+#include "ravennakit/core/audio/audio_recorder.hpp"
 #include "ravennakit/dnssd/bonjour/bonjour_browser.hpp"
 #include "ravennakit/ravenna/ravenna_node.hpp"
 #include "ravennakit/ravenna/ravenna_rtsp_client.hpp"
 #include "ravennakit/ravenna/ravenna_receiver.hpp"
+#include "ravennakit/core/util/tracy.hpp"
 
 #include <CLI/App.hpp>
 #include <boost/asio/io_context.hpp>
@@ -39,15 +39,19 @@
 namespace {
 
 /**
- * A class that is a subscriber to a RavennaReceiver and writes the audio data to a wav file.
+ * A class that is a subscriber to a RavennaReceiver and records the audio data to a wav file. The audio is handed over
+ * to the AudioRecorder, which writes the files on its own thread.
  */
 class StreamRecorder: public rav::RavennaReceiver::Subscriber {
   public:
     static constexpr auto k_delay_ms = 10;
-    static constexpr auto k_block_size = 512;  // Num frames per read/write
+    static constexpr auto k_block_size = 512;  // Num frames per read
 
-    explicit StreamRecorder(rav::RavennaNode& ravenna_node, const rav::Id receiver_id) :
-        ravenna_node_(ravenna_node), receiver_id_(receiver_id) {
+    explicit StreamRecorder(
+        rav::RavennaNode& ravenna_node, rav::AudioRecorder& audio_recorder, rav::ptp::Instance::Subscriber& ptp_subscriber,
+        const rav::Id receiver_id
+    ) :
+        ravenna_node_(ravenna_node), audio_recorder_(audio_recorder), ptp_subscriber_(ptp_subscriber), receiver_id_(receiver_id) {
         RAV_ASSERT(receiver_id.is_valid(), "Invalid id");
         ravenna_node.subscribe_to_receiver(receiver_id_, this).wait();
     }
@@ -58,17 +62,7 @@ class StreamRecorder: public rav::RavennaReceiver::Subscriber {
     }
 
     void close() {
-        const bool is_recording = wav_writer_.get() != nullptr;
-        if (wav_writer_) {
-            if (!wav_writer_->finalize()) {
-                RAV_LOG_ERROR("Failed to finalize wav file");
-            }
-            wav_writer_.reset();
-        }
-        if (file_output_stream_) {
-            file_output_stream_.reset();
-        }
-        if (is_recording) {
+        if (audio_recorder_.remove_track(receiver_id_)) {
             RAV_LOG_INFO("Closed audio recording");
         }
     }
@@ -127,35 +121,40 @@ class StreamRecorder: public rav::RavennaReceiver::Subscriber {
     }
 
     void process_audio() {
-        std::lock_guard guard(mutex_);
-
-        if (audio_data_.empty()) {
+        // Don't wait for the maintenance thread, try again next time instead.
+        std::unique_lock lock(mutex_, std::try_to_lock);
+        if (!lock || audio_data_.empty()) {
             return;
         }
 
+        const auto& local_clock = ptp_subscriber_.get_local_clock();
+
         for (int i = 0; i < 10; ++i) {
             const auto ts = ravenna_node_.read_data_realtime(receiver_id_, audio_data_.data(), audio_data_.size(), std::nullopt, delay_);
             if (!ts) {
                 return;
             }
 
-            if (audio_format_.byte_order == rav::AudioFormat::ByteOrder::be) {
-                rav::swap_bytes(audio_data_.data(), audio_data_.size(), audio_format_.bytes_per_sample());
-            }
-            if (!wav_writer_->write_audio_data(audio_data_.data(), audio_data_.size())) {
-                RAV_LOG_ERROR("Failed to write audio data");
+            // The time of the first frame in samples since the PTP epoch, which becomes the timecode of the file.
+            std::optional<uint64_t> timestamp;
+            if (local_clock.is_calibrated()) {
+                const auto sample_rate = audio_format_.sample_rate;
+                timestamp = local_clock.now().from_rtp_timestamp32(*ts, sample_rate).to_rtp_timestamp(sample_rate);
             }
+
+            // Audio which doesn't fit is dropped, and counted in the stats of the track.
+            audio_recorder_.write_realtime(receiver_id_, audio_data_.data(), audio_data_.size(), timestamp);
         }
     }
 
   private:
     rav::RavennaNode& ravenna_node_;
+    rav::AudioRecorder& audio_recorder_;
+    rav::ptp::Instance::Subscriber& ptp_subscriber_;
     const rav::Id receiver_id_;
 
     std::mutex mutex_;
     std::string session_name_;
-    std::unique_ptr<rav::FileOutputStream> file_output_stream_;
-    std::unique_ptr<rav::WavAudioFormat::Writer> wav_writer_;
     std::vector<uint8_t> audio_data_;
     rav::AudioFormat audio_format_;
     uint32_t delay_ = 0;
@@ -171,15 +170,22 @@ class StreamRecorder: public rav::RavennaReceiver::Subscriber {
             return;
         }
 
-        auto file_path = std::filesystem::absolute(session_name_ + ".wav");
+        close();
 
-        RAV_LOG_INFO("Start recording stream to: \"{}\" to file: {}", session_name_, file_path.string());
+        rav::AudioRecorder::TrackOptions options;
+        options.file = std::filesystem::absolute(session_name_ + ".wav");
+        options.format = audio_format_;
+        options.bext.emplace();
+        options.bext->description = session_name_;
+        options.bext->originator = "ravennakit";
+
+        RAV_LOG_INFO("Start recording stream to: \"{}\" to file: {}", session_name_, options.file.string());
+
+        if (auto result = audio_recorder_.add_track(receiver_id_, options); !result) {
+            RAV_LOG_ERROR("Failed to start recording: {}", result.error());
+            return;
+        }
 
-        file_output_stream_ = std::make_unique<rav::FileOutputStream>(file_path);
-        wav_writer_ = std::make_unique<rav::WavAudioFormat::Writer>(
-            *file_output_stream_, rav::WavAudioFormat::FormatCode::pcm, audio_format_.sample_rate, audio_format_.num_channels,
-            audio_format_.bytes_per_sample() * 8
-        );
         audio_data_.resize(k_block_size * audio_format_.bytes_per_frame());
         delay_ = audio_format_.sample_rate * k_delay_ms / 1000;
     }
@@ -224,6 +230,11 @@ int main(int const argc, char* argv[]) {
 
     rav::RavennaNode node;
     node.set_network_interface_config(std::move(interface_config)).get();
+
+    rav::ptp::Instance::Subscriber ptp_subscriber;
+    node.subscribe_to_ptp_instance(&ptp_subscriber).wait();
+
+    rav::AudioRecorder audio_recorder;
     std::vector<std::unique_ptr<StreamRecorder>> recorders;
 
     for (const auto& stream_name : stream_names) {
@@ -236,12 +247,14 @@ int main(int const argc, char* argv[]) {
             RAV_LOG_ERROR("Failed to create receiver: {}", id.error());
             return -1;
         }
-        recorders.emplace_back(std::make_unique<StreamRecorder>(node, *id));
+        recorders.emplace_back(std::make_unique<StreamRecorder>(node, audio_recorder, ptp_subscriber, *id));
     }
 
     std::atomic keep_going {true};
 
     std::thread recorder_thread([&] {
+        TRACY_SET_THREAD_NAME("ravenna_recorder_audio");
+
         while (keep_going.load(std::memory_order_relaxed)) {
             for (const auto& recorder : recorders) {
                 recorder->process_audio();
@@ -258,6 +271,9 @@ int main(int const argc, char* argv[]) {
     keep_going.store(false, std::memory_order_relaxed);
 
     recorder_thread.join();
+    recorders.clear();
+
+    node.unsubscribe_from_ptp_instance(&ptp_subscriber).wait();
 
     return 0;
 }
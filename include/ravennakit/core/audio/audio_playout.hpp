@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "audio_format.hpp"
+#include "formats/wav_audio_format.hpp"
+#include "ravennakit/core/containers/buffer_view.hpp"
+#include "ravennakit/core/streams/mapped_file_input_stream.hpp"
+#include "ravennakit/core/util/wrapping_uint.hpp"
+
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace rav {
+
+/**
+ * Options for an AudioPlayout.
+ */
+struct AudioPlayoutOptions {
+    /// The maximum number of frames handed out in one piece by AudioPlayout::process.
+    uint32_t max_frames_per_piece {1024};
+
+    /// When the playout is this many frames behind or ahead of the clock, it jumps to the clock instead of catching up.
+    uint32_t max_drift_frames {4800};
+
+    /// Options for mapping the file.
+    MappedFileInputStreamOptions file_options;
+};
+
+/**
+ * Plays out a WAVE file against a clock. The file is mapped into memory and its audio data is handed out without being
+ * copied, in pieces which point straight into the mapping. Each piece is tagged with the RTP timestamp it should be
+ * sent at, so it can be passed to AudioSender::send_data_realtime, which converts the byte order while copying the data
+ * into its send buffer.
+ * Playback follows a list of cues, which are played back to back, and optionally loops without gaps. Outside of
+ * playback, silence is handed out to keep the stream going.
+ * Thread safe: no.
+ */
+class AudioPlayout {
+  public:
+    /**
+     * A region of the file, in frames. The end is clamped to the length of the file.
+     */
+    struct Cue {
+        uint64_t begin_frame {};
+        uint64_t end_frame {std::numeric_limits<uint64_t>::max()};
+    };
+
+    /**
+     * Opens a WAVE file for playout.
+     * @param file The file to play.
+     * @param options The options of the playout.
+     * @return The playout, or nullptr if the file could not be mapped or is not a valid WAVE file.
+     */
+    [[nodiscard]] static std::unique_ptr<AudioPlayout> create(const std::filesystem::path& file, const AudioPlayoutOptions& options = {});
+
+    /**
+     * @return The format of the audio data in the file.
+     */
+    [[nodiscard]] const AudioFormat& get_audio_format() const;
+
+    /**
+     * @return The number of frames in the file.
+     */
+    [[nodiscard]] uint64_t get_num_frames() const;
+
+    /**
+     * Sets the cues to play. Allocates, so must not be called during playback from a realtime thread.
+     * @param cues The cues to play, in order. Cues outside the file are dropped. When empty, the whole file is played.
+     */
+    void set_cues(const std::vector<Cue>& cues);
+
+    /**
+     * @return The cues which are played, after clamping to the file.
+     */
+    [[nodiscard]] const std::vector<Cue>& get_cues() const;
+
+    /**
+     * @param looping When true, the cues are repeated endlessly. Otherwise, playback stops after the last cue.
+     */
+    void set_looping(bool looping);
+
+    /**
+     * Starts playing the cues from the beginning at given timestamp.
+     * @param at_timestamp The RTP timestamp of the first frame.
+     */
+    void start(uint32_t at_timestamp);
+
+    /**
+     * Stops playing. Silence is handed out from the next call to process.
+     */
+    void stop();
+
+    /**
+     * @return True if the cues are being played, false if playback hasn't started yet, has stopped or has ended.
+     */
+    [[nodiscard]] bool is_playing() const;
+
+    /**
+     * @return The number of frames played since playback started, including repetitions of the cues.
+     */
+    [[nodiscard]] uint64_t get_position() const;
+
+    /**
+     * Hands out the audio up to the given time. The pieces are consecutive, and the first piece continues where the
+     * previous call left off unless the clock drifted away by more than max_drift_frames. Realtime safe.
+     * @param now The current RTP timestamp.
+     * @param fn Called with each piece of audio as fn(BufferView<const uint8_t> data, uint32_t timestamp). The data is
+     * in the byte order of the file and only valid during the call.
+     * @return The number of frames handed out.
+     */
+    template<class Fn>
+    uint32_t process(const uint32_t now, Fn&& fn) {
+        resync(now);
+
+        uint32_t num_frames = 0;
+        while (next_ts_.diff(now) >= 0) {
+            uint32_t block_frames = options_.max_frames_per_piece;
+            while (block_frames > 0) {
+                const auto piece = next_piece(block_frames);
+                fn(piece, next_ts_.value());
+                const auto piece_frames = static_cast<uint32_t>(piece.size() / bytes_per_frame_);
+                next_ts_ += piece_frames;
+                block_frames -= piece_frames;
+                num_frames += piece_frames;
+            }
+        }
+        return num_frames;
+    }
+
+  private:
+    AudioPlayoutOptions options_;
+    std::unique_ptr<WavAudioFormat::Reader> reader_;  // Owns the mapping
+    const uint8_t* audio_data_ {};
+    uint64_t num_frames_ {};
+    AudioFormat audio_format_;
+    uint32_t bytes_per_frame_ {};
+    std::vector<uint8_t> silence_;
+    std::vector<Cue> cues_;
+    uint64_t cues_length_ {};  // The sum of the lengths of all cues
+    bool looping_ {};
+    std::optional<WrappingUint32> start_ts_;
+    bool playing_ {};
+    uint64_t position_ {};
+    WrappingUint32 next_ts_;
+    bool synced_ {};
+
+    AudioPlayout() = default;
+
+    void resync(uint32_t now);
+    [[nodiscard]] BufferView<const uint8_t> next_piece(uint32_t max_frames);
+};
+
+}  // namespace rav
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "audio_format.hpp"
+#include "formats/wav_audio_format.hpp"
+#include "ravennakit/core/expected.hpp"
+#include "ravennakit/core/containers/fifo_buffer.hpp"
+#include "ravennakit/core/streams/direct_file_output_stream.hpp"
+#include "ravennakit/core/sync/atomic_rw_lock.hpp"
+#include "ravennakit/core/util/id.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rav {
+
+/**
+ * Options for an AudioRecorder.
+ */
+struct AudioRecorderOptions {
+    /// The amount of audio each track buffers between the realtime thread and the writer thread. This has to cover
+    /// the longest stall of the disk.
+    std::chrono::milliseconds fifo_duration {2000};
+
+    /// The writer thread collects this many bytes of a track before writing them to its file.
+    size_t write_block_size {1024 * 1024};
+
+    /// The interval at which the headers of the files are updated. Limits how much of a recording is lost when the
+    /// process dies.
+    std::chrono::milliseconds finalize_interval {5000};
+
+    /// How long the writer thread sleeps when there is nothing to write.
+    std::chrono::milliseconds idle_interval {5};
+
+    /// Options for the files. When a DirectFileOutputStream can't be created, a FileOutputStream is used instead.
+    DirectFileOutputStreamOptions file_options {true, 64 * 1024 * 1024};
+};
+
+/**
+ * Records multiple tracks of audio to WAVE files. Audio is handed over from the realtime thread through a lock-free
+ * FIFO per track, and written to disk in large blocks by a dedicated writer thread. Files are written as Broadcast Wave
+ * Format when a bext chunk is given, and turn into RF64 files when they grow beyond 4 GB.
+ * Thread safe: yes, write_realtime can be called from one (realtime) thread per track.
+ */
+class AudioRecorder {
+  public:
+    static constexpr size_t k_max_num_tracks = 64;
+
+    /**
+     * Options for a track.
+     */
+    struct TrackOptions {
+        /// The file to write to. Existing files are overwritten.
+        std::filesystem::path file;
+        /// The format of the audio passed to write_realtime. Must be interleaved. Big endian data is converted to
+        /// little endian before writing.
+        AudioFormat format;
+        /// When set, the file is written as a Broadcast Wave Format file. The time reference is taken from the
+        /// timestamp given to write_realtime, if any.
+        std::optional<WavAudioFormat::BextChunk> bext;
+    };
+
+    /**
+     * Statistics of a track.
+     */
+    struct TrackStats {
+        /// The number of frames written to the file.
+        uint64_t frames_written {};
+        /// The number of frames which didn't fit in the FIFO, and which are missing from the file.
+        uint64_t frames_dropped {};
+        /// True when writing to the file failed. No more data is written after a failure.
+        bool failed {};
+    };
+
+    /**
+     * Constructs a recorder and starts the writer thread.
+     * @param options The options of the recorder.
+     */
+    explicit AudioRecorder(const AudioRecorderOptions& options = {});
+
+    /**
+     * Writes the remaining audio of all tracks and closes their files.
+     */
+    ~AudioRecorder();
+
+    AudioRecorder(const AudioRecorder&) = delete;
+    AudioRecorder& operator=(const AudioRecorder&) = delete;
+
+    AudioRecorder(AudioRecorder&&) noexcept = delete;
+    AudioRecorder& operator=(AudioRecorder&&) noexcept = delete;
+
+    /**
+     * Adds a track, creating its file.
+     * @param id The id of the track. Must be unique within this recorder.
+     * @param options The options of the track.
+     * @return An error if the track could not be added.
+     */
+    [[nodiscard]] tl::expected<void, std::string> add_track(Id id, const TrackOptions& options);
+
+    /**
+     * Removes a track, writing its remaining audio and closing its file.
+     * @param id The id of the track.
+     * @return True if the track was removed, false if no track with given id exists.
+     */
+    bool remove_track(Id id);
+
+    /**
+     * Hands audio over to the writer thread.
+     * Realtime safe: yes, wait-free.
+     * @param id The id of the track.
+     * @param data The audio data, in the format of the track. Should hold whole frames.
+     * @param size The number of bytes.
+     * @param timestamp The time of the first frame, in samples since an epoch which starts at midnight, like the PTP
+     * epoch. Only the first timestamp of a track is used, for the time reference of its bext chunk.
+     * @return True if the data was handed over, false if the track doesn't exist or its FIFO is full.
+     */
+    bool write_realtime(Id id, const uint8_t* data, size_t size, std::optional<uint64_t> timestamp = std::nullopt);
+
+    /**
+     * @param id The id of the track.
+     * @return The statistics of the track, or nullopt if no track with given id exists.
+     */
+    [[nodiscard]] std::optional<TrackStats> get_track_stats(Id id) const;
+
+  private:
+    struct Track {
+        AtomicRwLock rw_lock;
+        Id id;
+        AudioFormat format;
+        FifoBuffer<uint8_t, Fifo::Spsc> fifo;
+        std::atomic<uint64_t> frames_written {};
+        std::atomic<uint64_t> frames_dropped {};
+        std::atomic<uint64_t> first_timestamp {};
+        std::atomic<bool> has_timestamp {};
+        std::atomic<bool> failed {};
+
+        // Only accessed by the writer thread, or while holding the exclusive lock.
+        std::unique_ptr<OutputStream> stream;
+        std::unique_ptr<WavAudioFormat::Writer> writer;
+        size_t block_size {};
+        std::chrono::steady_clock::time_point last_finalize;
+    };
+
+    AudioRecorderOptions options_;
+    mutable std::mutex mutex_;  // Serializes adding and removing tracks.
+    std::array<Track, k_max_num_tracks> tracks_;
+    std::atomic<bool> keep_going_ {true};
+    std::thread writer_thread_;
+
+    [[nodiscard]] Track* find_track(Id id);
+    [[nodiscard]] const Track* find_track(Id id) const;
+    bool write_track(Track& track, std::vector<uint8_t>& buffer, bool drain) const;
+};
+
+}  // namespace rav
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/util/memory_arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rav {
+
+/**
+ * A resampler with a variable ratio, for asynchronous sample rate conversion between two clocks which run at nearly the
+ * same rate. Every output sample is calculated with a windowed sinc polyphase filter of k_num_taps taps, interpolating
+ * between the two nearest of k_num_phases phases. This bounds the cost to 2 * k_num_taps multiply-adds per output
+ * sample per channel, independent of the ratio. The inner loop uses SSE or NEON when available.
+ *
+ * The caller asks how many input frames the next block needs, writes them into the buffer returned by prepare_input,
+ * and calls process. The input is non-interleaved.
+ * Thread safe: no.
+ */
+class AudioResampler {
+  public:
+    /// The number of taps of the filter. The latency of the resampler is half of this.
+    static constexpr size_t k_num_taps = 32;
+
+    /// The number of phases of the filter.
+    static constexpr size_t k_num_phases = 128;
+
+    AudioResampler() = default;
+
+    /**
+     * Allocates the buffers and resets the resampler.
+     * @param num_channels The number of channels.
+     * @param max_num_output_frames The maximum number of frames per call to process.
+     * @param max_ratio The maximum ratio which will be set.
+     * @param allocator The allocator for the buffers.
+     */
+    void resize(size_t num_channels, size_t max_num_output_frames, double max_ratio, const ArenaAllocator<float>& allocator = {});
+
+    /**
+     * Clears the history and the fractional position. Realtime safe.
+     */
+    void reset();
+
+    /**
+     * Sets the ratio, which is the number of input frames consumed per output frame. Realtime safe.
+     * @param ratio The ratio, larger than 0 and not larger than the max_ratio given to resize.
+     */
+    void set_ratio(double ratio);
+
+    /**
+     * @return The current ratio.
+     */
+    [[nodiscard]] double get_ratio() const;
+
+    /**
+     * @return The number of channels.
+     */
+    [[nodiscard]] size_t num_channels() const;
+
+    /**
+     * @return The maximum number of frames per call to process.
+     */
+    [[nodiscard]] size_t max_num_output_frames() const;
+
+    /**
+     * @param num_output_frames The number of frames to produce.
+     * @return The number of input frames to pass to prepare_input before producing num_output_frames frames.
+     */
+    [[nodiscard]] size_t get_num_input_frames_needed(size_t num_output_frames) const;
+
+    /**
+     * Appends num_frames frames to the input. Realtime safe.
+     * @param num_frames The number of frames, as returned by get_num_input_frames_needed.
+     * @return The channels to write the input frames to.
+     */
+    [[nodiscard]] float* const* prepare_input(size_t num_frames);
+
+    /**
+     * Produces output frames from the input. Realtime safe.
+     * @param output The output channels.
+     * @param output_offset The frame in the output channels to start writing at.
+     * @param num_frames The number of frames to produce, at most max_num_output_frames.
+     */
+    void process(float* const* output, size_t output_offset, size_t num_frames);
+
+    /**
+     * @return The number of input frames which have been passed in but not yet been consumed, including the fraction
+     * of the current position.
+     */
+    [[nodiscard]] double get_num_buffered_frames() const;
+
+  private:
+    ArenaVector<float> buffer_;      // All channels, each holding capacity_ frames
+    ArenaVector<float*> channels_;   // Pointers into buffer_, for prepare_input
+    size_t num_channels_ {};
+    size_t capacity_ {};             // Frames per channel
+    size_t max_num_output_frames_ {};
+    size_t num_frames_buffered_ {};  // Input frames in the buffer
+    double position_ {};             // The position of the first tap of the next output frame in the buffer
+    double ratio_ {1.0};
+};
+
+}  // namespace rav
@@ -30,6 +30,8 @@
 #include "ravennakit/core/streams/output_stream.hpp"
 
 #include <array>
+#include <optional>
+#include <string>
 
 namespace rav {
 
@@ -101,19 +103,83 @@ class WavAudioFormat {
         /**
          * Reads the data chunk from the input stream.
          * @param istream The input stream to read from.
-         * @param chunk_size The size of the data chunk.
+         * @param chunk_size The size of the data chunk. For RF64 files this is the size from the ds64 chunk.
          */
-        [[nodiscard]] bool read(InputStream& istream, uint32_t chunk_size);
+        [[nodiscard]] bool read(InputStream& istream, size_t chunk_size);
 
         /**
          * Writes the data chunk to the output stream.
          * @param ostream The output stream to write to.
-         * @param data_written The number of bytes of audio data written into the stream so far.
+         * @param data_written The number of bytes of audio data written into the stream so far. When this doesn't fit in
+         * 32 bits, the size field is set to 0xffffffff and the actual size lives in the ds64 chunk.
          * @return The number of bytes written (excluding the size of the data).
          */
         [[nodiscard]] tl::expected<size_t, OutputStream::Error> write(OutputStream& ostream, size_t data_written);
     };
 
+    /**
+     * A struct representing the broadcast audio extension chunk (bext) of a Broadcast Wave Format file, as specified
+     * by EBU Tech 3285.
+     */
+    struct BextChunk {
+        /// The size of the chunk excluding the coding history.
+        static constexpr uint32_t k_fixed_size = 602;
+
+        /// Free text description of the sound sequence (max 256 characters).
+        std::string description;
+        /// The name of the originator (max 32 characters).
+        std::string originator;
+        /// A reference which is unique to the originator (max 32 characters).
+        std::string originator_reference;
+        /// The date of creation in the format yyyy:mm:dd (10 characters).
+        std::string origination_date;
+        /// The time of creation in the format hh:mm:ss (8 characters).
+        std::string origination_time;
+        /// The timecode of the first sample, as the number of samples since midnight.
+        uint64_t time_reference {};
+        /// The version of the bext chunk.
+        uint16_t version {2};
+        /// SMPTE UMID.
+        std::array<uint8_t, 64> umid {};
+        /// Integrated loudness in LUFS, multiplied by 100. 0x7fff means not set.
+        int16_t loudness_value {0x7fff};
+        /// Loudness range in LU, multiplied by 100. 0x7fff means not set.
+        int16_t loudness_range {0x7fff};
+        /// Maximum true peak level in dBTP, multiplied by 100. 0x7fff means not set.
+        int16_t max_true_peak_level {0x7fff};
+        /// Highest momentary loudness level in LUFS, multiplied by 100. 0x7fff means not set.
+        int16_t max_momentary_loudness {0x7fff};
+        /// Highest short-term loudness level in LUFS, multiplied by 100. 0x7fff means not set.
+        int16_t max_short_term_loudness {0x7fff};
+        /// Free text describing the coding history.
+        std::string coding_history;
+
+        /**
+         * Reads the bext chunk from the input stream.
+         * @param istream The input stream to read from.
+         * @param chunk_size The size of the bext chunk.
+         */
+        void read(InputStream& istream, uint32_t chunk_size);
+
+        /**
+         * Writes the bext chunk to the output stream, including its header.
+         * @param ostream The output stream to write to.
+         * @return The number of bytes written.
+         */
+        [[nodiscard]] tl::expected<size_t, OutputStream::Error> write(OutputStream& ostream) const;
+    };
+
+    /**
+     * Options for writing a WAVE file.
+     */
+    struct WriterOptions {
+        /// Reserves space for a ds64 chunk, so that the file can grow beyond 4 GB. The file is written as a regular
+        /// RIFF file and turns into an RF64 file (EBU Tech 3306) once it crosses the 4 GB limit.
+        bool rf64 {};
+        /// When set, a bext chunk is written, making the file a Broadcast Wave Format file.
+        std::optional<BextChunk> bext;
+    };
+
     /**
      * A reader class which reads audio (meta)data from an input stream.
      */
@@ -162,10 +228,21 @@ class WavAudioFormat {
          */
         [[nodiscard]] std::optional<AudioFormat> get_audio_format() const;
 
+        /**
+         * @return The bext chunk, if the file is a Broadcast Wave Format file.
+         */
+        [[nodiscard]] const std::optional<BextChunk>& get_bext_chunk() const;
+
+        /**
+         * @return The data chunk, which holds the position and size of the audio data in the stream.
+         */
+        [[nodiscard]] const std::optional<DataChunk>& get_data_chunk() const;
+
       private:
         std::unique_ptr<InputStream> istream_;
         std::optional<FmtChunk> fmt_chunk_;
         std::optional<DataChunk> data_chunk_;
+        std::optional<BextChunk> bext_chunk_;
         size_t data_read_position_ {};
     };
 
@@ -175,6 +252,21 @@ class WavAudioFormat {
     class Writer {
       public:
         explicit Writer(OutputStream& ostream, FormatCode format, double sample_rate, size_t num_channels, size_t bits_per_sample);
+
+        /**
+         * Constructs a writer with additional options.
+         * @param ostream The output stream to write to.
+         * @param format The format code of the audio data.
+         * @param sample_rate The sample rate of the audio data.
+         * @param num_channels The number of channels of the audio data.
+         * @param bits_per_sample The number of bits per sample.
+         * @param options The options of the writer.
+         */
+        Writer(
+            OutputStream& ostream, FormatCode format, double sample_rate, size_t num_channels, size_t bits_per_sample,
+            WriterOptions options
+        );
+
         ~Writer();
 
         /**
@@ -192,8 +284,21 @@ class WavAudioFormat {
          */
         [[nodiscard]] bool finalize();
 
+        /**
+         * Sets the time reference of the bext chunk. Takes effect the next time the header is written (see finalize).
+         * Does nothing if the writer was created without a bext chunk.
+         * @param time_reference The timecode of the first sample, as the number of samples since midnight.
+         */
+        void set_time_reference(uint64_t time_reference);
+
+        /**
+         * @return The number of bytes of audio data written so far.
+         */
+        [[nodiscard]] size_t get_audio_data_written() const;
+
       private:
         OutputStream& ostream_;
+        WriterOptions options_;
         FmtChunk fmt_chunk_;
         DataChunk data_chunk_;
         size_t audio_data_written_ {};
@@ -26,6 +26,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "ravennakit/core/exception.hpp"
 
@@ -67,6 +68,29 @@ static constexpr bool big_endian = false;
 
 namespace rav {
 
+/**
+ * A set of functions which swap the bytes of every sample in a buffer, for one instruction set. Each function takes the
+ * source, the destination and the size in bytes, which should be a multiple of the sample size. Source and destination
+ * must either be the same or not overlap.
+ */
+struct ByteSwapKernels {
+    const char* name {};
+    void (*swap_16)(const uint8_t* src, uint8_t* dst, size_t size) {};
+    void (*swap_24)(const uint8_t* src, uint8_t* dst, size_t size) {};
+    void (*swap_32)(const uint8_t* src, uint8_t* dst, size_t size) {};
+};
+
+/**
+ * @return The kernels for the fastest instruction set supported by this CPU. Selected on first use.
+ */
+const ByteSwapKernels& get_byte_swap_kernels();
+
+/**
+ * @return The kernels of all instruction sets supported by this CPU, starting with the portable scalar kernels and
+ * ending with the fastest.
+ */
+const std::vector<ByteSwapKernels>& get_supported_byte_swap_kernels();
+
 /**
  * Swaps given amount of bytes in the given data, in place.
  * @param data The data to swap.
@@ -84,9 +108,10 @@ inline void swap_bytes(uint8_t* data, const size_t size) {
 }
 
 /**
- * Swaps given amount of bytes in the given data, in place, with the given stride.
+ * Swaps given amount of bytes in the given data, in place, with the given stride. Strides of 2, 3 and 4 bytes use the
+ * vectorized kernels of get_byte_swap_kernels().
  * @param data The data to swap.
- * @param size The size of the data (in bytes).
+ * @param size The size of the data (in bytes), a multiple of stride.
  * @param stride The stride of the data (in bytes).
  */
 inline void swap_bytes(uint8_t* data, const size_t size, const size_t stride) {
@@ -95,6 +120,20 @@ inline void swap_bytes(uint8_t* data, const size_t size, const size_t stride) {
         return;
     }
 
+    switch (stride) {
+        case 2:
+            get_byte_swap_kernels().swap_16(data, data, size);
+            return;
+        case 3:
+            get_byte_swap_kernels().swap_24(data, data, size);
+            return;
+        case 4:
+            get_byte_swap_kernels().swap_32(data, data, size);
+            return;
+        default:
+            break;
+    }
+
     for (size_t i = 0; i < size; i += stride) {
         for (size_t j = 0; j < stride / 2; ++j) {
             std::swap(data[i + j], data[i + stride - j - 1]);
@@ -102,6 +141,52 @@ inline void swap_bytes(uint8_t* data, const size_t size, const size_t stride) {
     }
 }
 
+/**
+ * Copies given amount of bytes from src to dst, swapping the bytes of every stride bytes. Source and destination must
+ * either be the same or not overlap. Strides of 2, 3 and 4 bytes use the vectorized kernels of get_byte_swap_kernels().
+ * @param src The data to copy.
+ * @param dst The destination, which must hold at least size bytes.
+ * @param size The size of the data (in bytes), a multiple of stride.
+ * @param stride The stride of the data (in bytes).
+ */
+inline void swap_bytes(const uint8_t* src, uint8_t* dst, const size_t size, const size_t stride) {
+    if (src == nullptr || dst == nullptr || size == 0) {
+        return;
+    }
+
+    if (stride <= 1) {
+        if (src != dst) {
+            std::memcpy(dst, src, size);
+        }
+        return;
+    }
+
+    switch (stride) {
+        case 2:
+            get_byte_swap_kernels().swap_16(src, dst, size);
+            return;
+        case 3:
+            get_byte_swap_kernels().swap_24(src, dst, size);
+            return;
+        case 4:
+            get_byte_swap_kernels().swap_32(src, dst, size);
+            return;
+        default:
+            break;
+    }
+
+    if (src == dst) {
+        swap_bytes(dst, size, stride);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i += stride) {
+        for (size_t j = 0; j < stride; ++j) {
+            dst[i + j] = src[i + stride - j - 1];
+        }
+    }
+}
+
 /**
  * @tparam Type The type of the value to swap.
  * @param value The value to swap.
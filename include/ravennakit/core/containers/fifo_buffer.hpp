@@ -28,6 +28,7 @@
 
 #include <vector>
 #include <cstring>
+#include <memory>
 #include <optional>
 
 namespace rav {
@@ -35,7 +36,7 @@ namespace rav {
 /**
  * A classic FIFO buffer implementation with different strategies F.
  */
-template<class T, class F>
+template<class T, class F, class Allocator = std::allocator<T>>
 class FifoBuffer {
   public:
     FifoBuffer() = default;
@@ -146,6 +147,27 @@ class FifoBuffer {
         fifo_.resize(size);
     }
 
+    /**
+     * Replaces the allocator of the storage. When the allocator differs from the current one, the storage is released
+     * and the buffer must be resized before it can be used again.
+     * @param allocator The new allocator.
+     */
+    void set_allocator(const Allocator& allocator) {
+        if (buffer_.get_allocator() == allocator) {
+            return;
+        }
+        buffer_ = std::vector<T, Allocator>(allocator);
+        fifo_.resize(0);
+    }
+
+    /**
+     * Releases the storage of the buffer, which must be resized before it can be used again.
+     */
+    void release() {
+        buffer_ = std::vector<T, Allocator>(buffer_.get_allocator());
+        fifo_.resize(0);
+    }
+
     /**
      * Clears the buffer.
      */
@@ -162,7 +184,7 @@ class FifoBuffer {
     }
 
   private:
-    std::vector<T> buffer_;
+    std::vector<T, Allocator> buffer_;
     F fifo_;
 };
 
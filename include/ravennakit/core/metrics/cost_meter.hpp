@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "counter.hpp"
+#include "histogram.hpp"
+#include "ravennakit/core/clock.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace rav::metrics {
+
+/**
+ * Accounts for the time a realtime thread spends in a stage, like processing the packets of a stream. Written by a
+ * single thread and readable from any thread without locks. Besides the totals, the durations are kept in a histogram
+ * from which percentiles are estimated.
+ */
+class CostMeter {
+  public:
+    /// The upper bounds of the histogram buckets in microseconds.
+    static constexpr std::array<double, 12> k_buckets_us {1, 2, 5, 10, 20, 50, 100, 200, 500, 1'000, 2'000, 5'000};
+
+    using DurationHistogram = Histogram<k_buckets_us.size()>;
+
+    /**
+     * A copy of the state of a meter.
+     */
+    struct Snapshot {
+        uint64_t count {};     // The number of measured passes
+        uint64_t total_ns {};  // The time spent in all passes together
+        uint64_t max_ns {};    // The longest pass
+        double p50_us {};      // Estimated from the histogram
+        double p99_us {};      // Estimated from the histogram
+        double p999_us {};     // Estimated from the histogram
+
+        /**
+         * @return The average time of a pass in microseconds, or 0 if nothing was measured.
+         */
+        [[nodiscard]] double mean_us() const {
+            return count == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(count) / 1'000.0;
+        }
+    };
+
+    /**
+     * Measures the time between its construction and destruction, and adds it to a meter.
+     */
+    class Scope {
+      public:
+        explicit Scope(CostMeter& meter) : meter_(meter), begin_ns_(clock::now_monotonic_high_resolution_ns()) {}
+
+        ~Scope() {
+            meter_.add(clock::now_monotonic_high_resolution_ns() - begin_ns_);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        Scope(Scope&&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+      private:
+        CostMeter& meter_;
+        uint64_t begin_ns_ {};
+    };
+
+    CostMeter() = default;
+
+    CostMeter(const CostMeter&) = delete;
+    CostMeter& operator=(const CostMeter&) = delete;
+
+    CostMeter(CostMeter&&) = delete;
+    CostMeter& operator=(CostMeter&&) = delete;
+
+    /**
+     * Adds the duration of a pass. Must only be called from the thread owning the meter. Wait-free.
+     * @param duration_ns The duration in nanoseconds.
+     */
+    void add(const uint64_t duration_ns) {
+        total_ns_.increment(duration_ns);
+        if (duration_ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(duration_ns, std::memory_order_relaxed);
+        }
+        histogram_.observe(static_cast<double>(duration_ns) / 1'000.0);
+    }
+
+    /**
+     * Thread safe and wait-free. Passes which are being added while taking the snapshot might or might not be included.
+     * @return A copy of the current state.
+     */
+    [[nodiscard]] Snapshot get_snapshot() const {
+        const auto histogram = histogram_.get_snapshot();
+        Snapshot snapshot;
+        snapshot.count = histogram.count();
+        snapshot.total_ns = total_ns_.get();
+        snapshot.max_ns = max_ns_.load(std::memory_order_relaxed);
+        snapshot.p50_us = histogram.quantile(0.5);
+        snapshot.p99_us = histogram.quantile(0.99);
+        snapshot.p999_us = histogram.quantile(0.999);
+        return snapshot;
+    }
+
+    /**
+     * @return The histogram of the durations in microseconds.
+     */
+    [[nodiscard]] const DurationHistogram& get_histogram() const {
+        return histogram_;
+    }
+
+    /**
+     * Resets the meter. Must only be called when the owning thread is not writing to the meter.
+     */
+    void reset() {
+        total_ns_.reset();
+        max_ns_.store(0, std::memory_order_relaxed);
+        histogram_.reset();
+    }
+
+  private:
+    Counter total_ns_;
+    std::atomic<uint64_t> max_ns_ {0};
+    DurationHistogram histogram_ {k_buckets_us};
+};
+
+}  // namespace rav::metrics
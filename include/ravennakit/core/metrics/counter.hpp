@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace rav::metrics {
+
+/**
+ * A monotonically increasing counter which is written by a single thread and which can be read from any thread.
+ * Because there is only a single writer, incrementing doesn't need an atomic read-modify-write operation, which makes
+ * it wait-free and as cheap as a regular increment.
+ */
+class Counter {
+  public:
+    Counter() = default;
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    Counter(Counter&&) = delete;
+    Counter& operator=(Counter&&) = delete;
+
+    /**
+     * Increments the counter. Must only be called from the thread owning the counter.
+     * @param amount The amount to increment with.
+     */
+    void increment(const uint64_t amount = 1) {
+        value_.store(value_.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Thread safe and wait-free.
+     * @return The current value.
+     */
+    [[nodiscard]] uint64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Resets the counter to zero. Must only be called when the owning thread is not writing to the counter.
+     */
+    void reset() {
+        value_.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> value_ {0};
+};
+
+/**
+ * A value which can go up and down, written by a single thread and readable from any thread.
+ */
+class Gauge {
+  public:
+    Gauge() = default;
+
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    Gauge(Gauge&&) = delete;
+    Gauge& operator=(Gauge&&) = delete;
+
+    /**
+     * Sets the value of the gauge.
+     * @param value The new value.
+     */
+    void set(const double value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Thread safe and wait-free.
+     * @return The current value.
+     */
+    [[nodiscard]] double get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Resets the gauge to zero.
+     */
+    void reset() {
+        value_.store(0.0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<double> value_ {0.0};
+};
+
+}  // namespace rav::metrics
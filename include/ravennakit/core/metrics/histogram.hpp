@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/assert.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace rav::metrics {
+
+/**
+ * A histogram with a fixed number of buckets, written by a single thread and readable from any thread without locks.
+ * Each bucket counts the values which are smaller than or equal to its upper bound and larger than the upper bound of
+ * the previous bucket. Values larger than the last upper bound are counted in an additional overflow bucket.
+ * @tparam N The number of buckets (excluding the overflow bucket).
+ */
+template<size_t N>
+class Histogram {
+  public:
+    static_assert(N > 0, "A histogram needs at least one bucket");
+
+    using Bounds = std::array<double, N>;
+
+    /**
+     * A copy of the state of a histogram. The buckets are not cumulative.
+     */
+    struct Snapshot {
+        Bounds upper_bounds {};
+        std::array<uint64_t, N + 1> buckets {};
+        double sum {};
+
+        /**
+         * @return The total number of observed values.
+         */
+        [[nodiscard]] uint64_t count() const {
+            uint64_t total = 0;
+            for (const auto& b : buckets) {
+                total += b;
+            }
+            return total;
+        }
+
+        /**
+         * Estimates a quantile by interpolating linearly within the bucket which contains it, like histogram_quantile of
+         * Prometheus. The lower bound of the first bucket is 0, and quantiles in the overflow bucket are estimated as the
+         * last upper bound.
+         * @param q The quantile, between 0 and 1.
+         * @return The estimated value, or 0 if no values were observed.
+         */
+        [[nodiscard]] double quantile(const double q) const {
+            const auto total = count();
+            if (total == 0) {
+                return 0.0;
+            }
+            const auto rank = q * static_cast<double>(total);
+            double cumulative = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                const auto in_bucket = static_cast<double>(buckets[i]);
+                if (in_bucket > 0.0 && cumulative + in_bucket >= rank) {
+                    const auto lower = i == 0 ? 0.0 : upper_bounds[i - 1];
+                    return lower + (upper_bounds[i] - lower) * (rank - cumulative) / in_bucket;
+                }
+                cumulative += in_bucket;
+            }
+            return upper_bounds[N - 1];
+        }
+    };
+
+    /**
+     * Constructor.
+     * @param upper_bounds The upper bounds of the buckets, in ascending order.
+     */
+    explicit Histogram(const Bounds& upper_bounds) : upper_bounds_(upper_bounds) {
+        for (size_t i = 1; i < N; ++i) {
+            RAV_ASSERT(upper_bounds_[i - 1] < upper_bounds_[i], "Bounds must be in ascending order");
+        }
+    }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    Histogram(Histogram&&) = delete;
+    Histogram& operator=(Histogram&&) = delete;
+
+    /**
+     * Adds a value to the histogram. Must only be called from the thread owning the histogram. Wait-free.
+     * @param value The value to add.
+     */
+    void observe(const double value) {
+        size_t index = 0;
+        while (index < N && value > upper_bounds_[index]) {
+            ++index;
+        }
+        auto& bucket = buckets_[index];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Thread safe and wait-free. Note that values which are being added while taking the snapshot might or might not be
+     * included.
+     * @return A copy of the current state.
+     */
+    [[nodiscard]] Snapshot get_snapshot() const {
+        Snapshot snapshot;
+        snapshot.upper_bounds = upper_bounds_;
+        for (size_t i = 0; i < buckets_.size(); ++i) {
+            snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+        snapshot.sum = sum_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /**
+     * Resets all buckets. Must only be called when the owning thread is not writing to the histogram.
+     */
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        sum_.store(0.0, std::memory_order_relaxed);
+    }
+
+  private:
+    const Bounds upper_bounds_;
+    std::array<std::atomic<uint64_t>, N + 1> buckets_ {};
+    std::atomic<double> sum_ {0.0};
+};
+
+}  // namespace rav::metrics
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "histogram.hpp"
+#include "ravennakit/core/format.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rav::metrics {
+
+/**
+ * Collects metrics and renders them in the Prometheus text exposition format (version 0.0.4).
+ * Samples of the same metric are grouped together, regardless of the order in which they were added.
+ * https://prometheus.io/docs/instrumenting/exposition_formats/
+ */
+class PrometheusWriter {
+  public:
+    /// The content type of the rendered text.
+    static constexpr auto k_content_type = "text/plain; version=0.0.4; charset=utf-8";
+
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Adds a counter sample.
+     * @param name The name of the metric, should end in _total.
+     * @param help The description of the metric.
+     * @param labels The labels of this sample.
+     * @param value The value of the counter.
+     */
+    void add_counter(const std::string& name, const std::string& help, const Labels& labels, const uint64_t value) {
+        auto& family = get_or_create_family(name, help, "counter");
+        fmt::format_to(std::back_inserter(family.samples), "{}{} {}\n", name, format_labels(labels), value);
+    }
+
+    /**
+     * Adds a gauge sample.
+     * @param name The name of the metric.
+     * @param help The description of the metric.
+     * @param labels The labels of this sample.
+     * @param value The value of the gauge.
+     */
+    void add_gauge(const std::string& name, const std::string& help, const Labels& labels, const double value) {
+        auto& family = get_or_create_family(name, help, "gauge");
+        fmt::format_to(std::back_inserter(family.samples), "{}{} {}\n", name, format_labels(labels), value);
+    }
+
+    /**
+     * Adds a histogram. Buckets are rendered cumulative as required by the format.
+     * @param name The name of the metric.
+     * @param help The description of the metric.
+     * @param labels The labels of this sample.
+     * @param histogram The histogram to take a snapshot of.
+     */
+    template<size_t N>
+    void add_histogram(const std::string& name, const std::string& help, const Labels& labels, const Histogram<N>& histogram) {
+        const auto snapshot = histogram.get_snapshot();
+        auto& family = get_or_create_family(name, help, "histogram");
+        auto out = std::back_inserter(family.samples);
+
+        auto bucket_labels = labels;
+        bucket_labels.emplace_back("le", "");
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < N; ++i) {
+            cumulative += snapshot.buckets[i];
+            bucket_labels.back().second = fmt::format("{}", snapshot.upper_bounds[i]);
+            fmt::format_to(out, "{}_bucket{} {}\n", name, format_labels(bucket_labels), cumulative);
+        }
+        cumulative += snapshot.buckets[N];
+        bucket_labels.back().second = "+Inf";
+        fmt::format_to(out, "{}_bucket{} {}\n", name, format_labels(bucket_labels), cumulative);
+
+        const auto formatted_labels = format_labels(labels);
+        fmt::format_to(out, "{}_sum{} {}\n", name, formatted_labels, snapshot.sum);
+        fmt::format_to(out, "{}_count{} {}\n", name, formatted_labels, cumulative);
+    }
+
+    /**
+     * @return The metrics rendered in the Prometheus text format.
+     */
+    [[nodiscard]] std::string to_string() const {
+        std::string result;
+        for (const auto& family : families_) {
+            fmt::format_to(std::back_inserter(result), "# HELP {} {}\n# TYPE {} {}\n", family.name, family.help, family.name, family.type);
+            result += family.samples;
+        }
+        return result;
+    }
+
+  private:
+    struct Family {
+        std::string name;
+        std::string help;
+        const char* type {};
+        std::string samples;
+    };
+
+    std::vector<Family> families_;
+
+    Family& get_or_create_family(const std::string& name, const std::string& help, const char* type) {
+        for (auto& family : families_) {
+            if (family.name == name) {
+                RAV_ASSERT(std::string_view(family.type) == type, "Metric type mismatch");
+                return family;
+            }
+        }
+        return families_.emplace_back(Family {name, help, type, {}});
+    }
+
+    static std::string format_labels(const Labels& labels) {
+        if (labels.empty()) {
+            return {};
+        }
+        std::string result = "{";
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (i > 0) {
+                result += ',';
+            }
+            result += labels[i].first;
+            result += "=\"";
+            for (const auto c : labels[i].second) {
+                if (c == '\\' || c == '"') {
+                    result += '\\';
+                    result += c;
+                } else if (c == '\n') {
+                    result += "\\n";
+                } else {
+                    result += c;
+                }
+            }
+            result += '"';
+        }
+        result += '}';
+        return result;
+    }
+};
+
+}  // namespace rav::metrics
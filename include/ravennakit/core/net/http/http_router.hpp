@@ -68,14 +68,36 @@ class HttpRouter {
 
     /**
      * Matches the given method and path to a handler. If a matching route is found, the handler is returned.
+     * Routes are tried in the order they were inserted, except for routes ending in the recursive wildcard "**", which are
+     * only tried when no other route matches. This way a catch-all route doesn't shadow routes which are inserted later.
      * @param method The HTTP method to match (e.g., GET, POST).
      * @param path The path to match.
      * @param parameters The parameters to fill with the extracted values from the path.
      * @return A pointer to the matching handler, or nullptr if no match is found.
      */
     HandlerType* match(const boost::beast::http::verb method, const std::string_view path, PathMatcher::Parameters* parameters) {
+        if (auto* handler = match(method, path, parameters, false)) {
+            return handler;
+        }
+        return match(method, path, parameters, true);
+    }
+
+  private:
+    struct Route {
+        boost::beast::http::verb method {};
+        std::string pattern;
+        HandlerType handler;
+
+        [[nodiscard]] bool is_recursive() const {
+            return pattern.size() >= 2 && pattern.compare(pattern.size() - 2, 2, "**") == 0;
+        }
+    };
+
+    HandlerType* match(
+        const boost::beast::http::verb method, const std::string_view path, PathMatcher::Parameters* parameters, const bool recursive
+    ) {
         for (auto& route : routes_) {
-            if (route.method == method) {
+            if (route.method == method && route.is_recursive() == recursive) {
                 auto match_result = PathMatcher::match(path, route.pattern, parameters);
                 if (match_result.has_error()) {
                     RAV_LOG_ERROR("Error matching path: {}", match_result.error());
@@ -89,13 +111,6 @@ class HttpRouter {
         return nullptr;  // No matching route found
     }
 
-  private:
-    struct Route {
-        boost::beast::http::verb method {};
-        std::string pattern;
-        HandlerType handler;
-    };
-
     std::vector<Route> routes_;
 };
 
@@ -135,9 +135,22 @@ class ExtendedUdpSocket {
     std::shared_ptr<Impl> impl_;
 };
 
+/**
+ * Receives a datagram from a socket which has IP_RECVDSTADDR_PKTINFO enabled, together with its destination address.
+ * @param socket The socket to receive from.
+ * @param local_port The port the socket is bound to, which becomes the port of the destination endpoint. Passed in so
+ * that no syscall is needed per datagram.
+ * @param data_buf The buffer to receive the datagram in.
+ * @param src_endpoint The source endpoint of the datagram.
+ * @param dst_endpoint The destination endpoint of the datagram.
+ * @param recv_time The monotonic time in nanoseconds at which the datagram was received.
+ * @param ec Set when receiving failed.
+ * @return The number of bytes received.
+ */
 [[nodiscard]] size_t receive_from_socket(
-    boost::asio::ip::udp::socket& socket, std::array<uint8_t, 1500>& data_buf, boost::asio::ip::udp::endpoint& src_endpoint,
-    boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time, boost::system::error_code& ec
+    boost::asio::ip::udp::socket& socket, uint16_t local_port, std::array<uint8_t, 1500>& data_buf,
+    boost::asio::ip::udp::endpoint& src_endpoint, boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time,
+    boost::system::error_code& ec
 );
 
 }  // namespace rav
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/platform.hpp"
+
+#include <algorithm>
+
+#if RAV_POSIX
+
+    #include <pthread.h>
+    #include <sched.h>
+
+namespace rav::posix {
+
+/**
+ * Moves the calling thread to the SCHED_FIFO policy. This requires CAP_SYS_NICE or an RLIMIT_RTPRIO which allows the
+ * given priority, without it the thread keeps its current policy.
+ * @param priority The realtime priority, clamped to the range supported by SCHED_FIFO.
+ * @return True if the policy was set, or false if not.
+ */
+[[nodiscard]] inline bool set_thread_fifo_priority(const int priority) {
+    sched_param param {};
+    param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+}  // namespace rav::posix
+
+#endif
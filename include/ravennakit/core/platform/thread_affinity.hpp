@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/platform.hpp"
+
+#include <cstddef>
+#include <tuple>
+
+#if RAV_WINDOWS
+    #include <windows.h>
+#elif RAV_APPLE
+    #include <mach/mach_init.h>
+    #include <mach/thread_act.h>
+    #include <mach/thread_policy.h>
+    #include <pthread.h>
+#elif RAV_LINUX
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace rav {
+
+/**
+ * Pins the calling thread to given core. On Linux and Windows the thread will only be scheduled on that core. macOS
+ * doesn't support pinning, so there the core is passed as an affinity tag, which is a hint to keep threads with
+ * different tags on different L2 caches.
+ * @param core The index of the core.
+ * @return True if the affinity was set, or false if not.
+ */
+[[nodiscard]] inline bool set_current_thread_affinity(const size_t core) {
+#if RAV_WINDOWS
+    if (core >= sizeof(DWORD_PTR) * 8) {
+        return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR {1} << core) != 0;
+#elif RAV_APPLE
+    thread_affinity_policy_data_t policy {static_cast<integer_t>(core + 1)};  // Tag 0 means no affinity
+    const auto result = thread_policy_set(
+        pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY, reinterpret_cast<thread_policy_t>(&policy),
+        THREAD_AFFINITY_POLICY_COUNT
+    );
+    return result == KERN_SUCCESS;
+#elif RAV_LINUX
+    if (core >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    std::ignore = core;
+    return false;
+#endif
+}
+
+}  // namespace rav
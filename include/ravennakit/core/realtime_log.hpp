@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/format.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <new>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#define RAV_LOG_REALTIME_IMPL(level, ...)                                                                              \
+    do {                                                                                                               \
+        static ::rav::RealtimeLogger::CallSite rav_log_call_site;                                                      \
+        ::rav::RealtimeLogger::get_instance().log(rav_log_call_site, level, __VA_ARGS__);                              \
+    } while (false)
+
+/*
+ * Logging macros which are safe to use from realtime threads. Messages are pushed into a lock-free queue and written by
+ * a background thread using the regular RAV_LOG_* macros. Repeated messages from the same call site are rate limited.
+ */
+#define RAV_LOG_CRITICAL_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::critical, __VA_ARGS__)
+#define RAV_LOG_ERROR_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::error, __VA_ARGS__)
+#define RAV_LOG_WARNING_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::warning, __VA_ARGS__)
+#define RAV_LOG_INFO_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::info, __VA_ARGS__)
+#define RAV_LOG_DEBUG_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::debug, __VA_ARGS__)
+#define RAV_LOG_TRACE_REALTIME(...) RAV_LOG_REALTIME_IMPL(::rav::RealtimeLogger::Level::trace, __VA_ARGS__)
+
+namespace rav {
+
+/**
+ * A logger which can be used from realtime threads. Logging a message doesn't allocate, lock or do any I/O:
+ * - Arithmetic arguments are captured by value and formatted on the background thread. Other arguments (like strings)
+ *   are formatted on the calling thread into a fixed size buffer, truncating the message if it doesn't fit.
+ * - Messages are pushed into a bounded lock-free queue. When the queue is full the message is dropped and counted.
+ * - Messages from the same call site are rate limited; the number of suppressed messages is reported with the next
+ *   message which passes.
+ *
+ * The background thread is started when the instance is first accessed, so make sure to call get_instance() from a
+ * non-realtime thread before logging from realtime threads.
+ */
+class RealtimeLogger {
+  public:
+    /// The maximum size of a message (formatted text or captured arguments).
+    static constexpr size_t k_max_message_size = 256;
+
+    /// The number of messages the queue can hold. Must be a power of two.
+    static constexpr size_t k_queue_capacity = 1024;
+
+    enum class Level { critical, error, warning, info, debug, trace };
+
+    /**
+     * Holds the state of a single call site for rate limiting. Created by the RAV_LOG_*_REALTIME macros.
+     */
+    struct CallSite {
+        std::atomic<uint64_t> last_message_ns {0};
+        std::atomic<uint32_t> num_suppressed {0};
+    };
+
+    /**
+     * A function which receives the formatted messages, used instead of the RAV_LOG_* macros when set.
+     */
+    using Sink = std::function<void(Level level, const std::string& message)>;
+
+    RealtimeLogger();
+    ~RealtimeLogger();
+
+    RealtimeLogger(const RealtimeLogger&) = delete;
+    RealtimeLogger& operator=(const RealtimeLogger&) = delete;
+
+    RealtimeLogger(RealtimeLogger&&) = delete;
+    RealtimeLogger& operator=(RealtimeLogger&&) = delete;
+
+    /**
+     * Logs a message. Realtime safe, wait-free unless the queue is contended by multiple producers.
+     * @param call_site The call site, used for rate limiting.
+     * @param level The log level.
+     * @param fmt The format string, must have static storage duration (a string literal).
+     * @param args The arguments.
+     */
+    template<class... Args>
+    void log(CallSite& call_site, const Level level, fmt::format_string<Args...> fmt, Args&&... args) {
+        const auto now = clock::now_monotonic_high_resolution_ns();
+        const auto last = call_site.last_message_ns.load(std::memory_order_relaxed);
+        const auto interval_ns = rate_limit_interval_ns_.load(std::memory_order_relaxed);
+        if (last != 0 && now - last < interval_ns) {
+            call_site.num_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        call_site.last_message_ns.store(now, std::memory_order_relaxed);
+
+        Message message;
+        message.level = level;
+        message.num_suppressed = call_site.num_suppressed.exchange(0, std::memory_order_relaxed);
+
+        using Tuple = std::tuple<std::decay_t<Args>...>;
+        if constexpr ((std::is_arithmetic_v<std::decay_t<Args>> && ...) && sizeof(Tuple) <= k_max_message_size
+                      && std::is_trivially_destructible_v<Tuple>) {
+            const fmt::string_view format = fmt;
+            message.format = format.data();
+            message.format_size = format.size();
+            new (message.data.data()) Tuple(std::forward<Args>(args)...);
+            message.format_function = [](const Message& m, std::string& out) {
+                auto captured_args = *std::launder(reinterpret_cast<const Tuple*>(m.data.data()));
+                std::apply(
+                    [&](auto&... a) {
+                        fmt::vformat_to(std::back_inserter(out), fmt::string_view(m.format, m.format_size), fmt::make_format_args(a...));
+                    },
+                    captured_args
+                );
+            };
+        } else {
+            const auto result = fmt::format_to_n(message.data.data(), message.data.size(), fmt, std::forward<Args>(args)...);
+            message.size = std::min(result.size, message.data.size());
+        }
+
+        if (!push(message)) {
+            num_dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Writes all pending messages. Blocks until done.
+     */
+    void flush();
+
+    /**
+     * Sets the minimum time between two messages from the same call site. Defaults to 1 second.
+     * @param interval The interval, zero to disable rate limiting.
+     */
+    void set_rate_limit_interval(std::chrono::milliseconds interval);
+
+    /**
+     * Sets a function which receives the formatted messages. When not set, the messages are written using the RAV_LOG_*
+     * macros.
+     * @param sink The sink, or nullptr to restore the default.
+     */
+    void set_sink(Sink sink);
+
+    /**
+     * @return The number of messages dropped because the queue was full.
+     */
+    [[nodiscard]] uint64_t get_num_dropped() const;
+
+    /**
+     * @return The global instance, which is created (including its background thread) on first access.
+     */
+    static RealtimeLogger& get_instance();
+
+  private:
+    struct Message {
+        Level level {};
+        uint32_t num_suppressed {};
+        const char* format {};
+        size_t format_size {};
+        void (*format_function)(const Message&, std::string&) {};
+        size_t size {};  // The size of the formatted text in data, if format_function is nullptr
+        alignas(std::max_align_t) std::array<char, k_max_message_size> data {};
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence {};
+        Message message;
+    };
+
+    std::vector<Cell> cells_;
+    alignas(64) std::atomic<size_t> enqueue_position_ {0};
+    alignas(64) size_t dequeue_position_ {0};
+    std::atomic<uint64_t> num_dropped_ {0};
+    uint64_t num_dropped_reported_ {0};
+    std::atomic<uint64_t> rate_limit_interval_ns_ {1'000'000'000};
+
+    std::mutex consumer_mutex_;  // Guards the consumer side of the queue and the sink.
+    Sink sink_;
+
+    std::mutex thread_mutex_;
+    std::condition_variable condition_;
+    bool keep_going_ {true};
+    std::thread thread_;
+
+    bool push(const Message& message);
+    void write_pending_messages();
+    void write(Level level, const std::string& text) const;
+};
+
+}  // namespace rav
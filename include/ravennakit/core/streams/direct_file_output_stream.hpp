@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "output_stream.hpp"
+
+#include <filesystem>
+#include <memory>
+
+namespace rav {
+
+/**
+ * Options for a DirectFileOutputStream.
+ */
+struct DirectFileOutputStreamOptions {
+    /// Bypasses the page cache by opening the file with O_DIRECT (Linux) or F_NOCACHE (macOS). Falls back to buffered
+    /// writes when the file system doesn't support it.
+    bool direct_io {};
+
+    /// When non-zero, disk space is reserved ahead of the write position in steps of this many bytes (Linux only). This
+    /// keeps long recordings contiguous on disk and avoids allocating blocks on every write.
+    size_t preallocation_size {};
+
+    /// The size of the internal buffer, which is also the size of most writes to the file. Rounded up to a multiple of
+    /// the alignment.
+    size_t buffer_size {1024 * 1024};
+};
+
+/**
+ * An output stream which writes to a file in large blocks which are aligned to the block size of the disk. Data is
+ * collected in an aligned buffer and written out once the buffer is full, which allows bypassing the page cache. Parts
+ * of the file which don't cover whole blocks, like a header which is rewritten, go through the page cache instead.
+ * Thread safe: no.
+ */
+class DirectFileOutputStream final: public OutputStream {
+  public:
+    /// The alignment of the buffer and of all direct writes, which covers the logical block size of common disks.
+    static constexpr size_t k_alignment = 4096;
+
+    ~DirectFileOutputStream() override;
+
+    DirectFileOutputStream(const DirectFileOutputStream&) = delete;
+    DirectFileOutputStream& operator=(const DirectFileOutputStream&) = delete;
+
+    DirectFileOutputStream(DirectFileOutputStream&&) noexcept = delete;
+    DirectFileOutputStream& operator=(DirectFileOutputStream&&) noexcept = delete;
+
+    /**
+     * Creates a new stream, creating or truncating the file.
+     * @param file The file to write to.
+     * @param options The options of the stream.
+     * @return The stream, or nullptr if the file could not be opened or the platform is not supported.
+     */
+    [[nodiscard]] static std::unique_ptr<DirectFileOutputStream>
+    create(const std::filesystem::path& file, const DirectFileOutputStreamOptions& options);
+
+    /**
+     * @return True if whole blocks bypass the page cache.
+     */
+    [[nodiscard]] bool is_direct_io() const;
+
+    // OutputStream overrides
+    [[nodiscard]] tl::expected<void, Error> write(const uint8_t* buffer, size_t size) override;
+    [[nodiscard]] tl::expected<void, Error> set_write_position(size_t position) override;
+    [[nodiscard]] size_t get_write_position() override;
+    void flush() override;
+
+  private:
+    struct AlignedDeleter {
+        void operator()(uint8_t* ptr) const;
+    };
+
+    int fd_ {-1};
+    int direct_fd_ {-1};  // Same file, opened for writes which bypass the page cache. -1 if not available.
+    std::unique_ptr<uint8_t, AlignedDeleter> buffer_;
+    size_t buffer_size_ {};
+    size_t buffer_offset_ {};  // The file offset of the first byte of the buffer. Always aligned.
+    size_t buffer_begin_ {};   // The first byte in the buffer which is not yet written to the file.
+    size_t buffer_end_ {};     // The end of the data in the buffer.
+    size_t file_size_ {};
+    size_t preallocation_size_ {};
+    size_t preallocated_end_ {};
+
+    DirectFileOutputStream() = default;
+
+    [[nodiscard]] bool flush_buffer();
+    [[nodiscard]] bool write_to_file(int fd, const uint8_t* data, size_t size, size_t offset);
+};
+
+}  // namespace rav
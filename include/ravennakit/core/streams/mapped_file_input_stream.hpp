@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "input_stream.hpp"
+#include "ravennakit/core/platform.hpp"
+
+#include <filesystem>
+#include <memory>
+
+namespace rav {
+
+/**
+ * Options for a MappedFileInputStream.
+ */
+struct MappedFileInputStreamOptions {
+    /// Reads the whole file into memory up front, so that reading from the mapping doesn't have to wait for the disk.
+    bool populate {true};
+
+    /// Locks the mapping in RAM so that it's never paged out. Creating the stream fails if the memory lock limit of the
+    /// process is too low.
+    bool lock_memory {};
+};
+
+/**
+ * An input stream which maps a file into memory. Besides the regular InputStream interface, the contents of the file
+ * can be accessed directly through data(), without copying.
+ * Thread safe: no, but data() can be read from any thread while the stream is alive.
+ */
+class MappedFileInputStream final: public InputStream {
+  public:
+    ~MappedFileInputStream() override;
+
+    MappedFileInputStream(const MappedFileInputStream&) = delete;
+    MappedFileInputStream& operator=(const MappedFileInputStream&) = delete;
+
+    MappedFileInputStream(MappedFileInputStream&&) noexcept = delete;
+    MappedFileInputStream& operator=(MappedFileInputStream&&) noexcept = delete;
+
+    /**
+     * Maps a file into memory.
+     * @param file The file to map.
+     * @param options The options of the stream.
+     * @return The stream, or nullptr if the file could not be opened, mapped or locked.
+     */
+    [[nodiscard]] static std::unique_ptr<MappedFileInputStream>
+    create(const std::filesystem::path& file, const MappedFileInputStreamOptions& options = {});
+
+    /**
+     * @return A pointer to the contents of the file, valid as long as this stream is alive. Might be nullptr for empty
+     * files.
+     */
+    [[nodiscard]] const uint8_t* data() const;
+
+    // InputStream overrides
+    [[nodiscard]] tl::expected<size_t, Error> read(uint8_t* buffer, size_t size) override;
+    [[nodiscard]] bool set_read_position(size_t position) override;
+    [[nodiscard]] size_t get_read_position() override;
+    [[nodiscard]] std::optional<size_t> size() const override;
+    [[nodiscard]] bool exhausted() override;
+
+  private:
+    const uint8_t* data_ {};
+    size_t size_ {};
+    size_t read_position_ {};
+    bool locked_ {};
+#if RAV_WINDOWS
+    void* file_handle_ {};
+    void* mapping_handle_ {};
+#endif
+
+    MappedFileInputStream() = default;
+};
+
+}  // namespace rav
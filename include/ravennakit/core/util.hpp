@@ -30,6 +30,10 @@
 
 namespace rav {
 
+/// The assumed size of a cache line. Used to keep data which is written by different threads on separate cache lines
+/// to prevent false sharing.
+inline constexpr size_t k_cache_line_size = 64;
+
 /**
  * Returns the number of elements in a c-style array.
  * @tparam Type The type of the elements.
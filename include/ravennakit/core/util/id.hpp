@@ -117,6 +117,10 @@ class Id {
         return !(lhs == rhs);
     }
 
+    friend bool operator<(const Id& lhs, const Id& rhs) {
+        return lhs.id_ < rhs.id_;
+    }
+
     /**
      * Returns the next id from a process-wide, global generator.
      * This function is thread safe and can be safely called from any thread at any time.
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace rav {
+
+/**
+ * Options for a MemoryArena.
+ */
+struct MemoryArenaOptions {
+    /// The number of bytes to reserve. Rounded up to a multiple of the page size.
+    size_t size {};
+
+    /// The maximum number of allocations which can be alive at the same time.
+    size_t max_num_allocations {1024};
+
+    /// Backs the arena with huge pages, which reduces TLB misses. Falls back to regular pages if no huge pages are
+    /// available.
+    bool huge_pages {};
+
+    /// Locks the arena in RAM so that it's never paged out. Creating the arena fails if the memory lock limit of the
+    /// process is too low.
+    bool lock_memory {};
+};
+
+/**
+ * A region of memory which is reserved and faulted in up front, from which buffers are carved. Allocating from the
+ * arena and returning memory to it never touches the heap nor faults in new pages, which makes it suitable for buffers
+ * which are created and destroyed next to realtime threads. Blocks are handed out first fit and freed blocks are merged
+ * with their free neighbours.
+ * Thread safe: yes, but allocating and deallocating take a lock and are not meant to be called from realtime threads.
+ */
+class MemoryArena {
+  public:
+    /// The alignment of all blocks, which also keeps the buffers of different streams on separate cache lines.
+    static constexpr size_t k_alignment = 64;
+
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    MemoryArena(MemoryArena&&) noexcept = delete;
+    MemoryArena& operator=(MemoryArena&&) noexcept = delete;
+
+    /**
+     * Creates a new arena, reserving and faulting in all of its memory.
+     * @param options The options of the arena.
+     * @return The arena, or nullptr if the memory could not be reserved or locked.
+     */
+    [[nodiscard]] static std::unique_ptr<MemoryArena> create(const MemoryArenaOptions& options);
+
+    /**
+     * Allocates a block from the arena.
+     * @param size The number of bytes to allocate.
+     * @param alignment The alignment of the block, at most k_alignment.
+     * @return The block, or nullptr if the arena is exhausted.
+     */
+    [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Returns a block to the arena.
+     * @param ptr A block returned by allocate, or nullptr.
+     */
+    void deallocate(void* ptr);
+
+    /**
+     * @param ptr The pointer to check.
+     * @return True if the pointer points into the memory of this arena.
+     */
+    [[nodiscard]] bool owns(const void* ptr) const;
+
+    /**
+     * @return The total number of bytes of the arena.
+     */
+    [[nodiscard]] size_t capacity() const;
+
+    /**
+     * @return The number of bytes currently allocated, including padding.
+     */
+    [[nodiscard]] size_t bytes_allocated() const;
+
+    /**
+     * @return True if the arena is backed by huge pages.
+     */
+    [[nodiscard]] bool uses_huge_pages() const;
+
+    /**
+     * @return True if the arena is locked in RAM.
+     */
+    [[nodiscard]] bool is_locked() const;
+
+  private:
+    struct Block {
+        size_t offset {};
+        size_t size {};
+        bool free {};
+    };
+
+    uint8_t* data_ {};
+    size_t capacity_ {};
+    bool huge_pages_ {};
+    bool locked_ {};
+    mutable std::mutex mutex_;
+    std::vector<Block> blocks_;  // Sorted by offset and covering the whole arena. Reserved up front.
+    size_t bytes_allocated_ {};
+    size_t num_allocations_ {};
+    size_t max_num_allocations_ {};
+
+    MemoryArena() = default;
+};
+
+/**
+ * An allocator for standard containers which takes its memory from a MemoryArena. Without an arena, or when the arena
+ * is exhausted, the memory comes from the heap. The allocator propagates on assignment, so assigning an empty container
+ * with another allocator moves a container to another arena.
+ * @tparam T The type to allocate.
+ */
+template<class T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    ArenaAllocator() = default;
+
+    explicit ArenaAllocator(MemoryArena* arena) : arena_(arena) {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    [[nodiscard]] T* allocate(const size_t n) {
+        static_assert(alignof(T) <= MemoryArena::k_alignment);
+        if (arena_ != nullptr) {
+            if (auto* ptr = arena_->allocate(n * sizeof(T), alignof(T))) {
+                return static_cast<T*>(ptr);
+            }
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, const size_t n) {
+        if (arena_ != nullptr && arena_->owns(ptr)) {
+            arena_->deallocate(ptr);
+            return;
+        }
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    /**
+     * @return The arena of this allocator, or nullptr if the allocator uses the heap.
+     */
+    [[nodiscard]] MemoryArena* arena() const {
+        return arena_;
+    }
+
+    template<class U>
+    friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+        return lhs.arena_ == rhs.arena();
+    }
+
+    template<class U>
+    friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+        return lhs.arena_ != rhs.arena();
+    }
+
+  private:
+    MemoryArena* arena_ {};
+};
+
+/**
+ * A vector which takes its memory from a MemoryArena.
+ */
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace rav
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/platform.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace rav {
+
+/**
+ * A named region of memory which can be mapped by multiple processes. The region is created by one process, which owns
+ * the name, and opened by others. On POSIX systems the region is a POSIX shared memory object (shm_open), on Windows a
+ * named file mapping backed by the page file. The memory is zero initialized when created.
+ * Thread safe: no, but the memory itself can be accessed from any thread and process while the object is alive.
+ */
+class SharedMemory {
+  public:
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    SharedMemory(SharedMemory&&) noexcept = delete;
+    SharedMemory& operator=(SharedMemory&&) noexcept = delete;
+
+    /**
+     * Creates a new region. The name is removed again when the returned object is destroyed, processes which opened the
+     * region keep their mapping.
+     * @param name The name of the region, without a leading slash. Must not exist yet.
+     * @param size The size of the region in bytes.
+     * @param lock_memory Locks the region in RAM so that it's never paged out.
+     * @return The region, or nullptr if the region could not be created, mapped or locked.
+     */
+    [[nodiscard]] static std::unique_ptr<SharedMemory> create(const std::string& name, size_t size, bool lock_memory = false);
+
+    /**
+     * Opens a region which was created by another process (or by this process).
+     * @param name The name of the region, without a leading slash.
+     * @return The region, or nullptr if the region doesn't exist or could not be mapped.
+     */
+    [[nodiscard]] static std::unique_ptr<SharedMemory> open(const std::string& name);
+
+    /**
+     * @return A pointer to the start of the region, aligned to the page size.
+     */
+    [[nodiscard]] uint8_t* data() const;
+
+    /**
+     * @return The size of the region in bytes. For regions which were opened on Windows this is rounded up to the page
+     * size.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return The name of the region.
+     */
+    [[nodiscard]] const std::string& name() const;
+
+    /**
+     * @return True if this object created the region.
+     */
+    [[nodiscard]] bool is_owner() const;
+
+  private:
+    std::string name_;
+    uint8_t* data_ {};
+    size_t size_ {};
+    bool owner_ {};
+    bool locked_ {};
+#if RAV_WINDOWS
+    void* mapping_handle_ {};
+#endif
+
+    SharedMemory() = default;
+};
+
+}  // namespace rav
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/expected.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef RAV_ENABLE_TRACE_BUFFER
+    #define RAV_ENABLE_TRACE_BUFFER 1
+#endif
+
+#define RAV_TRACE_CONCAT_IMPL(a, b) a##b
+#define RAV_TRACE_CONCAT(a, b) RAV_TRACE_CONCAT_IMPL(a, b)
+
+#if RAV_ENABLE_TRACE_BUFFER
+    #define RAV_TRACE_ZONE_SCOPED                                                                                      \
+        static constexpr ::rav::trace::SourceLocation RAV_TRACE_CONCAT(rav_trace_location_, __LINE__) {                \
+            __func__, __FILE__, __LINE__                                                                               \
+        };                                                                                                             \
+        const ::rav::trace::ScopedZone RAV_TRACE_CONCAT(rav_trace_zone_, __LINE__)(&RAV_TRACE_CONCAT(rav_trace_location_, __LINE__))
+    #define RAV_TRACE_PLOT(name, value)                                                                                \
+        do {                                                                                                           \
+            static constexpr ::rav::trace::SourceLocation rav_trace_location {name, __FILE__, __LINE__};              \
+            ::rav::trace::record_plot(&rav_trace_location, static_cast<double>(value));                                \
+        } while (false)
+    #define RAV_TRACE_MESSAGE(message)                                                                                 \
+        do {                                                                                                           \
+            static constexpr ::rav::trace::SourceLocation rav_trace_location {message, __FILE__, __LINE__};           \
+            ::rav::trace::record_message(&rav_trace_location);                                                        \
+        } while (false)
+    #define RAV_TRACE_ANOMALY(reason)                                                                                  \
+        do {                                                                                                           \
+            static constexpr ::rav::trace::SourceLocation rav_trace_location {reason, __FILE__, __LINE__};            \
+            ::rav::trace::report_anomaly(&rav_trace_location);                                                        \
+        } while (false)
+    #define RAV_TRACE_SET_THREAD_NAME(name) ::rav::trace::set_thread_name(name)
+    #define RAV_TRACE_REGISTER_THREAD() ::rav::trace::register_thread()
+#else
+    #define RAV_TRACE_ZONE_SCOPED
+    #define RAV_TRACE_PLOT(...)
+    #define RAV_TRACE_MESSAGE(...)
+    #define RAV_TRACE_ANOMALY(...)
+    #define RAV_TRACE_SET_THREAD_NAME(...)
+    #define RAV_TRACE_REGISTER_THREAD()
+#endif
+
+/**
+ * Always-on, low overhead event tracing. Every thread writes fixed size events into its own ring buffer, which holds
+ * the most recent events. The buffers can be dumped on demand, or automatically after an anomaly was reported, as
+ * Chrome trace JSON (load in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Only threads which registered through register_thread() or set_thread_name() record events, events recorded on other
+ * threads are dropped. Registering locks and allocates, so it should happen before a realtime thread enters its loop.
+ * Recording an event is wait-free and never allocates.
+ */
+namespace rav::trace {
+
+/**
+ * Static information about the place where an event is recorded. Instances are created by the RAV_TRACE_* macros and
+ * have static storage duration, so events only have to store a pointer.
+ */
+struct SourceLocation {
+    const char* name;
+    const char* file;
+    uint32_t line;
+};
+
+enum class EventType : uint8_t {
+    /// A zone with a begin time and a duration.
+    zone,
+    /// A numeric value.
+    plot,
+    /// A message without a value.
+    message,
+    /// A message which also triggers a dump of the trace buffers.
+    anomaly,
+};
+
+/**
+ * A recorded event.
+ */
+struct Event {
+    uint64_t timestamp_ns {};  // Monotonic time.
+    uint64_t payload {};       // The duration in ns for zones, the bits of a double for plots.
+    const SourceLocation* location {};
+    EventType type {};
+};
+
+/**
+ * A fixed size ring buffer of events with a single writer (the owning thread) and any number of readers. Readers never
+ * block the writer; events which are overwritten while being read are discarded.
+ */
+class ThreadBuffer {
+  public:
+    /// The number of events each thread keeps (2 MiB), which covers a few seconds of a busy network thread. Must be a
+    /// power of two.
+    static constexpr size_t k_capacity = 65536;
+
+    explicit ThreadBuffer(uint64_t thread_id);
+
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+    ThreadBuffer(ThreadBuffer&&) = delete;
+    ThreadBuffer& operator=(ThreadBuffer&&) = delete;
+
+    /**
+     * Writes an event to the buffer, overwriting the oldest event when full. Must only be called from the owning thread.
+     */
+    void write(const Event& event) {
+        const auto index = write_index_.load(std::memory_order_relaxed);
+        auto& slot = slots_[index & (k_capacity - 1)];
+        // Release, so that a reader which sees (part of) this event also sees the updated write index.
+        slot.timestamp_ns.store(event.timestamp_ns, std::memory_order_release);
+        slot.payload.store(event.payload, std::memory_order_release);
+        slot.location.store(event.location, std::memory_order_release);
+        slot.type.store(event.type, std::memory_order_release);
+        write_index_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Thread safe.
+     * @return A copy of the events currently in the buffer, oldest first.
+     */
+    [[nodiscard]] std::vector<Event> read() const;
+
+    /**
+     * @return The id of the thread owning this buffer.
+     */
+    [[nodiscard]] uint64_t get_thread_id() const;
+
+    /**
+     * Thread safe.
+     * @return The name of the thread owning this buffer.
+     */
+    [[nodiscard]] std::string get_thread_name() const;
+
+    /**
+     * Sets the name of the thread owning this buffer. Thread safe.
+     */
+    void set_thread_name(const std::string& name);
+
+  private:
+    struct Slot {
+        std::atomic<uint64_t> timestamp_ns {};
+        std::atomic<uint64_t> payload {};
+        std::atomic<const SourceLocation*> location {};
+        std::atomic<EventType> type {};
+    };
+
+    const uint64_t thread_id_;
+    std::vector<Slot> slots_;
+    std::atomic<uint64_t> write_index_ {0};
+    mutable std::mutex thread_name_mutex_;
+    std::string thread_name_;
+};
+
+/**
+ * Creates and registers the buffer of the calling thread, if that didn't happen yet. Locks and allocates on the first
+ * call, so realtime threads should call this before entering their loop.
+ * @return The buffer of the calling thread.
+ */
+ThreadBuffer& register_thread();
+
+/**
+ * Wait-free.
+ * @return The buffer of the calling thread, or nullptr if the thread isn't registered.
+ */
+ThreadBuffer* get_thread_buffer();
+
+/**
+ * Enables or disables recording of events. Enabled by default.
+ */
+void set_enabled(bool enabled);
+
+/**
+ * @return True if events are being recorded.
+ */
+[[nodiscard]] bool is_enabled();
+
+/**
+ * Records a zone which started at begin_ns and ended now. Wait-free.
+ */
+void record_zone(const SourceLocation* location, uint64_t begin_ns);
+
+/**
+ * Records a numeric value. Wait-free.
+ */
+void record_plot(const SourceLocation* location, double value);
+
+/**
+ * Records a message. Wait-free.
+ */
+void record_message(const SourceLocation* location);
+
+/**
+ * Records an anomaly and requests a dump of the trace buffers, which will be written by the next call to
+ * process_pending_dump(). Requests are rate limited. Wait-free.
+ */
+void report_anomaly(const SourceLocation* location);
+
+/**
+ * Sets the name of the calling thread, which is used in the trace output. Also registers the thread, see
+ * register_thread().
+ */
+void set_thread_name(const char* name);
+
+/**
+ * Records a zone for the lifetime of this object. When recording is disabled, or the thread isn't registered, the zone
+ * costs no clock reads.
+ */
+class ScopedZone {
+  public:
+    explicit ScopedZone(const SourceLocation* location) :
+        location_(location), buffer_(is_enabled() ? get_thread_buffer() : nullptr) {
+        if (buffer_ != nullptr) {
+            begin_ns_ = clock::now_monotonic_high_resolution_ns();
+        }
+    }
+
+    ~ScopedZone() {
+        if (buffer_ != nullptr) {
+            const auto end_ns = clock::now_monotonic_high_resolution_ns();
+            buffer_->write({begin_ns_, end_ns - begin_ns_, location_, EventType::zone});
+        }
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+    ScopedZone(ScopedZone&&) = delete;
+    ScopedZone& operator=(ScopedZone&&) = delete;
+
+  private:
+    const SourceLocation* location_;
+    ThreadBuffer* buffer_;
+    uint64_t begin_ns_ {};
+};
+
+/**
+ * Converts the contents of all thread buffers to Chrome trace JSON. Thread safe, but allocates.
+ * @return The trace as JSON string.
+ */
+[[nodiscard]] std::string to_chrome_trace_json();
+
+/**
+ * Writes the contents of all thread buffers as Chrome trace JSON to the given file.
+ * @param path The file to write to.
+ * @return An error message if the file couldn't be written.
+ */
+[[nodiscard]] tl::expected<void, std::string> dump_to_file(const std::filesystem::path& path);
+
+/**
+ * Sets the directory where dumps triggered by anomalies are written. An empty path (the default) disables these dumps.
+ */
+void set_anomaly_dump_directory(const std::filesystem::path& directory);
+
+/**
+ * Sets the minimum time between two dumps triggered by anomalies. Defaults to 10 seconds.
+ */
+void set_anomaly_dump_interval(std::chrono::milliseconds interval);
+
+/**
+ * Writes the dump requested by report_anomaly(), if any. Should be called periodically from a non-realtime thread.
+ * @return The path of the written file, or an empty path if nothing was written.
+ */
+std::filesystem::path process_pending_dump();
+
+}  // namespace rav::trace
@@ -26,6 +26,9 @@
 
 #include "ravennakit/core/warnings.hpp"
 #include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/util/trace.hpp"
+
+// Besides Tracy (when enabled), these macros also record into the always-on trace buffer (see trace.hpp).
 
 #if defined(TRACY_ENABLE) && TRACY_ENABLE
     #if RAV_APPLE
@@ -36,17 +39,35 @@ RAV_BEGIN_IGNORE_WARNINGS
     #include <tracy/Tracy.hpp>
 RAV_END_IGNORE_WARNINGS
 
-    #define TRACY_ZONE_SCOPED ZoneScoped  // NOLINT(bugprone-reserved-identifier)
-    #define TRACY_PLOT(name, value) TracyPlot(name, value)
-    #define TRACY_MESSAGE(message) TracyMessageL(message)
-    #define TRACY_MESSAGE_COLOR(message, color) TracyMessageLC(message, color)
-    #define TRACY_SET_THREAD_NAME(name) tracy::SetThreadName(name)
+    #define TRACY_ZONE_SCOPED                                                                                          \
+        ZoneScoped;                                                                                                    \
+        RAV_TRACE_ZONE_SCOPED  // NOLINT(bugprone-reserved-identifier)
+    #define TRACY_PLOT(name, value)                                                                                    \
+        do {                                                                                                           \
+            TracyPlot(name, value);                                                                                    \
+            RAV_TRACE_PLOT(name, value);                                                                               \
+        } while (false)
+    #define TRACY_MESSAGE(message)                                                                                     \
+        do {                                                                                                           \
+            TracyMessageL(message);                                                                                    \
+            RAV_TRACE_MESSAGE(message);                                                                                \
+        } while (false)
+    #define TRACY_MESSAGE_COLOR(message, color)                                                                        \
+        do {                                                                                                           \
+            TracyMessageLC(message, color);                                                                            \
+            RAV_TRACE_MESSAGE(message);                                                                                \
+        } while (false)
+    #define TRACY_SET_THREAD_NAME(name)                                                                                \
+        do {                                                                                                           \
+            tracy::SetThreadName(name);                                                                                \
+            RAV_TRACE_SET_THREAD_NAME(name);                                                                           \
+        } while (false)
 #else
-    #define TRACY_ZONE_SCOPED
-    #define TRACY_PLOT(...)
-    #define TRACY_MESSAGE(...)
-    #define TRACY_MESSAGE_COLOR(...)
-    #define TRACY_SET_THREAD_NAME(...)
+    #define TRACY_ZONE_SCOPED RAV_TRACE_ZONE_SCOPED
+    #define TRACY_PLOT(name, value) RAV_TRACE_PLOT(name, value)
+    #define TRACY_MESSAGE(message) RAV_TRACE_MESSAGE(message)
+    #define TRACY_MESSAGE_COLOR(message, color) RAV_TRACE_MESSAGE(message)
+    #define TRACY_SET_THREAD_NAME(name) RAV_TRACE_SET_THREAD_NAME(name)
 #endif
 
 namespace rav {
@@ -129,7 +129,7 @@ struct Timestamp {
             return std::nullopt;
         }
         const auto nanoseconds = parser.read_int<uint32_t>();
-        if (!nanoseconds) {
+        if (!nanoseconds || *nanoseconds >= 1'000'000'000) {
             return std::nullopt;
         }
         if (!parser.exhausted()) {
@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include "ravennakit/core/json.hpp"
+#include "ravennakit/nmos/detail/nmos_timestamp.hpp"
+
 namespace rav::nmos {
 
 struct Activation {
@@ -86,10 +89,11 @@ inline void tag_invoke(const boost::json::value_from_tag&, boost::json::value& j
 
 inline Activation tag_invoke(const boost::json::value_to_tag<Activation>&, const boost::json::value& jv) {
     Activation act;
-    if (const auto result = jv.try_at("mode")) {
+    // A null mode unlocks the staged endpoint, cancelling a scheduled activation.
+    if (const auto result = jv.try_at("mode"); result && !result->is_null()) {
         act.mode = boost::json::value_to<Activation::Mode>(*result);
     }
-    if (const auto result = jv.try_at("requested_time")) {
+    if (const auto result = jv.try_at("requested_time"); result && !result->is_null()) {
         act.requested_time = boost::json::value_to<Timestamp>(*result);
     }
     return act;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "nmos_activation_response.hpp"
 #include "nmos_api_error.hpp"
 #include "nmos_resource_core.hpp"
 
@@ -65,8 +66,23 @@ struct ReceiverCore: ResourceCore {
     /// Object indicating how this Receiver is currently configured to receive data.
     Subscription subscription;
 
+    /// The activation reported by the staged endpoint, set while a scheduled activation is pending.
+    ActivationResponse staged_activation;
+
+    /// The activation reported by the active endpoint, which is the most recent completed activation.
+    ActivationResponse active_activation;
+
     std::function<tl::expected<void, ApiError>(const boost::json::value& patch_request)> on_patch_request;
     std::function<tl::expected<sdp::SessionDescription, ApiError>()> get_transport_file;
+
+    /// Prepares the changes of a PATCH request to be applied at the given absolute TAI time. When the activation
+    /// completed, staged_activation should be cleared and active_activation set. When not set, scheduled activations are
+    /// refused.
+    std::function<tl::expected<void, ApiError>(const boost::json::value& patch_request, const Timestamp& activation_time)>
+        on_scheduled_patch_request;
+
+    /// Discards the changes of a pending scheduled activation.
+    std::function<void()> on_cancel_scheduled_activation;
 };
 
 inline void tag_invoke(const boost::json::value_from_tag&, boost::json::value& jv, const ReceiverCore::Subscription& subscription) {
@@ -115,6 +115,12 @@ class Node: public ptp::Instance::Subscriber {
     SafeFunction<void(const Status& status, const StatusInfo& status_info)> on_status_changed;
     SafeFunction<void(const Configuration& config)> on_configuration_changed;
 
+    /// Called before the PATCH requests of a bulk request of the Connection API are applied.
+    SafeFunction<void()> on_bulk_request_begin;
+
+    /// Called after the PATCH requests of a bulk request were applied, so that the resulting changes can be applied as one batch.
+    SafeFunction<void()> on_bulk_request_end;
+
     explicit Node(
         boost::asio::io_context& io_context, ptp::Instance& ptp_instance, std::unique_ptr<RegistryBrowserBase> registry_browser = nullptr,
         std::unique_ptr<HttpClientBase> http_client = nullptr
@@ -150,6 +156,13 @@ class Node: public ptp::Instance::Subscriber {
      */
     [[nodiscard]] boost::asio::ip::tcp::endpoint get_local_endpoint() const;
 
+    /**
+     * Gives access to the HTTP server which serves the NMOS APIs. Can be used to add additional routes (for example
+     * /metrics). Note that the server only runs while the node is enabled.
+     * @return The HTTP server of this node.
+     */
+    [[nodiscard]] HttpServer& get_http_server();
+
     /**
      * Adds the given device to the node or updates an existing device if it already exists (based on the uuid).
      * The node if of the device is set to the node's uuid.
@@ -204,7 +217,7 @@ class Node: public ptp::Instance::Subscriber {
      * @param uuid The uuid of the receiver to find.
      * @return A pointer to the receiver if found, or nullptr if not found.
      */
-    [[nodiscard]] const ReceiverAudio* find_receiver(const boost::uuids::uuid& uuid) const;
+    [[nodiscard]] ReceiverAudio* find_receiver(const boost::uuids::uuid& uuid) const;
 
     /**
      * Removes a receiver from the node by its uuid.
@@ -46,6 +46,7 @@ class RequestResponseDelaySequence {
         awaiting_follow_up,
         ready_to_be_scheduled,
         delay_req_send_scheduled,
+        delay_req_sending,
         awaiting_delay_resp,
         delay_resp_received,
     };
@@ -144,6 +145,16 @@ class RequestResponseDelaySequence {
         return scheduled_send_time_;
     }
 
+    /**
+     * Marks the delay request message as handed over for sending, when the send time is only known later.
+     * Sets the state to delay_req_sending.
+     */
+    void set_delay_req_sending() {
+        TRACY_ZONE_SCOPED;
+        RAV_ASSERT(state_ == state::delay_req_send_scheduled, "State should be delay_req_send_scheduled");
+        state_ = state::delay_req_sending;
+    }
+
     /**
      * Sets the time the delay request message was sent.
      * Sets the state to awaiting_delay_resp.
@@ -151,7 +162,10 @@ class RequestResponseDelaySequence {
      */
     void set_delay_req_sent_time(const Timestamp& sent_at) {
         TRACY_ZONE_SCOPED;
-        RAV_ASSERT(state_ == state::delay_req_send_scheduled, "State should be delay_req_send_scheduled");
+        RAV_ASSERT(
+            state_ == state::delay_req_send_scheduled || state_ == state::delay_req_sending,
+            "State should be delay_req_send_scheduled or delay_req_sending"
+        );
         t3_ = sent_at;
         state_ = state::awaiting_delay_resp;
     }
@@ -231,6 +245,8 @@ class RequestResponseDelaySequence {
                 return "ready_to_be_scheduled";
             case state::delay_req_send_scheduled:
                 return "delay_req_send_scheduled";
+            case state::delay_req_sending:
+                return "delay_req_sending";
             case state::awaiting_delay_resp:
                 return "awaiting_delay_resp";
             case state::delay_resp_received:
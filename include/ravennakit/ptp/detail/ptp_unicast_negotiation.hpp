@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/ptp/messages/ptp_signaling_message.hpp"
+#include "ravennakit/ptp/types/ptp_port_identity.hpp"
+
+#include <boost/asio.hpp>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace rav::ptp {
+
+/**
+ * A master from which this port requests unicast transmission, together with the message rates to request from it.
+ */
+struct UnicastMaster {
+    boost::asio::ip::address_v4 address;
+    int8_t log_announce_interval {1};
+    int8_t log_sync_interval {-3};
+    int8_t log_delay_resp_interval {-3};
+    uint32_t duration {60};  // The requested grant duration in seconds. IEEE1588-2019: 16.1.4.1.5 recommends 10-1000.
+
+    friend bool operator==(const UnicastMaster& lhs, const UnicastMaster& rhs) {
+        return std::tie(lhs.address, lhs.log_announce_interval, lhs.log_sync_interval, lhs.log_delay_resp_interval, lhs.duration)
+            == std::tie(rhs.address, rhs.log_announce_interval, rhs.log_sync_interval, rhs.log_delay_resp_interval, rhs.duration);
+    }
+
+    friend bool operator!=(const UnicastMaster& lhs, const UnicastMaster& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * Implements the requesting side of unicast message negotiation (IEEE1588-2019: 16.1) for a single port. Requests
+ * Announce, Sync and Delay_Resp messages from each configured master, renews grants before they expire, and falls back
+ * to a lower message rate when a master denies a request.
+ * The class doesn't do any I/O. Signaling messages are handed to the send function and the caller drives the timing by
+ * calling process() periodically.
+ */
+class UnicastNegotiation {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using SendFunction = std::function<void(const boost::asio::ip::address_v4& destination, const SignalingMessage& message)>;
+
+    /// The interval at which requests are repeated while no grant is received.
+    static constexpr auto k_request_retry_interval = std::chrono::seconds(2);
+
+    /// The highest log inter message period to fall back to when a master denies requests.
+    static constexpr int8_t k_max_log_inter_message_period = 4;
+
+    /// The message types which are requested from each master.
+    static constexpr std::array<MessageType, 3> k_message_types {
+        MessageType::announce, MessageType::sync, MessageType::delay_resp
+    };
+
+    /**
+     * Constructs a negotiation for a port.
+     * @param port_identity The identity of the port requesting unicast transmission.
+     * @param send The function used to send signaling messages.
+     */
+    UnicastNegotiation(PortIdentity port_identity, SendFunction send);
+
+    /**
+     * Sets the masters to request unicast transmission from. Grants of masters which are no longer present are
+     * cancelled, masters whose rates changed are requested again.
+     * @param masters The masters.
+     * @param now The current time.
+     */
+    void set_masters(const std::vector<UnicastMaster>& masters, Clock::time_point now);
+
+    /**
+     * @return The configured masters.
+     */
+    [[nodiscard]] std::vector<UnicastMaster> get_masters() const;
+
+    /**
+     * Sends requests for message types which are not granted, or for grants which are due for renewal, and expires
+     * grants which weren't renewed in time.
+     * @param now The current time.
+     */
+    void process(Clock::time_point now);
+
+    /**
+     * Handles a signaling message received from a master.
+     * @param src_address The address the message was received from.
+     * @param message The message.
+     * @param now The current time.
+     */
+    void handle_signaling_message(const boost::asio::ip::address_v4& src_address, const SignalingMessage& message, Clock::time_point now);
+
+    /**
+     * Cancels all current grants.
+     */
+    void cancel_all();
+
+    /**
+     * @param address The address of the master.
+     * @param message_type The message type.
+     * @return True if the master currently grants unicast transmission of the given message type.
+     */
+    [[nodiscard]] bool is_granted(const boost::asio::ip::address_v4& address, MessageType message_type) const;
+
+    /**
+     * @param address The address of the master.
+     * @param message_type The message type.
+     * @return The granted log inter message period, or nullopt if not granted.
+     */
+    [[nodiscard]] std::optional<int8_t>
+    get_granted_log_inter_message_period(const boost::asio::ip::address_v4& address, MessageType message_type) const;
+
+    /**
+     * Finds the address of the master with given port identity, which granted unicast transmission of given message
+     * type.
+     * @param master_port_identity The port identity of the master.
+     * @param message_type The message type.
+     * @return The address of the master, or nullopt if no such grant exists.
+     */
+    [[nodiscard]] std::optional<boost::asio::ip::address_v4>
+    find_granted_master(const PortIdentity& master_port_identity, MessageType message_type) const;
+
+    /**
+     * @return True if there are no masters configured.
+     */
+    [[nodiscard]] bool empty() const;
+
+  private:
+    struct Grant {
+        MessageType message_type {};
+        int8_t requested_log_inter_message_period {};
+        std::optional<int8_t> granted_log_inter_message_period;
+        Clock::time_point granted_until {};
+        Clock::time_point next_request_time {};
+    };
+
+    struct MasterState {
+        UnicastMaster config;
+        std::optional<PortIdentity> port_identity;
+        std::array<Grant, k_message_types.size()> grants;
+    };
+
+    PortIdentity port_identity_;
+    SendFunction send_;
+    std::vector<MasterState> masters_;
+    uint16_t sequence_id_ {};
+
+    [[nodiscard]] static MasterState make_master_state(const UnicastMaster& config, Clock::time_point now);
+    [[nodiscard]] SignalingMessage make_signaling_message(const std::optional<PortIdentity>& target) const;
+    void send(const MasterState& master, SignalingMessage& message);
+    void cancel(MasterState& master);
+    static Grant* find_grant(MasterState& master, MessageType message_type);
+    static const Grant* find_grant(const MasterState& master, MessageType message_type);
+    [[nodiscard]] const MasterState* find_master(const boost::asio::ip::address_v4& address) const;
+};
+
+}  // namespace rav::ptp
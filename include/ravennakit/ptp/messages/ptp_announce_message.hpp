@@ -25,6 +25,7 @@
 #pragma once
 
 #include "ptp_message_header.hpp"
+#include "ravennakit/core/containers/byte_buffer.hpp"
 #include "ravennakit/ptp/types/ptp_clock_quality.hpp"
 #include "ravennakit/ptp/types/ptp_timestamp.hpp"
 
@@ -49,6 +50,12 @@ struct AnnounceMessage {
      */
     static tl::expected<AnnounceMessage, Error> from_data(const MessageHeader& header, BufferView<const uint8_t> data);
 
+    /**
+     * Write the ptp_announce_message to a byte buffer.
+     * @param buffer The buffer to write to.
+     */
+    void write_to(ByteBuffer& buffer) const;
+
     /**
      * @returns A string representation of the ptp_announce_message.
      */
@@ -61,7 +68,6 @@ struct AnnounceMessage {
         return header.source_port_identity.clock_identity.to_string();
     }
 
-  private:
     constexpr static size_t k_message_size = 30;  // Excluding header size
 };
 
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ptp_message_header.hpp"
+#include "ravennakit/core/expected.hpp"
+#include "ravennakit/ptp/ptp_error.hpp"
+#include "ravennakit/ptp/types/ptp_port_identity.hpp"
+
+#include <vector>
+
+namespace rav::ptp {
+
+/**
+ * TLV types used for unicast negotiation.
+ * IEEE1588-2019: 14.1.1
+ */
+enum class TlvType : uint16_t {
+    request_unicast_transmission = 0x0004,
+    grant_unicast_transmission = 0x0005,
+    cancel_unicast_transmission = 0x0006,
+    acknowledge_cancel_unicast_transmission = 0x0007,
+};
+
+const char* to_string(TlvType type);
+
+/**
+ * Represents one of the unicast negotiation TLVs. Which fields are used depends on the tlv type.
+ * IEEE1588-2019: 16.1.4
+ */
+struct UnicastNegotiationTlv {
+    TlvType tlv_type {};
+    MessageType message_type {};
+    int8_t log_inter_message_period {};  // Request and grant
+    uint32_t duration_field {};          // Request and grant, in seconds
+    bool renewal_invited {};             // Grant
+
+    /**
+     * Creates a TLV from the given data.
+     * @param data The data, starting at the tlvType field.
+     * @return The TLV, or nullopt if the TLV is not a unicast negotiation TLV (which should be skipped), or an error if
+     * the data is invalid.
+     */
+    static tl::expected<std::optional<UnicastNegotiationTlv>, Error> from_data(BufferView<const uint8_t> data);
+
+    /**
+     * Writes the TLV to a byte buffer.
+     * @param buffer The buffer to write to.
+     */
+    void write_to(ByteBuffer& buffer) const;
+
+    /**
+     * @return The size of the TLV on the wire, including the tlvType and lengthField fields.
+     */
+    [[nodiscard]] uint16_t size() const;
+
+    /**
+     * @return A string representation of the TLV.
+     */
+    [[nodiscard]] std::string to_string() const;
+
+    friend bool operator==(const UnicastNegotiationTlv& lhs, const UnicastNegotiationTlv& rhs) {
+        return std::tie(lhs.tlv_type, lhs.message_type, lhs.log_inter_message_period, lhs.duration_field, lhs.renewal_invited)
+            == std::tie(rhs.tlv_type, rhs.message_type, rhs.log_inter_message_period, rhs.duration_field, rhs.renewal_invited);
+    }
+
+    friend bool operator!=(const UnicastNegotiationTlv& lhs, const UnicastNegotiationTlv& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * A signaling message carrying unicast negotiation TLVs. Other TLVs are skipped when parsing.
+ * IEEE1588-2019: 13.12
+ */
+struct SignalingMessage {
+    constexpr static size_t k_tlv_header_size = 4;
+
+    MessageHeader header;
+    PortIdentity target_port_identity;
+    std::vector<UnicastNegotiationTlv> tlvs;
+
+    /**
+     * Create a SignalingMessage from a buffer_view.
+     * @param header The message header belonging to the message.
+     * @param data The message data. Expects it to start at the beginning of the message, excluding the header.
+     * @return A SignalingMessage if the data is valid, otherwise a ptp_error.
+     */
+    static tl::expected<SignalingMessage, Error> from_data(const MessageHeader& header, BufferView<const uint8_t> data);
+
+    /**
+     * Writes the message to a byte buffer. The message type, message length and log message interval of the header are
+     * set by this function.
+     * @param buffer The buffer to write to.
+     */
+    void write_to(ByteBuffer& buffer) const;
+
+    /**
+     * @returns A string representation of the message.
+     */
+    [[nodiscard]] std::string to_string() const;
+
+  private:
+    constexpr static size_t k_message_size = 10;  // Excluding header size and TLVs
+};
+
+}  // namespace rav::ptp
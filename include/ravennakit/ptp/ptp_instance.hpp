@@ -51,6 +51,7 @@ class Instance {
      */
     struct Configuration {
         uint8_t domain_number {};
+        std::vector<UnicastMaster> unicast_masters;  // Masters to negotiate unicast transmission with, on every port.
     };
 
     class Subscriber {
@@ -116,6 +117,17 @@ class Instance {
      */
     explicit Instance(boost::asio::io_context& io_context);
 
+    /**
+     * Constructs a PTP instance which receives the event messages (like Sync) on a separate io_context. Running that
+     * io_context on a dedicated, high priority thread keeps the receive timestamps accurate while io_context is busy
+     * with other work. The messages themselves are still processed on io_context.
+     * @param io_context The asio io context to use for general messages, timers and all state of the instance. Should be
+     * a single-threaded context.
+     * @param event_io_context The asio io context to receive event messages on. Should be a single-threaded context
+     * which outlives this instance.
+     */
+    Instance(boost::asio::io_context& io_context, boost::asio::io_context& event_io_context);
+
     ~Instance();
 
     /**
@@ -244,6 +256,12 @@ class Instance {
      */
     [[nodiscard]] Timestamp get_local_ptp_time() const;
 
+    /**
+     * @param host_time_ns A monotonic host time in nanoseconds, as returned by clock::now_monotonic_high_resolution_ns.
+     * @returns The PTP time from the local PTP clock at given host time.
+     */
+    [[nodiscard]] Timestamp get_local_ptp_time(uint64_t host_time_ns) const;
+
     /**
      * Adjusts the PTP clock of the PTP instance based on the mean delay and offset from the master.
      * @param measurement The measurement data.
@@ -252,6 +270,7 @@ class Instance {
 
   private:
     boost::asio::io_context& io_context_;
+    boost::asio::io_context& event_io_context_;
     Configuration config_;
     boost::asio::steady_timer state_decision_timer_;
     DefaultDs default_ds_;
@@ -30,17 +30,22 @@
 #include "datasets/ptp_port_ds.hpp"
 #include "detail/ptp_basic_filter.hpp"
 #include "detail/ptp_request_response_delay_sequence.hpp"
+#include "detail/ptp_unicast_negotiation.hpp"
 #include "messages/ptp_announce_message.hpp"
 #include "messages/ptp_delay_resp_message.hpp"
 #include "messages/ptp_follow_up_message.hpp"
 #include "messages/ptp_pdelay_req_message.hpp"
 #include "messages/ptp_pdelay_resp_follow_up_message.hpp"
 #include "messages/ptp_pdelay_resp_message.hpp"
+#include "messages/ptp_signaling_message.hpp"
 #include "messages/ptp_sync_message.hpp"
+#include "ravennakit/core/containers/fifo_buffer.hpp"
 #include "ravennakit/core/net/sockets/extended_udp_socket.hpp"
 #include "types/ptp_port_identity.hpp"
 
+#include <array>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -50,9 +55,18 @@ class Instance;
 
 class Port {
   public:
+    /**
+     * Constructs a port.
+     * @param parent The PTP instance this port belongs to.
+     * @param io_context The io_context to use for the general messages, timers and all state of the port.
+     * @param event_io_context The io_context to receive event messages on. Can be the same as io_context. When running
+     * on a different thread, event messages are timestamped there and handed to io_context through a lock-free fifo.
+     * @param interface_address The address of the interface to bind the port to.
+     * @param port_identity The identity of this port.
+     */
     Port(
-        Instance& parent, boost::asio::io_context& io_context, const boost::asio::ip::address_v4& interface_address,
-        PortIdentity port_identity
+        Instance& parent, boost::asio::io_context& io_context, boost::asio::io_context& event_io_context,
+        const boost::asio::ip::address_v4& interface_address, PortIdentity port_identity
     );
 
     ~Port();
@@ -112,12 +126,51 @@ class Port {
      */
     void set_interface(const boost::asio::ip::address_v4& interface_address);
 
+    /**
+     * Sets the masters to request unicast Announce, Sync and Delay_Resp messages from. Grants are renewed periodically
+     * until the master is removed again.
+     * @param masters The unicast masters, or an empty list to only use multicast.
+     */
+    void set_unicast_masters(const std::vector<UnicastMaster>& masters);
+
+    /**
+     * @return The unicast negotiation state of this port.
+     */
+    [[nodiscard]] const UnicastNegotiation& unicast_negotiation() const;
+
   private:
+    static constexpr size_t k_max_event_message_size = 256;
+    static constexpr size_t k_event_message_queue_size = 32;
+
+    /**
+     * An event message as received on the event thread, including its receive time.
+     */
+    struct EventMessage {
+        std::array<uint8_t, k_max_event_message_size> data {};
+        size_t size {};
+        boost::asio::ip::udp::endpoint src_endpoint;
+        boost::asio::ip::udp::endpoint dst_endpoint;
+        uint64_t recv_time {};
+    };
+
+    /**
+     * Shared between the port and the event socket handler, so that the handler doesn't need to access the port from the
+     * event thread. The port pointer is only accessed from io_context and is cleared when the port is destroyed.
+     */
+    struct EventMessageQueue {
+        FifoBuffer<EventMessage, Fifo::Spsc> messages {k_event_message_queue_size};
+        Port* port {};
+    };
+
     Instance& parent_;
+    boost::asio::io_context& io_context_;
+    boost::asio::io_context& event_io_context_;
     boost::asio::ip::address_v4 interface_address_;
     PortDs port_ds_;
     boost::asio::steady_timer announce_receipt_timeout_timer_;
-    ExtendedUdpSocket event_send_socket_;
+    boost::asio::steady_timer unicast_negotiation_timer_;
+    std::shared_ptr<EventMessageQueue> event_messages_;
+    std::unique_ptr<ExtendedUdpSocket> event_socket_;  // Only used from event_io_context_, also for sending.
     ExtendedUdpSocket general_send_socket_;
     ForeignMasterList foreign_master_list_;
     std::optional<AnnounceMessage> erbest_;
@@ -127,17 +180,21 @@ class Port {
     int32_t syncs_until_delay_req_ = 10;  // Number of syncs until the next delay_req message.
     ByteBuffer send_buffer_ {128};
     std::function<void(const Port&)> on_state_changed_callback_;
+    UnicastNegotiation unicast_negotiation_;
 
     boost::circular_buffer<SyncMessage> sync_messages_ {8};
     boost::circular_buffer<RequestResponseDelaySequence> request_response_delay_sequences_ {8};
 
     void handle_recv_event(const ExtendedUdpSocket::RecvEvent& event);
+    void process_event_messages();
+    void handle_delay_req_sent(WrappingUint<uint16_t> sequence_id, uint64_t sent_time);
     void handle_announce_message(const AnnounceMessage& announce_message, BufferView<const uint8_t> tlvs);
     void handle_sync_message(SyncMessage sync_message, BufferView<const uint8_t> tlvs);
     void handle_follow_up_message(const FollowUpMessage& follow_up_message, BufferView<const uint8_t> tlvs);
     void handle_delay_resp_message(const DelayRespMessage& delay_resp_message, BufferView<const uint8_t> tlvs);
     void handle_pdelay_resp_message(const PdelayRespMessage& delay_req_message, BufferView<const uint8_t> tlvs);
     void handle_pdelay_resp_follow_up_message(const PdelayRespFollowUpMessage& delay_req_message, BufferView<const uint8_t> tlvs);
+    void handle_signaling_message(const SignalingMessage& signaling_message, const boost::asio::ip::address& src_address);
 
     /**
      * Calculates the recommended state of this port.
@@ -154,6 +211,9 @@ class Port {
     void process_request_response_delay_sequence();
     void send_delay_req_message(RequestResponseDelaySequence& sequence);
 
+    void schedule_unicast_negotiation();
+    void send_signaling_message(const boost::asio::ip::address_v4& destination, const SignalingMessage& message);
+
     void set_state(State new_state);
 
     [[nodiscard]] Measurement<double> calculate_offset_from_master(const SyncMessage& sync_message) const;
@@ -29,8 +29,10 @@
 #include "ravenna_receiver.hpp"
 #include "ravenna_sender.hpp"
 #include "ravennakit/core/audio/audio_buffer_view.hpp"
+#include "ravennakit/core/metrics/prometheus_writer.hpp"
 #include "ravennakit/core/sync/realtime_shared_object.hpp"
 #include "ravennakit/core/util/id.hpp"
+#include "ravennakit/core/util/memory_arena.hpp"
 #include "ravennakit/dnssd/dnssd_advertiser.hpp"
 #include "ravennakit/nmos/nmos_node.hpp"
 #include "ravennakit/ptp/ptp_instance.hpp"
@@ -44,6 +46,11 @@ namespace rav {
 
 /**
  * This class contains all the components to act like a RAVENNA node as specified in the RAVENNA protocol.
+ *
+ * Next to the NMOS APIs, the HTTP server of the node serves the metrics in the Prometheus text format at GET /metrics,
+ * and the trace buffers as Chrome trace JSON at GET /trace (see trace.hpp). The trace only contains the events of
+ * registered threads. The node registers the threads it owns, but a thread of the host which calls the *_realtime
+ * functions has to call RAV_TRACE_REGISTER_THREAD() once before it starts calling them, because registering allocates.
  */
 class RavennaNode {
   public:
@@ -61,6 +68,34 @@ class RavennaNode {
         bool enable_dnssd_session_discovery {};
     };
 
+    /**
+     * Options for the threads which receive and send the RTP packets. The readers and writers are distributed over the
+     * threads, each thread serving its own shard.
+     */
+    struct NetworkThreadOptions {
+        /// The number of network threads, between 1 and rtp::AudioReceiver::k_max_num_shards.
+        size_t num_threads {1};
+
+        /// When true, network thread n is pinned to core first_core + n.
+        bool pin_to_cores {};
+
+        /// The first core to pin a network thread to.
+        size_t first_core {};
+
+        /// When set, the RTP packets are received and sent through io_uring (Linux only). Falls back to polling the
+        /// sockets when io_uring is not available.
+        std::optional<rtp::IoUringOptions> io_uring;
+
+        /// When set, the RTP packets are received from memory mapped AF_PACKET rings (Linux only, requires CAP_NET_RAW).
+        /// Falls back to polling the sockets when AF_PACKET is not available.
+        std::optional<rtp::PacketMmapOptions> packet_mmap;
+
+        /// When set, the buffers of the RTP readers and writers are carved from an arena which is reserved up front, so
+        /// that creating and destroying streams doesn't allocate from the heap. The arena is shared by the receiver and
+        /// the sender.
+        std::optional<MemoryArenaOptions> memory_arena;
+    };
+
     /**
      * Base class for classes which want to receive updates from the ravenna node.
      */
@@ -140,6 +175,13 @@ class RavennaNode {
     };
 
     explicit RavennaNode();
+
+    /**
+     * Constructs a node which receives and sends RTP packets on multiple network threads.
+     * @param network_thread_options The options for the network threads.
+     */
+    explicit RavennaNode(const NetworkThreadOptions& network_thread_options);
+
     ~RavennaNode();
 
     // MARK: Receivers
@@ -158,6 +200,23 @@ class RavennaNode {
      */
     [[nodiscard]] std::future<void> remove_receiver(Id receiver_id);
 
+    /**
+     * Creates several receivers as one transaction. The readers of all receivers are set up first, after which the
+     * multicast groups are joined in one pass, so that the time it takes grows linearly with the number of receivers.
+     * When one of the configurations can't be applied, none of the receivers is created.
+     * @param initial_configs The initial configurations of the receivers.
+     * @return A future that will be set with the IDs of the created receivers, in the order of the configurations.
+     */
+    [[nodiscard]] std::future<tl::expected<std::vector<Id>, std::string>>
+    create_receivers(std::vector<RavennaReceiver::Configuration> initial_configs);
+
+    /**
+     * Removes the receivers with the given ids as one transaction, leaving the multicast groups in one pass.
+     * @param receiver_ids The ids of the receivers to remove. Unknown ids are ignored.
+     * @return A future that will be set when the operation is complete.
+     */
+    [[nodiscard]] std::future<void> remove_receivers(std::vector<Id> receiver_ids);
+
     /**
      * Updates the configuration of the receiver with the given id.
      * @param receiver_id The id of the receiver to update.
@@ -185,6 +244,9 @@ class RavennaNode {
 
     /**
      * @copydoc rtp::AudioReceiver::read_data_realtime
+     * Each receiver can be read from its own thread. Receivers of the same streams which enable
+     * RavennaReceiver::Configuration::share_ingest may be read from different threads, but a read which overlaps with a
+     * read of another of these receivers fails instead of waiting.
      */
     [[nodiscard]] std::optional<uint32_t> read_data_realtime(
         Id receiver_id, uint8_t* buffer, size_t buffer_size, std::optional<uint32_t> at_timestamp, std::optional<uint32_t> require_delay
@@ -192,11 +254,35 @@ class RavennaNode {
 
     /**
      * @copydoc rtp::AudioReceiver::read_audio_data_realtime
+     * Each receiver can be read from its own thread. Receivers of the same streams which enable
+     * RavennaReceiver::Configuration::share_ingest may be read from different threads, but a read which overlaps with a
+     * read of another of these receivers fails instead of waiting.
      */
     [[nodiscard]] std::optional<uint32_t> read_audio_data_realtime(
         Id receiver_id, AudioBufferView<float>& output_buffer, std::optional<uint32_t> at_timestamp, std::optional<uint32_t> require_delay
     );
 
+    /**
+     * @param receiver_id The id of the receiver.
+     * @return A future that will be set with the state of the ASRC as measured during the most recent read, or nullopt if
+     * the receiver was not found.
+     */
+    [[nodiscard]] std::future<std::optional<rtp::AudioReceiver::AsrcStatus>> get_asrc_status(Id receiver_id);
+
+    /**
+     * Reads the cost accounting of a receiver without blocking the network and audio threads.
+     * @param receiver_id The id of the receiver.
+     * @return A future that will be set with the time spent on the receiver, or nullopt if the receiver was not found.
+     */
+    [[nodiscard]] std::future<std::optional<rtp::AudioReceiver::ReaderCost>> get_receiver_cost(Id receiver_id);
+
+    /**
+     * Reads the cost accounting of a sender without blocking the network and audio threads.
+     * @param sender_id The id of the sender.
+     * @return A future that will be set with the time spent on the sender, or nullopt if the sender was not found.
+     */
+    [[nodiscard]] std::future<std::optional<rtp::AudioSender::WriterCost>> get_sender_cost(Id sender_id);
+
     /**
      * Get the SDP for the sender with the given id. This function will generate the SDP based on the current state of the receiver.
      * @param sender_id The id of the sender to get the SDP for.
@@ -236,6 +322,22 @@ class RavennaNode {
      */
     [[nodiscard]] std::future<void> remove_sender(Id sender_id);
 
+    /**
+     * Creates several senders at once. All configurations are validated before the first sender is created, so when one of
+     * them is invalid none of the senders is created. No sender is enabled until all of them are configured.
+     * @param initial_configs The initial configurations of the senders.
+     * @return A future that will be set with the IDs of the created senders, in the order of the configurations.
+     */
+    [[nodiscard]] std::future<tl::expected<std::vector<Id>, std::string>>
+    create_senders(std::vector<RavennaSender::Configuration> initial_configs);
+
+    /**
+     * Removes the senders with the given ids as one transaction.
+     * @param sender_ids The ids of the senders to remove. Unknown ids are ignored.
+     * @return A future that will be set when the operation is complete.
+     */
+    [[nodiscard]] std::future<void> remove_senders(std::vector<Id> sender_ids);
+
     /**
      * Updates the configuration of the sender with the given id.
      * @param sender_id The id of the sender to update.
@@ -266,6 +368,12 @@ class RavennaNode {
      */
     [[nodiscard]] bool send_data_realtime(Id sender_id, BufferView<const uint8_t> buffer, uint32_t timestamp);
 
+    /**
+     * @copydoc rtp::AudioSender::send_data_realtime(Id, BufferView<const uint8_t>, uint32_t, AudioFormat::ByteOrder)
+     */
+    [[nodiscard]] bool
+    send_data_realtime(Id sender_id, BufferView<const uint8_t> buffer, uint32_t timestamp, AudioFormat::ByteOrder byte_order);
+
     /**
      * @copydoc rtp::AudioSender::send_audio_data_realtime
      */
@@ -308,6 +416,15 @@ class RavennaNode {
      */
     std::future<boost::uuids::uuid> get_nmos_device_id();
 
+    // MARK: Metrics
+
+    /**
+     * Collects the metrics of all receivers and senders in the Prometheus text format. The same metrics are served by
+     * the HTTP server of the NMOS node at /metrics (when the NMOS node is enabled).
+     * @return A future that will be set with the metrics.
+     */
+    [[nodiscard]] std::future<std::string> get_metrics();
+
     // MARK: RavennaNode
 
     /**
@@ -399,8 +516,10 @@ class RavennaNode {
     rtp::AudioReceiver rtp_receiver_ {io_context_};
     rtp::AudioSender rtp_sender_ {io_context_};
     std::atomic<bool> keep_going_ {true};
-    std::thread network_thread_;
+    std::vector<std::thread> network_threads_;
     std::thread maintenance_thread_;
+    boost::asio::io_context ptp_event_io_context_;  // Receives and timestamps PTP event messages on ptp_event_thread_
+    std::thread ptp_event_thread_;
     std::thread::id maintenance_thread_id_;
     Id::Generator id_generator_;
 
@@ -420,8 +539,10 @@ class RavennaNode {
     NetworkInterfaceConfig network_interface_config_;
 
     uint32_t generate_unique_session_id() const;
+    std::string collect_metrics();
     void do_maintenance() const;
     void update_ravenna_browser();
+    void run_network_thread(size_t shard, std::optional<size_t> core);
 };
 
 /**
@@ -49,6 +49,10 @@ class RavennaReceiver: public RavennaRtspClient::Subscriber {
         uint32_t delay_frames {};
         bool enabled {};
         bool auto_update_sdp {true};  // When true, the receiver will connect to the RTSP server for SDP updates.
+        bool adaptive_delay {};       // When true, the delay adapts to the network jitter, from a packet time up to delay_frames.
+        bool asrc {};                 // When true, the stream is resampled to the rate it's read at, keeping delay_frames buffered.
+        std::string shared_buffer_name;  // When set, the audio is exported to other processes through a SharedAudioBuffer.
+        bool share_ingest {};  // When true, receivers of the same streams share one ingest. See rtp::AudioReceiver::ReaderParameters.
 
         static Configuration default_config() {
             return Configuration {{}, {}, 480, true, true};
@@ -103,6 +107,16 @@ class RavennaReceiver: public RavennaRtspClient::Subscriber {
             std::ignore = stream_index;
             std::ignore = stats;
         }
+
+        /**
+         * Called periodically with the time the audio and network threads spend on the receiver.
+         * @param receiver_id The receiver for which the cost was updated.
+         * @param cost The cost accounting of the receiver.
+         */
+        virtual void ravenna_receiver_cost_updated(Id receiver_id, const rtp::AudioReceiver::ReaderCost& cost) {
+            std::ignore = receiver_id;
+            std::ignore = cost;
+        }
     };
 
     explicit RavennaReceiver(
@@ -207,6 +221,21 @@ class RavennaReceiver: public RavennaRtspClient::Subscriber {
     void on_announced(const RavennaRtspClient::AnnouncedEvent& event) override;
 
   private:
+    /// Time after the activation time after which a scheduled activation is applied without waiting for the reader to switch
+    /// over. The reader only switches while it's being read from.
+    static constexpr auto k_scheduled_activation_timeout_s = 1;
+
+    /**
+     * An IS-05 activation waiting for its activation time.
+     */
+    struct ScheduledActivation {
+        Configuration configuration;
+        std::optional<boost::uuids::uuid> sender_id;
+        nmos::Timestamp activation_time;
+        // True when the rtp reader switches to the new sessions by itself, at the RTP timestamp of the activation time.
+        bool staged_in_reader {};
+    };
+
     RavennaRtspClient& rtsp_client_;
     rtp::AudioReceiver& rtp_audio_receiver_;
     nmos::Node* nmos_node_ {nullptr};
@@ -218,11 +247,22 @@ class RavennaReceiver: public RavennaRtspClient::Subscriber {
     rtp::AudioReceiver::ReaderParameters reader_parameters_;
     std::array<rtp::AudioReceiver::StreamState, rtp::AudioReceiver::k_max_num_redundant_sessions> streams_states_ {};
     Throttle<void> stats_throttle_ {std::chrono::seconds(1)};
+    std::optional<ScheduledActivation> scheduled_activation_;
+    std::shared_ptr<rtp::SharedAudioBuffer> shared_buffer_;
 
     void handle_announced_sdp(const sdp::SessionDescription& sdp);
     tl::expected<void, std::string> update_nmos();
     tl::expected<void, std::string> update_rtsp();
+    void update_adaptive_delay();
+    void update_asrc();
+    void update_shared_buffer();
     tl::expected<void, nmos::ApiError> handle_patch_request(const boost::json::value& patch_request);
+    tl::expected<void, nmos::ApiError>
+    handle_scheduled_patch_request(const boost::json::value& patch_request, const nmos::Timestamp& activation_time);
+    [[nodiscard]] tl::expected<Configuration, nmos::ApiError> get_configuration_from_patch_request(const boost::json::value& patch_request
+    ) const;
+    void cancel_scheduled_activation();
+    bool update_scheduled_activation();
 };
 
 /**
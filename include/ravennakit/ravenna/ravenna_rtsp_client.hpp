@@ -28,6 +28,7 @@
 #include "ravennakit/dnssd/dnssd_browser.hpp"
 #include "ravennakit/rtsp/rtsp_client.hpp"
 #include "ravennakit/sdp/sdp_session_description.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 namespace rav {
 
@@ -28,6 +28,7 @@
 #include "ravennakit/core/util/uri.hpp"
 #include "ravennakit/core/containers/fifo_buffer.hpp"
 #include "ravennakit/core/util/rank.hpp"
+#include "ravennakit/core/util/throttle.hpp"
 #include "ravennakit/dnssd/dnssd_advertiser.hpp"
 #include "ravennakit/nmos/nmos_node.hpp"
 #include "ravennakit/ptp/ptp_instance.hpp"
@@ -81,6 +82,22 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
         AudioFormat audio_format;
         aes67::PacketTime packet_time;
         bool enabled {};
+        std::string shared_buffer_name;  // When set, the audio is taken from a SharedAudioBuffer written by another process.
+
+        friend bool operator==(const Configuration& lhs, const Configuration& rhs) {
+            return std::tie(
+                       lhs.session_name, lhs.destinations, lhs.ttl, lhs.payload_type, lhs.audio_format, lhs.packet_time, lhs.enabled,
+                       lhs.shared_buffer_name
+                   )
+                == std::tie(
+                       rhs.session_name, rhs.destinations, rhs.ttl, rhs.payload_type, rhs.audio_format, rhs.packet_time, rhs.enabled,
+                       rhs.shared_buffer_name
+                );
+        }
+
+        friend bool operator!=(const Configuration& lhs, const Configuration& rhs) {
+            return !(lhs == rhs);
+        }
     };
 
     class Subscriber {
@@ -91,6 +108,16 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
             std::ignore = sender_id;
             std::ignore = configuration;
         }
+
+        /**
+         * Called periodically with the time the audio and network threads spend on the sender.
+         * @param sender_id The sender for which the cost was updated.
+         * @param cost The cost accounting of the sender.
+         */
+        virtual void ravenna_sender_cost_updated(const Id sender_id, const rtp::AudioSender::WriterCost& cost) {
+            std::ignore = sender_id;
+            std::ignore = cost;
+        }
     };
 
     RavennaSender(
@@ -121,6 +148,13 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
      */
     [[nodiscard]] uint32_t get_session_id() const;
 
+    /**
+     * Checks whether the given configuration can be applied, without applying it.
+     * @param config The configuration to check.
+     * @return An error message when the configuration is invalid.
+     */
+    [[nodiscard]] static tl::expected<void, std::string> validate_configuration(const Configuration& config);
+
     /**
      * Updates the configuration of the sender.
      * @param config The configuration to update.
@@ -214,6 +248,11 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
      */
     [[nodiscard]] const nmos::Sender& get_nmos_sender() const;
 
+    /**
+     * Call regularly from the maintenance thread.
+     */
+    void do_maintenance();
+
     // rtsp_server::handler overrides
     void on_request(rtsp::Connection::RequestEvent event) const override;
 
@@ -221,6 +260,15 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
     void ptp_parent_changed(const ptp::ParentDs& parent) override;
 
   private:
+    /**
+     * An IS-05 activation waiting for its activation time.
+     */
+    struct ScheduledActivation {
+        Configuration configuration;
+        std::optional<boost::uuids::uuid> receiver_id;
+        nmos::Timestamp activation_time;
+    };
+
     rtp::AudioSender& rtp_audio_sender_;
     dnssd::Advertiser* advertiser_ {nullptr};
     rtsp::Server& rtsp_server_;
@@ -237,12 +285,44 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
     ptp::ClockIdentity grandmaster_identity_;
     NetworkInterfaceConfig network_interface_config_;
 
+    /**
+     * Everything generate_sdp() depends on.
+     */
+    struct SdpInputs {
+        Configuration configuration;
+        uint32_t session_id {};
+        int32_t clock_domain {};
+        ptp::ClockIdentity grandmaster_identity;
+        std::vector<ip_address_v4> interface_addresses;
+
+        friend bool operator==(const SdpInputs& lhs, const SdpInputs& rhs) {
+            return std::tie(lhs.configuration, lhs.session_id, lhs.clock_domain, lhs.grandmaster_identity, lhs.interface_addresses)
+                == std::tie(rhs.configuration, rhs.session_id, rhs.clock_domain, rhs.grandmaster_identity, rhs.interface_addresses);
+        }
+    };
+
+    /**
+     * The encoded SDP and the encoded response to a DESCRIBE request, which are shared by both RTSP paths. The CSeq
+     * header differs per request and is inserted between the status line and the remainder of the response.
+     */
+    struct CachedSdp {
+        SdpInputs inputs;  // The inputs the SDP was generated from. The cache is stale when these differ from the current ones.
+        std::string sdp;
+        std::string describe_response_status_line;
+        std::string describe_response_remainder;
+    };
+
+    mutable std::optional<CachedSdp> cached_sdp_;
+
     nmos::SourceAudio nmos_source_;
     nmos::FlowAudioRaw nmos_flow_;
     nmos::Sender nmos_sender_;
 
     SubscriberList<Subscriber> subscribers_;
     std::string status_message_;
+    std::optional<ScheduledActivation> scheduled_activation_;
+    std::shared_ptr<rtp::SharedAudioBuffer> shared_buffer_;
+    Throttle<void> cost_throttle_ {std::chrono::seconds(1)};
 
     /**
      * Sends an announcement request to all connected clients.
@@ -253,7 +333,18 @@ class RavennaSender: public rtsp::Server::PathHandler, public ptp::Instance::Sub
     void generate_auto_addresses_if_needed(bool notify_subscribers);
     bool generate_auto_addresses_if_needed(std::vector<Destination>& destinations) const;
     void restart_streaming() const;
+    [[nodiscard]] SdpInputs get_sdp_inputs() const;
+    [[nodiscard]] tl::expected<const CachedSdp*, std::string> get_cached_sdp() const;
+    void update_streaming() const;
+    void update_shared_buffer();
+    [[nodiscard]] rtp::AudioSender::WriterParameters get_writer_parameters() const;
     tl::expected<void, rav::nmos::ApiError> handle_patch_request(const boost::json::value& patch_request);
+    tl::expected<void, rav::nmos::ApiError>
+    handle_scheduled_patch_request(const boost::json::value& patch_request, const nmos::Timestamp& activation_time);
+    [[nodiscard]] tl::expected<Configuration, rav::nmos::ApiError>
+    get_configuration_from_patch_request(const boost::json::value& patch_request) const;
+    void cancel_scheduled_activation();
+    void update_scheduled_activation();
     void register_dnssd_session_advertisement();
 };
 
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/audio/audio_format.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rav::rtp {
+
+/**
+ * Converts between the interleaved big endian samples of RTP payloads (L16 or L24) and non-interleaved float buffers.
+ * For the channel counts of common ST 2110-30 and AES67 streams the conversion is instantiated with a constexpr frame
+ * size, so that the compiler can unroll and vectorize the loops. Other channel counts use a generic implementation.
+ */
+struct AudioPipeline {
+    /// The channel counts for which the pipeline is specialized.
+    static constexpr std::array<uint32_t, 6> k_specialized_num_channels {1, 2, 8, 16, 32, 64};
+
+    /**
+     * Converts interleaved payload data to non-interleaved float samples.
+     * @param src The payload data, num_frames * num_channels samples.
+     * @param num_frames The number of frames to convert.
+     * @param num_channels The number of channels, which must match the channel count of the pipeline.
+     * @param dst The destination channels, each holding at least num_frames samples.
+     */
+    using DecodeFunction = void (*)(const uint8_t* src, size_t num_frames, size_t num_channels, float* const* dst);
+
+    /**
+     * Converts non-interleaved float samples to interleaved payload data. Samples are clamped to [-1, 1].
+     * @param src The source channels, each holding at least num_frames samples.
+     * @param num_frames The number of frames to convert.
+     * @param num_channels The number of channels, which must match the channel count of the pipeline.
+     * @param dst The payload data to write num_frames * num_channels samples to.
+     */
+    using EncodeFunction = void (*)(const float* const* src, size_t num_frames, size_t num_channels, uint8_t* dst);
+
+    DecodeFunction decode {};
+    EncodeFunction encode {};
+    bool specialized {};  // True if the channel count is one of k_specialized_num_channels
+
+    /**
+     * @return True if the pipeline supports the format it was created for.
+     */
+    [[nodiscard]] bool is_valid() const {
+        return decode != nullptr && encode != nullptr;
+    }
+
+    /**
+     * Looks up the pipeline for the given format. The sample rate and byte order don't affect the conversion, since
+     * RTP payloads are always big endian.
+     * @param format The format of the RTP payload.
+     * @return The pipeline, which is invalid if the encoding is not L16 or L24.
+     */
+    [[nodiscard]] static AudioPipeline get(const AudioFormat& format);
+
+    /**
+     * Looks up the generic pipeline for the given format, regardless of the channel count. Used for testing and
+     * benchmarking the specialized pipelines.
+     * @param format The format of the RTP payload.
+     * @return The pipeline, which is invalid if the encoding is not L16 or L24.
+     */
+    [[nodiscard]] static AudioPipeline get_generic(const AudioFormat& format);
+};
+
+}  // namespace rav::rtp
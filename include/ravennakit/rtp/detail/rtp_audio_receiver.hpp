@@ -24,33 +24,55 @@
 
 #pragma once
 
+#include "rtp_audio_pipeline.hpp"
 #include "rtp_filter.hpp"
+#include "rtp_io_uring.hpp"
+#include "rtp_packet_mmap.hpp"
 #include "rtp_packet_stats.hpp"
 #include "rtp_ringbuffer.hpp"
 #include "rtp_session.hpp"
 #include "ravennakit/aes67/aes67_constants.hpp"
+#include "ravennakit/core/audio/audio_buffer.hpp"
 #include "ravennakit/core/audio/audio_buffer_view.hpp"
+#include "ravennakit/core/audio/audio_resampler.hpp"
 #include "ravennakit/core/math/interval_stats.hpp"
 #include "ravennakit/core/math/sliding_stats.hpp"
+#include "ravennakit/core/metrics/cost_meter.hpp"
+#include "ravennakit/core/metrics/counter.hpp"
+#include "ravennakit/core/metrics/histogram.hpp"
+#include "ravennakit/core/metrics/prometheus_writer.hpp"
 #include "ravennakit/core/net/asio/asio_helpers.hpp"
+#include "ravennakit/core/util.hpp"
 #include "ravennakit/core/sync/atomic_rw_lock.hpp"
 #include "ravennakit/core/util/id.hpp"
+#include "ravennakit/core/util/memory_arena.hpp"
 #include "ravennakit/core/util/safe_function.hpp"
 #include "ravennakit/ptp/ptp_instance.hpp"
+#include "ravennakit/rtp/rtp_shared_audio_buffer.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/container/static_vector.hpp>
 #include <boost/lockfree/spsc_value.hpp>
 
+#include <memory>
+#include <tuple>
+#include <vector>
+
 namespace rav::rtp {
 
 struct AudioReceiver {
     /// The maximum number of readers.
-    static constexpr auto k_max_num_readers = 16;
+    static constexpr auto k_max_num_readers = 256;
 
     /// The maximum number of redundant sessions per reader (redundant paths).
     static constexpr auto k_max_num_redundant_sessions = 2;  // How many redundant paths
 
+    /// The maximum number of shards. Each shard is served by its own network thread.
+    static constexpr size_t k_max_num_shards = 8;
+
+    /// The maximum number of interfaces per shard which can be received from AF_PACKET rings.
+    static constexpr size_t k_max_num_packet_mmap_interfaces = 4;
+
     /// The number of milliseconds after which a stream is considered inactive.
     static constexpr uint64_t k_receive_timeout_ms = 1000;
 
@@ -59,6 +81,28 @@ struct AudioReceiver {
     /// systems we go a bit higher. Note that this number is not the same as the delay or added latency.
     static constexpr uint32_t k_buffer_size_ms = 200;
 
+    /// The period over which the adaptive delay looks at the margin of the reads before lowering the delay.
+    static constexpr uint32_t k_adaptive_delay_window_ms = 1000;
+
+    /// The bandwidth of the control loop of the ASRC in radians per second. A lower bandwidth averages out more network
+    /// jitter, at the cost of following changes of the drift more slowly.
+    static constexpr double k_asrc_loop_bandwidth = 0.2;
+
+    /// The time constant of the low pass filter on the fill level of the ASRC in seconds.
+    static constexpr double k_asrc_fill_time_constant_s = 1.0;
+
+    /// The largest deviation of the ASRC ratio from 1 which can be configured, in parts per million.
+    static constexpr uint32_t k_asrc_max_deviation_ppm = 10'000;
+
+    /// The number of frames the ASRC produces per pass of the resampler. Larger reads are split into multiple passes.
+    static constexpr uint32_t k_asrc_block_frames = 512;
+
+    /// The upper bounds of the packet interval histogram buckets in milliseconds.
+    static constexpr std::array<double, 10> k_packet_interval_buckets_ms {0.0625, 0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0};
+
+    /// The upper bounds of the receive latency histogram buckets in milliseconds.
+    static constexpr std::array<double, 10> k_receive_latency_buckets_ms {0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0};
+
     using ArrayOfAddresses = std::array<ip_address_v4, k_max_num_redundant_sessions>;
 
     struct StreamInfo {
@@ -86,9 +130,13 @@ struct AudioReceiver {
     struct ReaderParameters {
         AudioFormat audio_format;
         std::array<StreamInfo, k_max_num_redundant_sessions> streams;
+        /// When true, the reader shares its ingest with the other readers of the same streams which opted in as well. Reading
+        /// a reader which shares its ingest moves the received packets of all these readers. They may be read from
+        /// different threads, in which case a read fails while a read of another of these readers is in progress.
+        bool share_ingest {};
 
         [[nodiscard]] auto tie() const {
-            return std::tie(audio_format, streams);
+            return std::tie(audio_format, streams, share_ingest);
         }
 
         friend bool operator==(const ReaderParameters& lhs, const ReaderParameters& rhs) {
@@ -112,6 +160,120 @@ struct AudioReceiver {
         }
     };
 
+    /**
+     * An update of the sessions of a reader, as part of a batch.
+     */
+    struct ReaderUpdate {
+        Id id;
+        ReaderParameters parameters;
+        ArrayOfAddresses interfaces;
+    };
+
+    /**
+     * A multicast group joined on an interface, for the socket of a port.
+     */
+    struct MulticastMembership {
+        ip_address_v4 group;
+        ip_address_v4 interface;
+        uint16_t port {};
+
+        friend bool operator==(const MulticastMembership& lhs, const MulticastMembership& rhs) {
+            return std::tie(lhs.group, lhs.interface, lhs.port) == std::tie(rhs.group, rhs.interface, rhs.port);
+        }
+
+        friend bool operator<(const MulticastMembership& lhs, const MulticastMembership& rhs) {
+            return std::tie(lhs.group, lhs.interface, lhs.port) < std::tie(rhs.group, rhs.interface, rhs.port);
+        }
+    };
+
+    /**
+     * Parameters for the adaptive delay of a reader. When enabled, the reader chooses the smallest delay (the distance
+     * between the most recent received frame and the last frame being read) which is safe given the measured network
+     * jitter, and adjusts the delay gradually by repeating or skipping a single frame per read. read_audio_data_realtime
+     * spreads that frame over the whole read by interpolation, so the output stays continuous, while read_data_realtime
+     * returns the encoded frames as they are. The frames repeated and skipped add up to an offset against the timeline of
+     * the consumer, which is kept when reading at an explicit timestamp.
+     */
+    struct AdaptiveDelayParameters {
+        /// The minimum delay in frames.
+        uint32_t min_delay_frames {};
+        /// The maximum delay in frames.
+        uint32_t max_delay_frames {};
+        /// The number of frames to keep on top of the measured jitter and the frames of a single read.
+        uint32_t margin_frames {};
+
+        [[nodiscard]] auto tie() const {
+            return std::tie(min_delay_frames, max_delay_frames, margin_frames);
+        }
+
+        friend bool operator==(const AdaptiveDelayParameters& lhs, const AdaptiveDelayParameters& rhs) {
+            return lhs.tie() == rhs.tie();
+        }
+
+        friend bool operator!=(const AdaptiveDelayParameters& lhs, const AdaptiveDelayParameters& rhs) {
+            return lhs.tie() != rhs.tie();
+        }
+
+        [[nodiscard]] bool is_valid() const {
+            return min_delay_frames <= max_delay_frames;
+        }
+    };
+
+    /**
+     * Parameters for the asynchronous sample rate conversion (ASRC) of a reader, for consumers which are clocked by a
+     * device instead of by PTP. The reader keeps the number of frames which were received but not yet played out at the
+     * target, by resampling the stream with a ratio which follows the drift between the device clock and the RTP
+     * timeline.
+     */
+    struct AsrcParameters {
+        /// The number of frames to keep buffered. Should cover the block size of the consumer and the network jitter.
+        uint32_t target_fill_frames {};
+        /// The maximum deviation of the ratio from 1 in parts per million.
+        uint32_t max_deviation_ppm {1000};
+
+        [[nodiscard]] auto tie() const {
+            return std::tie(target_fill_frames, max_deviation_ppm);
+        }
+
+        friend bool operator==(const AsrcParameters& lhs, const AsrcParameters& rhs) {
+            return lhs.tie() == rhs.tie();
+        }
+
+        friend bool operator!=(const AsrcParameters& lhs, const AsrcParameters& rhs) {
+            return lhs.tie() != rhs.tie();
+        }
+
+        [[nodiscard]] bool is_valid() const {
+            return target_fill_frames >= AudioResampler::k_num_taps && max_deviation_ppm > 0
+                && max_deviation_ppm <= k_asrc_max_deviation_ppm;
+        }
+    };
+
+    /**
+     * The state of the ASRC of a reader, as measured during the most recent read.
+     */
+    struct AsrcStatus {
+        /// The number of frames which were received but not yet played out.
+        double fill_frames {};
+        /// The deviation of the ratio from 1 in parts per million, positive when the stream runs faster than the
+        /// consumer.
+        double ratio_deviation_ppm {};
+        /// The number of times the fill level was reset because of an underrun or overrun.
+        uint64_t num_resets {};
+    };
+
+    /**
+     * The time the audio and network threads spend on a reader, accumulated since the reader was added.
+     */
+    struct ReaderCost {
+        /// Per read by the audio thread, including the maintenance.
+        metrics::CostMeter::Snapshot read;
+        /// Per pass of moving the received packets into the receive buffer, by the audio thread.
+        metrics::CostMeter::Snapshot maintenance;
+        /// Per packet of each stream, by the network thread.
+        std::array<metrics::CostMeter::Snapshot, k_max_num_redundant_sessions> packet_processing;
+    };
+
     /**
      * The state of a reader.
      */
@@ -128,7 +290,12 @@ struct AudioReceiver {
     ~AudioReceiver();
 
     /**
-     * Adds a reader to the receiver.
+     * Adds a reader to the receiver. When share_ingest is set and an active reader which set share_ingest as well
+     * receives the same streams in the same audio format already, the new reader shares its ingest: the packets are
+     * received and buffered once, and each reader reads the shared receive buffer at its own position and delay.
+     * Outside a batch every call scans the existing readers to join the multicast groups and update the packet rings, so
+     * adding many readers one by one takes quadratic time. Add them between begin_reader_updates and
+     * commit_reader_updates to do that work once.
      * Thread safe: no.
      * @param id The id to use, must be unique.
      * @param parameters The parameters of a reader.
@@ -146,27 +313,173 @@ struct AudioReceiver {
     [[nodiscard]] bool remove_reader(Id id);
 
     /**
-     * Sets the interfaces on all readers, leaving and joining multicast groups where necessary.
+     * Updates the sessions, filters and interfaces of an existing reader without interrupting the audio. Only the
+     * streams which changed are reset. As long as one of the valid streams keeps its session and filter, the receive
+     * buffer and read position are kept so reading continues seamlessly. Otherwise the new sessions have an unrelated
+     * timeline: the buffered audio plays out until the first packet of the new sessions arrives, at which point the
+     * receive buffer is cleared and the reader restarts at that packet, like a newly added reader.
+     * Changing the audio format, the packet time or share_ingest, or the streams of a reader which shares its ingest with
+     * other readers, requires the reader to be removed and added again.
+     * Thread safe: no.
+     * @param id The id of the reader to update.
+     * @param parameters The new parameters of the reader.
+     * @param interfaces The interfaces to receive multicast sessions on.
+     * @return true if the reader was updated in place, or false if the reader doesn't exist or can't be updated in place.
+     */
+    [[nodiscard]] bool update_reader(Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces);
+
+    /**
+     * Updates the sessions, filters and interfaces of several readers in place, like update_reader, as one transaction.
+     * The changed streams of all readers switch within a single lock window, multicast groups are joined and left once for
+     * the whole batch (a group which moves from one reader to another is neither left nor joined again), and the sockets
+     * and packet rings are updated once.
+     * Thread safe: no.
+     * @param updates The updates to apply.
+     * @return For every update whether the reader was updated in place. Readers which can't be updated in place are left
+     * untouched.
+     */
+    [[nodiscard]] std::vector<bool> update_readers(const std::vector<ReaderUpdate>& updates);
+
+    /**
+     * Starts a batch of reader changes, which is completed by commit_reader_updates. The calls to update_reader are
+     * collected and applied together on commit. Whether a reader can be updated in place is still checked right away, so
+     * that the caller can fall back to restarting the reader. Readers which are added or removed during the batch get
+     * or release their slot right away, but joining and leaving multicast groups, closing sockets and updating the
+     * packet rings is done once for the whole batch on commit, so that provisioning many readers costs linear time.
+     * Thread safe: no.
+     */
+    void begin_reader_updates();
+
+    /**
+     * Applies the updates collected since begin_reader_updates as one transaction (see update_readers), and joins and
+     * leaves the multicast groups of all readers which were added, removed or updated during the batch in one pass. A
+     * group which is left by one reader and joined by another is neither left nor joined again.
+     * Thread safe: no.
+     * @return true if all updates were applied, or false if not or if begin_reader_updates wasn't called.
+     */
+    bool commit_reader_updates();
+
+    /**
+     * Schedules new sessions, filters and interfaces for an existing reader, to become active at the given RTP timestamp.
+     * The new configuration is set up right away in a free slot and starts receiving, while reading continues from the
+     * current configuration. The read which contains the activation timestamp switches to the new configuration at
+     * exactly that frame. When the activation timestamp has passed already, the next read switches. The audio format
+     * can't be changed this way. A previously scheduled update of the reader is cancelled.
+     * Thread safe: no.
+     * @param id The id of the reader to update.
+     * @param parameters The new parameters of the reader.
+     * @param interfaces The interfaces to receive multicast sessions on.
+     * @param activation_timestamp The RTP timestamp of the first frame to read from the new configuration.
+     * @return true if the update was scheduled, or false if the reader doesn't exist, the audio format differs, or there
+     * is no free slot.
+     */
+    [[nodiscard]] bool
+    schedule_reader_update(Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces, uint32_t activation_timestamp);
+
+    /**
+     * Releases the previous configuration of a reader once the audio thread switched to the scheduled update. Call this
+     * periodically while an update is scheduled.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @return The RTP timestamp of the first frame which was read from the new configuration, or nullopt if no scheduled
+     * update was activated (yet).
+     */
+    [[nodiscard]] std::optional<uint32_t> complete_scheduled_update(Id id);
+
+    /**
+     * Cancels the scheduled update of a reader which hasn't been activated yet.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @return true if a scheduled update was cancelled, or false if there was none or if it was activated already, in which
+     * case complete_scheduled_update should be called.
+     */
+    bool cancel_scheduled_update(Id id);
+
+    /**
+     * @param id The id of the reader.
+     * @return true if the reader has a scheduled update which was not completed yet.
+     */
+    [[nodiscard]] bool has_scheduled_update(Id id) const;
+
+    /**
+     * Sets the interfaces on all readers, leaving and joining multicast groups where necessary. Outside a batch this
+     * runs as a batch of its own. During a batch the groups are joined and left by commit_reader_updates.
      * @param interfaces The new interfaces to use.
      */
     [[nodiscard]] bool set_interfaces(const ArrayOfAddresses& interfaces);
 
+    /**
+     * Sets the number of shards over which the readers and their sockets are distributed. Each shard can be served by
+     * its own network thread by calling read_incoming_packets(shard). Readers using the same RTP port always end up in
+     * the same shard, so that every socket is read by exactly one thread. Call this before the network threads start.
+     * Thread safe: no.
+     * @param num_shards The number of shards, between 1 and k_max_num_shards.
+     * @return true if the number of shards was set, or false if the value is out of range or readers are active.
+     */
+    [[nodiscard]] bool set_num_shards(size_t num_shards);
+
+    /**
+     * @return The number of shards.
+     */
+    [[nodiscard]] size_t get_num_shards() const;
+
+    /**
+     * Receives the packets of every shard through io_uring instead of polling the sockets. Call this after
+     * set_num_shards and before the network threads start.
+     * Thread safe: no.
+     * @param options The options for the io_uring instances, one of which is created per shard.
+     * @return true if io_uring is used, or false if io_uring is not available in which case the sockets are polled.
+     */
+    [[nodiscard]] bool enable_io_uring(const IoUringOptions& options);
+
+    /**
+     * Receives the packets of every shard from memory mapped AF_PACKET rings (TPACKET_V3), one per shard and interface,
+     * instead of from the sockets. The kernel filters the packets on the groups and ports of the readers and hands them
+     * over in blocks. The sockets are still opened to join the multicast groups, but drop all datagrams. Requires Linux
+     * and CAP_NET_RAW. Call this after set_num_shards and before adding readers.
+     * Thread safe: no.
+     * @param options The options for the rings.
+     * @return true if the rings are used, or false if AF_PACKET is not available in which case the sockets are polled.
+     */
+    [[nodiscard]] bool enable_packet_mmap(const PacketMmapOptions& options);
+
+    /**
+     * Sets the arena from which the buffers of the readers are allocated, so that adding and removing readers doesn't
+     * allocate from the heap. The arena can be shared with other receivers and senders. When the arena is exhausted the
+     * buffers are allocated from the heap.
+     * Thread safe: no.
+     * @param arena The arena, or nullptr to allocate from the heap.
+     * @return true if the arena was set, or false if readers are active.
+     */
+    [[nodiscard]] bool set_memory_arena(std::shared_ptr<MemoryArena> arena);
+
     /**
      * Call this to read incoming packets and place the data inside a fifo for consumption. Should be called from a
-     * single high priority thread with regular short intervals.
+     * single high priority thread with regular short intervals. Reads the packets of all shards.
      */
     void read_incoming_packets();
 
+    /**
+     * Reads the incoming packets of the sockets and readers of given shard. Each shard should be served by a single
+     * high priority thread with regular short intervals. Different shards can be served concurrently.
+     * @param shard The index of the shard, less than get_num_shards().
+     */
+    void read_incoming_packets(size_t shard);
+
     /**
      * Reads data from the buffer at the given timestamp.
      *
-     * Calling this function is realtime safe and thread safe when called from a single arbitrary thread.
+     * Calling this function is realtime safe and thread safe when called from a single arbitrary thread. Readers which
+     * share their ingest (see ReaderParameters::share_ingest) may be read from different threads, but a read which
+     * overlaps with a read of another of these readers returns std::nullopt (counted as a read without data).
      *
      * @param id The id of the reader to get data from.
      * @param buffer The destination to write the data to.
      * @param buffer_size The size of the buffer in bytes.
      * @param at_timestamp The optional timestamp to read at. If nullopt, the most recent timestamp minus the delay will
-     * be used for the first read and after that the timestamp will be incremented by the packet time.
+     * be used for the first read and after that the timestamp will be incremented by the packet time. With the adaptive
+     * delay enabled, the frames it repeated and skipped so far are added to at_timestamp, so the returned timestamp
+     * differs from at_timestamp by that offset.
      * @param require_delay If set, the call to read_data_realtime will only succeed if the requested timestamp is
      * older than the most recent received timestamp - require_delay. This can be useful in a case where there is no PTP
      * clock driving time, and instead, the time of the RTP stream has to be used. In normal PTP driven operation you
@@ -180,12 +493,16 @@ struct AudioReceiver {
     /**
      * Reads the data from the receiver with the given id.
      *
-     * Calling this function is realtime safe and thread safe when called from a single arbitrary thread.
+     * Calling this function is realtime safe and thread safe when called from a single arbitrary thread. Readers which
+     * share their ingest (see ReaderParameters::share_ingest) may be read from different threads, but a read which
+     * overlaps with a read of another of these readers returns std::nullopt (counted as a read without data).
      *
      * @param id The id of the reader to get data from.
      * @param output_buffer The buffer to read the data into.
      * @param at_timestamp The optional timestamp to read at. If nullopt, the most recent timestamp minus the delay will
-     * be used for the first read and after that the timestamp will be incremented by the packet time.
+     * be used for the first read and after that the timestamp will be incremented by the packet time. With the adaptive
+     * delay enabled, the frames it repeated and skipped so far are added to at_timestamp, so the returned timestamp
+     * differs from at_timestamp by that offset.
      * @param require_delay If set, the call to read_audio_data_realtime will only succeed if the requested timestamp is
      * older than the most recent received timestamp - require_delay. This can be useful in a case where there is no PTP
      * clock driving time, and instead, the time of the RTP stream has to be used. In normal PTP driven operation you
@@ -196,6 +513,65 @@ struct AudioReceiver {
         Id id, AudioBufferView<float>& output_buffer, std::optional<uint32_t> at_timestamp, std::optional<uint32_t> require_delay
     );
 
+    /**
+     * Enables or disables the adaptive delay for the reader with given id. When enabled, the require_delay argument of
+     * read_data_realtime and read_audio_data_realtime is ignored. Changing the parameters resets the offset which is added
+     * to at_timestamp. The setting is reset when the reader is removed.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @param parameters The parameters, or nullopt to disable the adaptive delay.
+     * @return true if the reader was found and the parameters are valid, or false if not.
+     */
+    [[nodiscard]] bool set_adaptive_delay(Id id, const std::optional<AdaptiveDelayParameters>& parameters);
+
+    /**
+     * @param id The id of the reader.
+     * @return The delay in frames as measured during the most recent successful read, or nullopt if the reader was not
+     * found.
+     */
+    [[nodiscard]] std::optional<uint32_t> get_delay(Id id) const;
+
+    /**
+     * Enables or disables the ASRC for the reader with given id. When enabled, read_audio_data_realtime ignores its
+     * at_timestamp and require_delay arguments and resamples the stream so that it's consumed at the rate at which
+     * read_audio_data_realtime is called. The ratio is derived from the fill level against the RTP timeline, so the
+     * consumer doesn't need a PTP clock. The adaptive delay is suspended while the ASRC is enabled. The resampler is
+     * allocated together with the reader, so enabling it doesn't allocate. The setting is reset when the reader is
+     * removed.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @param parameters The parameters, or nullopt to disable the ASRC.
+     * @return true if the reader was found and the parameters are valid, or false if not.
+     */
+    [[nodiscard]] bool set_asrc(Id id, const std::optional<AsrcParameters>& parameters);
+
+    /**
+     * @param id The id of the reader.
+     * @return The state of the ASRC as measured during the most recent read, or nullopt if the reader was not found.
+     */
+    [[nodiscard]] std::optional<AsrcStatus> get_asrc_status(Id id) const;
+
+    /**
+     * Reads the cost accounting of a reader without blocking the network and audio threads.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @return The time spent on the reader, or nullopt if the reader was not found.
+     */
+    [[nodiscard]] std::optional<ReaderCost> get_reader_cost(Id id) const;
+
+    /**
+     * Exports the received audio of a reader to other processes through given shared buffer. The network thread writes
+     * the payload of every packet into the buffer at its RTP timestamp as soon as it arrives, so the audio is available
+     * to the other processes without a consumer calling read_data_realtime. The setting moves along with a scheduled
+     * update and is reset when the reader is removed.
+     * Thread safe: no.
+     * @param id The id of the reader.
+     * @param buffer The buffer, which must have the audio format of the reader and hold at least one packet, or nullptr
+     * to stop exporting.
+     * @return true if the reader was found and the buffer fits the reader, or false if not.
+     */
+    [[nodiscard]] bool set_shared_buffer(Id id, std::shared_ptr<SharedAudioBuffer> buffer);
+
     /**
      * @param reader_id The id of the reader to get statistics from.
      * @param stream_index The index of the stream to get stats from.
@@ -210,12 +586,22 @@ struct AudioReceiver {
      */
     [[nodiscard]] std::optional<StreamState> get_stream_state(Id reader_id, size_t stream_index) const;
 
+    /**
+     * Adds the metrics of all readers to given writer. The metrics are read without blocking the network and audio
+     * threads.
+     * @param writer The writer to add the metrics to.
+     */
+    void collect_metrics(metrics::PrometheusWriter& writer);
+
     struct SocketWithContext {
         explicit SocketWithContext(boost::asio::io_context& io_context) : socket(io_context) {}
 
         AtomicRwLock rw_lock;
         udp_socket socket;
         uint16_t port {};
+        size_t shard {};
+        uint32_t generation {};         // Incremented whenever the socket is (re)opened
+        metrics::CostMeter receive_cost;  // Receiving and processing a datagram, written by the network thread
     };
 
     struct PacketBuffer {
@@ -223,39 +609,205 @@ struct AudioReceiver {
         uint16_t seq;
         uint16_t data_len;
         uint64_t recv_time;
+        uint32_t generation;  // The session generation of the stream at the time the packet was received
         std::array<uint8_t, aes67::constants::k_max_payload> payload;
     };
 
+    /**
+     * Metrics of a stream, written by the network thread.
+     */
+    struct alignas(k_cache_line_size) NetworkThreadMetrics {
+        metrics::Counter packets_received;
+        metrics::Counter bytes_received;
+        metrics::Counter packets_discarded;  // Packets which were too big, or didn't fit the fifo because they were not consumed
+        metrics::Histogram<k_packet_interval_buckets_ms.size()> packet_interval_ms {k_packet_interval_buckets_ms};
+        metrics::Histogram<k_receive_latency_buckets_ms.size()> receive_latency_ms {k_receive_latency_buckets_ms};
+        metrics::CostMeter processing_cost;  // Processing the packets of the stream
+
+        void reset() {
+            packets_received.reset();
+            bytes_received.reset();
+            packets_discarded.reset();
+            packet_interval_ms.reset();
+            receive_latency_ms.reset();
+            processing_cost.reset();
+        }
+    };
+
+    /**
+     * Metrics of a reader, written by the audio thread.
+     */
+    struct alignas(k_cache_line_size) AudioThreadMetrics {
+        metrics::Counter reads;
+        metrics::Counter reads_without_data;
+        metrics::Counter packets_too_late;
+        metrics::Counter frames_repeated;  // By the adaptive delay, to increase the delay
+        metrics::Counter frames_skipped;   // By the adaptive delay, to decrease the delay
+        metrics::Gauge delay_frames;
+        metrics::Gauge asrc_fill_frames;
+        metrics::Gauge asrc_ratio_deviation_ppm;
+        metrics::Counter asrc_resets;
+        metrics::CostMeter read_cost;         // read_data_from_reader_realtime, which includes the maintenance
+        metrics::CostMeter maintenance_cost;  // do_realtime_maintenance, moving the packets into the receive buffer
+
+        void reset() {
+            reads.reset();
+            reads_without_data.reset();
+            packets_too_late.reset();
+            frames_repeated.reset();
+            frames_skipped.reset();
+            delay_frames.reset();
+            asrc_fill_frames.reset();
+            asrc_ratio_deviation_ppm.reset();
+            asrc_resets.reset();
+            read_cost.reset();
+            maintenance_cost.reset();
+        }
+    };
+
     struct StreamContext {
+        // Guards session, filter, packet_time_frames and interface, which are swapped by the control thread while the
+        // reader is running. The network thread skips the stream while it is locked exclusively.
+        AtomicRwLock rw_lock;
         Session session;
         Filter filter;
         uint16_t packet_time_frames {};
         std::optional<WrappingUint32> rtp_ts;
         ip_address_v4 interface;
-        FifoBuffer<PacketBuffer, Fifo::Spsc> packets;
-        FifoBuffer<uint16_t, Fifo::Spsc> packets_too_old;
+        // Incremented by the control thread whenever the session is swapped, so that the audio thread can drop the packets
+        // of the previous session which are still in the fifo.
+        std::atomic<uint32_t> session_generation {0};
+        FifoBuffer<PacketBuffer, Fifo::Spsc, ArenaAllocator<PacketBuffer>> packets;
+        FifoBuffer<uint16_t, Fifo::Spsc, ArenaAllocator<uint16_t>> packets_too_old;
         PacketStats packet_stats;
         boost::lockfree::spsc_value<PacketStats::Counters, boost::lockfree::allow_multiple_reads<true>> packet_stats_counters;
         std::atomic<bool> reset_max_values {false};
         IntervalStats packet_interval_stats;
         WrappingUint64 prev_packet_time_ns;
         std::atomic<StreamState> state {StreamState::inactive};
+        NetworkThreadMetrics network_thread_metrics;
+
+        // Envelope of the receive latency (arrival time versus PTP time of the RTP timestamp), network thread only.
+        std::optional<std::pair<double, double>> receive_latency_min_max_ms;
+        // The measured jitter in frames, written by the network thread and read by the audio thread.
+        std::atomic<uint32_t> jitter_frames {0};
+    };
+
+    /**
+     * State of the adaptive delay, owned by the audio thread.
+     */
+    struct AdaptiveDelayState {
+        std::optional<AdaptiveDelayParameters> parameters;
+        uint32_t window_frames {};                 // The number of frames read in the current window
+        std::optional<uint32_t> window_min_slack;  // The smallest margin seen in the current window
+        uint32_t frames_to_skip {};                // The number of frames to skip to lower the delay
+        int32_t offset_frames {};                  // The frames skipped minus the frames repeated, added to at_timestamp
+        int32_t correction {};                     // 1 when the latest read skipped a frame, -1 when it repeated one
+
+        void reset() {
+            parameters.reset();
+            window_frames = {};
+            window_min_slack.reset();
+            frames_to_skip = {};
+            offset_frames = {};
+            correction = {};
+        }
+    };
+
+    /**
+     * State of the ASRC, owned by the audio thread. The resampler is allocated when the reader is set up and survives
+     * reset().
+     */
+    struct AsrcState {
+        std::optional<AsrcParameters> parameters;
+        AudioResampler resampler;
+        bool primed {};            // False until the read position was placed at the target fill level
+        double filtered_error {};  // The low pass filtered difference between the fill level and the target in frames
+        double integrator {};      // The integral part of the ratio deviation
+
+        void reset() {
+            parameters.reset();
+            resampler.reset();
+            primed = false;
+            filtered_error = {};
+            integrator = {};
+        }
+    };
+
+    /**
+     * The role of a reader slot. A scheduled update is prepared in a second slot with the same id, which replaces the
+     * active slot when the audio thread reaches the activation timestamp.
+     */
+    enum class Activation : uint8_t {
+        /// The slot is read by the audio thread.
+        active,
+        /// The slot receives packets and waits for the activation timestamp.
+        staged,
+        /// The slot was replaced by a staged slot and waits to be released by the control thread.
+        retired,
+    };
+
+    /**
+     * A switch to a staged slot, published by the control thread on the active slot.
+     */
+    struct ScheduledActivation {
+        size_t staged_index {};  // The index of the staged slot in readers
+        uint32_t rtp_timestamp {};
     };
 
     /**
      * Holds the structures to receive incoming data from redundant sources into a single buffer.
+     *
+     * Readers of the same streams share the ingest: the first reader receives the packets into its receive buffer, and
+     * the readers which are added later tap that reader (the source). A tap keeps its own read position, delay and ASRC,
+     * but has no fifos or receive buffer of its own, so the memory and the work of the network thread don't grow with
+     * the number of taps. When the source is removed, the first tap takes over its ingest.
      */
     struct Reader {
         AtomicRwLock rw_lock;
         Id id;
         AudioFormat audio_format;
+        AudioPipeline pipeline;          // Converts the payload data to float
+        uint16_t packet_time_frames {};  // The smallest packet time of the streams, which determines the fifo sizes
+        size_t shard {};                 // The shard of which the network thread receives the packets for this reader
         std::array<StreamContext, k_max_num_redundant_sessions> streams;
 
+        // The reader of which this reader reads the receive buffer, or nullptr if it receives its streams itself. Written
+        // by the control thread while this reader is locked exclusively.
+        Reader* source {nullptr};
+        bool share_ingest {};           // Whether other readers may tap this reader, see ReaderParameters::share_ingest
+        std::atomic<bool> has_taps {};  // Whether other readers tap this reader, written by the control thread
+
+        // Held exclusively by the audio thread which reads from the ingest of this reader, since the readers which share
+        // the ingest may be read from different threads. Only ever try-locked, a contended read fails instead of waiting.
+        AtomicRwLock ingest_lock;
+
+        // Network thread
+        std::shared_ptr<SharedAudioBuffer> shared_buffer;  // Receives the payloads when the audio is exported
+
         // Audio thread
         Ringbuffer receive_buffer;
-        std::vector<uint8_t> read_audio_data_buffer;
+        ArenaVector<uint8_t> read_audio_data_buffer;
+        AudioBuffer<float> skipped_frame;  // The frame skipped by the adaptive delay, allocated when the reader is set up
         std::optional<WrappingUint32> most_recent_ts;  // ts of the latest received data
         WrappingUint32 next_ts_to_read;
+        AudioThreadMetrics audio_thread_metrics;
+        AdaptiveDelayState adaptive_delay;
+        AsrcState asrc;
+        bool tap_started {};     // Whether the read position of a tap was placed at the data of the source
+        bool resync_pending {};  // Whether the timeline restarts at the first packet of the new sessions
+
+        std::optional<ScheduledActivation> scheduled_activation;
+
+        // Written by the control thread, read by the audio thread
+        boost::lockfree::spsc_value<std::optional<AdaptiveDelayParameters>> adaptive_delay_parameters;
+        boost::lockfree::spsc_value<std::optional<AsrcParameters>> asrc_parameters;
+        boost::lockfree::spsc_value<std::optional<ScheduledActivation>> scheduled_activation_request;
+        boost::lockfree::spsc_value<bool> resync_request;  // Set when the sessions were swapped for unrelated ones
+
+        // Written by the audio thread when switching slots, read by the control thread
+        std::atomic<Activation> activation {Activation::active};
+        std::atomic<uint32_t> activated_at {0};  // The first timestamp read from a staged slot which became active
     };
 
     /// Function for joining a multicast group. Can be overridden to alter behaviour. Used for unit testing.
@@ -268,10 +820,49 @@ struct AudioReceiver {
 
     static constexpr auto k_max_num_sessions = k_max_num_readers * k_max_num_redundant_sessions;
 
-    boost::container::static_vector<SocketWithContext, k_max_num_sessions> sockets;
-    boost::container::static_vector<Reader, k_max_num_readers> readers;
+    std::shared_ptr<MemoryArena> memory_arena;  // Declared before the readers, which return their buffers on destruction
+
+    /**
+     * The socket and reader slots. With their metrics, cost meters and ASRC state they take up about a megabyte, so they
+     * are allocated once on construction instead of being part of the receiver, which then fits on a (Windows) stack.
+     */
+    struct Slots {
+        boost::container::static_vector<SocketWithContext, k_max_num_sessions> sockets;
+        boost::container::static_vector<Reader, k_max_num_readers> readers;
+    };
+
+    std::unique_ptr<Slots> slots {std::make_unique<Slots>()};
+    boost::container::static_vector<SocketWithContext, k_max_num_sessions>& sockets {slots->sockets};
+    boost::container::static_vector<Reader, k_max_num_readers>& readers {slots->readers};
+
+    // One past the last reader and socket slot in use. Written by the control thread, read by the network and audio threads
+    // so that they don't visit the unused slots at the end.
+    std::atomic<size_t> num_reader_slots_in_use {0};
+    std::atomic<size_t> num_socket_slots_in_use {0};
+
+    /**
+     * The AF_PACKET ring of an interface. The ring is replaced by the control thread when the interfaces change.
+     */
+    struct PacketMmapInterface {
+        AtomicRwLock rw_lock;
+        ip_address_v4 interface;
+        std::unique_ptr<PacketMmapReceiveRing> ring;
+    };
+
+    /**
+     * State which is owned by the network thread of a shard.
+     */
+    struct alignas(k_cache_line_size) ShardState {
+        uint64_t last_time_maintenance {};
+        std::unique_ptr<IoUringReceiveRing> io_uring;  // When set, packets are received through io_uring
+        std::array<PacketMmapInterface, k_max_num_packet_mmap_interfaces> packet_mmap;
+    };
 
-    uint64_t last_time_maintenance {};
+    size_t num_shards {1};
+    std::array<ShardState, k_max_num_shards> shards;
+    std::optional<PacketMmapOptions> packet_mmap_options;  // When set, packets are received from AF_PACKET rings
+    std::optional<std::vector<ReaderUpdate>> pending_reader_updates;  // Set between begin and commit_reader_updates
+    std::vector<MulticastMembership> batch_memberships;              // The groups which were joined when the batch began
 };
 
 /**
@@ -24,17 +24,25 @@
 
 #pragma once
 
+#include "rtp_audio_pipeline.hpp"
+#include "rtp_io_uring.hpp"
 #include "rtp_ringbuffer.hpp"
 #include "ravennakit/aes67/aes67_constants.hpp"
 #include "ravennakit/core/audio/audio_buffer_view.hpp"
 #include "ravennakit/core/audio/audio_format.hpp"
-#include "ravennakit/core/containers/byte_buffer.hpp"
+#include "ravennakit/core/util.hpp"
+#include "ravennakit/core/metrics/cost_meter.hpp"
+#include "ravennakit/core/metrics/counter.hpp"
+#include "ravennakit/core/metrics/prometheus_writer.hpp"
 #include "ravennakit/core/net/asio/asio_helpers.hpp"
 #include "ravennakit/core/sync/atomic_rw_lock.hpp"
 #include "ravennakit/core/util/id.hpp"
+#include "ravennakit/core/util/memory_arena.hpp"
 #include "ravennakit/rtp/rtp_packet.hpp"
+#include "ravennakit/rtp/rtp_shared_audio_buffer.hpp"
 
 #include <boost/container/static_vector.hpp>
+#include <boost/lockfree/spsc_value.hpp>
 
 namespace rav::rtp {
 
@@ -51,11 +59,14 @@ struct AudioSender {
     static constexpr auto k_supported_encodings = {AudioEncoding::pcm_s16, AudioEncoding::pcm_s24};
 
     /// The maximum number of writers.
-    static constexpr auto k_max_num_writers = 16;
+    static constexpr auto k_max_num_writers = 256;
 
     /// The maximum number of redundant sessions per stream.
     static constexpr auto k_max_num_redundant_sessions = 2;  // How many redundant paths
 
+    /// The maximum number of shards. Each shard is served by its own network thread.
+    static constexpr size_t k_max_num_shards = 8;
+
     using ArrayOfAddresses = std::array<ip_address_v4, k_max_num_redundant_sessions>;
 
     struct WriterParameters {
@@ -66,6 +77,16 @@ struct AudioSender {
         uint8_t payload_type {};
     };
 
+    /**
+     * The time the audio and network threads spend on a writer, accumulated since the writer was added.
+     */
+    struct WriterCost {
+        /// Per packet scheduled by the audio thread.
+        metrics::CostMeter::Snapshot schedule;
+        /// Per pass of the network thread which sent at least one packet of the writer.
+        metrics::CostMeter::Snapshot send;
+    };
+
     explicit AudioSender(boost::asio::io_context& io_context);
     ~AudioSender();
 
@@ -87,6 +108,59 @@ struct AudioSender {
      */
     [[nodiscard]] bool remove_writer(Id id);
 
+    /**
+     * Updates the destinations, interfaces, ttl and payload type of an existing writer without interrupting the stream.
+     * The SSRC, sequence numbers and buffered audio are kept. The new destinations are picked up by the network thread
+     * and the new payload type by the audio thread between two packets. Changing the audio format or the packet time
+     * requires the writer to be removed and added again.
+     * Thread safe: no.
+     * @param id The id of the writer to update.
+     * @param parameters The new parameters of the writer.
+     * @param interfaces The interfaces for outbound.
+     * @return true if the writer was updated in place, or false if the writer doesn't exist or can't be updated in place.
+     */
+    [[nodiscard]] bool update_writer(Id id, const WriterParameters& parameters, const ArrayOfAddresses& interfaces);
+
+    /**
+     * Schedules new destinations and a new payload type for an existing writer, to take effect at the first packet which
+     * starts at or after the given RTP timestamp. The packets before that packet are sent with the current parameters. The
+     * interfaces and ttl are socket options and change right away. Changing the audio format or the packet time requires
+     * the writer to be removed and added again. A previously scheduled update of the writer is replaced.
+     * Thread safe: no.
+     * @param id The id of the writer to update.
+     * @param parameters The new parameters of the writer.
+     * @param interfaces The interfaces for outbound.
+     * @param activation_timestamp The RTP timestamp from which the new parameters apply.
+     * @return true if the update was scheduled, or false if the writer doesn't exist or can't be updated in place.
+     */
+    [[nodiscard]] bool
+    schedule_writer_update(Id id, const WriterParameters& parameters, const ArrayOfAddresses& interfaces, uint32_t activation_timestamp);
+
+    /**
+     * Finishes a scheduled update once the network thread sent the first packet with the new parameters. Call this
+     * periodically while an update is scheduled.
+     * Thread safe: no.
+     * @param id The id of the writer.
+     * @return The RTP timestamp of the first packet sent with the new parameters, or nullopt if no scheduled update was
+     * activated (yet).
+     */
+    [[nodiscard]] std::optional<uint32_t> complete_scheduled_update(Id id);
+
+    /**
+     * Cancels the scheduled update of a writer which hasn't been activated yet.
+     * Thread safe: no.
+     * @param id The id of the writer.
+     * @return true if a scheduled update was cancelled, or false if there was none or if it was activated already, in which
+     * case complete_scheduled_update should be called.
+     */
+    bool cancel_scheduled_update(Id id);
+
+    /**
+     * @param id The id of the writer.
+     * @return true if the writer has a scheduled update which was not completed yet.
+     */
+    [[nodiscard]] bool has_scheduled_update(Id id) const;
+
     /**
      * Sets the outbound interfaces on all sockets.
      * @param interfaces The new interfaces to use.
@@ -101,12 +175,53 @@ struct AudioSender {
      */
     bool set_ttl(Id id, uint8_t ttl);
 
+    /**
+     * Sets the number of shards over which the writers are distributed. Each shard can be served by its own network
+     * thread by calling send_outgoing_packets(shard). Call this before the network threads start.
+     * Thread safe: no.
+     * @param num_shards The number of shards, between 1 and k_max_num_shards.
+     * @return true if the number of shards was set, or false if the value is out of range or writers are active.
+     */
+    [[nodiscard]] bool set_num_shards(size_t num_shards);
+
+    /**
+     * @return The number of shards.
+     */
+    [[nodiscard]] size_t get_num_shards() const;
+
+    /**
+     * Sends the packets of every shard through io_uring, batching the sends of each call to send_outgoing_packets into
+     * a single submission. Call this after set_num_shards and before the network threads start.
+     * Thread safe: no.
+     * @param options The options for the io_uring instances, one of which is created per shard.
+     * @return true if io_uring is used, or false if io_uring is not available in which case the packets are sent
+     * directly.
+     */
+    [[nodiscard]] bool enable_io_uring(const IoUringOptions& options);
+
+    /**
+     * Sets the arena from which the buffers of the writers are allocated, so that adding and removing writers doesn't
+     * allocate from the heap. The arena can be shared with other senders and receivers. When the arena is exhausted the
+     * buffers are allocated from the heap.
+     * Thread safe: no.
+     * @param arena The arena, or nullptr to allocate from the heap.
+     * @return true if the arena was set, or false if writers are active.
+     */
+    [[nodiscard]] bool set_memory_arena(std::shared_ptr<MemoryArena> arena);
+
     /**
      * Call this to send outgoing packets onto the network. Should be called from a single high priority thread with
-     * regular short intervals.
+     * regular short intervals. Sends the packets of all shards.
      */
     void send_outgoing_packets();
 
+    /**
+     * Sends the outgoing packets of the writers of given shard. Each shard should be served by a single high priority
+     * thread with regular short intervals. Different shards can be served concurrently.
+     * @param shard The index of the shard, less than get_num_shards().
+     */
+    void send_outgoing_packets(size_t shard);
+
     /**
      * Schedules data for sending. A call to this function is realtime safe and thread safe as long as only one thread
      * makes the call.
@@ -117,6 +232,20 @@ struct AudioSender {
      */
     [[nodiscard]] bool send_data_realtime(Id id, BufferView<const uint8_t> buffer, uint32_t timestamp);
 
+    /**
+     * Schedules data for sending, like send_data_realtime above. When the byte order of the data differs from the byte
+     * order of the stream, the bytes of each sample are swapped while the data is copied into the send buffer, so no
+     * separate conversion pass is needed. A call to this function is realtime safe and thread safe as long as only one
+     * thread makes the call.
+     * @param id The id of the writer.
+     * @param buffer The buffer to send.
+     * @param timestamp The timestamp of the buffer.
+     * @param byte_order The byte order of the samples in the buffer.
+     * @returns True if the buffer was sent, or false if something went wrong.
+     */
+    [[nodiscard]] bool
+    send_data_realtime(Id id, BufferView<const uint8_t> buffer, uint32_t timestamp, AudioFormat::ByteOrder byte_order);
+
     /**
      * Schedules audio data for sending. A call to this function is realtime safe and thread safe as long as only one
      * thread makes the call.
@@ -127,33 +256,134 @@ struct AudioSender {
      */
     [[nodiscard]] bool send_audio_data_realtime(Id id, const AudioBufferView<const float>& input_buffer, uint32_t timestamp);
 
+    /**
+     * Feeds a writer from given shared buffer, into which another process writes the audio in the format of the stream.
+     * The network thread of the writer polls the buffer and sends a packet as soon as its frames were written, so the
+     * audio goes from the other process to the network without passing through an audio thread of this process. The
+     * packets start at the frames which are written after the buffer was set, and restart when the timestamps of the
+     * buffer jump. While a buffer is set, send_data_realtime and send_audio_data_realtime fail for the writer. The
+     * setting is reset when the writer is removed.
+     * Thread safe: no.
+     * @param id The id of the writer.
+     * @param buffer The buffer, which must have the audio format of the writer and hold at least one packet, or nullptr
+     * to feed the writer through send_data_realtime again.
+     * @return true if the writer was found and the buffer fits the writer, or false if not.
+     */
+    [[nodiscard]] bool set_shared_buffer(Id id, std::shared_ptr<SharedAudioBuffer> buffer);
+
+    /**
+     * Reads the cost accounting of a writer without blocking the network and audio threads.
+     * Thread safe: no.
+     * @param id The id of the writer.
+     * @return The time spent on the writer, or nullopt if the writer was not found.
+     */
+    [[nodiscard]] std::optional<WriterCost> get_writer_cost(Id id) const;
+
+    /**
+     * Adds the metrics of all writers to given writer. The metrics are read without blocking the network and audio
+     * threads.
+     * @param writer The writer to add the metrics to.
+     */
+    void collect_metrics(metrics::PrometheusWriter& writer);
+
     struct FifoPacket {
         uint32_t rtp_timestamp {};
         uint32_t payload_size_bytes {};
         std::array<uint8_t, aes67::constants::k_max_payload> payload {};
     };
 
+    /**
+     * Metrics of a writer, written by the audio thread.
+     */
+    struct alignas(k_cache_line_size) AudioThreadMetrics {
+        metrics::Counter packets_scheduled;
+        metrics::Counter packets_failed_to_schedule;
+        metrics::CostMeter schedule_cost;  // Scheduling a packet, including the encoding of the audio
+
+        void reset() {
+            packets_scheduled.reset();
+            packets_failed_to_schedule.reset();
+            schedule_cost.reset();
+        }
+    };
+
+    /**
+     * Metrics of a writer, written by the network thread.
+     */
+    struct alignas(k_cache_line_size) NetworkThreadMetrics {
+        metrics::Counter packets_sent;
+        metrics::Counter bytes_sent;
+        metrics::Counter packets_failed_to_send;
+        metrics::CostMeter send_cost;  // Passes of send_outgoing_packets which sent packets of the writer
+
+        void reset() {
+            packets_sent.reset();
+            bytes_sent.reset();
+            packets_failed_to_send.reset();
+            send_cost.reset();
+        }
+    };
+
+    /**
+     * Destinations which take effect at an RTP timestamp, handed from the control thread to the network thread.
+     */
+    struct ScheduledDestinations {
+        std::array<udp_endpoint, k_max_num_redundant_sessions> destinations;
+        uint32_t rtp_timestamp {};
+    };
+
+    /**
+     * A payload type which takes effect at an RTP timestamp, handed from the control thread to the audio thread.
+     */
+    struct ScheduledPayloadType {
+        uint8_t payload_type {};
+        uint32_t rtp_timestamp {};
+    };
+
     struct Writer {
         explicit Writer(std::array<udp_socket, k_max_num_redundant_sessions>&& s) : sockets(std::move(s)) {}
 
         AtomicRwLock rw_lock;
         Id id;
+        size_t shard {};  // The shard of which the network thread sends the packets of this writer
         std::array<udp_endpoint, k_max_num_redundant_sessions> destinations;
         std::array<udp_socket, k_max_num_redundant_sessions> sockets;
-        std::atomic<size_t> num_packets_failed_to_schedule {0};  // TODO: Report somewhere
-        std::atomic<size_t> num_packets_failed_to_send {0};      // TODO: Report somewhere
+        AudioThreadMetrics audio_thread_metrics;
+        NetworkThreadMetrics network_thread_metrics;
 
         // Audio thread:
-        ByteBuffer rtp_packet_buffer;
-        std::vector<uint8_t> intermediate_send_buffer;
-        std::vector<uint8_t> intermediate_audio_buffer;
+        ArenaVector<uint8_t> intermediate_send_buffer;
+        ArenaVector<uint8_t> intermediate_audio_buffer;
         uint32_t packet_time_frames {};
         Packet rtp_packet;
         AudioFormat audio_format;
+        AudioPipeline pipeline;  // Converts the audio to the payload format
         Ringbuffer rtp_buffer;
+        std::optional<ScheduledPayloadType> scheduled_payload_type;
+
+        // Network thread:
+        std::optional<ScheduledDestinations> scheduled_destinations;
+        std::shared_ptr<SharedAudioBuffer> shared_buffer;  // When set, takes the place of the audio thread
+        std::optional<uint32_t> shared_buffer_generation;  // The generation of the shared buffer which is being sent
+
+        // Control thread:
+        bool update_scheduled {false};
 
         // Audio thread writes and network thread reads:
-        FifoBuffer<FifoPacket, Fifo::Spsc> outgoing_data;
+        FifoBuffer<FifoPacket, Fifo::Spsc, ArenaAllocator<FifoPacket>> outgoing_data;
+
+        // Control thread writes and network thread reads:
+        boost::lockfree::spsc_value<std::array<udp_endpoint, k_max_num_redundant_sessions>> pending_destinations;
+
+        boost::lockfree::spsc_value<std::optional<ScheduledDestinations>> scheduled_destinations_request;
+
+        // Control thread writes and audio thread reads:
+        boost::lockfree::spsc_value<uint8_t> pending_payload_type;
+        boost::lockfree::spsc_value<std::optional<ScheduledPayloadType>> scheduled_payload_type_request;
+
+        // Network thread writes and control thread reads:
+        std::atomic<bool> scheduled_update_activated {false};
+        std::atomic<uint32_t> activated_at {0};  // The timestamp of the first packet sent to the scheduled destinations
     };
 
     struct SocketWithContext {
@@ -163,8 +393,26 @@ struct AudioSender {
         udp_socket socket;
     };
 
-    boost::container::static_vector<Writer, k_max_num_writers> writers;
-    boost::system::error_code last_error;  // Used to avoid log spamming
+    /**
+     * State which is owned by the network thread of a shard.
+     */
+    struct alignas(k_cache_line_size) ShardState {
+        boost::system::error_code last_error;       // Used to avoid log spamming
+        std::unique_ptr<IoUringSendRing> io_uring;  // When set, packets are sent through io_uring
+    };
+
+    std::shared_ptr<MemoryArena> memory_arena;  // Declared before the writers, which return their buffers on destruction
+
+    // The writer slots are allocated once on construction, so that the sender itself stays small enough for the stack.
+    using WriterSlots = boost::container::static_vector<Writer, k_max_num_writers>;
+    std::unique_ptr<WriterSlots> writer_slots {std::make_unique<WriterSlots>()};
+    WriterSlots& writers {*writer_slots};
+
+    // One past the last writer slot in use. Written by the control thread, read by the network and audio threads so that
+    // they don't visit the unused slots at the end.
+    std::atomic<size_t> num_writer_slots_in_use {0};
+    size_t num_shards {1};
+    std::array<ShardState, k_max_num_shards> shards;
 };
 
 }  // namespace rav::rtp
@@ -26,6 +26,7 @@
 
 #include "ravennakit/sdp/detail/sdp_constants.hpp"
 #include "ravennakit/sdp/sdp_session_description.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 #include <boost/asio.hpp>
 #include "ravennakit/core/expected.hpp"
@@ -89,6 +90,23 @@ class Filter {
         return total;
     }
 
+    /**
+     * Adds a filter from the given source filter view, using the addresses which were decoded while parsing.
+     * @param source_filter The source filter view.
+     * @return The number of source filters added.
+     */
+    size_t add_filter(const sdp::SourceFilterView& source_filter) {
+        size_t total = 0;
+        if (source_filter.dest_address.address != connection_address_) {
+            return 0;
+        }
+        for (auto& src : source_filter.src_list) {
+            add_filter(src.address, source_filter.mode);
+            total++;
+        }
+        return total;
+    }
+
     /**
      * Adds filters from given vector of source filters.
      * @param filters The source filters.
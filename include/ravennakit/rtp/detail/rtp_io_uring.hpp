@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/net/asio/asio_helpers.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#ifndef RAV_ENABLE_IO_URING
+    #define RAV_ENABLE_IO_URING 0
+#endif
+
+namespace rav::rtp {
+
+/**
+ * Options for the io_uring network backend.
+ */
+struct IoUringOptions {
+    /// The number of submission queue entries.
+    uint32_t num_entries {256};
+
+    /// When true, a kernel thread polls the submission queue so that the network thread doesn't need any syscalls.
+    bool sqpoll {};
+
+    /// The number of milliseconds of inactivity after which the kernel polling thread goes to sleep.
+    uint32_t sqpoll_idle_ms {100};
+
+    /// The core to pin the kernel polling thread to. When nullopt the thread is not pinned.
+    std::optional<uint32_t> sqpoll_cpu;
+};
+
+/**
+ * Receives datagrams from a set of sockets using io_uring. Every socket has a multishot recvmsg request armed which
+ * places the datagrams into buffers of a provided buffer ring, so no syscall per packet is needed. Datagrams bigger than
+ * aes67::constants::k_mtu don't fit a buffer and are dropped. Only available on Linux when built with RAV_ENABLE_IO_URING.
+ * Not thread safe: all calls must be made from the same thread.
+ */
+class IoUringReceiveRing {
+  public:
+    /// The maximum number of sockets (slots).
+    static constexpr size_t k_max_num_sockets = 512;
+
+    /// The number of receive buffers in the provided buffer ring. Must be a power of 2.
+    static constexpr uint32_t k_num_buffers = 512;
+
+    struct Packet {
+        const uint8_t* data {};
+        size_t size {};
+        udp_endpoint src_endpoint;
+        udp_endpoint dst_endpoint;
+        uint64_t recv_time {};  // Monotonically increasing time in nanoseconds with arbitrary starting point.
+    };
+
+    ~IoUringReceiveRing();
+
+    IoUringReceiveRing(const IoUringReceiveRing&) = delete;
+    IoUringReceiveRing& operator=(const IoUringReceiveRing&) = delete;
+
+    IoUringReceiveRing(IoUringReceiveRing&&) noexcept = delete;
+    IoUringReceiveRing& operator=(IoUringReceiveRing&&) noexcept = delete;
+
+    /**
+     * Creates a new ring.
+     * @param options The options of the ring.
+     * @return The ring, or nullptr if io_uring is not available.
+     */
+    static std::unique_ptr<IoUringReceiveRing> create(const IoUringOptions& options);
+
+    /**
+     * Makes sure a multishot receive is armed for the socket in given slot. Does nothing when the socket is armed
+     * already, so it is cheap to call on every iteration. Replaces the receive of a previous socket in the same slot.
+     * @param slot The slot of the socket, less than k_max_num_sockets.
+     * @param generation A value which changes whenever another socket is placed in the slot.
+     * @param fd The native handle of the socket.
+     * @param port The port the socket is bound to.
+     */
+    void arm(size_t slot, uint32_t generation, int fd, uint16_t port);
+
+    /**
+     * Cancels the receive of given slot, if armed.
+     * @param slot The slot of the socket, less than k_max_num_sockets.
+     */
+    void disarm(size_t slot);
+
+    /**
+     * Submits pending requests and collects the received datagrams. The data of the packets stays valid until the next
+     * call to receive.
+     * @param packets The array to place the packets in.
+     * @param max_num_packets The size of the array.
+     * @return The number of packets placed in the array.
+     */
+    size_t receive(Packet* packets, size_t max_num_packets);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+
+    explicit IoUringReceiveRing(std::unique_ptr<Impl> impl);
+};
+
+/**
+ * Sends datagrams using io_uring. The datagrams are copied into registered buffers and sent zero-copy. Sends are
+ * batched until submit is called. Only available on Linux when built with RAV_ENABLE_IO_URING.
+ * Not thread safe: all calls must be made from the same thread.
+ */
+class IoUringSendRing {
+  public:
+    /// The number of registered send buffers, which limits the number of sends in flight.
+    static constexpr uint32_t k_num_buffers = 256;
+
+    /// The size of each send buffer.
+    static constexpr size_t k_buffer_size = 1500;
+
+    struct Completion {
+        uint64_t tag {};    // The tag given to send.
+        int result {};      // The number of bytes sent, or a negative errno value.
+    };
+
+    ~IoUringSendRing();
+
+    IoUringSendRing(const IoUringSendRing&) = delete;
+    IoUringSendRing& operator=(const IoUringSendRing&) = delete;
+
+    IoUringSendRing(IoUringSendRing&&) noexcept = delete;
+    IoUringSendRing& operator=(IoUringSendRing&&) noexcept = delete;
+
+    /**
+     * Creates a new ring.
+     * @param options The options of the ring.
+     * @return The ring, or nullptr if io_uring is not available.
+     */
+    static std::unique_ptr<IoUringSendRing> create(const IoUringOptions& options);
+
+    /**
+     * Queues a datagram for sending. The data is copied, so the buffer can be reused right away.
+     * @param fd The native handle of the socket to send with.
+     * @param data The data to send.
+     * @param size The size of the data, at most k_buffer_size.
+     * @param endpoint The destination.
+     * @param tag A value which is returned with the completion.
+     * @return True if the datagram was queued, or false if all buffers are in flight or the data is too big.
+     */
+    [[nodiscard]] bool send(int fd, const uint8_t* data, size_t size, const udp_endpoint& endpoint, uint64_t tag);
+
+    /**
+     * Submits the queued datagrams.
+     */
+    void submit();
+
+    /**
+     * Collects the completions of the sends.
+     * @param completions The array to place the completions in.
+     * @param max_num_completions The size of the array.
+     * @return The number of completions placed in the array.
+     */
+    size_t complete(Completion* completions, size_t max_num_completions);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+
+    explicit IoUringSendRing(std::unique_ptr<Impl> impl);
+};
+
+}  // namespace rav::rtp
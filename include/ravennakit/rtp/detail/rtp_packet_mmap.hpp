@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/net/asio/asio_helpers.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rav::rtp {
+
+/**
+ * Options for the memory mapped AF_PACKET receive backend.
+ */
+struct PacketMmapOptions {
+    /// The size of a block of the ring. Must be a multiple of the page size and a power of 2.
+    uint32_t block_size {1 << 20};
+
+    /// The number of blocks in the ring.
+    uint32_t num_blocks {32};
+
+    /// The number of milliseconds after which the kernel hands over a block which isn't full yet. This bounds the
+    /// latency added by the batching.
+    uint32_t block_timeout_ms {1};
+};
+
+/**
+ * Receives the UDP datagrams of an interface from a memory mapped AF_PACKET ring (TPACKET_V3). A BPF filter makes the
+ * kernel only pass the datagrams sent to a given set of destinations, and the datagrams are handed over in blocks, so
+ * no syscall per datagram is needed. The IP and UDP headers are parsed in place. Datagrams bigger than
+ * aes67::constants::k_mtu are dropped. Only available on Linux, and requires CAP_NET_RAW.
+ * Not thread safe: receive must be called from a single thread. set_destinations may be called from another thread.
+ */
+class PacketMmapReceiveRing {
+  public:
+    struct Packet {
+        const uint8_t* data {};  // The UDP payload
+        size_t size {};
+        udp_endpoint src_endpoint;
+        udp_endpoint dst_endpoint;
+        uint64_t recv_time {};  // Monotonically increasing time in nanoseconds with arbitrary starting point.
+    };
+
+    ~PacketMmapReceiveRing();
+
+    PacketMmapReceiveRing(const PacketMmapReceiveRing&) = delete;
+    PacketMmapReceiveRing& operator=(const PacketMmapReceiveRing&) = delete;
+
+    PacketMmapReceiveRing(PacketMmapReceiveRing&&) noexcept = delete;
+    PacketMmapReceiveRing& operator=(PacketMmapReceiveRing&&) noexcept = delete;
+
+    /**
+     * Creates a new ring. No datagrams are received until set_destinations is called.
+     * @param interface_address The address of the interface to receive on. When unspecified, all interfaces are used.
+     * @param options The options of the ring.
+     * @return The ring, or nullptr if the ring could not be created.
+     */
+    static std::unique_ptr<PacketMmapReceiveRing> create(const ip_address_v4& interface_address, const PacketMmapOptions& options);
+
+    /**
+     * Replaces the kernel filter so that only the datagrams sent to given destinations are received. Outgoing datagrams
+     * and IP fragments are never received.
+     * @param destinations The destination addresses and ports.
+     * @return True if the filter was set, or false if not.
+     */
+    [[nodiscard]] bool set_destinations(const std::vector<udp_endpoint>& destinations);
+
+    /**
+     * Collects the received datagrams from the current block of the ring. The data of the packets stays valid until the
+     * next call to receive.
+     * @param packets The array to place the packets in.
+     * @param max_num_packets The size of the array.
+     * @return The number of packets placed in the array.
+     */
+    size_t receive(Packet* packets, size_t max_num_packets);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+
+    explicit PacketMmapReceiveRing(std::unique_ptr<Impl> impl);
+};
+
+/**
+ * Makes a socket drop all the datagrams it receives in the kernel, for sockets which are only kept open to stay joined
+ * to multicast groups.
+ * @param socket The socket.
+ * @return True if the filter was attached, or false if not.
+ */
+[[nodiscard]] bool attach_drop_all_filter(udp_socket& socket);
+
+}  // namespace rav::rtp
@@ -24,11 +24,15 @@
 
 #pragma once
 
+#include "ravennakit/core/byte_order.hpp"
 #include "ravennakit/core/containers/fifo_buffer.hpp"
 #include "ravennakit/rtp/rtp_packet_view.hpp"
 #include "ravennakit/core/log.hpp"
+#include "ravennakit/core/util/memory_arena.hpp"
 #include "ravennakit/core/util/wrapping_uint.hpp"
 
+#include <algorithm>
+
 namespace rav::rtp {
 
 /**
@@ -56,6 +60,29 @@ class Ringbuffer {
         std::fill(buffer_.begin(), buffer_.end(), ground_value_);
     }
 
+    /**
+     * Replaces the allocator of the buffer. When the allocator differs from the current one, the storage is released and
+     * the buffer must be resized before it can be used again.
+     * @param allocator The new allocator.
+     */
+    void set_allocator(const ArenaAllocator<uint8_t>& allocator) {
+        if (buffer_.get_allocator() == allocator) {
+            return;
+        }
+        buffer_ = ArenaVector<uint8_t>(allocator);
+        bytes_per_frame_ = 0;
+        next_ts_ = {};
+    }
+
+    /**
+     * Releases the storage of the buffer, which must be resized before it can be used again.
+     */
+    void release() {
+        buffer_ = ArenaVector<uint8_t>(buffer_.get_allocator());
+        bytes_per_frame_ = 0;
+        next_ts_ = {};
+    }
+
     /**
      * Writes data to the buffer. Older packets can be written as well, but make sure packet are not too old, otherwise
      * they might overwrite newer packets (as a result of circular buffering).
@@ -65,24 +92,19 @@ class Ringbuffer {
      * payload is larger than the buffer size.
      */
     void write(const uint32_t at_timestamp, const BufferView<const uint8_t>& payload) {
-        RAV_ASSERT_DEBUG(payload.data() != nullptr, "Payload data must not be nullptr.");
-        RAV_ASSERT_DEBUG(payload.size_bytes() > 0, "Payload size must be greater than 0.");
-        RAV_ASSERT_DEBUG(payload.size_bytes() % bytes_per_frame_ == 0, "Payload size must be a multiple of bytes_per_frame_.");
-        RAV_ASSERT_DEBUG(payload.size_bytes() <= buffer_.size(), "Payload size too big");
-
-        const Fifo::Position position(static_cast<size_t>(at_timestamp) * bytes_per_frame_, buffer_.size(), payload.size());
-
-        std::memcpy(buffer_.data() + position.index1, payload.data(), position.size1);
-
-        if (position.size2 > 0) {
-            std::memcpy(buffer_.data(), payload.data() + position.size1, position.size2);
-        }
-
-        const auto end_ts = WrappingUint32(at_timestamp) + static_cast<uint32_t>(payload.size_bytes() / bytes_per_frame_);
+        write_with_stride(at_timestamp, payload, 1);
+    }
 
-        if (end_ts > next_ts_) {
-            next_ts_ = end_ts;
-        }
+    /**
+     * Writes data to the buffer like write(), swapping the bytes of every sample while copying. This converts between
+     * little and big endian in the same pass which places the data in the buffer.
+     * @param at_timestamp Places the data at this timestamp.
+     * @param payload The data to write to the buffer.
+     * @param bytes_per_sample The number of bytes per sample. Must divide bytes_per_frame.
+     */
+    void write_byte_swapped(const uint32_t at_timestamp, const BufferView<const uint8_t>& payload, const uint32_t bytes_per_sample) {
+        RAV_ASSERT_DEBUG(bytes_per_sample > 0 && bytes_per_frame_ % bytes_per_sample == 0, "Invalid bytes per sample.");
+        write_with_stride(at_timestamp, payload, bytes_per_sample);
     }
 
     /**
@@ -116,6 +138,37 @@ class Ringbuffer {
         }
     }
 
+    /**
+     * Reads data from the buffer without clearing it, so that readers at different positions can read the same data.
+     * The frames which are not held by the buffer, because they were not written yet (at or after the next timestamp) or
+     * were overwritten already (older than the capacity of the buffer), read as the ground value.
+     * @param at_timestamp The timestamp to read from.
+     * @param buffer The destination to write the data to.
+     * @param buffer_size The size of the buffer in bytes.
+     */
+    void read_received(const uint32_t at_timestamp, uint8_t* buffer, const size_t buffer_size) {
+        RAV_ASSERT_DEBUG(buffer != nullptr, "Buffer must not be nullptr.");
+        RAV_ASSERT_DEBUG(buffer_size % bytes_per_frame_ == 0, "Payload size must be a multiple of bytes_per_frame_.");
+        RAV_ASSERT_DEBUG(buffer_size <= buffer_.size(), "Payload size too big");
+
+        const auto num_frames = static_cast<int64_t>(buffer_size / bytes_per_frame_);
+        const auto capacity_frames = get_capacity_frames();
+        const WrappingUint32 start(at_timestamp);
+
+        // The frames in [begin, end) of the buffer to read are held by the ringbuffer
+        const auto begin = std::clamp<int64_t>(start.diff(next_ts_ - capacity_frames), 0, num_frames);
+        const auto end = std::clamp<int64_t>(start.diff(next_ts_), begin, num_frames);
+
+        const auto begin_bytes = static_cast<size_t>(begin) * bytes_per_frame_;
+        const auto end_bytes = static_cast<size_t>(end) * bytes_per_frame_;
+
+        std::fill_n(buffer, begin_bytes, ground_value_);
+        if (end > begin) {
+            read(at_timestamp + static_cast<uint32_t>(begin), buffer + begin_bytes, end_bytes - begin_bytes);
+        }
+        std::fill_n(buffer + end_bytes, buffer_size - end_bytes, ground_value_);
+    }
+
     /**
      * Fills the buffer with a value until (but not including) the given timestamp. If given timestamp is older than the
      * existing data nothing will happen - i.e. an older packet will not overwrite a newer packet.
@@ -157,6 +210,13 @@ class Ringbuffer {
         return next_ts_;
     }
 
+    /**
+     * @returns The capacity of the buffer in frames.
+     */
+    [[nodiscard]] uint32_t get_capacity_frames() const {
+        return bytes_per_frame_ > 0 ? static_cast<uint32_t>(buffer_.size() / bytes_per_frame_) : 0;
+    }
+
     /**
      * Sets the next timestamp to the given value.
      * @param next_ts The next timestamp.
@@ -177,8 +237,30 @@ class Ringbuffer {
   private:
     uint32_t bytes_per_frame_ = 0;  // Number of bytes (octets) per frame
     WrappingUint32 next_ts_;        // Producer ts
-    std::vector<uint8_t> buffer_;   // Stores the actual data
+    ArenaVector<uint8_t> buffer_;   // Stores the actual data
     uint8_t ground_value_ = 0;      // Value to clear the buffer with.
+
+    void write_with_stride(const uint32_t at_timestamp, const BufferView<const uint8_t>& payload, const uint32_t stride) {
+        RAV_ASSERT_DEBUG(payload.data() != nullptr, "Payload data must not be nullptr.");
+        RAV_ASSERT_DEBUG(payload.size_bytes() > 0, "Payload size must be greater than 0.");
+        RAV_ASSERT_DEBUG(payload.size_bytes() % bytes_per_frame_ == 0, "Payload size must be a multiple of bytes_per_frame_.");
+        RAV_ASSERT_DEBUG(payload.size_bytes() <= buffer_.size(), "Payload size too big");
+
+        const Fifo::Position position(static_cast<size_t>(at_timestamp) * bytes_per_frame_, buffer_.size(), payload.size());
+
+        // Both parts start at a frame boundary, so samples are never split by the wrap around.
+        swap_bytes(payload.data(), buffer_.data() + position.index1, position.size1, stride);
+
+        if (position.size2 > 0) {
+            swap_bytes(payload.data() + position.size1, buffer_.data(), position.size2, stride);
+        }
+
+        const auto end_ts = WrappingUint32(at_timestamp) + static_cast<uint32_t>(payload.size_bytes() / bytes_per_frame_);
+
+        if (end_ts > next_ts_) {
+            next_ts_ = end_ts;
+        }
+    }
 };
 
 }  // namespace rav::rtp
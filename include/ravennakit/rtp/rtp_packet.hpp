@@ -34,6 +34,9 @@ namespace rav::rtp {
  */
 class Packet {
   public:
+    /// The size of the header as encoded by this class, which doesn't write CSRCs or extensions.
+    static constexpr size_t k_header_size = 12;
+
     Packet() = default;
 
     /**
@@ -98,6 +101,16 @@ class Packet {
      */
     void encode(const uint8_t* payload_data, size_t payload_size, ByteBuffer& buffer) const;
 
+    /**
+     * Encodes the RTP packet into given memory, without allocating.
+     * @param payload_data The payload to encode.
+     * @param payload_size The size of the payload in bytes.
+     * @param buffer The memory to write to.
+     * @param buffer_size The size of the memory in bytes.
+     * @return The number of bytes written, or 0 if the packet doesn't fit.
+     */
+    [[nodiscard]] size_t encode(const uint8_t* payload_data, size_t payload_size, uint8_t* buffer, size_t buffer_size) const;
+
   private:
     uint8_t payload_type_ {0};
     WrappingUint<uint16_t> sequence_number_ {0};
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "ravennakit/core/audio/audio_format.hpp"
+#include "ravennakit/core/containers/buffer_view.hpp"
+#include "ravennakit/core/util.hpp"
+#include "ravennakit/core/util/shared_memory.hpp"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace rav::rtp {
+
+/**
+ * A ringbuffer of audio frames in shared memory, through which other processes read the audio of a receiver or write
+ * the audio of a sender without copying it through another IPC layer. Frames are placed at their RTP timestamp modulo
+ * the capacity, in the format of the stream (the payload format of the RTP packets). A lock-free header in front of
+ * the data carries the position and the time of the most recent write, so reading and writing don't need any system
+ * calls once the memory is mapped.
+ *
+ * There is a single writer, which is either the network thread of a receiver or an external process feeding a sender,
+ * and any number of readers in any process. The writer marks the region it's about to overwrite before touching it and
+ * publishes it after, so readers detect when data was overwritten while they were copying it (like a seqlock) instead
+ * of waiting for the writer. A jump of the timestamp of more than the capacity starts a new generation.
+ *
+ * This header together with SharedMemory is the client library: an external process opens the buffer by name with
+ * open(), and uses get_write_position() and read() (or get_readable_region() and is_valid() for zero copy access) to
+ * follow the stream.
+ *
+ * Thread safe: one thread may write while any number of threads and processes read.
+ */
+class SharedAudioBuffer {
+  public:
+    /// Identifies the memory layout.
+    static constexpr uint32_t k_magic = 0x52415642;  // RAVB
+
+    /// The version of the memory layout, incremented on incompatible changes.
+    static constexpr uint32_t k_version = 1;
+
+    /**
+     * The layout of the start of the shared memory. The data follows at header_size bytes from the start.
+     */
+    struct Header {
+        std::atomic<uint32_t> magic;  // Stored last when the buffer is created
+        uint32_t version;
+        uint32_t header_size;
+        uint32_t capacity_frames;
+        uint32_t sample_rate;
+        uint32_t num_channels;
+        uint8_t encoding;
+        uint8_t byte_order;
+        uint8_t ordering;
+        uint8_t reserved;
+        uint32_t bytes_per_frame;
+
+        // The generation (high 32 bits) and the end timestamp (low 32 bits) of the region the writer is writing
+        alignas(k_cache_line_size) std::atomic<uint64_t> write_claim;
+        // The generation (high 32 bits) and the end timestamp (low 32 bits) of the most recent published write
+        alignas(k_cache_line_size) std::atomic<uint64_t> write_position;
+        // The monotonic time of the most recent published write in nanoseconds
+        std::atomic<uint64_t> write_time_ns;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The header must be lock free to be shared between processes");
+
+    /**
+     * The position of the writer.
+     */
+    struct Position {
+        /// Incremented whenever the timestamps jumped. Zero until the first write.
+        uint32_t generation {};
+        /// The timestamp following the most recent frame which was written.
+        uint32_t end_timestamp {};
+
+        friend bool operator==(const Position& lhs, const Position& rhs) {
+            return lhs.generation == rhs.generation && lhs.end_timestamp == rhs.end_timestamp;
+        }
+
+        friend bool operator!=(const Position& lhs, const Position& rhs) {
+            return !(lhs == rhs);
+        }
+    };
+
+    /**
+     * A range of frames in the ringbuffer, split in two parts where it wraps around.
+     */
+    template<class T>
+    struct Region {
+        BufferView<T> part1;
+        BufferView<T> part2;
+        uint32_t generation {};
+    };
+
+    ~SharedAudioBuffer() = default;
+
+    SharedAudioBuffer(const SharedAudioBuffer&) = delete;
+    SharedAudioBuffer& operator=(const SharedAudioBuffer&) = delete;
+
+    SharedAudioBuffer(SharedAudioBuffer&&) noexcept = delete;
+    SharedAudioBuffer& operator=(SharedAudioBuffer&&) noexcept = delete;
+
+    /**
+     * Creates a new buffer in shared memory. The name is removed when the buffer is destroyed.
+     * @param name The name of the shared memory, see SharedMemory.
+     * @param audio_format The format of the frames.
+     * @param capacity_frames The capacity of the buffer in frames.
+     * @param lock_memory Locks the buffer in RAM so that it's never paged out.
+     * @return The buffer, or nullptr if the format or capacity is invalid or the shared memory could not be created.
+     */
+    [[nodiscard]] static std::unique_ptr<SharedAudioBuffer>
+    create(const std::string& name, const AudioFormat& audio_format, uint32_t capacity_frames, bool lock_memory = false);
+
+    /**
+     * Opens a buffer which was created by another process.
+     * @param name The name of the shared memory.
+     * @return The buffer, or nullptr if the shared memory doesn't exist or doesn't contain a buffer of this version.
+     */
+    [[nodiscard]] static std::unique_ptr<SharedAudioBuffer> open(const std::string& name);
+
+    /**
+     * @return The format of the frames.
+     */
+    [[nodiscard]] const AudioFormat& get_audio_format() const;
+
+    /**
+     * @return The capacity of the buffer in frames.
+     */
+    [[nodiscard]] uint32_t get_capacity_frames() const;
+
+    /**
+     * @return The name of the shared memory.
+     */
+    [[nodiscard]] const std::string& get_name() const;
+
+    /**
+     * Writes frames at given timestamp and publishes them. Older frames can be written as well, as long as they are
+     * not older than the capacity. Frames which were skipped are cleared. Writer only, realtime safe.
+     * @param timestamp The timestamp of the first frame.
+     * @param data The frames, a multiple of the frame size and not larger than the capacity.
+     */
+    void write(uint32_t timestamp, BufferView<const uint8_t> data);
+
+    /**
+     * Prepares the region of given frames for writing in place, after which the frames are published with
+     * commit_write(). Writer only, realtime safe.
+     * @param timestamp The timestamp of the first frame.
+     * @param num_frames The number of frames, not more than the capacity.
+     * @return The region to write the frames into.
+     */
+    [[nodiscard]] Region<uint8_t> prepare_write(uint32_t timestamp, uint32_t num_frames);
+
+    /**
+     * Publishes the frames of the most recent prepare_write() to the readers. Writer only, realtime safe.
+     */
+    void commit_write();
+
+    /**
+     * @return The position of the most recent write, or nullopt if nothing was written yet.
+     */
+    [[nodiscard]] std::optional<Position> get_write_position() const;
+
+    /**
+     * @return The monotonic time of the most recent write in nanoseconds (see clock::now_monotonic_high_resolution_ns).
+     */
+    [[nodiscard]] uint64_t get_write_time_ns() const;
+
+    /**
+     * Copies frames out of the buffer. Realtime safe.
+     * @param timestamp The timestamp of the first frame.
+     * @param buffer The destination.
+     * @param buffer_size The size of the destination in bytes, a multiple of the frame size.
+     * @return True if the frames were read, or false if they were not written yet, are older than the capacity, or were
+     * overwritten while copying.
+     */
+    [[nodiscard]] bool read(uint32_t timestamp, uint8_t* buffer, size_t buffer_size) const;
+
+    /**
+     * Gives direct access to frames in the buffer. Once the frames were consumed, is_valid() tells whether the writer
+     * overwrote them in the meantime. Realtime safe.
+     * @param timestamp The timestamp of the first frame.
+     * @param num_frames The number of frames.
+     * @return The region, or nullopt if the frames were not written yet or are older than the capacity.
+     */
+    [[nodiscard]] std::optional<Region<const uint8_t>> get_readable_region(uint32_t timestamp, uint32_t num_frames) const;
+
+    /**
+     * @param timestamp The timestamp of the first frame of a region returned by get_readable_region().
+     * @param generation The generation of the region.
+     * @return True if the frames of the region were not overwritten since get_readable_region() returned it.
+     */
+    [[nodiscard]] bool is_valid(uint32_t timestamp, uint32_t generation) const;
+
+  private:
+    std::unique_ptr<SharedMemory> memory_;
+    Header* header_ {};
+    uint8_t* data_ {};
+    size_t capacity_bytes_ {};
+    AudioFormat audio_format_;
+
+    SharedAudioBuffer() = default;
+    [[nodiscard]] Region<uint8_t> get_region(uint32_t timestamp, uint32_t num_frames) const;
+};
+
+}  // namespace rav::rtp
@@ -25,3 +25,4 @@
 #pragma once
 
 #include "sdp_session_description.hpp"
+#include "sdp_session_description_view.hpp"
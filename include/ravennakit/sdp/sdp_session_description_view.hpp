@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#pragma once
+
+#include "detail/sdp_constants.hpp"
+#include "detail/sdp_group.hpp"
+#include "detail/sdp_media_clock_source.hpp"
+#include "detail/sdp_ravenna_clock_domain.hpp"
+#include "detail/sdp_reference_clock.hpp"
+#include "detail/sdp_time_active.hpp"
+#include "detail/sdp_types.hpp"
+#include "sdp_session_description.hpp"
+#include "ravennakit/core/expected.hpp"
+#include "ravennakit/core/math/fraction.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include <optional>
+#include <string_view>
+
+namespace rav::sdp {
+
+/**
+ * An address as written in the SDP text, together with its decoded value. When the text is not a numeric address (for
+ * example a FQDN), the decoded address is left unspecified.
+ */
+struct AddressView {
+    std::string_view text;
+    boost::asio::ip::address address;
+};
+
+/**
+ * Borrowing counterpart of OriginField.
+ */
+struct OriginView {
+    std::string_view username;
+    std::string_view session_id;
+    int session_version {};
+    NetwType network_type {NetwType::undefined};
+    AddrType address_type {AddrType::undefined};
+    AddressView unicast_address;
+};
+
+/**
+ * Borrowing counterpart of ConnectionInfoField.
+ */
+struct ConnectionInfoView {
+    NetwType network_type {NetwType::undefined};
+    AddrType address_type {AddrType::undefined};
+    AddressView address;
+    std::optional<int32_t> ttl;
+    std::optional<int32_t> number_of_addresses;
+};
+
+/**
+ * Borrowing counterpart of Format.
+ */
+struct FormatView {
+    uint8_t payload_type {};
+    std::string_view encoding_name;
+    uint32_t clock_rate {};
+    uint32_t num_channels {};
+};
+
+/**
+ * Borrowing counterpart of ReferenceClock.
+ */
+struct ReferenceClockView {
+    ReferenceClock::ClockSource source {ReferenceClock::ClockSource::undefined};
+    std::optional<ReferenceClock::PtpVersion> ptp_version {ReferenceClock::PtpVersion::undefined};
+    std::optional<std::string_view> gmid;
+    std::optional<int32_t> domain;
+};
+
+/**
+ * Borrowing counterpart of SourceFilter. The addresses are decoded, so they can be used without parsing them again.
+ */
+struct SourceFilterView {
+    FilterMode mode {FilterMode::undefined};
+    NetwType net_type {NetwType::undefined};
+    AddrType addr_type {AddrType::undefined};
+    AddressView dest_address;
+    boost::container::small_vector<AddressView, 2> src_list;
+};
+
+/**
+ * Borrowing counterpart of Group.
+ */
+struct GroupView {
+    Group::Type type {Group::Type::undefined};
+    boost::container::small_vector<std::string_view, 2> tags;
+};
+
+/**
+ * An attribute which is not decoded by the parser.
+ */
+struct AttributeView {
+    std::string_view key;
+    std::string_view value;
+};
+
+/**
+ * Borrowing counterpart of MediaDescription.
+ */
+struct MediaDescriptionView {
+    std::string_view media_type;
+    uint16_t port {};
+    uint16_t number_of_ports {1};
+    std::string_view protocol;
+    boost::container::small_vector<FormatView, 2> formats;
+    boost::container::small_vector<ConnectionInfoView, 1> connection_infos;
+    std::optional<float> ptime;
+    std::optional<float> max_ptime;
+    std::optional<MediaDirection> media_direction;
+    std::optional<ReferenceClockView> reference_clock;
+    std::optional<MediaClockSource> media_clock;
+    std::optional<std::string_view> session_information;
+    std::optional<RavennaClockDomain> ravenna_clock_domain;     // RAVENNA-specific attribute
+    std::optional<uint32_t> ravenna_sync_time;                  // RAVENNA-specific attribute
+    std::optional<Fraction<uint32_t>> ravenna_clock_deviation;  // RAVENNA-specific attribute
+    boost::container::small_vector<SourceFilterView, 1> source_filters;
+    std::optional<uint16_t> ravenna_framecount;  // Legacy RAVENNA attribute, replaced by ptime
+    std::optional<std::string_view> mid;
+    boost::container::small_vector<AttributeView, 4> attributes;  // Remaining, unknown attributes in order of appearance
+};
+
+/**
+ * A session description which refers to the SDP text it was parsed from instead of owning copies of it. Parsing into a
+ * view doesn't allocate for typical RAVENNA and AES67 descriptions, and the addresses, ports, packet times and clock
+ * references are decoded while parsing. The SDP text must outlive the view.
+ */
+struct SessionDescriptionView {
+    int version {};
+    OriginView origin;
+    std::string_view session_name;
+    std::optional<ConnectionInfoView> connection_info;
+    TimeActiveField time_active;
+    std::optional<std::string_view> session_information;
+    std::optional<MediaDirection> media_direction;
+    std::optional<ReferenceClockView> reference_clock;
+    std::optional<MediaClockSource> media_clock;
+    std::optional<RavennaClockDomain> ravenna_clock_domain;  // RAVENNA-specific attribute
+    std::optional<uint32_t> ravenna_sync_time;               // RAVENNA-specific attribute
+    boost::container::small_vector<SourceFilterView, 1> source_filters;
+    std::optional<GroupView> group;
+    boost::container::small_vector<AttributeView, 4> attributes;  // Remaining, unknown attributes in order of appearance
+    boost::container::small_vector<MediaDescriptionView, 2> media_descriptions;
+};
+
+/**
+ * Parses an SDP session description from a string into a view over that string. This is the SDP grammar of the
+ * library: parse_session_description and the parse functions of the owning types convert the result of the view
+ * parsers below.
+ * @param sdp_text The SDP text to parse. Must outlive the returned view.
+ * @return A result indicating whether the parsing was successful or not. The error will be a message explaining
+ * what went wrong.
+ */
+[[nodiscard]] tl::expected<SessionDescriptionView, std::string> parse_session_description_view(std::string_view sdp_text);
+
+/**
+ * Parses an origin field (o=*) into a view over given line.
+ */
+[[nodiscard]] tl::expected<OriginView, std::string> parse_origin_view(std::string_view line);
+
+/**
+ * Parses a connection info field (c=*) into a view over given line.
+ */
+[[nodiscard]] tl::expected<ConnectionInfoView, std::string> parse_connection_info_view(std::string_view line);
+
+/**
+ * Parses the value of an rtpmap attribute into a view over given line.
+ */
+[[nodiscard]] tl::expected<FormatView, std::string> parse_format_view(std::string_view line);
+
+/**
+ * Parses the value of a ts-refclk attribute into a view over given line.
+ */
+[[nodiscard]] tl::expected<ReferenceClockView, std::string> parse_reference_clock_view(std::string_view line);
+
+/**
+ * Parses the value of a source-filter attribute into a view over given line.
+ */
+[[nodiscard]] tl::expected<SourceFilterView, std::string> parse_source_filter_view(std::string_view line);
+
+/**
+ * Parses the value of a group attribute into a view over given line.
+ */
+[[nodiscard]] tl::expected<GroupView, std::string> parse_group_view(std::string_view line);
+
+/**
+ * Parses a media description line (m=*) into a view over given line. Does not parse the connection info or attributes.
+ */
+[[nodiscard]] tl::expected<MediaDescriptionView, std::string> parse_media_description_view(std::string_view line);
+
+/**
+ * Parses a session level attribute line (a=*) into given session.
+ * @return A result indicating success or failure. When parsing fails, the error message will contain a description of
+ * the error.
+ */
+[[nodiscard]] tl::expected<void, std::string> parse_attribute(SessionDescriptionView& session, std::string_view line);
+
+/**
+ * Parses a media level attribute line (a=*) into given media description. An rtpmap attribute updates the format with
+ * the same payload type.
+ * @return A result indicating success or failure. When parsing fails, the error message will contain a description of
+ * the error.
+ */
+[[nodiscard]] tl::expected<void, std::string> parse_attribute(MediaDescriptionView& media, std::string_view line);
+
+/**
+ * Converts a view into an owning session description.
+ * @param view The view to convert.
+ * @return The owning session description.
+ */
+[[nodiscard]] SessionDescription to_session_description(const SessionDescriptionView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] OriginField to_origin(const OriginView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] ConnectionInfoField to_connection_info(const ConnectionInfoView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] Format to_format(const FormatView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] ReferenceClock to_reference_clock(const ReferenceClockView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] SourceFilter to_source_filter(const SourceFilterView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] Group to_group(const GroupView& view);
+
+/// Converts a view into its owning counterpart.
+[[nodiscard]] MediaDescription to_media_description(const MediaDescriptionView& view);
+
+/**
+ * Copies the attributes and connection infos which are set in a view onto an owning media description, leaving the
+ * other members of the media description as they are. The formats are not copied.
+ */
+void merge_attributes(const MediaDescriptionView& view, MediaDescription& media);
+
+/**
+ * Copies the session level attributes which are set in a view onto an owning session description, leaving the other
+ * members of the session description as they are.
+ */
+void merge_attributes(const SessionDescriptionView& view, SessionDescription& session);
+
+}  // namespace rav::sdp
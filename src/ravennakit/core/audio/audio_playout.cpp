@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_playout.hpp"
+
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/log.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+std::unique_ptr<rav::AudioPlayout> rav::AudioPlayout::create(const std::filesystem::path& file, const AudioPlayoutOptions& options) {
+    if (options.max_frames_per_piece == 0) {
+        RAV_LOG_ERROR("Invalid number of frames per piece");
+        return nullptr;
+    }
+
+    auto stream = MappedFileInputStream::create(file, options.file_options);
+    if (stream == nullptr) {
+        return nullptr;
+    }
+
+    const auto* file_data = stream->data();
+    const auto file_size = stream->size().value_or(0);
+
+    std::unique_ptr<AudioPlayout> playout(new AudioPlayout());
+    playout->options_ = options;
+
+    try {
+        playout->reader_ = std::make_unique<WavAudioFormat::Reader>(std::move(stream));
+    } catch (const std::exception& e) {
+        RAV_LOG_ERROR("Failed to read {}: {}", file.string(), e.what());
+        return nullptr;
+    }
+
+    const auto audio_format = playout->reader_->get_audio_format();
+    if (!audio_format || !audio_format->is_valid()) {
+        RAV_LOG_ERROR("Unsupported audio format in {}", file.string());
+        return nullptr;
+    }
+
+    const auto& data_chunk = playout->reader_->get_data_chunk();
+    if (!data_chunk || data_chunk->data_begin > file_size) {
+        RAV_LOG_ERROR("No audio data in {}", file.string());
+        return nullptr;
+    }
+
+    playout->audio_format_ = *audio_format;
+    playout->bytes_per_frame_ = audio_format->bytes_per_frame();
+    playout->audio_data_ = file_data + data_chunk->data_begin;
+    // A file which is still being recorded might hold less data than its header says
+    playout->num_frames_ = std::min(data_chunk->data_size, file_size - data_chunk->data_begin) / playout->bytes_per_frame_;
+    playout->silence_.resize(static_cast<size_t>(options.max_frames_per_piece) * playout->bytes_per_frame_, audio_format->ground_value());
+    playout->set_cues({});
+
+    return playout;
+}
+
+const rav::AudioFormat& rav::AudioPlayout::get_audio_format() const {
+    return audio_format_;
+}
+
+uint64_t rav::AudioPlayout::get_num_frames() const {
+    return num_frames_;
+}
+
+void rav::AudioPlayout::set_cues(const std::vector<Cue>& cues) {
+    cues_.clear();
+    cues_length_ = 0;
+
+    for (const auto& cue : cues) {
+        const auto end_frame = std::min(cue.end_frame, num_frames_);
+        if (cue.begin_frame >= end_frame) {
+            continue;
+        }
+        cues_.push_back({cue.begin_frame, end_frame});
+        cues_length_ += end_frame - cue.begin_frame;
+    }
+
+    if (cues_.empty() && cues.empty() && num_frames_ > 0) {
+        cues_.push_back({0, num_frames_});
+        cues_length_ = num_frames_;
+    }
+}
+
+const std::vector<rav::AudioPlayout::Cue>& rav::AudioPlayout::get_cues() const {
+    return cues_;
+}
+
+void rav::AudioPlayout::set_looping(const bool looping) {
+    looping_ = looping;
+}
+
+void rav::AudioPlayout::start(const uint32_t at_timestamp) {
+    start_ts_ = WrappingUint32(at_timestamp);
+    playing_ = false;
+    position_ = 0;
+}
+
+void rav::AudioPlayout::stop() {
+    start_ts_.reset();
+    playing_ = false;
+}
+
+bool rav::AudioPlayout::is_playing() const {
+    return playing_;
+}
+
+uint64_t rav::AudioPlayout::get_position() const {
+    return position_;
+}
+
+void rav::AudioPlayout::resync(const uint32_t now) {
+    if (!synced_) {
+        next_ts_ = WrappingUint32(now);
+        synced_ = true;
+        return;
+    }
+
+    const int64_t drift = next_ts_.diff(now);
+    if (std::abs(drift) <= static_cast<int64_t>(options_.max_drift_frames)) {
+        return;
+    }
+
+    // Keep the playback position in line with the clock
+    if (playing_) {
+        if (drift > 0) {
+            position_ += static_cast<uint64_t>(drift);
+        } else {
+            position_ -= std::min(position_, static_cast<uint64_t>(-drift));
+        }
+    }
+
+    next_ts_ = WrappingUint32(now);
+}
+
+rav::BufferView<const uint8_t> rav::AudioPlayout::next_piece(const uint32_t max_frames) {
+    auto silence = [this](const uint64_t num_frames) {
+        return BufferView<const uint8_t>(silence_.data(), static_cast<size_t>(num_frames) * bytes_per_frame_);
+    };
+
+    if (start_ts_.has_value()) {
+        const auto frames_until_start = next_ts_.diff(*start_ts_);
+        if (frames_until_start > 0) {
+            return silence(std::min(max_frames, static_cast<uint32_t>(frames_until_start)));
+        }
+        position_ = static_cast<uint64_t>(-static_cast<int64_t>(frames_until_start));  // Start might have passed already
+        playing_ = true;
+        start_ts_.reset();
+    }
+
+    if (!playing_) {
+        return silence(max_frames);
+    }
+
+    if (cues_length_ == 0 || (!looping_ && position_ >= cues_length_)) {
+        playing_ = false;
+        return silence(max_frames);
+    }
+
+    auto offset = looping_ ? position_ % cues_length_ : position_;
+    for (const auto& cue : cues_) {
+        const auto cue_length = cue.end_frame - cue.begin_frame;
+        if (offset < cue_length) {
+            const auto num_frames = std::min(static_cast<uint64_t>(max_frames), cue_length - offset);
+            position_ += num_frames;
+            return {
+                audio_data_ + static_cast<size_t>(cue.begin_frame + offset) * bytes_per_frame_,
+                static_cast<size_t>(num_frames) * bytes_per_frame_
+            };
+        }
+        offset -= cue_length;
+    }
+
+    RAV_ASSERT_FALSE("Position beyond the cues");
+    playing_ = false;
+    return silence(max_frames);
+}
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_recorder.hpp"
+
+#include "ravennakit/core/byte_order.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/streams/file_output_stream.hpp"
+#include "ravennakit/core/util/tracy.hpp"
+
+#include <algorithm>
+
+#if RAV_APPLE
+    #include <pthread.h>
+#endif
+
+namespace {
+
+constexpr uint64_t k_seconds_per_day = 24 * 60 * 60;
+
+std::optional<rav::WavAudioFormat::FormatCode> get_format_code(const rav::AudioFormat& format) {
+    switch (format.encoding) {
+        case rav::AudioEncoding::pcm_u8:
+        case rav::AudioEncoding::pcm_s16:
+        case rav::AudioEncoding::pcm_s24:
+        case rav::AudioEncoding::pcm_s32:
+            return rav::WavAudioFormat::FormatCode::pcm;
+        case rav::AudioEncoding::pcm_f32:
+        case rav::AudioEncoding::pcm_f64:
+            return rav::WavAudioFormat::FormatCode::ieee_float;
+        case rav::AudioEncoding::pcm_s8:  // WAVE only knows unsigned 8-bit audio
+        case rav::AudioEncoding::undefined:
+        default:
+            return std::nullopt;
+    }
+}
+
+}  // namespace
+
+rav::AudioRecorder::AudioRecorder(const AudioRecorderOptions& options) : options_(options) {
+    writer_thread_ = std::thread([this] {
+        TRACY_SET_THREAD_NAME("audio_recorder_writer");
+#if RAV_APPLE
+        pthread_setname_np("audio_recorder_writer");
+#endif
+
+        std::vector<uint8_t> buffer(options_.write_block_size);
+
+        while (keep_going_.load(std::memory_order_acquire)) {
+            bool did_write = false;
+            for (auto& track : tracks_) {
+                const auto guard = track.rw_lock.try_lock_shared();
+                if (!guard) {
+                    continue;  // Track is being added or removed
+                }
+                did_write |= write_track(track, buffer, false);
+            }
+            if (!did_write) {
+                std::this_thread::sleep_for(options_.idle_interval);
+            }
+        }
+    });
+}
+
+rav::AudioRecorder::~AudioRecorder() {
+    keep_going_.store(false, std::memory_order_release);
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    for (auto& track : tracks_) {
+        if (const auto id = track.id; id.is_valid()) {
+            remove_track(id);
+        }
+    }
+}
+
+tl::expected<void, std::string> rav::AudioRecorder::add_track(const Id id, const TrackOptions& options) {
+    if (!id.is_valid()) {
+        return tl::unexpected("Invalid id");
+    }
+
+    const auto& format = options.format;
+    if (!format.is_valid() || format.ordering != AudioFormat::ChannelOrdering::interleaved) {
+        return tl::unexpected(fmt::format("Unsupported audio format: {}", format.to_string()));
+    }
+
+    const auto format_code = get_format_code(format);
+    if (!format_code) {
+        return tl::unexpected(fmt::format("Unsupported audio format: {}", format.to_string()));
+    }
+
+    std::lock_guard lock(mutex_);
+
+    if (find_track(id) != nullptr) {
+        return tl::unexpected("A track with given id already exists");
+    }
+
+    auto* track = find_track(Id());
+    if (track == nullptr) {
+        return tl::unexpected("Too many tracks");
+    }
+
+    std::unique_ptr<OutputStream> stream = DirectFileOutputStream::create(options.file, options_.file_options);
+    std::unique_ptr<WavAudioFormat::Writer> writer;
+
+    try {
+        if (stream == nullptr) {
+            stream = std::make_unique<FileOutputStream>(options.file);
+        }
+        WavAudioFormat::WriterOptions writer_options;
+        writer_options.rf64 = true;
+        writer_options.bext = options.bext;
+        writer = std::make_unique<WavAudioFormat::Writer>(
+            *stream, *format_code, format.sample_rate, format.num_channels, format.bytes_per_sample() * 8, writer_options
+        );
+    } catch (const std::exception& e) {
+        return tl::unexpected(fmt::format("Failed to create file {}: {}", options.file.string(), e.what()));
+    }
+
+    const auto bytes_per_frame = format.bytes_per_frame();
+    const auto block_size = std::max<size_t>(options_.write_block_size / bytes_per_frame, 1) * bytes_per_frame;
+    const auto fifo_frames = static_cast<size_t>(format.sample_rate) * static_cast<size_t>(options_.fifo_duration.count()) / 1000;
+    const auto fifo_size = std::max(fifo_frames * bytes_per_frame, 2 * block_size);
+
+    const auto guard = track->rw_lock.lock_exclusive();
+    if (!guard) {
+        return tl::unexpected("Failed to lock track");
+    }
+
+    track->id = id;
+    track->format = format;
+    track->fifo.resize(fifo_size);
+    track->frames_written = 0;
+    track->frames_dropped = 0;
+    track->first_timestamp = 0;
+    track->has_timestamp = false;
+    track->failed = false;
+    track->stream = std::move(stream);
+    track->writer = std::move(writer);
+    track->block_size = block_size;
+    track->last_finalize = std::chrono::steady_clock::now();
+
+    return {};
+}
+
+bool rav::AudioRecorder::remove_track(const Id id) {
+    std::lock_guard lock(mutex_);
+
+    auto* track = find_track(id);
+    if (track == nullptr) {
+        return false;
+    }
+
+    const auto guard = track->rw_lock.lock_exclusive();
+    if (!guard) {
+        RAV_LOG_ERROR("Failed to lock track");
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(track->block_size);
+    write_track(*track, buffer, true);
+
+    track->writer.reset();  // Finalizes the file
+    track->stream.reset();
+    track->fifo.resize(0);
+    track->id = {};
+
+    return true;
+}
+
+bool rav::AudioRecorder::write_realtime(const Id id, const uint8_t* data, const size_t size, const std::optional<uint64_t> timestamp) {
+    TRACY_ZONE_SCOPED;
+
+    for (auto& track : tracks_) {
+        const auto guard = track.rw_lock.try_lock_shared();
+        if (!guard) {
+            TRACY_MESSAGE("Failed to lock track");
+            continue;
+        }
+        if (track.id != id) {
+            continue;
+        }
+        if (!track.fifo.write(data, size)) {
+            track.frames_dropped.fetch_add(size / track.format.bytes_per_frame(), std::memory_order_relaxed);
+            return false;
+        }
+        if (timestamp && !track.has_timestamp.load(std::memory_order_relaxed)) {
+            track.first_timestamp.store(*timestamp, std::memory_order_relaxed);
+            track.has_timestamp.store(true, std::memory_order_release);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<rav::AudioRecorder::TrackStats> rav::AudioRecorder::get_track_stats(const Id id) const {
+    std::lock_guard lock(mutex_);
+
+    const auto* track = find_track(id);
+    if (track == nullptr) {
+        return std::nullopt;
+    }
+    TrackStats stats;
+    stats.frames_written = track->frames_written.load(std::memory_order_relaxed);
+    stats.frames_dropped = track->frames_dropped.load(std::memory_order_relaxed);
+    stats.failed = track->failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+rav::AudioRecorder::Track* rav::AudioRecorder::find_track(const Id id) {
+    for (auto& track : tracks_) {
+        if (track.id == id) {
+            return &track;
+        }
+    }
+    return nullptr;
+}
+
+const rav::AudioRecorder::Track* rav::AudioRecorder::find_track(const Id id) const {
+    for (auto& track : tracks_) {
+        if (track.id == id) {
+            return &track;
+        }
+    }
+    return nullptr;
+}
+
+bool rav::AudioRecorder::write_track(Track& track, std::vector<uint8_t>& buffer, bool drain) const {
+    if (track.writer == nullptr || track.failed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto finalize = drain || now - track.last_finalize >= options_.finalize_interval;
+    const auto bytes_per_frame = track.format.bytes_per_frame();
+    bool did_write = false;
+
+    if (buffer.size() < track.block_size) {
+        buffer.resize(track.block_size);
+    }
+
+    try {
+        while (true) {
+            const auto available = track.fifo.size() / bytes_per_frame * bytes_per_frame;
+            // Wait for a whole block, unless the file is about to be finalized.
+            if (available == 0 || (available < track.block_size && !finalize)) {
+                break;
+            }
+
+            const auto size = std::min(available, track.block_size);
+            if (!track.fifo.read(buffer.data(), size)) {
+                break;
+            }
+
+            if (track.format.byte_order == AudioFormat::ByteOrder::be) {
+                swap_bytes(buffer.data(), size, track.format.bytes_per_sample());
+            }
+
+            if (!track.writer->write_audio_data(buffer.data(), size)) {
+                RAV_LOG_ERROR("Failed to write audio data, recording of track stopped");
+                track.failed.store(true, std::memory_order_relaxed);
+                return did_write;
+            }
+
+            track.frames_written.fetch_add(size / bytes_per_frame, std::memory_order_relaxed);
+            did_write = true;
+
+            if (!finalize) {
+                break;  // Give the other tracks a turn
+            }
+        }
+
+        if (finalize) {
+            if (track.has_timestamp.load(std::memory_order_acquire)) {
+                const auto samples_per_day = k_seconds_per_day * track.format.sample_rate;
+                track.writer->set_time_reference(track.first_timestamp.load(std::memory_order_relaxed) % samples_per_day);
+            }
+            if (!track.writer->finalize()) {
+                RAV_LOG_ERROR("Failed to finalize file, recording of track stopped");
+                track.failed.store(true, std::memory_order_relaxed);
+            }
+            track.last_finalize = now;
+        }
+    } catch (const std::exception& e) {
+        RAV_LOG_ERROR("Failed to write audio data, recording of track stopped: {}", e.what());
+        track.failed.store(true, std::memory_order_relaxed);
+    }
+
+    return did_write;
+}
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_resampler.hpp"
+
+#include "ravennakit/core/assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define RAV_RESAMPLER_SSE 1
+    #include <emmintrin.h>
+#else
+    #define RAV_RESAMPLER_SSE 0
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+    #define RAV_RESAMPLER_NEON 1
+    #include <arm_neon.h>
+#else
+    #define RAV_RESAMPLER_NEON 0
+#endif
+
+namespace {
+
+constexpr size_t k_num_taps = rav::AudioResampler::k_num_taps;
+constexpr size_t k_num_phases = rav::AudioResampler::k_num_phases;
+constexpr double k_cutoff = 0.45;  // Relative to the input rate, leaving room for the transition band below Nyquist
+constexpr double k_kaiser_beta = 8.0;
+constexpr double k_pi = 3.14159265358979323846;
+
+static_assert(k_num_taps % 4 == 0, "The SIMD kernels process four taps at a time");
+
+using FilterTable = std::array<std::array<float, k_num_taps>, k_num_phases + 1>;
+
+double bessel_i0(const double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * Row p holds the taps for an output which lies p / k_num_phases frames after the centre tap. Row k_num_phases equals
+ * row 0 shifted by one tap, so that every phase can be interpolated with the next row. Each row has unity gain at DC.
+ */
+FilterTable make_filter_table() {
+    FilterTable table {};
+    constexpr double half_length = static_cast<double>(k_num_taps) / 2.0;
+    constexpr double centre = half_length - 1.0;
+    const double i0_beta = bessel_i0(k_kaiser_beta);
+
+    for (size_t p = 0; p <= k_num_phases; ++p) {
+        const double fraction = static_cast<double>(p) / static_cast<double>(k_num_phases);
+        std::array<double, k_num_taps> taps {};
+        double sum = 0.0;
+        for (size_t k = 0; k < k_num_taps; ++k) {
+            const double t = static_cast<double>(k) - centre - fraction;
+            const double x = 2.0 * k_cutoff * t;
+            const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(k_pi * x) / (k_pi * x);
+            const double w = std::clamp(t / half_length, -1.0, 1.0);
+            taps[k] = 2.0 * k_cutoff * sinc * bessel_i0(k_kaiser_beta * std::sqrt(1.0 - w * w)) / i0_beta;
+            sum += taps[k];
+        }
+        for (size_t k = 0; k < k_num_taps; ++k) {
+            table[p][k] = static_cast<float>(taps[k] / sum);
+        }
+    }
+
+    return table;
+}
+
+const FilterTable& get_filter_table() {
+    static const FilterTable table = make_filter_table();
+    return table;
+}
+
+/**
+ * Computes the dot products of the input with two adjacent filter rows in one pass.
+ */
+void dot_2(const float* input, const float* row_a, const float* row_b, float& out_a, float& out_b) {
+#if RAV_RESAMPLER_SSE
+    __m128 sum_a = _mm_setzero_ps();
+    __m128 sum_b = _mm_setzero_ps();
+    for (size_t k = 0; k < k_num_taps; k += 4) {
+        const __m128 x = _mm_loadu_ps(input + k);
+        sum_a = _mm_add_ps(sum_a, _mm_mul_ps(x, _mm_loadu_ps(row_a + k)));
+        sum_b = _mm_add_ps(sum_b, _mm_mul_ps(x, _mm_loadu_ps(row_b + k)));
+    }
+    alignas(16) float a[4];
+    alignas(16) float b[4];
+    _mm_store_ps(a, sum_a);
+    _mm_store_ps(b, sum_b);
+    out_a = (a[0] + a[1]) + (a[2] + a[3]);
+    out_b = (b[0] + b[1]) + (b[2] + b[3]);
+#elif RAV_RESAMPLER_NEON
+    float32x4_t sum_a = vdupq_n_f32(0.0f);
+    float32x4_t sum_b = vdupq_n_f32(0.0f);
+    for (size_t k = 0; k < k_num_taps; k += 4) {
+        const float32x4_t x = vld1q_f32(input + k);
+        sum_a = vmlaq_f32(sum_a, x, vld1q_f32(row_a + k));
+        sum_b = vmlaq_f32(sum_b, x, vld1q_f32(row_b + k));
+    }
+    const float32x2_t a = vadd_f32(vget_low_f32(sum_a), vget_high_f32(sum_a));
+    const float32x2_t b = vadd_f32(vget_low_f32(sum_b), vget_high_f32(sum_b));
+    out_a = vget_lane_f32(a, 0) + vget_lane_f32(a, 1);
+    out_b = vget_lane_f32(b, 0) + vget_lane_f32(b, 1);
+#else
+    float sum_a = 0.0f;
+    float sum_b = 0.0f;
+    for (size_t k = 0; k < k_num_taps; ++k) {
+        sum_a += input[k] * row_a[k];
+        sum_b += input[k] * row_b[k];
+    }
+    out_a = sum_a;
+    out_b = sum_b;
+#endif
+}
+
+}  // namespace
+
+void rav::AudioResampler::resize(
+    const size_t num_channels, const size_t max_num_output_frames, const double max_ratio, const ArenaAllocator<float>& allocator
+) {
+    RAV_ASSERT(max_ratio > 0.0, "Ratio must be positive");
+    std::ignore = get_filter_table();  // Build the table outside the realtime thread
+
+    num_channels_ = num_channels;
+    max_num_output_frames_ = max_num_output_frames;
+    capacity_ = k_num_taps + static_cast<size_t>(std::ceil(static_cast<double>(max_num_output_frames) * max_ratio)) + 2;
+
+    buffer_ = ArenaVector<float>(allocator);
+    buffer_.resize(num_channels_ * capacity_);
+    channels_ = ArenaVector<float*>(ArenaAllocator<float*>(allocator));
+    channels_.resize(num_channels_);
+
+    reset();
+}
+
+void rav::AudioResampler::reset() {
+    std::fill(buffer_.begin(), buffer_.end(), 0.0f);
+    num_frames_buffered_ = capacity_ == 0 ? 0 : k_num_taps - 1;
+    position_ = 0.0;
+}
+
+void rav::AudioResampler::set_ratio(const double ratio) {
+    RAV_ASSERT(ratio > 0.0, "Ratio must be positive");
+    if (ratio > 0.0) {
+        ratio_ = ratio;
+    }
+}
+
+double rav::AudioResampler::get_ratio() const {
+    return ratio_;
+}
+
+size_t rav::AudioResampler::num_channels() const {
+    return num_channels_;
+}
+
+size_t rav::AudioResampler::max_num_output_frames() const {
+    return max_num_output_frames_;
+}
+
+size_t rav::AudioResampler::get_num_input_frames_needed(const size_t num_output_frames) const {
+    if (num_output_frames == 0) {
+        return 0;
+    }
+    const auto last = static_cast<size_t>(position_ + static_cast<double>(num_output_frames - 1) * ratio_);
+    const auto required = last + k_num_taps;
+    return required > num_frames_buffered_ ? required - num_frames_buffered_ : 0;
+}
+
+float* const* rav::AudioResampler::prepare_input(size_t num_frames) {
+    if (num_frames_buffered_ + num_frames > capacity_) {
+        RAV_ASSERT_FALSE("More input than the resampler can hold");
+        // Keep the newest frames so that the returned channels are valid
+        num_frames = std::min(num_frames, capacity_);
+        const auto keep = capacity_ - num_frames;
+        const auto discard = num_frames_buffered_ - std::min(keep, num_frames_buffered_);
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            auto* channel = buffer_.data() + ch * capacity_;
+            std::memmove(channel, channel + discard, (num_frames_buffered_ - discard) * sizeof(float));
+        }
+        num_frames_buffered_ -= discard;
+        position_ = 0.0;
+    }
+
+    for (size_t ch = 0; ch < num_channels_; ++ch) {
+        channels_[ch] = buffer_.data() + ch * capacity_ + num_frames_buffered_;
+    }
+    num_frames_buffered_ += num_frames;
+    return channels_.data();
+}
+
+void rav::AudioResampler::process(float* const* output, const size_t output_offset, const size_t num_frames) {
+    RAV_ASSERT(num_frames <= max_num_output_frames_, "Too many frames");
+    RAV_ASSERT(get_num_input_frames_needed(num_frames) == 0, "Not enough input");
+
+    const auto& table = get_filter_table();
+    const auto last_index = num_frames_buffered_ >= k_num_taps ? num_frames_buffered_ - k_num_taps : 0;
+
+    for (size_t i = 0; i < num_frames; ++i) {
+        const double position = position_ + static_cast<double>(i) * ratio_;
+        const auto index = std::min(static_cast<size_t>(position), last_index);
+        const double phase = (position - static_cast<double>(index)) * static_cast<double>(k_num_phases);
+        const auto row = std::min(static_cast<size_t>(phase), k_num_phases - 1);
+        const auto weight = static_cast<float>(phase - static_cast<double>(row));
+
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            float a {};
+            float b {};
+            dot_2(buffer_.data() + ch * capacity_ + index, table[row].data(), table[row + 1].data(), a, b);
+            output[ch][output_offset + i] = a + (b - a) * weight;
+        }
+    }
+
+    // Discard the input which is no longer needed
+    position_ += static_cast<double>(num_frames) * ratio_;
+    const auto consumed = std::min(static_cast<size_t>(position_), num_frames_buffered_);
+    if (consumed > 0) {
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            auto* channel = buffer_.data() + ch * capacity_;
+            std::memmove(channel, channel + consumed, (num_frames_buffered_ - consumed) * sizeof(float));
+        }
+        num_frames_buffered_ -= consumed;
+        position_ -= static_cast<double>(consumed);
+    }
+}
+
+double rav::AudioResampler::get_num_buffered_frames() const {
+    return static_cast<double>(num_frames_buffered_) - position_;
+}
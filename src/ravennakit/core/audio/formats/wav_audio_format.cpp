@@ -28,9 +28,30 @@
 #include "ravennakit/core/exception.hpp"
 #include "ravennakit/core/util/todo.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <tuple>
 
-namespace {}
+namespace {
+
+constexpr uint32_t k_ds64_chunk_size = 28;  // Without the table, which is not used.
+constexpr uint32_t k_size_placeholder = 0xffffffff;
+
+std::string read_fixed_string(rav::InputStream& istream, const size_t size) {
+    auto str = istream.read_as_string(size).value();
+    str.erase(std::find(str.begin(), str.end(), '\0'), str.end());
+    return str;
+}
+
+tl::expected<void, rav::OutputStream::Error>
+write_fixed_string(rav::OutputStream& ostream, const std::string& str, const size_t size) {
+    std::array<char, 256> buffer {};
+    RAV_ASSERT(size <= buffer.size(), "Field too large");
+    std::memcpy(buffer.data(), str.data(), std::min(str.size(), size));
+    return ostream.write(buffer.data(), size);
+}
+
+}  // namespace
 
 void rav::WavAudioFormat::FmtChunk::read(InputStream& istream, const uint32_t chunk_size) {
     format = istream.read_le<FormatCode>().value();
@@ -177,7 +198,7 @@ std::optional<rav::AudioFormat> rav::WavAudioFormat::FmtChunk::to_audio_format()
     return std::nullopt;
 }
 
-bool rav::WavAudioFormat::DataChunk::read(InputStream& istream, const uint32_t chunk_size) {
+bool rav::WavAudioFormat::DataChunk::read(InputStream& istream, const size_t chunk_size) {
     data_begin = istream.get_read_position();
     data_size = chunk_size;
     return istream.skip(chunk_size);
@@ -194,7 +215,8 @@ tl::expected<size_t, rav::OutputStream::Error> rav::WavAudioFormat::DataChunk::w
     if (!result) {
         return result;
     }
-    result = ostream.write_le<uint32_t>(static_cast<uint32_t>(data_size)).map(map_value);
+    const auto size_field = data_size < k_size_placeholder ? static_cast<uint32_t>(data_size) : k_size_placeholder;
+    result = ostream.write_le<uint32_t>(size_field).map(map_value);
     if (!result) {
         return result;
     }
@@ -202,13 +224,86 @@ tl::expected<size_t, rav::OutputStream::Error> rav::WavAudioFormat::DataChunk::w
     return data_begin - pos;
 }
 
+void rav::WavAudioFormat::BextChunk::read(InputStream& istream, const uint32_t chunk_size) {
+    if (chunk_size < k_fixed_size) {
+        RAV_THROW_EXCEPTION("Invalid bext chunk size");
+    }
+    description = read_fixed_string(istream, 256);
+    originator = read_fixed_string(istream, 32);
+    originator_reference = read_fixed_string(istream, 32);
+    origination_date = read_fixed_string(istream, 10);
+    origination_time = read_fixed_string(istream, 8);
+    time_reference = istream.read_le<uint64_t>().value();
+    version = istream.read_le<uint16_t>().value();
+    umid = istream.read_le<std::array<uint8_t, 64>>().value();
+    loudness_value = istream.read_le<int16_t>().value();
+    loudness_range = istream.read_le<int16_t>().value();
+    max_true_peak_level = istream.read_le<int16_t>().value();
+    max_momentary_loudness = istream.read_le<int16_t>().value();
+    max_short_term_loudness = istream.read_le<int16_t>().value();
+    if (!istream.skip(180)) {  // Reserved
+        RAV_THROW_EXCEPTION("Failed to read bext chunk");
+    }
+    coding_history = read_fixed_string(istream, chunk_size - k_fixed_size);
+}
+
+tl::expected<size_t, rav::OutputStream::Error> rav::WavAudioFormat::BextChunk::write(OutputStream& ostream) const {
+    const auto start_pos = ostream.get_write_position();
+
+    if (auto result = ostream.write("bext", 4); !result) {
+        return tl::unexpected(result.error());
+    }
+    if (auto result = ostream.write_le<uint32_t>(k_fixed_size + static_cast<uint32_t>(coding_history.size())); !result) {
+        return tl::unexpected(result.error());
+    }
+    for (auto [str, size] : {
+             std::pair {&description, 256},
+             std::pair {&originator, 32},
+             std::pair {&originator_reference, 32},
+             std::pair {&origination_date, 10},
+             std::pair {&origination_time, 8},
+         }) {
+        if (auto result = write_fixed_string(ostream, *str, static_cast<size_t>(size)); !result) {
+            return tl::unexpected(result.error());
+        }
+    }
+    if (auto result = ostream.write_le(time_reference); !result) {
+        return tl::unexpected(result.error());
+    }
+    if (auto result = ostream.write_le(version); !result) {
+        return tl::unexpected(result.error());
+    }
+    if (auto result = ostream.write_le(umid); !result) {
+        return tl::unexpected(result.error());
+    }
+    for (const auto value :
+         {loudness_value, loudness_range, max_true_peak_level, max_momentary_loudness, max_short_term_loudness}) {
+        if (auto result = ostream.write_le(value); !result) {
+            return tl::unexpected(result.error());
+        }
+    }
+    if (auto result = ostream.write_le(std::array<uint8_t, 180> {}); !result) {  // Reserved
+        return tl::unexpected(result.error());
+    }
+    if (auto result = ostream.write(coding_history.data(), coding_history.size()); !result) {
+        return tl::unexpected(result.error());
+    }
+    if (coding_history.size() % 2 == 1) {
+        if (auto result = ostream.write_le<uint8_t>(0); !result) {  // Padding
+            return tl::unexpected(result.error());
+        }
+    }
+
+    return ostream.get_write_position() - start_pos;
+}
+
 rav::WavAudioFormat::Reader::Reader(std::unique_ptr<InputStream> istream) : istream_(std::move(istream)) {
     RAV_ASSERT(istream_, "Invalid input stream");
 
     // RIFF header
     const auto riff_header = istream_->read_as_string(4);
-    if (riff_header != "RIFF") {
-        RAV_THROW_EXCEPTION("expecting RIFF header");
+    if (riff_header != "RIFF" && riff_header != "RF64") {
+        RAV_THROW_EXCEPTION("expecting RIFF or RF64 header");
     }
 
     // RIFF size
@@ -225,6 +320,9 @@ rav::WavAudioFormat::Reader::Reader(std::unique_ptr<InputStream> istream) : istr
         RAV_THROW_EXCEPTION("expecting WAVE header");
     }
 
+    // The sizes of an RF64 file, which don't fit in the 32-bit size fields.
+    std::optional<uint64_t> ds64_data_size;
+
     // Loop through chunks
     while (!istream_->exhausted()) {
         if (istream_->get_read_position() % 2 == 1) {
@@ -252,9 +350,32 @@ rav::WavAudioFormat::Reader::Reader(std::unique_ptr<InputStream> istream) : istr
             continue;
         }
 
+        if (chunk_id == "ds64") {
+            if (chunk_size.value() < k_ds64_chunk_size) {
+                RAV_THROW_EXCEPTION("invalid ds64 chunk size");
+            }
+            std::ignore = istream_->read_le<uint64_t>().value();  // RIFF size
+            ds64_data_size = istream_->read_le<uint64_t>().value();
+            std::ignore = istream_->read_le<uint64_t>().value();  // Sample count
+            if (!istream_->skip(chunk_size.value() - 24)) {
+                RAV_THROW_EXCEPTION("failed to skip ds64 table");
+            }
+            continue;
+        }
+
+        if (chunk_id == "bext") {
+            bext_chunk_.emplace();
+            bext_chunk_->read(*istream_, chunk_size.value());
+            continue;
+        }
+
         if (chunk_id == "data") {
+            size_t data_size = chunk_size.value();
+            if (data_size == k_size_placeholder && ds64_data_size.has_value()) {
+                data_size = static_cast<size_t>(*ds64_data_size);
+            }
             data_chunk_.emplace();
-            if (!data_chunk_->read(*istream_, chunk_size.value())) {
+            if (!data_chunk_->read(*istream_, data_size)) {
                 RAV_THROW_EXCEPTION("failed to read data chunk");
             }
             continue;
@@ -318,10 +439,24 @@ std::optional<rav::AudioFormat> rav::WavAudioFormat::Reader::get_audio_format()
     return fmt_chunk_->to_audio_format();
 }
 
+const std::optional<rav::WavAudioFormat::BextChunk>& rav::WavAudioFormat::Reader::get_bext_chunk() const {
+    return bext_chunk_;
+}
+
+const std::optional<rav::WavAudioFormat::DataChunk>& rav::WavAudioFormat::Reader::get_data_chunk() const {
+    return data_chunk_;
+}
+
 rav::WavAudioFormat::Writer::Writer(
     OutputStream& ostream, const FormatCode format, const double sample_rate, const size_t num_channels, const size_t bits_per_sample
 ) :
-    ostream_(ostream) {
+    Writer(ostream, format, sample_rate, num_channels, bits_per_sample, WriterOptions {}) {}
+
+rav::WavAudioFormat::Writer::Writer(
+    OutputStream& ostream, const FormatCode format, const double sample_rate, const size_t num_channels,
+    const size_t bits_per_sample, WriterOptions options
+) :
+    ostream_(ostream), options_(std::move(options)) {
     fmt_chunk_.format = format;
     fmt_chunk_.sample_rate = static_cast<uint32_t>(sample_rate);
     fmt_chunk_.num_channels = static_cast<uint16_t>(num_channels);
@@ -357,20 +492,33 @@ bool rav::WavAudioFormat::Writer::finalize() {
     return true;
 }
 
+void rav::WavAudioFormat::Writer::set_time_reference(const uint64_t time_reference) {
+    if (options_.bext.has_value()) {
+        options_.bext->time_reference = time_reference;
+    }
+}
+
+size_t rav::WavAudioFormat::Writer::get_audio_data_written() const {
+    return audio_data_written_;
+}
+
 tl::expected<void, rav::OutputStream::Error> rav::WavAudioFormat::Writer::write_header() {
     const auto pos = ostream_.get_write_position();
     auto result = ostream_.set_write_position(0);
     if (!result) {
         return result;
     }
-    result = ostream_.write("RIFF", 4);
+
+    // The riff size will only be correct after calling write_header() once before.
+    const auto riff_size = chunks_total_size_ + audio_data_written_ + 4;  // +4 for "WAVE"
+    const auto is_rf64 = options_.rf64 && riff_size >= k_size_placeholder;
+    RAV_ASSERT(is_rf64 || riff_size < k_size_placeholder, "WAV file too large");
+
+    result = ostream_.write(is_rf64 ? "RF64" : "RIFF", 4);
     if (!result) {
         return result;
     }
-    // The riff size will only be correct after calling write_header() once before.
-    const auto riff_size = chunks_total_size_ + audio_data_written_ + 4;  // +4 for "WAVE"
-    RAV_ASSERT(riff_size < std::numeric_limits<uint32_t>::max(), "WAV file too large");
-    result = ostream_.write_le<uint32_t>(static_cast<uint32_t>(riff_size));
+    result = ostream_.write_le<uint32_t>(is_rf64 ? k_size_placeholder : static_cast<uint32_t>(riff_size));
     if (!result) {
         return result;
     }
@@ -378,8 +526,45 @@ tl::expected<void, rav::OutputStream::Error> rav::WavAudioFormat::Writer::write_
     if (!result) {
         return result;
     }
-    chunks_total_size_ = fmt_chunk_.write(ostream_).value();                         // TODO: Handle error
-    chunks_total_size_ += data_chunk_.write(ostream_, audio_data_written_).value();  // TODO: Handle error
+
+    size_t chunks_total_size = 0;
+
+    if (options_.rf64) {
+        // A JUNK chunk reserves the space for the ds64 chunk until the file crosses the 4 GB limit.
+        result = ostream_.write(is_rf64 ? "ds64" : "JUNK", 4);
+        if (!result) {
+            return result;
+        }
+        result = ostream_.write_le(k_ds64_chunk_size);
+        if (!result) {
+            return result;
+        }
+        const auto num_frames = fmt_chunk_.block_align > 0 ? audio_data_written_ / fmt_chunk_.block_align : 0;
+        for (const auto value : {uint64_t {riff_size}, uint64_t {audio_data_written_}, uint64_t {num_frames}}) {
+            result = ostream_.write_le<uint64_t>(is_rf64 ? value : 0);
+            if (!result) {
+                return result;
+            }
+        }
+        result = ostream_.write_le<uint32_t>(0);  // Table length
+        if (!result) {
+            return result;
+        }
+        chunks_total_size += 8 + k_ds64_chunk_size;
+    }
+
+    chunks_total_size += fmt_chunk_.write(ostream_).value();  // TODO: Handle error
+
+    if (options_.bext.has_value()) {
+        const auto bext_size = options_.bext->write(ostream_);
+        if (!bext_size) {
+            return tl::unexpected(bext_size.error());
+        }
+        chunks_total_size += *bext_size;
+    }
+
+    chunks_total_size += data_chunk_.write(ostream_, audio_data_written_).value();  // TODO: Handle error
+    chunks_total_size_ = chunks_total_size;
 
     if (pos > 0) {
         result = ostream_.set_write_position(pos);
@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/byte_order.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define RAV_BYTE_SWAP_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define RAV_TARGET(x)
+    #else
+        #define RAV_TARGET(x) __attribute__((target(x)))
+    #endif
+#else
+    #define RAV_BYTE_SWAP_X86 0
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+    #define RAV_BYTE_SWAP_NEON 1
+    #include <arm_neon.h>
+#else
+    #define RAV_BYTE_SWAP_NEON 0
+#endif
+
+namespace {
+
+void swap_16_scalar(const uint8_t* src, uint8_t* dst, const size_t size) {
+    for (size_t i = 0; i + 2 <= size; i += 2) {
+        uint16_t value {};
+        std::memcpy(&value, src + i, sizeof(value));
+        value = RAV_BYTE_SWAP_16(value);
+        std::memcpy(dst + i, &value, sizeof(value));
+    }
+}
+
+void swap_24_scalar(const uint8_t* src, uint8_t* dst, const size_t size) {
+    for (size_t i = 0; i + 3 <= size; i += 3) {
+        const auto first = src[i];
+        dst[i] = src[i + 2];
+        dst[i + 1] = src[i + 1];
+        dst[i + 2] = first;
+    }
+}
+
+void swap_32_scalar(const uint8_t* src, uint8_t* dst, const size_t size) {
+    for (size_t i = 0; i + 4 <= size; i += 4) {
+        uint32_t value {};
+        std::memcpy(&value, src + i, sizeof(value));
+        value = RAV_BYTE_SWAP_32(value);
+        std::memcpy(dst + i, &value, sizeof(value));
+    }
+}
+
+#if RAV_BYTE_SWAP_X86
+
+// The vector kernels load a block before storing it, and the blocks don't overlap (apart from bytes which are stored
+// unchanged), so the kernels work in place as well.
+
+RAV_TARGET("ssse3") void swap_16_ssse3(const uint8_t* src, uint8_t* dst, const size_t size) {
+    const auto mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    swap_16_scalar(src + i, dst + i, size - i);
+}
+
+RAV_TARGET("ssse3") void swap_24_ssse3(const uint8_t* src, uint8_t* dst, const size_t size) {
+    // Swaps 5 samples (15 bytes) per block, the last byte is stored unchanged and overwritten by the next block.
+    const auto mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 15) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    swap_24_scalar(src + i, dst + i, size - i);
+}
+
+RAV_TARGET("ssse3") void swap_32_ssse3(const uint8_t* src, uint8_t* dst, const size_t size) {
+    const auto mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    swap_32_scalar(src + i, dst + i, size - i);
+}
+
+RAV_TARGET("avx2") void swap_16_avx2(const uint8_t* src, uint8_t* dst, const size_t size) {
+    const auto mask = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+    );
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    swap_16_ssse3(src + i, dst + i, size - i);
+}
+
+RAV_TARGET("avx2") void swap_24_avx2(const uint8_t* src, uint8_t* dst, const size_t size) {
+    // vpshufb only shuffles within 128-bit lanes, so 8 samples (24 bytes) are spread over the lanes as dwords 0-3 and
+    // 3-6, swapped (4 samples per lane), and packed together again. The last 8 bytes are stored unchanged.
+    const auto spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    const auto pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 6, 7);
+    const auto mask = _mm256_setr_epi8(
+        2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15, 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15
+    );
+    size_t i = 0;
+    for (; i + 32 <= size; i += 24) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const auto swapped = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(v, spread), mask);
+        const auto packed = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(swapped, pack), v, 0b11000000);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    swap_24_ssse3(src + i, dst + i, size - i);
+}
+
+RAV_TARGET("avx2") void swap_32_avx2(const uint8_t* src, uint8_t* dst, const size_t size) {
+    const auto mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+    );
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    swap_32_ssse3(src + i, dst + i, size - i);
+}
+
+bool cpu_supports_ssse3() {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+    #else
+    return __builtin_cpu_supports("ssse3");
+    #endif
+}
+
+bool cpu_supports_avx2() {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] {};
+    __cpuid(info, 1);
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    if (!os_saves_ymm) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+    #else
+    return __builtin_cpu_supports("avx2");
+    #endif
+}
+
+#endif
+
+#if RAV_BYTE_SWAP_NEON
+
+void swap_16_neon(const uint8_t* src, uint8_t* dst, const size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, vrev16q_u8(vld1q_u8(src + i)));
+    }
+    swap_16_scalar(src + i, dst + i, size - i);
+}
+
+void swap_24_neon(const uint8_t* src, uint8_t* dst, const size_t size) {
+    // Deinterleaves 16 samples into their first, second and third bytes, and interleaves them back in reverse order.
+    size_t i = 0;
+    for (; i + 48 <= size; i += 48) {
+        auto v = vld3q_u8(src + i);
+        const auto first = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = first;
+        vst3q_u8(dst + i, v);
+    }
+    swap_24_scalar(src + i, dst + i, size - i);
+}
+
+void swap_32_neon(const uint8_t* src, uint8_t* dst, const size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, vrev32q_u8(vld1q_u8(src + i)));
+    }
+    swap_32_scalar(src + i, dst + i, size - i);
+}
+
+#endif
+
+}  // namespace
+
+const rav::ByteSwapKernels& rav::get_byte_swap_kernels() {
+    static const ByteSwapKernels kernels = get_supported_byte_swap_kernels().back();
+    return kernels;
+}
+
+const std::vector<rav::ByteSwapKernels>& rav::get_supported_byte_swap_kernels() {
+    static const std::vector<ByteSwapKernels> kernels = [] {
+        std::vector<ByteSwapKernels> result;
+        result.push_back({"scalar", swap_16_scalar, swap_24_scalar, swap_32_scalar});
+#if RAV_BYTE_SWAP_X86
+        if (cpu_supports_ssse3()) {
+            result.push_back({"ssse3", swap_16_ssse3, swap_24_ssse3, swap_32_ssse3});
+        }
+        if (cpu_supports_ssse3() && cpu_supports_avx2()) {
+            result.push_back({"avx2", swap_16_avx2, swap_24_avx2, swap_32_avx2});
+        }
+#endif
+#if RAV_BYTE_SWAP_NEON
+        result.push_back({"neon", swap_16_neon, swap_24_neon, swap_32_neon});
+#endif
+        return result;
+    }();
+    return kernels;
+}
@@ -30,8 +30,9 @@
 
 #if RAV_WINDOWS
 size_t rav::receive_from_socket(
-    boost::asio::ip::udp::socket& socket, std::array<uint8_t, 1500>& data_buf, boost::asio::ip::udp::endpoint& src_endpoint,
-    boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time, boost::system::error_code& ec
+    boost::asio::ip::udp::socket& socket, const uint16_t local_port, std::array<uint8_t, 1500>& data_buf,
+    boost::asio::ip::udp::endpoint& src_endpoint, boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time,
+    boost::system::error_code& ec
 ) {
     TRACY_ZONE_SCOPED;
     // Set up the message structure
@@ -71,12 +72,7 @@ size_t rav::receive_from_socket(
             auto* pktinfo = reinterpret_cast<IN_PKTINFO*>(WSA_CMSG_DATA(cmsg));
             IN_ADDR dest_addr = pktinfo->ipi_addr;
 
-            dst_endpoint =
-                boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4(ntohl(dest_addr.s_addr)), socket.local_endpoint(ec).port());
-
-            if (ec) {
-                RAV_LOG_ERROR("Failed to get port from local endpoint");
-            }
+            dst_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4(ntohl(dest_addr.s_addr)), local_port);
 
             char dest_ip[INET_ADDRSTRLEN];
             inet_ntop(AF_INET, &dest_addr, dest_ip, sizeof(dest_ip));
@@ -88,13 +84,18 @@ size_t rav::receive_from_socket(
 }
 #else
 size_t rav::receive_from_socket(
-    boost::asio::ip::udp::socket& socket, std::array<uint8_t, 1500>& data_buf, boost::asio::ip::udp::endpoint& src_endpoint,
-    boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time, boost::system::error_code& ec
+    boost::asio::ip::udp::socket& socket, const uint16_t local_port, std::array<uint8_t, 1500>& data_buf,
+    boost::asio::ip::udp::endpoint& src_endpoint, boost::asio::ip::udp::endpoint& dst_endpoint, uint64_t& recv_time,
+    boost::system::error_code& ec
 ) {
     TRACY_ZONE_SCOPED;
     sockaddr_in src_addr {};
     iovec iov[1];
+#if RAV_APPLE
     char ctrl_buf[CMSG_SPACE(sizeof(in_addr))];
+#else
+    char ctrl_buf[CMSG_SPACE(sizeof(in_pktinfo))];
+#endif
     msghdr msg {};
 
     iov[0].iov_base = data_buf.data();
@@ -118,8 +119,12 @@ size_t rav::receive_from_socket(
     // Extract the destination IP from the control message
     for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
         if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR_PKTINFO) {
+#if RAV_APPLE
             const auto* dst_addr = reinterpret_cast<struct in_addr*>(CMSG_DATA(cmsg));
-            dst_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4(ntohl(dst_addr->s_addr)), ntohs(src_addr.sin_port));
+#else
+            const auto* dst_addr = &reinterpret_cast<struct in_pktinfo*>(CMSG_DATA(cmsg))->ipi_addr;
+#endif
+            dst_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4(ntohl(dst_addr->s_addr)), local_port);
         }
     }
 
@@ -153,6 +158,7 @@ class rav::ExtendedUdpSocket::Impl: public std::enable_shared_from_this<Impl> {
 
   private:
     boost::asio::ip::udp::socket socket_;
+    uint16_t local_port_ {};                             // The port the socket is bound to.
     boost::asio::ip::udp::endpoint sender_endpoint_ {};  // For receiving the senders address.
     std::array<uint8_t, 1500> recv_data_ {};
     HandlerType handler_;
@@ -245,6 +251,7 @@ rav::ExtendedUdpSocket::Impl::Impl(boost::asio::io_context& io_context, const bo
     socket_.open(endpoint.protocol());
     socket_.set_option(boost::asio::ip::udp::socket::reuse_address(true));
     socket_.bind(endpoint);
+    local_port_ = socket_.local_endpoint().port();
     socket_.non_blocking(true);
     socket_.set_option(boost::asio::detail::socket_option::integer<IPPROTO_IP, IP_RECVDSTADDR_PKTINFO>(1));
 }
@@ -286,7 +293,9 @@ void rav::ExtendedUdpSocket::Impl::async_receive() {
             boost::asio::ip::udp::endpoint src_endpoint;
             boost::asio::ip::udp::endpoint dst_endpoint;
             uint64_t recv_time = 0;
-            const auto bytes_received = receive_from_socket(self->socket_, self->recv_data_, src_endpoint, dst_endpoint, recv_time, ec);
+            const auto bytes_received = receive_from_socket(
+                self->socket_, self->local_port_, self->recv_data_, src_endpoint, dst_endpoint, recv_time, ec
+            );
 
             if (ec) {
                 RAV_LOG_ERROR("Read error: {}. Closing connection.", ec.message());
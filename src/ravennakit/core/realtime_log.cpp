@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/realtime_log.hpp"
+#include "ravennakit/core/log.hpp"
+
+namespace {
+
+constexpr auto k_write_interval = std::chrono::milliseconds(20);
+
+}
+
+rav::RealtimeLogger::RealtimeLogger() : cells_(k_queue_capacity) {
+    static_assert((k_queue_capacity & (k_queue_capacity - 1)) == 0, "Capacity must be a power of two");
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread([this] {
+        std::unique_lock lock(thread_mutex_);
+        while (keep_going_) {
+            condition_.wait_for(lock, k_write_interval);
+            lock.unlock();
+            write_pending_messages();
+            lock.lock();
+        }
+    });
+}
+
+rav::RealtimeLogger::~RealtimeLogger() {
+    {
+        std::lock_guard lock(thread_mutex_);
+        keep_going_ = false;
+    }
+    condition_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    write_pending_messages();
+}
+
+void rav::RealtimeLogger::flush() {
+    write_pending_messages();
+}
+
+void rav::RealtimeLogger::set_rate_limit_interval(const std::chrono::milliseconds interval) {
+    rate_limit_interval_ns_.store(static_cast<uint64_t>(std::chrono::nanoseconds(interval).count()), std::memory_order_relaxed);
+}
+
+void rav::RealtimeLogger::set_sink(Sink sink) {
+    std::lock_guard lock(consumer_mutex_);
+    sink_ = std::move(sink);
+}
+
+uint64_t rav::RealtimeLogger::get_num_dropped() const {
+    return num_dropped_.load(std::memory_order_relaxed);
+}
+
+rav::RealtimeLogger& rav::RealtimeLogger::get_instance() {
+    static RealtimeLogger instance;
+    return instance;
+}
+
+bool rav::RealtimeLogger::push(const Message& message) {
+    // Bounded MPMC queue by Dmitry Vyukov, used with a single consumer.
+    auto position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = cells_[position & (k_queue_capacity - 1)];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (diff == 0) {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.message = message;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void rav::RealtimeLogger::write_pending_messages() {
+    std::lock_guard lock(consumer_mutex_);
+
+    std::string text;
+    while (true) {
+        auto& cell = cells_[dequeue_position_ & (k_queue_capacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+            break;  // Empty
+        }
+
+        const auto& message = cell.message;
+        text.clear();
+        if (message.format_function != nullptr) {
+            message.format_function(message, text);
+        } else {
+            text.assign(message.data.data(), message.size);
+        }
+        if (message.num_suppressed > 0) {
+            fmt::format_to(std::back_inserter(text), " (suppressed {} similar messages)", message.num_suppressed);
+        }
+        const auto level = message.level;
+
+        cell.sequence.store(dequeue_position_ + k_queue_capacity, std::memory_order_release);
+        ++dequeue_position_;
+
+        write(level, text);
+    }
+
+    const auto num_dropped = num_dropped_.load(std::memory_order_relaxed);
+    if (num_dropped != num_dropped_reported_) {
+        write(Level::warning, fmt::format("Realtime logger dropped {} messages", num_dropped - num_dropped_reported_));
+        num_dropped_reported_ = num_dropped;
+    }
+}
+
+void rav::RealtimeLogger::write(const Level level, const std::string& text) const {
+    if (sink_) {
+        sink_(level, text);
+        return;
+    }
+
+    switch (level) {
+        case Level::critical:
+            RAV_LOG_CRITICAL("{}", text);
+            break;
+        case Level::error:
+            RAV_LOG_ERROR("{}", text);
+            break;
+        case Level::warning:
+            RAV_LOG_WARNING("{}", text);
+            break;
+        case Level::info:
+            RAV_LOG_INFO("{}", text);
+            break;
+        case Level::debug:
+            RAV_LOG_DEBUG("{}", text);
+            break;
+        case Level::trace:
+            RAV_LOG_TRACE("{}", text);
+            break;
+    }
+}
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/streams/direct_file_output_stream.hpp"
+
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <tuple>
+
+#if RAV_POSIX
+    #include <fcntl.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace {
+
+constexpr auto k_alignment = rav::DirectFileOutputStream::k_alignment;
+
+size_t align_down(const size_t value) {
+    return value / k_alignment * k_alignment;
+}
+
+size_t align_up(const size_t value) {
+    return (value + k_alignment - 1) / k_alignment * k_alignment;
+}
+
+}  // namespace
+
+void rav::DirectFileOutputStream::AlignedDeleter::operator()(uint8_t* ptr) const {
+    ::operator delete(ptr, std::align_val_t {k_alignment});
+}
+
+rav::DirectFileOutputStream::~DirectFileOutputStream() {
+#if RAV_POSIX
+    if (!flush_buffer()) {
+        RAV_LOG_ERROR("Failed to write the remaining data to file");
+    }
+    if (preallocated_end_ > file_size_) {
+        // Releases the space which was reserved beyond the end of the file.
+        if (ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+            RAV_LOG_WARNING("Failed to truncate file: {}", std::strerror(errno));
+        }
+    }
+    if (direct_fd_ >= 0 && direct_fd_ != fd_) {
+        close(direct_fd_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+#endif
+}
+
+std::unique_ptr<rav::DirectFileOutputStream>
+rav::DirectFileOutputStream::create(const std::filesystem::path& file, const DirectFileOutputStreamOptions& options) {
+#if RAV_POSIX
+    const auto buffer_size = align_up(std::max(options.buffer_size, k_alignment));
+
+    const auto fd = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        RAV_LOG_ERROR("Failed to open file {}: {}", file.string(), std::strerror(errno));
+        return nullptr;
+    }
+
+    std::unique_ptr<DirectFileOutputStream> stream(new DirectFileOutputStream());
+    stream->fd_ = fd;
+    stream->buffer_.reset(static_cast<uint8_t*>(::operator new(buffer_size, std::align_val_t {k_alignment})));
+    stream->buffer_size_ = buffer_size;
+
+    if (options.direct_io) {
+    #if RAV_LINUX
+        stream->direct_fd_ = open(file.c_str(), O_WRONLY | O_DIRECT | O_CLOEXEC);
+        if (stream->direct_fd_ < 0) {
+            RAV_LOG_WARNING("Direct io not available for {}: {}", file.string(), std::strerror(errno));
+        }
+    #elif RAV_APPLE
+        // F_NOCACHE has no alignment requirements, so all writes can go through the same descriptor.
+        if (fcntl(fd, F_NOCACHE, 1) != 0) {
+            RAV_LOG_WARNING("Direct io not available for {}: {}", file.string(), std::strerror(errno));
+        } else {
+            stream->direct_fd_ = fd;
+        }
+    #else
+        RAV_LOG_WARNING("Direct io is not supported on this platform");
+    #endif
+    }
+
+    #if RAV_LINUX
+    stream->preallocation_size_ = align_up(options.preallocation_size);
+    #else
+    if (options.preallocation_size > 0) {
+        RAV_LOG_WARNING("Preallocation is not supported on this platform");
+    }
+    #endif
+
+    return stream;
+#else
+    std::ignore = file;
+    std::ignore = options;
+    RAV_LOG_ERROR("DirectFileOutputStream is not supported on this platform");
+    return nullptr;
+#endif
+}
+
+bool rav::DirectFileOutputStream::is_direct_io() const {
+    return direct_fd_ >= 0;
+}
+
+tl::expected<void, rav::OutputStream::Error> rav::DirectFileOutputStream::write(const uint8_t* buffer, size_t size) {
+    while (size > 0) {
+        const auto num_bytes = std::min(size, buffer_size_ - buffer_end_);
+        std::memcpy(buffer_.get() + buffer_end_, buffer, num_bytes);
+        buffer_end_ += num_bytes;
+        buffer += num_bytes;
+        size -= num_bytes;
+
+        if (buffer_end_ == buffer_size_) {
+            if (!flush_buffer()) {
+                return tl::unexpected(Error::failed_to_write);
+            }
+            buffer_offset_ += buffer_size_;
+            buffer_begin_ = 0;
+            buffer_end_ = 0;
+        }
+    }
+    return {};
+}
+
+tl::expected<void, rav::OutputStream::Error> rav::DirectFileOutputStream::set_write_position(const size_t position) {
+    if (!flush_buffer()) {
+        return tl::unexpected(Error::failed_to_write);
+    }
+    buffer_offset_ = align_down(position);
+    buffer_begin_ = position - buffer_offset_;
+    buffer_end_ = buffer_begin_;
+    return {};
+}
+
+size_t rav::DirectFileOutputStream::get_write_position() {
+    return buffer_offset_ + buffer_end_;
+}
+
+void rav::DirectFileOutputStream::flush() {
+    if (!flush_buffer()) {
+        RAV_LOG_ERROR("Failed to flush file");
+    }
+    // Start over at the beginning of the buffer, so that the next writes fill whole blocks again.
+    std::ignore = set_write_position(get_write_position());
+}
+
+bool rav::DirectFileOutputStream::flush_buffer() {
+    if (buffer_begin_ == buffer_end_) {
+        return true;
+    }
+
+    // The unaligned head and tail go through the page cache, the whole blocks in between bypass it.
+    const auto head_end = std::min(align_up(buffer_begin_), buffer_end_);
+    const auto body_end = std::max(head_end, align_down(buffer_end_));
+    const auto body_fd = direct_fd_ >= 0 ? direct_fd_ : fd_;
+
+    const auto* data = buffer_.get();
+    if (!write_to_file(fd_, data + buffer_begin_, head_end - buffer_begin_, buffer_offset_ + buffer_begin_)) {
+        return false;
+    }
+    if (!write_to_file(body_fd, data + head_end, body_end - head_end, buffer_offset_ + head_end)) {
+        return false;
+    }
+    if (!write_to_file(fd_, data + body_end, buffer_end_ - body_end, buffer_offset_ + body_end)) {
+        return false;
+    }
+
+    file_size_ = std::max(file_size_, buffer_offset_ + buffer_end_);
+    buffer_begin_ = buffer_end_;
+    return true;
+}
+
+bool rav::DirectFileOutputStream::write_to_file(const int fd, const uint8_t* data, size_t size, size_t offset) {
+#if RAV_POSIX
+    if (size == 0) {
+        return true;
+    }
+
+    #if RAV_LINUX
+    if (preallocation_size_ > 0 && offset + size > preallocated_end_) {
+        const auto end = align_up(offset + size) + preallocation_size_;
+        // FALLOC_FL_KEEP_SIZE reserves the blocks without changing the size of the file.
+        const auto result = fallocate(
+            fd_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(preallocated_end_), static_cast<off_t>(end - preallocated_end_)
+        );
+        if (result != 0) {
+            RAV_LOG_WARNING("Failed to preallocate file: {}", std::strerror(errno));
+            preallocation_size_ = 0;
+        } else {
+            preallocated_end_ = end;
+        }
+    }
+    #endif
+
+    while (size > 0) {
+        const auto result = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            RAV_LOG_ERROR("Failed to write to file: {}", std::strerror(errno));
+            return false;
+        }
+        data += result;
+        size -= static_cast<size_t>(result);
+        offset += static_cast<size_t>(result);
+    }
+    return true;
+#else
+    std::ignore = fd;
+    std::ignore = data;
+    std::ignore = size;
+    std::ignore = offset;
+    return false;
+#endif
+}
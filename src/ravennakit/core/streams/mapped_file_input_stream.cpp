@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/streams/mapped_file_input_stream.hpp"
+
+#include "ravennakit/core/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if RAV_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace {
+
+#if !RAV_LINUX
+/**
+ * Touches every page of the mapping, so that the data is read from disk now instead of on first access.
+ */
+void touch_pages(const uint8_t* data, const size_t size) {
+    constexpr size_t k_page_size = 4096;
+    volatile uint8_t sink = 0;
+    for (size_t i = 0; i < size; i += k_page_size) {
+        sink = sink + data[i];
+    }
+}
+#endif
+
+}  // namespace
+
+rav::MappedFileInputStream::~MappedFileInputStream() {
+#if RAV_WINDOWS
+    if (data_ != nullptr) {
+        if (locked_) {
+            VirtualUnlock(const_cast<uint8_t*>(data_), size_);
+        }
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_ != nullptr) {
+        CloseHandle(mapping_handle_);
+    }
+    if (file_handle_ != nullptr) {
+        CloseHandle(file_handle_);
+    }
+#else
+    if (data_ != nullptr) {
+        if (locked_) {
+            munlock(data_, size_);
+        }
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+}
+
+std::unique_ptr<rav::MappedFileInputStream>
+rav::MappedFileInputStream::create(const std::filesystem::path& file, const MappedFileInputStreamOptions& options) {
+    std::unique_ptr<MappedFileInputStream> stream(new MappedFileInputStream());
+
+#if RAV_WINDOWS
+    const auto file_handle =
+        CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        RAV_LOG_ERROR("Failed to open file {}: {}", file.string(), GetLastError());
+        return nullptr;
+    }
+    stream->file_handle_ = file_handle;
+
+    LARGE_INTEGER file_size {};
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        RAV_LOG_ERROR("Failed to get the size of file {}: {}", file.string(), GetLastError());
+        return nullptr;
+    }
+    stream->size_ = static_cast<size_t>(file_size.QuadPart);
+
+    if (stream->size_ > 0) {
+        stream->mapping_handle_ = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (stream->mapping_handle_ == nullptr) {
+            RAV_LOG_ERROR("Failed to map file {}: {}", file.string(), GetLastError());
+            return nullptr;
+        }
+        stream->data_ = static_cast<const uint8_t*>(MapViewOfFile(stream->mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+        if (stream->data_ == nullptr) {
+            RAV_LOG_ERROR("Failed to map file {}: {}", file.string(), GetLastError());
+            return nullptr;
+        }
+        if (options.populate) {
+            touch_pages(stream->data_, stream->size_);
+        }
+        if (options.lock_memory) {
+            if (!VirtualLock(const_cast<uint8_t*>(stream->data_), stream->size_)) {
+                RAV_LOG_ERROR("Failed to lock {} bytes: {}", stream->size_, GetLastError());
+                return nullptr;
+            }
+            stream->locked_ = true;
+        }
+    }
+#else
+    const auto fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        RAV_LOG_ERROR("Failed to open file {}: {}", file.string(), std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0) {
+        RAV_LOG_ERROR("Failed to get the size of file {}: {}", file.string(), std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    stream->size_ = static_cast<size_t>(file_stat.st_size);
+
+    if (stream->size_ > 0) {
+        int flags = MAP_PRIVATE;
+    #if RAV_LINUX
+        if (options.populate) {
+            flags |= MAP_POPULATE;
+        }
+    #endif
+        auto* data = mmap(nullptr, stream->size_, PROT_READ, flags, fd, 0);
+        if (data == MAP_FAILED) {
+            RAV_LOG_ERROR("Failed to map file {}: {}", file.string(), std::strerror(errno));
+            close(fd);
+            return nullptr;
+        }
+        stream->data_ = static_cast<const uint8_t*>(data);
+    }
+
+    close(fd);  // The mapping keeps the file open
+
+    if (stream->data_ != nullptr) {
+    #if !RAV_LINUX
+        if (options.populate) {
+            touch_pages(stream->data_, stream->size_);
+        }
+    #endif
+        if (options.lock_memory) {
+            if (mlock(stream->data_, stream->size_) != 0) {
+                RAV_LOG_ERROR("Failed to lock {} bytes: {}", stream->size_, std::strerror(errno));
+                return nullptr;
+            }
+            stream->locked_ = true;
+        }
+    }
+#endif
+
+    return stream;
+}
+
+const uint8_t* rav::MappedFileInputStream::data() const {
+    return data_;
+}
+
+tl::expected<size_t, rav::InputStream::Error> rav::MappedFileInputStream::read(uint8_t* buffer, const size_t size) {
+    const auto num_bytes = std::min(size, size_ - read_position_);
+    if (num_bytes > 0) {
+        std::memcpy(buffer, data_ + read_position_, num_bytes);
+    }
+    read_position_ += num_bytes;
+    return num_bytes;
+}
+
+bool rav::MappedFileInputStream::set_read_position(const size_t position) {
+    if (position > size_) {
+        return false;
+    }
+    read_position_ = position;
+    return true;
+}
+
+size_t rav::MappedFileInputStream::get_read_position() {
+    return read_position_;
+}
+
+std::optional<size_t> rav::MappedFileInputStream::size() const {
+    return size_;
+}
+
+bool rav::MappedFileInputStream::exhausted() {
+    return read_position_ >= size_;
+}
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/memory_arena.hpp"
+
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#if RAV_WINDOWS
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace {
+
+size_t round_up(const size_t value, const size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+struct Mapping {
+    uint8_t* data {};
+    size_t size {};
+    bool huge_pages {};
+};
+
+#if RAV_WINDOWS
+
+Mapping map_memory(const size_t size, const bool huge_pages) {
+    if (huge_pages) {
+        // Requires the SeLockMemoryPrivilege. Large pages are always locked.
+        if (const auto large_page_size = GetLargePageMinimum(); large_page_size > 0) {
+            const auto rounded_size = round_up(size, large_page_size);
+            if (auto* data = VirtualAlloc(nullptr, rounded_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)) {
+                return {static_cast<uint8_t*>(data), rounded_size, true};
+            }
+        }
+        RAV_LOG_WARNING("Large pages are not available, falling back to regular pages");
+    }
+
+    SYSTEM_INFO info {};
+    GetSystemInfo(&info);
+    const auto rounded_size = round_up(size, info.dwPageSize);
+    auto* data = VirtualAlloc(nullptr, rounded_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (data == nullptr) {
+        RAV_LOG_ERROR("Failed to reserve {} bytes: {}", rounded_size, GetLastError());
+        return {};
+    }
+    return {static_cast<uint8_t*>(data), rounded_size, false};
+}
+
+void unmap_memory(const Mapping& mapping) {
+    VirtualFree(mapping.data, 0, MEM_RELEASE);
+}
+
+bool lock_memory(const Mapping& mapping) {
+    if (!VirtualLock(mapping.data, mapping.size)) {
+        RAV_LOG_ERROR("Failed to lock {} bytes: {}", mapping.size, GetLastError());
+        return false;
+    }
+    return true;
+}
+
+#else
+
+constexpr size_t k_huge_page_size = 2 * 1024 * 1024;
+
+Mapping map_memory(const size_t size, const bool huge_pages) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #if RAV_LINUX
+    flags |= MAP_POPULATE;
+
+    if (huge_pages) {
+        const auto rounded_size = round_up(size, k_huge_page_size);
+        auto* data = mmap(nullptr, rounded_size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) {
+            return {static_cast<uint8_t*>(data), rounded_size, true};
+        }
+        RAV_LOG_WARNING("No huge pages available ({}), falling back to transparent huge pages", std::strerror(errno));
+    }
+    #else
+    if (huge_pages) {
+        RAV_LOG_WARNING("Huge pages are not supported on this platform, falling back to regular pages");
+    }
+    #endif
+
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    // Aligning the size to huge pages lets the kernel back the arena with transparent huge pages.
+    const auto rounded_size = round_up(size, huge_pages ? k_huge_page_size : page_size);
+    auto* data = mmap(nullptr, rounded_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (data == MAP_FAILED) {
+        RAV_LOG_ERROR("Failed to reserve {} bytes: {}", rounded_size, std::strerror(errno));
+        return {};
+    }
+
+    #if RAV_LINUX
+    if (huge_pages) {
+        std::ignore = madvise(data, rounded_size, MADV_HUGEPAGE);
+    }
+    #endif
+
+    return {static_cast<uint8_t*>(data), rounded_size, false};
+}
+
+void unmap_memory(const Mapping& mapping) {
+    munmap(mapping.data, mapping.size);
+}
+
+bool lock_memory(const Mapping& mapping) {
+    if (mlock(mapping.data, mapping.size) != 0) {
+        RAV_LOG_ERROR("Failed to lock {} bytes: {}", mapping.size, std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+}  // namespace
+
+rav::MemoryArena::~MemoryArena() {
+    RAV_ASSERT_NO_THROW(bytes_allocated_ == 0, "Memory arena destroyed while blocks are still allocated");
+    unmap_memory({data_, capacity_, huge_pages_});
+}
+
+std::unique_ptr<rav::MemoryArena> rav::MemoryArena::create(const MemoryArenaOptions& options) {
+    if (options.size == 0) {
+        RAV_LOG_ERROR("Invalid memory arena size");
+        return nullptr;
+    }
+
+    if (options.max_num_allocations == 0) {
+        RAV_LOG_ERROR("Invalid max number of allocations");
+        return nullptr;
+    }
+
+    const auto mapping = map_memory(options.size, options.huge_pages);
+    if (mapping.data == nullptr) {
+        return nullptr;
+    }
+
+    if (options.lock_memory && !lock_memory(mapping)) {
+        unmap_memory(mapping);
+        return nullptr;
+    }
+
+    // Write to every page, so that all pages are backed by RAM before the first allocation.
+    std::memset(mapping.data, 0, mapping.size);
+
+    std::unique_ptr<MemoryArena> arena(new MemoryArena());
+    arena->data_ = mapping.data;
+    arena->capacity_ = mapping.size;
+    arena->huge_pages_ = mapping.huge_pages;
+    arena->locked_ = options.lock_memory;
+    arena->max_num_allocations_ = options.max_num_allocations;
+    // Between and around the allocated blocks there is at most one free block.
+    arena->blocks_.reserve(options.max_num_allocations * 2 + 1);
+    arena->blocks_.push_back({0, mapping.size, true});
+    return arena;
+}
+
+void* rav::MemoryArena::allocate(size_t size, const size_t alignment) {
+    if (alignment > k_alignment) {
+        RAV_LOG_ERROR("Unsupported alignment: {}", alignment);
+        return nullptr;
+    }
+
+    size = round_up(std::max(size, size_t {1}), k_alignment);
+
+    std::lock_guard guard(mutex_);
+
+    if (num_allocations_ >= max_num_allocations_) {
+        RAV_LOG_WARNING("Memory arena reached its max number of allocations");
+        return nullptr;
+    }
+
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+        if (!it->free || it->size < size) {
+            continue;
+        }
+
+        if (it->size > size) {
+            RAV_ASSERT(blocks_.size() < blocks_.capacity(), "Inserting a block would reallocate");
+            const Block remainder {it->offset + size, it->size - size, true};
+            it->size = size;
+            it = blocks_.insert(it + 1, remainder) - 1;
+        }
+
+        it->free = false;
+        bytes_allocated_ += it->size;
+        num_allocations_++;
+        return data_ + it->offset;
+    }
+
+    RAV_LOG_WARNING("Memory arena exhausted, failed to allocate {} bytes", size);
+    return nullptr;
+}
+
+void rav::MemoryArena::deallocate(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    RAV_ASSERT(owns(ptr), "Pointer doesn't belong to this arena");
+
+    const auto offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - data_);
+
+    std::lock_guard guard(mutex_);
+
+    auto it = std::lower_bound(blocks_.begin(), blocks_.end(), offset, [](const Block& block, const size_t value) {
+        return block.offset < value;
+    });
+
+    if (it == blocks_.end() || it->offset != offset || it->free) {
+        RAV_ASSERT_FALSE("Invalid pointer passed to deallocate");
+        return;
+    }
+
+    it->free = true;
+    bytes_allocated_ -= it->size;
+    num_allocations_--;
+
+    if (auto next = it + 1; next != blocks_.end() && next->free) {
+        it->size += next->size;
+        it = blocks_.erase(next) - 1;
+    }
+
+    if (it != blocks_.begin()) {
+        if (auto prev = it - 1; prev->free) {
+            prev->size += it->size;
+            blocks_.erase(it);
+        }
+    }
+}
+
+bool rav::MemoryArena::owns(const void* ptr) const {
+    const auto* p = static_cast<const uint8_t*>(ptr);
+    return p >= data_ && p < data_ + capacity_;
+}
+
+size_t rav::MemoryArena::capacity() const {
+    return capacity_;
+}
+
+size_t rav::MemoryArena::bytes_allocated() const {
+    std::lock_guard guard(mutex_);
+    return bytes_allocated_;
+}
+
+bool rav::MemoryArena::uses_huge_pages() const {
+    return huge_pages_;
+}
+
+bool rav::MemoryArena::is_locked() const {
+    return locked_;
+}
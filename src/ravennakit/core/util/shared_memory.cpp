@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/shared_memory.hpp"
+
+#include "ravennakit/core/log.hpp"
+
+#include <cstring>
+
+#if RAV_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace {
+
+#if !RAV_WINDOWS
+std::string get_posix_name(const std::string& name) {
+    return "/" + name;
+}
+#endif
+
+}  // namespace
+
+rav::SharedMemory::~SharedMemory() {
+#if RAV_WINDOWS
+    if (data_ != nullptr) {
+        if (locked_) {
+            VirtualUnlock(data_, size_);
+        }
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_ != nullptr) {
+        CloseHandle(mapping_handle_);  // The mapping goes away with the last handle, there is no name to remove
+    }
+#else
+    if (data_ != nullptr) {
+        if (locked_) {
+            munlock(data_, size_);
+        }
+        munmap(data_, size_);
+    }
+    if (owner_) {
+        shm_unlink(get_posix_name(name_).c_str());
+    }
+#endif
+}
+
+std::unique_ptr<rav::SharedMemory> rav::SharedMemory::create(const std::string& name, const size_t size, const bool lock_memory) {
+    if (name.empty() || size == 0) {
+        RAV_LOG_ERROR("Invalid name or size for shared memory");
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedMemory> memory(new SharedMemory());
+    memory->name_ = name;
+    memory->size_ = size;
+
+#if RAV_WINDOWS
+    const auto size_64 = static_cast<uint64_t>(size);
+    memory->mapping_handle_ = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size_64 >> 32), static_cast<DWORD>(size_64 & 0xffffffff),
+        name.c_str()
+    );
+    if (memory->mapping_handle_ == nullptr) {
+        RAV_LOG_ERROR("Failed to create shared memory {}: {}", name, GetLastError());
+        return nullptr;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        RAV_LOG_ERROR("Shared memory {} already exists", name);
+        return nullptr;
+    }
+    memory->owner_ = true;
+    memory->data_ = static_cast<uint8_t*>(MapViewOfFile(memory->mapping_handle_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (memory->data_ == nullptr) {
+        RAV_LOG_ERROR("Failed to map shared memory {}: {}", name, GetLastError());
+        return nullptr;
+    }
+    if (lock_memory) {
+        if (!VirtualLock(memory->data_, size)) {
+            RAV_LOG_ERROR("Failed to lock {} bytes: {}", size, GetLastError());
+            return nullptr;
+        }
+        memory->locked_ = true;
+    }
+#else
+    const auto posix_name = get_posix_name(name);
+    const auto fd = shm_open(posix_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        RAV_LOG_ERROR("Failed to create shared memory {}: {}", name, std::strerror(errno));
+        return nullptr;
+    }
+    memory->owner_ = true;  // From here on the name is removed again on failure
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        RAV_LOG_ERROR("Failed to set the size of shared memory {}: {}", name, std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the object open
+    if (data == MAP_FAILED) {
+        RAV_LOG_ERROR("Failed to map shared memory {}: {}", name, std::strerror(errno));
+        return nullptr;
+    }
+    memory->data_ = static_cast<uint8_t*>(data);
+
+    if (lock_memory) {
+        if (mlock(memory->data_, size) != 0) {
+            RAV_LOG_ERROR("Failed to lock {} bytes: {}", size, std::strerror(errno));
+            return nullptr;
+        }
+        memory->locked_ = true;
+    }
+#endif
+
+    return memory;
+}
+
+std::unique_ptr<rav::SharedMemory> rav::SharedMemory::open(const std::string& name) {
+    if (name.empty()) {
+        RAV_LOG_ERROR("Invalid name for shared memory");
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedMemory> memory(new SharedMemory());
+    memory->name_ = name;
+
+#if RAV_WINDOWS
+    memory->mapping_handle_ = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+    if (memory->mapping_handle_ == nullptr) {
+        RAV_LOG_ERROR("Failed to open shared memory {}: {}", name, GetLastError());
+        return nullptr;
+    }
+    memory->data_ = static_cast<uint8_t*>(MapViewOfFile(memory->mapping_handle_, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (memory->data_ == nullptr) {
+        RAV_LOG_ERROR("Failed to map shared memory {}: {}", name, GetLastError());
+        return nullptr;
+    }
+    MEMORY_BASIC_INFORMATION info {};
+    if (VirtualQuery(memory->data_, &info, sizeof(info)) == 0) {
+        RAV_LOG_ERROR("Failed to get the size of shared memory {}: {}", name, GetLastError());
+        return nullptr;
+    }
+    memory->size_ = info.RegionSize;
+#else
+    const auto fd = shm_open(get_posix_name(name).c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        RAV_LOG_ERROR("Failed to open shared memory {}: {}", name, std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat shm_stat {};
+    if (fstat(fd, &shm_stat) != 0 || shm_stat.st_size <= 0) {
+        RAV_LOG_ERROR("Failed to get the size of shared memory {}: {}", name, std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    memory->size_ = static_cast<size_t>(shm_stat.st_size);
+
+    auto* data = mmap(nullptr, memory->size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        RAV_LOG_ERROR("Failed to map shared memory {}: {}", name, std::strerror(errno));
+        return nullptr;
+    }
+    memory->data_ = static_cast<uint8_t*>(data);
+#endif
+
+    return memory;
+}
+
+uint8_t* rav::SharedMemory::data() const {
+    return data_;
+}
+
+size_t rav::SharedMemory::size() const {
+    return size_;
+}
+
+const std::string& rav::SharedMemory::name() const {
+    return name_;
+}
+
+bool rav::SharedMemory::is_owner() const {
+    return owner_;
+}
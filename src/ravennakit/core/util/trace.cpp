@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/trace.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/format.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<rav::trace::ThreadBuffer>> buffers;
+    uint64_t next_thread_id {1};
+    std::filesystem::path anomaly_dump_directory;
+};
+
+Registry& get_registry() {
+    static Registry registry;
+    return registry;
+}
+
+std::atomic<bool> g_enabled {true};
+std::atomic<const rav::trace::SourceLocation*> g_pending_anomaly {nullptr};
+std::atomic<uint64_t> g_last_anomaly_ns {0};
+std::atomic<int64_t> g_anomaly_dump_interval_ms {10'000};
+
+thread_local std::shared_ptr<rav::trace::ThreadBuffer> t_thread_buffer;
+
+uint64_t double_to_bits(const double value) {
+    uint64_t bits {};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bits_to_double(const uint64_t bits) {
+    double value {};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void write_escaped(std::string& out, const char* str) {
+    if (str == nullptr) {
+        return;
+    }
+    for (; *str != '\0'; ++str) {
+        const auto c = *str;
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+}
+
+void write_event(std::string& out, const rav::trace::Event& event, const uint64_t tid) {
+    const auto* location = event.location;
+    if (location == nullptr) {
+        return;
+    }
+
+    out += "{\"name\":\"";
+    write_escaped(out, location->name);
+    out += '"';
+
+    const auto ts_us = static_cast<double>(event.timestamp_ns) / 1'000.0;
+    switch (event.type) {
+        case rav::trace::EventType::zone:
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f}", ts_us, static_cast<double>(event.payload) / 1'000.0);
+            break;
+        case rav::trace::EventType::plot:
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"C\",\"ts\":{:.3f},\"args\":{{\"value\":{}}}", ts_us, bits_to_double(event.payload));
+            break;
+        case rav::trace::EventType::message:
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"i\",\"s\":\"t\",\"ts\":{:.3f}", ts_us);
+            break;
+        case rav::trace::EventType::anomaly:
+            fmt::format_to(std::back_inserter(out), ",\"cat\":\"anomaly\",\"ph\":\"i\",\"s\":\"g\",\"ts\":{:.3f}", ts_us);
+            break;
+    }
+
+    fmt::format_to(std::back_inserter(out), ",\"pid\":1,\"tid\":{}", tid);
+
+    if (event.type == rav::trace::EventType::zone) {
+        out += ",\"args\":{\"file\":\"";
+        write_escaped(out, location->file);
+        fmt::format_to(std::back_inserter(out), "\",\"line\":{}}}", location->line);
+    }
+
+    out += '}';
+}
+
+}  // namespace
+
+rav::trace::ThreadBuffer::ThreadBuffer(const uint64_t thread_id) : thread_id_(thread_id), slots_(k_capacity) {
+    static_assert((k_capacity & (k_capacity - 1)) == 0, "Capacity must be a power of two");
+}
+
+std::vector<rav::trace::Event> rav::trace::ThreadBuffer::read() const {
+    const auto end = write_index_.load(std::memory_order_acquire);
+    const auto begin = end > k_capacity ? end - k_capacity : 0;
+
+    std::vector<Event> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (auto i = begin; i < end; ++i) {
+        const auto& slot = slots_[i & (k_capacity - 1)];
+        Event event;
+        event.timestamp_ns = slot.timestamp_ns.load(std::memory_order_acquire);
+        event.payload = slot.payload.load(std::memory_order_acquire);
+        event.location = slot.location.load(std::memory_order_acquire);
+        event.type = slot.type.load(std::memory_order_acquire);
+        events.push_back(event);
+    }
+
+    // Discard the events which might have been overwritten by the writer while copying, including the one being written.
+    const auto new_end = write_index_.load(std::memory_order_relaxed);
+    if (new_end + 1 > begin + k_capacity) {
+        const auto num_overwritten = std::min(static_cast<size_t>(new_end + 1 - begin - k_capacity), events.size());
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(num_overwritten));
+    }
+
+    return events;
+}
+
+uint64_t rav::trace::ThreadBuffer::get_thread_id() const {
+    return thread_id_;
+}
+
+std::string rav::trace::ThreadBuffer::get_thread_name() const {
+    std::lock_guard lock(thread_name_mutex_);
+    return thread_name_;
+}
+
+void rav::trace::ThreadBuffer::set_thread_name(const std::string& name) {
+    std::lock_guard lock(thread_name_mutex_);
+    thread_name_ = name;
+}
+
+rav::trace::ThreadBuffer& rav::trace::register_thread() {
+    if (t_thread_buffer == nullptr) {
+        auto& registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        // Forget about buffers of threads which have exited
+        registry.buffers.erase(
+            std::remove_if(
+                registry.buffers.begin(), registry.buffers.end(),
+                [](const auto& buffer) {
+                    return buffer.use_count() == 1;
+                }
+            ),
+            registry.buffers.end()
+        );
+        t_thread_buffer = std::make_shared<ThreadBuffer>(registry.next_thread_id++);
+        registry.buffers.push_back(t_thread_buffer);
+    }
+    return *t_thread_buffer;
+}
+
+rav::trace::ThreadBuffer* rav::trace::get_thread_buffer() {
+    return t_thread_buffer.get();
+}
+
+void rav::trace::set_enabled(const bool enabled) {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool rav::trace::is_enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void rav::trace::record_zone(const SourceLocation* location, const uint64_t begin_ns) {
+    if (!is_enabled()) {
+        return;
+    }
+    auto* buffer = get_thread_buffer();
+    if (buffer == nullptr) {
+        return;  // Registering would lock and allocate, which might happen on a realtime thread.
+    }
+    const auto end_ns = clock::now_monotonic_high_resolution_ns();
+    buffer->write({begin_ns, end_ns - begin_ns, location, EventType::zone});
+}
+
+void rav::trace::record_plot(const SourceLocation* location, const double value) {
+    if (!is_enabled()) {
+        return;
+    }
+    if (auto* buffer = get_thread_buffer()) {
+        buffer->write({clock::now_monotonic_high_resolution_ns(), double_to_bits(value), location, EventType::plot});
+    }
+}
+
+void rav::trace::record_message(const SourceLocation* location) {
+    if (!is_enabled()) {
+        return;
+    }
+    if (auto* buffer = get_thread_buffer()) {
+        buffer->write({clock::now_monotonic_high_resolution_ns(), 0, location, EventType::message});
+    }
+}
+
+void rav::trace::report_anomaly(const SourceLocation* location) {
+    if (!is_enabled()) {
+        return;
+    }
+
+    const auto now = clock::now_monotonic_high_resolution_ns();
+    if (auto* buffer = get_thread_buffer()) {
+        buffer->write({now, 0, location, EventType::anomaly});
+    }
+
+    const auto interval_ns = static_cast<uint64_t>(g_anomaly_dump_interval_ms.load(std::memory_order_relaxed)) * 1'000'000;
+    auto last = g_last_anomaly_ns.load(std::memory_order_relaxed);
+    if (last != 0 && now - last < interval_ns) {
+        return;  // Rate limited
+    }
+    if (!g_last_anomaly_ns.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        return;  // Another thread beat us to it
+    }
+    g_pending_anomaly.store(location, std::memory_order_release);
+}
+
+void rav::trace::set_thread_name(const char* name) {
+    register_thread().set_thread_name(name);
+}
+
+std::string rav::trace::to_chrome_trace_json() {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        auto& registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+
+    for (const auto& buffer : buffers) {
+        const auto tid = buffer->get_thread_id();
+
+        if (const auto name = buffer->get_thread_name(); !name.empty()) {
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,";
+            fmt::format_to(std::back_inserter(out), "\"tid\":{},\"args\":{{\"name\":\"", tid);
+            write_escaped(out, name.c_str());
+            out += "\"}}";
+        }
+
+        for (const auto& event : buffer->read()) {
+            out += first ? "\n" : ",\n";
+            first = false;
+            write_event(out, event, tid);
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+tl::expected<void, std::string> rav::trace::dump_to_file(const std::filesystem::path& path) {
+    const auto json = to_chrome_trace_json();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return tl::unexpected(fmt::format("Failed to open file: {}", path.string()));
+    }
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!file.good()) {
+        return tl::unexpected(fmt::format("Failed to write to file: {}", path.string()));
+    }
+    return {};
+}
+
+void rav::trace::set_anomaly_dump_directory(const std::filesystem::path& directory) {
+    auto& registry = get_registry();
+    std::lock_guard lock(registry.mutex);
+    registry.anomaly_dump_directory = directory;
+}
+
+void rav::trace::set_anomaly_dump_interval(const std::chrono::milliseconds interval) {
+    g_anomaly_dump_interval_ms.store(interval.count(), std::memory_order_relaxed);
+}
+
+std::filesystem::path rav::trace::process_pending_dump() {
+    const auto* location = g_pending_anomaly.exchange(nullptr, std::memory_order_acquire);
+    if (location == nullptr) {
+        return {};
+    }
+
+    std::filesystem::path directory;
+    {
+        auto& registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+        directory = registry.anomaly_dump_directory;
+    }
+
+    if (directory.empty()) {
+        return {};
+    }
+
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+    auto path = directory / fmt::format("ravennakit_trace_{}.json", now.count());
+
+    if (auto result = dump_to_file(path); !result) {
+        RAV_LOG_ERROR("Failed to write trace after anomaly ({}): {}", location->name, result.error());
+        return {};
+    }
+
+    RAV_LOG_WARNING("Anomaly detected ({}), trace written to: {}", location->name, path.string());
+    return path;
+}
@@ -111,6 +111,187 @@ void ok_response(http::response<http::string_body>& res, std::string body, const
     res.prepare_payload();
 }
 
+/**
+ * Sets the response to indicate that the request was accepted for later processing, and adds the body.
+ * @param res The response to set.
+ * @param body The body of the response.
+ */
+void accepted_response(http::response<http::string_body>& res, std::string body) {
+    res.result(http::status::accepted);
+    set_default_headers(res, "application/json");
+    res.body() = std::move(body);
+    res.prepare_payload();
+}
+
+/**
+ * Determines the absolute TAI time at which a scheduled activation should take place.
+ * @param activation The requested activation, which must be scheduled.
+ * @param now The current TAI time.
+ * @return The activation time, or an error if the activation is invalid.
+ */
+tl::expected<rav::nmos::Timestamp, rav::nmos::ApiError>
+get_scheduled_activation_time(const rav::nmos::Activation& activation, const rav::ptp::Timestamp now) {
+    RAV_ASSERT(activation.mode.has_value(), "Expecting an activation mode");
+
+    if (!activation.requested_time.has_value()) {
+        return tl::unexpected(rav::nmos::ApiError {http::status::bad_request, "A scheduled activation requires a requested_time"});
+    }
+
+    if (*activation.mode == rav::nmos::Activation::Mode::activate_scheduled_absolute) {
+        return *activation.requested_time;
+    }
+
+    auto seconds = now.raw_seconds() + activation.requested_time->seconds;
+    auto nanoseconds = static_cast<uint64_t>(now.raw_nanoseconds()) + activation.requested_time->nanoseconds;
+    if (nanoseconds >= 1'000'000'000) {
+        nanoseconds -= 1'000'000'000;
+        seconds++;
+    }
+    return rav::nmos::Timestamp {seconds, static_cast<uint32_t>(nanoseconds)};
+}
+
+/**
+ * Applies the PATCH request to the staged endpoint of a receiver or sender according to the requested activation.
+ * Requests without activation mode are applied right away, as are immediate activations. Scheduled activations are
+ * handed to the resource to be prepared, replacing a pending scheduled activation.
+ * @param resource The receiver or sender.
+ * @param patch_request The body of the request.
+ * @param now The current TAI time.
+ * @return The activation to report in the response, or an error.
+ */
+template<class Resource>
+tl::expected<rav::nmos::ActivationResponse, rav::nmos::ApiError>
+apply_staged_patch_request(Resource& resource, const boost::json::value& patch_request, const rav::ptp::Timestamp now) {
+    rav::nmos::Activation activation;
+    try {
+        if (const auto result = patch_request.try_at("activation")) {
+            activation = boost::json::value_to<rav::nmos::Activation>(*result);
+        }
+    } catch (const std::exception& e) {
+        return tl::unexpected(rav::nmos::ApiError {http::status::bad_request, "Bad Request", fmt::format("Invalid activation: {}", e.what())});
+    }
+
+    const auto is_scheduled = activation.mode.has_value() && *activation.mode != rav::nmos::Activation::Mode::activate_immediate;
+
+    if (is_scheduled) {
+        if (!resource.on_scheduled_patch_request) {
+            return tl::unexpected(rav::nmos::ApiError {http::status::not_implemented, "Scheduled activations are not implemented"});
+        }
+
+        auto activation_time = get_scheduled_activation_time(activation, now);
+        if (!activation_time) {
+            return tl::unexpected(activation_time.error());
+        }
+
+        if (auto result = resource.on_scheduled_patch_request(patch_request, *activation_time); !result) {
+            return tl::unexpected(result.error());
+        }
+
+        rav::nmos::ActivationResponse response;
+        response.mode = activation.mode;
+        response.requested_time = activation.requested_time;
+        response.activation_time = *activation_time;
+        resource.staged_activation = response;
+        return response;
+    }
+
+    if (resource.staged_activation.mode.has_value()) {
+        if (resource.on_cancel_scheduled_activation) {
+            resource.on_cancel_scheduled_activation();
+        }
+        resource.staged_activation = {};
+    }
+
+    RAV_ASSERT(resource.on_patch_request, "Expecting valid function");
+    if (auto result = resource.on_patch_request(patch_request); !result) {
+        return tl::unexpected(result.error());
+    }
+
+    rav::nmos::ActivationResponse response;
+    if (activation.mode.has_value()) {
+        response.mode = activation.mode;
+        response.activation_time = rav::nmos::Timestamp(now);
+        resource.active_activation = response;
+    }
+    return response;
+}
+
+/// The members which may appear in a PATCH request to the staged endpoint of a receiver.
+constexpr std::array<std::string_view, 5> k_receiver_staged_keys {
+    "activation", "sender_id", "transport_params", "transport_file", "master_enable",
+};
+
+/// The members which may appear in a PATCH request to the staged endpoint of a sender.
+constexpr std::array<std::string_view, 4> k_sender_staged_keys {
+    "activation", "receiver_id", "transport_params", "master_enable",
+};
+
+/**
+ * Validates the members of a PATCH request to a staged endpoint.
+ * @param patch_request The body of the request.
+ * @param allowed_keys The members which may appear in the request.
+ * @return An error if the request is not an object or contains an unexpected member.
+ */
+template<size_t N>
+tl::expected<void, rav::nmos::ApiError>
+validate_staged_patch_request(const boost::json::value& patch_request, const std::array<std::string_view, N>& allowed_keys) {
+    if (!patch_request.is_object()) {
+        return tl::unexpected(rav::nmos::ApiError {http::status::bad_request, "Bad Request", "Expected a JSON object"});
+    }
+
+    for (auto& member : patch_request.as_object()) {
+        const std::string_view key(member.key().data(), member.key().size());
+        if (std::find(allowed_keys.begin(), allowed_keys.end(), key) == allowed_keys.end()) {
+            return tl::unexpected(
+                rav::nmos::ApiError {http::status::bad_request, "Bad Request", "Invalid JSON: unexpected key: " + std::string(key)}
+            );
+        }
+    }
+
+    return {};
+}
+
+/**
+ * Applies a single entry of a bulk request of the Connection API. Errors are reported in the returned entry, so that the
+ * other entries are still applied.
+ * @param entry The entry, an object holding the id of the resource and the parameters to stage.
+ * @param apply Function which applies the parameters to the resource with given id, returning the status of the result.
+ * @return The entry of the response.
+ */
+template<class ApplyFunction>
+boost::json::value apply_bulk_request_entry(const boost::json::value& entry, ApplyFunction&& apply) {
+    std::string id;
+    tl::expected<http::status, rav::nmos::ApiError> result;
+
+    try {
+        const auto* object = entry.if_object();
+        const auto* id_value = object != nullptr ? object->if_contains("id") : nullptr;
+        const auto* patch_request = object != nullptr ? object->if_contains("params") : nullptr;
+        if (id_value == nullptr || !id_value->is_string() || patch_request == nullptr) {
+            result = tl::unexpected(rav::nmos::ApiError {http::status::bad_request, "Bad Request", "Expected an object with id and params"});
+        } else {
+            id = id_value->as_string().c_str();
+            result = apply(boost::uuids::string_generator()(id), *patch_request);
+        }
+    } catch (const std::exception& e) {
+        result = tl::unexpected(rav::nmos::ApiError {http::status::bad_request, "Bad Request", e.what()});
+    }
+
+    if (!result) {
+        return {
+            {"id", id},
+            {"code", result.error().code},
+            {"error", result.error().error},
+            {"debug", result.error().debug},
+        };
+    }
+
+    return {
+        {"id", id},
+        {"code", static_cast<unsigned>(*result)},
+    };
+}
+
 template<typename VersionsContainer>
 std::optional<rav::nmos::ApiVersion> get_valid_api_version_from_parameters(
     const rav::PathMatcher::Parameters& params, const VersionsContainer& versions, const std::string_view param_name = "version"
@@ -723,8 +904,52 @@ rav::nmos::Node::Node(
                 return invalid_api_version_response(res);
             }
 
-            res.base().result(403);
-            res.base().reason("Forbidden");
+            set_error_response(res, http::status::method_not_allowed, "Method Not Allowed", "Bulk resources only support POST");
+        }
+    );
+
+    http_server_.post(
+        "/x-nmos/connection/{version}/bulk/receivers",
+        [this](const HttpServer::Request& request, HttpServer::Response& res, const PathMatcher::Parameters& params) {
+            if (!get_valid_api_version_from_parameters(params, k_connection_api_versions).has_value()) {
+                return invalid_api_version_response(res);
+            }
+
+            boost::system::error_code ec;
+            const auto json = boost::json::parse(request.body(), ec);
+            if (ec || !json.is_array()) {
+                set_error_response(res, http::status::bad_request, "Bad Request", "Expected a JSON array");
+                return;
+            }
+
+            const auto now = get_local_clock().now();
+            boost::json::array results;
+
+            on_bulk_request_begin();
+            Defer end_bulk_request([this] {
+                on_bulk_request_end();
+            });
+
+            for (auto& entry : json.as_array()) {
+                results.push_back(apply_bulk_request_entry(
+                    entry,
+                    [&](const boost::uuids::uuid& id, const boost::json::value& patch_request) -> tl::expected<http::status, ApiError> {
+                        auto* receiver = find_receiver(id);
+                        if (receiver == nullptr) {
+                            return tl::unexpected(ApiError {http::status::not_found, "Not found", "Receiver not found"});
+                        }
+                        if (auto result = validate_staged_patch_request(patch_request, k_receiver_staged_keys); !result) {
+                            return tl::unexpected(result.error());
+                        }
+                        if (auto result = apply_staged_patch_request(*receiver, patch_request, now); !result) {
+                            return tl::unexpected(result.error());
+                        }
+                        return receiver->staged_activation.mode.has_value() ? http::status::accepted : http::status::ok;
+                    }
+                ));
+            }
+
+            ok_response(res, boost::json::serialize(results));
         }
     );
 
@@ -814,11 +1039,11 @@ rav::nmos::Node::Node(
                 transport_file.data = *sdp_text;
             }
 
-            ActivationResponse activation_response;
-
             const boost::json::value value {
-                {"sender_id", json_value_from_uuid(receiver->subscription.sender_id)}, {"master_enable", receiver->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},          {"transport_params", transport_params},
+                {"sender_id", json_value_from_uuid(receiver->subscription.sender_id)},
+                {"master_enable", receiver->subscription.active},
+                {"activation", boost::json::value_from(receiver->staged_activation)},
+                {"transport_params", transport_params},
                 {"transport_file", boost::json::value_from(transport_file)},
             };
 
@@ -871,48 +1096,14 @@ rav::nmos::Node::Node(
             const auto& body = request.body();
             auto json = boost::json::parse(body);
 
-            if (!json.is_object()) {
-                set_error_response(res, http::status::bad_request, "Bad Request", "Expected a JSON object");
-                return;
-            }
-
-            // Validate object
-            for (auto& member : json.as_object()) {
-                if (member.key() == "activation") {
-                    continue;
-                }
-                if (member.key() == "sender_id") {
-                    continue;
-                }
-                if (member.key() == "transport_params") {
-                    continue;
-                }
-                if (member.key() == "transport_file") {
-                    continue;
-                }
-                if (member.key() == "master_enable") {
-                    continue;
-                }
-                set_error_response(
-                    res, http::status::bad_request, "Bad Request", "Invalid JSON: unexpected key: " + std::string(member.key())
-                );
+            if (auto result = validate_staged_patch_request(json, k_receiver_staged_keys); !result) {
+                set_error_response(res, result.error());
                 return;
             }
 
-            // Refuse activation modes other than activate_immediate
-            if (const auto result = json.try_at("activation")) {
-                auto activation = boost::json::value_to<Activation>(*result);
-                if (const auto mode = activation.mode) {
-                    if (*mode != Activation::Mode::activate_immediate) {
-                        set_error_response(res, http::status::not_implemented, "Not Implemented", "Only activate_immediate is implemented");
-                        return;
-                    }
-                }
-            }
-
-            RAV_ASSERT(receiver->on_patch_request, "Expecting valid function");
-            if (auto result = receiver->on_patch_request(json); !result) {
-                set_error_response(res, result.error());
+            auto activation_response = apply_staged_patch_request(*receiver, json, get_local_clock().now());
+            if (!activation_response) {
+                set_error_response(res, activation_response.error());
                 return;
             }
 
@@ -932,15 +1123,17 @@ rav::nmos::Node::Node(
                 transport_file.data = *sdp_text;
             }
 
-            ActivationResponse activation_response;
-
             const boost::json::value value {
                 {"sender_id", json_value_from_uuid(receiver->subscription.sender_id)}, {"master_enable", receiver->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},          {"transport_params", transport_params},
+                {"activation", boost::json::value_from(*activation_response)},         {"transport_params", transport_params},
                 {"transport_file", boost::json::value_from(transport_file)},
             };
 
-            ok_response(res, boost::json::serialize(value));
+            if (receiver->staged_activation.mode.has_value()) {
+                accepted_response(res, boost::json::serialize(value));
+            } else {
+                ok_response(res, boost::json::serialize(value));
+            }
         }
     );
 
@@ -979,11 +1172,11 @@ rav::nmos::Node::Node(
                 transport_file.data = *sdp_text;
             }
 
-            ActivationResponse activation_response;
-
             const boost::json::value value {
-                {"sender_id", json_value_from_uuid(receiver->subscription.sender_id)}, {"master_enable", receiver->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},          {"transport_params", transport_params},
+                {"sender_id", json_value_from_uuid(receiver->subscription.sender_id)},
+                {"master_enable", receiver->subscription.active},
+                {"activation", boost::json::value_from(receiver->active_activation)},
+                {"transport_params", transport_params},
                 {"transport_file", boost::json::value_from(transport_file)},
             };
 
@@ -1046,7 +1239,52 @@ rav::nmos::Node::Node(
                 return invalid_api_version_response(res);
             }
 
-            set_error_response(res, http::status::forbidden, "Forbidden", {});
+            set_error_response(res, http::status::method_not_allowed, "Method Not Allowed", "Bulk resources only support POST");
+        }
+    );
+
+    http_server_.post(
+        "/x-nmos/connection/{version}/bulk/senders",
+        [this](const HttpServer::Request& request, HttpServer::Response& res, const PathMatcher::Parameters& params) {
+            if (!get_valid_api_version_from_parameters(params, k_connection_api_versions).has_value()) {
+                return invalid_api_version_response(res);
+            }
+
+            boost::system::error_code ec;
+            const auto json = boost::json::parse(request.body(), ec);
+            if (ec || !json.is_array()) {
+                set_error_response(res, http::status::bad_request, "Bad Request", "Expected a JSON array");
+                return;
+            }
+
+            const auto now = get_local_clock().now();
+            boost::json::array results;
+
+            on_bulk_request_begin();
+            Defer end_bulk_request([this] {
+                on_bulk_request_end();
+            });
+
+            for (auto& entry : json.as_array()) {
+                results.push_back(apply_bulk_request_entry(
+                    entry,
+                    [&](const boost::uuids::uuid& id, const boost::json::value& patch_request) -> tl::expected<http::status, ApiError> {
+                        auto* sender = find_sender(id);
+                        if (sender == nullptr) {
+                            return tl::unexpected(ApiError {http::status::not_found, "Not found", "Sender not found"});
+                        }
+                        if (auto result = validate_staged_patch_request(patch_request, k_sender_staged_keys); !result) {
+                            return tl::unexpected(result.error());
+                        }
+                        if (auto result = apply_staged_patch_request(*sender, patch_request, now); !result) {
+                            return tl::unexpected(result.error());
+                        }
+                        return sender->staged_activation.mode.has_value() ? http::status::accepted : http::status::ok;
+                    }
+                ));
+            }
+
+            ok_response(res, boost::json::serialize(results));
         }
     );
 
@@ -1152,13 +1390,12 @@ rav::nmos::Node::Node(
                 return;
             }
 
-            ActivationResponse activation_response;
             auto transport_params = get_sender_transport_params_from_sdp(*transport_file);
 
             const boost::json::value value {
                 {"receiver_id", boost::json::value_from(sender->subscription.receiver_id)},
                 {"master_enable", sender->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},
+                {"activation", boost::json::value_from(sender->staged_activation)},
                 {"transport_params", transport_params},
             };
 
@@ -1188,40 +1425,14 @@ rav::nmos::Node::Node(
             auto body = req.body();
             auto json = boost::json::parse(body);
 
-            // Validate object
-            for (auto& member : json.as_object()) {
-                if (member.key() == "activation") {
-                    continue;
-                }
-                if (member.key() == "receiver_id") {
-                    continue;
-                }
-                if (member.key() == "transport_params") {
-                    continue;
-                }
-                if (member.key() == "master_enable") {
-                    continue;
-                }
-                set_error_response(
-                    res, http::status::bad_request, "Bad Request", "Invalid JSON: unexpected key: " + std::string(member.key())
-                );
+            if (auto result = validate_staged_patch_request(json, k_sender_staged_keys); !result) {
+                set_error_response(res, result.error());
                 return;
             }
 
-            // Refuse activation modes other than activate_immediate
-            if (const auto result = json.try_at("activation")) {
-                auto activation = boost::json::value_to<Activation>(*result);
-                if (const auto mode = activation.mode) {
-                    if (*mode != Activation::Mode::activate_immediate) {
-                        set_error_response(res, http::status::not_implemented, "Not Implemented", "Only activate_immediate is implemented");
-                        return;
-                    }
-                }
-            }
-
-            RAV_ASSERT(sender->on_patch_request, "Expecting valid function");
-            if (auto result = sender->on_patch_request(json); !result) {
-                set_error_response(res, result.error());
+            auto activation_response = apply_staged_patch_request(*sender, json, get_local_clock().now());
+            if (!activation_response) {
+                set_error_response(res, activation_response.error());
                 return;
             }
 
@@ -1232,17 +1443,20 @@ rav::nmos::Node::Node(
                 return;
             }
 
-            ActivationResponse activation_response;
             auto transport_params = get_sender_transport_params_from_sdp(*transport_file);
 
             const boost::json::value value {
                 {"receiver_id", json_value_from_uuid(sender->subscription.receiver_id)},
                 {"master_enable", sender->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},
+                {"activation", boost::json::value_from(*activation_response)},
                 {"transport_params", transport_params},
             };
 
-            ok_response(res, boost::json::serialize(value));
+            if (sender->staged_activation.mode.has_value()) {
+                accepted_response(res, boost::json::serialize(value));
+            } else {
+                ok_response(res, boost::json::serialize(value));
+            }
         }
     );
 
@@ -1272,13 +1486,12 @@ rav::nmos::Node::Node(
                 return;
             }
 
-            ActivationResponse activation_response;
             auto transport_params = get_sender_transport_params_from_sdp(*transport_file);
 
             const boost::json::value value {
                 {"receiver_id", json_value_from_uuid(sender->subscription.receiver_id)},
                 {"master_enable", sender->subscription.active},
-                {"activation", boost::json::value_from(activation_response)},
+                {"activation", boost::json::value_from(sender->active_activation)},
                 {"transport_params", transport_params},
             };
 
@@ -1899,6 +2112,10 @@ boost::asio::ip::tcp::endpoint rav::nmos::Node::get_local_endpoint() const {
     return http_server_.get_local_endpoint();
 }
 
+rav::HttpServer& rav::nmos::Node::get_http_server() {
+    return http_server_;
+}
+
 bool rav::nmos::Node::add_or_update_device(Device* device) {
     RAV_ASSERT(device != nullptr, "Device should not be nullptr");
     RAV_ASSERT(!device->id.is_nil(), "Device ID should not be nil");
@@ -2050,7 +2267,7 @@ bool rav::nmos::Node::add_or_update_receiver(ReceiverAudio* receiver) {
     return true;
 }
 
-const rav::nmos::ReceiverAudio* rav::nmos::Node::find_receiver(const boost::uuids::uuid& uuid) const {
+rav::nmos::ReceiverAudio* rav::nmos::Node::find_receiver(const boost::uuids::uuid& uuid) const {
     const auto it = std::find_if(receivers_.begin(), receivers_.end(), [uuid](const ReceiverAudio* receiver) {
         return receiver->id == uuid;
     });
@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/ptp/detail/ptp_unicast_negotiation.hpp"
+
+#include "ravennakit/core/log.hpp"
+
+namespace {
+
+int8_t log_inter_message_period_for(const rav::ptp::UnicastMaster& master, const rav::ptp::MessageType message_type) {
+    switch (message_type) {
+        case rav::ptp::MessageType::announce:
+            return master.log_announce_interval;
+        case rav::ptp::MessageType::sync:
+            return master.log_sync_interval;
+        case rav::ptp::MessageType::delay_resp:
+        case rav::ptp::MessageType::delay_req:
+        case rav::ptp::MessageType::p_delay_req:
+        case rav::ptp::MessageType::p_delay_resp:
+        case rav::ptp::MessageType::follow_up:
+        case rav::ptp::MessageType::p_delay_resp_follow_up:
+        case rav::ptp::MessageType::signaling:
+        case rav::ptp::MessageType::management:
+        case rav::ptp::MessageType::reserved1:
+        case rav::ptp::MessageType::reserved2:
+        case rav::ptp::MessageType::reserved3:
+        case rav::ptp::MessageType::reserved4:
+        case rav::ptp::MessageType::reserved5:
+        case rav::ptp::MessageType::reserved6:
+        default:
+            return master.log_delay_resp_interval;
+    }
+}
+
+rav::ptp::PortIdentity all_ports() {
+    rav::ptp::PortIdentity port_identity;
+    port_identity.clock_identity.data.fill(0xff);
+    port_identity.port_number = rav::ptp::PortIdentity::k_port_number_all;
+    return port_identity;
+}
+
+}  // namespace
+
+rav::ptp::UnicastNegotiation::UnicastNegotiation(PortIdentity port_identity, SendFunction send) :
+    port_identity_(std::move(port_identity)), send_(std::move(send)) {}
+
+void rav::ptp::UnicastNegotiation::set_masters(const std::vector<UnicastMaster>& masters, const Clock::time_point now) {
+    std::vector<MasterState> new_masters;
+    new_masters.reserve(masters.size());
+
+    for (auto& config : masters) {
+        auto it = std::find_if(masters_.begin(), masters_.end(), [&config](const MasterState& m) {
+            return m.config == config;
+        });
+        if (it != masters_.end()) {
+            new_masters.push_back(*it);
+            masters_.erase(it);
+        } else {
+            new_masters.push_back(make_master_state(config, now));
+        }
+    }
+
+    // Whatever is left is no longer configured (or configured differently)
+    for (auto& master : masters_) {
+        cancel(master);
+    }
+
+    masters_ = std::move(new_masters);
+}
+
+std::vector<rav::ptp::UnicastMaster> rav::ptp::UnicastNegotiation::get_masters() const {
+    std::vector<UnicastMaster> masters;
+    masters.reserve(masters_.size());
+    for (auto& master : masters_) {
+        masters.push_back(master.config);
+    }
+    return masters;
+}
+
+void rav::ptp::UnicastNegotiation::process(const Clock::time_point now) {
+    for (auto& master : masters_) {
+        auto message = make_signaling_message(master.port_identity);
+
+        for (auto& grant : master.grants) {
+            if (grant.granted_log_inter_message_period && now >= grant.granted_until) {
+                RAV_LOG_WARNING(
+                    "Unicast grant for {} from {} expired", to_string(grant.message_type), master.config.address.to_string()
+                );
+                grant.granted_log_inter_message_period.reset();
+                grant.next_request_time = now;
+            }
+
+            if (now < grant.next_request_time) {
+                continue;
+            }
+
+            UnicastNegotiationTlv tlv;
+            tlv.tlv_type = TlvType::request_unicast_transmission;
+            tlv.message_type = grant.message_type;
+            tlv.log_inter_message_period = grant.requested_log_inter_message_period;
+            tlv.duration_field = master.config.duration;
+            message.tlvs.push_back(tlv);
+
+            grant.next_request_time = now + k_request_retry_interval;
+        }
+
+        if (!message.tlvs.empty()) {
+            send(master, message);
+        }
+    }
+}
+
+void rav::ptp::UnicastNegotiation::handle_signaling_message(
+    const boost::asio::ip::address_v4& src_address, const SignalingMessage& message, const Clock::time_point now
+) {
+    auto it = std::find_if(masters_.begin(), masters_.end(), [&src_address](const MasterState& m) {
+        return m.config.address == src_address;
+    });
+
+    if (it == masters_.end()) {
+        RAV_LOG_TRACE("Ignoring signaling message from unknown master {}", src_address.to_string());
+        return;
+    }
+
+    if (message.target_port_identity != port_identity_ && message.target_port_identity.port_number != PortIdentity::k_port_number_all) {
+        RAV_LOG_TRACE("Ignoring signaling message for other port: {}", message.target_port_identity.to_string());
+        return;
+    }
+
+    auto& master = *it;
+    master.port_identity = message.header.source_port_identity;
+
+    auto reply = make_signaling_message(master.port_identity);
+
+    for (auto& tlv : message.tlvs) {
+        switch (tlv.tlv_type) {
+            case TlvType::grant_unicast_transmission: {
+                auto* grant = find_grant(master, tlv.message_type);
+                if (grant == nullptr) {
+                    break;
+                }
+                if (tlv.duration_field == 0) {
+                    // IEEE1588-2019: 16.1.4.2.5 A duration of zero means the request was denied. Try a lower rate.
+                    grant->granted_log_inter_message_period.reset();
+                    if (grant->requested_log_inter_message_period < k_max_log_inter_message_period) {
+                        grant->requested_log_inter_message_period++;
+                    }
+                    grant->next_request_time = now + k_request_retry_interval;
+                    RAV_LOG_WARNING(
+                        "Unicast {} denied by {}, requesting log interval {} next", to_string(tlv.message_type),
+                        src_address.to_string(), grant->requested_log_inter_message_period
+                    );
+                    break;
+                }
+                const auto duration = std::chrono::seconds(tlv.duration_field);
+                grant->granted_log_inter_message_period = tlv.log_inter_message_period;
+                grant->granted_until = now + duration;
+                // Renew halfway the grant, or request again when the grant expires if no renewal is invited.
+                grant->next_request_time = tlv.renewal_invited ? now + duration / 2 : grant->granted_until;
+                RAV_LOG_TRACE(
+                    "Unicast {} granted by {} for {}s", to_string(tlv.message_type), src_address.to_string(), tlv.duration_field
+                );
+                break;
+            }
+            case TlvType::cancel_unicast_transmission: {
+                if (auto* grant = find_grant(master, tlv.message_type)) {
+                    grant->granted_log_inter_message_period.reset();
+                    grant->next_request_time = now + k_request_retry_interval;
+                }
+                UnicastNegotiationTlv ack;
+                ack.tlv_type = TlvType::acknowledge_cancel_unicast_transmission;
+                ack.message_type = tlv.message_type;
+                reply.tlvs.push_back(ack);
+                RAV_LOG_INFO("Unicast {} cancelled by {}", to_string(tlv.message_type), src_address.to_string());
+                break;
+            }
+            case TlvType::request_unicast_transmission: {
+                // This port only acts as slave, so deny any requests.
+                UnicastNegotiationTlv deny;
+                deny.tlv_type = TlvType::grant_unicast_transmission;
+                deny.message_type = tlv.message_type;
+                deny.log_inter_message_period = tlv.log_inter_message_period;
+                reply.tlvs.push_back(deny);
+                break;
+            }
+            case TlvType::acknowledge_cancel_unicast_transmission:
+            default:
+                break;
+        }
+    }
+
+    if (!reply.tlvs.empty()) {
+        send(master, reply);
+    }
+}
+
+void rav::ptp::UnicastNegotiation::cancel_all() {
+    for (auto& master : masters_) {
+        cancel(master);
+    }
+}
+
+bool rav::ptp::UnicastNegotiation::is_granted(const boost::asio::ip::address_v4& address, const MessageType message_type) const {
+    return get_granted_log_inter_message_period(address, message_type).has_value();
+}
+
+std::optional<int8_t> rav::ptp::UnicastNegotiation::get_granted_log_inter_message_period(
+    const boost::asio::ip::address_v4& address, const MessageType message_type
+) const {
+    const auto* master = find_master(address);
+    if (master == nullptr) {
+        return std::nullopt;
+    }
+    const auto* grant = find_grant(*master, message_type);
+    if (grant == nullptr) {
+        return std::nullopt;
+    }
+    return grant->granted_log_inter_message_period;
+}
+
+std::optional<boost::asio::ip::address_v4>
+rav::ptp::UnicastNegotiation::find_granted_master(const PortIdentity& master_port_identity, const MessageType message_type) const {
+    for (auto& master : masters_) {
+        if (master.port_identity != master_port_identity) {
+            continue;
+        }
+        const auto* grant = find_grant(master, message_type);
+        if (grant != nullptr && grant->granted_log_inter_message_period) {
+            return master.config.address;
+        }
+    }
+    return std::nullopt;
+}
+
+bool rav::ptp::UnicastNegotiation::empty() const {
+    return masters_.empty();
+}
+
+rav::ptp::UnicastNegotiation::MasterState
+rav::ptp::UnicastNegotiation::make_master_state(const UnicastMaster& config, const Clock::time_point now) {
+    MasterState master;
+    master.config = config;
+    for (size_t i = 0; i < k_message_types.size(); ++i) {
+        master.grants[i].message_type = k_message_types[i];
+        master.grants[i].requested_log_inter_message_period = log_inter_message_period_for(config, k_message_types[i]);
+        master.grants[i].next_request_time = now;
+    }
+    return master;
+}
+
+rav::ptp::SignalingMessage rav::ptp::UnicastNegotiation::make_signaling_message(const std::optional<PortIdentity>& target) const {
+    SignalingMessage message;
+    message.header.message_type = MessageType::signaling;
+    message.header.source_port_identity = port_identity_;
+    message.header.flags.unicast_flag = true;
+    message.target_port_identity = target.value_or(all_ports());
+    return message;
+}
+
+void rav::ptp::UnicastNegotiation::send(const MasterState& master, SignalingMessage& message) {
+    message.header.sequence_id = sequence_id_++;
+    if (send_) {
+        send_(master.config.address, message);
+    }
+}
+
+void rav::ptp::UnicastNegotiation::cancel(MasterState& master) {
+    auto message = make_signaling_message(master.port_identity);
+    for (auto& grant : master.grants) {
+        if (!grant.granted_log_inter_message_period) {
+            continue;
+        }
+        UnicastNegotiationTlv tlv;
+        tlv.tlv_type = TlvType::cancel_unicast_transmission;
+        tlv.message_type = grant.message_type;
+        message.tlvs.push_back(tlv);
+        grant.granted_log_inter_message_period.reset();
+    }
+    if (!message.tlvs.empty()) {
+        send(master, message);
+    }
+}
+
+rav::ptp::UnicastNegotiation::Grant* rav::ptp::UnicastNegotiation::find_grant(MasterState& master, const MessageType message_type) {
+    for (auto& grant : master.grants) {
+        if (grant.message_type == message_type) {
+            return &grant;
+        }
+    }
+    return nullptr;
+}
+
+const rav::ptp::UnicastNegotiation::Grant*
+rav::ptp::UnicastNegotiation::find_grant(const MasterState& master, const MessageType message_type) {
+    for (auto& grant : master.grants) {
+        if (grant.message_type == message_type) {
+            return &grant;
+        }
+    }
+    return nullptr;
+}
+
+const rav::ptp::UnicastNegotiation::MasterState*
+rav::ptp::UnicastNegotiation::find_master(const boost::asio::ip::address_v4& address) const {
+    for (auto& master : masters_) {
+        if (master.config.address == address) {
+            return &master;
+        }
+    }
+    return nullptr;
+}
@@ -47,6 +47,19 @@ rav::ptp::AnnounceMessage::from_data(const MessageHeader& header, BufferView<con
     return msg;
 }
 
+void rav::ptp::AnnounceMessage::write_to(ByteBuffer& buffer) const {
+    header.write_to(buffer);
+    origin_timestamp.write_to(buffer);
+    buffer.write_be<int16_t>(current_utc_offset);
+    buffer.write_be<uint8_t>(0);  // Reserved
+    buffer.write_be<uint8_t>(grandmaster_priority1);
+    grandmaster_clock_quality.write_to(buffer);
+    buffer.write_be<uint8_t>(grandmaster_priority2);
+    grandmaster_identity.write_to(buffer);
+    buffer.write_be<uint16_t>(steps_removed);
+    buffer.write_be<uint8_t>(static_cast<uint8_t>(time_source));
+}
+
 std::string rav::ptp::AnnounceMessage::to_string() const {
     return fmt::format(
         "{} origin_timestamp={}.{:09d} current_utc_offset={} gm_priority1={} gm_clock_quality=({})", header.to_string(),
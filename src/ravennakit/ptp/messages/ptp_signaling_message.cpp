@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/ptp/messages/ptp_signaling_message.hpp"
+
+namespace {
+
+constexpr uint16_t k_request_length = 6;
+constexpr uint16_t k_grant_length = 8;
+constexpr uint16_t k_cancel_length = 2;
+
+uint16_t length_field_for(const rav::ptp::TlvType type) {
+    switch (type) {
+        case rav::ptp::TlvType::request_unicast_transmission:
+            return k_request_length;
+        case rav::ptp::TlvType::grant_unicast_transmission:
+            return k_grant_length;
+        case rav::ptp::TlvType::cancel_unicast_transmission:
+        case rav::ptp::TlvType::acknowledge_cancel_unicast_transmission:
+        default:
+            return k_cancel_length;
+    }
+}
+
+}  // namespace
+
+const char* rav::ptp::to_string(const TlvType type) {
+    switch (type) {
+        case TlvType::request_unicast_transmission:
+            return "REQUEST_UNICAST_TRANSMISSION";
+        case TlvType::grant_unicast_transmission:
+            return "GRANT_UNICAST_TRANSMISSION";
+        case TlvType::cancel_unicast_transmission:
+            return "CANCEL_UNICAST_TRANSMISSION";
+        case TlvType::acknowledge_cancel_unicast_transmission:
+            return "ACKNOWLEDGE_CANCEL_UNICAST_TRANSMISSION";
+        default:
+            return "unknown";
+    }
+}
+
+tl::expected<std::optional<rav::ptp::UnicastNegotiationTlv>, rav::ptp::Error>
+rav::ptp::UnicastNegotiationTlv::from_data(const BufferView<const uint8_t> data) {
+    if (data.size() < SignalingMessage::k_tlv_header_size) {
+        return tl::unexpected(Error::invalid_message_length);
+    }
+
+    const auto tlv_type = static_cast<TlvType>(data.read_be<uint16_t>(0));
+    const auto length_field = data.read_be<uint16_t>(2);
+
+    if (data.size() < SignalingMessage::k_tlv_header_size + length_field) {
+        return tl::unexpected(Error::invalid_message_length);
+    }
+
+    switch (tlv_type) {
+        case TlvType::request_unicast_transmission:
+        case TlvType::grant_unicast_transmission:
+        case TlvType::cancel_unicast_transmission:
+        case TlvType::acknowledge_cancel_unicast_transmission:
+            break;
+        default:
+            return std::nullopt;
+    }
+
+    if (length_field < length_field_for(tlv_type)) {
+        return tl::unexpected(Error::invalid_data);
+    }
+
+    UnicastNegotiationTlv tlv;
+    tlv.tlv_type = tlv_type;
+    tlv.message_type = static_cast<MessageType>((data[4] & 0b11110000) >> 4);
+
+    if (tlv_type == TlvType::request_unicast_transmission || tlv_type == TlvType::grant_unicast_transmission) {
+        tlv.log_inter_message_period = static_cast<int8_t>(data[5]);
+        tlv.duration_field = data.read_be<uint32_t>(6);
+    }
+
+    if (tlv_type == TlvType::grant_unicast_transmission) {
+        tlv.renewal_invited = (data[11] & 0b00000001) != 0;
+    }
+
+    return tlv;
+}
+
+void rav::ptp::UnicastNegotiationTlv::write_to(ByteBuffer& buffer) const {
+    buffer.write_be<uint16_t>(static_cast<uint16_t>(tlv_type));
+    buffer.write_be<uint16_t>(length_field_for(tlv_type));
+    // Left shift by multiplication to avoid type promotion
+    buffer.write_be<uint8_t>((static_cast<uint8_t>(message_type) & 0b00001111) * 16);
+
+    switch (tlv_type) {
+        case TlvType::request_unicast_transmission:
+            buffer.write_be<int8_t>(log_inter_message_period);
+            buffer.write_be<uint32_t>(duration_field);
+            break;
+        case TlvType::grant_unicast_transmission:
+            buffer.write_be<int8_t>(log_inter_message_period);
+            buffer.write_be<uint32_t>(duration_field);
+            buffer.write_be<uint8_t>(0);  // Reserved
+            buffer.write_be<uint8_t>(renewal_invited ? 1 : 0);
+            break;
+        case TlvType::cancel_unicast_transmission:
+        case TlvType::acknowledge_cancel_unicast_transmission:
+        default:
+            buffer.write_be<uint8_t>(0);  // Reserved
+            break;
+    }
+}
+
+uint16_t rav::ptp::UnicastNegotiationTlv::size() const {
+    return static_cast<uint16_t>(SignalingMessage::k_tlv_header_size + length_field_for(tlv_type));
+}
+
+std::string rav::ptp::UnicastNegotiationTlv::to_string() const {
+    return fmt::format(
+        "{} message_type={} log_inter_message_period={} duration_field={} renewal_invited={}", rav::ptp::to_string(tlv_type),
+        rav::ptp::to_string(message_type), log_inter_message_period, duration_field, renewal_invited
+    );
+}
+
+tl::expected<rav::ptp::SignalingMessage, rav::ptp::Error>
+rav::ptp::SignalingMessage::from_data(const MessageHeader& header, const BufferView<const uint8_t> data) {
+    if (data.size() < k_message_size) {
+        return tl::unexpected(Error::invalid_message_length);
+    }
+
+    SignalingMessage msg;
+    msg.header = header;
+    auto target_port_identity = PortIdentity::from_data(data);
+    if (!target_port_identity) {
+        return tl::unexpected(target_port_identity.error());
+    }
+    msg.target_port_identity = target_port_identity.value();
+
+    auto remaining = data.subview(k_message_size);
+    while (remaining.size() >= k_tlv_header_size) {
+        auto tlv = UnicastNegotiationTlv::from_data(remaining);
+        if (!tlv) {
+            return tl::unexpected(tlv.error());
+        }
+        if (tlv->has_value()) {
+            msg.tlvs.push_back(**tlv);
+        }
+        remaining = remaining.subview(k_tlv_header_size + remaining.read_be<uint16_t>(2));
+    }
+
+    return msg;
+}
+
+void rav::ptp::SignalingMessage::write_to(ByteBuffer& buffer) const {
+    size_t message_length = MessageHeader::k_header_size + k_message_size;
+    for (auto& tlv : tlvs) {
+        message_length += tlv.size();
+    }
+
+    auto signaling_header = header;
+    signaling_header.message_type = MessageType::signaling;
+    signaling_header.message_length = static_cast<uint16_t>(message_length);
+    signaling_header.log_message_interval = 0x7f;  // IEEE1588-2019: 13.3.2.14
+    signaling_header.write_to(buffer);
+    target_port_identity.write_to(buffer);
+    for (auto& tlv : tlvs) {
+        tlv.write_to(buffer);
+    }
+}
+
+std::string rav::ptp::SignalingMessage::to_string() const {
+    std::string result = fmt::format("target_port_identity={}", target_port_identity.to_string());
+    for (auto& tlv : tlvs) {
+        result += fmt::format(" [{}]", tlv.to_string());
+    }
+    return result;
+}
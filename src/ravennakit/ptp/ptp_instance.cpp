@@ -36,8 +36,14 @@ const rav::ptp::LocalClock& rav::ptp::Instance::Subscriber::get_local_clock() {
     return local_clock_;
 }
 
-rav::ptp::Instance::Instance(boost::asio::io_context& io_context) :
-    io_context_(io_context), state_decision_timer_(io_context), default_ds_(true), parent_ds_(default_ds_) {}
+rav::ptp::Instance::Instance(boost::asio::io_context& io_context) : Instance(io_context, io_context) {}
+
+rav::ptp::Instance::Instance(boost::asio::io_context& io_context, boost::asio::io_context& event_io_context) :
+    io_context_(io_context),
+    event_io_context_(event_io_context),
+    state_decision_timer_(io_context),
+    default_ds_(true),
+    parent_ds_(default_ds_) {}
 
 rav::ptp::Instance::~Instance() {
     state_decision_timer_.cancel();
@@ -65,6 +71,10 @@ tl::expected<void, std::string> rav::ptp::Instance::set_configuration(const Conf
     config_ = config;
     default_ds_.domain_number = config_.domain_number;
 
+    for (const auto& port : ports_) {
+        port->set_unicast_masters(config_.unicast_masters);
+    }
+
     subscribers_.foreach ([this](Subscriber* s) {
         s->ptp_configuration_updated(config_);
     });
@@ -106,13 +116,15 @@ rav::ptp::Instance::add_port(const uint16_t port_number, const boost::asio::ip::
     port_identity.clock_identity = default_ds_.clock_identity;
     port_identity.port_number = port_number;
 
-    auto new_port = std::make_unique<Port>(*this, io_context_, interface_address, port_identity);
+    auto new_port = std::make_unique<Port>(*this, io_context_, event_io_context_, interface_address, port_identity);
     new_port->on_state_changed([this](const Port& port) {
         for (auto* s : subscribers_) {
             s->ptp_port_changed_state(port);
         }
     });
 
+    new_port->set_unicast_masters(config_.unicast_masters);
+
     const auto& added_port = ports_.emplace_back(std::move(new_port));
     added_port->assert_valid_state(DefaultProfile1);
 
@@ -372,6 +384,10 @@ rav::ptp::Timestamp rav::ptp::Instance::get_local_ptp_time() const {
     return local_clock_.now();
 }
 
+rav::ptp::Timestamp rav::ptp::Instance::get_local_ptp_time(const uint64_t host_time_ns) const {
+    return local_clock_.get_adjusted_time(host_time_ns);
+}
+
 void rav::ptp::Instance::update_local_ptp_clock(const Measurement<double>& measurement) {
     current_ds_.mean_delay = TimeInterval::to_fractional_interval(measurement.mean_delay);
     current_ds_.offset_from_master = TimeInterval::to_fractional_interval(measurement.offset_from_master);
@@ -463,12 +479,33 @@ void rav::ptp::Instance::schedule_state_decision_timer() {
 }
 
 void rav::ptp::tag_invoke(const boost::json::value_from_tag&, boost::json::value& jv, const Instance::Configuration& config) {
-    jv = {{"domain_number", config.domain_number}};
+    boost::json::array unicast_masters;
+    for (const auto& master : config.unicast_masters) {
+        unicast_masters.push_back({
+            {"address", master.address.to_string()},
+            {"log_announce_interval", master.log_announce_interval},
+            {"log_sync_interval", master.log_sync_interval},
+            {"log_delay_resp_interval", master.log_delay_resp_interval},
+            {"duration", master.duration},
+        });
+    }
+    jv = {{"domain_number", config.domain_number}, {"unicast_masters", unicast_masters}};
 }
 
 rav::ptp::Instance::Configuration
 rav::ptp::tag_invoke(const boost::json::value_to_tag<Instance::Configuration>&, const boost::json::value& jv) {
     Instance::Configuration config;
     config.domain_number = jv.at("domain_number").to_number<uint8_t>();
+    if (const auto* unicast_masters = jv.as_object().if_contains("unicast_masters")) {
+        for (const auto& master_jv : unicast_masters->as_array()) {
+            UnicastMaster master;
+            master.address = boost::asio::ip::make_address_v4(master_jv.at("address").as_string().c_str());
+            master.log_announce_interval = master_jv.at("log_announce_interval").to_number<int8_t>();
+            master.log_sync_interval = master_jv.at("log_sync_interval").to_number<int8_t>();
+            master.log_delay_resp_interval = master_jv.at("log_delay_resp_interval").to_number<int8_t>();
+            master.duration = master_jv.at("duration").to_number<uint32_t>();
+            config.unicast_masters.push_back(master);
+        }
+    }
     return config;
 }
@@ -24,7 +24,9 @@
 
 #include "ravennakit/ptp/ptp_port.hpp"
 
+#include "ravennakit/core/clock.hpp"
 #include "ravennakit/core/random.hpp"
+#include "ravennakit/core/realtime_log.hpp"
 #include "ravennakit/core/util.hpp"
 #include "ravennakit/core/containers/buffer_view.hpp"
 #include "ravennakit/ptp/ptp_constants.hpp"
@@ -35,6 +37,7 @@
 #include "ravennakit/ptp/messages/ptp_pdelay_resp_follow_up_message.hpp"
 #include "ravennakit/ptp/messages/ptp_pdelay_resp_message.hpp"
 
+#include <cstring>
 #include <random>
 
 namespace {
@@ -44,16 +47,25 @@ constexpr auto k_ptp_general_port = 320;
 }  // namespace
 
 rav::ptp::Port::Port(
-    Instance& parent, boost::asio::io_context& io_context, const boost::asio::ip::address_v4& interface_address,
-    const PortIdentity port_identity
+    Instance& parent, boost::asio::io_context& io_context, boost::asio::io_context& event_io_context,
+    const boost::asio::ip::address_v4& interface_address, const PortIdentity port_identity
 ) :
     parent_(parent),
+    io_context_(io_context),
+    event_io_context_(event_io_context),
     announce_receipt_timeout_timer_(io_context),
-    event_send_socket_(io_context, boost::asio::ip::address_v4(), k_ptp_event_port),
-    general_send_socket_(io_context, boost::asio::ip::address_v4(), k_ptp_general_port) {
+    unicast_negotiation_timer_(io_context),
+    event_messages_(std::make_shared<EventMessageQueue>()),
+    event_socket_(std::make_unique<ExtendedUdpSocket>(event_io_context, boost::asio::ip::address_v4(), k_ptp_event_port)),
+    general_send_socket_(io_context, boost::asio::ip::address_v4(), k_ptp_general_port),
+    unicast_negotiation_(port_identity, [this](const boost::asio::ip::address_v4& destination, const SignalingMessage& message) {
+        send_signaling_message(destination, message);
+    }) {
     RAV_ASSERT(!interface_address.is_unspecified(), "Interface address must not be unspecified");
     RAV_ASSERT(!interface_address.is_multicast(), "Interface address must not be multicast");
 
+    event_messages_->port = this;
+
     // Initialize the port data set
     port_ds_.port_identity = port_identity;
     port_ds_.delay_mechanism = DelayMechanism::e2e;  // TODO: Make this configurable
@@ -61,29 +73,62 @@ rav::ptp::Port::Port(
 
     set_interface(interface_address);
 
-    if (const auto ec = event_send_socket_.set_multicast_loopback(false)) {
-        RAV_LOG_WARNING("Failed to set multicast loopback for event socket: {}", ec.message());
-    }
     if (const auto ec = general_send_socket_.set_multicast_loopback(false)) {
         RAV_LOG_WARNING("Failed to set multicast loopback for general socket: {}", ec.message());
     }
-
-    event_send_socket_.set_dscp_value(46);    // Default AES67 value
     general_send_socket_.set_dscp_value(46);  // Default AES67 value
 
-    auto handler = [this](const ExtendedUdpSocket::RecvEvent& event) {
+    // Called on the event thread. Only touches the queue, the messages are processed on io_context.
+    auto event_handler = [queue = event_messages_, &io_context](const ExtendedUdpSocket::RecvEvent& event) {
+        TRACY_ZONE_SCOPED;
+        if (event.size > k_max_event_message_size) {
+            RAV_LOG_WARNING_REALTIME("PTP event message too large: {} bytes", event.size);
+            return;
+        }
+        EventMessage message;
+        std::memcpy(message.data.data(), event.data, event.size);
+        message.size = event.size;
+        message.src_endpoint = event.src_endpoint;
+        message.dst_endpoint = event.dst_endpoint;
+        message.recv_time = event.recv_time;
+        if (!queue->messages.push(message)) {
+            RAV_LOG_WARNING_REALTIME("PTP event message queue is full, dropping message");
+            return;
+        }
+        boost::asio::post(io_context, [queue] {
+            if (queue->port != nullptr) {
+                queue->port->process_event_messages();
+            }
+        });
+    };
+
+    auto general_handler = [this](const ExtendedUdpSocket::RecvEvent& event) {
+        // Process pending event messages first, so that a Follow_Up is never handled before its Sync.
+        process_event_messages();
         handle_recv_event(event);
     };
 
-    event_send_socket_.start(handler);
-    general_send_socket_.start(handler);
+    // The event socket is only ever used from the event thread, which also receives on it.
+    boost::asio::post(event_io_context_, [socket = event_socket_.get(), handler = std::move(event_handler)] {
+        if (const auto ec = socket->set_multicast_loopback(false)) {
+            RAV_LOG_WARNING("Failed to set multicast loopback for event socket: {}", ec.message());
+        }
+        socket->set_dscp_value(46);  // Default AES67 value
+        socket->start(handler);
+    });
+    general_send_socket_.start(general_handler);
 
     set_state(State::listening);
 
     schedule_announce_receipt_timeout();
 }
 
-rav::ptp::Port::~Port() = default;
+rav::ptp::Port::~Port() {
+    unicast_negotiation_.cancel_all();
+    event_messages_->port = nullptr;
+    // The event socket is receiving on the event thread, so it has to be closed there as well.
+    boost::asio::post(event_io_context_, [socket = std::move(event_socket_)] {});
+}
 
 const rav::ptp::PortIdentity& rav::ptp::Port::get_port_identity() const {
     return port_ds_.port_identity;
@@ -271,13 +316,48 @@ void rav::ptp::Port::process_request_response_delay_sequence() {
 void rav::ptp::Port::send_delay_req_message(RequestResponseDelaySequence& sequence) {
     TRACY_ZONE_SCOPED;
 
-    const auto msg = sequence.create_delay_req_message(port_ds_);
+    auto msg = sequence.create_delay_req_message(port_ds_);
+
+    // When the master granted unicast Delay_Resp messages, the Delay_Req is sent to it directly.
+    boost::asio::ip::address_v4 destination = k_ptp_multicast_address;
+    if (const auto master = unicast_negotiation_.find_granted_master(parent_.get_parent_ds().parent_port_identity, MessageType::delay_resp)) {
+        destination = *master;
+        msg.header.flags.unicast_flag = true;
+    }
+
     send_buffer_.clear();
     msg.write_to(send_buffer_);
-    tracy_point();
-    event_send_socket_.send(send_buffer_.data(), send_buffer_.size(), {k_ptp_multicast_address, k_ptp_event_port});
-    tracy_point();
-    sequence.set_delay_req_sent_time(parent_.get_local_ptp_time());
+    sequence.set_delay_req_sending();
+
+    // The event socket is owned by the event thread, so the message is sent from there. The send time is taken right after sending
+    // and handed back to io_context, where the sequence lives. The socket outlives this handler, see ~Port().
+    boost::asio::post(
+        event_io_context_,
+        [socket = event_socket_.get(), data = std::vector<uint8_t>(send_buffer_.data(), send_buffer_.data() + send_buffer_.size()),
+         endpoint = boost::asio::ip::udp::endpoint(destination, k_ptp_event_port), queue = event_messages_, &io_context = io_context_,
+         sequence_id = msg.header.sequence_id] {
+            tracy_point();
+            socket->send(data.data(), data.size(), endpoint);
+            tracy_point();
+            const auto sent_time = clock::now_monotonic_high_resolution_ns();
+            boost::asio::post(io_context, [queue, sequence_id, sent_time] {
+                if (queue->port != nullptr) {
+                    queue->port->handle_delay_req_sent(sequence_id, sent_time);
+                }
+            });
+        }
+    );
+}
+
+void rav::ptp::Port::handle_delay_req_sent(const WrappingUint<uint16_t> sequence_id, const uint64_t sent_time) {
+    TRACY_ZONE_SCOPED;
+
+    for (auto& seq : request_response_delay_sequences_) {
+        if (seq.get_state() == RequestResponseDelaySequence::state::delay_req_sending && seq.get_sequence_id() == sequence_id) {
+            seq.set_delay_req_sent_time(parent_.get_local_ptp_time(sent_time));
+            return;
+        }
+    }
 }
 
 rav::ptp::State rav::ptp::Port::state() const {
@@ -352,10 +432,25 @@ void rav::ptp::Port::set_interface(const boost::asio::ip::address_v4& interface_
         return;
     }
 
-    if (!interface_address_.is_unspecified()) {
-        if (const auto ec = event_send_socket_.leave_multicast_group(k_ptp_multicast_address, interface_address_)) {
-            RAV_LOG_ERROR("Failed to leave multicast group for event socket: {}", ec.message());
+    // The event socket is owned by the event thread, the membership is changed there as well.
+    boost::asio::post(event_io_context_, [socket = event_socket_.get(), previous = interface_address_, next = interface_address] {
+        if (!previous.is_unspecified()) {
+            if (const auto ec = socket->leave_multicast_group(k_ptp_multicast_address, previous)) {
+                RAV_LOG_ERROR("Failed to leave multicast group for event socket: {}", ec.message());
+            }
+        }
+        if (next.is_unspecified()) {
+            return;
+        }
+        if (const auto ec = socket->join_multicast_group(k_ptp_multicast_address, next)) {
+            RAV_LOG_ERROR("Failed to join multicast group for event socket: {}", ec.message());
+        }
+        if (const auto ec = socket->set_multicast_outbound_interface(next)) {
+            RAV_LOG_ERROR("Failed to set multicast outbound interface for event socket: {}", ec.message());
         }
+    });
+
+    if (!interface_address_.is_unspecified()) {
         if (const auto ec = general_send_socket_.leave_multicast_group(k_ptp_multicast_address, interface_address_)) {
             RAV_LOG_ERROR("Failed to leave multicast group for general socket: {}", ec.message());
         }
@@ -363,19 +458,20 @@ void rav::ptp::Port::set_interface(const boost::asio::ip::address_v4& interface_
 
     interface_address_ = interface_address;
 
+    // Grants were given for the previous address, so cancel them and request them again.
+    if (!unicast_negotiation_.empty()) {
+        const auto masters = unicast_negotiation_.get_masters();
+        set_unicast_masters({});
+        set_unicast_masters(masters);
+    }
+
     if (interface_address_.is_unspecified()) {
         return;
     }
 
-    if (const auto ec = event_send_socket_.join_multicast_group(k_ptp_multicast_address, interface_address_)) {
-        RAV_LOG_ERROR("Failed to join multicast group for event socket: {}", ec.message());
-    }
     if (const auto ec = general_send_socket_.join_multicast_group(k_ptp_multicast_address, interface_address_)) {
         RAV_LOG_ERROR("Failed to join multicast group for general socket: {}", ec.message());
     }
-    if (const auto ec = event_send_socket_.set_multicast_outbound_interface(interface_address_)) {
-        RAV_LOG_ERROR("Failed to set multicast outbound interface for event socket: {}", ec.message());
-    }
     if (const auto ec = general_send_socket_.set_multicast_outbound_interface(interface_address_)) {
         RAV_LOG_ERROR("Failed to set multicast outbound interface for general socket: {}", ec.message());
     }
@@ -424,6 +520,8 @@ void rav::ptp::Port::handle_recv_event(const ExtendedUdpSocket::RecvEvent& event
             if (!sync_message) {
                 RAV_LOG_ERROR("{} error: {}", header->to_string(), to_string(sync_message.error()));
             }
+            // Using the time the message was received instead of the time it is handled, which can be later.
+            sync_message.value().receive_timestamp = parent_.get_local_ptp_time(event.recv_time);
             handle_sync_message(sync_message.value(), {});
             break;
         }
@@ -464,7 +562,15 @@ void rav::ptp::Port::handle_recv_event(const ExtendedUdpSocket::RecvEvent& event
             handle_pdelay_resp_follow_up_message(pdelay_resp_follow_up.value(), {});
             break;
         }
-        case MessageType::signaling:
+        case MessageType::signaling: {
+            auto signaling = SignalingMessage::from_data(header.value(), data.subview(MessageHeader::k_header_size));
+            if (!signaling) {
+                RAV_LOG_ERROR("{} error: {}", header->to_string(), to_string(signaling.error()));
+                break;
+            }
+            handle_signaling_message(signaling.value(), event.src_endpoint.address());
+            break;
+        }
         case MessageType::management:
         case MessageType::reserved1:
         case MessageType::reserved2:
@@ -478,6 +584,14 @@ void rav::ptp::Port::handle_recv_event(const ExtendedUdpSocket::RecvEvent& event
     }
 }
 
+void rav::ptp::Port::process_event_messages() {
+    TRACY_ZONE_SCOPED;
+
+    while (const auto message = event_messages_->messages.pop()) {
+        handle_recv_event({message->data.data(), message->size, message->src_endpoint, message->dst_endpoint, message->recv_time});
+    }
+}
+
 void rav::ptp::Port::handle_announce_message(const AnnounceMessage& announce_message, BufferView<const uint8_t> tlvs) {
     TRACY_ZONE_SCOPED;
 
@@ -531,8 +645,6 @@ void rav::ptp::Port::handle_sync_message(SyncMessage sync_message, BufferView<co
 
     std::ignore = tlvs;
 
-    sync_message.receive_timestamp = parent_.get_local_ptp_time();
-
     // Ignore sync messages when not in slave or uncalibrated state
     if (!(port_ds_.port_state == State::slave || port_ds_.port_state == State::uncalibrated)) {
         return;
@@ -626,6 +738,9 @@ void rav::ptp::Port::handle_delay_resp_message(const DelayRespMessage& delay_res
     }
 
     for (auto& seq : request_response_delay_sequences_) {
+        if (seq.get_state() == RequestResponseDelaySequence::state::delay_req_sending) {
+            continue;  // The send time hasn't been handed back by the event thread yet.
+        }
         if (delay_resp_message.header.sequence_id == seq.get_sequence_id()) {
             port_ds_.log_min_delay_req_interval = delay_resp_message.header.log_message_interval;
             // Message is associated with earlier delay request message
@@ -668,6 +783,65 @@ void rav::ptp::Port::handle_pdelay_resp_follow_up_message(
     std::ignore = tlvs;
 }
 
+void rav::ptp::Port::handle_signaling_message(const SignalingMessage& signaling_message, const boost::asio::ip::address& src_address) {
+    TRACY_ZONE_SCOPED;
+
+    if (!src_address.is_v4()) {
+        return;
+    }
+
+    unicast_negotiation_.handle_signaling_message(src_address.to_v4(), signaling_message, UnicastNegotiation::Clock::now());
+}
+
+void rav::ptp::Port::set_unicast_masters(const std::vector<UnicastMaster>& masters) {
+    const auto now = UnicastNegotiation::Clock::now();
+    unicast_negotiation_.set_masters(masters, now);
+
+    if (unicast_negotiation_.empty()) {
+        unicast_negotiation_timer_.cancel();
+        return;
+    }
+
+    unicast_negotiation_.process(now);
+    schedule_unicast_negotiation();
+}
+
+const rav::ptp::UnicastNegotiation& rav::ptp::Port::unicast_negotiation() const {
+    return unicast_negotiation_;
+}
+
+void rav::ptp::Port::schedule_unicast_negotiation() {
+    unicast_negotiation_timer_.expires_after(std::chrono::seconds(1));
+    unicast_negotiation_timer_.async_wait([this](const boost::system::error_code& error) {
+        if (error == boost::asio::error::operation_aborted) {
+            return;
+        }
+        if (error) {
+            RAV_LOG_ERROR("Unicast negotiation timer error: {}", error.message());
+            return;
+        }
+        unicast_negotiation_.process(UnicastNegotiation::Clock::now());
+        schedule_unicast_negotiation();
+    });
+}
+
+void rav::ptp::Port::send_signaling_message(const boost::asio::ip::address_v4& destination, const SignalingMessage& message) {
+    TRACY_ZONE_SCOPED;
+
+    if (interface_address_.is_unspecified()) {
+        return;
+    }
+
+    auto signaling_message = message;
+    signaling_message.header.sdo_id = parent_.get_default_ds().sdo_id;
+    signaling_message.header.domain_number = parent_.get_default_ds().domain_number;
+    signaling_message.header.version = {port_ds_.version_number, port_ds_.minor_version_number};
+
+    send_buffer_.clear();
+    signaling_message.write_to(send_buffer_);
+    general_send_socket_.send(send_buffer_.data(), send_buffer_.size(), {destination, k_ptp_general_port});
+}
+
 void rav::ptp::Port::calculate_erbest() {
     if (erbest_) {
         RAV_ASSERT(
@@ -25,9 +25,16 @@
 #include "ravennakit/ravenna/ravenna_node.hpp"
 
 #include "ravennakit/core/platform/apple/priority.hpp"
+#include "ravennakit/core/platform/posix/priority.hpp"
+#include "ravennakit/core/platform/thread_affinity.hpp"
 #include "ravennakit/core/platform/windows/thread_characteristics.hpp"
+#include "ravennakit/core/realtime_log.hpp"
+#include "ravennakit/core/util/defer.hpp"
+#include "ravennakit/core/util/trace.hpp"
 #include "ravennakit/ravenna/ravenna_sender.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 namespace rav {
@@ -40,8 +47,11 @@ inline bool operator==(const rav::RavennaNode::Configuration& lhs, const rav::Ra
 
 }  // namespace rav
 
-rav::RavennaNode::RavennaNode() :
-    rtsp_server_(io_context_, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::any(), 0)), ptp_instance_(io_context_) {
+rav::RavennaNode::RavennaNode() : RavennaNode(NetworkThreadOptions {}) {}
+
+rav::RavennaNode::RavennaNode(const NetworkThreadOptions& network_thread_options) :
+    rtsp_server_(io_context_, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::any(), 0)),
+    ptp_instance_(io_context_, ptp_event_io_context_) {
     nmos_device_.id = boost::uuids::random_generator()();
     if (!nmos_node_.add_or_update_device(&nmos_device_)) {
         RAV_LOG_ERROR("Failed to add NMOS device with ID: {}", boost::uuids::to_string(nmos_device_.id));
@@ -59,10 +69,39 @@ rav::RavennaNode::RavennaNode() :
         }
     };
 
+    // The receivers of a bulk request switch their sessions together
+    nmos_node_.on_bulk_request_begin = [this] {
+        rtp_receiver_.begin_reader_updates();
+    };
+
+    nmos_node_.on_bulk_request_end = [this] {
+        if (!rtp_receiver_.commit_reader_updates()) {
+            RAV_LOG_ERROR("Failed to apply all reader updates of a bulk request");
+        }
+    };
+
     if (!ptp_instance_.subscribe(&rtp_receiver_.ptp_instance_subscriber)) {
         RAV_LOG_ERROR("Failed to subscribe to PTP instance");
     }
 
+    nmos_node_.get_http_server().get(
+        "/metrics", [this](const HttpServer::Request&, HttpServer::Response& res, PathMatcher::Parameters&) {
+            res.result(boost::beast::http::status::ok);
+            res.set(boost::beast::http::field::content_type, metrics::PrometheusWriter::k_content_type);
+            res.body() = collect_metrics();
+            res.prepare_payload();
+        }
+    );
+
+    nmos_node_.get_http_server().get("/trace", [](const HttpServer::Request&, HttpServer::Response& res, PathMatcher::Parameters&) {
+        res.result(boost::beast::http::status::ok);
+        res.set(boost::beast::http::field::content_type, "application/json");
+        res.body() = trace::to_chrome_trace_json();
+        res.prepare_payload();
+    });
+
+    std::ignore = RealtimeLogger::get_instance();  // Starts the background thread before the network thread needs it
+
     std::promise<std::thread::id> promise;
     auto f = promise.get_future();
     maintenance_thread_ = std::thread([this, p = std::move(promise)]() mutable {
@@ -90,13 +129,23 @@ rav::RavennaNode::RavennaNode() :
     });
     maintenance_thread_id_ = f.get();
 
-    network_thread_ = std::thread([this] {
-        TRACY_SET_THREAD_NAME("ravenna_node_network");
+    // PTP event messages are received on their own thread, so that their timestamps don't suffer from the work done on
+    // the maintenance thread (like serving the NMOS API).
+    ptp_event_thread_ = std::thread([this] {
+        TRACY_SET_THREAD_NAME("ravenna_node_ptp_event");
 #if RAV_APPLE
-        pthread_setname_np("ravenna_node_network");
-        constexpr auto min_packet_time = 125 * 1000;       // 125us
-        constexpr auto max_packet_time = 4 * 1000 * 1000;  // 4ms
-        if (!set_thread_realtime(min_packet_time, max_packet_time, max_packet_time * 2)) {
+        pthread_setname_np("ravenna_node_ptp_event");
+        constexpr auto computation = 500 * 1000;       // 500us
+        constexpr auto constraint = 2 * 1000 * 1000;  // 2ms
+        if (!set_thread_realtime(0, computation, constraint)) {
+            RAV_LOG_ERROR("Failed to set thread realtime");
+        }
+#endif
+
+#if RAV_LINUX
+        // Below the default priority of the threaded interrupt handlers (50), which have to deliver the packets first.
+        constexpr auto priority = 40;
+        if (!posix::set_thread_fifo_priority(priority)) {
             RAV_LOG_ERROR("Failed to set thread realtime");
         }
 #endif
@@ -105,35 +154,58 @@ rav::RavennaNode::RavennaNode() :
         WindowsThreadCharacteristics set_thread_characteristics(TEXT("Pro Audio"));
 #endif
 
-        while (keep_going_.load(std::memory_order_acquire)) {
-            auto next = clock::now_monotonic_high_resolution_ns();
+        const auto work_guard = boost::asio::make_work_guard(ptp_event_io_context_);
+        while (true) {
             try {
-                while (keep_going_.load(std::memory_order_acquire)) {
-                    rtp_receiver_.read_incoming_packets();
-                    rtp_sender_.send_outgoing_packets();
-                    next += 100'000;  // 100us
-#if RAV_APPLE
-                    if (!mach_wait_until_ns(next)) {
-                        RAV_LOG_ERROR("mach_wait_until_ns failed");
-                    }
-#elif RAV_WINDOWS
-                    while (clock::now_monotonic_high_resolution_ns() < next) {
-                        std::this_thread::yield();
-                    }
-#else
-                    std::this_thread::sleep_for(std::chrono::microseconds(10));
-#endif
-                }
+                ptp_event_io_context_.run();
                 break;
             } catch (const std::exception& e) {
-                RAV_LOG_CRITICAL("Unhandled exception on network thread: {}", e.what());
-                RAV_ASSERT_DEBUG(false, "Unhandled exception on network thread");
+                RAV_LOG_CRITICAL("Unhandled exception on ptp event thread: {}", e.what());
+                RAV_ASSERT_DEBUG(false, "Unhandled exception on ptp event thread");
             } catch (...) {
-                RAV_LOG_CRITICAL("Unhandled unknown exception on maintenance thread");
-                RAV_ASSERT_DEBUG(false, "Unhandled unknown exception on maintenance thread");
+                RAV_LOG_CRITICAL("Unhandled unknown exception on ptp event thread");
+                RAV_ASSERT_DEBUG(false, "Unhandled unknown exception on ptp event thread");
             }
         }
     });
+
+    const auto num_network_threads = std::clamp<size_t>(network_thread_options.num_threads, 1, rtp::AudioReceiver::k_max_num_shards);
+    if (num_network_threads != network_thread_options.num_threads) {
+        RAV_LOG_WARNING("Number of network threads clamped to {}", num_network_threads);
+    }
+    if (!rtp_receiver_.set_num_shards(num_network_threads) || !rtp_sender_.set_num_shards(num_network_threads)) {
+        RAV_LOG_ERROR("Failed to set the number of shards");
+    }
+
+    if (network_thread_options.io_uring.has_value()) {
+        if (!rtp_receiver_.enable_io_uring(*network_thread_options.io_uring) ||
+            !rtp_sender_.enable_io_uring(*network_thread_options.io_uring)) {
+            RAV_LOG_WARNING("io_uring not available, falling back to polling the sockets");
+        }
+    }
+
+    if (network_thread_options.packet_mmap.has_value()) {
+        if (!rtp_receiver_.enable_packet_mmap(*network_thread_options.packet_mmap)) {
+            RAV_LOG_WARNING("AF_PACKET not available, falling back to polling the sockets");
+        }
+    }
+
+    if (network_thread_options.memory_arena.has_value()) {
+        std::shared_ptr<MemoryArena> arena = MemoryArena::create(*network_thread_options.memory_arena);
+        if (arena == nullptr || !rtp_receiver_.set_memory_arena(arena) || !rtp_sender_.set_memory_arena(arena)) {
+            RAV_LOG_WARNING("Failed to set up the memory arena, falling back to the heap");
+        }
+    }
+
+    for (size_t shard = 0; shard < num_network_threads; ++shard) {
+        std::optional<size_t> core;
+        if (network_thread_options.pin_to_cores) {
+            core = network_thread_options.first_core + shard;
+        }
+        network_threads_.emplace_back([this, shard, core] {
+            run_network_thread(shard, core);
+        });
+    }
 }
 
 rav::RavennaNode::~RavennaNode() {
@@ -145,8 +217,14 @@ rav::RavennaNode::~RavennaNode() {
         maintenance_thread_.join();
     }
     keep_going_.store(false, std::memory_order_release);
-    if (network_thread_.joinable()) {
-        network_thread_.join();
+    for (auto& network_thread : network_threads_) {
+        if (network_thread.joinable()) {
+            network_thread.join();
+        }
+    }
+    ptp_event_io_context_.stop();
+    if (ptp_event_thread_.joinable()) {
+        ptp_event_thread_.join();
     }
     for (const auto& receiver : receivers_) {
         receiver->set_nmos_node(nullptr);  // Prevent receiver from sending NMOS updates upon destruction
@@ -194,6 +272,74 @@ std::future<void> rav::RavennaNode::remove_receiver(Id receiver_id) {
     return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
 }
 
+std::future<tl::expected<std::vector<rav::Id>, std::string>>
+rav::RavennaNode::create_receivers(std::vector<RavennaReceiver::Configuration> initial_configs) {
+    auto work = [this, configs = std::move(initial_configs)]() mutable -> tl::expected<std::vector<Id>, std::string> {
+        // The multicast groups are joined once all readers are set up. When a configuration fails, the receivers which
+        // were created so far are destroyed before the commit, so nothing is joined.
+        rtp_receiver_.begin_reader_updates();
+        Defer commit_reader_updates([this] {
+            if (!rtp_receiver_.commit_reader_updates()) {
+                RAV_LOG_ERROR("Failed to apply all reader updates");
+            }
+        });
+
+        std::vector<std::unique_ptr<RavennaReceiver>> new_receivers;
+        new_receivers.reserve(configs.size());
+        for (auto& config : configs) {
+            auto new_receiver =
+                std::make_unique<RavennaReceiver>(rtsp_client_, rtp_receiver_, id_generator_.next(), network_interface_config_);
+            auto result = new_receiver->set_configuration(std::move(config));
+            if (!result) {
+                RAV_LOG_ERROR("Failed to set receiver configuration: {}", result.error());
+                return tl::unexpected(result.error());
+            }
+            new_receivers.push_back(std::move(new_receiver));
+        }
+
+        RAV_ASSERT(!nmos_node_.get_devices().empty(), "NMOS node must have at least one device");
+        std::vector<Id> ids;
+        ids.reserve(new_receivers.size());
+        for (auto& new_receiver : new_receivers) {
+            const auto& it = receivers_.emplace_back(std::move(new_receiver));
+            it->set_nmos_device_id(nmos_device_.id);
+            it->set_nmos_node(&nmos_node_);
+            for (const auto& s : subscribers_) {
+                s->ravenna_receiver_added(*it);
+            }
+            ids.push_back(it->get_id());
+        }
+        return ids;
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
+std::future<void> rav::RavennaNode::remove_receivers(std::vector<Id> receiver_ids) {
+    auto work = [this, ids = std::move(receiver_ids)]() mutable {
+        std::sort(ids.begin(), ids.end());
+        const auto it = std::stable_partition(receivers_.begin(), receivers_.end(), [&ids](const auto& receiver) {
+            return !std::binary_search(ids.begin(), ids.end(), receiver->get_id());
+        });
+
+        // Extend the lifetime until after the realtime context is updated:
+        std::vector<std::unique_ptr<RavennaReceiver>> removed(std::make_move_iterator(it), std::make_move_iterator(receivers_.end()));
+        receivers_.erase(it, receivers_.end());
+        for (const auto& receiver : removed) {
+            for (const auto& s : subscribers_) {
+                s->ravenna_receiver_removed(receiver->get_id());
+            }
+        }
+
+        // The multicast groups are left in one pass once all readers are removed
+        rtp_receiver_.begin_reader_updates();
+        removed.clear();
+        if (!rtp_receiver_.commit_reader_updates()) {
+            RAV_LOG_ERROR("Failed to apply all reader updates");
+        }
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
 std::future<tl::expected<void, std::string>>
 rav::RavennaNode::update_receiver_configuration(Id receiver_id, RavennaReceiver::Configuration config) {
     auto work = [this, receiver_id, u = std::move(config)]() -> tl::expected<void, std::string> {
@@ -250,6 +396,91 @@ std::future<void> rav::RavennaNode::remove_sender(Id sender_id) {
     return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
 }
 
+std::future<tl::expected<std::vector<rav::Id>, std::string>>
+rav::RavennaNode::create_senders(std::vector<RavennaSender::Configuration> initial_configs) {
+    auto work = [this, configs = std::move(initial_configs)]() mutable -> tl::expected<std::vector<Id>, std::string> {
+        // The senders are only added to senders_ at the end, so the session ids are handed out from here.
+        const auto first_session_id = generate_unique_session_id();
+
+        // Validate everything before the first sender is created, so that an invalid configuration leaves no trace.
+        for (size_t i = 0; i < configs.size(); ++i) {
+            auto& config = configs[i];
+            if (config.session_name.empty()) {
+                config.session_name = fmt::format("Sender {}", first_session_id + i);
+            }
+            auto result = RavennaSender::validate_configuration(config);
+            if (!result) {
+                RAV_LOG_ERROR("Invalid sender configuration: {}", result.error());
+                return tl::unexpected(result.error());
+            }
+        }
+
+        // Configure the senders disabled first, so none of them starts streaming or gets announced until all of them are set up.
+        auto session_id = first_session_id;
+        std::vector<std::unique_ptr<RavennaSender>> new_senders;
+        new_senders.reserve(configs.size());
+        for (const auto& config : configs) {
+            auto new_sender = std::make_unique<RavennaSender>(
+                rtp_sender_, advertiser_.get(), rtsp_server_, ptp_instance_, id_generator_.next(), session_id++,
+                network_interface_config_
+            );
+            auto disabled_config = config;
+            disabled_config.enabled = false;
+            auto result = new_sender->set_configuration(std::move(disabled_config));
+            if (!result) {
+                RAV_LOG_ERROR("Failed to set sender configuration: {}", result.error());
+                return tl::unexpected(result.error());
+            }
+            new_senders.push_back(std::move(new_sender));
+        }
+
+        for (size_t i = 0; i < new_senders.size(); ++i) {
+            if (!configs[i].enabled) {
+                continue;
+            }
+            auto result = new_senders[i]->set_configuration(configs[i]);
+            if (!result) {
+                RAV_LOG_ERROR("Failed to enable sender: {}", result.error());
+            }
+        }
+
+        std::vector<Id> ids;
+        ids.reserve(new_senders.size());
+        for (auto& new_sender : new_senders) {
+            const auto& it = senders_.emplace_back(std::move(new_sender));
+            it->set_nmos_device_id(nmos_device_.id);
+            it->set_nmos_node(&nmos_node_);
+            for (const auto& s : subscribers_) {
+                s->ravenna_sender_added(*it);
+            }
+            ids.push_back(it->get_id());
+        }
+        return ids;
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
+std::future<void> rav::RavennaNode::remove_senders(std::vector<Id> sender_ids) {
+    auto work = [this, ids = std::move(sender_ids)]() mutable {
+        std::sort(ids.begin(), ids.end());
+        const auto it = std::stable_partition(senders_.begin(), senders_.end(), [&ids](const auto& sender) {
+            return !std::binary_search(ids.begin(), ids.end(), sender->get_id());
+        });
+
+        // Extend the lifetime until after the realtime context is updated:
+        const std::vector<std::unique_ptr<RavennaSender>> removed(
+            std::make_move_iterator(it), std::make_move_iterator(senders_.end())
+        );
+        senders_.erase(it, senders_.end());
+        for (const auto& sender : removed) {
+            for (const auto& s : subscribers_) {
+                s->ravenna_sender_removed(sender->get_id());
+            }
+        }
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
 std::future<tl::expected<void, std::string>>
 rav::RavennaNode::update_sender_configuration(Id sender_id, RavennaSender::Configuration config) {
     auto work = [this, sender_id, u = std::move(config)]() -> tl::expected<void, std::string> {
@@ -457,6 +688,27 @@ std::optional<uint32_t> rav::RavennaNode::read_audio_data_realtime(
     return rtp_receiver_.read_audio_data_realtime(receiver_id, output_buffer, at_timestamp, require_delay);
 }
 
+std::future<std::optional<rav::rtp::AudioReceiver::AsrcStatus>> rav::RavennaNode::get_asrc_status(const Id receiver_id) {
+    auto work = [this, receiver_id] {
+        return rtp_receiver_.get_asrc_status(receiver_id);
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
+std::future<std::optional<rav::rtp::AudioReceiver::ReaderCost>> rav::RavennaNode::get_receiver_cost(const Id receiver_id) {
+    auto work = [this, receiver_id] {
+        return rtp_receiver_.get_reader_cost(receiver_id);
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
+std::future<std::optional<rav::rtp::AudioSender::WriterCost>> rav::RavennaNode::get_sender_cost(const Id sender_id) {
+    auto work = [this, sender_id] {
+        return rtp_sender_.get_writer_cost(sender_id);
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
 std::future<tl::expected<rav::sdp::SessionDescription, std::string>> rav::RavennaNode::get_sdp_for_sender(Id sender_id) {
     TRACY_ZONE_SCOPED;
     auto work = [this, sender_id]() -> tl::expected<sdp::SessionDescription, std::string> {
@@ -474,6 +726,12 @@ bool rav::RavennaNode::send_data_realtime(const Id sender_id, const BufferView<c
     return rtp_sender_.send_data_realtime(sender_id, buffer, timestamp);
 }
 
+bool rav::RavennaNode::send_data_realtime(
+    const Id sender_id, const BufferView<const uint8_t> buffer, const uint32_t timestamp, const AudioFormat::ByteOrder byte_order
+) {
+    return rtp_sender_.send_data_realtime(sender_id, buffer, timestamp, byte_order);
+}
+
 bool rav::RavennaNode::send_audio_data_realtime(const Id sender_id, const AudioBufferView<const float>& buffer, const uint32_t timestamp) {
     return rtp_sender_.send_audio_data_realtime(sender_id, buffer, timestamp);
 }
@@ -621,6 +879,15 @@ std::future<tl::expected<void, std::string>> rav::RavennaNode::restore_from_boos
 
             // Receivers
 
+            // The multicast groups of the new receivers and of the receivers they replace are joined and left in one pass,
+            // once the replaced receivers are gone. A group which both use is neither left nor joined again.
+            rtp_receiver_.begin_reader_updates();
+            Defer commit_reader_updates([this] {
+                if (!rtp_receiver_.commit_reader_updates()) {
+                    RAV_LOG_ERROR("Failed to apply all reader updates");
+                }
+            });
+
             auto receivers = json.at("receivers").as_array();
             std::vector<std::unique_ptr<RavennaReceiver>> new_receivers;
 
@@ -725,6 +992,20 @@ std::future<tl::expected<void, std::string>> rav::RavennaNode::restore_from_boos
     return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
 }
 
+std::future<std::string> rav::RavennaNode::get_metrics() {
+    auto work = [this] {
+        return collect_metrics();
+    };
+    return boost::asio::dispatch(io_context_, boost::asio::use_future(work));
+}
+
+std::string rav::RavennaNode::collect_metrics() {
+    metrics::PrometheusWriter writer;
+    rtp_receiver_.collect_metrics(writer);
+    rtp_sender_.collect_metrics(writer);
+    return writer.to_string();
+}
+
 uint32_t rav::RavennaNode::generate_unique_session_id() const {
     uint32_t highest_session_id = 0;
     for (auto& sender : senders_) {
@@ -737,6 +1018,10 @@ void rav::RavennaNode::do_maintenance() const {
     for (const auto& receiver : receivers_) {
         receiver->do_maintenance();
     }
+    for (const auto& sender : senders_) {
+        sender->do_maintenance();
+    }
+    trace::process_pending_dump();
 }
 
 void rav::RavennaNode::update_ravenna_browser() {
@@ -748,6 +1033,55 @@ void rav::RavennaNode::update_ravenna_browser() {
     }
 }
 
+void rav::RavennaNode::run_network_thread(const size_t shard, const std::optional<size_t> core) {
+    TRACY_SET_THREAD_NAME("ravenna_node_network");
+#if RAV_APPLE
+    pthread_setname_np("ravenna_node_network");
+    constexpr auto min_packet_time = 125 * 1000;       // 125us
+    constexpr auto max_packet_time = 4 * 1000 * 1000;  // 4ms
+    if (!set_thread_realtime(min_packet_time, max_packet_time, max_packet_time * 2)) {
+        RAV_LOG_ERROR("Failed to set thread realtime");
+    }
+#endif
+
+#if RAV_WINDOWS
+    WindowsThreadCharacteristics set_thread_characteristics(TEXT("Pro Audio"));
+#endif
+
+    if (core.has_value() && !set_current_thread_affinity(*core)) {
+        RAV_LOG_ERROR("Failed to pin network thread {} to core {}", shard, *core);
+    }
+
+    while (keep_going_.load(std::memory_order_acquire)) {
+        auto next = clock::now_monotonic_high_resolution_ns();
+        try {
+            while (keep_going_.load(std::memory_order_acquire)) {
+                rtp_receiver_.read_incoming_packets(shard);
+                rtp_sender_.send_outgoing_packets(shard);
+                next += 100'000;  // 100us
+#if RAV_APPLE
+                if (!mach_wait_until_ns(next)) {
+                    RAV_LOG_ERROR("mach_wait_until_ns failed");
+                }
+#elif RAV_WINDOWS
+                while (clock::now_monotonic_high_resolution_ns() < next) {
+                    std::this_thread::yield();
+                }
+#else
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+#endif
+            }
+            break;
+        } catch (const std::exception& e) {
+            RAV_LOG_CRITICAL("Unhandled exception on network thread: {}", e.what());
+            RAV_ASSERT_DEBUG(false, "Unhandled exception on network thread");
+        } catch (...) {
+            RAV_LOG_CRITICAL("Unhandled unknown exception on network thread");
+            RAV_ASSERT_DEBUG(false, "Unhandled unknown exception on network thread");
+        }
+    }
+}
+
 namespace rav {
 
 inline void tag_invoke(const boost::json::value_from_tag&, boost::json::value& jv, const RavennaNode::Configuration& config) {
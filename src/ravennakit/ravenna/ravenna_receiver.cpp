@@ -35,6 +35,8 @@
 #include <boost/uuid/string_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include <algorithm>
+
 namespace {
 
 bool is_connection_info_valid(const rav::sdp::ConnectionInfoField& conn) {
@@ -193,6 +195,8 @@ const rav::nmos::ReceiverAudio& rav::RavennaReceiver::get_nmos_receiver() const
 }
 
 void rav::RavennaReceiver::do_maintenance() {
+    update_scheduled_activation();
+
     // Update stream states
     for (size_t i = 0; i < streams_states_.size(); ++i) {
         if (auto state = rtp_audio_receiver_.get_stream_state(id_, i)) {
@@ -216,6 +220,12 @@ void rav::RavennaReceiver::do_maintenance() {
                 }
             }
         }
+
+        if (auto cost = rtp_audio_receiver_.get_reader_cost(id_)) {
+            for (auto* subscriber : subscribers_) {
+                subscriber->ravenna_receiver_cost_updated(id_, *cost);
+            }
+        }
     }
 }
 
@@ -236,6 +246,16 @@ rav::RavennaReceiver::RavennaReceiver(
         return handle_patch_request(patch_request);
     };
 
+    nmos_receiver_.on_scheduled_patch_request = [this](
+                                                    const boost::json::value& patch_request, const nmos::Timestamp& activation_time
+                                                ) -> tl::expected<void, nmos::ApiError> {
+        return handle_scheduled_patch_request(patch_request, activation_time);
+    };
+
+    nmos_receiver_.on_cancel_scheduled_activation = [this] {
+        cancel_scheduled_activation();
+    };
+
     nmos_receiver_.get_transport_file = [this]() -> tl::expected<sdp::SessionDescription, nmos::ApiError> {
         return configuration_.sdp;
     };
@@ -307,10 +327,67 @@ tl::expected<void, std::string> rav::RavennaReceiver::update_rtsp() {
 }
 
 tl::expected<void, rav::nmos::ApiError> rav::RavennaReceiver::handle_patch_request(const boost::json::value& patch_request) {
+    auto configuration = get_configuration_from_patch_request(patch_request);
+    if (!configuration) {
+        return tl::unexpected(configuration.error());
+    }
+
     if (const auto result = patch_request.try_at("sender_id")) {
         nmos_receiver_.subscription.sender_id = uuid_from_json(*result);
     }
 
+    if (auto t = set_configuration(std::move(*configuration)); !t) {
+        return tl::unexpected(nmos::ApiError {http::status::internal_server_error, t.error()});
+    }
+
+    return {};
+}
+
+tl::expected<void, rav::nmos::ApiError> rav::RavennaReceiver::handle_scheduled_patch_request(
+    const boost::json::value& patch_request, const nmos::Timestamp& activation_time
+) {
+    // A pending activation which is due by now has to land in configuration_ first, otherwise the patch would be applied on top of a
+    // stale configuration and silently revert it.
+    cancel_scheduled_activation();
+
+    auto configuration = get_configuration_from_patch_request(patch_request);
+    if (!configuration) {
+        return tl::unexpected(configuration.error());
+    }
+
+    ScheduledActivation scheduled;
+    scheduled.configuration = std::move(*configuration);
+    scheduled.sender_id = nmos_receiver_.subscription.sender_id;
+    if (const auto result = patch_request.try_at("sender_id")) {
+        scheduled.sender_id = uuid_from_json(*result);
+    }
+    scheduled.activation_time = activation_time;
+
+    // When only the sessions change, the reader prepares the new sessions up front and switches over at the exact sample of the
+    // activation time. Other changes restart the reader anyway and are applied from the maintenance loop.
+    if (configuration_.enabled && scheduled.configuration.enabled) {
+        auto parameters = create_rtp_receiver_parameters(scheduled.configuration.sdp);
+        if (parameters) {
+            parameters->share_ingest = scheduled.configuration.share_ingest;
+        }
+        if (parameters && parameters->is_valid() && parameters->audio_format == reader_parameters_.audio_format &&
+            *parameters != reader_parameters_) {
+            const auto rtp_timestamp = ptp::Timestamp(activation_time.seconds, activation_time.nanoseconds)
+                                           .to_rtp_timestamp32(parameters->audio_format.sample_rate);
+            scheduled.staged_in_reader = rtp_audio_receiver_.schedule_reader_update(
+                id_, *parameters,
+                network_interface_config_.get_array_of_interface_addresses<rtp::AudioReceiver::k_max_num_redundant_sessions>(),
+                rtp_timestamp
+            );
+        }
+    }
+
+    scheduled_activation_ = std::move(scheduled);
+    return {};
+}
+
+tl::expected<rav::RavennaReceiver::Configuration, rav::nmos::ApiError>
+rav::RavennaReceiver::get_configuration_from_patch_request(const boost::json::value& patch_request) const {
     auto configuration = configuration_;
     if (const auto result = patch_request.try_at("master_enable")) {
         configuration.enabled = boost::json::value_to<bool>(*result);
@@ -331,11 +408,138 @@ tl::expected<void, rav::nmos::ApiError> rav::RavennaReceiver::handle_patch_reque
         configuration.sdp = *sdp;
     }
 
-    if (auto t = set_configuration(configuration); !t) {
-        return tl::unexpected(nmos::ApiError {http::status::internal_server_error, t.error()});
+    return configuration;
+}
+
+void rav::RavennaReceiver::cancel_scheduled_activation() {
+    // An activation which took place already can't be cancelled anymore.
+    if (update_scheduled_activation()) {
+        return;
     }
 
-    return {};
+    if (!scheduled_activation_.has_value()) {
+        return;
+    }
+
+    if (scheduled_activation_->staged_in_reader && !rtp_audio_receiver_.cancel_scheduled_update(id_)) {
+        // The reader switched over in the meantime.
+        if (update_scheduled_activation()) {
+            return;
+        }
+    }
+
+    scheduled_activation_.reset();
+    nmos_receiver_.staged_activation = {};
+}
+
+bool rav::RavennaReceiver::update_scheduled_activation() {
+    if (!scheduled_activation_.has_value()) {
+        return false;
+    }
+
+    const auto now = rtp_audio_receiver_.ptp_instance_subscriber.get_local_clock().now();
+    const ptp::Timestamp activation_time(
+        scheduled_activation_->activation_time.seconds, scheduled_activation_->activation_time.nanoseconds
+    );
+    std::optional<ptp::Timestamp> activated_at;
+
+    if (scheduled_activation_->staged_in_reader) {
+        auto deadline = activation_time;
+        deadline.add_seconds(k_scheduled_activation_timeout_s);
+
+        if (const auto rtp_timestamp = rtp_audio_receiver_.complete_scheduled_update(id_)) {
+            activated_at = now.from_rtp_timestamp32(*rtp_timestamp, reader_parameters_.audio_format.sample_rate);
+        } else if (!rtp_audio_receiver_.has_scheduled_update(id_)) {
+            // The reader was restarted in the meantime, which dropped the staged sessions.
+            scheduled_activation_->staged_in_reader = false;
+        } else if (now > deadline && rtp_audio_receiver_.cancel_scheduled_update(id_)) {
+            // Nobody reads from the receiver, so the reader won't switch over by itself.
+            scheduled_activation_->staged_in_reader = false;
+        }
+    }
+
+    if (!activated_at.has_value() && !scheduled_activation_->staged_in_reader && now >= activation_time) {
+        activated_at = now;
+    }
+
+    if (!activated_at.has_value()) {
+        return false;
+    }
+
+    auto scheduled = std::move(*scheduled_activation_);
+    scheduled_activation_.reset();
+
+    nmos_receiver_.subscription.sender_id = scheduled.sender_id;
+    nmos_receiver_.active_activation = nmos_receiver_.staged_activation;
+    nmos_receiver_.active_activation.activation_time = nmos::Timestamp(*activated_at);
+    nmos_receiver_.staged_activation = {};
+
+    // When the reader switched over already, the reader update is a no-op.
+    if (auto result = set_configuration(std::move(scheduled.configuration)); !result) {
+        RAV_LOG_ERROR("Failed to apply scheduled activation: {}", result.error());
+    }
+
+    if (auto result = update_nmos(); !result) {
+        RAV_LOG_ERROR("Failed to update NMOS after scheduled activation: {}", result.error());
+    }
+
+    return true;
+}
+
+void rav::RavennaReceiver::update_adaptive_delay() {
+    std::optional<rtp::AudioReceiver::AdaptiveDelayParameters> parameters;
+    if (configuration_.adaptive_delay) {
+        // Packets arrive a packet time at once, so at least one packet time has to be kept on top of the jitter and the frames
+        // of a read. Below that every read at the bottom of a packet would underrun.
+        uint32_t packet_time_frames = 0;
+        for (const auto& stream : reader_parameters_.streams) {
+            if (stream.is_valid() && (packet_time_frames == 0 || stream.packet_time_frames < packet_time_frames)) {
+                packet_time_frames = stream.packet_time_frames;
+            }
+        }
+        parameters = rtp::AudioReceiver::AdaptiveDelayParameters {
+            std::min(packet_time_frames, configuration_.delay_frames), configuration_.delay_frames, packet_time_frames
+        };
+    }
+    // Fails when the reader doesn't exist (i.e. the receiver is disabled), which is fine.
+    std::ignore = rtp_audio_receiver_.set_adaptive_delay(id_, parameters);
+}
+
+void rav::RavennaReceiver::update_asrc() {
+    std::optional<rtp::AudioReceiver::AsrcParameters> parameters;
+    if (configuration_.asrc) {
+        parameters = rtp::AudioReceiver::AsrcParameters {};
+        parameters->target_fill_frames = std::max(configuration_.delay_frames, static_cast<uint32_t>(AudioResampler::k_num_taps));
+    }
+    // Fails when the reader doesn't exist (i.e. the receiver is disabled), which is fine.
+    std::ignore = rtp_audio_receiver_.set_asrc(id_, parameters);
+}
+
+void rav::RavennaReceiver::update_shared_buffer() {
+    const auto& audio_format = reader_parameters_.audio_format;
+    if (shared_buffer_ != nullptr && shared_buffer_->get_name() == configuration_.shared_buffer_name
+        && shared_buffer_->get_audio_format() == audio_format) {
+        // Fails when the reader doesn't exist (i.e. the receiver is disabled), which is fine.
+        std::ignore = rtp_audio_receiver_.set_shared_buffer(id_, shared_buffer_);
+        return;
+    }
+
+    // Releases the previous buffer first, so that its name can be used again.
+    std::ignore = rtp_audio_receiver_.set_shared_buffer(id_, nullptr);
+    shared_buffer_.reset();
+
+    if (configuration_.shared_buffer_name.empty() || !audio_format.is_valid()) {
+        return;
+    }
+
+    const auto capacity_frames = rtp::AudioReceiver::k_buffer_size_ms * audio_format.sample_rate / 1000;
+    shared_buffer_ = rtp::SharedAudioBuffer::create(configuration_.shared_buffer_name, audio_format, capacity_frames);
+    if (shared_buffer_ == nullptr) {
+        RAV_LOG_ERROR("Failed to create shared buffer {}", configuration_.shared_buffer_name);
+        return;
+    }
+
+    std::ignore = rtp_audio_receiver_.set_shared_buffer(id_, shared_buffer_);
 }
 
 rav::Id rav::RavennaReceiver::get_id() const {
@@ -360,6 +564,7 @@ tl::expected<void, std::string> rav::RavennaReceiver::set_configuration(Configur
     bool do_update_nmos = false;
     bool do_update_rtsp = false;
     bool do_stop_start = false;
+    bool do_update_reader = false;
 
     if (config.enabled != configuration_.enabled) {
         do_update_nmos = true;
@@ -376,22 +581,44 @@ tl::expected<void, std::string> rav::RavennaReceiver::set_configuration(Configur
         do_update_rtsp = true;
     }
 
+    const bool do_update_adaptive_delay =
+        config.adaptive_delay != configuration_.adaptive_delay || config.delay_frames != configuration_.delay_frames;
+    const bool do_update_asrc = config.asrc != configuration_.asrc || config.delay_frames != configuration_.delay_frames;
+    const bool do_update_shared_buffer = config.shared_buffer_name != configuration_.shared_buffer_name;
+
     // Apply the configuration changes
 
     configuration_ = std::move(config);
 
     auto parameters = create_rtp_receiver_parameters(configuration_.sdp);
     auto new_parameters = parameters.has_value() ? *parameters : rtp::AudioReceiver::ReaderParameters {};
+    new_parameters.share_ingest = configuration_.share_ingest;
 
-    if (std::exchange(reader_parameters_, new_parameters) != new_parameters) {
-        do_stop_start = true;
+    const auto previous_parameters = std::exchange(reader_parameters_, new_parameters);
+    if (previous_parameters != reader_parameters_) {
         do_update_nmos = true;
+        if (previous_parameters.audio_format == reader_parameters_.audio_format) {
+            do_update_reader = true;
+        } else {
+            do_stop_start = true;
+        }
 
         for (auto* subscriber : subscribers_) {
             subscriber->ravenna_receiver_parameters_updated(reader_parameters_);
         }
     }
 
+    if (do_update_reader && !do_stop_start) {
+        // Swap the sessions of the running reader, which keeps the buffered audio. Falls back to restarting the reader.
+        do_stop_start = !(
+            reader_parameters_.is_valid() && configuration_.enabled &&
+            rtp_audio_receiver_.update_reader(
+                id_, reader_parameters_,
+                network_interface_config_.get_array_of_interface_addresses<rtp::AudioReceiver::k_max_num_redundant_sessions>()
+            )
+        );
+    }
+
     if (do_stop_start) {
         std::ignore = rtp_audio_receiver_.remove_reader(id_);
 
@@ -406,6 +633,18 @@ tl::expected<void, std::string> rav::RavennaReceiver::set_configuration(Configur
         }
     }
 
+    if (do_stop_start || do_update_reader || do_update_adaptive_delay) {
+        update_adaptive_delay();
+    }
+
+    if (do_stop_start || do_update_asrc) {
+        update_asrc();
+    }
+
+    if (do_stop_start || do_update_shared_buffer) {
+        update_shared_buffer();
+    }
+
     if (!configuration_.auto_update_sdp) {
         configuration_.session_name = configuration_.sdp.session_name;
     }
@@ -581,6 +820,10 @@ void rav::tag_invoke(const boost::json::value_from_tag&, boost::json::value& jv,
         {"delay_frames", config.delay_frames},
         {"enabled", config.enabled},
         {"auto_update_sdp", config.auto_update_sdp},
+        {"adaptive_delay", config.adaptive_delay},
+        {"asrc", config.asrc},
+        {"shared_buffer_name", config.shared_buffer_name},
+        {"share_ingest", config.share_ingest},
         {"sdp", boost::json::value_from(sdp::to_string(config.sdp))}
     };
 }
@@ -592,6 +835,18 @@ rav::tag_invoke(const boost::json::value_to_tag<RavennaReceiver::Configuration>&
     config.delay_frames = jv.at("delay_frames").to_number<uint32_t>();
     config.enabled = jv.at("enabled").as_bool();
     config.auto_update_sdp = jv.at("auto_update_sdp").as_bool();
+    if (const auto* adaptive_delay = jv.as_object().if_contains("adaptive_delay")) {
+        config.adaptive_delay = adaptive_delay->as_bool();  // Optional for backwards compatibility
+    }
+    if (const auto* asrc = jv.as_object().if_contains("asrc")) {
+        config.asrc = asrc->as_bool();  // Optional for backwards compatibility
+    }
+    if (const auto* shared_buffer_name = jv.as_object().if_contains("shared_buffer_name")) {
+        config.shared_buffer_name = shared_buffer_name->as_string();  // Optional for backwards compatibility
+    }
+    if (const auto* share_ingest = jv.as_object().if_contains("share_ingest")) {
+        config.share_ingest = share_ingest->as_bool();  // Optional for backwards compatibility
+    }
 
     const auto sdp = jv.at("sdp");  // It is expected that the "sdp" field exists at all time.
     if (auto* str = sdp.if_string()) {
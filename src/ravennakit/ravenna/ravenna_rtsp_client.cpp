@@ -225,14 +225,20 @@ void rav::RavennaRtspClient::do_maintenance() {
 }
 
 void rav::RavennaRtspClient::handle_incoming_sdp(const std::string& sdp_text) {
-    auto sdp = sdp::parse_session_description(sdp_text);
-    if (!sdp) {
-        RAV_LOG_ERROR("Failed to parse SDP: {}", sdp.error());
+    auto sdp_view = sdp::parse_session_description_view(sdp_text);
+    if (!sdp_view) {
+        RAV_LOG_ERROR("Failed to parse SDP: {}", sdp_view.error());
         return;
     }
 
+    // Only build the owning representation when the SDP is for one of our sessions.
+    std::optional<sdp::SessionDescription> sdp;
+
     for (auto& session : sessions_) {
-        if (session.session_name == sdp->session_name) {
+        if (session.session_name == sdp_view->session_name) {
+            if (!sdp) {
+                sdp = sdp::to_session_description(*sdp_view);
+            }
             session.sdp_ = *sdp;
             session.sdp_text_ = sdp_text;
 
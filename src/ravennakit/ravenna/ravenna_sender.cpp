@@ -71,6 +71,16 @@ rav::RavennaSender::RavennaSender(
         return handle_patch_request(patch_request);
     };
 
+    nmos_sender_.on_scheduled_patch_request = [this](
+                                                  const boost::json::value& patch_request, const nmos::Timestamp& activation_time
+                                              ) -> tl::expected<void, nmos::ApiError> {
+        return handle_scheduled_patch_request(patch_request, activation_time);
+    };
+
+    nmos_sender_.on_cancel_scheduled_activation = [this] {
+        cancel_scheduled_activation();
+    };
+
     nmos_sender_.get_transport_file = [this]() -> tl::expected<sdp::SessionDescription, nmos::ApiError> {
         auto sdp = generate_sdp();
         if (!sdp) {
@@ -128,9 +138,7 @@ uint32_t rav::RavennaSender::get_session_id() const {
     return session_id_;
 }
 
-tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configuration config) {
-    // Validate the configuration
-
+tl::expected<void, std::string> rav::RavennaSender::validate_configuration(const Configuration& config) {
     if (config.session_name.empty()) {
         return tl::unexpected("Session name cannot be empty");
     }
@@ -176,13 +184,22 @@ tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configurat
         }
     }
 
+    return {};
+}
+
+tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configuration config) {
+    auto validated = validate_configuration(config);
+    if (!validated) {
+        return validated;
+    }
+
     // Determine changes
 
     bool do_update_advertisement = false;
     bool do_announce = false;
     bool do_update_nmos = false;
     bool do_restart_streaming = false;
-    bool do_update_ttl = false;
+    bool do_update_streaming = false;
 
     if (config.enabled != configuration_.enabled) {
         do_update_advertisement = true;
@@ -200,17 +217,17 @@ tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configurat
     if (config.destinations != configuration_.destinations) {
         do_announce = true;
         do_update_nmos = true;
-        do_restart_streaming = true;
+        do_update_streaming = true;
     }
 
     if (config.ttl != configuration_.ttl) {
         do_announce = true;
-        do_update_ttl = true;
+        do_update_streaming = true;
     }
 
     if (config.payload_type != configuration_.payload_type) {
         do_announce = true;
-        do_restart_streaming = true;
+        do_update_streaming = true;
     }
 
     if (config.audio_format != configuration_.audio_format) {
@@ -224,6 +241,9 @@ tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configurat
         do_restart_streaming = true;
     }
 
+    const bool do_update_shared_buffer =
+        config.shared_buffer_name != configuration_.shared_buffer_name || config.audio_format != configuration_.audio_format;
+
     if (network_interface_config_.interfaces.empty()) {
         do_announce = false;  // If there are no interfaces present it doesn't make sense to announce.
     }
@@ -234,13 +254,13 @@ tl::expected<void, std::string> rav::RavennaSender::set_configuration(Configurat
 
     generate_auto_addresses_if_needed(configuration_.destinations);
 
+    if (do_update_shared_buffer) {
+        update_shared_buffer();
+    }
     if (do_restart_streaming) {
         restart_streaming();
-    } else if (do_update_ttl) {
-        // If not restarting streaming (which would update TTL), update TTL directly to avoid a complete restart when only TTL changed.
-        if (!rtp_audio_sender_.set_ttl(id_, configuration_.ttl)) {
-            RAV_LOG_ERROR("Failed to update TTL");
-        }
+    } else if (do_update_streaming) {
+        update_streaming();
     }
     if (do_update_advertisement) {
         update_advertisement();
@@ -316,7 +336,7 @@ void rav::RavennaSender::set_network_interface_config(NetworkInterfaceConfig net
     }
     network_interface_config_ = std::move(network_interface_config);
     generate_auto_addresses_if_needed(true);
-    restart_streaming();
+    update_streaming();
     update_nmos();
 }
 
@@ -352,6 +372,18 @@ const rav::nmos::Sender& rav::RavennaSender::get_nmos_sender() const {
     return nmos_sender_;
 }
 
+void rav::RavennaSender::do_maintenance() {
+    update_scheduled_activation();
+
+    if (cost_throttle_.update()) {
+        if (auto cost = rtp_audio_sender_.get_writer_cost(id_)) {
+            for (auto* subscriber : subscribers_) {
+                subscriber->ravenna_sender_cost_updated(id_, *cost);
+            }
+        }
+    }
+}
+
 boost::json::object rav::RavennaSender::to_boost_json() const {
     return {
         {"session_id", session_id_},
@@ -404,21 +436,20 @@ void rav::RavennaSender::on_request(const rtsp::Connection::RequestEvent event)
         error_response.rtsp_headers.set(*cseq);
     }
 
-    const auto sdp = generate_sdp();  // Should the SDP be cached and updated on changes?
-    if (!sdp) {
-        RAV_LOG_ERROR("Failed to build SDP: {}", sdp.error());
+    const auto cached_sdp = get_cached_sdp();
+    if (!cached_sdp) {
+        RAV_LOG_ERROR("Failed to build SDP: {}", cached_sdp.error());
         event.rtsp_connection.async_send_response(error_response);
         return;
     }
 
-    // RAV_LOG_TRACE("SDP:\n{}", rav::sdp::to_string(*sdp, "\n").value_or("n/a"));
-
-    auto response = rtsp::Response(200, "OK", rav::sdp::to_string(*sdp).value_or("n/a"));
+    // Equal to encoding an rtsp::Response with the cseq and content-type headers and the SDP as data.
+    std::string response = (*cached_sdp)->describe_response_status_line;
     if (const auto* cseq = event.rtsp_request.rtsp_headers.get("cseq")) {
-        response.rtsp_headers.set(*cseq);
+        fmt::format_to(std::back_inserter(response), "{}: {}\r\n", cseq->name, cseq->value);
     }
-    response.rtsp_headers.set("content-type", "application/sdp");
-    event.rtsp_connection.async_send_response(response);
+    response += (*cached_sdp)->describe_response_remainder;
+    event.rtsp_connection.async_send_data(response);
 }
 
 void rav::RavennaSender::ptp_parent_changed(const ptp::ParentDs& parent) {
@@ -443,9 +474,9 @@ void rav::RavennaSender::send_announce() const {
         return;
     }
 
-    auto sdp = generate_sdp();
-    if (!sdp) {
-        RAV_LOG_ERROR("Failed to encode SDP: {}", sdp.error());
+    const auto cached_sdp = get_cached_sdp();
+    if (!cached_sdp) {
+        RAV_LOG_ERROR("Failed to encode SDP: {}", cached_sdp.error());
         return;
     }
 
@@ -454,7 +485,7 @@ void rav::RavennaSender::send_announce() const {
     rtsp::Request request;
     request.method = "ANNOUNCE";
     request.rtsp_headers.set("content-type", "application/sdp");
-    request.data = sdp::to_string(*sdp).value_or("n/a");
+    request.data = (*cached_sdp)->sdp;
     request.uri = Uri::encode("rtsp", interface_address_string + ":" + std::to_string(rtsp_server_.port()), rtsp_path_by_name_);
     std::ignore = rtsp_server_.send_request(rtsp_path_by_name_, request);
 
@@ -649,7 +680,10 @@ tl::expected<rav::sdp::SessionDescription, std::string> rav::RavennaSender::gene
 }
 
 void rav::RavennaSender::generate_auto_addresses_if_needed(const bool notify_subscribers) {
-    if (generate_auto_addresses_if_needed(configuration_.destinations) && notify_subscribers) {
+    if (!generate_auto_addresses_if_needed(configuration_.destinations)) {
+        return;
+    }
+    if (notify_subscribers) {
         for (auto* subscriber : subscribers_) {
             subscriber->ravenna_sender_configuration_updated(id_, configuration_);
         }
@@ -685,6 +719,39 @@ bool rav::RavennaSender::generate_auto_addresses_if_needed(std::vector<Destinati
     return changed;
 }
 
+rav::RavennaSender::SdpInputs rav::RavennaSender::get_sdp_inputs() const {
+    return {configuration_, session_id_, clock_domain_, grandmaster_identity_, network_interface_config_.get_interface_ipv4_addresses()};
+}
+
+tl::expected<const rav::RavennaSender::CachedSdp*, std::string> rav::RavennaSender::get_cached_sdp() const {
+    auto inputs = get_sdp_inputs();
+    if (cached_sdp_.has_value() && cached_sdp_->inputs == inputs) {
+        return &*cached_sdp_;
+    }
+
+    const auto sdp = generate_sdp();
+    if (!sdp) {
+        return tl::unexpected(sdp.error());
+    }
+
+    auto sdp_text = sdp::to_string(*sdp);
+    if (!sdp_text) {
+        return tl::unexpected("Failed to encode SDP");
+    }
+
+    rtsp::Response response(200, "OK", *sdp_text);
+    response.rtsp_headers.set("content-type", "application/sdp");
+    const auto encoded = response.encode();
+    const auto status_line_end = encoded.find("\r\n") + 2;
+
+    CachedSdp cached;
+    cached.inputs = std::move(inputs);
+    cached.sdp = std::move(*sdp_text);
+    cached.describe_response_status_line = encoded.substr(0, status_line_end);
+    cached.describe_response_remainder = encoded.substr(status_line_end);
+    return &cached_sdp_.emplace(std::move(cached));
+}
+
 void rav::RavennaSender::restart_streaming() const {
     std::ignore = rtp_audio_sender_.remove_writer(id_);
 
@@ -692,6 +759,52 @@ void rav::RavennaSender::restart_streaming() const {
         return;  // Done here
     }
 
+    const auto interfaces = network_interface_config_.get_array_of_interface_addresses<rtp::AudioSender::k_max_num_redundant_sessions>();
+    if (!rtp_audio_sender_.add_writer(id_, get_writer_parameters(), interfaces)) {
+        RAV_LOG_ERROR("Failed to add writer");
+        return;
+    }
+
+    if (shared_buffer_ != nullptr) {
+        if (!rtp_audio_sender_.set_shared_buffer(id_, shared_buffer_)) {
+            RAV_LOG_ERROR("Failed to set the shared buffer of the writer");
+        }
+    }
+}
+
+void rav::RavennaSender::update_shared_buffer() {
+    // Releases the previous buffer first, so that its name can be used again.
+    std::ignore = rtp_audio_sender_.set_shared_buffer(id_, nullptr);
+    shared_buffer_.reset();
+
+    if (configuration_.shared_buffer_name.empty() || !configuration_.audio_format.is_valid()) {
+        return;
+    }
+
+    shared_buffer_ =
+        rtp::SharedAudioBuffer::create(configuration_.shared_buffer_name, configuration_.audio_format, rtp::AudioSender::k_max_num_frames);
+    if (shared_buffer_ == nullptr) {
+        RAV_LOG_ERROR("Failed to create shared buffer {}", configuration_.shared_buffer_name);
+        return;
+    }
+
+    // Fails when the writer doesn't exist (i.e. the sender is disabled), in which case it's set when streaming starts.
+    std::ignore = rtp_audio_sender_.set_shared_buffer(id_, shared_buffer_);
+}
+
+void rav::RavennaSender::update_streaming() const {
+    if (!configuration_.enabled) {
+        return;  // Not streaming
+    }
+
+    const auto interfaces = network_interface_config_.get_array_of_interface_addresses<rtp::AudioSender::k_max_num_redundant_sessions>();
+    if (!rtp_audio_sender_.update_writer(id_, get_writer_parameters(), interfaces)) {
+        RAV_LOG_TRACE("Failed to update writer in place, restarting streaming");
+        restart_streaming();
+    }
+}
+
+rav::rtp::AudioSender::WriterParameters rav::RavennaSender::get_writer_parameters() const {
     rtp::AudioSender::WriterParameters params;
     params.audio_format = configuration_.audio_format;
     params.packet_time_frames = configuration_.packet_time.framecount(configuration_.audio_format.sample_rate);
@@ -702,17 +815,79 @@ void rav::RavennaSender::restart_streaming() const {
             params.destinations[dst.interface_by_rank] = dst.endpoint;
         }
     }
-    const auto interfaces = network_interface_config_.get_array_of_interface_addresses<rtp::AudioSender::k_max_num_redundant_sessions>();
-    if (!rtp_audio_sender_.add_writer(id_, params, interfaces)) {
-        RAV_LOG_ERROR("Failed to add writer");
-    }
+    return params;
 }
 
 tl::expected<void, rav::nmos::ApiError> rav::RavennaSender::handle_patch_request(const boost::json::value& patch_request) {
+    auto configuration = get_configuration_from_patch_request(patch_request);
+    if (!configuration) {
+        return tl::unexpected(configuration.error());
+    }
+
     if (const auto result = patch_request.try_at("receiver_id")) {
         nmos_sender_.subscription.receiver_id = uuid_from_json(*result);
     }
 
+    if (auto t = set_configuration(std::move(*configuration)); !t) {
+        return tl::unexpected(nmos::ApiError {http::status::internal_server_error, t.error()});
+    }
+
+    return {};
+}
+
+tl::expected<void, rav::nmos::ApiError> rav::RavennaSender::handle_scheduled_patch_request(
+    const boost::json::value& patch_request, const nmos::Timestamp& activation_time
+) {
+    auto configuration = get_configuration_from_patch_request(patch_request);
+    if (!configuration) {
+        return tl::unexpected(configuration.error());
+    }
+
+    // Over NMOS only the enabled state and the receiver can change, both of which are applied from the maintenance loop once the
+    // activation time has passed.
+    ScheduledActivation scheduled;
+    scheduled.configuration = std::move(*configuration);
+    scheduled.receiver_id = nmos_sender_.subscription.receiver_id;
+    if (const auto result = patch_request.try_at("receiver_id")) {
+        scheduled.receiver_id = uuid_from_json(*result);
+    }
+    scheduled.activation_time = activation_time;
+    scheduled_activation_ = std::move(scheduled);
+    return {};
+}
+
+void rav::RavennaSender::cancel_scheduled_activation() {
+    scheduled_activation_.reset();
+    nmos_sender_.staged_activation = {};
+}
+
+void rav::RavennaSender::update_scheduled_activation() {
+    if (!scheduled_activation_.has_value()) {
+        return;
+    }
+
+    const auto now = get_local_clock().now();
+    if (now < ptp::Timestamp(scheduled_activation_->activation_time.seconds, scheduled_activation_->activation_time.nanoseconds)) {
+        return;
+    }
+
+    auto scheduled = std::move(*scheduled_activation_);
+    scheduled_activation_.reset();
+
+    nmos_sender_.subscription.receiver_id = scheduled.receiver_id;
+    nmos_sender_.active_activation = nmos_sender_.staged_activation;
+    nmos_sender_.active_activation.activation_time = nmos::Timestamp(now);
+    nmos_sender_.staged_activation = {};
+
+    if (auto result = set_configuration(std::move(scheduled.configuration)); !result) {
+        RAV_LOG_ERROR("Failed to apply scheduled activation: {}", result.error());
+    }
+
+    update_nmos();
+}
+
+tl::expected<rav::RavennaSender::Configuration, rav::nmos::ApiError>
+rav::RavennaSender::get_configuration_from_patch_request(const boost::json::value& patch_request) const {
     auto configuration = configuration_;
     if (const auto result = patch_request.try_at("master_enable")) {
         configuration.enabled = boost::json::value_to<bool>(*result);
@@ -753,11 +928,7 @@ tl::expected<void, rav::nmos::ApiError> rav::RavennaSender::handle_patch_request
         }
     }
 
-    if (auto t = set_configuration(configuration); !t) {
-        return tl::unexpected(nmos::ApiError {http::status::internal_server_error, t.error()});
-    }
-
-    return {};
+    return configuration;
 }
 
 void rav::RavennaSender::register_dnssd_session_advertisement() {
@@ -787,6 +958,7 @@ void rav::tag_invoke(const boost::json::value_from_tag&, boost::json::value& jv,
         {"packet_time", boost::json::value_from(config.packet_time)},
         {"audio_format", boost::json::value_from(config.audio_format)},
         {"enabled", config.enabled},
+        {"shared_buffer_name", config.shared_buffer_name},
     };
 }
 
@@ -812,6 +984,9 @@ rav::tag_invoke(const boost::json::value_to_tag<RavennaSender::Configuration>&,
     config.packet_time = boost::json::value_to<aes67::PacketTime>(jv.at("packet_time"));
     config.audio_format = boost::json::value_to<AudioFormat>(jv.at("audio_format"));
     config.enabled = jv.at("enabled").as_bool();
+    if (const auto* shared_buffer_name = jv.as_object().if_contains("shared_buffer_name")) {
+        config.shared_buffer_name = shared_buffer_name->as_string();  // Optional for backwards compatibility
+    }
 
     return config;
 }
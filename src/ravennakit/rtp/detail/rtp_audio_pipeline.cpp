@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_audio_pipeline.hpp"
+
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/types/int24.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+/// Reads and writes big endian samples. Matches the conversions of AudioData::convert_sample bit for bit.
+template<class T>
+struct Sample;
+
+template<>
+struct Sample<int16_t> {
+    static constexpr size_t k_size = 2;
+
+    static float decode(const uint8_t* data) {
+        const auto value = static_cast<int16_t>(static_cast<uint16_t>(data[0] << 8 | data[1]));
+        return static_cast<float>(value) * 0.000030517578125f;
+    }
+
+    static void encode(const float sample, uint8_t* data) {
+        const auto value = static_cast<uint16_t>(static_cast<int16_t>(std::clamp(sample, -1.0f, 1.0f) * 32767.f));
+        data[0] = static_cast<uint8_t>(value >> 8);
+        data[1] = static_cast<uint8_t>(value);
+    }
+};
+
+template<>
+struct Sample<rav::int24_t> {
+    static constexpr size_t k_size = 3;
+
+    static float decode(const uint8_t* data) {
+        const auto value = static_cast<int32_t>(
+                               static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 |
+                               static_cast<uint32_t>(data[2]) << 8
+                           ) >>
+            8;
+        return static_cast<float>(value) * 0.00000011920928955078125f;
+    }
+
+    static void encode(const float sample, uint8_t* data) {
+        const auto value = static_cast<uint32_t>(static_cast<int32_t>(std::clamp(sample, -1.0f, 1.0f) * 8388607.f));
+        data[0] = static_cast<uint8_t>(value >> 16);
+        data[1] = static_cast<uint8_t>(value >> 8);
+        data[2] = static_cast<uint8_t>(value);
+    }
+};
+
+/// Decodes channel by channel so that the writes are contiguous.
+template<class T>
+void decode_samples_generic(const uint8_t* src, const size_t num_frames, const size_t num_channels, float* const* dst) {
+    const size_t stride = num_channels * Sample<T>::k_size;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+        const auto* channel_src = src + ch * Sample<T>::k_size;
+        auto* channel_dst = dst[ch];
+        for (size_t frame = 0; frame < num_frames; ++frame) {
+            channel_dst[frame] = Sample<T>::decode(channel_src + frame * stride);
+        }
+    }
+}
+
+template<class T>
+void encode_samples_generic(const float* const* src, const size_t num_frames, const size_t num_channels, uint8_t* dst) {
+    const size_t stride = num_channels * Sample<T>::k_size;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+        const auto* channel_src = src[ch];
+        auto* channel_dst = dst + ch * Sample<T>::k_size;
+        for (size_t frame = 0; frame < num_frames; ++frame) {
+            Sample<T>::encode(channel_src[frame], channel_dst + frame * stride);
+        }
+    }
+}
+
+/// The number of channels which the specialized pipelines convert at once. Larger frames are split into groups of this
+/// size, which keeps the unrolled loops small.
+constexpr size_t k_channel_group_size = 16;
+
+/// Decodes frame by frame. Since the frame size is a compile time constant, the samples of a group of channels are read
+/// contiguously in an unrolled loop and then distributed over the channels.
+template<class T, size_t NumChannels>
+void decode_samples(const uint8_t* src, const size_t num_frames, const size_t num_channels, float* const* dst) {
+    RAV_ASSERT_DEBUG(NumChannels == num_channels, "Channel count mismatch");
+
+    if constexpr (sizeof(T) == 2 && NumChannels >= 8) {
+        // Reading 16 bit samples per channel vectorizes better than reading them per frame, so wider frames take the
+        // channel major loop. Passing the channel count as a constant makes the compiler unroll that loop, which measured
+        // slower, hence the runtime value.
+        decode_samples_generic<T>(src, num_frames, num_channels, dst);
+        return;
+    }
+    std::ignore = num_channels;
+
+    constexpr auto k_group_size = std::min(NumChannels, k_channel_group_size);
+    static_assert(NumChannels % k_group_size == 0);
+
+    for (size_t group = 0; group < NumChannels; group += k_group_size) {
+        std::array<float*, k_group_size> channels {};
+        std::copy_n(dst + group, k_group_size, channels.begin());
+
+        for (size_t frame = 0; frame < num_frames; ++frame) {
+            std::array<float, k_group_size> samples {};
+            const auto* frame_src = src + (frame * NumChannels + group) * Sample<T>::k_size;
+            for (size_t ch = 0; ch < k_group_size; ++ch) {
+                samples[ch] = Sample<T>::decode(frame_src + ch * Sample<T>::k_size);
+            }
+            for (size_t ch = 0; ch < k_group_size; ++ch) {
+                channels[ch][frame] = samples[ch];
+            }
+        }
+    }
+}
+
+template<class T, size_t NumChannels>
+void encode_samples(const float* const* src, const size_t num_frames, const size_t num_channels, uint8_t* dst) {
+    RAV_ASSERT_DEBUG(NumChannels == num_channels, "Channel count mismatch");
+    std::ignore = num_channels;
+
+    constexpr auto k_group_size = std::min(NumChannels, k_channel_group_size);
+    static_assert(NumChannels % k_group_size == 0);
+
+    for (size_t group = 0; group < NumChannels; group += k_group_size) {
+        std::array<const float*, k_group_size> channels {};
+        std::copy_n(src + group, k_group_size, channels.begin());
+
+        for (size_t frame = 0; frame < num_frames; ++frame) {
+            std::array<float, k_group_size> samples {};
+            for (size_t ch = 0; ch < k_group_size; ++ch) {
+                samples[ch] = channels[ch][frame];
+            }
+            auto* frame_dst = dst + (frame * NumChannels + group) * Sample<T>::k_size;
+            for (size_t ch = 0; ch < k_group_size; ++ch) {
+                Sample<T>::encode(samples[ch], frame_dst + ch * Sample<T>::k_size);
+            }
+        }
+    }
+}
+
+struct PipelineEntry {
+    uint32_t num_channels;
+    rav::rtp::AudioPipeline pipeline;
+};
+
+template<class T, size_t... Is>
+constexpr std::array<PipelineEntry, sizeof...(Is)> make_pipeline_table(std::index_sequence<Is...>) {
+    constexpr auto& channels = rav::rtp::AudioPipeline::k_specialized_num_channels;
+    return {{
+        {channels[Is], {&decode_samples<T, channels[Is]>, &encode_samples<T, channels[Is]>, true}}...,
+    }};
+}
+
+template<class T>
+rav::rtp::AudioPipeline generic_pipeline() {
+    return {&decode_samples_generic<T>, &encode_samples_generic<T>, false};
+}
+
+template<class T>
+rav::rtp::AudioPipeline find_pipeline(const uint32_t num_channels) {
+    static constexpr auto k_table =
+        make_pipeline_table<T>(std::make_index_sequence<rav::rtp::AudioPipeline::k_specialized_num_channels.size()>());
+    for (auto& entry : k_table) {
+        if (entry.num_channels == num_channels) {
+            return entry.pipeline;
+        }
+    }
+    return generic_pipeline<T>();
+}
+
+}  // namespace
+
+rav::rtp::AudioPipeline rav::rtp::AudioPipeline::get(const AudioFormat& format) {
+    switch (format.encoding) {
+        case AudioEncoding::pcm_s16:
+            return find_pipeline<int16_t>(format.num_channels);
+        case AudioEncoding::pcm_s24:
+            return find_pipeline<int24_t>(format.num_channels);
+        case AudioEncoding::undefined:
+        case AudioEncoding::pcm_s8:
+        case AudioEncoding::pcm_u8:
+        case AudioEncoding::pcm_s32:
+        case AudioEncoding::pcm_f32:
+        case AudioEncoding::pcm_f64:
+        default:
+            return {};
+    }
+}
+
+rav::rtp::AudioPipeline rav::rtp::AudioPipeline::get_generic(const AudioFormat& format) {
+    switch (format.encoding) {
+        case AudioEncoding::pcm_s16:
+            return generic_pipeline<int16_t>();
+        case AudioEncoding::pcm_s24:
+            return generic_pipeline<int24_t>();
+        case AudioEncoding::undefined:
+        case AudioEncoding::pcm_s8:
+        case AudioEncoding::pcm_u8:
+        case AudioEncoding::pcm_s32:
+        case AudioEncoding::pcm_f32:
+        case AudioEncoding::pcm_f64:
+        default:
+            return {};
+    }
+}
@@ -26,7 +26,7 @@
 
 #include "ravennakit/core/clock.hpp"
 #include "ravennakit/core/log.hpp"
-#include "ravennakit/core/audio/audio_data.hpp"
+#include "ravennakit/core/realtime_log.hpp"
 #include "ravennakit/core/net/sockets/extended_udp_socket.hpp"
 #include "ravennakit/rtp/rtcp_packet_view.hpp"
 #include "ravennakit/core/util/subscriber_list.hpp"
@@ -35,6 +35,8 @@
 #include "ravennakit/core/util/defer.hpp"
 
 #include <fmt/core.h>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace {
@@ -58,6 +60,35 @@ namespace {
     return true;
 }
 
+/// Updates the number of reader and socket slots which the network and audio threads visit, which is one past the last
+/// slot in use. Must be called by the control thread after a slot was taken into use or released.
+void update_slots_in_use(rav::rtp::AudioReceiver& receiver) {
+    auto num_readers = receiver.readers.size();
+    while (num_readers > 0 && !receiver.readers[num_readers - 1].id.is_valid()) {
+        num_readers--;
+    }
+    auto num_sockets = receiver.sockets.size();
+    while (num_sockets > 0 && !receiver.sockets[num_sockets - 1].socket.is_open()) {
+        num_sockets--;
+    }
+    receiver.num_reader_slots_in_use.store(num_readers, std::memory_order_release);
+    receiver.num_socket_slots_in_use.store(num_sockets, std::memory_order_release);
+}
+
+/// Updates which readers are tapped by other readers. Must be called by the control thread after the source of a reader
+/// was set or changed.
+void update_has_taps(rav::rtp::AudioReceiver& receiver) {
+    std::array<bool, rav::rtp::AudioReceiver::k_max_num_readers> has_taps {};
+    for (const auto& reader : receiver.readers) {
+        if (reader.source != nullptr) {
+            has_taps[static_cast<size_t>(reader.source - receiver.readers.data())] = true;
+        }
+    }
+    for (size_t i = 0; i < receiver.readers.size(); ++i) {
+        receiver.readers[i].has_taps.store(has_taps[i], std::memory_order_relaxed);
+    }
+}
+
 [[nodiscard]] boost::asio::ip::udp::socket* find_socket(rav::rtp::AudioReceiver& receiver, const uint16_t port) {
     // Try to find existing socket
     for (auto& ctx : receiver.sockets) {
@@ -68,12 +99,19 @@ namespace {
     return nullptr;
 }
 
-[[nodiscard]] boost::asio::ip::udp::socket* find_or_create_socket(rav::rtp::AudioReceiver& receiver, const uint16_t port) {
+[[nodiscard]] boost::asio::ip::udp::socket*
+find_or_create_socket(rav::rtp::AudioReceiver& receiver, const uint16_t port, const size_t shard) {
     RAV_ASSERT(port > 0, "Port should be non zero");
 
     // Try to find existing socket
-    if (auto* found = find_socket(receiver, port)) {
-        return found;
+    for (auto& ctx : receiver.sockets) {
+        if (ctx.port == port) {
+            if (ctx.shard != shard) {
+                RAV_LOG_ERROR("Socket for port {} belongs to shard {} instead of shard {}", port, ctx.shard, shard);
+                return nullptr;
+            }
+            return &ctx.socket;
+        }
     }
 
     // Try to reuse existing socket slot
@@ -91,13 +129,70 @@ namespace {
             return nullptr;
         }
         RAV_ASSERT(ctx.socket.is_open(), "Socket expected to be open at this point");
+        if (receiver.packet_mmap_options.has_value() && !rav::rtp::attach_drop_all_filter(ctx.socket)) {
+            RAV_LOG_WARNING("Failed to attach drop filter to the socket for port {}", port);
+        }
         ctx.port = port;
+        ctx.shard = shard;
+        ctx.generation++;
+        ctx.receive_cost.reset();
+        update_slots_in_use(receiver);
         return &ctx.socket;
     }
 
     return nullptr;
 }
 
+/// @return True if the socket for given port doesn't exist yet or is read by given shard.
+[[nodiscard]] bool is_port_available_in_shard(const rav::rtp::AudioReceiver& receiver, const uint16_t port, const size_t shard) {
+    for (auto& ctx : receiver.sockets) {
+        if (ctx.port == port) {
+            return ctx.shard == shard;
+        }
+    }
+    return true;
+}
+
+/// Selects the shard for a new reader. Readers sharing an RTP port must be in the same shard because the socket of a
+/// port is read by a single network thread. Otherwise, the shard with the fewest readers is chosen.
+[[nodiscard]] std::optional<size_t>
+select_shard(const rav::rtp::AudioReceiver& receiver, const rav::rtp::AudioReceiver::ReaderParameters& parameters) {
+    std::optional<size_t> required_shard;
+    for (auto& stream : parameters.streams) {
+        if (!stream.session.valid()) {
+            continue;
+        }
+        for (auto& ctx : receiver.sockets) {
+            if (ctx.port != stream.session.rtp_port) {
+                continue;
+            }
+            if (required_shard.has_value() && *required_shard != ctx.shard) {
+                return std::nullopt;  // The ports of the streams are read by different shards
+            }
+            required_shard = ctx.shard;
+        }
+    }
+
+    if (required_shard.has_value()) {
+        return required_shard;
+    }
+
+    std::array<size_t, rav::rtp::AudioReceiver::k_max_num_shards> num_readers {};
+    for (auto& reader : receiver.readers) {
+        if (reader.id.is_valid()) {
+            num_readers[reader.shard]++;
+        }
+    }
+
+    size_t shard = 0;
+    for (size_t i = 1; i < receiver.num_shards; ++i) {
+        if (num_readers[i] < num_readers[shard]) {
+            shard = i;
+        }
+    }
+    return shard;
+}
+
 [[nodiscard]] uint32_t count_multicast_groups(
     rav::rtp::AudioReceiver& receiver, const boost::asio::ip::address_v4& multicast_group,
     const boost::asio::ip::address_v4& interface_address, const uint16_t port
@@ -125,34 +220,194 @@ namespace {
     return total;
 }
 
+/// Resets the state which the network thread derives from the received packets.
+void reset_stream_statistics(rav::rtp::AudioReceiver::StreamContext& stream) {
+    stream.rtp_ts = {};
+    stream.packet_stats.reset();
+    stream.packet_stats_counters.write({});
+    stream.packet_interval_stats = {};
+    stream.prev_packet_time_ns = {};
+    stream.network_thread_metrics.reset();
+    stream.receive_latency_min_max_ms.reset();
+    stream.jitter_frames.store(0, std::memory_order_relaxed);
+}
+
 void reset_stream_context(rav::rtp::AudioReceiver::StreamContext& stream) {
     stream.session = {};
     stream.filter = {};
+    stream.packet_time_frames = {};
     stream.interface = {};
-    stream.rtp_ts = {};
     stream.packets.reset();
     stream.packets_too_old.reset();
-    stream.packet_stats.reset();
-    stream.packet_stats_counters.write({});
-    stream.packet_interval_stats = {};
-    stream.prev_packet_time_ns = {};
+    reset_stream_statistics(stream);
 }
 
 void reset_reader(rav::rtp::AudioReceiver::Reader& reader) {
     reader.id = {};
     reader.audio_format = {};
+    reader.pipeline = {};
+    reader.packet_time_frames = {};
+    reader.shard = {};
     for (auto& stream : reader.streams) {
         reset_stream_context(stream);
     }
+    reader.source = nullptr;
+    reader.share_ingest = false;
+    reader.shared_buffer.reset();
     reader.receive_buffer.clear();
     reader.read_audio_data_buffer = {};
+    reader.skipped_frame = {};
     reader.most_recent_ts = {};
     reader.next_ts_to_read = {};
+    reader.audio_thread_metrics.reset();
+    reader.adaptive_delay.reset();
+    reader.adaptive_delay_parameters.write(std::nullopt);
+    reader.asrc.reset();
+    reader.asrc.resampler = {};
+    reader.asrc_parameters.write(std::nullopt);
+    reader.tap_started = false;
+    reader.resync_pending = false;
+    reader.resync_request.write(false);
+    reader.scheduled_activation.reset();
+    reader.scheduled_activation_request.write(std::nullopt);
+    reader.activation.store(rav::rtp::AudioReceiver::Activation::active, std::memory_order_release);
+    reader.activated_at.store(0, std::memory_order_relaxed);
+}
+
+/// @return True if given reader is the slot of given id which is read by the audio thread.
+bool is_active_reader(const rav::rtp::AudioReceiver::Reader& reader, const rav::Id id) {
+    return reader.id == id && reader.activation.load(std::memory_order_acquire) == rav::rtp::AudioReceiver::Activation::active;
+}
+
+/// Opens the socket for the session of given stream and joins the multicast group if it wasn't joined already.
+void open_stream(rav::rtp::AudioReceiver& receiver, const rav::rtp::AudioReceiver::StreamContext& stream, const size_t shard) {
+    if (!stream.session.valid()) {
+        return;
+    }
+
+    auto* socket = find_or_create_socket(receiver, stream.session.rtp_port, shard);
+    if (socket == nullptr) {
+        RAV_LOG_ERROR("Failed to create receive socket");
+        return;
+    }
+
+    if (receiver.pending_reader_updates.has_value()) {
+        return;  // The multicast groups of a batch are joined by commit_reader_updates
+    }
+
+    if (stream.session.connection_address.is_multicast()) {
+        if (!stream.interface.is_unspecified()) {
+            const auto count =
+                count_multicast_groups(receiver, stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port);
+            if (count == 1) {  // 1 because the stream being opened is also counted
+                if (!receiver.join_multicast_group(*socket, stream.session.connection_address.to_v4(), stream.interface)) {
+                    RAV_LOG_ERROR("Failed to join multicast group");
+                }
+            }
+        }
+    }
+}
+
+/// Moves the buffers of given reader to given arena, releasing the buffers which were allocated elsewhere. Without an
+/// arena the buffers are allocated on the heap.
+void set_reader_allocator(rav::rtp::AudioReceiver::Reader& reader, rav::MemoryArena* arena) {
+    const rav::ArenaAllocator<uint8_t> allocator(arena);
+    reader.receive_buffer.set_allocator(allocator);
+    if (reader.read_audio_data_buffer.get_allocator() != allocator) {
+        reader.read_audio_data_buffer = rav::ArenaVector<uint8_t>(allocator);
+    }
+    for (auto& stream : reader.streams) {
+        stream.packets.set_allocator(rav::ArenaAllocator<rav::rtp::AudioReceiver::PacketBuffer>(arena));
+        stream.packets_too_old.set_allocator(rav::ArenaAllocator<uint16_t>(arena));
+    }
+}
+
+/// @return True if given stream receives given session already.
+[[nodiscard]] bool is_stream_unchanged(
+    const rav::rtp::AudioReceiver::StreamContext& stream, const rav::rtp::AudioReceiver::StreamInfo& info,
+    const boost::asio::ip::address_v4& interface
+) {
+    const rav::rtp::AudioReceiver::StreamInfo current {stream.session, stream.filter, stream.packet_time_frames};
+    return current == info && stream.interface == interface;
+}
+
+/// Allocates the packet fifos of the streams of given reader.
+void allocate_packet_fifos(rav::rtp::AudioReceiver::Reader& reader) {
+    const auto buffer_size_frames = std::max(reader.audio_format.sample_rate * rav::rtp::AudioReceiver::k_buffer_size_ms / 1000, 1024u);
+    const auto buffer_size_packets = buffer_size_frames / reader.packet_time_frames;
+    for (auto& stream : reader.streams) {
+        // Also allocate the fifos of unused streams, so that a session can be added later without reallocating.
+        stream.packets.resize(buffer_size_packets);
+        stream.packets_too_old.resize(buffer_size_packets);
+    }
+}
+
+/// Allocates the receive buffer and the packet fifos of given reader, which receives the packets of its streams itself.
+void allocate_ingest(rav::rtp::AudioReceiver::Reader& reader) {
+    reader.receive_buffer.clear();
+    reader.receive_buffer.resize(
+        reader.audio_format.sample_rate * rav::rtp::AudioReceiver::k_buffer_size_ms / 1000, reader.audio_format.bytes_per_frame()
+    );
+    allocate_packet_fifos(reader);
+}
+
+/// Releases the receive buffer and the packet fifos of given reader, which taps the ingest of another reader.
+void release_ingest(rav::rtp::AudioReceiver::Reader& reader) {
+    reader.receive_buffer.release();
+    for (auto& stream : reader.streams) {
+        stream.packets.release();
+        stream.packets_too_old.release();
+    }
+}
+
+/// @return An active reader in given shard which receives given streams already, of which a new reader can share the
+/// ingest, or nullptr if there is none.
+[[nodiscard]] rav::rtp::AudioReceiver::Reader* find_source(
+    rav::rtp::AudioReceiver& receiver, const rav::rtp::AudioReceiver::ReaderParameters& parameters,
+    const rav::rtp::AudioReceiver::ArrayOfAddresses& interfaces, const size_t shard
+) {
+    if (!parameters.share_ingest) {
+        return nullptr;
+    }
+    for (auto& reader : receiver.readers) {
+        if (!reader.id.is_valid() || !reader.share_ingest || reader.source != nullptr || reader.shard != shard) {
+            continue;
+        }
+        if (reader.activation.load(std::memory_order_acquire) != rav::rtp::AudioReceiver::Activation::active) {
+            continue;  // The slots of a scheduled update come and go
+        }
+        if (reader.audio_format != parameters.audio_format) {
+            continue;
+        }
+        if (receiver.pending_reader_updates.has_value()) {
+            const auto& pending = *receiver.pending_reader_updates;
+            if (std::any_of(pending.begin(), pending.end(), [&reader](const rav::rtp::AudioReceiver::ReaderUpdate& update) {
+                    return update.id == reader.id;
+                })) {
+                continue;  // The streams are about to change
+            }
+        }
+
+        bool unchanged = true;
+        for (size_t i = 0; i < reader.streams.size(); ++i) {
+            if (!is_stream_unchanged(reader.streams[i], parameters.streams[i], interfaces[i])) {
+                unchanged = false;
+                break;
+            }
+        }
+        if (unchanged) {
+            return &reader;
+        }
+    }
+    return nullptr;
 }
 
+/// Sets up given reader for given parameters. When a source is given, the reader taps the ingest of the source instead of
+/// allocating its own.
 [[nodiscard]] bool setup_reader(
     rav::rtp::AudioReceiver& receiver, rav::rtp::AudioReceiver::Reader& reader, const rav::Id id,
-    const rav::rtp::AudioReceiver::ReaderParameters& parameters, const rav::rtp::AudioReceiver::ArrayOfAddresses& interfaces
+    const rav::rtp::AudioReceiver::ReaderParameters& parameters, const rav::rtp::AudioReceiver::ArrayOfAddresses& interfaces,
+    const size_t shard, rav::rtp::AudioReceiver::Reader* source = nullptr
 ) {
     RAV_ASSERT(parameters.streams.size() == interfaces.size(), "Unequal size");
     RAV_ASSERT(parameters.audio_format.is_valid(), "Invalid format");
@@ -175,6 +430,9 @@ void reset_reader(rav::rtp::AudioReceiver::Reader& reader) {
     }
 
     reader.id = id;
+    reader.shard = shard;
+    reader.share_ingest = parameters.share_ingest;
+    update_slots_in_use(receiver);
 
     for (size_t i = 0; i < reader.streams.size(); ++i) {
         reset_stream_context(reader.streams[i]);
@@ -185,7 +443,8 @@ void reset_reader(rav::rtp::AudioReceiver::Reader& reader) {
     }
 
     reader.audio_format = parameters.audio_format;
-    reader.receive_buffer.clear();
+    reader.pipeline = rav::rtp::AudioPipeline::get(parameters.audio_format);
+    set_reader_allocator(reader, receiver.memory_arena.get());
 
     // Find the smallest packet time frames
     uint16_t packet_time_frames = std::numeric_limits<uint16_t>::max();
@@ -199,43 +458,48 @@ void reset_reader(rav::rtp::AudioReceiver::Reader& reader) {
     RAV_ASSERT(bytes_per_frame > 0, "bytes_per_frame must be greater than 0");
 
     const auto buffer_size_frames = std::max(reader.audio_format.sample_rate * rav::rtp::AudioReceiver::k_buffer_size_ms / 1000, 1024u);
-    reader.receive_buffer.resize(reader.audio_format.sample_rate * rav::rtp::AudioReceiver::k_buffer_size_ms / 1000, bytes_per_frame);
-
     reader.read_audio_data_buffer.resize(buffer_size_frames * bytes_per_frame);
-    const auto buffer_size_packets = buffer_size_frames / packet_time_frames;
+    reader.skipped_frame.resize(reader.audio_format.num_channels, 1);
+    // Also allocate the resampler when the ASRC is disabled, so that it can be enabled later without reallocating.
+    reader.asrc.resampler.resize(
+        reader.audio_format.num_channels, rav::rtp::AudioReceiver::k_asrc_block_frames,
+        1.0 + rav::rtp::AudioReceiver::k_asrc_max_deviation_ppm * 1e-6, rav::ArenaAllocator<float>(receiver.memory_arena.get())
+    );
+    reader.packet_time_frames = packet_time_frames;
+
+    // A tap keeps the sessions of its streams, which account for the multicast groups and sockets it relies on.
+    reader.source = source;
+    if (source != nullptr) {
+        release_ingest(reader);
+    } else {
+        allocate_ingest(reader);
+    }
+    update_has_taps(receiver);
 
     for (auto& stream : reader.streams) {
-        if (!stream.session.valid()) {
-            stream.packets.reset();
-            stream.packets_too_old.reset();
-            continue;
-        }
-
-        stream.packets.resize(buffer_size_packets);
-        stream.packets_too_old.resize(buffer_size_packets);
-
-        const auto endpoint = boost::asio::ip::udp::endpoint(stream.session.connection_address, stream.session.rtp_port);
+        open_stream(receiver, stream, shard);
+    }
 
-        auto* socket = find_or_create_socket(receiver, endpoint.port());
-        if (socket == nullptr) {
-            RAV_LOG_ERROR("Failed to create receive socket");
-            continue;
-        }
+    return true;
+}
 
-        if (stream.session.connection_address.is_multicast()) {
-            if (!stream.interface.is_unspecified()) {
-                const auto count =
-                    count_multicast_groups(receiver, stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port);
-                if (count == 1) {  // 1 because the current reader being set up is also counted
-                    if (!receiver.join_multicast_group(*socket, stream.session.connection_address.to_v4(), stream.interface)) {
-                        RAV_LOG_ERROR("Failed to join multicast group");
-                    }
-                }
+/// Leaves given multicast group on the socket of given port.
+void leave_multicast_group_on_port(
+    rav::rtp::AudioReceiver& receiver, const boost::asio::ip::address_v4& multicast_address,
+    const boost::asio::ip::address_v4& interface_address, const uint16_t port
+) {
+    for (auto& socket : receiver.sockets) {
+        if (socket.port == port) {
+            RAV_ASSERT(socket.socket.is_open(), "Socket is not open");
+            // Note: not locking the rw_lock here as joining and leaving a multicast group should be thread safe, and we
+            // don't want to interrupt the call to read_incoming_packets().
+            if (!receiver.leave_multicast_group(socket.socket, multicast_address, interface_address)) {
+                RAV_LOG_ERROR(
+                    "Failed to leave multicast group {}:{} on {}", multicast_address.to_string(), port, interface_address.to_string()
+                );
             }
         }
     }
-
-    return true;
 }
 
 /// Leaves given multicast group if last.
@@ -253,22 +517,221 @@ void reset_reader(rav::rtp::AudioReceiver::Reader& reader) {
         return false;
     }
 
-    for (auto& socket : receiver.sockets) {
-        if (socket.port == port) {
-            RAV_ASSERT(socket.socket.is_open(), "Socket is not open");
-            // Note: not locking the rw_lock here as joining and leaving a multicast group should be thread safe, and we
-            // don't want to interrupt the call to read_incoming_packets().
-            if (!receiver.leave_multicast_group(socket.socket, multicast_address, interface_address)) {
-                RAV_LOG_ERROR(
-                    "Failed to leave multicast group {}:{} on {}", multicast_address.to_string(), port, interface_address.to_string()
+    leave_multicast_group_on_port(receiver, multicast_address, interface_address, port);
+    return true;
+}
+
+/// @return The timestamp of the first frame of the most recent packet received by given reader, which is where a tap
+/// starts reading.
+rav::WrappingUint32 get_tap_start(const rav::rtp::AudioReceiver::Reader& ingest) {
+    RAV_ASSERT_DEBUG(ingest.most_recent_ts.has_value(), "Expecting data to be received");
+    return *ingest.most_recent_ts - static_cast<uint32_t>(ingest.packet_time_frames - 1);
+}
+
+/// Moves the ingest of given source, including the packets which were not consumed yet and the state of the streams, to
+/// given reader which taps it. Both readers must be locked exclusively.
+void take_over_ingest(rav::rtp::AudioReceiver::Reader& tap, rav::rtp::AudioReceiver::Reader& source) {
+    RAV_ASSERT(tap.source == &source, "Expecting the reader to tap the source");
+
+    std::swap(tap.receive_buffer, source.receive_buffer);
+    allocate_packet_fifos(tap);
+
+    for (size_t i = 0; i < tap.streams.size(); ++i) {
+        auto& from = source.streams[i];
+        auto& to = tap.streams[i];
+        while (auto packet = from.packets.pop()) {
+            std::ignore = to.packets.push(*packet);
+        }
+        while (auto seq = from.packets_too_old.pop()) {
+            std::ignore = to.packets_too_old.push(*seq);
+        }
+        to.session_generation.store(from.session_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.rtp_ts = from.rtp_ts;
+        std::swap(to.packet_stats, from.packet_stats);
+        if (const auto counters = from.packet_stats_counters.read(boost::lockfree::uses_optional)) {
+            to.packet_stats_counters.write(*counters);
+        }
+        std::swap(to.packet_interval_stats, from.packet_interval_stats);
+        to.prev_packet_time_ns = from.prev_packet_time_ns;
+        to.state.store(from.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.receive_latency_min_max_ms = from.receive_latency_min_max_ms;
+        to.jitter_frames.store(from.jitter_frames.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    tap.most_recent_ts = source.most_recent_ts;
+    if (!tap.tap_started && tap.most_recent_ts.has_value()) {
+        tap.next_ts_to_read = get_tap_start(tap);
+    }
+    tap.source = nullptr;
+}
+
+/// Hands the ingest of given reader over to the first reader which taps it, and points the other taps at that reader.
+/// The reader must be locked exclusively.
+void hand_over_taps(rav::rtp::AudioReceiver& receiver, rav::rtp::AudioReceiver::Reader& reader) {
+    RAV_ASSERT(reader.rw_lock.is_locked_exclusively(), "Expecting the reader to be locked exclusively");
+
+    rav::rtp::AudioReceiver::Reader* successor = nullptr;
+    for (auto& tap : receiver.readers) {
+        if (tap.source != &reader) {
+            continue;  // The source is only written by this thread, so the slot doesn't need to be locked to read it.
+        }
+
+        const auto guard = tap.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            continue;
+        }
+
+        if (successor == nullptr) {
+            take_over_ingest(tap, reader);
+            successor = &tap;
+        } else {
+            tap.source = successor;
+        }
+    }
+}
+
+/// Leaves the multicast groups of given reader which are not used by other readers, and resets the reader. The readers
+/// which tap given reader take over its ingest. The reader must be locked exclusively. During a batch the groups are left
+/// by commit_reader_updates.
+void release_reader(rav::rtp::AudioReceiver& receiver, rav::rtp::AudioReceiver::Reader& reader) {
+    RAV_ASSERT(reader.rw_lock.is_locked_exclusively(), "Expecting the reader to be locked exclusively");
+
+    hand_over_taps(receiver, reader);
+
+    if (!receiver.pending_reader_updates.has_value()) {
+        for (auto& stream : reader.streams) {
+            if (stream.session.valid() && stream.session.connection_address.is_multicast() && !stream.interface.is_unspecified()) {
+                std::ignore = leave_multicast_group_if_last(
+                    receiver, stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port
                 );
             }
         }
     }
 
+    reset_reader(reader);
+    update_slots_in_use(receiver);
+    update_has_taps(receiver);
+}
+
+/// @return True if given reader shares its ingest with other readers, either as a tap or as the source.
+[[nodiscard]] bool is_ingest_shared(const rav::rtp::AudioReceiver& receiver, const rav::rtp::AudioReceiver::Reader& reader) {
+    if (reader.source != nullptr) {
+        return true;
+    }
+    return std::any_of(receiver.readers.begin(), receiver.readers.end(), [&reader](const rav::rtp::AudioReceiver::Reader& other) {
+        return other.source == &reader;
+    });
+}
+
+/// @return True if the streams of given reader can be replaced by given parameters without reallocating its buffers.
+[[nodiscard]] bool can_update_reader_in_place(
+    const rav::rtp::AudioReceiver& receiver, const rav::rtp::AudioReceiver::Reader& reader,
+    const rav::rtp::AudioReceiver::ReaderParameters& parameters, const rav::rtp::AudioReceiver::ArrayOfAddresses& interfaces
+) {
+    if (reader.audio_format != parameters.audio_format) {
+        return false;  // Requires the buffers to be reallocated
+    }
+
+    if (reader.share_ingest != parameters.share_ingest) {
+        return false;  // The reader would have to find or leave a source
+    }
+
+    if (is_ingest_shared(receiver, reader)) {
+        for (size_t i = 0; i < reader.streams.size(); ++i) {
+            if (!is_stream_unchanged(reader.streams[i], parameters.streams[i], interfaces[i])) {
+                return false;  // The other readers would lose their streams, or this one its source
+            }
+        }
+    }
+
+    for (size_t i = 0; i < reader.streams.size(); ++i) {
+        const auto& info = parameters.streams[i];
+        if (!info.is_valid()) {
+            continue;
+        }
+        if (reader.streams[i].session.valid() && reader.streams[i].packet_time_frames != info.packet_time_frames) {
+            return false;
+        }
+        if (info.packet_time_frames < reader.packet_time_frames) {
+            return false;  // The fifos are too small
+        }
+        if (!is_port_available_in_shard(receiver, info.session.rtp_port, reader.shard)) {
+            return false;  // The port is read by another shard
+        }
+    }
+
     return true;
 }
 
+/// Points given stream at a new session. The stream must be locked exclusively.
+void set_stream_session(
+    rav::rtp::AudioReceiver::StreamContext& stream, const rav::rtp::AudioReceiver::StreamInfo& info,
+    const boost::asio::ip::address_v4& interface
+) {
+    RAV_ASSERT(stream.rw_lock.is_locked_exclusively(), "Expecting the stream to be locked exclusively");
+    stream.session = info.session;
+    stream.filter = info.filter;
+    stream.packet_time_frames = info.packet_time_frames;
+    stream.interface = interface;
+    stream.session_generation.fetch_add(1, std::memory_order_release);
+    stream.state.store(rav::rtp::AudioReceiver::StreamState::inactive, std::memory_order_relaxed);
+    reset_stream_statistics(stream);
+}
+
+/// @return True if none of the valid streams of given reader keeps its session and filter, in which case the RTP
+/// timestamps of the new sessions are unrelated to the data in the receive buffer.
+[[nodiscard]] bool is_timeline_changed(
+    const rav::rtp::AudioReceiver::Reader& reader, const rav::rtp::AudioReceiver::ReaderParameters& parameters
+) {
+    bool changed = false;
+    for (size_t i = 0; i < reader.streams.size(); ++i) {
+        const auto& stream = reader.streams[i];
+        const auto& info = parameters.streams[i];
+        if (stream.session == info.session && stream.filter == info.filter) {
+            if (stream.session.valid()) {
+                return false;  // The timeline continues with this stream
+            }
+            continue;
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+/// @return The distinct multicast groups which the streams of all readers require, sorted.
+std::vector<rav::rtp::AudioReceiver::MulticastMembership> collect_multicast_memberships(const rav::rtp::AudioReceiver& receiver) {
+    std::vector<rav::rtp::AudioReceiver::MulticastMembership> memberships;
+    for (auto& reader : receiver.readers) {
+        for (auto& stream : reader.streams) {
+            if (!stream.session.valid() || !stream.session.connection_address.is_multicast() || stream.interface.is_unspecified()) {
+                continue;
+            }
+            memberships.push_back({stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port});
+        }
+    }
+    std::sort(memberships.begin(), memberships.end());
+    memberships.erase(std::unique(memberships.begin(), memberships.end()), memberships.end());
+    return memberships;
+}
+
+/// Drops the updates of given reader which were collected since begin_reader_updates.
+void erase_pending_reader_updates(rav::rtp::AudioReceiver& receiver, const rav::Id id) {
+    if (!receiver.pending_reader_updates.has_value()) {
+        return;
+    }
+    auto& pending = *receiver.pending_reader_updates;
+    pending.erase(
+        std::remove_if(
+            pending.begin(), pending.end(),
+            [id](const rav::rtp::AudioReceiver::ReaderUpdate& update) {
+                return update.id == id;
+            }
+        ),
+        pending.end()
+    );
+}
+
 size_t count_num_sessions_using_rtp_port(rav::rtp::AudioReceiver& receiver, const uint16_t port) {
     RAV_ASSERT(port > 0, "A valid port must be given, otherwise empty sessions will be counted as well");
     size_t count = 0;
@@ -283,6 +746,10 @@ size_t count_num_sessions_using_rtp_port(rav::rtp::AudioReceiver& receiver, cons
 }
 
 void close_unused_sockets(rav::rtp::AudioReceiver& receiver) {
+    if (receiver.pending_reader_updates.has_value()) {
+        return;  // Closed by commit_reader_updates, so that a port which moves between readers keeps its socket
+    }
+
     for (auto& socket : receiver.sockets) {
         if (!socket.socket.is_open()) {
             continue;
@@ -306,13 +773,24 @@ void close_unused_sockets(rav::rtp::AudioReceiver& receiver) {
             socket.port = {};
         }
     }
+    update_slots_in_use(receiver);
 }
 
+/**
+ * Moves the received packets of given reader into its receive buffer. The thread which calls this function must hold
+ * the ingest lock of the reader, unless it is a staged slot, which isn't tapped.
+ */
 void do_realtime_maintenance(rav::rtp::AudioReceiver::Reader& reader) {
     TRACY_ZONE_SCOPED;
+    const rav::metrics::CostMeter::Scope cost(reader.audio_thread_metrics.maintenance_cost);
 
     RAV_ASSERT_DEBUG(reader.rw_lock.is_locked_shared(), "Reader must be shared locked");
 
+    bool resync = false;
+    if (reader.resync_request.read(resync) && resync) {
+        reader.resync_pending = true;
+    }
+
     for (auto& stream : reader.streams) {
         if (stream.state.load(std::memory_order_relaxed) == rav::rtp::AudioReceiver::StreamState::no_consumer) {
             stream.packets.pop_all();
@@ -320,12 +798,28 @@ void do_realtime_maintenance(rav::rtp::AudioReceiver::Reader& reader) {
             continue;
         }
 
-        for (size_t i = 0; i < stream.packets.size(); ++i) {
+        const auto generation = stream.session_generation.load(std::memory_order_acquire);
+        const auto num_packets = stream.packets.size();
+        for (size_t i = 0; i < num_packets; ++i) {
             auto rtp_packet = stream.packets.pop();
             if (!rtp_packet.has_value()) {
                 break;
             }
 
+            if (rtp_packet->generation != generation) {
+                continue;  // Received from the previous session of the stream
+            }
+
+            if (reader.resync_pending) {
+                // The first packet of the new sessions, which don't share the timeline of the buffered data.
+                TRACY_MESSAGE("Resync to new sessions");
+                reader.resync_pending = false;
+                reader.most_recent_ts.reset();
+                reader.receive_buffer.clear();
+                reader.adaptive_delay.offset_frames = 0;
+                reader.asrc.primed = false;
+            }
+
             rav::WrappingUint32 packet_timestamp(rtp_packet->timestamp);
             const auto num_frames = static_cast<uint32_t>(rtp_packet->data_len) / reader.audio_format.bytes_per_frame();
             auto packet_most_recent_ts = rav::WrappingUint32(rtp_packet->timestamp + num_frames - 1);
@@ -341,71 +835,929 @@ void do_realtime_maintenance(rav::rtp::AudioReceiver::Reader& reader) {
             }
 
             // Determine whether whole packet is too old
-            if (packet_timestamp + stream.packet_time_frames <= reader.next_ts_to_read) {
-                TRACY_MESSAGE("Packet too late - skipping");
+            if (packet_timestamp + num_frames <= reader.next_ts_to_read) {
+                reader.audio_thread_metrics.packets_too_late.increment();
                 std::ignore = stream.packets_too_old.push(rtp_packet->seq);
-                continue;
-            }
-
-            // Determine whether part of the packet is too old
-            if (packet_timestamp < reader.next_ts_to_read) {
+                if (!reader.has_taps.load(std::memory_order_relaxed)) {
+                    TRACY_MESSAGE("Packet too late - skipping");
+                    continue;
+                }
+                // Still written, since the readers which tap this reader might read further behind
+                TRACY_MESSAGE("Packet too late - writing for the taps");
+            } else if (packet_timestamp < reader.next_ts_to_read) {
+                // Determine whether part of the packet is too old
                 TRACY_MESSAGE("Packet partly too late - not skipping");
                 std::ignore = stream.packets_too_old.push(rtp_packet->seq);
                 // Still process the packet since it contains data that is not outdated
             }
 
+            // A late packet must not overwrite newer data
+            if (packet_timestamp + reader.receive_buffer.get_capacity_frames() < reader.receive_buffer.get_next_ts()) {
+                TRACY_MESSAGE("Packet older than the receive buffer - skipping");
+                continue;
+            }
+
             reader.receive_buffer.clear_until(rtp_packet->timestamp);
             reader.receive_buffer.write(rtp_packet->timestamp, {rtp_packet->payload.data(), rtp_packet->data_len});
         }
     }
 }
 
-std::optional<uint32_t> read_data_from_reader_realtime(
-    rav::rtp::AudioReceiver::Reader& reader, uint8_t* buffer, const size_t buffer_size, const std::optional<uint32_t> at_timestamp,
-    const std::optional<uint32_t> require_delay
-) {
-    TRACY_ZONE_SCOPED;
+/**
+ * @return The reader which receives the packets for given reader, which is its source when it taps another reader.
+ */
+rav::rtp::AudioReceiver::Reader& get_ingest(rav::rtp::AudioReceiver::Reader& reader) {
+    return reader.source != nullptr ? *reader.source : reader;
+}
 
-    RAV_ASSERT_DEBUG(reader.rw_lock.is_locked_shared(), "Reader must be shared locked");
+const rav::rtp::AudioReceiver::Reader& get_ingest(const rav::rtp::AudioReceiver::Reader& reader) {
+    return reader.source != nullptr ? *reader.source : reader;
+}
 
-    if (at_timestamp.has_value()) {
+/**
+ * Locks the source of given reader for reading, if the reader taps another reader.
+ * @return False if the source is being changed by the control thread, in which case there is nothing to read.
+ */
+[[nodiscard]] bool try_lock_source(
+    rav::rtp::AudioReceiver::Reader& reader, std::optional<rav::AtomicRwLock::AccessGuard<rav::AtomicRwLock::Shared>>& guard
+) {
+    if (reader.source == nullptr) {
+        return true;
+    }
+    guard.emplace(reader.source->rw_lock.try_lock_shared());
+    return *guard && reader.source->id.is_valid();
+}
+
+/**
+ * Tries to lock the ingest of given reader for the calling thread. The readers which share an ingest may be read from
+ * different threads, which both move the packets into, and read from, the receive buffer of the ingest. Waiting for the
+ * read of another thread isn't realtime safe, so the lock fails while another thread reads. Always succeeds when the
+ * ingest isn't shared.
+ */
+[[nodiscard]] rav::AtomicRwLock::AccessGuard<rav::AtomicRwLock::Exclusive> try_lock_ingest(rav::rtp::AudioReceiver::Reader& reader) {
+    return get_ingest(reader).ingest_lock.try_lock_exclusive();
+}
+
+/**
+ * Moves the received packets of the ingest of given reader into its receive buffer. A tap starts reading at the most
+ * recent packet once its source received data, like a reader starts at its first packet.
+ * @return The ingest of given reader.
+ */
+rav::rtp::AudioReceiver::Reader& update_ingest(rav::rtp::AudioReceiver::Reader& reader) {
+    auto& ingest = get_ingest(reader);
+    do_realtime_maintenance(ingest);
+    if (&ingest != &reader && !reader.tap_started && ingest.most_recent_ts.has_value()) {
+        reader.next_ts_to_read = get_tap_start(ingest);
+        reader.tap_started = true;
+    }
+    return ingest;
+}
+
+/**
+ * Applies the ASRC parameters which were set by the control thread on given reader since the previous read, if any.
+ */
+void update_asrc_parameters(rav::rtp::AudioReceiver::Reader& reader, rav::rtp::AudioReceiver::AsrcState& state) {
+    std::optional<rav::rtp::AudioReceiver::AsrcParameters> parameters;
+    if (reader.asrc_parameters.read(parameters)) {
+        state.reset();
+        state.parameters = parameters;
+    }
+}
+
+/**
+ * Determines how many frames to advance after reading num_frames, which is num_frames - 1 to raise the delay by
+ * repeating a frame, num_frames + 1 to lower the delay by skipping a frame, or num_frames otherwise.
+ */
+uint32_t get_adaptive_advance(rav::rtp::AudioReceiver::Reader& reader, const uint32_t num_frames, const uint32_t delay) {
+    auto& state = reader.adaptive_delay;
+    RAV_ASSERT_DEBUG(state.parameters.has_value(), "Expecting adaptive delay parameters");
+    const auto& parameters = *state.parameters;
+
+    // Use the jitter of the best stream, as the data of any redundant stream will do.
+    std::optional<uint32_t> jitter_frames;
+    for (auto& stream : get_ingest(reader).streams) {
+        if (stream.state.load(std::memory_order_relaxed) != rav::rtp::AudioReceiver::StreamState::receiving) {
+            continue;
+        }
+        const auto jitter = stream.jitter_frames.load(std::memory_order_relaxed);
+        if (!jitter_frames.has_value() || jitter < *jitter_frames) {
+            jitter_frames = jitter;
+        }
+    }
+
+    // The delay is measured from the last frame of this read, so the next read needs num_frames more on top of the jitter.
+    const auto target =
+        std::clamp(jitter_frames.value_or(0) + num_frames + parameters.margin_frames, parameters.min_delay_frames, parameters.max_delay_frames);
+
+    if (delay < target) {
+        // Not enough margin, raise the delay one frame at a time.
+        state.frames_to_skip = 0;
+        state.window_frames = 0;
+        state.window_min_slack.reset();
+        if (num_frames <= 1) {
+            return num_frames;  // Repeating the only frame would stall the read position
+        }
+        reader.audio_thread_metrics.frames_repeated.increment();
+        return num_frames - 1;
+    }
+
+    const auto slack = delay - target;
+    if (!state.window_min_slack.has_value() || slack < *state.window_min_slack) {
+        state.window_min_slack = slack;
+    }
+    state.window_frames += num_frames;
+
+    // Only lower the delay when the margin was larger than needed during a whole window.
+    if (state.window_frames >= reader.audio_format.sample_rate * rav::rtp::AudioReceiver::k_adaptive_delay_window_ms / 1000) {
+        state.frames_to_skip = state.window_min_slack.value_or(0);
+        state.window_frames = 0;
+        state.window_min_slack.reset();
+    }
+
+    if (delay > parameters.max_delay_frames) {
+        state.frames_to_skip = std::max(state.frames_to_skip, delay - parameters.max_delay_frames);
+    }
+
+    if (state.frames_to_skip > 0) {
+        --state.frames_to_skip;
+        reader.audio_thread_metrics.frames_skipped.increment();
+        return num_frames + 1;
+    }
+
+    return num_frames;
+}
+
+/**
+ * Spreads the frame which the adaptive delay skipped or repeated after the latest read of given reader over the frames of
+ * that read, so that the output stays continuous. Output frame i is interpolated at input frame i * (n + correction) / n,
+ * which makes the next read continue where this one ends.
+ * @param reader The reader which was read.
+ * @param read_at The timestamp of the first frame of the read.
+ * @param buffer The decoded frames of the read.
+ */
+void spread_adaptive_correction(rav::rtp::AudioReceiver::Reader& reader, const uint32_t read_at, rav::AudioBufferView<float>& buffer) {
+    const auto correction = reader.adaptive_delay.correction;
+    const auto num_frames = buffer.num_frames();
+    if (correction == 0 || num_frames < 2) {
+        return;
+    }
+
+    // Lowering the delay needs the skipped frame to interpolate the last frame
+    if (correction > 0) {
+        auto& skipped = reader.skipped_frame;
+        const auto bytes_per_frame = reader.audio_format.bytes_per_frame();
+        auto& read_buffer = reader.read_audio_data_buffer;
+        if (skipped.num_channels() != buffer.num_channels() || (num_frames + 1) * bytes_per_frame > read_buffer.size()) {
+            return;
+        }
+        auto* frame = read_buffer.data() + num_frames * bytes_per_frame;
+        get_ingest(reader).receive_buffer.read_received(read_at + static_cast<uint32_t>(num_frames), frame, bytes_per_frame);
+        reader.pipeline.decode(frame, 1, buffer.num_channels(), skipped.data());
+    }
+
+    const auto advance = static_cast<uint64_t>(static_cast<int64_t>(num_frames) + correction);
+    const auto frame_at = [&](const size_t ch, const size_t i) {
+        return i < num_frames ? buffer[ch][i] : reader.skipped_frame[ch][0];
+    };
+
+    for (size_t ch = 0; ch < buffer.num_channels(); ++ch) {
+        auto* samples = buffer[ch];
+        // In place: when skipping, frame i only reads from frames i and later, when repeating, from frames i and earlier.
+        for (size_t k = 0; k < num_frames; ++k) {
+            const auto i = correction > 0 ? k : num_frames - 1 - k;
+            const auto position = i * advance;
+            const auto index = static_cast<size_t>(position / num_frames);
+            const auto fraction = static_cast<float>(position % num_frames) / static_cast<float>(num_frames);
+            const auto current = frame_at(ch, index);
+            samples[i] = fraction > 0.0f ? current + (frame_at(ch, index + 1) - current) * fraction : current;
+        }
+    }
+}
+
+std::optional<uint32_t> read_data_from_reader_realtime(
+    rav::rtp::AudioReceiver::Reader& reader, uint8_t* buffer, const size_t buffer_size, const std::optional<uint32_t> at_timestamp,
+    const std::optional<uint32_t> require_delay
+) {
+    TRACY_ZONE_SCOPED;
+    const rav::metrics::CostMeter::Scope cost(reader.audio_thread_metrics.read_cost);
+
+    RAV_ASSERT_DEBUG(reader.rw_lock.is_locked_shared(), "Reader must be shared locked");
+
+    if (at_timestamp.has_value()) {
         reader.next_ts_to_read = *at_timestamp;  // Updating before do_realtime_maintenance to have the most accurate next_to_to_read
     }
 
-    do_realtime_maintenance(reader);
+    auto& ingest = update_ingest(reader);
+
+    if (!ingest.most_recent_ts.has_value()) {
+        reader.audio_thread_metrics.reads_without_data.increment();
+        return {};  // No data has been received yet
+    }
+
+    RAV_ASSERT_DEBUG(ingest.most_recent_ts.has_value(), "Should have a value, since first_packet_timestamp is set");
+
+    const auto num_frames = static_cast<uint32_t>(buffer_size) / reader.audio_format.bytes_per_frame();
+    if (num_frames == 0) {
+        return {};  // Smaller than a frame
+    }
+
+    std::optional<rav::rtp::AudioReceiver::AdaptiveDelayParameters> adaptive_delay_parameters;
+    if (reader.adaptive_delay_parameters.read(adaptive_delay_parameters)) {
+        reader.adaptive_delay.reset();
+        reader.adaptive_delay.parameters = adaptive_delay_parameters;
+    }
+
+    uint32_t advance = num_frames;
+
+    if (reader.adaptive_delay.parameters.has_value() && !reader.asrc.parameters.has_value()) {
+        const auto last_frame = reader.next_ts_to_read + (num_frames - 1);
+        if (last_frame > *ingest.most_recent_ts) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return {};
+        }
+        const auto delay = static_cast<uint32_t>(last_frame.diff(*ingest.most_recent_ts));
+        advance = get_adaptive_advance(reader, num_frames, delay);
+        reader.adaptive_delay.offset_frames += static_cast<int32_t>(advance) - static_cast<int32_t>(num_frames);
+        reader.audio_thread_metrics.delay_frames.set(static_cast<double>(delay));
+    } else if (require_delay.has_value()) {
+        if (reader.next_ts_to_read + num_frames - 1 + *require_delay > ingest.most_recent_ts) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return {};
+        }
+    }
+
+    reader.adaptive_delay.correction = static_cast<int32_t>(advance) - static_cast<int32_t>(num_frames);
+
+    TRACY_PLOT("RTP Receive buffer", static_cast<int64_t>(reader.next_ts_to_read.diff(ingest.receive_buffer.get_next_ts())) - num_frames);
+
+    // The data is not cleared by reading, since the readers which share the ingest read at different positions. Frames
+    // which weren't received, or were overwritten by newer data, read as silence.
+    const auto read_at = reader.next_ts_to_read.value();
+    ingest.receive_buffer.read_received(read_at, buffer, buffer_size);
+    reader.next_ts_to_read += advance;
+    reader.audio_thread_metrics.reads.increment();
+
+    return read_at;
+}
+
+/**
+ * Reads from given reader, taking a scheduled activation into account. The read which contains the activation timestamp
+ * is split: the frames before the activation timestamp are read from given reader and the remaining frames from the
+ * staged slot, which then replaces given reader. Until then the staged slot is kept up to date so that it has data
+ * available at the moment of the switch. When the switch happens, activated is set to the staged slot.
+ */
+std::optional<uint32_t> read_data_with_activation_realtime(
+    rav::rtp::AudioReceiver& receiver, rav::rtp::AudioReceiver::Reader& reader, uint8_t* buffer, const size_t buffer_size,
+    const std::optional<uint32_t> at_timestamp, const std::optional<uint32_t> require_delay,
+    rav::rtp::AudioReceiver::Reader** activated = nullptr
+) {
+    using Activation = rav::rtp::AudioReceiver::Activation;
+
+    // The adjustments of the adaptive delay are kept, otherwise every read at an explicit timestamp would undo them.
+    std::optional<uint32_t> read_from;
+    if (at_timestamp.has_value()) {
+        read_from = *at_timestamp + static_cast<uint32_t>(reader.adaptive_delay.offset_frames);
+    }
+
+    std::optional<rav::rtp::AudioReceiver::ScheduledActivation> request;
+    if (reader.scheduled_activation_request.read(request)) {
+        reader.scheduled_activation = request;
+    }
+
+    if (!reader.scheduled_activation.has_value()) {
+        return read_data_from_reader_realtime(reader, buffer, buffer_size, read_from, require_delay);
+    }
+
+    const auto scheduled = *reader.scheduled_activation;
+    RAV_ASSERT_DEBUG(scheduled.staged_index < receiver.readers.size(), "Staged index out of range");
+    auto& staged = receiver.readers[scheduled.staged_index];
+
+    const auto staged_guard = staged.rw_lock.try_lock_shared();
+    if (!staged_guard) {
+        return read_data_from_reader_realtime(reader, buffer, buffer_size, read_from, require_delay);
+    }
+
+    if (staged.id != reader.id || staged.activation.load(std::memory_order_acquire) != Activation::staged) {
+        reader.scheduled_activation.reset();  // Cancelled by the control thread
+        return read_data_from_reader_realtime(reader, buffer, buffer_size, read_from, require_delay);
+    }
+
+    const auto bytes_per_frame = reader.audio_format.bytes_per_frame();
+    const auto num_frames = static_cast<int32_t>(buffer_size / bytes_per_frame);
+    const auto first_frame = read_from.has_value() ? rav::WrappingUint32(*read_from) : reader.next_ts_to_read;
+    const auto frames_before = first_frame.diff(scheduled.rtp_timestamp);
+
+    if (frames_before >= num_frames) {
+        do_realtime_maintenance(staged);
+        return read_data_from_reader_realtime(reader, buffer, buffer_size, read_from, require_delay);
+    }
+
+    std::optional<uint32_t> read_at;
+    auto switch_at = first_frame;
+    size_t bytes_before = 0;
+
+    if (frames_before > 0) {
+        bytes_before = static_cast<size_t>(frames_before) * bytes_per_frame;
+        read_at = read_data_from_reader_realtime(reader, buffer, bytes_before, read_from, require_delay);
+        if (!read_at.has_value()) {
+            std::fill_n(buffer, bytes_before, uint8_t {0});
+        }
+        switch_at = rav::WrappingUint32(scheduled.rtp_timestamp);
+    }
+
+    // The staged slot continues with the adaptive delay of the slot it replaces.
+    staged.adaptive_delay = reader.adaptive_delay;
+    std::optional<rav::rtp::AudioReceiver::AdaptiveDelayParameters> adaptive_delay_parameters;
+    if (reader.adaptive_delay_parameters.read(adaptive_delay_parameters)) {
+        staged.adaptive_delay.reset();
+        staged.adaptive_delay.parameters = adaptive_delay_parameters;
+    }
+
+    // And with the resampler, which holds the history of the stream, as long as the number of channels didn't change.
+    if (staged.asrc.resampler.num_channels() == reader.asrc.resampler.num_channels()) {
+        std::swap(staged.asrc, reader.asrc);
+    } else {
+        staged.asrc.reset();
+        staged.asrc.parameters = reader.asrc.parameters;
+    }
+    update_asrc_parameters(reader, staged.asrc);
+
+    // Takes in the packets first, otherwise the first packet would move the read position to its own timestamp.
+    do_realtime_maintenance(staged);
+
+    const auto staged_read_at =
+        read_data_from_reader_realtime(staged, buffer + bytes_before, buffer_size - bytes_before, switch_at.value(), require_delay);
+    if (!staged_read_at.has_value()) {
+        std::fill_n(buffer + bytes_before, buffer_size - bytes_before, uint8_t {0});
+    }
+
+    staged.activated_at.store(switch_at.value(), std::memory_order_relaxed);
+    reader.scheduled_activation.reset();
+    reader.activation.store(Activation::retired, std::memory_order_release);
+    staged.activation.store(Activation::active, std::memory_order_release);
+    if (activated != nullptr) {
+        *activated = &staged;
+    }
+
+    if (!read_at.has_value() && !staged_read_at.has_value()) {
+        return std::nullopt;
+    }
+    return first_frame.value();
+}
+
+/**
+ * Updates the ratio of the resampler of given reader from the fill level, which is the number of frames received but not
+ * yet played out. A PI controller steers the low pass filtered fill level to the target, so that the ratio converges to
+ * the drift between the consumer and the RTP timeline. When the fill level can't be kept, because of an underrun, a gap
+ * in the stream or the start of a stream, the read position jumps to the target and the resampler restarts.
+ * @return False if no data has been received yet.
+ */
+bool update_asrc_ratio(rav::rtp::AudioReceiver::Reader& reader, const size_t num_frames) {
+    using Receiver = rav::rtp::AudioReceiver;
+
+    auto& state = reader.asrc;
+    auto& resampler = state.resampler;
+    const auto& parameters = *state.parameters;
+
+    const auto& ingest = update_ingest(reader);
+
+    if (!ingest.most_recent_ts.has_value()) {
+        return false;
+    }
+
+    // Leave room in the receive buffer for the jitter on top of the target
+    const auto max_target_fill_frames = reader.audio_format.sample_rate * Receiver::k_buffer_size_ms / 1000 / 2;
+    const auto target = std::min(parameters.target_fill_frames, max_target_fill_frames);
+    const auto end_ts = *ingest.most_recent_ts + 1;
+    const auto num_received = static_cast<int64_t>(reader.next_ts_to_read.diff(end_ts));
+    auto fill = static_cast<double>(num_received) + resampler.get_num_buffered_frames();
+
+    const auto underrun = static_cast<int64_t>(resampler.get_num_input_frames_needed(num_frames)) > num_received;
+    if (!state.primed || underrun || fill > 2.0 * target) {
+        if (state.primed) {
+            reader.audio_thread_metrics.asrc_resets.increment();
+        }
+        resampler.reset();
+        const auto num_buffered = static_cast<uint32_t>(resampler.get_num_buffered_frames());
+        reader.next_ts_to_read = end_ts - (std::max(target, num_buffered) - num_buffered);
+        fill = static_cast<double>(std::max(target, num_buffered));
+        state.filtered_error = 0.0;
+        state.primed = true;  // The integrator is kept, since the drift didn't change
+    }
+
+    const auto sample_rate = static_cast<double>(reader.audio_format.sample_rate);
+    const auto dt = static_cast<double>(num_frames) / sample_rate;
+    const auto max_deviation = static_cast<double>(parameters.max_deviation_ppm) * 1e-6;
+    constexpr auto wn = Receiver::k_asrc_loop_bandwidth;
+
+    state.filtered_error += (fill - target - state.filtered_error) * std::min(1.0, dt / Receiver::k_asrc_fill_time_constant_s);
+    state.integrator = std::clamp(state.integrator + wn * wn / sample_rate * state.filtered_error * dt, -max_deviation, max_deviation);
+    const auto deviation = std::clamp(2.0 * wn / sample_rate * state.filtered_error + state.integrator, -max_deviation, max_deviation);
+    resampler.set_ratio(1.0 + deviation);
+
+    reader.audio_thread_metrics.asrc_fill_frames.set(fill);
+    reader.audio_thread_metrics.asrc_ratio_deviation_ppm.set(deviation * 1e6);
+    return true;
+}
+
+/**
+ * Fills given buffer from given reader through the resampler of the ASRC. The input is read in blocks, taking a scheduled
+ * activation into account, after which the resampler of the staged slot continues.
+ * @return The timestamp of the first frame of the buffer, or nullopt if no data has been received yet.
+ */
+std::optional<uint32_t> read_audio_data_with_asrc_realtime(
+    rav::rtp::AudioReceiver& receiver, rav::rtp::AudioReceiver::Reader& reader, rav::AudioBufferView<float>& output_buffer
+) {
+    TRACY_ZONE_SCOPED;
+
+    const auto num_frames = output_buffer.num_frames();
+    if (reader.asrc.resampler.num_channels() != output_buffer.num_channels() || !update_asrc_ratio(reader, num_frames)) {
+        reader.audio_thread_metrics.reads_without_data.increment();
+        return std::nullopt;
+    }
+
+    // The output lags the input of the resampler by half the filter length
+    const auto buffered = static_cast<uint32_t>(std::lround(reader.asrc.resampler.get_num_buffered_frames()));
+    const auto read_at = reader.next_ts_to_read - buffered + (rav::AudioResampler::k_num_taps / 2 - 1);
+
+    const auto bytes_per_frame = reader.audio_format.bytes_per_frame();
+    const auto pipeline = reader.pipeline;
+    auto* buffer = reader.read_audio_data_buffer.data();
+    auto* current = &reader;
+    std::optional<rav::AtomicRwLock::AccessGuard<rav::AtomicRwLock::Shared>> activated_guard;
+
+    size_t offset = 0;
+    while (offset < num_frames) {
+        auto& resampler = current->asrc.resampler;
+        const auto n = std::min(num_frames - offset, resampler.max_num_output_frames());
+        const auto num_input_frames = resampler.get_num_input_frames_needed(n);
+
+        if (num_input_frames > 0) {
+            auto* const* input = resampler.prepare_input(num_input_frames);
+            rav::rtp::AudioReceiver::Reader* activated = nullptr;
+            const auto input_read_at = read_data_with_activation_realtime(
+                receiver, *current, buffer, num_input_frames * bytes_per_frame, std::nullopt, std::nullopt, &activated
+            );
+
+            if (input_read_at.has_value() && pipeline.is_valid()) {
+                pipeline.decode(buffer, num_input_frames, output_buffer.num_channels(), input);
+            } else {
+                for (size_t ch = 0; ch < output_buffer.num_channels(); ++ch) {
+                    std::fill_n(input[ch], num_input_frames, 0.0f);
+                }
+            }
+
+            if (activated != nullptr) {
+                // The resampler moved to the staged slot, unless the number of channels changed
+                activated_guard.emplace(activated->rw_lock.try_lock_shared());
+                if (!*activated_guard || activated->asrc.resampler.num_channels() != output_buffer.num_channels()) {
+                    for (size_t ch = 0; ch < output_buffer.num_channels(); ++ch) {
+                        output_buffer.clear(ch, offset, num_frames - offset);
+                    }
+                    break;
+                }
+                current = activated;
+            }
+        }
+
+        current->asrc.resampler.process(output_buffer.data(), offset, n);
+        offset += n;
+    }
+
+    return read_at.value();
+}
+
+/**
+ * Updates the jitter of the stream used by the adaptive delay. When the PTP clock is locked, the jitter is the spread of
+ * the receive latency (the arrival time versus the PTP time of the RTP timestamp). The envelope follows new extremes
+ * immediately and releases slowly. Without PTP, the maximum deviation of the packet interval is used instead.
+ */
+void update_jitter(rav::rtp::AudioReceiver::StreamContext& stream, const std::optional<double> receive_latency_ms, const uint32_t sample_rate) {
+    constexpr double k_release = 0.0005;  // Per packet
+
+    double jitter_ms = stream.packet_interval_stats.max_deviation;
+
+    if (receive_latency_ms.has_value()) {
+        if (!stream.receive_latency_min_max_ms.has_value()) {
+            stream.receive_latency_min_max_ms = std::make_pair(*receive_latency_ms, *receive_latency_ms);
+        }
+        auto& [min, max] = *stream.receive_latency_min_max_ms;
+        min = *receive_latency_ms < min ? *receive_latency_ms : min + (*receive_latency_ms - min) * k_release;
+        max = *receive_latency_ms > max ? *receive_latency_ms : max + (*receive_latency_ms - max) * k_release;
+        jitter_ms = max - min;
+    } else {
+        stream.receive_latency_min_max_ms.reset();
+    }
+
+    const auto jitter_frames = std::ceil(std::max(jitter_ms, 0.0) * static_cast<double>(sample_rate) / 1000.0);
+    stream.jitter_frames.store(static_cast<uint32_t>(jitter_frames), std::memory_order_relaxed);
+}
+
+void update_stream_active_state(rav::rtp::AudioReceiver::StreamContext& stream, const uint64_t now) {
+    TRACY_ZONE_SCOPED;
+    if ((stream.prev_packet_time_ns + rav::rtp::AudioReceiver::k_receive_timeout_ms * 1'000'000).value() < now) {
+        stream.state.store(rav::rtp::AudioReceiver::StreamState::inactive, std::memory_order_relaxed);
+    }
+}
+
+/// Writes given payload to the shared buffer of given reader, if the reader exports its audio.
+void export_payload(rav::rtp::AudioReceiver::Reader& reader, const uint32_t timestamp, const rav::BufferView<const uint8_t>& payload) {
+    // Only the active slot exports, so that a staged slot in another shard doesn't write to the same buffer.
+    if (reader.shared_buffer != nullptr
+        && reader.activation.load(std::memory_order_relaxed) == rav::rtp::AudioReceiver::Activation::active) {
+        const auto bytes_per_frame = reader.audio_format.bytes_per_frame();
+        const auto num_frames = payload.size_bytes() / bytes_per_frame;
+        if (payload.size_bytes() % bytes_per_frame == 0 && num_frames <= reader.shared_buffer->get_capacity_frames()) {
+            reader.shared_buffer->write(timestamp, payload);
+        }
+    }
+}
+
+/// Passes a received datagram to the streams of the readers of given shard.
+/// @return True if the datagram is a valid RTP packet, or false if not.
+bool process_packet(
+    rav::rtp::AudioReceiver& receiver, const size_t shard, const uint8_t* data, const size_t size,
+    const boost::asio::ip::udp::endpoint& src_endpoint, const boost::asio::ip::udp::endpoint& dst_endpoint, const uint64_t recv_time,
+    const uint64_t now
+) {
+    rav::rtp::PacketView view(data, size);
+    if (!view.validate()) {
+        return false;  // Invalid RTP packet
+    }
+
+    const auto payload = view.payload_data();
+    if (payload.size_bytes() == 0) {
+        return true;  // Received packet with empty payload
+    }
+
+    if (payload.size_bytes() > std::numeric_limits<uint16_t>::max()) {
+        return true;  // Payload size exceeds maximum size
+    }
+
+    const auto num_reader_slots = receiver.num_reader_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_reader_slots; ++i) {
+        auto& reader = receiver.readers[i];
+        const auto reader_guard = reader.rw_lock.try_lock_shared();
+        if (!reader_guard) {
+            continue;  // Failed to lock which means it is being added or removed.
+        }
+
+        if (!reader.id.is_valid() || reader.shard != shard) {
+            continue;
+        }
+
+        for (auto& stream : reader.streams) {
+            const auto stream_guard = stream.rw_lock.try_lock_shared();
+            if (!stream_guard) {
+                continue;  // The session of this stream is being changed.
+            }
+            if (stream.session.connection_address != dst_endpoint.address()) {
+                continue;
+            }
+            if (stream.session.rtp_port != dst_endpoint.port()) {
+                continue;
+            }
+            if (!stream.filter.is_valid_source(dst_endpoint.address(), src_endpoint.address())) {
+                continue;
+            }
+
+            if (reader.source != nullptr) {
+                export_payload(reader, view.timestamp(), payload);
+                continue;  // The packet is received into the receive buffer of the source
+            }
+
+            if (payload.size_bytes() > rav::aes67::constants::k_max_payload) {
+                stream.network_thread_metrics.packets_discarded.increment();
+                continue;  // Doesn't fit the packet buffer
+            }
+
+            const rav::metrics::CostMeter::Scope cost(stream.network_thread_metrics.processing_cost);
+            update_stream_active_state(stream, now);
+
+            if (!stream.rtp_ts.has_value()) {
+                stream.rtp_ts = view.timestamp();
+                stream.prev_packet_time_ns = recv_time;
+            }
+
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.timestamp = view.timestamp();
+            packet.seq = view.sequence_number();
+            packet.data_len = static_cast<uint16_t>(payload.size_bytes());
+            packet.recv_time = recv_time;
+            packet.generation = stream.session_generation.load(std::memory_order_relaxed);
+            std::memcpy(packet.payload.data(), payload.data(), payload.size_bytes());
+
+            auto& metrics = stream.network_thread_metrics;
+            metrics.packets_received.increment();
+            metrics.bytes_received.increment(size);
+
+            auto state = stream.state.load(std::memory_order_relaxed);
+            if (stream.packets.push(packet)) {
+                stream.state.store(rav::rtp::AudioReceiver::StreamState::receiving, std::memory_order_relaxed);
+            } else {
+                metrics.packets_discarded.increment();
+                if (state != rav::rtp::AudioReceiver::StreamState::no_consumer) {
+                    stream.state.store(rav::rtp::AudioReceiver::StreamState::no_consumer, std::memory_order_relaxed);
+                }
+            }
+
+            export_payload(reader, packet.timestamp, payload);
+
+            std::optional<double> receive_latency_ms;
+
+            {
+                // This block compares the rtp timestamp against the recv_time converted to PTP scale.
+                const auto& local_clock = receiver.ptp_instance_subscriber.get_local_clock();
+                if (local_clock.is_locked()) {
+                    auto ptp_time = local_clock.get_adjusted_time(recv_time);
+                    auto rtp_time = ptp_time.from_rtp_timestamp32(packet.timestamp, reader.audio_format.sample_rate);
+                    receive_latency_ms = ptp_time.to_milliseconds_double() - rtp_time.to_milliseconds_double();
+                    metrics.receive_latency_ms.observe(*receive_latency_ms);
+                    TRACY_PLOT("receive latency (ms)", *receive_latency_ms);
+                }
+            }
+
+            while (auto seq = stream.packets_too_old.pop()) {
+                stream.packet_stats.mark_packet_too_late(*seq);
+            }
+
+            if (const auto interval = stream.prev_packet_time_ns.update(recv_time)) {
+                if (stream.packet_interval_stats.initialized || *interval != 0) {
+                    if (stream.reset_max_values.exchange(false, std::memory_order_acq_rel)) {
+                        stream.packet_interval_stats.max_deviation = {};
+                    }
+                    const auto interval_ms = static_cast<double>(*interval) / 1'000'000.0;
+                    stream.packet_interval_stats.update(interval_ms);
+                    metrics.packet_interval_ms.observe(interval_ms);
+                    if (reader.audio_format.sample_rate > 0 && stream.packet_time_frames > 0) {
+                        const auto packet_time_ms = static_cast<double>(stream.packet_time_frames) * 1000.0 /
+                            static_cast<double>(reader.audio_format.sample_rate);
+                        if (interval_ms > packet_time_ms * 4.0) {
+                            RAV_TRACE_ANOMALY("Packet interval spike");
+                        }
+                    }
+                    TRACY_PLOT("packet interval (ms)", interval_ms);
+                    TRACY_PLOT("packet interval EMA (ms)", stream.packet_interval_stats.interval);
+                    TRACY_PLOT("packet interval MAX (ms)", stream.packet_interval_stats.max_deviation);
+                }
+            }
+
+            update_jitter(stream, receive_latency_ms, reader.audio_format.sample_rate);
+
+            std::ignore = stream.packet_stats.update(view.sequence_number());
+            auto stats = stream.packet_stats.get_total_counts();
+            stats.jitter = stream.packet_interval_stats.max_deviation;
+            stream.packet_stats_counters.write(stats);
+        }
+    }
+
+    return true;
+}
+
+/// Points the AF_PACKET rings of every shard at the destinations of the streams in the shard. A ring is created for every
+/// interface in use, and the rings of interfaces which are no longer used are destroyed.
+void update_packet_mmap_rings(rav::rtp::AudioReceiver& receiver) {
+    if (!receiver.packet_mmap_options.has_value() || receiver.pending_reader_updates.has_value()) {
+        return;  // During a batch the rings are updated by commit_reader_updates
+    }
+
+    for (size_t shard = 0; shard < receiver.num_shards; ++shard) {
+        std::vector<std::pair<rav::ip_address_v4, std::vector<rav::udp_endpoint>>> interfaces;
+        for (auto& reader : receiver.readers) {
+            if (!reader.id.is_valid() || reader.shard != shard || reader.source != nullptr) {
+                continue;  // The destinations of a tap are those of its source
+            }
+            for (auto& stream : reader.streams) {
+                if (!stream.session.valid()) {
+                    continue;
+                }
+                auto it = std::find_if(interfaces.begin(), interfaces.end(), [&stream](const auto& pair) {
+                    return pair.first == stream.interface;
+                });
+                if (it == interfaces.end()) {
+                    it = interfaces.emplace(interfaces.end(), stream.interface, std::vector<rav::udp_endpoint> {});
+                }
+                it->second.emplace_back(stream.session.connection_address, stream.session.rtp_port);
+            }
+        }
+
+        auto& entries = receiver.shards[shard].packet_mmap;
+
+        for (auto& entry : entries) {
+            if (entry.ring == nullptr) {
+                continue;
+            }
+            const auto in_use = std::any_of(interfaces.begin(), interfaces.end(), [&entry](const auto& pair) {
+                return pair.first == entry.interface;
+            });
+            if (in_use) {
+                continue;
+            }
+            const auto guard = entry.rw_lock.lock_exclusive();
+            if (!guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock packet ring");
+                continue;
+            }
+            entry.ring.reset();
+            entry.interface = {};
+        }
+
+        for (auto& [interface, destinations] : interfaces) {
+            auto it = std::find_if(entries.begin(), entries.end(), [&interface = interface](const auto& entry) {
+                return entry.ring != nullptr && entry.interface == interface;
+            });
+            if (it != entries.end()) {
+                if (!it->ring->set_destinations(destinations)) {
+                    RAV_LOG_ERROR("Failed to set the destinations of the packet ring of {}", interface.to_string());
+                }
+                continue;
+            }
+
+            it = std::find_if(entries.begin(), entries.end(), [](const auto& entry) {
+                return entry.ring == nullptr;
+            });
+            if (it == entries.end()) {
+                RAV_LOG_ERROR("No packet ring available for interface {}", interface.to_string());
+                continue;
+            }
+
+            auto ring = rav::rtp::PacketMmapReceiveRing::create(interface, *receiver.packet_mmap_options);
+            if (ring == nullptr) {
+                RAV_LOG_ERROR("Failed to create packet ring for interface {}", interface.to_string());
+                continue;
+            }
+            if (!ring->set_destinations(destinations)) {
+                RAV_LOG_ERROR("Failed to set the destinations of the packet ring of {}", interface.to_string());
+            }
+
+            const auto guard = it->rw_lock.lock_exclusive();
+            if (!guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock packet ring");
+                continue;
+            }
+            it->interface = interface;
+            it->ring = std::move(ring);
+        }
+    }
+}
+
+/// Leaves the groups in given memberships which no reader requires anymore and joins the groups which readers require
+/// since, then closes the unused sockets and updates the packet rings. Both lists are sorted, so this is done in one pass
+/// regardless of the number of readers.
+void sync_multicast_memberships(
+    rav::rtp::AudioReceiver& receiver, const std::vector<rav::rtp::AudioReceiver::MulticastMembership>& memberships_before
+) {
+    const auto memberships_after = collect_multicast_memberships(receiver);
+
+    for (auto& membership : memberships_before) {
+        if (!std::binary_search(memberships_after.begin(), memberships_after.end(), membership)) {
+            leave_multicast_group_on_port(receiver, membership.group, membership.interface, membership.port);
+        }
+    }
+
+    for (auto& membership : memberships_after) {
+        if (std::binary_search(memberships_before.begin(), memberships_before.end(), membership)) {
+            continue;
+        }
+        auto* socket = find_socket(receiver, membership.port);
+        if (socket == nullptr || !receiver.join_multicast_group(*socket, membership.group, membership.interface)) {
+            RAV_LOG_ERROR("Failed to join multicast group");
+        }
+    }
+
+    close_unused_sockets(receiver);
+    update_packet_mmap_rings(receiver);
+}
+
+/// Points the streams of the readers in given updates at their new sessions, within a single lock window, without
+/// joining or leaving multicast groups.
+/// @return For every update whether the reader was updated in place.
+std::vector<bool>
+apply_reader_updates(rav::rtp::AudioReceiver& receiver, const std::vector<rav::rtp::AudioReceiver::ReaderUpdate>& updates) {
+    using rav::rtp::AudioReceiver;
+    std::vector<bool> results(updates.size(), false);
+
+    // Check all updates before touching anything
+    std::vector<std::pair<AudioReceiver::Reader*, size_t>> readers_to_update;
+    for (size_t i = 0; i < updates.size(); ++i) {
+        for (auto& reader : receiver.readers) {
+            if (is_active_reader(reader, updates[i].id)) {
+                if (can_update_reader_in_place(receiver, reader, updates[i].parameters, updates[i].interfaces)) {
+                    readers_to_update.emplace_back(&reader, i);
+                }
+                break;
+            }
+        }
+    }
+
+    // The guards are held until all readers are updated, so that the network threads see all the changes at once. Only
+    // the streams are locked, so that the audio thread keeps reading from the receive buffers.
+    std::vector<rav::AtomicRwLock::AccessGuard<rav::AtomicRwLock::Shared>> reader_guards;
+    std::vector<rav::AtomicRwLock::AccessGuard<rav::AtomicRwLock::Exclusive>> stream_guards;
+    reader_guards.reserve(readers_to_update.size());
+    stream_guards.reserve(readers_to_update.size() * AudioReceiver::k_max_num_redundant_sessions);
+
+    for (auto& [reader, index] : readers_to_update) {
+        const auto& update = updates[index];
+
+        auto reader_guard = reader->rw_lock.lock_shared();
+        if (!reader_guard) {
+            RAV_LOG_ERROR("Failed to lock reader");
+            continue;
+        }
+        reader_guards.push_back(std::move(reader_guard));
+
+        results[index] = true;
+        const auto resync = is_timeline_changed(*reader, update.parameters);
+        for (size_t i = 0; i < reader->streams.size(); ++i) {
+            auto& stream = reader->streams[i];
+            if (is_stream_unchanged(stream, update.parameters.streams[i], update.interfaces[i])) {
+                continue;
+            }
+
+            auto stream_guard = stream.rw_lock.lock_exclusive();
+            if (!stream_guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock stream");
+                results[index] = false;
+                continue;
+            }
+            stream_guards.push_back(std::move(stream_guard));
 
-    if (!reader.most_recent_ts.has_value()) {
-        return {};  // No data has been received yet
+            set_stream_session(stream, update.parameters.streams[i], update.interfaces[i]);
+            if (stream.session.valid() && find_or_create_socket(receiver, stream.session.rtp_port, reader->shard) == nullptr) {
+                RAV_LOG_ERROR("Failed to create receive socket");
+            }
+        }
+        if (resync) {
+            reader->resync_request.write(true);
+        }
     }
 
-    RAV_ASSERT_DEBUG(reader.most_recent_ts.has_value(), "Should have a value, since first_packet_timestamp is set");
-
-    const auto num_frames = static_cast<uint32_t>(buffer_size) / reader.audio_format.bytes_per_frame();
+    return results;
+}
 
-    if (require_delay.has_value()) {
-        if (reader.next_ts_to_read + num_frames - 1 + *require_delay > reader.most_recent_ts) {
-            return {};
+/// Processes the datagrams received from the AF_PACKET rings of given shard.
+/// @return True if at least one valid RTP packet was received, or false if not.
+bool read_incoming_packets_packet_mmap(rav::rtp::AudioReceiver& receiver, const size_t shard, const uint64_t now) {
+    bool received = false;
+    std::array<rav::rtp::PacketMmapReceiveRing::Packet, 64> packets;
+    for (auto& entry : receiver.shards[shard].packet_mmap) {
+        const auto guard = entry.rw_lock.try_lock_shared();
+        if (!guard || entry.ring == nullptr) {
+            continue;
+        }
+        const auto num_packets = entry.ring->receive(packets.data(), packets.size());
+        for (size_t i = 0; i < num_packets; ++i) {
+            const auto& packet = packets[i];
+            if (process_packet(receiver, shard, packet.data, packet.size, packet.src_endpoint, packet.dst_endpoint, packet.recv_time, now)) {
+                received = true;
+            }
         }
     }
+    return received;
+}
 
-    TRACY_PLOT("RTP Receive buffer", static_cast<int64_t>(reader.next_ts_to_read.diff(reader.receive_buffer.get_next_ts())) - num_frames);
-
-    const auto read_at = reader.next_ts_to_read.value();
-    reader.receive_buffer.read(read_at, buffer, buffer_size, true);
-    reader.next_ts_to_read += num_frames;
+static_assert(
+    rav::rtp::AudioReceiver::k_max_num_sessions <= rav::rtp::IoUringReceiveRing::k_max_num_sockets,
+    "Every socket needs a slot in the io_uring receive ring"
+);
 
-    return read_at;
-}
+/// Keeps the receives of the sockets of given shard armed and processes the datagrams received through io_uring.
+/// @return True if at least one valid RTP packet was received, or false if not.
+bool read_incoming_packets_io_uring(
+    rav::rtp::AudioReceiver& receiver, const size_t shard, rav::rtp::IoUringReceiveRing& io_uring, const uint64_t now
+) {
+    const auto num_socket_slots = receiver.num_socket_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_socket_slots; ++i) {
+        auto& ctx = receiver.sockets[i];
+        const auto socket_guard = ctx.rw_lock.try_lock_shared();
+        if (!socket_guard) {
+            continue;  // Exclusively locked, so it either just appeared or is going away.
+        }
+        if (!ctx.socket.is_open() || ctx.shard != shard) {
+            io_uring.disarm(i);
+            continue;
+        }
+        io_uring.arm(i, ctx.generation, ctx.socket.native_handle(), ctx.port);
+    }
 
-void update_stream_active_state(rav::rtp::AudioReceiver::StreamContext& stream, const uint64_t now) {
-    TRACY_ZONE_SCOPED;
-    if ((stream.prev_packet_time_ns + rav::rtp::AudioReceiver::k_receive_timeout_ms * 1'000'000).value() < now) {
-        stream.state.store(rav::rtp::AudioReceiver::StreamState::inactive, std::memory_order_relaxed);
+    bool received = false;
+    std::array<rav::rtp::IoUringReceiveRing::Packet, 64> packets;
+    const auto num_packets = io_uring.receive(packets.data(), packets.size());
+    for (size_t i = 0; i < num_packets; ++i) {
+        const auto& packet = packets[i];
+        if (process_packet(receiver, shard, packet.data, packet.size, packet.src_endpoint, packet.dst_endpoint, packet.recv_time, now)) {
+            received = true;
+        }
     }
+    return received;
 }
 
 }  // namespace
 
+// The slots are allocated on the heap, so the receiver itself can be constructed on the stack.
+static_assert(sizeof(rav::rtp::AudioReceiver) < 64 * 1024);
+
 rav::rtp::AudioReceiver::AudioReceiver(boost::asio::io_context& io_context) {
     join_multicast_group = [](boost::asio::ip::udp::socket& socket, const boost::asio::ip::address_v4& multicast_group,
                               const boost::asio::ip::address_v4& interface_address) {
@@ -445,261 +1797,520 @@ rav::rtp::AudioReceiver::AudioReceiver(boost::asio::io_context& io_context) {
         return true;
     };
 
-    for (size_t i = sockets.size(); i < decltype(sockets)::capacity(); i++) {
-        sockets.emplace_back(io_context);
+    for (size_t i = sockets.size(); i < sockets.capacity(); i++) {
+        sockets.emplace_back(io_context);
+    }
+
+    for (size_t i = readers.size(); i < readers.capacity(); i++) {
+        readers.emplace_back();
+    }
+}
+
+rav::rtp::AudioReceiver::~AudioReceiver() {
+    for (auto& reader : readers) {
+        RAV_ASSERT_NO_THROW(!reader.id.is_valid(), "There should be no active readers at this point");
+    }
+    for (auto& socket : sockets) {
+        RAV_ASSERT_NO_THROW(!socket.socket.is_open(), "There should be no active socket at this point");
+    }
+}
+
+bool rav::rtp::AudioReceiver::set_interfaces(const ArrayOfAddresses& interfaces) {
+    if (!pending_reader_updates.has_value()) {
+        // Diffing the memberships once is linear, where joining and leaving per stream scans all readers for each stream
+        begin_reader_updates();
+        const auto result = set_interfaces(interfaces);
+        return commit_reader_updates() && result;
+    }
+
+    for (auto& reader : readers) {
+        RAV_ASSERT(interfaces.size() == reader.streams.size(), "Size mismatch");
+
+        const auto guard = reader.rw_lock.lock_shared();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to lock reader");
+            return false;
+        }
+
+        for (size_t i = 0; i < reader.streams.size(); i++) {
+            if (reader.streams[i].interface == interfaces[i]) {
+                continue;
+            }
+            const auto stream_guard = reader.streams[i].rw_lock.lock_exclusive();
+            if (!stream_guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock stream");
+                return false;
+            }
+            reader.streams[i].interface = interfaces[i];  // The groups are joined and left by commit_reader_updates
+        }
+    }
+
+    return true;
+}
+
+bool rav::rtp::AudioReceiver::add_reader(const Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces) {
+    RAV_ASSERT(parameters.streams.size() == interfaces.size(), "Should be equal");
+
+    for (auto& reader : readers) {
+        if (reader.id == id) {
+            RAV_LOG_WARNING("A reader for given id already exists");
+            return false;
+        }
+    }
+
+    const auto shard = select_shard(*this, parameters);
+    if (!shard.has_value()) {
+        RAV_LOG_ERROR("The RTP ports of the reader are read by different shards");
+        return false;
+    }
+
+    // Readers of the same streams share the packets and the receive buffer of the first one
+    auto* source = find_source(*this, parameters, interfaces, *shard);
+
+    for (auto& reader : readers) {
+        if (reader.id.is_valid()) {
+            continue;  // Used already. The id is only written by this thread, so the slot doesn't need to be locked.
+        }
+
+        const auto guard = reader.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            return false;
+        }
+
+        const auto result = setup_reader(*this, reader, id, parameters, interfaces, *shard, source);
+        update_packet_mmap_rings(*this);
+        return result;
+    }
+
+    return false;
+}
+
+bool rav::rtp::AudioReceiver::remove_reader(const Id id) {
+    erase_pending_reader_updates(*this, id);
+
+    // Besides the active slot, this also releases the slots of a scheduled update.
+    bool removed = false;
+    for (auto& reader : readers) {
+        if (reader.id == id) {
+            const auto guard = reader.rw_lock.lock_exclusive();
+            if (!guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock reader");
+                return false;
+            }
+
+            release_reader(*this, reader);
+            removed = true;
+        }
+    }
+
+    if (removed) {
+        close_unused_sockets(*this);
+        update_packet_mmap_rings(*this);
+    }
+
+    return removed;
+}
+
+bool rav::rtp::AudioReceiver::update_reader(const Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces) {
+    RAV_ASSERT(parameters.streams.size() == interfaces.size(), "Should be equal");
+
+    for (auto& reader : readers) {
+        if (!is_active_reader(reader, id)) {
+            continue;
+        }
+
+        if (!can_update_reader_in_place(*this, reader, parameters, interfaces)) {
+            return false;
+        }
+
+        if (pending_reader_updates.has_value()) {
+            erase_pending_reader_updates(*this, id);
+            pending_reader_updates->push_back({id, parameters, interfaces});
+            return true;
+        }
+
+        // Only the streams are locked, so that the audio thread keeps reading from the receive buffer.
+        const auto guard = reader.rw_lock.lock_shared();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to lock reader");
+            return false;
+        }
+
+        const auto resync = is_timeline_changed(reader, parameters);
+        for (size_t i = 0; i < reader.streams.size(); ++i) {
+            auto& stream = reader.streams[i];
+            if (is_stream_unchanged(stream, parameters.streams[i], interfaces[i])) {
+                continue;
+            }
+
+            const auto stream_guard = stream.rw_lock.lock_exclusive();
+            if (!stream_guard) {
+                RAV_LOG_ERROR("Failed to exclusively lock stream");
+                return false;
+            }
+
+            if (stream.session.valid() && stream.session.connection_address.is_multicast() && !stream.interface.is_unspecified()) {
+                std::ignore =
+                    leave_multicast_group_if_last(*this, stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port);
+            }
+
+            set_stream_session(stream, parameters.streams[i], interfaces[i]);
+            open_stream(*this, stream, reader.shard);
+        }
+        if (resync) {
+            reader.resync_request.write(true);
+        }
+
+        close_unused_sockets(*this);
+        update_packet_mmap_rings(*this);
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<bool> rav::rtp::AudioReceiver::update_readers(const std::vector<ReaderUpdate>& updates) {
+    const auto memberships_before = collect_multicast_memberships(*this);
+    auto results = apply_reader_updates(*this, updates);
+
+    if (std::none_of(results.begin(), results.end(), [](const bool result) {
+            return result;
+        })) {
+        return results;
+    }
+
+    // Only the groups which are no longer used by any reader are left, and only the new ones are joined
+    sync_multicast_memberships(*this, memberships_before);
+    return results;
+}
+
+void rav::rtp::AudioReceiver::begin_reader_updates() {
+    if (!pending_reader_updates.has_value()) {
+        pending_reader_updates.emplace();
+        batch_memberships = collect_multicast_memberships(*this);
+    }
+}
+
+bool rav::rtp::AudioReceiver::commit_reader_updates() {
+    if (!pending_reader_updates.has_value()) {
+        return false;
+    }
+
+    const auto updates = std::move(*pending_reader_updates);
+    pending_reader_updates.reset();
+
+    const auto results = apply_reader_updates(*this, updates);
+    sync_multicast_memberships(*this, std::exchange(batch_memberships, {}));
+    return std::all_of(results.begin(), results.end(), [](const bool result) {
+        return result;
+    });
+}
+
+bool rav::rtp::AudioReceiver::schedule_reader_update(
+    const Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces, const uint32_t activation_timestamp
+) {
+    RAV_ASSERT(parameters.streams.size() == interfaces.size(), "Should be equal");
+
+    // Finish or cancel a previously scheduled update first, so that there is a single staged slot.
+    std::ignore = complete_scheduled_update(id);
+    std::ignore = cancel_scheduled_update(id);
+
+    Reader* active = nullptr;
+    for (auto& reader : readers) {
+        if (is_active_reader(reader, id)) {
+            active = &reader;
+            break;
+        }
+    }
+
+    if (active == nullptr) {
+        return false;
+    }
+
+    if (active->audio_format != parameters.audio_format) {
+        return false;  // The staged slot must produce the same data as the active slot
+    }
+
+    const auto shard = select_shard(*this, parameters);
+    if (!shard.has_value()) {
+        RAV_LOG_ERROR("The RTP ports of the reader are read by different shards");
+        return false;
+    }
+
+    for (size_t i = 0; i < readers.size(); ++i) {
+        auto& staged = readers[i];
+        if (staged.id.is_valid()) {
+            continue;  // Used already. The id is only written by this thread, so the slot doesn't need to be locked.
+        }
+
+        const auto guard = staged.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            return false;
+        }
+
+        // Marked as staged before the slot gets an id, so that it's never mistaken for the active slot.
+        staged.activation.store(Activation::staged, std::memory_order_release);
+        if (!setup_reader(*this, staged, id, parameters, interfaces, *shard)) {
+            reset_reader(staged);
+            return false;
+        }
+
+        staged.shared_buffer = active->shared_buffer;
+        update_packet_mmap_rings(*this);
+        active->scheduled_activation_request.write(ScheduledActivation {i, activation_timestamp});
+        return true;
+    }
+
+    RAV_LOG_ERROR("No free reader to schedule the update");
+    return false;
+}
+
+std::optional<uint32_t> rav::rtp::AudioReceiver::complete_scheduled_update(const Id id) {
+    for (auto& reader : readers) {
+        if (reader.id != id || reader.activation.load(std::memory_order_acquire) != Activation::retired) {
+            continue;
+        }
+
+        const auto guard = reader.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            return std::nullopt;
+        }
+
+        release_reader(*this, reader);
+        close_unused_sockets(*this);
+        update_packet_mmap_rings(*this);
+
+        for (auto& active : readers) {
+            if (is_active_reader(active, id)) {
+                return active.activated_at.load(std::memory_order_relaxed);
+            }
+        }
+        return std::nullopt;
+    }
+
+    return std::nullopt;
+}
+
+bool rav::rtp::AudioReceiver::cancel_scheduled_update(const Id id) {
+    for (auto& reader : readers) {
+        if (reader.id != id || reader.activation.load(std::memory_order_acquire) != Activation::staged) {
+            continue;
+        }
+
+        for (auto& active : readers) {
+            if (is_active_reader(active, id)) {
+                active.scheduled_activation_request.write(std::nullopt);
+            }
+        }
+
+        const auto guard = reader.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            return false;
+        }
+
+        if (reader.activation.load(std::memory_order_acquire) != Activation::staged) {
+            return false;  // The audio thread switched in the meantime
+        }
+
+        release_reader(*this, reader);
+        close_unused_sockets(*this);
+        update_packet_mmap_rings(*this);
+        return true;
+    }
+
+    return false;
+}
+
+bool rav::rtp::AudioReceiver::has_scheduled_update(const Id id) const {
+    for (auto& reader : readers) {
+        if (reader.id == id && reader.activation.load(std::memory_order_acquire) != Activation::active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool rav::rtp::AudioReceiver::set_num_shards(const size_t num_shards_to_set) {
+    if (num_shards_to_set == 0 || num_shards_to_set > k_max_num_shards) {
+        RAV_LOG_ERROR("Invalid number of shards: {}", num_shards_to_set);
+        return false;
+    }
+
+    for (auto& reader : readers) {
+        if (reader.id.is_valid()) {
+            RAV_LOG_ERROR("Can't change the number of shards while readers are active");
+            return false;
+        }
+    }
+
+    for (auto& shard : shards) {
+        if (shard.io_uring != nullptr) {
+            RAV_LOG_ERROR("Can't change the number of shards after enabling io_uring");
+            return false;
+        }
+    }
+
+    num_shards = num_shards_to_set;
+    return true;
+}
+
+size_t rav::rtp::AudioReceiver::get_num_shards() const {
+    return num_shards;
+}
+
+bool rav::rtp::AudioReceiver::enable_io_uring(const IoUringOptions& options) {
+    if (packet_mmap_options.has_value()) {
+        RAV_LOG_ERROR("Can't enable io_uring when receiving from AF_PACKET rings");
+        return false;
     }
 
-    for (size_t i = readers.size(); i < decltype(readers)::capacity(); i++) {
-        readers.emplace_back();
+    for (size_t i = 0; i < num_shards; ++i) {
+        if (shards[i].io_uring != nullptr) {
+            continue;
+        }
+        shards[i].io_uring = IoUringReceiveRing::create(options);
+        if (shards[i].io_uring == nullptr) {
+            for (auto& shard : shards) {
+                shard.io_uring.reset();
+            }
+            return false;
+        }
     }
+    return true;
 }
 
-rav::rtp::AudioReceiver::~AudioReceiver() {
-    for (auto& reader : readers) {
-        RAV_ASSERT_NO_THROW(!reader.id.is_valid(), "There should be no active readers at this point");
-    }
-    for (auto& socket : sockets) {
-        RAV_ASSERT_NO_THROW(!socket.socket.is_open(), "There should be no active socket at this point");
+bool rav::rtp::AudioReceiver::enable_packet_mmap(const PacketMmapOptions& options) {
+    for (auto& shard : shards) {
+        if (shard.io_uring != nullptr) {
+            RAV_LOG_ERROR("Can't enable AF_PACKET rings when receiving through io_uring");
+            return false;
+        }
     }
-}
 
-bool rav::rtp::AudioReceiver::set_interfaces(const ArrayOfAddresses& interfaces) {
     for (auto& reader : readers) {
-        RAV_ASSERT(interfaces.size() == reader.streams.size(), "Size mismatch");
-
-        const auto guard = reader.rw_lock.lock_exclusive();
-        if (!guard) {
-            RAV_LOG_ERROR("Failed to exclusively lock writer");
+        if (reader.id.is_valid()) {
+            RAV_LOG_ERROR("Can't enable AF_PACKET rings while readers are active");
             return false;
         }
+    }
 
-        for (size_t i = 0; i < reader.streams.size(); i++) {
-            if (reader.streams[i].interface == interfaces[i]) {
-                continue;
-            }
-            if (!reader.streams[i].interface.is_unspecified()) {
-                if (reader.streams[i].session.connection_address.is_multicast()) {
-                    std::ignore = leave_multicast_group_if_last(
-                        *this, reader.streams[i].session.connection_address.to_v4(), reader.streams[i].interface,
-                        reader.streams[i].session.rtp_port
-                    );
-                }
-            }
-            reader.streams[i].interface = {};
-            if (!interfaces[i].is_unspecified()) {
-                if (reader.streams[i].session.connection_address.is_multicast()) {
-                    const auto count = count_multicast_groups(
-                        *this, reader.streams[i].session.connection_address.to_v4(), interfaces[i], reader.streams[i].session.rtp_port
-                    );
-                    if (count == 0) {
-                        auto* socket = find_socket(*this, reader.streams[i].session.rtp_port);
-                        RAV_ASSERT(socket != nullptr, "Socket not found");
-                        if (!join_multicast_group(*socket, reader.streams[i].session.connection_address.to_v4(), interfaces[i])) {
-                            RAV_LOG_ERROR("Failed to join multicast group");
-                        }
-                    }
-                }
-            }
-            reader.streams[i].interface = interfaces[i];
-        }
+    // The rings are created once the readers are added, but fail early when AF_PACKET is not available.
+    if (PacketMmapReceiveRing::create({}, options) == nullptr) {
+        return false;
     }
 
-    close_unused_sockets(*this);
+    packet_mmap_options = options;
     return true;
 }
 
-bool rav::rtp::AudioReceiver::add_reader(const Id id, const ReaderParameters& parameters, const ArrayOfAddresses& interfaces) {
-    RAV_ASSERT(parameters.streams.size() == interfaces.size(), "Should be equal");
-
+bool rav::rtp::AudioReceiver::set_memory_arena(std::shared_ptr<MemoryArena> arena) {
     for (auto& reader : readers) {
-        if (reader.id == id) {
-            RAV_LOG_WARNING("A reader for given id already exists");
+        if (reader.id.is_valid()) {
+            RAV_LOG_ERROR("Can't change the memory arena while readers are active");
             return false;
         }
     }
 
+    // Release the buffers which idle readers hold on to, which might come from the previous arena.
     for (auto& reader : readers) {
         const auto guard = reader.rw_lock.lock_exclusive();
         if (!guard) {
             RAV_LOG_ERROR("Failed to exclusively lock reader");
             return false;
         }
-
-        if (reader.id.is_valid()) {
-            continue;  // Used already
-        }
-
-        return setup_reader(*this, reader, id, parameters, interfaces);
+        set_reader_allocator(reader, arena.get());
     }
 
-    return false;
+    memory_arena = std::move(arena);
+    return true;
 }
 
-bool rav::rtp::AudioReceiver::remove_reader(const Id id) {
-    for (auto& reader : readers) {
-        if (reader.id == id) {
-            const auto guard = reader.rw_lock.lock_exclusive();
-            if (!guard) {
-                RAV_LOG_ERROR("Failed to exclusively lock reader");
-                return false;
-            }
-
-            for (auto& stream : reader.streams) {
-                if (stream.session.valid() && stream.session.connection_address.is_multicast() && !stream.interface.is_unspecified()) {
-                    std::ignore = leave_multicast_group_if_last(
-                        *this, stream.session.connection_address.to_v4(), stream.interface, stream.session.rtp_port
-                    );
-                }
-            }
-
-            reset_reader(reader);
-            close_unused_sockets(*this);
-
-            return true;
-        }
+void rav::rtp::AudioReceiver::read_incoming_packets() {
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+        read_incoming_packets(shard);
     }
-    return false;
 }
 
-void rav::rtp::AudioReceiver::read_incoming_packets() {
+void rav::rtp::AudioReceiver::read_incoming_packets(const size_t shard) {
     TRACY_ZONE_SCOPED;
 
-    const auto now = clock::now_monotonic_high_resolution_ns();
-
-    for (auto& ctx : sockets) {
-        const auto socket_guard = ctx.rw_lock.try_lock_shared();
-        if (!socket_guard) {
-            continue;  // Exclusively locked, so it either just appeared or is going away.
-        }
-
-        if (!ctx.socket.is_open()) {
-            continue;  // This means unused. I think the call is stable and will not be changed externally.
-        }
-
-        boost::system::error_code ec;
-        std::array<uint8_t, aes67::constants::k_mtu> receive_buffer {};
-        boost::asio::ip::udp::endpoint src_endpoint;
-        boost::asio::ip::udp::endpoint dst_endpoint;
-        uint64_t recv_time = 0;
-        const auto bytes_received = receive_from_socket(ctx.socket, receive_buffer, src_endpoint, dst_endpoint, recv_time, ec);
-
-        if (ec == boost::asio::error::try_again) {
-            // Normally you would call ctx.socket.available(ec); to test if there is data available, but to safe time we
-            // test for boost::asio::error::try_again.
-            continue;
-        }
-
-        if (ec) {
-            // RAV_LOG_ERROR("Failed to receive from socket: {}", ec.message());
-            // TODO: Report error
-            continue;
-        }
+    RAV_ASSERT_DEBUG(shard < num_shards, "Shard out of range");
 
-        if (bytes_received == 0) {
-            continue;
-        }
+    const auto now = clock::now_monotonic_high_resolution_ns();
+    auto& shard_state = shards[shard];
 
-        PacketView view(receive_buffer.data(), bytes_received);
-        if (!view.validate()) {
-            continue;  // Invalid RTP packet
+    if (auto* io_uring = shard_state.io_uring.get()) {
+        if (read_incoming_packets_io_uring(*this, shard, *io_uring, now)) {
+            shard_state.last_time_maintenance = now;
         }
-
-        const auto payload = view.payload_data();
-        if (payload.size_bytes() == 0) {
-            return;  // Received packet with empty payload
+    } else if (packet_mmap_options.has_value()) {
+        if (read_incoming_packets_packet_mmap(*this, shard, now)) {
+            shard_state.last_time_maintenance = now;
         }
+    } else {
+        const auto num_socket_slots = num_socket_slots_in_use.load(std::memory_order_acquire);
+        for (size_t i = 0; i < num_socket_slots; ++i) {
+            auto& ctx = sockets[i];
+            const auto socket_guard = ctx.rw_lock.try_lock_shared();
+            if (!socket_guard) {
+                continue;  // Exclusively locked, so it either just appeared or is going away.
+            }
 
-        if (payload.size_bytes() > std::numeric_limits<uint16_t>::max()) {
-            return;  // Payload size exceeds maximum size
-        }
+            if (!ctx.socket.is_open()) {
+                continue;  // This means unused. I think the call is stable and will not be changed externally.
+            }
 
-        for (auto& reader : readers) {
-            const auto reader_guard = reader.rw_lock.try_lock_shared();
-            if (!reader_guard) {
-                continue;  // Failed to lock which means it is being added or removed.
+            if (ctx.shard != shard) {
+                continue;  // Read by the network thread of another shard
             }
 
-            if (!reader.id.is_valid()) {
+            // Only the polls which return a datagram are accounted, otherwise the idle polls would dominate the percentiles
+            const auto begin_ns = clock::now_monotonic_high_resolution_ns();
+            boost::system::error_code ec;
+            std::array<uint8_t, aes67::constants::k_mtu> receive_buffer {};
+            boost::asio::ip::udp::endpoint src_endpoint;
+            boost::asio::ip::udp::endpoint dst_endpoint;
+            uint64_t recv_time = 0;
+            const auto bytes_received =
+                receive_from_socket(ctx.socket, ctx.port, receive_buffer, src_endpoint, dst_endpoint, recv_time, ec);
+
+            if (ec == boost::asio::error::try_again) {
+                // Normally you would call ctx.socket.available(ec); to test if there is data available, but to safe time we
+                // test for boost::asio::error::try_again.
                 continue;
             }
 
-            for (auto& stream : reader.streams) {
-                if (stream.session.connection_address != dst_endpoint.address()) {
-                    continue;
-                }
-                if (stream.session.rtp_port != dst_endpoint.port()) {
-                    continue;
-                }
-                if (!stream.filter.is_valid_source(dst_endpoint.address(), src_endpoint.address())) {
-                    continue;
-                }
-
-                update_stream_active_state(stream, now);
-
-                if (!stream.rtp_ts.has_value()) {
-                    stream.rtp_ts = view.timestamp();
-                    stream.prev_packet_time_ns = recv_time;
-                }
-
-                PacketBuffer packet {};
-                packet.timestamp = view.timestamp();
-                packet.seq = view.sequence_number();
-                packet.data_len = static_cast<uint16_t>(payload.size_bytes());
-                packet.recv_time = recv_time;
-                std::memcpy(packet.payload.data(), payload.data(), payload.size_bytes());
-
-                auto state = stream.state.load(std::memory_order_relaxed);
-                if (stream.packets.push(packet)) {
-                    stream.state.store(StreamState::receiving, std::memory_order_relaxed);
-                } else if (state != StreamState::no_consumer) {
-                    stream.state.store(StreamState::no_consumer, std::memory_order_relaxed);
-                }
-
-                {
-                    // This block compares the rtp timestamp against the recv_time converted to PTP scale.
-                    const auto& local_clock = ptp_instance_subscriber.get_local_clock();
-                    if (local_clock.is_locked()) {
-                        auto ptp_time = local_clock.get_adjusted_time(recv_time);
-                        [[maybe_unused]] auto rtp_time = ptp_time.from_rtp_timestamp32(packet.timestamp, reader.audio_format.sample_rate);
-                        TRACY_PLOT("receive latency (ms)", ptp_time.to_milliseconds_double() - rtp_time.to_milliseconds_double());
-                    }
-                }
-
-                while (auto seq = stream.packets_too_old.pop()) {
-                    stream.packet_stats.mark_packet_too_late(*seq);
-                }
+            if (ec) {
+                RAV_LOG_ERROR_REALTIME("Failed to receive from socket (error {})", ec.value());
+                continue;
+            }
 
-                if (const auto interval = stream.prev_packet_time_ns.update(recv_time)) {
-                    if (stream.packet_interval_stats.initialized || *interval != 0) {
-                        if (stream.reset_max_values.exchange(false, std::memory_order_acq_rel)) {
-                            stream.packet_interval_stats.max_deviation = {};
-                        }
-                        stream.packet_interval_stats.update(static_cast<double>(*interval) / 1'000'000.0);
-                        TRACY_PLOT("packet interval (ms)", static_cast<double>(*interval) / 1'000'000.0);
-                        TRACY_PLOT("packet interval EMA (ms)", stream.packet_interval_stats.interval);
-                        TRACY_PLOT("packet interval MAX (ms)", stream.packet_interval_stats.max_deviation);
-                    }
-                }
+            if (bytes_received == 0) {
+                continue;
+            }
 
-                std::ignore = stream.packet_stats.update(view.sequence_number());
-                auto stats = stream.packet_stats.get_total_counts();
-                stats.jitter = stream.packet_interval_stats.max_deviation;
-                stream.packet_stats_counters.write(stats);
+            if (process_packet(*this, shard, receive_buffer.data(), bytes_received, src_endpoint, dst_endpoint, recv_time, now)) {
+                shard_state.last_time_maintenance = now;
             }
+            ctx.receive_cost.add(clock::now_monotonic_high_resolution_ns() - begin_ns);
         }
-
-        last_time_maintenance = now;
     }
 
     // Do maintenance if not done for a while
-    if (last_time_maintenance + k_receive_timeout_ms * 1'000'000 < now) {
-        for (auto& reader : readers) {
+    if (shard_state.last_time_maintenance + k_receive_timeout_ms * 1'000'000 < now) {
+        const auto num_reader_slots = num_reader_slots_in_use.load(std::memory_order_acquire);
+        for (size_t i = 0; i < num_reader_slots; ++i) {
+            auto& reader = readers[i];
             const auto reader_guard = reader.rw_lock.try_lock_shared();
             if (!reader_guard) {
                 continue;  // Failed to lock which means it is being added or removed.
             }
 
-            if (!reader.id.is_valid()) {
+            if (!reader.id.is_valid() || reader.shard != shard || reader.source != nullptr) {
                 continue;
             }
 
@@ -707,7 +2318,7 @@ void rav::rtp::AudioReceiver::read_incoming_packets() {
                 update_stream_active_state(stream, now);
             }
         }
-        last_time_maintenance = now;
+        shard_state.last_time_maintenance = now;
     }
 }
 
@@ -717,16 +2328,28 @@ std::optional<uint32_t> rav::rtp::AudioReceiver::read_data_realtime(
 ) {
     TRACY_ZONE_SCOPED;
 
-    for (auto& reader : readers) {
+    const auto num_reader_slots = num_reader_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_reader_slots; ++i) {
+        auto& reader = readers[i];
         const auto guard = reader.rw_lock.try_lock_shared();
         if (!guard) {
             TRACY_MESSAGE("Failed to lock reader");
             continue;
         }
-        if (reader.id != id) {
+        if (!is_active_reader(reader, id)) {
             continue;
         }
-        return read_data_from_reader_realtime(reader, buffer, buffer_size, at_timestamp, require_delay);
+        std::optional<AtomicRwLock::AccessGuard<AtomicRwLock::Shared>> source_guard;
+        if (!try_lock_source(reader, source_guard)) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return std::nullopt;
+        }
+        const auto ingest_guard = try_lock_ingest(reader);
+        if (!ingest_guard) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return std::nullopt;
+        }
+        return read_data_with_activation_realtime(*this, reader, buffer, buffer_size, at_timestamp, require_delay);
     }
 
     return std::nullopt;
@@ -741,12 +2364,14 @@ std::optional<uint32_t> rav::rtp::AudioReceiver::read_audio_data_realtime(
     RAV_ASSERT_DEBUG(id.is_valid(), "Id should be valid");
     RAV_ASSERT_DEBUG(output_buffer.is_valid(), "Buffer must be valid");
 
-    for (auto& reader : readers) {
+    const auto num_reader_slots = num_reader_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_reader_slots; ++i) {
+        auto& reader = readers[i];
         const auto guard = reader.rw_lock.try_lock_shared();
         if (!guard) {
             continue;
         }
-        if (reader.id != id) {
+        if (!is_active_reader(reader, id)) {
             continue;
         }
 
@@ -757,23 +2382,37 @@ std::optional<uint32_t> rav::rtp::AudioReceiver::read_audio_data_realtime(
             return std::nullopt;
         }
 
+        std::optional<AtomicRwLock::AccessGuard<AtomicRwLock::Shared>> source_guard;
+        if (!try_lock_source(reader, source_guard)) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return std::nullopt;
+        }
+        const auto ingest_guard = try_lock_ingest(reader);
+        if (!ingest_guard) {
+            reader.audio_thread_metrics.reads_without_data.increment();
+            return std::nullopt;
+        }
+
+        update_asrc_parameters(reader, reader.asrc);
+        if (reader.asrc.parameters.has_value()) {
+            return read_audio_data_with_asrc_realtime(*this, reader, output_buffer);
+        }
+
         auto& buffer = reader.read_audio_data_buffer;
-        const auto read_at = read_data_from_reader_realtime(
-            reader, buffer.data(), output_buffer.num_frames() * format.bytes_per_frame(), at_timestamp, require_delay
+        Reader* activated = nullptr;
+        const auto read_at = read_data_with_activation_realtime(
+            *this, reader, buffer.data(), output_buffer.num_frames() * format.bytes_per_frame(), at_timestamp, require_delay, &activated
         );
 
         if (!read_at.has_value()) {
             return std::nullopt;
         }
 
-        if (format.encoding == AudioEncoding::pcm_s16) {
-            AudioData::convert<int16_t, AudioData::ByteOrder::Be, AudioData::Interleaving::Interleaved, float, AudioData::ByteOrder::Ne>(
-                reinterpret_cast<int16_t*>(buffer.data()), output_buffer.num_frames(), output_buffer.num_channels(), output_buffer.data()
-            );
-        } else if (format.encoding == AudioEncoding::pcm_s24) {
-            AudioData::convert<int24_t, AudioData::ByteOrder::Be, AudioData::Interleaving::Interleaved, float, AudioData::ByteOrder::Ne>(
-                reinterpret_cast<int24_t*>(buffer.data()), output_buffer.num_frames(), output_buffer.num_channels(), output_buffer.data()
-            );
+        if (reader.pipeline.is_valid()) {
+            reader.pipeline.decode(buffer.data(), output_buffer.num_frames(), output_buffer.num_channels(), output_buffer.data());
+            if (activated == nullptr) {
+                spread_adaptive_correction(reader, *read_at, output_buffer);
+            }
         }
 
         return read_at;
@@ -782,9 +2421,124 @@ std::optional<uint32_t> rav::rtp::AudioReceiver::read_audio_data_realtime(
     return std::nullopt;
 }
 
+bool rav::rtp::AudioReceiver::set_adaptive_delay(const Id id, const std::optional<AdaptiveDelayParameters>& parameters) {
+    if (parameters.has_value() && !parameters->is_valid()) {
+        RAV_LOG_ERROR("Invalid adaptive delay parameters");
+        return false;
+    }
+
+    for (auto& reader : readers) {
+        const auto guard = reader.rw_lock.try_lock_shared();
+        if (!guard) {
+            continue;
+        }
+        if (!is_active_reader(reader, id)) {
+            continue;
+        }
+        reader.adaptive_delay_parameters.write(parameters);
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<uint32_t> rav::rtp::AudioReceiver::get_delay(const Id id) const {
+    for (auto& reader : readers) {
+        if (is_active_reader(reader, id)) {
+            return static_cast<uint32_t>(reader.audio_thread_metrics.delay_frames.get());
+        }
+    }
+    return std::nullopt;
+}
+
+bool rav::rtp::AudioReceiver::set_asrc(const Id id, const std::optional<AsrcParameters>& parameters) {
+    if (parameters.has_value() && !parameters->is_valid()) {
+        RAV_LOG_ERROR("Invalid ASRC parameters");
+        return false;
+    }
+
+    for (auto& reader : readers) {
+        const auto guard = reader.rw_lock.try_lock_shared();
+        if (!guard) {
+            continue;
+        }
+        if (!is_active_reader(reader, id)) {
+            continue;
+        }
+        reader.asrc_parameters.write(parameters);
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<rav::rtp::AudioReceiver::AsrcStatus> rav::rtp::AudioReceiver::get_asrc_status(const Id id) const {
+    for (auto& reader : readers) {
+        if (is_active_reader(reader, id)) {
+            const auto& audio_thread_metrics = reader.audio_thread_metrics;
+            return AsrcStatus {
+                audio_thread_metrics.asrc_fill_frames.get(),
+                audio_thread_metrics.asrc_ratio_deviation_ppm.get(),
+                audio_thread_metrics.asrc_resets.get(),
+            };
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<rav::rtp::AudioReceiver::ReaderCost> rav::rtp::AudioReceiver::get_reader_cost(const Id id) const {
+    for (auto& reader : readers) {
+        if (is_active_reader(reader, id)) {
+            // The packets of a tap are processed by its source, of which the cost is shared by all its readers
+            const auto& ingest = get_ingest(reader);
+            ReaderCost cost;
+            cost.read = reader.audio_thread_metrics.read_cost.get_snapshot();
+            cost.maintenance = ingest.audio_thread_metrics.maintenance_cost.get_snapshot();
+            for (size_t i = 0; i < ingest.streams.size(); ++i) {
+                cost.packet_processing[i] = ingest.streams[i].network_thread_metrics.processing_cost.get_snapshot();
+            }
+            return cost;
+        }
+    }
+    return std::nullopt;
+}
+
+bool rav::rtp::AudioReceiver::set_shared_buffer(const Id id, std::shared_ptr<SharedAudioBuffer> buffer) {
+    bool found = false;
+
+    // Applies to the staged slot of the reader as well, which takes over exporting when it becomes active.
+    for (auto& reader : readers) {
+        if (reader.id != id) {
+            continue;
+        }
+
+        if (buffer != nullptr) {
+            if (buffer->get_audio_format() != reader.audio_format) {
+                RAV_LOG_ERROR("The audio format of the shared buffer doesn't match the reader");
+                return false;
+            }
+            if (buffer->get_capacity_frames() < reader.packet_time_frames) {
+                RAV_LOG_ERROR("The shared buffer is too small for the packets of the reader");
+                return false;
+            }
+        }
+
+        const auto guard = reader.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock reader");
+            return false;
+        }
+
+        reader.shared_buffer = buffer;
+        found = true;
+    }
+
+    return found;
+}
+
 std::optional<rav::rtp::PacketStats::Counters> rav::rtp::AudioReceiver::get_packet_stats(const Id reader_id, const size_t stream_index) {
     for (auto& reader : readers) {
-        if (reader.id != reader_id) {
+        if (!is_active_reader(reader, reader_id)) {
             continue;
         }
         const auto guard = reader.rw_lock.try_lock_shared();
@@ -797,7 +2551,8 @@ std::optional<rav::rtp::PacketStats::Counters> rav::rtp::AudioReceiver::get_pack
             return std::nullopt;
         }
 
-        auto& stream = reader.streams[stream_index];
+        // The source of a tap is only released by this thread, so it can be read without locking it
+        auto& stream = get_ingest(reader).streams[stream_index];
         stream.reset_max_values.store(true, std::memory_order_release);
         return stream.packet_stats_counters.read(boost::lockfree::uses_optional);
     }
@@ -808,18 +2563,126 @@ std::optional<rav::rtp::PacketStats::Counters> rav::rtp::AudioReceiver::get_pack
 std::optional<rav::rtp::AudioReceiver::StreamState>
 rav::rtp::AudioReceiver::get_stream_state(const Id reader_id, const size_t stream_index) const {
     for (auto& reader : readers) {
-        if (reader.id == reader_id) {
+        if (is_active_reader(reader, reader_id)) {
             if (stream_index >= reader.streams.size()) {
                 RAV_ASSERT_FALSE("Index out of bounds");
                 return {};
             }
 
-            return reader.streams[stream_index].state.load(std::memory_order_relaxed);
+            return get_ingest(reader).streams[stream_index].state.load(std::memory_order_relaxed);
         }
     }
     return {};
 }
 
+void rav::rtp::AudioReceiver::collect_metrics(metrics::PrometheusWriter& writer) {
+    for (auto& reader : readers) {
+        const auto guard = reader.rw_lock.try_lock_shared();
+        if (!guard) {
+            continue;
+        }
+        if (!reader.id.is_valid() || reader.activation.load(std::memory_order_acquire) != Activation::active) {
+            continue;  // The slots of a scheduled update are reported once they become active
+        }
+
+        const auto reader_id = std::to_string(reader.id.value());
+        const metrics::PrometheusWriter::Labels reader_labels {{"reader", reader_id}};
+
+        auto& audio_thread_metrics = reader.audio_thread_metrics;
+        writer.add_counter(
+            "rav_rtp_reader_reads_total", "Number of successful reads by the consumer.", reader_labels, audio_thread_metrics.reads.get()
+        );
+        writer.add_counter(
+            "rav_rtp_reader_reads_without_data_total", "Number of reads which failed because no (or not enough) data was available.",
+            reader_labels, audio_thread_metrics.reads_without_data.get()
+        );
+        writer.add_counter(
+            "rav_rtp_reader_packets_too_late_total", "Number of packets which arrived too late to be consumed.", reader_labels,
+            audio_thread_metrics.packets_too_late.get()
+        );
+        writer.add_counter(
+            "rav_rtp_reader_frames_repeated_total", "Number of frames repeated by the adaptive delay to raise the delay.",
+            reader_labels, audio_thread_metrics.frames_repeated.get()
+        );
+        writer.add_counter(
+            "rav_rtp_reader_frames_skipped_total", "Number of frames skipped by the adaptive delay to lower the delay.",
+            reader_labels, audio_thread_metrics.frames_skipped.get()
+        );
+        writer.add_gauge(
+            "rav_rtp_reader_delay_frames", "The delay in frames between the most recent received frame and the last frame read.",
+            reader_labels, audio_thread_metrics.delay_frames.get()
+        );
+        writer.add_gauge(
+            "rav_rtp_reader_asrc_fill_frames", "The number of frames received but not yet played out, as seen by the ASRC.",
+            reader_labels, audio_thread_metrics.asrc_fill_frames.get()
+        );
+        writer.add_gauge(
+            "rav_rtp_reader_asrc_ratio_deviation_ppm", "The deviation of the ASRC ratio from 1 in parts per million.", reader_labels,
+            audio_thread_metrics.asrc_ratio_deviation_ppm.get()
+        );
+        writer.add_counter(
+            "rav_rtp_reader_asrc_resets_total", "Number of times the ASRC reset the fill level after an underrun or overrun.",
+            reader_labels, audio_thread_metrics.asrc_resets.get()
+        );
+        writer.add_histogram(
+            "rav_rtp_reader_read_cost_us", "Time per read by the audio thread in microseconds.", reader_labels,
+            audio_thread_metrics.read_cost.get_histogram()
+        );
+        writer.add_histogram(
+            "rav_rtp_reader_maintenance_cost_us", "Time per realtime maintenance pass by the audio thread in microseconds.",
+            reader_labels, audio_thread_metrics.maintenance_cost.get_histogram()
+        );
+
+        if (reader.source != nullptr) {
+            continue;  // The streams of a tap are received, and reported, by its source
+        }
+
+        for (size_t i = 0; i < reader.streams.size(); ++i) {
+            auto& stream = reader.streams[i];
+            if (!stream.session.valid()) {
+                continue;
+            }
+
+            const metrics::PrometheusWriter::Labels labels {{"reader", reader_id}, {"stream", std::to_string(i)}};
+            auto& network_thread_metrics = stream.network_thread_metrics;
+
+            writer.add_counter(
+                "rav_rtp_stream_packets_received_total", "Number of RTP packets received.", labels,
+                network_thread_metrics.packets_received.get()
+            );
+            writer.add_counter(
+                "rav_rtp_stream_bytes_received_total", "Number of RTP bytes received.", labels, network_thread_metrics.bytes_received.get()
+            );
+            writer.add_counter(
+                "rav_rtp_stream_packets_discarded_total", "Number of RTP packets discarded because they were not consumed.", labels,
+                network_thread_metrics.packets_discarded.get()
+            );
+            writer.add_histogram(
+                "rav_rtp_stream_packet_interval_ms", "Interval between consecutive RTP packets in milliseconds.", labels,
+                network_thread_metrics.packet_interval_ms
+            );
+            writer.add_histogram(
+                "rav_rtp_stream_receive_latency_ms", "Time between the RTP timestamp and the arrival of a packet in milliseconds.",
+                labels, network_thread_metrics.receive_latency_ms
+            );
+            writer.add_histogram(
+                "rav_rtp_stream_processing_cost_us", "Time per packet spent by the network thread in microseconds.", labels,
+                network_thread_metrics.processing_cost.get_histogram()
+            );
+        }
+    }
+
+    for (auto& socket : sockets) {
+        if (socket.port == 0) {
+            continue;
+        }
+        writer.add_histogram(
+            "rav_rtp_socket_receive_cost_us", "Time per received datagram spent by the network thread in microseconds.",
+            {{"port", std::to_string(socket.port)}}, socket.receive_cost.get_histogram()
+        );
+    }
+}
+
 const char* rav::rtp::to_string(const AudioReceiver::StreamState state) {
     switch (state) {
         case AudioReceiver::StreamState::inactive:
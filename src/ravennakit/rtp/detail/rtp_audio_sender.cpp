@@ -26,7 +26,7 @@
 #include "ravennakit/rtp/detail/rtp_audio_sender.hpp"
 
 #include "ravennakit/core/random.hpp"
-#include "ravennakit/core/audio/audio_data.hpp"
+#include "ravennakit/core/realtime_log.hpp"
 #include "ravennakit/core/util/stl_helpers.hpp"
 #include "ravennakit/core/util/todo.hpp"
 #include "ravennakit/core/util/tracy.hpp"
@@ -65,20 +65,13 @@ bool set_socket_ttl(rav::udp_socket& socket, const uint8_t ttl) {
     return true;
 }
 
-bool setup_writer(
-    rav::rtp::AudioSender::Writer& writer, const rav::Id id, const rav::rtp::AudioSender::WriterParameters& parameters,
+bool set_socket_options(
+    rav::rtp::AudioSender::Writer& writer, const rav::rtp::AudioSender::WriterParameters& parameters,
     const rav::rtp::AudioSender::ArrayOfAddresses& interfaces
 ) {
-    RAV_ASSERT(writer.rw_lock.is_locked_exclusively(), "Expecting the writer to be locked exclusively");
     RAV_ASSERT(interfaces.size() == writer.sockets.size(), "Unequal size");
 
     for (size_t i = 0; i < writer.sockets.size(); ++i) {
-        if (!writer.sockets[i].is_open()) {
-            if (const auto ec = setup_socket(writer.sockets[i])) {
-                RAV_LOG_ERROR("Failed to open socket for sending: {}", ec.message());
-                return false;
-            }
-        }
         boost::system::error_code ec;
         writer.sockets[i].set_option(boost::asio::ip::multicast::outbound_interface(interfaces[i]), ec);
         if (ec) {
@@ -90,22 +83,77 @@ bool setup_writer(
         }
     }
 
+    return true;
+}
+
+void discard_pending_updates(rav::rtp::AudioSender::Writer& writer) {
+    std::array<rav::udp_endpoint, rav::rtp::AudioSender::k_max_num_redundant_sessions> destinations;
+    std::ignore = writer.pending_destinations.read(destinations);
+    uint8_t payload_type {};
+    std::ignore = writer.pending_payload_type.read(payload_type);
+    writer.scheduled_destinations_request.write(std::nullopt);
+    writer.scheduled_payload_type_request.write(std::nullopt);
+    writer.scheduled_destinations.reset();
+    writer.scheduled_payload_type.reset();
+    writer.update_scheduled = false;
+    writer.scheduled_update_activated.store(false, std::memory_order_relaxed);
+    writer.activated_at.store(0, std::memory_order_relaxed);
+}
+
+/// Moves the buffers of given writer to given arena, releasing the buffers which were allocated elsewhere. Without an
+/// arena the buffers are allocated on the heap.
+void set_writer_allocator(rav::rtp::AudioSender::Writer& writer, rav::MemoryArena* arena) {
+    const rav::ArenaAllocator<uint8_t> allocator(arena);
+    if (writer.intermediate_send_buffer.get_allocator() != allocator) {
+        writer.intermediate_send_buffer = rav::ArenaVector<uint8_t>(allocator);
+    }
+    if (writer.intermediate_audio_buffer.get_allocator() != allocator) {
+        writer.intermediate_audio_buffer = rav::ArenaVector<uint8_t>(allocator);
+    }
+    writer.rtp_buffer.set_allocator(allocator);
+    writer.outgoing_data.set_allocator(rav::ArenaAllocator<rav::rtp::AudioSender::FifoPacket>(arena));
+}
+
+bool setup_writer(
+    rav::rtp::AudioSender::Writer& writer, const rav::Id id, const rav::rtp::AudioSender::WriterParameters& parameters,
+    const rav::rtp::AudioSender::ArrayOfAddresses& interfaces, const size_t shard, rav::MemoryArena* arena
+) {
+    RAV_ASSERT(writer.rw_lock.is_locked_exclusively(), "Expecting the writer to be locked exclusively");
+    RAV_ASSERT(interfaces.size() == writer.sockets.size(), "Unequal size");
+
+    for (size_t i = 0; i < writer.sockets.size(); ++i) {
+        if (!writer.sockets[i].is_open()) {
+            if (const auto ec = setup_socket(writer.sockets[i])) {
+                RAV_LOG_ERROR("Failed to open socket for sending: {}", ec.message());
+                return false;
+            }
+        }
+    }
+
+    if (!set_socket_options(writer, parameters, interfaces)) {
+        return false;
+    }
+
+    discard_pending_updates(writer);
+
     // TODO: Implement proper SSRC generation (RAV-1)
     const auto ssrc = static_cast<uint32_t>(rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
 
     const auto audio_format = parameters.audio_format;
     const auto packet_size_bytes = parameters.packet_time_frames * audio_format.bytes_per_frame();
     writer.audio_format = audio_format;
+    writer.pipeline = rav::rtp::AudioPipeline::get(audio_format);
     writer.packet_time_frames = parameters.packet_time_frames;
     writer.rtp_packet.payload_type(parameters.payload_type);
     writer.rtp_packet.ssrc(ssrc);
+    set_writer_allocator(writer, arena);
     writer.outgoing_data.resize(rav::rtp::AudioSender::k_buffer_num_packets);
     writer.intermediate_audio_buffer.resize(rav::rtp::AudioSender::k_max_num_frames * audio_format.bytes_per_frame());
-    writer.rtp_packet_buffer = rav::ByteBuffer(packet_size_bytes);
     writer.intermediate_send_buffer.resize(packet_size_bytes);
     writer.rtp_buffer.resize(rav::rtp::AudioSender::k_max_num_frames, audio_format.bytes_per_frame());
     writer.rtp_buffer.set_ground_value(audio_format.ground_value());
     writer.destinations = parameters.destinations;
+    writer.shard = shard;
     writer.id = id;
 
     return true;
@@ -114,15 +162,21 @@ bool setup_writer(
 void reset_writer(rav::rtp::AudioSender::Writer& writer) {
     // Not clearing rw_lock to maintain lock
     writer.id = {};
+    writer.shard = {};
     writer.destinations = {};
-    writer.rtp_packet_buffer = {};
     writer.intermediate_send_buffer = {};
     writer.intermediate_audio_buffer = {};
     writer.packet_time_frames = {};
     writer.rtp_packet = {};
     writer.audio_format = {};
+    writer.pipeline = {};
     writer.rtp_buffer = rav::rtp::Ringbuffer {};
     writer.outgoing_data.reset();
+    writer.shared_buffer.reset();
+    writer.shared_buffer_generation.reset();
+    writer.audio_thread_metrics.reset();
+    writer.network_thread_metrics.reset();
+    discard_pending_updates(writer);
 
     for (auto& socket : writer.sockets) {
         if (socket.is_open()) {
@@ -135,22 +189,147 @@ void reset_writer(rav::rtp::AudioSender::Writer& writer) {
     }
 }
 
-boost::system::error_code set_error(rav::rtp::AudioSender& sender, const boost::system::error_code& ec) {
-    if (ec == sender.last_error) {
+boost::system::error_code set_error(rav::rtp::AudioSender::ShardState& shard_state, const boost::system::error_code& ec) {
+    if (ec == shard_state.last_error) {
         return {};
     }
-    sender.last_error = ec;
-    return sender.last_error;
+    shard_state.last_error = ec;
+    return shard_state.last_error;
+}
+
+/// Updates the metrics of the writers with the results of the sends which were done through io_uring.
+void complete_io_uring_sends(rav::rtp::AudioSender& sender, const size_t shard, rav::rtp::IoUringSendRing& io_uring) {
+    std::array<rav::rtp::IoUringSendRing::Completion, 64> completions;
+    while (true) {
+        const auto num_completions = io_uring.complete(completions.data(), completions.size());
+        if (num_completions == 0) {
+            return;
+        }
+
+        for (size_t i = 0; i < num_completions; ++i) {
+            const auto& completion = completions[i];
+            RAV_ASSERT_DEBUG(completion.tag < sender.writers.size(), "Invalid writer index");
+            auto& writer = sender.writers[completion.tag];
+
+            const auto guard = writer.rw_lock.try_lock_shared();
+            if (!guard) {
+                continue;  // The writer is being changed
+            }
+            if (!writer.id.is_valid() || writer.shard != shard) {
+                continue;  // The writer was removed after the packet was sent
+            }
+
+            if (completion.result < 0) {
+                const boost::system::error_code ec(-completion.result, boost::system::system_category());
+                if (const auto new_error = set_error(sender.shards[shard], ec)) {
+                    RAV_LOG_ERROR_REALTIME("Failed to send packet (error {})", new_error.value());
+                }
+                writer.network_thread_metrics.packets_failed_to_send.increment();
+            } else {
+                std::ignore = set_error(sender.shards[shard], {});
+                writer.network_thread_metrics.packets_sent.increment();
+                writer.network_thread_metrics.bytes_sent.increment(static_cast<uint64_t>(completion.result));
+            }
+        }
+    }
+}
+
+/// @return The shard with the fewest writers.
+size_t select_shard(const rav::rtp::AudioSender& sender) {
+    std::array<size_t, rav::rtp::AudioSender::k_max_num_shards> num_writers {};
+    for (auto& writer : sender.writers) {
+        if (writer.id.is_valid()) {
+            num_writers[writer.shard]++;
+        }
+    }
+
+    size_t shard = 0;
+    for (size_t i = 1; i < sender.num_shards; ++i) {
+        if (num_writers[i] < num_writers[shard]) {
+            shard = i;
+        }
+    }
+    return shard;
+}
+
+/// Updates the number of writer slots which the network and audio threads visit, which is one past the last slot in use.
+/// Must be called by the control thread after a slot was taken into use or released.
+void update_slots_in_use(rav::rtp::AudioSender& sender) {
+    auto num_writers = sender.writers.size();
+    while (num_writers > 0 && !sender.writers[num_writers - 1].id.is_valid()) {
+        num_writers--;
+    }
+    sender.num_writer_slots_in_use.store(num_writers, std::memory_order_release);
+}
+
+/// Applies the payload type which was set by the control thread, if any.
+void update_payload_type(rav::rtp::AudioSender::Writer& writer) {
+    uint8_t payload_type {};
+    if (writer.pending_payload_type.read(payload_type)) {
+        writer.rtp_packet.payload_type(payload_type);
+    }
+
+    std::optional<rav::rtp::AudioSender::ScheduledPayloadType> scheduled_payload_type;
+    if (writer.scheduled_payload_type_request.read(scheduled_payload_type)) {
+        writer.scheduled_payload_type = scheduled_payload_type;
+    }
+}
+
+/// Encodes the packet at the timestamp of the RTP packet of given writer from the frames in the intermediate send buffer,
+/// and queues it for sending.
+/// @return False if the packet could not be encoded.
+bool enqueue_packet(rav::rtp::AudioSender::Writer& writer) {
+    TRACY_ZONE_SCOPED;
+
+    auto& rtp_packet = writer.rtp_packet;
+    const auto size_per_packet = writer.packet_time_frames * writer.audio_format.bytes_per_frame();
+
+    if (writer.scheduled_payload_type.has_value()) {
+        if (rtp_packet.get_timestamp() >= rav::WrappingUint32(writer.scheduled_payload_type->rtp_timestamp)) {
+            rtp_packet.payload_type(writer.scheduled_payload_type->payload_type);
+            writer.scheduled_payload_type.reset();
+        }
+    }
+
+    rav::rtp::AudioSender::FifoPacket packet;
+    packet.rtp_timestamp = rtp_packet.get_timestamp().value();
+    const auto packet_size =
+        rtp_packet.encode(writer.intermediate_send_buffer.data(), size_per_packet, packet.payload.data(), packet.payload.size());
+
+    RAV_ASSERT_DEBUG(packet_size > 0, "Packet payload overflow");
+
+    if (packet_size == 0) {
+        return false;
+    }
+
+    packet.payload_size_bytes = static_cast<uint32_t>(packet_size);
+
+    if (writer.outgoing_data.push(packet)) {
+        writer.audio_thread_metrics.packets_scheduled.increment();
+    } else {
+        writer.audio_thread_metrics.packets_failed_to_schedule.increment();
+    }
+
+    rtp_packet.sequence_number_inc(1);
+    rtp_packet.inc_timestamp(writer.packet_time_frames);
+    return true;
 }
 
 bool schedule_data_for_sending_realtime(
-    rav::rtp::AudioSender::Writer& writer, const rav::BufferView<const uint8_t> buffer, const uint32_t timestamp
+    rav::rtp::AudioSender::Writer& writer, const rav::BufferView<const uint8_t> buffer, const uint32_t timestamp,
+    const bool swap_byte_order = false
 ) {
+    if (writer.shared_buffer != nullptr) {
+        return false;  // The writer is fed from the shared buffer by the network thread
+    }
+
     auto& rtp_buffer = writer.rtp_buffer;
     auto& rtp_packet = writer.rtp_packet;
     const auto packet_time_frames = writer.packet_time_frames;
     const auto size_per_packet = packet_time_frames * writer.audio_format.bytes_per_frame();
 
+    update_payload_type(writer);
+
     if (rtp_buffer.get_next_ts() != rav::WrappingUint32(timestamp)) {
         // This buffer is not at the expected timestamp, reset the timestamp
         rtp_packet.set_timestamp(timestamp);
@@ -158,44 +337,65 @@ bool schedule_data_for_sending_realtime(
     }
 
     rtp_buffer.clear_until(timestamp);
-    rtp_buffer.write(timestamp, buffer);
+    if (swap_byte_order) {
+        rtp_buffer.write_byte_swapped(timestamp, buffer, writer.audio_format.bytes_per_sample());
+    } else {
+        rtp_buffer.write(timestamp, buffer);
+    }
 
     const auto next_ts = rtp_buffer.get_next_ts();
 
     while (rtp_packet.get_timestamp() + packet_time_frames < next_ts) {
-        TRACY_ZONE_SCOPED;
-
         rtp_buffer.read(rtp_packet.get_timestamp().value(), writer.intermediate_send_buffer.data(), size_per_packet);
-
-        writer.rtp_packet_buffer.clear();
-        rtp_packet.encode(writer.intermediate_send_buffer.data(), size_per_packet, writer.rtp_packet_buffer);
-
-        RAV_ASSERT_DEBUG(writer.rtp_packet_buffer.size() <= rav::aes67::constants::k_max_payload, "Packet payload overflow");
-
-        if (writer.rtp_packet_buffer.size() > rav::aes67::constants::k_max_payload) {
+        if (!enqueue_packet(writer)) {
             return false;
         }
+    }
 
-        rav::rtp::AudioSender::FifoPacket packet;
-        packet.rtp_timestamp = rtp_packet.get_timestamp().value();
-        packet.payload_size_bytes = static_cast<uint32_t>(writer.rtp_packet_buffer.size());
-        std::memcpy(packet.payload.data(), writer.rtp_packet_buffer.data(), writer.rtp_packet_buffer.size());
+    return true;
+}
 
-        if (!writer.outgoing_data.push(packet)) {
-            writer.num_packets_failed_to_schedule.fetch_add(1, std::memory_order_relaxed);
-        }
+/// Queues the packets of which the frames were written to the shared buffer of given writer since the previous call.
+void schedule_data_from_shared_buffer(rav::rtp::AudioSender::Writer& writer) {
+    TRACY_ZONE_SCOPED;
 
-        rtp_packet.sequence_number_inc(1);
-        rtp_packet.inc_timestamp(packet_time_frames);
+    const auto position = writer.shared_buffer->get_write_position();
+    if (!position.has_value()) {
+        return;  // Nothing was written yet
     }
 
-    return true;
+    auto& rtp_packet = writer.rtp_packet;
+    if (writer.shared_buffer_generation != position->generation) {
+        // Starts with the frames which are written next, also after the timestamps jumped
+        writer.shared_buffer_generation = position->generation;
+        rtp_packet.set_timestamp(position->end_timestamp);
+    }
+
+    update_payload_type(writer);
+
+    const auto packet_time_frames = writer.packet_time_frames;
+    const auto size_per_packet = packet_time_frames * writer.audio_format.bytes_per_frame();
+    const auto end_timestamp = rav::WrappingUint32(position->end_timestamp);
+
+    while (rtp_packet.get_timestamp() + packet_time_frames <= end_timestamp) {
+        if (!writer.shared_buffer->read(rtp_packet.get_timestamp().value(), writer.intermediate_send_buffer.data(), size_per_packet)) {
+            // Fell behind by more than the capacity of the buffer, continue with the frames which are written next
+            rtp_packet.set_timestamp(position->end_timestamp);
+            return;
+        }
+        if (!enqueue_packet(writer)) {
+            return;
+        }
+    }
 }
 
 }  // namespace
 
+// The slots are allocated on the heap, so the sender itself can be constructed on the stack.
+static_assert(sizeof(rav::rtp::AudioSender) < 64 * 1024);
+
 rav::rtp::AudioSender::AudioSender(boost::asio::io_context& io_context) {
-    for (size_t i = writers.size(); i < decltype(writers)::capacity(); i++) {
+    for (size_t i = writers.size(); i < writers.capacity(); i++) {
         writers.emplace_back(generate_array<udp_socket, k_max_num_redundant_sessions>([&io_context](std::size_t) {
             return udp_socket(io_context);
         }));
@@ -216,22 +416,27 @@ bool rav::rtp::AudioSender::add_writer(const Id id, const WriterParameters& para
         }
     }
 
+    const auto shard = select_shard(*this);
+
     for (auto& writer : writers) {
+        if (writer.id.is_valid()) {
+            continue;  // In use already. The id is only written by this thread, so the slot doesn't need to be locked.
+        }
+
         const auto guard = writer.rw_lock.lock_exclusive();
         if (!guard) {
             RAV_LOG_ERROR("Failed to exclusively lock writer");
             return false;
         }
 
-        if (writer.id.is_valid()) {
-            continue;  // In use already
-        }
-
-        RAV_LOG_TRACE("Adding writer {}", id.value());
-        return setup_writer(writer, id, parameters, interfaces);
+        RAV_LOG_TRACE("Adding writer {} to shard {}", id.value(), shard);
+        const auto result = setup_writer(writer, id, parameters, interfaces, shard, memory_arena.get());
+        update_slots_in_use(*this);
+        return result;
     }
 
-    return true;
+    RAV_LOG_ERROR("No free writer slot available");
+    return false;
 }
 
 bool rav::rtp::AudioSender::remove_writer(const Id id) {
@@ -244,6 +449,7 @@ bool rav::rtp::AudioSender::remove_writer(const Id id) {
             }
             RAV_LOG_TRACE("Removing writer {}", writer.id.value());
             reset_writer(writer);
+            update_slots_in_use(*this);
             return true;
         }
     }
@@ -251,11 +457,119 @@ bool rav::rtp::AudioSender::remove_writer(const Id id) {
     return false;
 }
 
+bool rav::rtp::AudioSender::update_writer(const Id id, const WriterParameters& parameters, const ArrayOfAddresses& interfaces) {
+    for (auto& writer : writers) {
+        if (writer.id != id) {
+            continue;
+        }
+
+        // Socket options apply to the underlying socket and the pending values are handed over lock-free, so a shared
+        // lock is enough and the audio and network threads keep running.
+        const auto guard = writer.rw_lock.lock_shared();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to lock writer");
+            return false;
+        }
+
+        if (writer.audio_format != parameters.audio_format || writer.packet_time_frames != parameters.packet_time_frames) {
+            return false;  // Requires the buffers to be reallocated
+        }
+
+        if (!set_socket_options(writer, parameters, interfaces)) {
+            return false;
+        }
+
+        writer.pending_payload_type.write(parameters.payload_type);
+        writer.pending_destinations.write(parameters.destinations);
+
+        RAV_LOG_TRACE("Updated writer {}", id.value());
+        return true;
+    }
+
+    return false;
+}
+
+bool rav::rtp::AudioSender::schedule_writer_update(
+    const Id id, const WriterParameters& parameters, const ArrayOfAddresses& interfaces, const uint32_t activation_timestamp
+) {
+    for (auto& writer : writers) {
+        if (writer.id != id) {
+            continue;
+        }
+
+        const auto guard = writer.rw_lock.lock_shared();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to lock writer");
+            return false;
+        }
+
+        if (writer.audio_format != parameters.audio_format || writer.packet_time_frames != parameters.packet_time_frames) {
+            return false;  // Requires the buffers to be reallocated
+        }
+
+        if (!set_socket_options(writer, parameters, interfaces)) {
+            return false;
+        }
+
+        // A previously scheduled update which was activated in the meantime is done.
+        writer.scheduled_update_activated.store(false, std::memory_order_relaxed);
+        writer.scheduled_payload_type_request.write(ScheduledPayloadType {parameters.payload_type, activation_timestamp});
+        writer.scheduled_destinations_request.write(ScheduledDestinations {parameters.destinations, activation_timestamp});
+        writer.update_scheduled = true;
+
+        RAV_LOG_TRACE("Scheduled update of writer {} at {}", id.value(), activation_timestamp);
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<uint32_t> rav::rtp::AudioSender::complete_scheduled_update(const Id id) {
+    for (auto& writer : writers) {
+        if (writer.id != id || !writer.update_scheduled) {
+            continue;
+        }
+        if (!writer.scheduled_update_activated.exchange(false, std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        writer.update_scheduled = false;
+        return writer.activated_at.load(std::memory_order_relaxed);
+    }
+
+    return std::nullopt;
+}
+
+bool rav::rtp::AudioSender::cancel_scheduled_update(const Id id) {
+    for (auto& writer : writers) {
+        if (writer.id != id || !writer.update_scheduled) {
+            continue;
+        }
+        if (writer.scheduled_update_activated.load(std::memory_order_acquire)) {
+            return false;
+        }
+        writer.scheduled_payload_type_request.write(std::nullopt);
+        writer.scheduled_destinations_request.write(std::nullopt);
+        writer.update_scheduled = false;
+        return true;
+    }
+
+    return false;
+}
+
+bool rav::rtp::AudioSender::has_scheduled_update(const Id id) const {
+    for (auto& writer : writers) {
+        if (writer.id == id) {
+            return writer.update_scheduled;
+        }
+    }
+    return false;
+}
+
 bool rav::rtp::AudioSender::set_interfaces(const ArrayOfAddresses& interfaces) {
     for (auto& writer : writers) {
-        const auto guard = writer.rw_lock.lock_exclusive();
+        const auto guard = writer.rw_lock.lock_shared();
         if (!guard) {
-            RAV_LOG_ERROR("Failed to exclusively lock writer");
+            RAV_LOG_ERROR("Failed to lock writer");
             return false;
         }
 
@@ -280,9 +594,9 @@ bool rav::rtp::AudioSender::set_interfaces(const ArrayOfAddresses& interfaces) {
 bool rav::rtp::AudioSender::set_ttl(const Id id, const uint8_t ttl) {
     for (auto& writer : writers) {
         if (writer.id == id) {
-            const auto guard = writer.rw_lock.lock_exclusive();
+            const auto guard = writer.rw_lock.lock_shared();
             if (!guard) {
-                RAV_LOG_ERROR("Failed to exclusively lock writer");
+                RAV_LOG_ERROR("Failed to lock writer");
                 return false;
             }
 
@@ -298,25 +612,140 @@ bool rav::rtp::AudioSender::set_ttl(const Id id, const uint8_t ttl) {
     return false;
 }
 
+bool rav::rtp::AudioSender::set_num_shards(const size_t num_shards_to_set) {
+    if (num_shards_to_set == 0 || num_shards_to_set > k_max_num_shards) {
+        RAV_LOG_ERROR("Invalid number of shards: {}", num_shards_to_set);
+        return false;
+    }
+
+    for (auto& writer : writers) {
+        if (writer.id.is_valid()) {
+            RAV_LOG_ERROR("Can't change the number of shards while writers are active");
+            return false;
+        }
+    }
+
+    for (auto& shard : shards) {
+        if (shard.io_uring != nullptr) {
+            RAV_LOG_ERROR("Can't change the number of shards after enabling io_uring");
+            return false;
+        }
+    }
+
+    num_shards = num_shards_to_set;
+    return true;
+}
+
+size_t rav::rtp::AudioSender::get_num_shards() const {
+    return num_shards;
+}
+
+bool rav::rtp::AudioSender::enable_io_uring(const IoUringOptions& options) {
+    for (size_t i = 0; i < num_shards; ++i) {
+        if (shards[i].io_uring != nullptr) {
+            continue;
+        }
+        shards[i].io_uring = IoUringSendRing::create(options);
+        if (shards[i].io_uring == nullptr) {
+            for (auto& shard : shards) {
+                shard.io_uring.reset();
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rav::rtp::AudioSender::set_memory_arena(std::shared_ptr<MemoryArena> arena) {
+    for (auto& writer : writers) {
+        if (writer.id.is_valid()) {
+            RAV_LOG_ERROR("Can't change the memory arena while writers are active");
+            return false;
+        }
+    }
+
+    // Release the buffers which idle writers hold on to, which might come from the previous arena.
+    for (auto& writer : writers) {
+        const auto guard = writer.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock writer");
+            return false;
+        }
+        set_writer_allocator(writer, arena.get());
+    }
+
+    memory_arena = std::move(arena);
+    return true;
+}
+
 void rav::rtp::AudioSender::send_outgoing_packets() {
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+        send_outgoing_packets(shard);
+    }
+}
+
+void rav::rtp::AudioSender::send_outgoing_packets(const size_t shard) {
     TRACY_ZONE_SCOPED;
 
-    for (auto& writer : writers) {
+    RAV_ASSERT_DEBUG(shard < num_shards, "Shard out of range");
+
+    auto& shard_state = shards[shard];
+    auto* io_uring = shard_state.io_uring.get();
+
+    if (io_uring != nullptr) {
+        complete_io_uring_sends(*this, shard, *io_uring);
+    }
+
+    const auto num_writer_slots = num_writer_slots_in_use.load(std::memory_order_acquire);
+    for (size_t writer_index = 0; writer_index < num_writer_slots; ++writer_index) {
+        auto& writer = writers[writer_index];
         const auto guard = writer.rw_lock.try_lock_shared();
         if (!guard) {
             continue;  // Exclusive locked, so it either just appeared or is about to go away.
         }
 
-        for (size_t i = 0; i < writer.outgoing_data.size(); ++i) {
+        if (!writer.id.is_valid() || writer.shard != shard) {
+            continue;
+        }
+
+        const auto begin_ns = clock::now_monotonic_high_resolution_ns();
+        size_t num_packets_popped = 0;
+
+        std::array<udp_endpoint, k_max_num_redundant_sessions> destinations;
+        if (writer.pending_destinations.read(destinations)) {
+            writer.destinations = destinations;  // Applied between two packets
+        }
+
+        std::optional<ScheduledDestinations> scheduled_destinations;
+        if (writer.scheduled_destinations_request.read(scheduled_destinations)) {
+            writer.scheduled_destinations = scheduled_destinations;
+        }
+
+        if (writer.shared_buffer != nullptr) {
+            schedule_data_from_shared_buffer(writer);
+        }
+
+        const auto num_packets = writer.outgoing_data.size();
+        for (size_t i = 0; i < num_packets; ++i) {
             const auto packet = writer.outgoing_data.pop();
 
             if (!packet.has_value()) {
-                return;  // Nothing to do here
+                break;  // Nothing to do here
             }
+            ++num_packets_popped;
 
             RAV_ASSERT_DEBUG(packet->payload_size_bytes <= aes67::constants::k_max_payload, "Payload size exceeds maximum");
             RAV_ASSERT_DEBUG(packet->payload_size_bytes > 0, "Packet is empty");
 
+            if (writer.scheduled_destinations.has_value()) {
+                if (WrappingUint32(packet->rtp_timestamp) >= WrappingUint32(writer.scheduled_destinations->rtp_timestamp)) {
+                    writer.destinations = writer.scheduled_destinations->destinations;
+                    writer.scheduled_destinations.reset();
+                    writer.activated_at.store(packet->rtp_timestamp, std::memory_order_relaxed);
+                    writer.scheduled_update_activated.store(true, std::memory_order_release);
+                }
+            }
+
             for (size_t j = 0; j < writer.destinations.size(); j++) {
                 if (writer.destinations[j].address().is_unspecified()) {
                     continue;
@@ -325,24 +754,52 @@ void rav::rtp::AudioSender::send_outgoing_packets() {
                     continue;
                 }
 
+                if (io_uring != nullptr) {
+                    const auto queued = io_uring->send(
+                        writer.sockets[j].native_handle(), packet->payload.data(), packet->payload_size_bytes, writer.destinations[j],
+                        writer_index
+                    );
+                    if (queued) {
+                        continue;  // The metrics are updated when the send completes
+                    }
+                    // All send buffers are in flight, fall back to sending directly
+                }
+
                 boost::system::error_code ec;
                 writer.sockets[j].send_to(
                     boost::asio::buffer(packet->payload.data(), packet->payload_size_bytes), writer.destinations[j], 0, ec
                 );
-                if (set_error(*this, ec)) {
-                    writer.num_packets_failed_to_send.fetch_add(1, std::memory_order_relaxed);
+                if (const auto new_error = set_error(shard_state, ec)) {
+                    RAV_LOG_ERROR_REALTIME("Failed to send packet (error {})", new_error.value());
+                }
+                if (ec) {
+                    writer.network_thread_metrics.packets_failed_to_send.increment();
+                } else {
+                    writer.network_thread_metrics.packets_sent.increment();
+                    writer.network_thread_metrics.bytes_sent.increment(packet->payload_size_bytes);
                 }
 
                 RAV_ASSERT_DEBUG(PacketView(packet->payload.data(), packet->payload_size_bytes).validate(), "Packet validation failed");
             }
         }
+
+        // Only passes which sent something are accounted, so that polling an idle writer doesn't dilute the distribution
+        if (num_packets_popped > 0) {
+            writer.network_thread_metrics.send_cost.add(clock::now_monotonic_high_resolution_ns() - begin_ns);
+        }
+    }
+
+    if (io_uring != nullptr) {
+        io_uring->submit();  // All packets of this iteration go out with a single submission
     }
 }
 
 bool rav::rtp::AudioSender::send_data_realtime(const Id id, const BufferView<const uint8_t> buffer, const uint32_t timestamp) {
     TRACY_ZONE_SCOPED;
 
-    for (auto& writer : writers) {
+    const auto num_writer_slots = num_writer_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_writer_slots; ++i) {
+        auto& writer = writers[i];
         const auto guard = writer.rw_lock.lock_shared();
         if (!guard) {
             continue;
@@ -350,18 +807,43 @@ bool rav::rtp::AudioSender::send_data_realtime(const Id id, const BufferView<con
         if (writer.id != id) {
             continue;
         }
+        const metrics::CostMeter::Scope cost(writer.audio_thread_metrics.schedule_cost);
         return schedule_data_for_sending_realtime(writer, buffer, timestamp);
     }
 
     return false;
 }
 
+bool rav::rtp::AudioSender::send_data_realtime(
+    const Id id, const BufferView<const uint8_t> buffer, const uint32_t timestamp, const AudioFormat::ByteOrder byte_order
+) {
+    TRACY_ZONE_SCOPED;
+
+    const auto num_writer_slots = num_writer_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_writer_slots; ++i) {
+        auto& writer = writers[i];
+        const auto guard = writer.rw_lock.lock_shared();
+        if (!guard) {
+            continue;
+        }
+        if (writer.id != id) {
+            continue;
+        }
+        const metrics::CostMeter::Scope cost(writer.audio_thread_metrics.schedule_cost);
+        return schedule_data_for_sending_realtime(writer, buffer, timestamp, writer.audio_format.byte_order != byte_order);
+    }
+
+    return false;
+}
+
 bool rav::rtp::AudioSender::send_audio_data_realtime(
     const Id id, const AudioBufferView<const float>& input_buffer, const uint32_t timestamp
 ) {
     TRACY_ZONE_SCOPED;
 
-    for (auto& writer : writers) {
+    const auto num_writer_slots = num_writer_slots_in_use.load(std::memory_order_acquire);
+    for (size_t i = 0; i < num_writer_slots; ++i) {
+        auto& writer = writers[i];
         const auto guard = writer.rw_lock.lock_shared();
         if (!guard) {
             continue;
@@ -370,6 +852,8 @@ bool rav::rtp::AudioSender::send_audio_data_realtime(
             continue;
         }
 
+        const metrics::CostMeter::Scope cost(writer.audio_thread_metrics.schedule_cost);  // Including the encoding
+
         if (input_buffer.num_frames() > k_max_num_frames) {
             RAV_ASSERT_DEBUG(false, "Input buffer size exceeds maximum");
             return false;
@@ -383,23 +867,105 @@ bool rav::rtp::AudioSender::send_audio_data_realtime(
 
         auto& intermediate_buffer = writer.intermediate_audio_buffer;
 
-        if (audio_format.encoding == AudioEncoding::pcm_s16) {
-            AudioData::convert<float, AudioData::ByteOrder::Ne, int16_t, AudioData::ByteOrder::Be, AudioData::Interleaving::Interleaved>(
-                input_buffer.data(), input_buffer.num_frames(), input_buffer.num_channels(),
-                reinterpret_cast<int16_t*>(intermediate_buffer.data()), 0, 0
-            );
-        } else if (audio_format.encoding == AudioEncoding::pcm_s24) {
-            AudioData::convert<float, AudioData::ByteOrder::Ne, int24_t, AudioData::ByteOrder::Be, AudioData::Interleaving::Interleaved>(
-                input_buffer.data(), input_buffer.num_frames(), input_buffer.num_channels(),
-                reinterpret_cast<int24_t*>(intermediate_buffer.data()), 0, 0
-            );
+        if (writer.pipeline.is_valid()) {
+            writer.pipeline.encode(input_buffer.data(), input_buffer.num_frames(), input_buffer.num_channels(), intermediate_buffer.data());
         }
 
         return schedule_data_for_sending_realtime(
-            writer, BufferView(intermediate_buffer).subview(0, input_buffer.num_frames() * audio_format.bytes_per_frame()).const_view(),
+            writer, BufferView(intermediate_buffer.data(), intermediate_buffer.size()).subview(0, input_buffer.num_frames() * audio_format.bytes_per_frame()).const_view(),
             timestamp
         );
     }
 
     return false;
 }
+
+bool rav::rtp::AudioSender::set_shared_buffer(const Id id, std::shared_ptr<SharedAudioBuffer> buffer) {
+    for (auto& writer : writers) {
+        if (writer.id != id) {
+            continue;
+        }
+
+        if (buffer != nullptr) {
+            if (buffer->get_audio_format() != writer.audio_format) {
+                RAV_LOG_ERROR("The audio format of the shared buffer doesn't match the writer");
+                return false;
+            }
+            if (buffer->get_capacity_frames() < writer.packet_time_frames) {
+                RAV_LOG_ERROR("The shared buffer is too small for the packets of the writer");
+                return false;
+            }
+        }
+
+        const auto guard = writer.rw_lock.lock_exclusive();
+        if (!guard) {
+            RAV_LOG_ERROR("Failed to exclusively lock writer");
+            return false;
+        }
+
+        writer.shared_buffer = std::move(buffer);
+        writer.shared_buffer_generation.reset();
+        if (writer.shared_buffer == nullptr) {
+            // The network thread moved the packets along, the audio thread continues from the frames it wrote last
+            writer.rtp_packet.set_timestamp(writer.rtp_buffer.get_next_ts().value());
+        }
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<rav::rtp::AudioSender::WriterCost> rav::rtp::AudioSender::get_writer_cost(const Id id) const {
+    for (auto& writer : writers) {
+        if (writer.id == id) {
+            WriterCost cost;
+            cost.schedule = writer.audio_thread_metrics.schedule_cost.get_snapshot();
+            cost.send = writer.network_thread_metrics.send_cost.get_snapshot();
+            return cost;
+        }
+    }
+    return std::nullopt;
+}
+
+void rav::rtp::AudioSender::collect_metrics(metrics::PrometheusWriter& writer) {
+    for (auto& w : writers) {
+        const auto guard = w.rw_lock.try_lock_shared();
+        if (!guard) {
+            continue;
+        }
+        if (!w.id.is_valid()) {
+            continue;
+        }
+
+        const metrics::PrometheusWriter::Labels labels {{"writer", std::to_string(w.id.value())}};
+
+        writer.add_counter(
+            "rav_rtp_writer_packets_scheduled_total", "Number of RTP packets scheduled for sending.", labels,
+            w.audio_thread_metrics.packets_scheduled.get()
+        );
+        writer.add_counter(
+            "rav_rtp_writer_packets_failed_to_schedule_total", "Number of RTP packets which could not be scheduled because the queue was full.",
+            labels, w.audio_thread_metrics.packets_failed_to_schedule.get()
+        );
+        writer.add_counter(
+            "rav_rtp_writer_packets_sent_total", "Number of RTP packets sent (counted per destination).", labels,
+            w.network_thread_metrics.packets_sent.get()
+        );
+        writer.add_counter(
+            "rav_rtp_writer_bytes_sent_total", "Number of RTP bytes sent (counted per destination).", labels,
+            w.network_thread_metrics.bytes_sent.get()
+        );
+        writer.add_counter(
+            "rav_rtp_writer_packets_failed_to_send_total", "Number of RTP packets which failed to send (counted per destination).", labels,
+            w.network_thread_metrics.packets_failed_to_send.get()
+        );
+        writer.add_histogram(
+            "rav_rtp_writer_schedule_cost_us", "Time per call scheduling data by the audio thread in microseconds.", labels,
+            w.audio_thread_metrics.schedule_cost.get_histogram()
+        );
+        writer.add_histogram(
+            "rav_rtp_writer_send_cost_us", "Time per pass of the network thread which sent packets of the writer in microseconds.",
+            labels, w.network_thread_metrics.send_cost.get_histogram()
+        );
+    }
+}
@@ -0,0 +1,478 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_io_uring.hpp"
+
+#include "ravennakit/aes67/aes67_constants.hpp"
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/realtime_log.hpp"
+
+#include <tuple>
+
+#if RAV_ENABLE_IO_URING && RAV_LINUX
+
+    #include <liburing.h>
+    #include <netinet/in.h>
+
+    #include <algorithm>
+    #include <array>
+    #include <cerrno>
+    #include <cstring>
+    #include <limits>
+    #include <vector>
+
+namespace {
+
+constexpr uint16_t k_buffer_group = 0;
+constexpr uint64_t k_internal_user_data = std::numeric_limits<uint64_t>::max();
+constexpr size_t k_max_cqes_per_batch = 64;
+constexpr size_t k_control_size = CMSG_SPACE(sizeof(in_pktinfo));
+constexpr size_t k_receive_buffer_size =
+    sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + k_control_size + rav::aes67::constants::k_mtu;
+
+[[nodiscard]] uint64_t encode_user_data(const size_t slot, const uint32_t generation) {
+    return static_cast<uint64_t>(generation) << 32 | static_cast<uint64_t>(slot);
+}
+
+[[nodiscard]] bool init_ring(io_uring& ring, const rav::rtp::IoUringOptions& options) {
+    io_uring_params params {};
+    if (options.sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = options.sqpoll_idle_ms;
+        if (options.sqpoll_cpu.has_value()) {
+            params.flags |= IORING_SETUP_SQ_AFF;
+            params.sq_thread_cpu = *options.sqpoll_cpu;
+        }
+    }
+
+    const auto result = io_uring_queue_init_params(options.num_entries, &ring, &params);
+    if (result < 0) {
+        RAV_LOG_ERROR("Failed to setup io_uring: {}", std::strerror(-result));
+        return false;
+    }
+    return true;
+}
+
+/// @return A submission queue entry, submitting the pending entries first if the queue is full.
+[[nodiscard]] io_uring_sqe* get_sqe(io_uring& ring) {
+    if (auto* sqe = io_uring_get_sqe(&ring)) {
+        return sqe;
+    }
+    io_uring_submit(&ring);
+    return io_uring_get_sqe(&ring);
+}
+
+[[nodiscard]] rav::udp_endpoint to_endpoint(const sockaddr_in& address) {
+    return {rav::ip_address_v4(ntohl(address.sin_addr.s_addr)), ntohs(address.sin_port)};
+}
+
+}  // namespace
+
+class rav::rtp::IoUringReceiveRing::Impl {
+  public:
+    struct Slot {
+        int fd {-1};
+        uint32_t generation {};
+        uint16_t port {};
+        bool armed {};
+    };
+
+    io_uring ring {};
+    bool ring_initialized {};
+    io_uring_buf_ring* buffer_ring {};
+    std::vector<uint8_t> buffers;
+    msghdr msg_template {};
+    std::array<Slot, k_max_num_sockets> slots;
+    std::array<uint16_t, k_num_buffers> buffers_to_return {};
+    size_t num_buffers_to_return {};
+
+    ~Impl() {
+        if (buffer_ring != nullptr) {
+            io_uring_free_buf_ring(&ring, buffer_ring, k_num_buffers, k_buffer_group);
+        }
+        if (ring_initialized) {
+            io_uring_queue_exit(&ring);
+        }
+    }
+
+    [[nodiscard]] uint8_t* buffer(const uint16_t buffer_id) {
+        return buffers.data() + static_cast<size_t>(buffer_id) * k_receive_buffer_size;
+    }
+
+    void return_buffers() {
+        const auto mask = io_uring_buf_ring_mask(k_num_buffers);
+        for (size_t i = 0; i < num_buffers_to_return; ++i) {
+            const auto buffer_id = buffers_to_return[i];
+            io_uring_buf_ring_add(buffer_ring, buffer(buffer_id), k_receive_buffer_size, buffer_id, mask, static_cast<int>(i));
+        }
+        io_uring_buf_ring_advance(buffer_ring, static_cast<int>(num_buffers_to_return));
+        num_buffers_to_return = 0;
+    }
+
+    void submit_receive(const size_t slot_index) {
+        auto& slot = slots[slot_index];
+        auto* sqe = get_sqe(ring);
+        if (sqe == nullptr) {
+            return;  // Stays disarmed and will be retried on the next call to arm
+        }
+        io_uring_prep_recvmsg_multishot(sqe, slot.fd, &msg_template, 0);
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        sqe->buf_group = k_buffer_group;
+        io_uring_sqe_set_data64(sqe, encode_user_data(slot_index, slot.generation));
+        slot.armed = true;
+    }
+
+    void cancel_receive(const size_t slot_index) {
+        auto& slot = slots[slot_index];
+        if (auto* sqe = get_sqe(ring)) {
+            io_uring_prep_cancel64(sqe, encode_user_data(slot_index, slot.generation), 0);
+            io_uring_sqe_set_data64(sqe, k_internal_user_data);
+        }
+        // The completions of a receive which couldn't be cancelled are discarded because the slot no longer matches.
+        slot = {};
+    }
+
+    /// Parses a datagram received by recvmsg, which is laid out as io_uring_recvmsg_out, name, control and payload.
+    [[nodiscard]] bool parse(uint8_t* data, const int size, const Slot& slot, Packet& packet) {
+        auto* out = io_uring_recvmsg_validate(data, size, &msg_template);
+        if (out == nullptr || (out->flags & MSG_TRUNC) != 0 || out->namelen < sizeof(sockaddr_in)) {
+            return false;
+        }
+
+        sockaddr_in src_address {};
+        std::memcpy(&src_address, io_uring_recvmsg_name(out), sizeof(src_address));
+        packet.src_endpoint = to_endpoint(src_address);
+        packet.dst_endpoint = {};
+
+        for (auto* cmsg = io_uring_recvmsg_cmsg_firsthdr(out, &msg_template); cmsg != nullptr;
+             cmsg = io_uring_recvmsg_cmsg_nexthdr(out, &msg_template, cmsg)) {
+            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                in_pktinfo pktinfo {};
+                std::memcpy(&pktinfo, CMSG_DATA(cmsg), sizeof(pktinfo));
+                packet.dst_endpoint = {ip_address_v4(ntohl(pktinfo.ipi_addr.s_addr)), slot.port};
+            }
+        }
+
+        packet.data = static_cast<const uint8_t*>(io_uring_recvmsg_payload(out, &msg_template));
+        packet.size = io_uring_recvmsg_payload_length(out, size, &msg_template);
+        return true;
+    }
+};
+
+rav::rtp::IoUringReceiveRing::IoUringReceiveRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::IoUringReceiveRing::~IoUringReceiveRing() = default;
+
+std::unique_ptr<rav::rtp::IoUringReceiveRing> rav::rtp::IoUringReceiveRing::create(const IoUringOptions& options) {
+    auto impl = std::make_unique<Impl>();
+    if (!init_ring(impl->ring, options)) {
+        return nullptr;
+    }
+    impl->ring_initialized = true;
+
+    int result = 0;
+    impl->buffer_ring = io_uring_setup_buf_ring(&impl->ring, k_num_buffers, k_buffer_group, 0, &result);
+    if (impl->buffer_ring == nullptr) {
+        RAV_LOG_ERROR("Failed to setup io_uring buffer ring: {}", std::strerror(-result));
+        return nullptr;
+    }
+
+    impl->buffers.resize(k_num_buffers * k_receive_buffer_size);
+    for (uint16_t i = 0; i < k_num_buffers; ++i) {
+        impl->buffers_to_return[i] = i;
+    }
+    impl->num_buffers_to_return = k_num_buffers;
+    impl->return_buffers();
+
+    impl->msg_template.msg_namelen = sizeof(sockaddr_in);
+    impl->msg_template.msg_controllen = k_control_size;
+
+    return std::unique_ptr<IoUringReceiveRing>(new IoUringReceiveRing(std::move(impl)));
+}
+
+void rav::rtp::IoUringReceiveRing::arm(const size_t slot_index, const uint32_t generation, const int fd, const uint16_t port) {
+    RAV_ASSERT(slot_index < k_max_num_sockets, "Slot out of range");
+
+    auto& slot = impl_->slots[slot_index];
+    if (slot.fd == fd && slot.generation == generation) {
+        if (!slot.armed) {
+            impl_->submit_receive(slot_index);  // The previous multishot receive terminated
+        }
+        return;
+    }
+
+    if (slot.fd >= 0) {
+        impl_->cancel_receive(slot_index);
+    }
+
+    slot.fd = fd;
+    slot.generation = generation;
+    slot.port = port;
+    impl_->submit_receive(slot_index);
+}
+
+void rav::rtp::IoUringReceiveRing::disarm(const size_t slot_index) {
+    RAV_ASSERT(slot_index < k_max_num_sockets, "Slot out of range");
+
+    if (impl_->slots[slot_index].fd >= 0) {
+        impl_->cancel_receive(slot_index);
+    }
+}
+
+size_t rav::rtp::IoUringReceiveRing::receive(Packet* packets, const size_t max_num_packets) {
+    auto& ring = impl_->ring;
+
+    impl_->return_buffers();
+
+    if (io_uring_sq_ready(&ring) > 0) {
+        io_uring_submit(&ring);
+    }
+
+    std::array<io_uring_cqe*, k_max_cqes_per_batch> cqes {};
+    const auto num_cqes = io_uring_peek_batch_cqe(&ring, cqes.data(), static_cast<unsigned>(std::min(max_num_packets, cqes.size())));
+    if (num_cqes == 0) {
+        return 0;
+    }
+
+    const auto recv_time = clock::now_monotonic_high_resolution_ns();
+    size_t num_packets = 0;
+
+    for (unsigned i = 0; i < num_cqes; ++i) {
+        const auto* cqe = cqes[i];
+        const auto user_data = io_uring_cqe_get_data64(cqe);
+        if (user_data == k_internal_user_data) {
+            continue;
+        }
+
+        const auto slot_index = static_cast<size_t>(user_data & 0xffffffff);
+        const auto generation = static_cast<uint32_t>(user_data >> 32);
+        auto& slot = impl_->slots[slot_index];
+        const auto is_current = slot.fd >= 0 && slot.generation == generation;
+
+        if (is_current && (cqe->flags & IORING_CQE_F_MORE) == 0) {
+            slot.armed = false;  // Re-armed by the next call to arm
+        }
+
+        if ((cqe->flags & IORING_CQE_F_BUFFER) == 0) {
+            if (is_current && cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+                RAV_LOG_ERROR_REALTIME("Failed to receive through io_uring (error {})", -cqe->res);
+            }
+            continue;
+        }
+
+        const auto buffer_id = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        impl_->buffers_to_return[impl_->num_buffers_to_return++] = buffer_id;
+
+        if (!is_current || cqe->res <= 0) {
+            continue;
+        }
+
+        if (impl_->parse(impl_->buffer(buffer_id), cqe->res, slot, packets[num_packets])) {
+            packets[num_packets].recv_time = recv_time;
+            num_packets++;
+        }
+    }
+
+    io_uring_cq_advance(&ring, num_cqes);
+    return num_packets;
+}
+
+class rav::rtp::IoUringSendRing::Impl {
+  public:
+    struct Buffer {
+        sockaddr_in address {};  // Must stay valid until the kernel consumed the submission
+        uint64_t tag {};
+    };
+
+    io_uring ring {};
+    bool ring_initialized {};
+    std::vector<uint8_t> data;
+    std::array<Buffer, k_num_buffers> buffers;
+    std::array<uint32_t, k_num_buffers> free_buffers {};
+    size_t num_free_buffers {};
+
+    ~Impl() {
+        if (ring_initialized) {
+            io_uring_queue_exit(&ring);
+        }
+    }
+
+    void release(const uint32_t index) {
+        RAV_ASSERT_DEBUG(num_free_buffers < free_buffers.size(), "Buffer released twice");
+        free_buffers[num_free_buffers++] = index;
+    }
+};
+
+rav::rtp::IoUringSendRing::IoUringSendRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::IoUringSendRing::~IoUringSendRing() = default;
+
+std::unique_ptr<rav::rtp::IoUringSendRing> rav::rtp::IoUringSendRing::create(const IoUringOptions& options) {
+    auto impl = std::make_unique<Impl>();
+    if (!init_ring(impl->ring, options)) {
+        return nullptr;
+    }
+    impl->ring_initialized = true;
+
+    impl->data.resize(k_num_buffers * k_buffer_size);
+
+    // A single registered buffer covers all send buffers, which are addressed by offset.
+    const iovec iov {impl->data.data(), impl->data.size()};
+    const auto result = io_uring_register_buffers(&impl->ring, &iov, 1);
+    if (result < 0) {
+        RAV_LOG_ERROR("Failed to register io_uring send buffers: {}", std::strerror(-result));
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < k_num_buffers; ++i) {
+        impl->release(i);
+    }
+
+    return std::unique_ptr<IoUringSendRing>(new IoUringSendRing(std::move(impl)));
+}
+
+bool rav::rtp::IoUringSendRing::send(const int fd, const uint8_t* data, const size_t size, const udp_endpoint& endpoint, const uint64_t tag) {
+    if (size > k_buffer_size || impl_->num_free_buffers == 0) {
+        return false;
+    }
+
+    auto* sqe = get_sqe(impl_->ring);
+    if (sqe == nullptr) {
+        return false;
+    }
+
+    const auto index = impl_->free_buffers[--impl_->num_free_buffers];
+    auto* buffer_data = impl_->data.data() + static_cast<size_t>(index) * k_buffer_size;
+    std::memcpy(buffer_data, data, size);
+
+    auto& buffer = impl_->buffers[index];
+    buffer.address = {};
+    buffer.address.sin_family = AF_INET;
+    buffer.address.sin_port = htons(endpoint.port());
+    buffer.address.sin_addr.s_addr = htonl(endpoint.address().to_v4().to_uint());
+    buffer.tag = tag;
+
+    io_uring_prep_send_zc_fixed(sqe, fd, buffer_data, size, 0, 0, 0);
+    io_uring_prep_send_set_addr(sqe, reinterpret_cast<const sockaddr*>(&buffer.address), sizeof(buffer.address));
+    io_uring_sqe_set_data64(sqe, index);
+    return true;
+}
+
+void rav::rtp::IoUringSendRing::submit() {
+    if (io_uring_sq_ready(&impl_->ring) > 0) {
+        io_uring_submit(&impl_->ring);
+    }
+}
+
+size_t rav::rtp::IoUringSendRing::complete(Completion* completions, const size_t max_num_completions) {
+    auto& ring = impl_->ring;
+
+    std::array<io_uring_cqe*, k_max_cqes_per_batch> cqes {};
+    const auto num_cqes = io_uring_peek_batch_cqe(&ring, cqes.data(), static_cast<unsigned>(std::min(max_num_completions, cqes.size())));
+
+    size_t num_completions = 0;
+    for (unsigned i = 0; i < num_cqes; ++i) {
+        const auto* cqe = cqes[i];
+        const auto index = static_cast<uint32_t>(io_uring_cqe_get_data64(cqe));
+
+        if ((cqe->flags & IORING_CQE_F_NOTIF) != 0) {
+            impl_->release(index);  // The kernel is done with the buffer
+            continue;
+        }
+
+        completions[num_completions++] = {impl_->buffers[index].tag, cqe->res};
+
+        if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
+            impl_->release(index);  // No notification follows
+        }
+    }
+
+    io_uring_cq_advance(&ring, num_cqes);
+    return num_completions;
+}
+
+#else
+
+class rav::rtp::IoUringReceiveRing::Impl {};
+
+rav::rtp::IoUringReceiveRing::IoUringReceiveRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::IoUringReceiveRing::~IoUringReceiveRing() = default;
+
+std::unique_ptr<rav::rtp::IoUringReceiveRing> rav::rtp::IoUringReceiveRing::create(const IoUringOptions& options) {
+    std::ignore = options;
+    RAV_LOG_WARNING("io_uring is not available in this build");
+    return nullptr;
+}
+
+void rav::rtp::IoUringReceiveRing::arm(const size_t slot_index, const uint32_t generation, const int fd, const uint16_t port) {
+    std::ignore = slot_index;
+    std::ignore = generation;
+    std::ignore = fd;
+    std::ignore = port;
+}
+
+void rav::rtp::IoUringReceiveRing::disarm(const size_t slot_index) {
+    std::ignore = slot_index;
+}
+
+size_t rav::rtp::IoUringReceiveRing::receive(Packet* packets, const size_t max_num_packets) {
+    std::ignore = packets;
+    std::ignore = max_num_packets;
+    return 0;
+}
+
+class rav::rtp::IoUringSendRing::Impl {};
+
+rav::rtp::IoUringSendRing::IoUringSendRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::IoUringSendRing::~IoUringSendRing() = default;
+
+std::unique_ptr<rav::rtp::IoUringSendRing> rav::rtp::IoUringSendRing::create(const IoUringOptions& options) {
+    std::ignore = options;
+    RAV_LOG_WARNING("io_uring is not available in this build");
+    return nullptr;
+}
+
+bool rav::rtp::IoUringSendRing::send(const int fd, const uint8_t* data, const size_t size, const udp_endpoint& endpoint, const uint64_t tag) {
+    std::ignore = fd;
+    std::ignore = data;
+    std::ignore = size;
+    std::ignore = endpoint;
+    std::ignore = tag;
+    return false;
+}
+
+void rav::rtp::IoUringSendRing::submit() {}
+
+size_t rav::rtp::IoUringSendRing::complete(Completion* completions, const size_t max_num_completions) {
+    std::ignore = completions;
+    std::ignore = max_num_completions;
+    return 0;
+}
+
+#endif
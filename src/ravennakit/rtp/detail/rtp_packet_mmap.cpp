@@ -0,0 +1,401 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_packet_mmap.hpp"
+
+#include "ravennakit/aes67/aes67_constants.hpp"
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/util/defer.hpp"
+
+#include <tuple>
+
+#if RAV_LINUX
+
+    #include <arpa/inet.h>
+    #include <ifaddrs.h>
+    #include <linux/filter.h>
+    #include <linux/if_ether.h>
+    #include <linux/if_packet.h>
+    #include <net/if.h>
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+
+    #include <algorithm>
+    #include <cerrno>
+    #include <cstring>
+    #include <ctime>
+    #include <optional>
+
+namespace {
+
+constexpr uint32_t k_frame_size = 2048;
+constexpr uint32_t k_fragment_mask = 0x3fff;  // More fragments flag and fragment offset
+constexpr uint32_t k_ip_header_min_size = 20;
+constexpr uint32_t k_ip_header_max_size = 60;
+constexpr uint32_t k_udp_header_size = 8;
+constexpr uint32_t k_max_datagram_size = rav::aes67::constants::k_mtu;  // Like the receive buffer of the sockets
+
+// The kernel truncates bigger frames to this length, after which parse drops them.
+constexpr uint32_t k_accept_length = k_ip_header_max_size + k_udp_header_size + k_max_datagram_size;
+constexpr size_t k_max_ports_per_jump = 127;  // The jump offsets of classic BPF are 8 bit
+
+/// Rounds given size up to the alignment of the TPACKET headers, like TPACKET_ALIGN without its sign conversion.
+constexpr size_t tpacket_align(const size_t size) {
+    return (size + TPACKET_ALIGNMENT - 1) & ~static_cast<size_t>(TPACKET_ALIGNMENT - 1);
+}
+
+/// The offset of the link layer address behind the header of a frame.
+constexpr size_t k_tpacket3_hdr_len = tpacket_align(sizeof(tpacket3_hdr));
+
+[[nodiscard]] uint16_t read_be16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] << 8 | data[1]);
+}
+
+[[nodiscard]] uint32_t read_be32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 | static_cast<uint32_t>(data[2]) << 8 |
+        static_cast<uint32_t>(data[3]);
+}
+
+[[nodiscard]] std::optional<unsigned int> find_interface_index(const rav::ip_address_v4& interface_address) {
+    if (interface_address.is_unspecified()) {
+        return 0;  // All interfaces
+    }
+
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0) {
+        RAV_LOG_ERROR("Failed to get interface addresses: {}", std::strerror(errno));
+        return std::nullopt;
+    }
+    rav::Defer free_interfaces([interfaces] {
+        freeifaddrs(interfaces);
+    });
+
+    for (auto* it = interfaces; it != nullptr; it = it->ifa_next) {
+        if (it->ifa_addr == nullptr || it->ifa_addr->sa_family != AF_INET) {
+            continue;
+        }
+        sockaddr_in address {};
+        std::memcpy(&address, it->ifa_addr, sizeof(address));
+        if (ntohl(address.sin_addr.s_addr) == interface_address.to_uint()) {
+            const auto index = if_nametoindex(it->ifa_name);
+            if (index == 0) {
+                return std::nullopt;
+            }
+            return index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+[[nodiscard]] bool attach_filter(const int fd, std::vector<sock_filter>& program) {
+    sock_fprog fprog {};
+    fprog.len = static_cast<unsigned short>(program.size());
+    fprog.filter = program.data();
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0) {
+        RAV_LOG_ERROR("Failed to attach socket filter: {}", std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/// Builds a filter for packets starting at the IP header which only accepts incoming, unfragmented UDP datagrams sent
+/// to one of given destinations. The destinations are grouped by address so that the address is only compared once.
+[[nodiscard]] std::vector<sock_filter> build_destination_filter(std::vector<rav::udp_endpoint> destinations) {
+    std::sort(destinations.begin(), destinations.end());
+    destinations.erase(std::unique(destinations.begin(), destinations.end()), destinations.end());
+
+    std::vector<sock_filter> program {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_PKTTYPE)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 9),  // Protocol
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 1, 0),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 6),  // Flags and fragment offset
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, k_fragment_mask, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),  // X = IP header length
+    };
+
+    for (size_t begin = 0; begin < destinations.size();) {
+        const auto address = destinations[begin].address().to_v4().to_uint();
+        auto end = begin;
+        while (end < destinations.size() && end - begin < k_max_ports_per_jump && destinations[end].address().to_v4().to_uint() == address) {
+            ++end;
+        }
+        const auto num_ports = static_cast<uint8_t>(end - begin);
+
+        program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 16));  // Destination address
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, address, 0, static_cast<uint8_t>(1 + 2 * num_ports)));
+        program.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2));  // Destination port
+        for (auto i = begin; i < end; ++i) {
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, destinations[i].port(), 0, 1));
+            program.push_back(BPF_STMT(BPF_RET | BPF_K, k_accept_length));
+        }
+        begin = end;
+    }
+
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+    return program;
+}
+
+}  // namespace
+
+class rav::rtp::PacketMmapReceiveRing::Impl {
+  public:
+    int fd {-1};
+    uint8_t* map {};
+    size_t map_size {};
+    uint32_t block_size {};
+    uint32_t num_blocks {};
+    uint32_t block_index {};
+    tpacket_block_desc* block {};  // The block being read, or nullptr
+    const uint8_t* next_packet {};
+    uint32_t num_packets_left {};
+
+    ~Impl() {
+        if (map != nullptr) {
+            munmap(map, map_size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    /// @return True if a block was handed over by the kernel, in which case it becomes the block being read.
+    [[nodiscard]] bool acquire_block() {
+        auto* desc = reinterpret_cast<tpacket_block_desc*>(map + static_cast<size_t>(block_index) * block_size);
+        if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            return false;
+        }
+        block = desc;
+        next_packet = reinterpret_cast<const uint8_t*>(desc) + desc->hdr.bh1.offset_to_first_pkt;
+        num_packets_left = desc->hdr.bh1.num_pkts;
+        return true;
+    }
+
+    /// Hands the block being read back to the kernel.
+    void release_block() {
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        block = nullptr;
+        block_index = (block_index + 1) % num_blocks;
+    }
+
+    /// Parses the IP and UDP headers of a frame in place.
+    [[nodiscard]] static bool parse(const tpacket3_hdr& header, const int64_t realtime_to_monotonic, Packet& packet) {
+        const auto* frame = reinterpret_cast<const uint8_t*>(&header);
+        const auto* link = reinterpret_cast<const sockaddr_ll*>(frame + k_tpacket3_hdr_len);
+        if (link->sll_pkttype == PACKET_OUTGOING) {
+            return false;
+        }
+
+        const auto* ip = frame + header.tp_net;
+        const auto size = header.tp_snaplen;
+        if (size < k_ip_header_min_size || ip[0] >> 4 != 4) {
+            return false;
+        }
+        const uint32_t ip_header_size = (ip[0] & 0x0f) * 4u;
+        const uint32_t total_length = read_be16(ip + 2);
+        if (ip_header_size < k_ip_header_min_size || total_length > size || total_length < ip_header_size + k_udp_header_size) {
+            return false;
+        }
+        if (ip[9] != IPPROTO_UDP || (read_be16(ip + 6) & k_fragment_mask) != 0) {
+            return false;
+        }
+
+        const auto* udp = ip + ip_header_size;
+        const uint32_t udp_length = read_be16(udp + 4);
+        if (udp_length < k_udp_header_size || ip_header_size + udp_length > total_length) {
+            return false;
+        }
+        if (udp_length - k_udp_header_size > k_max_datagram_size) {
+            return false;  // Jumbo frames are bigger than any RTP packet the receiver accepts
+        }
+
+        packet.src_endpoint = {ip_address_v4(read_be32(ip + 12)), read_be16(udp)};
+        packet.dst_endpoint = {ip_address_v4(read_be32(ip + 16)), read_be16(udp + 2)};
+        packet.data = udp + k_udp_header_size;
+        packet.size = udp_length - k_udp_header_size;
+
+        const auto timestamp = static_cast<int64_t>(header.tp_sec) * 1'000'000'000 + static_cast<int64_t>(header.tp_nsec);
+        packet.recv_time = static_cast<uint64_t>(timestamp + realtime_to_monotonic);
+        return true;
+    }
+};
+
+rav::rtp::PacketMmapReceiveRing::PacketMmapReceiveRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::PacketMmapReceiveRing::~PacketMmapReceiveRing() = default;
+
+std::unique_ptr<rav::rtp::PacketMmapReceiveRing>
+rav::rtp::PacketMmapReceiveRing::create(const ip_address_v4& interface_address, const PacketMmapOptions& options) {
+    const auto page_size = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    if (options.block_size < page_size || options.block_size % page_size != 0 || (options.block_size & (options.block_size - 1)) != 0) {
+        RAV_LOG_ERROR("Invalid block size: {}", options.block_size);
+        return nullptr;
+    }
+    if (options.num_blocks == 0) {
+        RAV_LOG_ERROR("Invalid number of blocks: {}", options.num_blocks);
+        return nullptr;
+    }
+
+    const auto interface_index = find_interface_index(interface_address);
+    if (!interface_index.has_value()) {
+        RAV_LOG_ERROR("Failed to find the interface with address {}", interface_address.to_string());
+        return nullptr;
+    }
+
+    auto impl = std::make_unique<Impl>();
+
+    // Protocol 0 receives nothing until the socket is bound, so that no packets arrive before the filter is in place.
+    impl->fd = socket(AF_PACKET, SOCK_DGRAM, 0);
+    if (impl->fd < 0) {
+        RAV_LOG_ERROR("Failed to open packet socket: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(impl->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+        RAV_LOG_ERROR("Failed to set TPACKET_V3: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    std::vector<sock_filter> drop_all {BPF_STMT(BPF_RET | BPF_K, 0)};
+    if (!attach_filter(impl->fd, drop_all)) {
+        return nullptr;
+    }
+
+    tpacket_req3 request {};
+    request.tp_block_size = options.block_size;
+    request.tp_block_nr = options.num_blocks;
+    request.tp_frame_size = k_frame_size;
+    request.tp_frame_nr = options.block_size / k_frame_size * options.num_blocks;
+    request.tp_retire_blk_tov = options.block_timeout_ms;
+    if (setsockopt(impl->fd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) != 0) {
+        RAV_LOG_ERROR("Failed to setup packet ring: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    impl->map_size = static_cast<size_t>(options.block_size) * options.num_blocks;
+    auto* map = mmap(nullptr, impl->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, 0);
+    if (map == MAP_FAILED) {
+        RAV_LOG_ERROR("Failed to map packet ring: {}", std::strerror(errno));
+        return nullptr;
+    }
+    impl->map = static_cast<uint8_t*>(map);
+    impl->block_size = options.block_size;
+    impl->num_blocks = options.num_blocks;
+
+    sockaddr_ll address {};
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_IP);
+    address.sll_ifindex = static_cast<int>(*interface_index);
+    if (bind(impl->fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        RAV_LOG_ERROR("Failed to bind packet socket: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    return std::unique_ptr<PacketMmapReceiveRing>(new PacketMmapReceiveRing(std::move(impl)));
+}
+
+bool rav::rtp::PacketMmapReceiveRing::set_destinations(const std::vector<udp_endpoint>& destinations) {
+    auto program = build_destination_filter(destinations);
+    if (program.size() > BPF_MAXINSNS) {
+        RAV_LOG_ERROR("Too many destinations for the packet filter: {}", destinations.size());
+        return false;
+    }
+    return attach_filter(impl_->fd, program);
+}
+
+size_t rav::rtp::PacketMmapReceiveRing::receive(Packet* packets, const size_t max_num_packets) {
+    auto& impl = *impl_;
+
+    // The packets of the previous call point into the block, so it's released only once all packets were handed out.
+    if (impl.block != nullptr && impl.num_packets_left == 0) {
+        impl.release_block();
+    }
+
+    if (impl.block == nullptr && !impl.acquire_block()) {
+        return 0;
+    }
+
+    timespec realtime {};
+    clock_gettime(CLOCK_REALTIME, &realtime);
+    const auto realtime_to_monotonic = static_cast<int64_t>(clock::now_monotonic_high_resolution_ns()) -
+        (static_cast<int64_t>(realtime.tv_sec) * 1'000'000'000 + static_cast<int64_t>(realtime.tv_nsec));
+
+    size_t num_packets = 0;
+    while (num_packets < max_num_packets && impl.num_packets_left > 0) {
+        const auto& header = *reinterpret_cast<const tpacket3_hdr*>(impl.next_packet);
+        impl.next_packet += header.tp_next_offset;
+        impl.num_packets_left--;
+        if (Impl::parse(header, realtime_to_monotonic, packets[num_packets])) {
+            num_packets++;
+        }
+    }
+    return num_packets;
+}
+
+bool rav::rtp::attach_drop_all_filter(udp_socket& socket) {
+    std::vector<sock_filter> drop_all {BPF_STMT(BPF_RET | BPF_K, 0)};
+    return attach_filter(socket.native_handle(), drop_all);
+}
+
+#else
+
+class rav::rtp::PacketMmapReceiveRing::Impl {};
+
+rav::rtp::PacketMmapReceiveRing::PacketMmapReceiveRing(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+rav::rtp::PacketMmapReceiveRing::~PacketMmapReceiveRing() = default;
+
+std::unique_ptr<rav::rtp::PacketMmapReceiveRing>
+rav::rtp::PacketMmapReceiveRing::create(const ip_address_v4& interface_address, const PacketMmapOptions& options) {
+    std::ignore = interface_address;
+    std::ignore = options;
+    RAV_LOG_WARNING("AF_PACKET is not available on this platform");
+    return nullptr;
+}
+
+bool rav::rtp::PacketMmapReceiveRing::set_destinations(const std::vector<udp_endpoint>& destinations) {
+    std::ignore = destinations;
+    return false;
+}
+
+size_t rav::rtp::PacketMmapReceiveRing::receive(Packet* packets, const size_t max_num_packets) {
+    std::ignore = packets;
+    std::ignore = max_num_packets;
+    return 0;
+}
+
+bool rav::rtp::attach_drop_all_filter(udp_socket& socket) {
+    std::ignore = socket;
+    return false;
+}
+
+#endif
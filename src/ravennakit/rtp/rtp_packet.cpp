@@ -24,6 +24,8 @@
 
 #include "ravennakit/rtp/rtp_packet.hpp"
 
+#include <cstring>
+
 void rav::rtp::Packet::payload_type(const uint8_t value) {
     payload_type_ = value;
 }
@@ -75,3 +77,18 @@ void rav::rtp::Packet::encode(const uint8_t* payload_data, const size_t payload_
     // Payload
     buffer.write(payload_data, payload_size);
 }
+
+size_t rav::rtp::Packet::encode(const uint8_t* payload_data, const size_t payload_size, uint8_t* buffer, const size_t buffer_size) const {
+    if (k_header_size + payload_size > buffer_size) {
+        return 0;
+    }
+
+    buffer[0] = 0b10000000;  // Version 2, no padding, no extension, CSRC count of 0.
+    buffer[1] = payload_type_ & 0b01111111;  // No marker bit.
+    write_be<uint16_t>(buffer + 2, sequence_number_.value());
+    write_be<uint32_t>(buffer + 4, timestamp_.value());
+    write_be<uint32_t>(buffer + 8, ssrc_);
+    std::memcpy(buffer + k_header_size, payload_data, payload_size);
+
+    return k_header_size + payload_size;
+}
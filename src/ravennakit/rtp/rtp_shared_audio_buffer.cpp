@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/rtp_shared_audio_buffer.hpp"
+
+#include "ravennakit/core/assert.hpp"
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/containers/detail/fifo.hpp"
+#include "ravennakit/core/util/wrapping_uint.hpp"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t k_header_size = (sizeof(rav::rtp::SharedAudioBuffer::Header) + rav::k_cache_line_size - 1) / rav::k_cache_line_size *
+    rav::k_cache_line_size;
+
+uint64_t pack(const uint32_t generation, const uint32_t end_timestamp) {
+    return static_cast<uint64_t>(generation) << 32 | end_timestamp;
+}
+
+rav::rtp::SharedAudioBuffer::Position unpack(const uint64_t value) {
+    return {static_cast<uint32_t>(value >> 32), static_cast<uint32_t>(value & 0xffffffff)};
+}
+
+/// @return True if the frames [timestamp, timestamp + num_frames) lie within the capacity before end_timestamp.
+bool is_in_window(const uint32_t end_timestamp, const uint32_t capacity_frames, const uint32_t timestamp, const uint32_t num_frames) {
+    const auto age = rav::WrappingUint32(timestamp).diff(end_timestamp);  // end_timestamp - timestamp
+    return age >= static_cast<int64_t>(num_frames) && age <= static_cast<int64_t>(capacity_frames);
+}
+
+}  // namespace
+
+std::unique_ptr<rav::rtp::SharedAudioBuffer> rav::rtp::SharedAudioBuffer::create(
+    const std::string& name, const AudioFormat& audio_format, const uint32_t capacity_frames, const bool lock_memory
+) {
+    if (!audio_format.is_valid() || capacity_frames == 0) {
+        RAV_LOG_ERROR("Invalid audio format or capacity for shared audio buffer");
+        return nullptr;
+    }
+
+    if (capacity_frames > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+        RAV_LOG_ERROR("Capacity too large for shared audio buffer");
+        return nullptr;
+    }
+
+    const auto capacity_bytes = static_cast<size_t>(capacity_frames) * audio_format.bytes_per_frame();
+    auto memory = SharedMemory::create(name, k_header_size + capacity_bytes, lock_memory);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedAudioBuffer> buffer(new SharedAudioBuffer());
+    buffer->header_ = new (memory->data()) Header {};
+    buffer->data_ = memory->data() + k_header_size;
+    buffer->capacity_bytes_ = capacity_bytes;
+    buffer->audio_format_ = audio_format;
+    buffer->memory_ = std::move(memory);
+
+    auto& header = *buffer->header_;
+    header.version = k_version;
+    header.header_size = static_cast<uint32_t>(k_header_size);
+    header.capacity_frames = capacity_frames;
+    header.sample_rate = audio_format.sample_rate;
+    header.num_channels = audio_format.num_channels;
+    header.encoding = static_cast<uint8_t>(audio_format.encoding);
+    header.byte_order = static_cast<uint8_t>(audio_format.byte_order);
+    header.ordering = static_cast<uint8_t>(audio_format.ordering);
+    header.bytes_per_frame = audio_format.bytes_per_frame();
+    header.write_claim.store(0, std::memory_order_relaxed);
+    header.write_position.store(0, std::memory_order_relaxed);
+    header.write_time_ns.store(0, std::memory_order_relaxed);
+    std::memset(buffer->data_, audio_format.ground_value(), capacity_bytes);
+    header.magic.store(k_magic, std::memory_order_release);  // Makes the buffer visible to open()
+
+    return buffer;
+}
+
+std::unique_ptr<rav::rtp::SharedAudioBuffer> rav::rtp::SharedAudioBuffer::open(const std::string& name) {
+    auto memory = SharedMemory::open(name);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+
+    if (memory->size() < k_header_size) {
+        RAV_LOG_ERROR("Shared memory {} is too small for a shared audio buffer", name);
+        return nullptr;
+    }
+
+    auto* header = reinterpret_cast<Header*>(memory->data());
+    if (header->magic.load(std::memory_order_acquire) != k_magic) {
+        RAV_LOG_ERROR("Shared memory {} doesn't contain a shared audio buffer (yet)", name);
+        return nullptr;
+    }
+
+    if (header->version != k_version || header->header_size != k_header_size) {
+        RAV_LOG_ERROR("Shared audio buffer {} has an unsupported version ({})", name, header->version);
+        return nullptr;
+    }
+
+    AudioFormat audio_format;
+    audio_format.sample_rate = header->sample_rate;
+    audio_format.num_channels = header->num_channels;
+    audio_format.encoding = static_cast<AudioEncoding>(header->encoding);
+    audio_format.byte_order = static_cast<AudioFormat::ByteOrder>(header->byte_order);
+    audio_format.ordering = static_cast<AudioFormat::ChannelOrdering>(header->ordering);
+
+    const auto capacity_bytes = static_cast<size_t>(header->capacity_frames) * header->bytes_per_frame;
+    if (!audio_format.is_valid() || audio_format.bytes_per_frame() != header->bytes_per_frame || header->capacity_frames == 0
+        || memory->size() < k_header_size + capacity_bytes) {
+        RAV_LOG_ERROR("Shared audio buffer {} has an invalid header", name);
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedAudioBuffer> buffer(new SharedAudioBuffer());
+    buffer->header_ = header;
+    buffer->data_ = memory->data() + k_header_size;
+    buffer->capacity_bytes_ = capacity_bytes;
+    buffer->audio_format_ = audio_format;
+    buffer->memory_ = std::move(memory);
+    return buffer;
+}
+
+const rav::AudioFormat& rav::rtp::SharedAudioBuffer::get_audio_format() const {
+    return audio_format_;
+}
+
+uint32_t rav::rtp::SharedAudioBuffer::get_capacity_frames() const {
+    return header_->capacity_frames;
+}
+
+const std::string& rav::rtp::SharedAudioBuffer::get_name() const {
+    return memory_->name();
+}
+
+void rav::rtp::SharedAudioBuffer::write(const uint32_t timestamp, const BufferView<const uint8_t> data) {
+    const auto bytes_per_frame = header_->bytes_per_frame;
+    RAV_ASSERT_DEBUG(data.size_bytes() % bytes_per_frame == 0, "Data size must be a multiple of the frame size");
+    RAV_ASSERT_DEBUG(data.size_bytes() <= capacity_bytes_, "Data size exceeds the capacity");
+
+    auto region = prepare_write(timestamp, static_cast<uint32_t>(data.size_bytes() / bytes_per_frame));
+    std::memcpy(region.part1.data(), data.data(), region.part1.size_bytes());
+    if (!region.part2.empty()) {
+        std::memcpy(region.part2.data(), data.data() + region.part1.size_bytes(), region.part2.size_bytes());
+    }
+    commit_write();
+}
+
+rav::rtp::SharedAudioBuffer::Region<uint8_t> rav::rtp::SharedAudioBuffer::prepare_write(const uint32_t timestamp, const uint32_t num_frames) {
+    RAV_ASSERT_DEBUG(num_frames <= header_->capacity_frames, "Number of frames exceeds the capacity");
+
+    const auto capacity_frames = header_->capacity_frames;
+    const auto claim = unpack(header_->write_claim.load(std::memory_order_relaxed));  // Only written by this thread
+    const auto end_timestamp = timestamp + num_frames;
+    const auto distance = WrappingUint32(claim.end_timestamp).diff(timestamp);  // timestamp - claim end
+
+    auto new_claim = claim;
+    if (claim.generation == 0 || distance > static_cast<int64_t>(capacity_frames) || distance < -static_cast<int64_t>(capacity_frames)) {
+        // The timestamps jumped, none of the existing data belongs to the new timeline
+        new_claim = {claim.generation + 1 == 0 ? 1 : claim.generation + 1, end_timestamp};
+        header_->write_claim.store(pack(new_claim.generation, new_claim.end_timestamp), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memset(data_, audio_format_.ground_value(), capacity_bytes_);
+    } else if (WrappingUint32(end_timestamp) > WrappingUint32(claim.end_timestamp)) {
+        new_claim.end_timestamp = end_timestamp;
+        header_->write_claim.store(pack(new_claim.generation, new_claim.end_timestamp), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        if (distance > 0) {
+            // Clear the frames which were skipped
+            auto gap = get_region(claim.end_timestamp, static_cast<uint32_t>(distance));
+            std::memset(gap.part1.data(), audio_format_.ground_value(), gap.part1.size_bytes());
+            std::memset(gap.part2.data(), audio_format_.ground_value(), gap.part2.size_bytes());
+        }
+    }
+    // Else older frames are filled in, which doesn't move the claim
+
+    auto region = get_region(timestamp, num_frames);
+    region.generation = new_claim.generation;
+    return region;
+}
+
+void rav::rtp::SharedAudioBuffer::commit_write() {
+    header_->write_time_ns.store(clock::now_monotonic_high_resolution_ns(), std::memory_order_relaxed);
+    header_->write_position.store(header_->write_claim.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+std::optional<rav::rtp::SharedAudioBuffer::Position> rav::rtp::SharedAudioBuffer::get_write_position() const {
+    const auto position = unpack(header_->write_position.load(std::memory_order_acquire));
+    if (position.generation == 0) {
+        return std::nullopt;
+    }
+    return position;
+}
+
+uint64_t rav::rtp::SharedAudioBuffer::get_write_time_ns() const {
+    return header_->write_time_ns.load(std::memory_order_relaxed);
+}
+
+bool rav::rtp::SharedAudioBuffer::read(const uint32_t timestamp, uint8_t* buffer, const size_t buffer_size) const {
+    const auto bytes_per_frame = header_->bytes_per_frame;
+    if (buffer_size % bytes_per_frame != 0 || buffer_size > capacity_bytes_) {
+        RAV_ASSERT_DEBUG(false, "Invalid buffer size");
+        return false;
+    }
+
+    const auto region = get_readable_region(timestamp, static_cast<uint32_t>(buffer_size / bytes_per_frame));
+    if (!region) {
+        return false;
+    }
+
+    std::memcpy(buffer, region->part1.data(), region->part1.size_bytes());
+    if (!region->part2.empty()) {
+        std::memcpy(buffer + region->part1.size_bytes(), region->part2.data(), region->part2.size_bytes());
+    }
+
+    return is_valid(timestamp, region->generation);
+}
+
+std::optional<rav::rtp::SharedAudioBuffer::Region<const uint8_t>>
+rav::rtp::SharedAudioBuffer::get_readable_region(const uint32_t timestamp, const uint32_t num_frames) const {
+    const auto position = get_write_position();
+    if (!position || !is_in_window(position->end_timestamp, header_->capacity_frames, timestamp, num_frames)) {
+        return std::nullopt;
+    }
+
+    const auto region = get_region(timestamp, num_frames);
+    return Region<const uint8_t> {region.part1.const_view(), region.part2.const_view(), position->generation};
+}
+
+bool rav::rtp::SharedAudioBuffer::is_valid(const uint32_t timestamp, const uint32_t generation) const {
+    std::atomic_thread_fence(std::memory_order_acquire);  // Orders the reads of the data before reading the claim
+    const auto claim = unpack(header_->write_claim.load(std::memory_order_relaxed));
+    return claim.generation == generation && is_in_window(claim.end_timestamp, header_->capacity_frames, timestamp, 0);
+}
+
+rav::rtp::SharedAudioBuffer::Region<uint8_t> rav::rtp::SharedAudioBuffer::get_region(const uint32_t timestamp, const uint32_t num_frames) const {
+    const auto bytes_per_frame = header_->bytes_per_frame;
+    const Fifo::Position position(
+        static_cast<size_t>(timestamp) * bytes_per_frame, capacity_bytes_, static_cast<size_t>(num_frames) * bytes_per_frame
+    );
+    return {BufferView(data_ + position.index1, position.size1), BufferView(data_, position.size2), 0};
+}
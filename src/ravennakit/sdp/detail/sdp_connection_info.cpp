@@ -26,76 +26,14 @@
 
 #include "ravennakit/core/string_parser.hpp"
 #include "ravennakit/sdp/detail/sdp_constants.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 tl::expected<rav::sdp::ConnectionInfoField, std::string> rav::sdp::parse_connection_info(const std::string_view line) {
-    StringParser parser(line);
-
-    if (!parser.skip("c=")) {
-        return tl::unexpected("connection: expecting 'c='");
-    }
-
-    ConnectionInfoField info;
-
-    // Network type
-    if (const auto network_type = parser.split(' ')) {
-        if (*network_type == k_sdp_inet) {
-            info.network_type = NetwType::internet;
-        } else {
-            return tl::unexpected("connection: invalid network type");
-        }
-    } else {
-        return tl::unexpected("connection: failed to parse network type");
-    }
-
-    // Address type
-    if (const auto address_type = parser.split(' ')) {
-        if (*address_type == k_sdp_ipv4) {
-            info.address_type = AddrType::ipv4;
-        } else if (*address_type == k_sdp_ipv6) {
-            info.address_type = AddrType::ipv6;
-        } else {
-            return tl::unexpected("connection: invalid address type");
-        }
-    } else {
-        return tl::unexpected("connection: failed to parse address type");
-    }
-
-    // Address
-    if (const auto address = parser.split('/')) {
-        info.address = *address;
+    auto view = parse_connection_info_view(line);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    if (parser.exhausted()) {
-        return info;
-    }
-
-    // Parse optional ttl and number of addresses
-    if (info.address_type == AddrType::ipv4) {
-        if (auto ttl = parser.read_int<int32_t>()) {
-            info.ttl = *ttl;
-        } else {
-            return tl::unexpected("connection: failed to parse ttl for ipv4 address");
-        }
-        if (parser.skip('/')) {
-            if (auto num_addresses = parser.read_int<int32_t>()) {
-                info.number_of_addresses = *num_addresses;
-            } else {
-                return tl::unexpected("connection: failed to parse number of addresses for ipv4 address");
-            }
-        }
-    } else if (info.address_type == sdp::AddrType::ipv6) {
-        if (auto num_addresses = parser.read_int<int32_t>()) {
-            info.number_of_addresses = *num_addresses;
-        } else {
-            return tl::unexpected("connection: failed to parse number of addresses for ipv4 address");
-        }
-    }
-
-    if (!parser.exhausted()) {
-        return tl::unexpected("connection: unexpected characters at end of line");
-    }
-
-    return info;
+    return to_connection_info(*view);
 }
 
 std::string rav::sdp::to_string(const ConnectionInfoField& field) {
@@ -26,46 +26,14 @@
 #include "ravennakit/core/string_parser.hpp"
 
 #include "ravennakit/core/format.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 tl::expected<rav::sdp::Format, std::string> rav::sdp::parse_format(const std::string_view line) {
-    StringParser parser(line);
-
-    Format map;
-
-    if (const auto payload_type = parser.read_int<uint8_t>()) {
-        map.payload_type = *payload_type;
-        if (!parser.skip(' ')) {
-            return tl::unexpected("rtpmap: expecting space after payload type");
-        }
-    } else {
-        return tl::unexpected("rtpmap: invalid payload type");
+    auto view = parse_format_view(line);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    if (const auto encoding_name = parser.split('/')) {
-        map.encoding_name = *encoding_name;
-    } else {
-        return tl::unexpected("rtpmap: failed to parse encoding name");
-    }
-
-    if (const auto clock_rate = parser.read_int<uint32_t>()) {
-        map.clock_rate = *clock_rate;
-    } else {
-        return tl::unexpected("rtpmap: invalid clock rate");
-    }
-
-    if (parser.skip('/')) {
-        if (const auto num_channels = parser.read_int<uint32_t>()) {
-            // Note: strictly speaking the encoding parameters can be anything, but as of now it's only used for
-            // channels.
-            map.num_channels = *num_channels;
-        } else {
-            return tl::unexpected("rtpmap: failed to parse number of channels");
-        }
-    } else {
-        map.num_channels = 1;
-    }
-
-    return map;
+    return to_format(*view);
 }
 
 std::optional<rav::sdp::Format> rav::sdp::make_audio_format(const AudioFormat& input_format) {
@@ -26,29 +26,16 @@
 
 #include "ravennakit/core/string_parser.hpp"
 #include "ravennakit/core/support.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 #include <fmt/ranges.h>
 
 tl::expected<rav::sdp::Group, std::string> rav::sdp::parse_group(const std::string_view line) {
-    StringParser parser(line);
-
-    const auto type = parser.read_until(' ');
-    if (!type) {
-        return tl::unexpected("Invalid group type");
-    }
-
-    if (*type != "DUP") {
-        return tl::unexpected(fmt::format("Unsupported group type ({})"));
+    auto view = parse_group_view(line);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    Group group;
-    group.type = Group::Type::dup;
-
-    for (auto tag = parser.split(' '); tag.has_value(); tag = parser.split(' ')) {
-        group.tags.emplace_back(*tag);
-    }
-
-    return group;
+    return to_group(*view);
 }
 
 std::string rav::sdp::to_string(const Group& input) {
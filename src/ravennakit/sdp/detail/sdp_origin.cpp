@@ -25,69 +25,14 @@
 #include "ravennakit/sdp/detail/sdp_origin.hpp"
 #include "ravennakit/core/string_parser.hpp"
 #include "ravennakit/sdp/detail/sdp_constants.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
-tl::expected<rav::sdp::OriginField, std::string> rav::sdp::parse_origin(std::string_view line) {
-    StringParser parser(line);
-
-    if (!parser.skip("o=")) {
-        return tl::unexpected("origin: expecting 'o='");
-    }
-
-    OriginField o;
-
-    // Username
-    if (const auto username = parser.split(' ')) {
-        o.username = *username;
-    } else {
-        return tl::unexpected("origin: failed to parse username");
-    }
-
-    // Session id
-    if (const auto session_id = parser.split(' ')) {
-        o.session_id = *session_id;
-    } else {
-        return tl::unexpected("origin: failed to parse session id");
-    }
-
-    // Session version
-    if (const auto version = parser.read_int<int32_t>()) {
-        o.session_version = *version;
-        parser.skip(' ');
-    } else {
-        return tl::unexpected("origin: failed to parse session version");
+tl::expected<rav::sdp::OriginField, std::string> rav::sdp::parse_origin(const std::string_view line) {
+    auto view = parse_origin_view(line);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    // Network type
-    if (const auto network_type = parser.split(' ')) {
-        if (*network_type != k_sdp_inet) {
-            return tl::unexpected("origin: invalid network type");
-        }
-        o.network_type = NetwType::internet;
-    } else {
-        return tl::unexpected("origin: failed to parse network type");
-    }
-
-    // Address type
-    if (const auto address_type = parser.split(' ')) {
-        if (*address_type == k_sdp_ipv4) {
-            o.address_type = AddrType::ipv4;
-        } else if (*address_type == k_sdp_ipv6) {
-            o.address_type = AddrType::ipv6;
-        } else {
-            return tl::unexpected("origin: invalid address type");
-        }
-    } else {
-        return tl::unexpected("origin: failed to parse address type");
-    }
-
-    // Address
-    if (const auto address = parser.split(' ')) {
-        o.unicast_address = *address;
-    } else {
-        return tl::unexpected("origin: failed to parse address");
-    }
-
-    return o;
+    return to_origin(*view);
 }
 
 std::string rav::sdp::to_string(const OriginField& field) {
@@ -28,6 +28,7 @@
 #include "ravennakit/core/string.hpp"
 #include "ravennakit/core/string_parser.hpp"
 #include "ravennakit/sdp/detail/sdp_constants.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 namespace {}  // namespace
 
@@ -81,52 +82,11 @@ std::string rav::sdp::to_string(const ReferenceClock& reference_clock) {
 }
 
 tl::expected<rav::sdp::ReferenceClock, std::string> rav::sdp::parse_reference_clock(const std::string_view line) {
-    StringParser parser(line);
-
-    const auto source = parser.split("=");
-    if (!source) {
-        return tl::unexpected("reference_clock: invalid source");
+    auto view = parse_reference_clock_view(line);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    if (source == "ptp") {
-        ReferenceClock ref_clock;
-
-        ref_clock.source_ = ReferenceClock::ClockSource::ptp;
-
-        if (const auto ptp_version = parser.split(":")) {
-            if (ptp_version == "IEEE1588-2002") {
-                ref_clock.ptp_version_ = ReferenceClock::PtpVersion::IEEE_1588_2002;
-            } else if (ptp_version == "IEEE1588-2008") {
-                ref_clock.ptp_version_ = ReferenceClock::PtpVersion::IEEE_1588_2008;
-            } else if (ptp_version == "IEEE802.1AS-2011") {
-                ref_clock.ptp_version_ = ReferenceClock::PtpVersion::IEEE_802_1AS_2011;
-            } else if (ptp_version == "traceable") {
-                ref_clock.ptp_version_ = ReferenceClock::PtpVersion::traceable;
-            } else {
-                return tl::unexpected("reference_clock: unknown ptp version");
-            }
-        }
-
-        if (const auto gmid = parser.split(":")) {
-            ref_clock.gmid_ = *gmid;
-        }
-
-        if (parser.exhausted()) {
-            return ref_clock;
-        }
-
-        if (const auto domain = parser.read_int<int32_t>()) {
-            ref_clock.domain_ = *domain;
-        } else {
-            return tl::unexpected("reference_clock: invalid domain");
-        }
-
-        return ref_clock;
-    }
-
-    RAV_LOG_WARNING("reference_clock: ignoring clock source: {}", *source);
-
-    return tl::unexpected("reference_clock: unsupported source");
+    return to_reference_clock(*view);
 }
 
 tl::expected<void, std::string> rav::sdp::validate(const ReferenceClock& reference_clock) {
@@ -32,6 +32,7 @@
 #include "ravennakit/sdp/sdp_media_description.hpp"
 #include "ravennakit/sdp/detail/sdp_constants.hpp"
 #include "ravennakit/sdp/detail/sdp_reference_clock.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 void rav::sdp::SessionDescription::add_or_update_source_filter(const SourceFilter& filter) {
     for (auto& f : source_filters) {
@@ -45,83 +46,12 @@ void rav::sdp::SessionDescription::add_or_update_source_filter(const SourceFilte
 }
 
 tl::expected<void, std::string> rav::sdp::SessionDescription::parse_attribute(const std::string_view line) {
-    StringParser parser(line);
-
-    if (!parser.skip("a=")) {
-        return tl::unexpected("attribute: expecting 'a='");
+    SessionDescriptionView view;
+    auto result = sdp::parse_attribute(view, line);
+    if (!result) {
+        return tl::unexpected(result.error());
     }
-
-    const auto key = parser.split(':');
-
-    if (!key) {
-        return tl::unexpected("attribute: expecting key");
-    }
-
-    if (key == k_sdp_sendrecv) {
-        media_direction = MediaDirection::sendrecv;
-    } else if (key == k_sdp_sendonly) {
-        media_direction = MediaDirection::sendonly;
-    } else if (key == k_sdp_recvonly) {
-        media_direction = MediaDirection::recvonly;
-    } else if (key == k_sdp_inactive) {
-        media_direction = MediaDirection::inactive;
-    } else if (key == k_sdp_ts_refclk) {
-        if (const auto value = parser.read_until_end()) {
-            auto ref_clock = parse_reference_clock(*value);
-            if (!ref_clock) {
-                return tl::unexpected(ref_clock.error());
-            }
-            reference_clock = std::move(*ref_clock);
-        }
-    } else if (key == MediaClockSource::k_attribute_name) {
-        if (const auto value = parser.read_until_end()) {
-            auto clock = parse_media_clock_source(*value);
-            if (!clock) {
-                return tl::unexpected(clock.error());
-            }
-            media_clock = *clock;
-        }
-    } else if (key == RavennaClockDomain::k_attribute_name) {
-        if (const auto value = parser.read_until_end()) {
-            auto clock_domain = parse_ravenna_clock_domain(*value);
-            if (!clock_domain) {
-                return tl::unexpected(clock_domain.error());
-            }
-            ravenna_clock_domain = *clock_domain;
-        }
-    } else if (key == SourceFilter::k_attribute_name) {
-        if (const auto value = parser.read_until_end()) {
-            auto filter = parse_source_filter(*value);
-            if (!filter) {
-                return tl::unexpected(filter.error());
-            }
-            source_filters.push_back(std::move(*filter));
-        } else {
-            return tl::unexpected("media: failed to parse source-filter value");
-        }
-    } else if (key == k_sdp_sync_time) {
-        if (const auto rtp_ts = parser.read_int<uint32_t>()) {
-            ravenna_sync_time = *rtp_ts;
-        } else {
-            return tl::unexpected("media: failed to parse sync-time value");
-        }
-    } else if (key == k_sdp_group) {
-        if (const auto value = parser.read_until_end()) {
-            auto new_group = parse_group(*value);
-            if (!new_group.has_value()) {
-                return tl::unexpected(new_group.error());
-            }
-            group = *new_group;
-        }
-    } else {
-        // Store the attribute in the map of unknown attributes
-        if (auto value = parser.read_until_end()) {
-            attributes.emplace(*key, *value);
-        } else {
-            return tl::unexpected("media: failed to parse attribute value");
-        }
-    }
-
+    merge_attributes(view, *this);
     return {};
 }
 
@@ -141,91 +71,11 @@ tl::expected<int, std::string> rav::sdp::parse_version(const std::string_view li
 }
 
 tl::expected<rav::sdp::SessionDescription, std::string> rav::sdp::parse_session_description(const std::string& sdp_text) {
-    SessionDescription sd;
-    StringParser parser(sdp_text);
-
-    for (auto line = parser.read_line(); line.has_value(); line = parser.read_line()) {
-        if (line->empty()) {
-            continue;
-        }
-
-        switch (line->front()) {
-            case 'v': {
-                auto result = parse_version(*line);
-                if (!result) {
-                    return tl::unexpected(result.error());
-                }
-                sd.version = *result;
-                break;
-            }
-            case 'o': {
-                auto result = parse_origin(*line);
-                if (!result) {
-                    return tl::unexpected(result.error());
-                }
-                sd.origin = std::move(*result);
-                break;
-            }
-            case 's': {
-                sd.session_name = line->substr(2);
-                break;
-            }
-            case 'c': {
-                auto result = parse_connection_info(*line);
-                if (!result) {
-                    return tl::unexpected(result.error());
-                }
-                if (!sd.media_descriptions.empty()) {
-                    sd.media_descriptions.back().connection_infos.push_back(std::move(*result));
-                } else {
-                    sd.connection_info = std::move(*result);
-                }
-                break;
-            }
-            case 't': {
-                auto time_active = parse_time_active(*line);
-                if (!time_active) {
-                    return tl::unexpected(time_active.error());
-                }
-                sd.time_active = *time_active;
-                break;
-            }
-            case 'm': {
-                auto desc = parse_media_description(*line);
-                if (!desc) {
-                    return tl::unexpected(desc.error());
-                }
-                sd.media_descriptions.push_back(*desc);
-                break;
-            }
-            case 'a': {
-                if (!sd.media_descriptions.empty()) {
-                    auto result = sd.media_descriptions.back().parse_attribute(*line);
-                    if (!result) {
-                        return tl::unexpected(result.error());
-                    }
-                } else {
-                    auto result = sd.parse_attribute(*line);
-                    if (!result) {
-                        return tl::unexpected(result.error());
-                    }
-                }
-                break;
-            }
-            case 'i': {
-                if (!sd.media_descriptions.empty()) {
-                    sd.media_descriptions.back().session_information = std::string(line->substr(2));
-                } else {
-                    sd.session_information = line->substr(2);
-                }
-                break;
-            }
-            default:
-                return tl::unexpected(fmt::format("Unknown line: {}", *line));
-        }
+    auto view = parse_session_description_view(sdp_text);
+    if (!view) {
+        return tl::unexpected(view.error());
     }
-
-    return sd;
+    return to_session_description(*view);
 }
 
 std::optional<std::string> rav::sdp::to_string(const SessionDescription& session_description, const char* newline) {
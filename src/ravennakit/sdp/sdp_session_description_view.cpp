@@ -0,0 +1,862 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
+
+#include "ravennakit/core/log.hpp"
+#include "ravennakit/core/string_parser.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+/// Decodes a numeric address without allocating, or returns an unspecified address if the text is not one.
+boost::asio::ip::address decode_address(const std::string_view text) {
+    std::array<char, 64> buffer {};
+    if (text.empty() || text.size() >= buffer.size()) {
+        return {};
+    }
+    std::memcpy(buffer.data(), text.data(), text.size());
+    boost::system::error_code ec;
+    auto address = boost::asio::ip::make_address(buffer.data(), ec);
+    if (ec) {
+        return {};
+    }
+    return address;
+}
+
+/// Reads a float from the beginning of given text like std::stof, without allocating.
+std::optional<float> decode_float(const std::string_view text) {
+    std::array<char, 32> buffer {};
+    const auto size = std::min(text.size(), buffer.size() - 1);
+    std::memcpy(buffer.data(), text.data(), size);
+    char* end = nullptr;
+    const auto value = std::strtof(buffer.data(), &end);
+    if (end == buffer.data()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+rav::sdp::AddressView make_address_view(const std::string_view text) {
+    return {text, decode_address(text)};
+}
+
+/**
+ * Parses the attributes which are allowed on both the session and the media level.
+ * @return True if the attribute was handled, false if it's not a common attribute, or an error.
+ */
+template<class T>
+tl::expected<bool, std::string> parse_common_attribute(T& target, const std::string_view key, rav::StringParser& parser) {
+    if (key == rav::sdp::k_sdp_sendrecv) {
+        target.media_direction = rav::sdp::MediaDirection::sendrecv;
+    } else if (key == rav::sdp::k_sdp_sendonly) {
+        target.media_direction = rav::sdp::MediaDirection::sendonly;
+    } else if (key == rav::sdp::k_sdp_recvonly) {
+        target.media_direction = rav::sdp::MediaDirection::recvonly;
+    } else if (key == rav::sdp::k_sdp_inactive) {
+        target.media_direction = rav::sdp::MediaDirection::inactive;
+    } else if (key == rav::sdp::MediaClockSource::k_attribute_name) {
+        if (const auto value = parser.read_until_end()) {
+            auto clock = rav::sdp::parse_media_clock_source(*value);
+            if (!clock) {
+                return tl::unexpected(clock.error());
+            }
+            target.media_clock = *clock;
+        } else if constexpr (std::is_same_v<T, rav::sdp::MediaDescriptionView>) {
+            return tl::unexpected("media: failed to parse media clock value");
+        }
+    } else if (key == rav::sdp::RavennaClockDomain::k_attribute_name) {
+        if (const auto value = parser.read_until_end()) {
+            auto clock_domain = rav::sdp::parse_ravenna_clock_domain(*value);
+            if (!clock_domain) {
+                return tl::unexpected(clock_domain.error());
+            }
+            target.ravenna_clock_domain = *clock_domain;
+        } else if constexpr (std::is_same_v<T, rav::sdp::MediaDescriptionView>) {
+            return tl::unexpected("media: failed to parse clock domain value");
+        }
+    } else if (key == rav::sdp::k_sdp_ts_refclk) {
+        if (const auto value = parser.read_until_end()) {
+            auto ref_clock = rav::sdp::parse_reference_clock_view(*value);
+            if (!ref_clock) {
+                return tl::unexpected(ref_clock.error());
+            }
+            target.reference_clock = *ref_clock;
+        } else if constexpr (std::is_same_v<T, rav::sdp::MediaDescriptionView>) {
+            return tl::unexpected("media: failed to parse ts-refclk value");
+        }
+    } else if (key == rav::sdp::SourceFilter::k_attribute_name) {
+        if (const auto value = parser.read_until_end()) {
+            auto filter = rav::sdp::parse_source_filter_view(*value);
+            if (!filter) {
+                return tl::unexpected(filter.error());
+            }
+            target.source_filters.push_back(std::move(*filter));
+        } else {
+            return tl::unexpected("media: failed to parse source-filter value");
+        }
+    } else if (key == rav::sdp::k_sdp_sync_time) {
+        if (const auto rtp_ts = parser.read_int<uint32_t>()) {
+            target.ravenna_sync_time = *rtp_ts;
+        } else {
+            return tl::unexpected("media: failed to parse sync-time value");
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+tl::expected<void, std::string> add_unknown_attribute(
+    boost::container::small_vector<rav::sdp::AttributeView, 4>& attributes, const std::string_view key, rav::StringParser& parser
+) {
+    if (const auto value = parser.read_until_end()) {
+        attributes.push_back({key, *value});
+        return {};
+    }
+    return tl::unexpected("media: failed to parse attribute value");
+}
+
+template<class Map>
+void add_attributes(Map& map, const boost::container::small_vector<rav::sdp::AttributeView, 4>& attributes) {
+    for (auto& attribute : attributes) {
+        map.emplace(attribute.key, attribute.value);
+    }
+}
+
+}  // namespace
+
+tl::expected<rav::sdp::OriginView, std::string> rav::sdp::parse_origin_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    if (!parser.skip("o=")) {
+        return tl::unexpected("origin: expecting 'o='");
+    }
+
+    rav::sdp::OriginView o;
+
+    if (const auto username = parser.split(' ')) {
+        o.username = *username;
+    } else {
+        return tl::unexpected("origin: failed to parse username");
+    }
+
+    if (const auto session_id = parser.split(' ')) {
+        o.session_id = *session_id;
+    } else {
+        return tl::unexpected("origin: failed to parse session id");
+    }
+
+    if (const auto version = parser.read_int<int32_t>()) {
+        o.session_version = *version;
+        parser.skip(' ');
+    } else {
+        return tl::unexpected("origin: failed to parse session version");
+    }
+
+    if (const auto network_type = parser.split(' ')) {
+        if (*network_type != rav::sdp::k_sdp_inet) {
+            return tl::unexpected("origin: invalid network type");
+        }
+        o.network_type = rav::sdp::NetwType::internet;
+    } else {
+        return tl::unexpected("origin: failed to parse network type");
+    }
+
+    if (const auto address_type = parser.split(' ')) {
+        if (*address_type == rav::sdp::k_sdp_ipv4) {
+            o.address_type = rav::sdp::AddrType::ipv4;
+        } else if (*address_type == rav::sdp::k_sdp_ipv6) {
+            o.address_type = rav::sdp::AddrType::ipv6;
+        } else {
+            return tl::unexpected("origin: invalid address type");
+        }
+    } else {
+        return tl::unexpected("origin: failed to parse address type");
+    }
+
+    if (const auto address = parser.split(' ')) {
+        o.unicast_address = make_address_view(*address);
+    } else {
+        return tl::unexpected("origin: failed to parse address");
+    }
+
+    return o;
+}
+
+tl::expected<rav::sdp::ConnectionInfoView, std::string> rav::sdp::parse_connection_info_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    if (!parser.skip("c=")) {
+        return tl::unexpected("connection: expecting 'c='");
+    }
+
+    rav::sdp::ConnectionInfoView info;
+
+    if (const auto network_type = parser.split(' ')) {
+        if (*network_type == rav::sdp::k_sdp_inet) {
+            info.network_type = rav::sdp::NetwType::internet;
+        } else {
+            return tl::unexpected("connection: invalid network type");
+        }
+    } else {
+        return tl::unexpected("connection: failed to parse network type");
+    }
+
+    if (const auto address_type = parser.split(' ')) {
+        if (*address_type == rav::sdp::k_sdp_ipv4) {
+            info.address_type = rav::sdp::AddrType::ipv4;
+        } else if (*address_type == rav::sdp::k_sdp_ipv6) {
+            info.address_type = rav::sdp::AddrType::ipv6;
+        } else {
+            return tl::unexpected("connection: invalid address type");
+        }
+    } else {
+        return tl::unexpected("connection: failed to parse address type");
+    }
+
+    if (const auto address = parser.split('/')) {
+        info.address = make_address_view(*address);
+    }
+
+    if (parser.exhausted()) {
+        return info;
+    }
+
+    if (info.address_type == rav::sdp::AddrType::ipv4) {
+        if (const auto ttl = parser.read_int<int32_t>()) {
+            info.ttl = *ttl;
+        } else {
+            return tl::unexpected("connection: failed to parse ttl for ipv4 address");
+        }
+        if (parser.skip('/')) {
+            if (const auto num_addresses = parser.read_int<int32_t>()) {
+                info.number_of_addresses = *num_addresses;
+            } else {
+                return tl::unexpected("connection: failed to parse number of addresses for ipv4 address");
+            }
+        }
+    } else if (info.address_type == rav::sdp::AddrType::ipv6) {
+        if (const auto num_addresses = parser.read_int<int32_t>()) {
+            info.number_of_addresses = *num_addresses;
+        } else {
+            return tl::unexpected("connection: failed to parse number of addresses for ipv4 address");
+        }
+    }
+
+    if (!parser.exhausted()) {
+        return tl::unexpected("connection: unexpected characters at end of line");
+    }
+
+    return info;
+}
+
+tl::expected<rav::sdp::FormatView, std::string> rav::sdp::parse_format_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    rav::sdp::FormatView map;
+
+    if (const auto payload_type = parser.read_int<uint8_t>()) {
+        map.payload_type = *payload_type;
+        if (!parser.skip(' ')) {
+            return tl::unexpected("rtpmap: expecting space after payload type");
+        }
+    } else {
+        return tl::unexpected("rtpmap: invalid payload type");
+    }
+
+    if (const auto encoding_name = parser.split('/')) {
+        map.encoding_name = *encoding_name;
+    } else {
+        return tl::unexpected("rtpmap: failed to parse encoding name");
+    }
+
+    if (const auto clock_rate = parser.read_int<uint32_t>()) {
+        map.clock_rate = *clock_rate;
+    } else {
+        return tl::unexpected("rtpmap: invalid clock rate");
+    }
+
+    if (parser.skip('/')) {
+        if (const auto num_channels = parser.read_int<uint32_t>()) {
+            map.num_channels = *num_channels;
+        } else {
+            return tl::unexpected("rtpmap: failed to parse number of channels");
+        }
+    } else {
+        map.num_channels = 1;
+    }
+
+    return map;
+}
+
+tl::expected<rav::sdp::ReferenceClockView, std::string> rav::sdp::parse_reference_clock_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    const auto source = parser.split('=');
+    if (!source) {
+        return tl::unexpected("reference_clock: invalid source");
+    }
+
+    if (*source != "ptp") {
+        RAV_LOG_WARNING("reference_clock: ignoring clock source: {}", *source);
+        return tl::unexpected("reference_clock: unsupported source");
+    }
+
+    rav::sdp::ReferenceClockView ref_clock;
+    ref_clock.source = rav::sdp::ReferenceClock::ClockSource::ptp;
+
+    if (const auto ptp_version = parser.split(':')) {
+        if (*ptp_version == "IEEE1588-2002") {
+            ref_clock.ptp_version = rav::sdp::ReferenceClock::PtpVersion::IEEE_1588_2002;
+        } else if (*ptp_version == "IEEE1588-2008") {
+            ref_clock.ptp_version = rav::sdp::ReferenceClock::PtpVersion::IEEE_1588_2008;
+        } else if (*ptp_version == "IEEE802.1AS-2011") {
+            ref_clock.ptp_version = rav::sdp::ReferenceClock::PtpVersion::IEEE_802_1AS_2011;
+        } else if (*ptp_version == "traceable") {
+            ref_clock.ptp_version = rav::sdp::ReferenceClock::PtpVersion::traceable;
+        } else {
+            return tl::unexpected("reference_clock: unknown ptp version");
+        }
+    }
+
+    if (const auto gmid = parser.split(':')) {
+        ref_clock.gmid = *gmid;
+    }
+
+    if (parser.exhausted()) {
+        return ref_clock;
+    }
+
+    if (const auto domain = parser.read_int<int32_t>()) {
+        ref_clock.domain = *domain;
+    } else {
+        return tl::unexpected("reference_clock: invalid domain");
+    }
+
+    return ref_clock;
+}
+
+tl::expected<rav::sdp::SourceFilterView, std::string> rav::sdp::parse_source_filter_view(const std::string_view line) {
+    rav::sdp::SourceFilterView filter;
+    rav::StringParser parser(line);
+
+    if (!parser.skip(' ')) {
+        return tl::unexpected("source_filter: leading space not found");
+    }
+
+    const auto filter_mode = parser.split(' ');
+    if (!filter_mode) {
+        return tl::unexpected("source_filter: filter mode not found");
+    }
+    if (*filter_mode == "incl") {
+        filter.mode = rav::sdp::FilterMode::include;
+    } else if (*filter_mode == "excl") {
+        filter.mode = rav::sdp::FilterMode::exclude;
+    } else {
+        return tl::unexpected("source_filter: invalid filter mode");
+    }
+
+    const auto netw_type = parser.split(' ');
+    if (!netw_type) {
+        return tl::unexpected("source_filter: network type not found");
+    }
+    if (*netw_type == rav::sdp::k_sdp_inet) {
+        filter.net_type = rav::sdp::NetwType::internet;
+    } else {
+        return tl::unexpected("source_filter: invalid network type");
+    }
+
+    const auto addr_type = parser.split(' ');
+    if (!addr_type) {
+        return tl::unexpected("source_filter: address type not found");
+    }
+    if (*addr_type == rav::sdp::k_sdp_ipv4) {
+        filter.addr_type = rav::sdp::AddrType::ipv4;
+    } else if (*addr_type == rav::sdp::k_sdp_ipv6) {
+        filter.addr_type = rav::sdp::AddrType::ipv6;
+    } else if (*addr_type == rav::sdp::k_sdp_wildcard) {
+        filter.addr_type = rav::sdp::AddrType::both;
+    } else {
+        return tl::unexpected("source_filter: invalid address type");
+    }
+
+    const auto dest_address = parser.split(' ');
+    if (!dest_address) {
+        return tl::unexpected("source_filter: destination address not found");
+    }
+    if (dest_address->empty()) {
+        return tl::unexpected("source_filter: destination address is empty");
+    }
+    filter.dest_address = make_address_view(*dest_address);
+
+    constexpr auto s_loop_upper_bound = 100'000;
+    for (auto i = 0; i < s_loop_upper_bound; ++i) {
+        const auto src_address = parser.split(' ');
+        if (!src_address) {
+            break;
+        }
+        if (src_address->empty()) {
+            return tl::unexpected("source_filter: source address is empty");
+        }
+        filter.src_list.push_back(make_address_view(*src_address));
+    }
+
+    return filter;
+}
+
+tl::expected<rav::sdp::GroupView, std::string> rav::sdp::parse_group_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    const auto type = parser.read_until(' ');
+    if (!type) {
+        return tl::unexpected("Invalid group type");
+    }
+
+    if (*type != "DUP") {
+        return tl::unexpected(fmt::format("Unsupported group type ({})", *type));
+    }
+
+    rav::sdp::GroupView group;
+    group.type = rav::sdp::Group::Type::dup;
+
+    for (auto tag = parser.split(' '); tag.has_value(); tag = parser.split(' ')) {
+        group.tags.push_back(*tag);
+    }
+
+    return group;
+}
+
+tl::expected<rav::sdp::MediaDescriptionView, std::string> rav::sdp::parse_media_description_view(const std::string_view line) {
+    rav::StringParser parser(line);
+
+    if (!parser.skip("m=")) {
+        return tl::unexpected("media: expecting 'm='");
+    }
+
+    rav::sdp::MediaDescriptionView media;
+
+    if (const auto media_type = parser.split(' ')) {
+        media.media_type = *media_type;
+    } else {
+        return tl::unexpected("media: failed to parse media type");
+    }
+
+    if (const auto port = parser.read_int<uint16_t>()) {
+        media.port = *port;
+        if (parser.skip('/')) {
+            if (const auto num_ports = parser.read_int<uint16_t>()) {
+                media.number_of_ports = *num_ports;
+            } else {
+                return tl::unexpected("media: failed to parse number of ports as integer");
+            }
+        } else {
+            media.number_of_ports = 1;
+        }
+        parser.skip(' ');
+    } else {
+        return tl::unexpected("media: failed to parse port as integer");
+    }
+
+    if (const auto protocol = parser.split(' ')) {
+        media.protocol = *protocol;
+    } else {
+        return tl::unexpected("media: failed to parse protocol");
+    }
+
+    while (const auto format_str = parser.split(' ')) {
+        if (const auto value = rav::string_to_int<uint8_t>(*format_str)) {
+            media.formats.push_back({*value, {}, {}, {}});
+        } else {
+            return tl::unexpected("media: format integer parsing failed");
+        }
+    }
+
+    return media;
+}
+
+tl::expected<void, std::string> rav::sdp::parse_attribute(SessionDescriptionView& session, const std::string_view line) {
+    StringParser parser(line);
+
+    if (!parser.skip("a=")) {
+        return tl::unexpected("attribute: expecting 'a='");
+    }
+
+    const auto key = parser.split(':');
+    if (!key) {
+        return tl::unexpected("attribute: expecting key");
+    }
+
+    const auto handled = parse_common_attribute(session, *key, parser);
+    if (!handled) {
+        return tl::unexpected(handled.error());
+    }
+    if (*handled) {
+        return {};
+    }
+
+    if (*key == rav::sdp::k_sdp_group) {
+        if (const auto value = parser.read_until_end()) {
+            auto group = parse_group_view(*value);
+            if (!group) {
+                return tl::unexpected(group.error());
+            }
+            session.group = std::move(*group);
+        }
+        return {};
+    }
+
+    return add_unknown_attribute(session.attributes, *key, parser);
+}
+
+tl::expected<void, std::string> rav::sdp::parse_attribute(MediaDescriptionView& media, const std::string_view line) {
+    StringParser parser(line);
+
+    if (!parser.skip("a=")) {
+        return tl::unexpected("attribute: expecting 'a='");
+    }
+
+    const auto key = parser.split(':');
+    if (!key) {
+        return tl::unexpected("attribute: expecting key");
+    }
+
+    if (*key == rav::sdp::k_sdp_rtp_map) {
+        const auto value = parser.read_until_end();
+        if (!value) {
+            return tl::unexpected("media: failed to parse rtpmap value");
+        }
+        const auto format = parse_format_view(*value);
+        if (!format) {
+            return tl::unexpected(format.error());
+        }
+        for (auto& fmt : media.formats) {
+            if (fmt.payload_type == format->payload_type) {
+                fmt = *format;
+                return {};
+            }
+        }
+        return tl::unexpected("media: rtpmap attribute for unknown payload type");
+    }
+
+    if (*key == rav::sdp::k_sdp_ptime || *key == rav::sdp::k_sdp_max_ptime) {
+        const auto is_ptime = *key == rav::sdp::k_sdp_ptime;
+        const auto value = parser.read_until_end();
+        if (!value) {
+            return tl::unexpected(is_ptime ? "media: failed to parse ptime value" : "media: failed to parse maxptime value");
+        }
+        const auto ptime = decode_float(*value);
+        if (!ptime) {
+            return tl::unexpected("media: failed to parse ptime as double");
+        }
+        if (*ptime < 0) {
+            return tl::unexpected(is_ptime ? "media: ptime must be a positive number" : "media: maxptime must be a positive number");
+        }
+        (is_ptime ? media.ptime : media.max_ptime) = *ptime;
+        return {};
+    }
+
+    const auto handled = parse_common_attribute(media, *key, parser);
+    if (!handled) {
+        return tl::unexpected(handled.error());
+    }
+    if (*handled) {
+        return {};
+    }
+
+    if (*key == rav::sdp::k_sdp_clock_deviation) {
+        const auto num = parser.read_int<uint32_t>();
+        if (!num) {
+            return tl::unexpected("media: failed to parse clock-deviation value");
+        }
+        if (!parser.skip('/')) {
+            return tl::unexpected("media: expecting '/' after clock-deviation numerator value");
+        }
+        const auto denom = parser.read_int<uint32_t>();
+        if (!denom) {
+            return tl::unexpected("media: failed to parse clock-deviation denominator value");
+        }
+        media.ravenna_clock_deviation = rav::Fraction<uint32_t> {*num, *denom};
+        return {};
+    }
+
+    if (*key == "framecount") {
+        if (const auto value = parser.read_int<uint16_t>()) {
+            media.ravenna_framecount = *value;
+            return {};
+        }
+        return tl::unexpected("media: failed to parse framecount value");
+    }
+
+    if (*key == rav::sdp::k_sdp_mid) {
+        const auto mid = parser.read_until_end();
+        if (!mid) {
+            return tl::unexpected("media: failed to parse mid value");
+        }
+        if (mid->empty()) {
+            return tl::unexpected("media: mid value cannot be empty");
+        }
+        media.mid = *mid;
+        return {};
+    }
+
+    return add_unknown_attribute(media.attributes, *key, parser);
+}
+
+rav::sdp::OriginField rav::sdp::to_origin(const OriginView& view) {
+    OriginField origin;
+    origin.username = view.username;
+    origin.session_id = view.session_id;
+    origin.session_version = view.session_version;
+    origin.network_type = view.network_type;
+    origin.address_type = view.address_type;
+    origin.unicast_address = view.unicast_address.text;
+    return origin;
+}
+
+rav::sdp::ConnectionInfoField rav::sdp::to_connection_info(const ConnectionInfoView& view) {
+    return {view.network_type, view.address_type, std::string(view.address.text), view.ttl, view.number_of_addresses};
+}
+
+rav::sdp::Format rav::sdp::to_format(const FormatView& view) {
+    return {view.payload_type, std::string(view.encoding_name), view.clock_rate, view.num_channels};
+}
+
+rav::sdp::ReferenceClock rav::sdp::to_reference_clock(const ReferenceClockView& view) {
+    ReferenceClock ref_clock;
+    ref_clock.source_ = view.source;
+    ref_clock.ptp_version_ = view.ptp_version;
+    if (view.gmid.has_value()) {
+        ref_clock.gmid_ = std::string(*view.gmid);
+    }
+    ref_clock.domain_ = view.domain;
+    return ref_clock;
+}
+
+rav::sdp::SourceFilter rav::sdp::to_source_filter(const SourceFilterView& view) {
+    SourceFilter filter;
+    filter.mode = view.mode;
+    filter.net_type = view.net_type;
+    filter.addr_type = view.addr_type;
+    filter.dest_address = view.dest_address.text;
+    filter.src_list.reserve(view.src_list.size());
+    for (auto& src : view.src_list) {
+        filter.src_list.emplace_back(src.text);
+    }
+    return filter;
+}
+
+rav::sdp::Group rav::sdp::to_group(const GroupView& view) {
+    Group group;
+    group.type = view.type;
+    for (auto& tag : view.tags) {
+        group.tags.emplace_back(tag);
+    }
+    return group;
+}
+
+rav::sdp::MediaDescription rav::sdp::to_media_description(const MediaDescriptionView& view) {
+    MediaDescription media;
+    media.media_type = view.media_type;
+    media.port = view.port;
+    media.number_of_ports = view.number_of_ports;
+    media.protocol = view.protocol;
+    for (auto& format : view.formats) {
+        media.formats.push_back(to_format(format));
+    }
+    merge_attributes(view, media);
+    return media;
+}
+
+void rav::sdp::merge_attributes(const MediaDescriptionView& view, MediaDescription& media) {
+    for (auto& connection_info : view.connection_infos) {
+        media.connection_infos.push_back(to_connection_info(connection_info));
+    }
+    if (view.ptime.has_value()) {
+        media.ptime = view.ptime;
+    }
+    if (view.max_ptime.has_value()) {
+        media.max_ptime = view.max_ptime;
+    }
+    if (view.media_direction.has_value()) {
+        media.media_direction = view.media_direction;
+    }
+    if (view.reference_clock.has_value()) {
+        media.reference_clock = to_reference_clock(*view.reference_clock);
+    }
+    if (view.media_clock.has_value()) {
+        media.media_clock = view.media_clock;
+    }
+    if (view.session_information.has_value()) {
+        media.session_information = std::string(*view.session_information);
+    }
+    if (view.ravenna_clock_domain.has_value()) {
+        media.ravenna_clock_domain = view.ravenna_clock_domain;
+    }
+    if (view.ravenna_sync_time.has_value()) {
+        media.ravenna_sync_time = view.ravenna_sync_time;
+    }
+    if (view.ravenna_clock_deviation.has_value()) {
+        media.ravenna_clock_deviation = view.ravenna_clock_deviation;
+    }
+    for (auto& filter : view.source_filters) {
+        media.source_filters.push_back(to_source_filter(filter));
+    }
+    if (view.ravenna_framecount.has_value()) {
+        media.ravenna_framecount = view.ravenna_framecount;
+    }
+    if (view.mid.has_value()) {
+        media.mid = std::string(*view.mid);
+    }
+    add_attributes(media.attributes, view.attributes);
+}
+
+void rav::sdp::merge_attributes(const SessionDescriptionView& view, SessionDescription& session) {
+    if (view.media_direction.has_value()) {
+        session.media_direction = view.media_direction;
+    }
+    if (view.reference_clock.has_value()) {
+        session.reference_clock = to_reference_clock(*view.reference_clock);
+    }
+    if (view.media_clock.has_value()) {
+        session.media_clock = view.media_clock;
+    }
+    if (view.ravenna_clock_domain.has_value()) {
+        session.ravenna_clock_domain = view.ravenna_clock_domain;
+    }
+    if (view.ravenna_sync_time.has_value()) {
+        session.ravenna_sync_time = view.ravenna_sync_time;
+    }
+    for (auto& filter : view.source_filters) {
+        session.source_filters.push_back(to_source_filter(filter));
+    }
+    if (view.group.has_value()) {
+        session.group = to_group(*view.group);
+    }
+    add_attributes(session.attributes, view.attributes);
+}
+
+tl::expected<rav::sdp::SessionDescriptionView, std::string> rav::sdp::parse_session_description_view(const std::string_view sdp_text) {
+    SessionDescriptionView sd;
+    StringParser parser(sdp_text);
+
+    for (auto line = parser.read_line(); line.has_value(); line = parser.read_line()) {
+        if (line->empty()) {
+            continue;
+        }
+
+        switch (line->front()) {
+            case 'v': {
+                auto result = parse_version(*line);
+                if (!result) {
+                    return tl::unexpected(result.error());
+                }
+                sd.version = *result;
+                break;
+            }
+            case 'o': {
+                auto result = parse_origin_view(*line);
+                if (!result) {
+                    return tl::unexpected(result.error());
+                }
+                sd.origin = *result;
+                break;
+            }
+            case 's': {
+                sd.session_name = line->substr(2);
+                break;
+            }
+            case 'c': {
+                auto result = parse_connection_info_view(*line);
+                if (!result) {
+                    return tl::unexpected(result.error());
+                }
+                if (!sd.media_descriptions.empty()) {
+                    sd.media_descriptions.back().connection_infos.push_back(*result);
+                } else {
+                    sd.connection_info = *result;
+                }
+                break;
+            }
+            case 't': {
+                auto time_active = parse_time_active(*line);
+                if (!time_active) {
+                    return tl::unexpected(time_active.error());
+                }
+                sd.time_active = *time_active;
+                break;
+            }
+            case 'm': {
+                auto desc = parse_media_description_view(*line);
+                if (!desc) {
+                    return tl::unexpected(desc.error());
+                }
+                sd.media_descriptions.push_back(std::move(*desc));
+                break;
+            }
+            case 'a': {
+                auto result = sd.media_descriptions.empty() ? parse_attribute(sd, *line)
+                                                            : parse_attribute(sd.media_descriptions.back(), *line);
+                if (!result) {
+                    return tl::unexpected(result.error());
+                }
+                break;
+            }
+            case 'i': {
+                if (!sd.media_descriptions.empty()) {
+                    sd.media_descriptions.back().session_information = line->substr(2);
+                } else {
+                    sd.session_information = line->substr(2);
+                }
+                break;
+            }
+            default:
+                return tl::unexpected(fmt::format("Unknown line: {}", *line));
+        }
+    }
+
+    return sd;
+}
+
+rav::sdp::SessionDescription rav::sdp::to_session_description(const SessionDescriptionView& view) {
+    SessionDescription sd;
+    sd.version = view.version;
+    sd.origin = to_origin(view.origin);
+    sd.session_name = view.session_name;
+    if (view.connection_info.has_value()) {
+        sd.connection_info = to_connection_info(*view.connection_info);
+    }
+    sd.time_active = view.time_active;
+    if (view.session_information.has_value()) {
+        sd.session_information = std::string(*view.session_information);
+    }
+    merge_attributes(view, sd);
+    for (auto& media : view.media_descriptions) {
+        sd.media_descriptions.push_back(to_media_description(media));
+    }
+    return sd;
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_playout.hpp"
+#include "ravennakit/core/streams/file_output_stream.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+/**
+ * Writes a mono 16-bit file in which every sample holds its frame index.
+ */
+void write_test_file(const std::filesystem::path& path, const uint16_t num_frames) {
+    rav::FileOutputStream stream(path);
+    rav::WavAudioFormat::Writer writer(stream, rav::WavAudioFormat::FormatCode::pcm, 48000, 1, 16);
+    for (uint16_t i = 0; i < num_frames; ++i) {
+        const std::array<uint8_t, 2> sample {static_cast<uint8_t>(i & 0xff), static_cast<uint8_t>(i >> 8)};
+        REQUIRE(writer.write_audio_data(sample.data(), sample.size()));
+    }
+    REQUIRE(writer.finalize());
+}
+
+/**
+ * Runs the playout until given time and returns the frames it handed out, with silence as -1.
+ */
+std::vector<int> play(rav::AudioPlayout& playout, const uint32_t now, uint32_t& expected_ts) {
+    std::vector<int> frames;
+    std::ignore = playout.process(now, [&](const rav::BufferView<const uint8_t> data, const uint32_t timestamp) {
+        REQUIRE(timestamp == expected_ts);
+        expected_ts += static_cast<uint32_t>(data.size() / 2);
+        for (size_t i = 0; i < data.size(); i += 2) {
+            frames.push_back(data[i] | data[i + 1] << 8);
+        }
+    });
+    return frames;
+}
+
+}  // namespace
+
+TEST_CASE("rav::AudioPlayout") {
+    const auto directory = std::filesystem::temp_directory_path() / "ravennakit_audio_playout_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "test.wav";
+    write_test_file(path, 10);
+
+    rav::AudioPlayoutOptions options;
+    options.max_frames_per_piece = 4;
+    options.max_drift_frames = 100;
+
+    auto playout = rav::AudioPlayout::create(path, options);
+    REQUIRE(playout != nullptr);
+    REQUIRE(playout->get_num_frames() == 10);
+    REQUIRE(playout->get_audio_format().num_channels == 1);
+    REQUIRE(playout->get_audio_format().encoding == rav::AudioEncoding::pcm_s16);
+    REQUIRE(playout->get_cues().size() == 1);
+
+    uint32_t ts = 1000;
+
+    SECTION("Silence until started") {
+        REQUIRE(play(*playout, 1000, ts) == std::vector<int> {0, 0, 0, 0});
+        REQUIRE(play(*playout, 1003, ts).empty());
+        REQUIRE_FALSE(playout->is_playing());
+    }
+
+    SECTION("Play the file once") {
+        playout->start(1002);
+        REQUIRE(play(*playout, 1000, ts) == std::vector<int> {0, 0, 0, 1});
+        REQUIRE(play(*playout, 1011, ts) == std::vector<int> {2, 3, 4, 5, 6, 7, 8, 9});
+        REQUIRE(playout->is_playing());
+        REQUIRE(play(*playout, 1012, ts) == std::vector<int> {0, 0, 0, 0});
+        REQUIRE_FALSE(playout->is_playing());
+        REQUIRE(playout->get_position() == 10);
+    }
+
+    SECTION("Loop cues without gaps") {
+        playout->set_cues({{2, 4}, {7, 100}});
+        REQUIRE(playout->get_cues().size() == 2);
+        REQUIRE(playout->get_cues()[1].end_frame == 10);
+
+        playout->set_looping(true);
+        playout->start(1000);
+        REQUIRE(play(*playout, 1000, ts) == std::vector<int> {2, 3, 7, 8});
+        REQUIRE(play(*playout, 1011, ts) == std::vector<int> {9, 2, 3, 7, 8, 9, 2, 3});
+        REQUIRE(playout->get_position() == 12);
+
+        playout->stop();
+        REQUIRE(play(*playout, 1012, ts) == std::vector<int> {0, 0, 0, 0});
+    }
+
+    SECTION("Jump when the clock drifts away") {
+        playout->set_looping(true);
+        playout->start(1000);
+        REQUIRE(play(*playout, 1000, ts) == std::vector<int> {0, 1, 2, 3});
+
+        ts = 1204;
+        REQUIRE(play(*playout, 1204, ts) == std::vector<int> {4, 5, 6, 7});  // (4 + 200) % 10
+        REQUIRE(playout->get_position() == 208);
+    }
+
+    SECTION("Cues outside the file") {
+        playout->set_cues({{10, 20}});
+        REQUIRE(playout->get_cues().empty());
+        playout->start(1000);
+        REQUIRE(play(*playout, 1000, ts) == std::vector<int> {0, 0, 0, 0});
+        REQUIRE_FALSE(playout->is_playing());
+    }
+
+    SECTION("Invalid file") {
+        REQUIRE(rav::AudioPlayout::create(directory / "nonexistent.wav") == nullptr);
+    }
+
+    playout.reset();
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_recorder.hpp"
+#include "ravennakit/core/streams/file_input_stream.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+rav::AudioFormat make_audio_format() {
+    return {
+        rav::AudioFormat::ByteOrder::be, rav::AudioEncoding::pcm_s24, rav::AudioFormat::ChannelOrdering::interleaved, 48000, 2
+    };
+}
+
+}  // namespace
+
+TEST_CASE("rav::AudioRecorder") {
+    const auto directory = std::filesystem::temp_directory_path() / "ravennakit_audio_recorder_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    const rav::Id id(1);
+    rav::AudioRecorder::TrackOptions track_options;
+    track_options.file = directory / "track.wav";
+    track_options.format = make_audio_format();
+
+    SECTION("Record a track") {
+        rav::AudioRecorderOptions options;
+        options.write_block_size = 600;
+        options.idle_interval = std::chrono::milliseconds(1);
+        options.file_options.preallocation_size = 0;
+
+        track_options.bext.emplace();
+        track_options.bext->originator = "ravennakit";
+
+        // Big endian samples, which are written as little endian.
+        std::vector<uint8_t> data(48 * 6 * 10);
+        for (size_t i = 0; i < data.size(); i += 3) {
+            data[i] = static_cast<uint8_t>(i / 3);
+            data[i + 1] = 0x22;
+            data[i + 2] = 0x33;
+        }
+
+        // One day and one hour, in samples
+        constexpr uint64_t timestamp = 48000ull * (24 + 1) * 60 * 60;
+
+        rav::AudioRecorder recorder(options);
+        REQUIRE(recorder.add_track(id, track_options));
+        for (size_t i = 0; i < data.size(); i += 48 * 6) {
+            REQUIRE(recorder.write_realtime(id, data.data() + i, 48 * 6, timestamp + i / 6));
+        }
+        REQUIRE(recorder.remove_track(id));
+        REQUIRE_FALSE(recorder.write_realtime(id, data.data(), 6));
+
+        rav::WavAudioFormat::Reader reader(std::make_unique<rav::FileInputStream>(track_options.file));
+        const auto format = reader.get_audio_format();
+        REQUIRE(format.has_value());
+        REQUIRE(format->encoding == rav::AudioEncoding::pcm_s24);
+        REQUIRE(format->byte_order == rav::AudioFormat::ByteOrder::le);
+        REQUIRE(format->sample_rate == 48000);
+        REQUIRE(format->num_channels == 2);
+        REQUIRE(reader.get_bext_chunk().has_value());
+        REQUIRE(reader.get_bext_chunk()->originator == "ravennakit");
+        REQUIRE(reader.get_bext_chunk()->time_reference == 48000ull * 60 * 60);
+
+        std::vector<uint8_t> read_data(reader.remaining_audio_data());
+        REQUIRE(read_data.size() == data.size());
+        REQUIRE(reader.read_audio_data(read_data.data(), read_data.size()) == read_data.size());
+        rav::swap_bytes(data.data(), data.size(), 3);
+        REQUIRE(read_data == data);
+    }
+
+    SECTION("Stats") {
+        rav::AudioRecorderOptions options;
+        options.write_block_size = 600;
+        options.fifo_duration = std::chrono::milliseconds(0);  // Two blocks
+
+        rav::AudioRecorder recorder(options);
+        REQUIRE_FALSE(recorder.get_track_stats(id).has_value());
+        REQUIRE(recorder.add_track(id, track_options));
+
+        const std::vector<uint8_t> data(1800);
+        REQUIRE_FALSE(recorder.write_realtime(id, data.data(), data.size()));
+        REQUIRE(recorder.write_realtime(id, data.data(), 600));
+
+        const auto stats = recorder.get_track_stats(id);
+        REQUIRE(stats.has_value());
+        REQUIRE(stats->frames_dropped == 300);
+        REQUIRE_FALSE(stats->failed);
+
+        REQUIRE(recorder.remove_track(id));
+        REQUIRE_FALSE(recorder.get_track_stats(id).has_value());
+        REQUIRE(std::filesystem::file_size(track_options.file) > 600);
+    }
+
+    SECTION("Invalid tracks") {
+        rav::AudioRecorder recorder;
+        REQUIRE_FALSE(recorder.add_track(rav::Id(), track_options));
+        REQUIRE(recorder.add_track(id, track_options));
+        REQUIRE_FALSE(recorder.add_track(id, track_options));
+
+        auto options = track_options;
+        options.format.encoding = rav::AudioEncoding::pcm_s8;
+        REQUIRE_FALSE(recorder.add_track(rav::Id(2), options));
+
+        options = track_options;
+        options.format.ordering = rav::AudioFormat::ChannelOrdering::noninterleaved;
+        REQUIRE_FALSE(recorder.add_track(rav::Id(2), options));
+
+        options = track_options;
+        options.file = directory / "does_not_exist" / "track.wav";
+        REQUIRE_FALSE(recorder.add_track(rav::Id(2), options));
+
+        REQUIRE_FALSE(recorder.remove_track(rav::Id(2)));
+    }
+
+    SECTION("Max number of tracks") {
+        rav::AudioRecorderOptions options;
+        options.file_options.preallocation_size = 0;
+        rav::AudioRecorder recorder(options);
+        for (size_t i = 1; i <= rav::AudioRecorder::k_max_num_tracks; ++i) {
+            track_options.file = directory / fmt::format("track_{}.wav", i);
+            REQUIRE(recorder.add_track(rav::Id(i), track_options));
+        }
+        track_options.file = directory / "track.wav";
+        REQUIRE_FALSE(recorder.add_track(rav::Id(rav::AudioRecorder::k_max_num_tracks + 1), track_options));
+    }
+
+    std::filesystem::remove_all(directory);
+}
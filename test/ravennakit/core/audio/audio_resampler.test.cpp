@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/audio/audio_resampler.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+
+namespace {
+
+constexpr double k_frequency = 1000.0 / 48000.0;  // Cycles per input frame
+
+double input_signal(const double frame, const size_t channel) {
+    return std::sin(2.0 * 3.14159265358979323846 * k_frequency * frame + static_cast<double>(channel));
+}
+
+/**
+ * Feeds a sine wave through the resampler in blocks of varying size, and returns the largest difference between the
+ * output and the input signal at the position the resampler should have interpolated at.
+ */
+double run_sine(rav::AudioResampler& resampler, const double ratio, const size_t num_output_frames, size_t& num_input_frames) {
+    resampler.set_ratio(ratio);
+    std::vector<std::vector<float>> output(resampler.num_channels(), std::vector<float>(num_output_frames));
+    std::vector<float*> output_channels;
+    for (auto& channel : output) {
+        output_channels.push_back(channel.data());
+    }
+
+    num_input_frames = 0;
+    size_t offset = 0;
+    size_t block = 1;
+    while (offset < num_output_frames) {
+        const auto n = std::min({block, num_output_frames - offset, resampler.max_num_output_frames()});
+        const auto needed = resampler.get_num_input_frames_needed(n);
+        auto* const* input = resampler.prepare_input(needed);
+        for (size_t ch = 0; ch < resampler.num_channels(); ++ch) {
+            for (size_t i = 0; i < needed; ++i) {
+                input[ch][i] = static_cast<float>(input_signal(static_cast<double>(num_input_frames + i), ch));
+            }
+        }
+        num_input_frames += needed;
+        resampler.process(output_channels.data(), offset, n);
+        offset += n;
+        block = block * 3 % 97 + 1;
+    }
+
+    // The first input frame comes out after half the filter length
+    double max_error = 0.0;
+    for (size_t ch = 0; ch < resampler.num_channels(); ++ch) {
+        for (size_t i = rav::AudioResampler::k_num_taps; i < num_output_frames; ++i) {
+            const auto position = static_cast<double>(i) * ratio - static_cast<double>(rav::AudioResampler::k_num_taps / 2);
+            max_error = std::max(max_error, std::abs(output[ch][i] - input_signal(position, ch)));
+        }
+    }
+    return max_error;
+}
+
+}  // namespace
+
+TEST_CASE("rav::AudioResampler") {
+    rav::AudioResampler resampler;
+    resampler.resize(2, 64, 1.01);
+
+    SECTION("Initial state") {
+        REQUIRE(resampler.num_channels() == 2);
+        REQUIRE(resampler.max_num_output_frames() == 64);
+        REQUIRE(resampler.get_ratio() == 1.0);
+        REQUIRE(resampler.get_num_input_frames_needed(0) == 0);
+        REQUIRE(resampler.get_num_input_frames_needed(1) == 1);
+        REQUIRE(resampler.get_num_input_frames_needed(64) == 64);
+        REQUIRE_THAT(resampler.get_num_buffered_frames(), Catch::Matchers::WithinAbs(rav::AudioResampler::k_num_taps - 1, 1e-9));
+    }
+
+    SECTION("Unity ratio") {
+        size_t num_input_frames {};
+        REQUIRE(run_sine(resampler, 1.0, 4800, num_input_frames) < 1e-3);
+        REQUIRE(num_input_frames == 4800);
+    }
+
+    SECTION("Faster input") {
+        size_t num_input_frames {};
+        REQUIRE(run_sine(resampler, 1.001, 48000, num_input_frames) < 1e-3);
+        REQUIRE_THAT(static_cast<double>(num_input_frames), Catch::Matchers::WithinAbs(48048, 1.0));
+    }
+
+    SECTION("Slower input") {
+        size_t num_input_frames {};
+        REQUIRE(run_sine(resampler, 0.9995, 48000, num_input_frames) < 1e-3);
+        REQUIRE_THAT(static_cast<double>(num_input_frames), Catch::Matchers::WithinAbs(47976, 1.0));
+    }
+
+    SECTION("Buffered frames follow the consumption") {
+        resampler.set_ratio(1.0);
+        std::vector<float> out(64);
+        std::array<float*, 2> channels {out.data(), out.data()};
+        std::ignore = resampler.prepare_input(resampler.get_num_input_frames_needed(10) + 5);
+        resampler.process(channels.data(), 0, 10);
+        REQUIRE_THAT(resampler.get_num_buffered_frames(), Catch::Matchers::WithinAbs(rav::AudioResampler::k_num_taps - 1 + 5, 1e-9));
+        REQUIRE(resampler.get_num_input_frames_needed(5) == 0);
+        REQUIRE(resampler.get_num_input_frames_needed(6) == 1);
+    }
+
+    SECTION("Reset") {
+        std::ignore = resampler.prepare_input(20);
+        resampler.reset();
+        REQUIRE_THAT(resampler.get_num_buffered_frames(), Catch::Matchers::WithinAbs(rav::AudioResampler::k_num_taps - 1, 1e-9));
+        REQUIRE(resampler.get_num_input_frames_needed(1) == 1);
+    }
+}
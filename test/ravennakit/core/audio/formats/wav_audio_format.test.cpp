@@ -27,8 +27,45 @@
 #include "wav_audio_format.data.cpp"
 #include "ravennakit/core/audio/formats/wav_audio_format.hpp"
 #include "ravennakit/core/streams/byte_stream.hpp"
+#include "ravennakit/core/streams/input_stream_view.hpp"
 #include "ravennakit/core/util.hpp"
 
+namespace {
+
+/**
+ * An output stream which only keeps the first bytes, for writing files which are too large to keep in memory.
+ */
+class HeaderOutputStream final: public rav::OutputStream {
+  public:
+    std::array<uint8_t, 1024> header {};
+    size_t size {};
+
+    tl::expected<void, Error> write(const uint8_t* buffer, const size_t num_bytes) override {
+        for (size_t i = position_; i < std::min(position_ + num_bytes, header.size()); ++i) {
+            header[i] = buffer[i - position_];
+        }
+        position_ += num_bytes;
+        size = std::max(size, position_);
+        return {};
+    }
+
+    tl::expected<void, Error> set_write_position(const size_t position) override {
+        position_ = position;
+        return {};
+    }
+
+    size_t get_write_position() override {
+        return position_;
+    }
+
+    void flush() override {}
+
+  private:
+    size_t position_ {};
+};
+
+}  // namespace
+
 TEST_CASE("rav::WavAudioFormat") {
     {
         REQUIRE(sin_1ms_wav.size() == 1808);
@@ -104,4 +141,98 @@ TEST_CASE("rav::WavAudioFormat") {
             )
         );
     }
+
+    SECTION("Write broadcast wave file") {
+        constexpr auto sin_1ms_wav_header_size = 44;
+        const auto sin_1ms_wav_audio_data_size = sin_1ms_wav.size() - sin_1ms_wav_header_size;
+
+        rav::WavAudioFormat::WriterOptions options;
+        options.rf64 = true;
+        options.bext.emplace();
+        options.bext->description = "Description";
+        options.bext->originator = "ravennakit";
+        options.bext->origination_date = "2025:01:31";
+        options.bext->origination_time = "12:34:56";
+        options.bext->coding_history = "A=PCM,F=44100,W=16,M=stereo";  // Odd length, requires padding
+
+        rav::ByteStream bytes;
+        {
+            rav::WavAudioFormat::Writer writer(bytes, rav::WavAudioFormat::FormatCode::pcm, 44100, 2, 16, options);
+            REQUIRE(writer.write_audio_data(sin_1ms_wav.data() + sin_1ms_wav_header_size, sin_1ms_wav_audio_data_size));
+            writer.set_time_reference(44100ull * 3600);
+        }
+
+        constexpr auto header_size = 44 + 36 + 8 + 602 + 28;
+        REQUIRE(bytes.size() == sin_1ms_wav_audio_data_size + header_size);
+
+        // Below 4 GB the file is a regular RIFF file, with space reserved for the ds64 chunk.
+        REQUIRE(bytes.read_as_string(4) == "RIFF");
+        REQUIRE(bytes.read_le<uint32_t>().value() == sin_1ms_wav_audio_data_size + header_size - 8);
+        REQUIRE(bytes.read_as_string(4) == "WAVE");
+        REQUIRE(bytes.read_as_string(4) == "JUNK");
+        REQUIRE(bytes.read_le<uint32_t>().value() == 28);
+
+        std::vector<uint8_t> file(bytes.size().value());
+        REQUIRE(bytes.set_read_position(0));
+        REQUIRE(bytes.read(file.data(), file.size()) == file.size());
+
+        rav::WavAudioFormat::Reader reader(std::make_unique<rav::ByteStream>(file));
+        REQUIRE(reader.num_channels() == 2);
+        REQUIRE(reader.remaining_audio_data() == sin_1ms_wav_audio_data_size);
+
+        const auto& bext = reader.get_bext_chunk();
+        REQUIRE(bext.has_value());
+        REQUIRE(bext->description == "Description");
+        REQUIRE(bext->originator == "ravennakit");
+        REQUIRE(bext->originator_reference.empty());
+        REQUIRE(bext->origination_date == "2025:01:31");
+        REQUIRE(bext->origination_time == "12:34:56");
+        REQUIRE(bext->time_reference == 44100ull * 3600);
+        REQUIRE(bext->version == 2);
+        REQUIRE(bext->loudness_value == 0x7fff);
+        REQUIRE(bext->coding_history == "A=PCM,F=44100,W=16,M=stereo");
+
+        std::vector<uint8_t> read_audio_data(sin_1ms_wav_audio_data_size, 0);
+        REQUIRE(reader.read_audio_data(read_audio_data.data(), read_audio_data.size()) == read_audio_data.size());
+        REQUIRE(std::equal(sin_1ms_wav.begin() + sin_1ms_wav_header_size, sin_1ms_wav.end(), read_audio_data.begin()));
+    }
+
+    SECTION("Write RF64 file beyond 4 GB") {
+        rav::WavAudioFormat::WriterOptions options;
+        options.rf64 = true;
+
+        constexpr size_t block_size = 1024 * 1024;
+        constexpr size_t num_blocks = 4608;  // 4.5 GB
+        const std::vector<uint8_t> block(block_size);
+
+        HeaderOutputStream stream;
+        {
+            rav::WavAudioFormat::Writer writer(stream, rav::WavAudioFormat::FormatCode::pcm, 48000, 2, 24, options);
+            bool success = true;
+            for (size_t i = 0; i < num_blocks; ++i) {
+                success &= writer.write_audio_data(block.data(), block.size()).has_value();
+            }
+            REQUIRE(success);
+            REQUIRE(writer.get_audio_data_written() == block_size * num_blocks);
+        }
+
+        constexpr auto header_size = 44 + 36;
+        constexpr auto data_size = uint64_t {block_size} * num_blocks;
+        REQUIRE(stream.size == data_size + header_size);
+
+        rav::InputStreamView header(stream.header.data(), stream.header.size());
+        REQUIRE(header.read_as_string(4) == "RF64");
+        REQUIRE(header.read_le<uint32_t>().value() == 0xffffffff);
+        REQUIRE(header.read_as_string(4) == "WAVE");
+        REQUIRE(header.read_as_string(4) == "ds64");
+        REQUIRE(header.read_le<uint32_t>().value() == 28);
+        REQUIRE(header.read_le<uint64_t>().value() == data_size + header_size - 8);  // RIFF size
+        REQUIRE(header.read_le<uint64_t>().value() == data_size);                    // Data size
+        REQUIRE(header.read_le<uint64_t>().value() == data_size / 6);                // Sample count
+        REQUIRE(header.read_le<uint32_t>().value() == 0);                            // Table length
+        REQUIRE(header.read_as_string(4) == "fmt ");
+        REQUIRE(header.skip(20));
+        REQUIRE(header.read_as_string(4) == "data");
+        REQUIRE(header.read_le<uint32_t>().value() == 0xffffffff);
+    }
 }
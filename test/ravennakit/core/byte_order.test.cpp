@@ -135,6 +135,62 @@ TEST_CASE("rav::ByteOrder") {
         REQUIRE(data == std::array<uint64_t, 3> {0x0100000000000000, 0x0200000000000000});
     }
 
+    SECTION("Out of place") {
+        constexpr std::array<uint8_t, 6> src = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc};
+        std::array<uint8_t, 6> dst {};
+
+        rav::swap_bytes(src.data(), dst.data(), src.size(), 3);
+        REQUIRE(dst == std::array<uint8_t, 6> {0x56, 0x34, 0x12, 0xbc, 0x9a, 0x78});
+
+        rav::swap_bytes(src.data(), dst.data(), src.size(), 2);
+        REQUIRE(dst == std::array<uint8_t, 6> {0x34, 0x12, 0x78, 0x56, 0xbc, 0x9a});
+
+        rav::swap_bytes(src.data(), dst.data(), src.size(), 1);
+        REQUIRE(dst == src);
+    }
+
+    SECTION("Kernels") {
+        const auto& supported = rav::get_supported_byte_swap_kernels();
+        REQUIRE(std::string(supported.front().name) == "scalar");
+        REQUIRE(std::string(rav::get_byte_swap_kernels().name) == supported.back().name);
+
+        // Covers the vector blocks, the scalar tails and unaligned buffers.
+        std::vector<uint8_t> src(1300);
+        for (size_t i = 0; i < src.size(); ++i) {
+            src[i] = static_cast<uint8_t>(i * 7 + i / 256);
+        }
+
+        for (const auto& kernels : supported) {
+            INFO(kernels.name);
+            for (const int bytes_per_sample : {2, 3, 4}) {
+                const auto stride = static_cast<size_t>(bytes_per_sample);
+                const auto swap = stride == 2 ? kernels.swap_16 : stride == 3 ? kernels.swap_24 : kernels.swap_32;
+                for (size_t offset = 0; offset < 3; ++offset) {
+                    for (const int num_samples : {0, 1, 5, 7, 8, 11, 16, 17, 33, 100, 300}) {
+                        const auto size = static_cast<size_t>(num_samples) * stride;
+
+                        std::vector<uint8_t> expected(size);
+                        for (size_t i = 0; i < size; i += stride) {
+                            for (size_t j = 0; j < stride; ++j) {
+                                expected[i + j] = src[offset + i + stride - j - 1];
+                            }
+                        }
+
+                        std::vector<uint8_t> dst(size + 1, 0xee);
+                        swap(src.data() + offset, dst.data(), size);
+                        REQUIRE(std::equal(expected.begin(), expected.end(), dst.begin()));
+                        REQUIRE(dst.back() == 0xee);
+
+                        std::vector<uint8_t> in_place(src.begin(), src.begin() + static_cast<std::ptrdiff_t>(offset + size + 1));
+                        swap(in_place.data() + offset, in_place.data() + offset, size);
+                        REQUIRE(std::equal(expected.begin(), expected.end(), in_place.begin() + static_cast<std::ptrdiff_t>(offset)));
+                        REQUIRE(in_place.back() == src[offset + size]);
+                    }
+                }
+            }
+        }
+    }
+
     constexpr uint8_t u16be[] = {0x12, 0x34};
     constexpr uint8_t u16le[] = {0x34, 0x12};
 
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/metrics/cost_meter.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+TEST_CASE("rav::metrics::CostMeter") {
+    rav::metrics::CostMeter meter;
+
+    SECTION("Initially empty") {
+        const auto snapshot = meter.get_snapshot();
+        REQUIRE(snapshot.count == 0);
+        REQUIRE(snapshot.total_ns == 0);
+        REQUIRE(snapshot.max_ns == 0);
+        REQUIRE(snapshot.mean_us() == 0.0);
+    }
+
+    SECTION("Durations are accumulated") {
+        for (int i = 0; i < 98; ++i) {
+            meter.add(1'500);
+        }
+        meter.add(40'000);
+        meter.add(3'000'000);
+
+        const auto snapshot = meter.get_snapshot();
+        REQUIRE(snapshot.count == 100);
+        REQUIRE(snapshot.total_ns == 98 * 1'500 + 40'000 + 3'000'000);
+        REQUIRE(snapshot.max_ns == 3'000'000);
+        REQUIRE_THAT(snapshot.mean_us(), Catch::Matchers::WithinAbs(31.87, 1e-9));
+        REQUIRE(snapshot.p50_us > 1.0);
+        REQUIRE(snapshot.p50_us <= 2.0);
+        REQUIRE(snapshot.p99_us > 20.0);
+        REQUIRE(snapshot.p99_us <= 50.0);
+        REQUIRE(snapshot.p999_us > 2'000.0);
+        REQUIRE(snapshot.p999_us <= 5'000.0);
+        REQUIRE(meter.get_histogram().get_snapshot().count() == 100);
+    }
+
+    SECTION("A scope adds the time it was alive") {
+        {
+            const rav::metrics::CostMeter::Scope scope(meter);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const auto snapshot = meter.get_snapshot();
+        REQUIRE(snapshot.count == 1);
+        REQUIRE(snapshot.total_ns >= 1'000'000);
+        REQUIRE(snapshot.max_ns == snapshot.total_ns);
+    }
+
+    SECTION("Reset") {
+        meter.add(1'000);
+        meter.reset();
+        const auto snapshot = meter.get_snapshot();
+        REQUIRE(snapshot.count == 0);
+        REQUIRE(snapshot.total_ns == 0);
+        REQUIRE(snapshot.max_ns == 0);
+    }
+}
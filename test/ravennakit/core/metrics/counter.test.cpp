@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/metrics/counter.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+TEST_CASE("rav::metrics::Counter") {
+    rav::metrics::Counter counter;
+    REQUIRE(counter.get() == 0);
+
+    SECTION("Increment") {
+        counter.increment();
+        counter.increment(10);
+        REQUIRE(counter.get() == 11);
+    }
+
+    SECTION("Reset") {
+        counter.increment(5);
+        counter.reset();
+        REQUIRE(counter.get() == 0);
+    }
+
+    SECTION("Read from another thread while writing") {
+        static constexpr uint64_t k_num_increments = 100'000;
+        std::thread writer([&counter] {
+            for (uint64_t i = 0; i < k_num_increments; ++i) {
+                counter.increment();
+            }
+        });
+        uint64_t previous = 0;
+        while (previous < k_num_increments) {
+            const auto value = counter.get();
+            REQUIRE(value >= previous);
+            previous = value;
+        }
+        writer.join();
+        REQUIRE(counter.get() == k_num_increments);
+    }
+}
+
+TEST_CASE("rav::metrics::Gauge") {
+    rav::metrics::Gauge gauge;
+    REQUIRE(gauge.get() == 0.0);
+    gauge.set(-1.5);
+    REQUIRE(gauge.get() == -1.5);
+    gauge.reset();
+    REQUIRE(gauge.get() == 0.0);
+}
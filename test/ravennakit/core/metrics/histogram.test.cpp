@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/metrics/histogram.hpp"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("rav::metrics::Histogram") {
+    rav::metrics::Histogram<3> histogram({1.0, 2.0, 4.0});
+
+    SECTION("Initially empty") {
+        const auto snapshot = histogram.get_snapshot();
+        REQUIRE(snapshot.count() == 0);
+        REQUIRE(snapshot.sum == 0.0);
+        REQUIRE(snapshot.upper_bounds == std::array {1.0, 2.0, 4.0});
+    }
+
+    SECTION("Values are counted in the right bucket") {
+        histogram.observe(0.5);
+        histogram.observe(1.0);
+        histogram.observe(1.5);
+        histogram.observe(4.0);
+        histogram.observe(10.0);
+
+        const auto snapshot = histogram.get_snapshot();
+        REQUIRE(snapshot.buckets[0] == 2);
+        REQUIRE(snapshot.buckets[1] == 1);
+        REQUIRE(snapshot.buckets[2] == 1);
+        REQUIRE(snapshot.buckets[3] == 1);
+        REQUIRE(snapshot.count() == 5);
+        REQUIRE(snapshot.sum == 17.0);
+    }
+
+    SECTION("Quantiles are interpolated within a bucket") {
+        REQUIRE(histogram.get_snapshot().quantile(0.5) == 0.0);
+
+        for (int i = 0; i < 50; ++i) {
+            histogram.observe(0.5);
+        }
+        for (int i = 0; i < 40; ++i) {
+            histogram.observe(3.0);
+        }
+        for (int i = 0; i < 10; ++i) {
+            histogram.observe(10.0);
+        }
+
+        const auto snapshot = histogram.get_snapshot();
+        REQUIRE_THAT(snapshot.quantile(0.25), Catch::Matchers::WithinAbs(0.5, 1e-9));
+        REQUIRE_THAT(snapshot.quantile(0.5), Catch::Matchers::WithinAbs(1.0, 1e-9));
+        REQUIRE_THAT(snapshot.quantile(0.7), Catch::Matchers::WithinAbs(3.0, 1e-9));
+        REQUIRE(snapshot.quantile(0.99) == 4.0);  // In the overflow bucket
+    }
+
+    SECTION("Reset") {
+        histogram.observe(1.0);
+        histogram.observe(5.0);
+        histogram.reset();
+        const auto snapshot = histogram.get_snapshot();
+        REQUIRE(snapshot.count() == 0);
+        REQUIRE(snapshot.sum == 0.0);
+    }
+}
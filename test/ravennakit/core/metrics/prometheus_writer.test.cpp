@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/metrics/prometheus_writer.hpp"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("rav::metrics::PrometheusWriter") {
+    rav::metrics::PrometheusWriter writer;
+
+    SECTION("Empty") {
+        REQUIRE(writer.to_string().empty());
+    }
+
+    SECTION("Counters of the same family are grouped") {
+        writer.add_counter("packets_total", "Number of packets", {{"stream", "1"}}, 10);
+        writer.add_gauge("level", "Some level", {}, 0.5);
+        writer.add_counter("packets_total", "Number of packets", {{"stream", "2"}}, 20);
+        REQUIRE(
+            writer.to_string()
+            == "# HELP packets_total Number of packets\n"
+               "# TYPE packets_total counter\n"
+               "packets_total{stream=\"1\"} 10\n"
+               "packets_total{stream=\"2\"} 20\n"
+               "# HELP level Some level\n"
+               "# TYPE level gauge\n"
+               "level 0.5\n"
+        );
+    }
+
+    SECTION("Label values are escaped") {
+        writer.add_counter("c_total", "Help", {{"name", "a\"b\\c\nd"}}, 1);
+        REQUIRE(writer.to_string().find(R"(c_total{name="a\"b\\c\nd"} 1)") != std::string::npos);
+    }
+
+    SECTION("Histogram buckets are cumulative") {
+        rav::metrics::Histogram<2> histogram({1.0, 2.0});
+        histogram.observe(0.5);
+        histogram.observe(1.5);
+        histogram.observe(3.0);
+        writer.add_histogram("latency", "Latency", {{"stream", "1"}}, histogram);
+        REQUIRE(
+            writer.to_string()
+            == "# HELP latency Latency\n"
+               "# TYPE latency histogram\n"
+               "latency_bucket{stream=\"1\",le=\"1\"} 1\n"
+               "latency_bucket{stream=\"1\",le=\"2\"} 2\n"
+               "latency_bucket{stream=\"1\",le=\"+Inf\"} 3\n"
+               "latency_sum{stream=\"1\"} 5\n"
+               "latency_count{stream=\"1\"} 3\n"
+        );
+    }
+}
@@ -79,7 +79,6 @@ TEST_CASE("rav::HttpServer") {
             }
         );
 
-        // The order of the handlers matters. The catch-all handler should be last.
         server.get(
             "**",
             [](const rav::HttpServer::Request&, rav::HttpServer::Response& response, rav::PathMatcher::Parameters&) {
@@ -89,6 +88,16 @@ TEST_CASE("rav::HttpServer") {
             }
         );
 
+        // The catch-all handler is only used when no other handler matches, even for handlers which are added after it.
+        server.get(
+            "/late",
+            [](const rav::HttpServer::Request&, rav::HttpServer::Response& response, rav::PathMatcher::Parameters&) {
+                response.result(boost::beast::http::status::ok);
+                response.body() = "/late";
+                response.prepare_payload();
+            }
+        );
+
         rav::HttpClient client(io_context, endpoint);
         client.get_async("/", [](auto response) {
             REQUIRE(response.has_value());
@@ -102,6 +111,12 @@ TEST_CASE("rav::HttpServer") {
             REQUIRE(response->body() == "/test");
         });
 
+        client.get_async("/late", [](auto response) {
+            REQUIRE(response.has_value());
+            REQUIRE(response->result() == boost::beast::http::status::ok);
+            REQUIRE(response->body() == "/late");
+        });
+
         client.get_async("/some/deep/path", [](auto response) {
             REQUIRE(response.has_value());
             REQUIRE(response->result() == boost::beast::http::status::ok);
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/realtime_log.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+namespace {
+
+struct Capture {
+    std::mutex mutex;
+    std::vector<std::pair<rav::RealtimeLogger::Level, std::string>> messages;
+
+    rav::RealtimeLogger::Sink get_sink() {
+        return [this](const rav::RealtimeLogger::Level level, const std::string& message) {
+            std::lock_guard lock(mutex);
+            messages.emplace_back(level, message);
+        };
+    }
+};
+
+}  // namespace
+
+TEST_CASE("rav::RealtimeLogger") {
+    rav::RealtimeLogger logger;
+    Capture capture;
+    logger.set_sink(capture.get_sink());
+    logger.set_rate_limit_interval(std::chrono::milliseconds(0));
+
+    SECTION("Arithmetic arguments are formatted on the background thread") {
+        rav::RealtimeLogger::CallSite call_site;
+        logger.log(call_site, rav::RealtimeLogger::Level::error, "Value {} and {:.1f}", 42, 1.25);
+        logger.flush();
+        REQUIRE(capture.messages.size() == 1);
+        REQUIRE(capture.messages[0].first == rav::RealtimeLogger::Level::error);
+        REQUIRE(capture.messages[0].second == "Value 42 and 1.2");
+    }
+
+    SECTION("Other arguments are formatted when logging") {
+        rav::RealtimeLogger::CallSite call_site;
+        std::string str = "string";
+        logger.log(call_site, rav::RealtimeLogger::Level::info, "A {} and {}", str, 1);
+        str = "changed";
+        logger.flush();
+        REQUIRE(capture.messages.size() == 1);
+        REQUIRE(capture.messages[0].second == "A string and 1");
+    }
+
+    SECTION("Long messages are truncated") {
+        rav::RealtimeLogger::CallSite call_site;
+        const std::string str(rav::RealtimeLogger::k_max_message_size * 2, 'a');
+        logger.log(call_site, rav::RealtimeLogger::Level::info, "{}", str);
+        logger.flush();
+        REQUIRE(capture.messages.size() == 1);
+        REQUIRE(capture.messages[0].second.size() == rav::RealtimeLogger::k_max_message_size);
+    }
+
+    SECTION("Repeated messages are rate limited") {
+        logger.set_rate_limit_interval(std::chrono::hours(1));
+        rav::RealtimeLogger::CallSite call_site;
+        for (int i = 0; i < 10; ++i) {
+            logger.log(call_site, rav::RealtimeLogger::Level::warning, "Message {}", i);
+        }
+        logger.flush();
+        REQUIRE(capture.messages.size() == 1);
+        REQUIRE(capture.messages[0].second == "Message 0");
+
+        call_site.last_message_ns = 0;  // Pretend the interval has passed
+        logger.log(call_site, rav::RealtimeLogger::Level::warning, "Message {}", 10);
+        logger.flush();
+        REQUIRE(capture.messages.size() == 2);
+        REQUIRE(capture.messages[1].second == "Message 10 (suppressed 9 similar messages)");
+    }
+
+    SECTION("Messages are dropped and counted when the queue is full") {
+        rav::RealtimeLogger::CallSite call_site;
+        // The background thread might consume some messages, so push enough to overflow regardless.
+        for (size_t i = 0; i < rav::RealtimeLogger::k_queue_capacity * 100; ++i) {
+            logger.log(call_site, rav::RealtimeLogger::Level::trace, "Message {}", i);
+            if (logger.get_num_dropped() > 0) {
+                break;
+            }
+        }
+        REQUIRE(logger.get_num_dropped() > 0);
+    }
+
+    SECTION("Log from multiple threads") {
+        static constexpr size_t k_num_threads = 4;
+        static constexpr size_t k_num_messages = 200;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < k_num_threads; ++t) {
+            threads.emplace_back([&logger] {
+                rav::RealtimeLogger::CallSite call_site;
+                for (size_t i = 0; i < k_num_messages; ++i) {
+                    logger.log(call_site, rav::RealtimeLogger::Level::info, "Message {}", i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        logger.flush();
+        std::lock_guard lock(capture.mutex);
+        REQUIRE(capture.messages.size() + logger.get_num_dropped() == k_num_threads * k_num_messages);
+    }
+}
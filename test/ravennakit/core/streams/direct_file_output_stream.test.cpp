@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/platform.hpp"
+#include "ravennakit/core/streams/direct_file_output_stream.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <fstream>
+
+#if RAV_POSIX
+
+namespace {
+
+std::vector<uint8_t> read_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator(file), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+TEST_CASE("rav::DirectFileOutputStream") {
+    const auto directory = std::filesystem::temp_directory_path() / "ravennakit_direct_file_output_stream_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "test.bin";
+
+    std::vector<uint8_t> data(100'000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    rav::DirectFileOutputStreamOptions options;
+    options.direct_io = true;
+    options.preallocation_size = 64 * 1024;
+    options.buffer_size = 3 * rav::DirectFileOutputStream::k_alignment;
+
+    SECTION("Write in odd sized chunks") {
+        {
+            const auto stream = rav::DirectFileOutputStream::create(path, options);
+            REQUIRE(stream != nullptr);
+            for (size_t i = 0; i < data.size(); i += 999) {
+                REQUIRE(stream->write(data.data() + i, std::min<size_t>(999, data.size() - i)));
+            }
+            REQUIRE(stream->get_write_position() == data.size());
+        }
+        REQUIRE(read_file(path) == data);
+    }
+
+    SECTION("Rewrite the beginning of the file") {
+        {
+            const auto stream = rav::DirectFileOutputStream::create(path, options);
+            REQUIRE(stream != nullptr);
+            REQUIRE(stream->write(data.data(), 50'001));
+            REQUIRE(stream->set_write_position(10));
+            REQUIRE(stream->write_le<uint32_t>(0x44332211));
+            REQUIRE(stream->get_write_position() == 14);
+            REQUIRE(stream->set_write_position(50'001));
+            REQUIRE(stream->write(data.data() + 50'001, data.size() - 50'001));
+        }
+        auto expected = data;
+        expected[10] = 0x11;
+        expected[11] = 0x22;
+        expected[12] = 0x33;
+        expected[13] = 0x44;
+        REQUIRE(read_file(path) == expected);
+    }
+
+    SECTION("Flush in between writes") {
+        const auto stream = rav::DirectFileOutputStream::create(path, options);
+        REQUIRE(stream != nullptr);
+        REQUIRE(stream->write(data.data(), 5'000));
+        stream->flush();
+        REQUIRE(read_file(path) == std::vector(data.begin(), data.begin() + 5'000));
+        REQUIRE(stream->write(data.data() + 5'000, data.size() - 5'000));
+        stream->flush();
+        REQUIRE(read_file(path) == data);
+        REQUIRE(stream->get_write_position() == data.size());
+    }
+
+    SECTION("Without direct io") {
+        options.direct_io = false;
+        options.preallocation_size = 0;
+        {
+            const auto stream = rav::DirectFileOutputStream::create(path, options);
+            REQUIRE(stream != nullptr);
+            REQUIRE_FALSE(stream->is_direct_io());
+            REQUIRE(stream->write(data.data(), data.size()));
+        }
+        REQUIRE(read_file(path) == data);
+    }
+
+    SECTION("Fails for an invalid path") {
+        REQUIRE(rav::DirectFileOutputStream::create(directory / "does_not_exist" / "test.bin", options) == nullptr);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+#endif
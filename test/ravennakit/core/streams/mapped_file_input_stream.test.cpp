@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/streams/mapped_file_input_stream.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <fstream>
+
+TEST_CASE("rav::MappedFileInputStream") {
+    const auto directory = std::filesystem::temp_directory_path() / "ravennakit_mapped_file_input_stream_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "test.bin";
+
+    SECTION("Read a file") {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "0123456789";
+        }
+
+        auto stream = rav::MappedFileInputStream::create(path);
+        REQUIRE(stream != nullptr);
+        REQUIRE(stream->size() == 10u);
+        REQUIRE(stream->data() != nullptr);
+        REQUIRE(std::string(reinterpret_cast<const char*>(stream->data()), 10) == "0123456789");
+
+        REQUIRE(stream->read_as_string(4) == "0123");
+        REQUIRE(stream->get_read_position() == 4);
+
+        std::array<uint8_t, 8> buffer {};
+        REQUIRE(stream->read(buffer.data(), buffer.size()) == 6u);
+        REQUIRE(stream->exhausted());
+        REQUIRE(stream->read(buffer.data(), buffer.size()) == 0u);
+
+        REQUIRE(stream->set_read_position(8));
+        REQUIRE(stream->read_as_string(2) == "89");
+        REQUIRE_FALSE(stream->set_read_position(11));
+    }
+
+    SECTION("Empty file") {
+        std::ofstream(path, std::ios::binary).close();
+
+        auto stream = rav::MappedFileInputStream::create(path);
+        REQUIRE(stream != nullptr);
+        REQUIRE(stream->size() == 0u);
+        REQUIRE(stream->data() == nullptr);
+        REQUIRE(stream->exhausted());
+    }
+
+    SECTION("File which doesn't exist") {
+        REQUIRE(rav::MappedFileInputStream::create(directory / "nonexistent.bin") == nullptr);
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/memory_arena.hpp"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("rav::MemoryArena") {
+    SECTION("Invalid options") {
+        REQUIRE(rav::MemoryArena::create({}) == nullptr);
+        REQUIRE(rav::MemoryArena::create({4096, 0}) == nullptr);
+    }
+
+    SECTION("Allocate and deallocate") {
+        auto arena = rav::MemoryArena::create({4096});
+        REQUIRE(arena != nullptr);
+        REQUIRE(arena->capacity() >= 4096);
+        REQUIRE(arena->bytes_allocated() == 0);
+
+        auto* a = arena->allocate(100);
+        auto* b = arena->allocate(1);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(arena->owns(a));
+        REQUIRE(arena->owns(b));
+        REQUIRE(reinterpret_cast<uintptr_t>(a) % rav::MemoryArena::k_alignment == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(b) % rav::MemoryArena::k_alignment == 0);
+        REQUIRE(arena->bytes_allocated() == 128 + 64);
+
+        int on_the_stack = 0;
+        REQUIRE_FALSE(arena->owns(&on_the_stack));
+
+        arena->deallocate(a);
+        REQUIRE(arena->bytes_allocated() == 64);
+
+        // The freed block is reused
+        REQUIRE(arena->allocate(128) == a);
+
+        arena->deallocate(a);
+        arena->deallocate(b);
+        arena->deallocate(nullptr);
+        REQUIRE(arena->bytes_allocated() == 0);
+    }
+
+    SECTION("Exhaustion") {
+        auto arena = rav::MemoryArena::create({4096});
+        REQUIRE(arena != nullptr);
+
+        auto* all = arena->allocate(arena->capacity());
+        REQUIRE(all != nullptr);
+        REQUIRE(arena->allocate(1) == nullptr);
+        arena->deallocate(all);
+
+        REQUIRE(arena->allocate(arena->capacity() + 1) == nullptr);
+        REQUIRE(arena->allocate(1, rav::MemoryArena::k_alignment * 2) == nullptr);
+    }
+
+    SECTION("Freed blocks are merged") {
+        auto arena = rav::MemoryArena::create({4096});
+        REQUIRE(arena != nullptr);
+
+        const auto third = arena->capacity() / 3 / rav::MemoryArena::k_alignment * rav::MemoryArena::k_alignment;
+        auto* a = arena->allocate(third);
+        auto* b = arena->allocate(third);
+        auto* c = arena->allocate(third);
+        REQUIRE(c != nullptr);
+
+        arena->deallocate(a);
+        arena->deallocate(c);
+        REQUIRE(arena->allocate(third * 2) == nullptr);  // The free blocks are not adjacent
+
+        arena->deallocate(b);
+        auto* all = arena->allocate(arena->capacity());
+        REQUIRE(all == a);
+        arena->deallocate(all);
+    }
+
+    SECTION("Max number of allocations") {
+        auto arena = rav::MemoryArena::create({4096, 2});
+        REQUIRE(arena != nullptr);
+
+        auto* a = arena->allocate(1);
+        auto* b = arena->allocate(1);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(arena->allocate(1) == nullptr);
+
+        arena->deallocate(a);
+        arena->deallocate(b);
+        REQUIRE(arena->bytes_allocated() == 0);
+    }
+
+    SECTION("Locked memory") {
+        auto arena = rav::MemoryArena::create({4096, 16, false, true});
+        if (arena == nullptr) {
+            WARN("Memory could not be locked, the memory lock limit is probably too low");
+            return;
+        }
+        REQUIRE(arena->is_locked());
+    }
+
+    SECTION("Huge pages fall back to regular pages") {
+        auto arena = rav::MemoryArena::create({4096, 16, true});
+        REQUIRE(arena != nullptr);
+        auto* ptr = arena->allocate(4096);
+        REQUIRE(ptr != nullptr);
+        arena->deallocate(ptr);
+    }
+}
+
+TEST_CASE("rav::ArenaAllocator") {
+    auto arena = rav::MemoryArena::create({64 * 1024});
+    REQUIRE(arena != nullptr);
+
+    SECTION("Vector") {
+        rav::ArenaVector<int> vector {rav::ArenaAllocator<int>(arena.get())};
+        vector.resize(1000);
+        REQUIRE(arena->owns(vector.data()));
+        REQUIRE(arena->bytes_allocated() >= 1000 * sizeof(int));
+
+        vector = rav::ArenaVector<int>();
+        REQUIRE(arena->bytes_allocated() == 0);
+        vector.resize(1000);
+        REQUIRE_FALSE(arena->owns(vector.data()));
+    }
+
+    SECTION("An exhausted arena falls back to the heap") {
+        rav::ArenaVector<uint8_t> vector {rav::ArenaAllocator<uint8_t>(arena.get())};
+        vector.resize(arena->capacity() + 1);
+        REQUIRE_FALSE(arena->owns(vector.data()));
+        REQUIRE(arena->bytes_allocated() == 0);
+    }
+
+    SECTION("Equality") {
+        REQUIRE(rav::ArenaAllocator<int>(arena.get()) == rav::ArenaAllocator<uint8_t>(arena.get()));
+        REQUIRE(rav::ArenaAllocator<int>(arena.get()) != rav::ArenaAllocator<int>());
+    }
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/shared_memory.hpp"
+#include "ravennakit/core/random.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+std::string get_unique_name() {
+    return "ravennakit_test_" + std::to_string(rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+}
+
+}  // namespace
+
+TEST_CASE("rav::SharedMemory") {
+    SECTION("Invalid arguments") {
+        REQUIRE(rav::SharedMemory::create({}, 4096) == nullptr);
+        REQUIRE(rav::SharedMemory::create(get_unique_name(), 0) == nullptr);
+        REQUIRE(rav::SharedMemory::open({}) == nullptr);
+    }
+
+    SECTION("Open a region which doesn't exist") {
+        REQUIRE(rav::SharedMemory::open(get_unique_name()) == nullptr);
+    }
+
+    SECTION("Create and open") {
+        const auto name = get_unique_name();
+        auto created = rav::SharedMemory::create(name, 10'000);
+        REQUIRE(created != nullptr);
+        REQUIRE(created->is_owner());
+        REQUIRE(created->name() == name);
+        REQUIRE(created->size() == 10'000);
+        REQUIRE(created->data()[0] == 0);
+        REQUIRE(created->data()[9'999] == 0);
+
+        // The name can only be created once
+        REQUIRE(rav::SharedMemory::create(name, 10'000) == nullptr);
+
+        auto opened = rav::SharedMemory::open(name);
+        REQUIRE(opened != nullptr);
+        REQUIRE_FALSE(opened->is_owner());
+        REQUIRE(opened->size() >= 10'000);
+        REQUIRE(opened->data() != created->data());
+
+        created->data()[1234] = 0xab;
+        REQUIRE(opened->data()[1234] == 0xab);
+        opened->data()[5678] = 0xcd;
+        REQUIRE(created->data()[5678] == 0xcd);
+
+        // The mapping outlives the name
+        created.reset();
+        REQUIRE(opened->data()[1234] == 0xab);
+        REQUIRE(rav::SharedMemory::open(name) == nullptr);
+    }
+}
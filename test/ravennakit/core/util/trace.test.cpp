@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/core/util/trace.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <fstream>
+#include <thread>
+
+namespace {
+
+void traced_function() {
+    RAV_TRACE_ZONE_SCOPED;
+}
+
+void disabled_traced_function() {
+    RAV_TRACE_ZONE_SCOPED;
+}
+
+}  // namespace
+
+TEST_CASE("rav::trace::ThreadBuffer") {
+    static constexpr rav::trace::SourceLocation location {"test", __FILE__, __LINE__};
+
+    SECTION("Events are returned oldest first") {
+        rav::trace::ThreadBuffer buffer(1);
+        REQUIRE(buffer.read().empty());
+        for (uint64_t i = 0; i < 10; ++i) {
+            buffer.write({i, i * 2, &location, rav::trace::EventType::plot});
+        }
+        const auto events = buffer.read();
+        REQUIRE(events.size() == 10);
+        for (uint64_t i = 0; i < 10; ++i) {
+            REQUIRE(events[i].timestamp_ns == i);
+            REQUIRE(events[i].payload == i * 2);
+            REQUIRE(events[i].location == &location);
+        }
+    }
+
+    SECTION("Oldest events are overwritten when full") {
+        rav::trace::ThreadBuffer buffer(1);
+        constexpr auto num_events = rav::trace::ThreadBuffer::k_capacity + 100;
+        for (uint64_t i = 0; i < num_events; ++i) {
+            buffer.write({i, 0, &location, rav::trace::EventType::message});
+        }
+        const auto events = buffer.read();
+        // The oldest remaining slot is discarded because it might be overwritten by the next write.
+        REQUIRE(events.size() == rav::trace::ThreadBuffer::k_capacity - 1);
+        REQUIRE(events.front().timestamp_ns == 101);
+        REQUIRE(events.back().timestamp_ns == num_events - 1);
+    }
+
+    SECTION("Read while writing from another thread") {
+        rav::trace::ThreadBuffer buffer(1);
+        std::atomic<bool> keep_going {true};
+        std::thread writer([&] {
+            uint64_t i = 0;
+            while (keep_going.load(std::memory_order_relaxed)) {
+                buffer.write({i, i, &location, rav::trace::EventType::plot});
+                ++i;
+            }
+        });
+        for (int n = 0; n < 20; ++n) {
+            const auto events = buffer.read();
+            for (size_t i = 1; i < events.size(); ++i) {
+                REQUIRE(events[i].timestamp_ns == events[i - 1].timestamp_ns + 1);
+                REQUIRE(events[i].payload == events[i].timestamp_ns);
+            }
+        }
+        keep_going = false;
+        writer.join();
+    }
+}
+
+TEST_CASE("rav::trace") {
+    RAV_TRACE_REGISTER_THREAD();
+
+    SECTION("Chrome trace JSON contains the recorded events") {
+        std::thread thread([] {
+            RAV_TRACE_SET_THREAD_NAME("trace_test_thread");
+            traced_function();
+            RAV_TRACE_PLOT("trace_test_plot", 1.5);
+            RAV_TRACE_MESSAGE("trace_test_message");
+        });
+        thread.join();
+
+        const auto json = rav::trace::to_chrome_trace_json();
+        REQUIRE(json.find(R"("args":{"name":"trace_test_thread"})") != std::string::npos);
+        REQUIRE(json.find(R"({"name":"traced_function","ph":"X")") != std::string::npos);
+        REQUIRE(json.find(R"({"name":"trace_test_plot","ph":"C")") != std::string::npos);
+        REQUIRE(json.find(R"("args":{"value":1.5})") != std::string::npos);
+        REQUIRE(json.find(R"({"name":"trace_test_message","ph":"i")") != std::string::npos);
+    }
+
+    SECTION("Events of unregistered threads are dropped") {
+        std::thread thread([] {
+            REQUIRE(rav::trace::get_thread_buffer() == nullptr);
+            RAV_TRACE_MESSAGE("trace_test_unregistered");
+            REQUIRE(rav::trace::get_thread_buffer() == nullptr);
+        });
+        thread.join();
+
+        REQUIRE(rav::trace::to_chrome_trace_json().find("trace_test_unregistered") == std::string::npos);
+    }
+
+    SECTION("Disabled") {
+        rav::trace::set_enabled(false);
+        RAV_TRACE_MESSAGE("trace_test_disabled");
+        disabled_traced_function();
+        rav::trace::set_enabled(true);
+        const auto json = rav::trace::to_chrome_trace_json();
+        REQUIRE(json.find("trace_test_disabled") == std::string::npos);
+        REQUIRE(json.find("disabled_traced_function") == std::string::npos);
+    }
+
+    SECTION("Anomaly triggers a dump") {
+        const auto directory = std::filesystem::temp_directory_path() / "ravennakit_trace_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        rav::trace::set_anomaly_dump_directory(directory);
+        rav::trace::set_anomaly_dump_interval(std::chrono::milliseconds(0));
+
+        REQUIRE(rav::trace::process_pending_dump().empty());
+
+        RAV_TRACE_ANOMALY("trace_test_anomaly");
+        const auto path = rav::trace::process_pending_dump();
+        REQUIRE(!path.empty());
+        REQUIRE(std::filesystem::exists(path));
+
+        std::ifstream file(path);
+        const std::string contents((std::istreambuf_iterator(file)), std::istreambuf_iterator<char>());
+        REQUIRE(contents.find(R"({"name":"trace_test_anomaly","cat":"anomaly")") != std::string::npos);
+
+        REQUIRE(rav::trace::process_pending_dump().empty());
+
+        rav::trace::set_anomaly_dump_directory({});
+        rav::trace::set_anomaly_dump_interval(std::chrono::seconds(10));
+        std::filesystem::remove_all(directory);
+    }
+}
@@ -64,5 +64,9 @@ TEST_CASE("rav::nmos::Version") {
         // Trailing whitespace
         v = rav::nmos::Version::from_string("1439299836:10 ");
         REQUIRE_FALSE(v.has_value());
+
+        // Nanoseconds out of range
+        v = rav::nmos::Version::from_string("1439299836:1000000000");
+        REQUIRE_FALSE(v.has_value());
     }
 }
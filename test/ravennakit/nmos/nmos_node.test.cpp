@@ -23,8 +23,10 @@
  */
 
 #include "ravennakit/nmos/nmos_node.hpp"
+#include "ravennakit/ptp/ptp_local_clock.hpp"
 #include "nmos_node.test.hpp"
 
+#include <boost/asio/steady_timer.hpp>
 #include <catch2/catch_all.hpp>
 
 namespace {
@@ -110,6 +112,98 @@ class NodeTestHttpClient final: public rav::HttpClientBase {
     }
 };
 
+/**
+ * A receiver which records the PATCH requests applied to it, and applies a scheduled activation when the local clock
+ * reaches the activation time, like RavennaReceiver does. The local clock of a node whose PTP instance doesn't run
+ * follows the monotonic system clock, like a default constructed LocalClock.
+ */
+class NodeTestReceiver {
+  public:
+    rav::nmos::ReceiverAudio receiver;
+    std::vector<boost::json::value> applied_patch_requests;
+    int calls_to_cancel = 0;
+
+    NodeTestReceiver(boost::asio::io_context& io_context, const boost::uuids::uuid& device_id) : timer_(io_context) {
+        receiver.id = boost::uuids::random_generator()();
+        receiver.label = "Test Receiver";
+        receiver.device_id = device_id;
+        receiver.transport = "urn:x-nmos:transport:rtp";
+        receiver.caps.media_types = {"audio/L24"};
+
+        receiver.on_patch_request = [this](const boost::json::value& patch_request) -> tl::expected<void, rav::nmos::ApiError> {
+            applied_patch_requests.push_back(patch_request);
+            if (const auto* master_enable = patch_request.as_object().if_contains("master_enable")) {
+                receiver.subscription.active = master_enable->as_bool();
+            }
+            return {};
+        };
+
+        receiver.get_transport_file = []() -> tl::expected<rav::sdp::SessionDescription, rav::nmos::ApiError> {
+            return rav::sdp::SessionDescription {};
+        };
+
+        receiver.on_scheduled_patch_request = [this](
+                                                  const boost::json::value& patch_request, const rav::nmos::Timestamp& activation_time
+                                              ) -> tl::expected<void, rav::nmos::ApiError> {
+            pending_patch_request_ = patch_request;
+            const rav::ptp::Timestamp at(activation_time.seconds, activation_time.nanoseconds);
+            const auto delay_s = std::max(at.to_seconds_double() - rav::ptp::LocalClock {}.now().to_seconds_double(), 0.0);
+            timer_.expires_after(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(delay_s)));
+            timer_.async_wait([this](const boost::system::error_code& ec) {
+                if (!ec) {
+                    activate();
+                }
+            });
+            return {};
+        };
+
+        receiver.on_cancel_scheduled_activation = [this] {
+            calls_to_cancel++;
+            timer_.cancel();
+            pending_patch_request_.reset();
+        };
+    }
+
+  private:
+    boost::asio::steady_timer timer_;
+    std::optional<boost::json::value> pending_patch_request_;
+
+    void activate() {
+        REQUIRE(pending_patch_request_.has_value());
+        REQUIRE(receiver.on_patch_request(*pending_patch_request_));
+        pending_patch_request_.reset();
+        receiver.active_activation = receiver.staged_activation;
+        receiver.active_activation.activation_time = rav::nmos::Timestamp(rav::ptp::LocalClock {}.now());
+        receiver.staged_activation = {};
+    }
+};
+
+/// Sends a request to the HTTP server of given node, running given io_context until the response arrived.
+rav::http::response<rav::http::string_body> http_request(
+    boost::asio::io_context& io_context, const rav::nmos::Node& node, const rav::http::verb method, const std::string_view target,
+    std::string body = {}
+) {
+    rav::HttpClient client(io_context, boost::asio::ip::make_address("127.0.0.1"), node.get_local_endpoint().port());
+    std::optional<rav::http::response<rav::http::string_body>> result;
+    client.request_async(method, target, std::move(body), "application/json", [&result](auto response) {
+        REQUIRE(response.has_value());
+        result = std::move(*response);
+    });
+    while (!result.has_value() && io_context.run_one()) {}
+    REQUIRE(result.has_value());
+    return std::move(*result);
+}
+
+/// Starts given node in peer to peer mode, so that it serves its APIs without a registry.
+void start_p2p(rav::nmos::Node& node) {
+    rav::nmos::Node::Configuration config;
+    config.id = boost::uuids::random_generator()();
+    config.operation_mode = rav::nmos::OperationMode::p2p;
+    config.enabled = true;
+    REQUIRE(node.set_configuration(config));
+    REQUIRE(node.get_local_endpoint().port() != 0);
+}
+
 }  // namespace
 
 TEST_CASE("rav::nmos::Node") {
@@ -342,6 +436,238 @@ TEST_CASE("rav::nmos::Node") {
         }
     }
 
+    SECTION("Scheduled activations over HTTP") {
+        boost::asio::io_context io_context;
+        rav::ptp::Instance ptp_instance(io_context);
+        rav::nmos::Node node(io_context, ptp_instance, std::make_unique<NodeTestRegistryBrowser>(), std::make_unique<NodeTestHttpClient>());
+        start_p2p(node);
+
+        rav::nmos::Device device;
+        device.id = boost::uuids::random_generator()();
+        REQUIRE(node.add_or_update_device(&device));
+        NodeTestReceiver test_receiver(io_context, device.id);
+        auto& receiver = test_receiver.receiver;
+        REQUIRE(node.add_or_update_receiver(&receiver));
+
+        const auto target = fmt::format("/x-nmos/connection/v1.1/single/receivers/{}", boost::uuids::to_string(receiver.id));
+        const auto patch = [&](const boost::json::value& body) {
+            return http_request(io_context, node, rav::http::verb::patch, target + "/staged", boost::json::serialize(body));
+        };
+        const auto get_activation = [&](const std::string_view endpoint) {
+            const auto response = http_request(io_context, node, rav::http::verb::get, fmt::format("{}/{}", target, endpoint));
+            REQUIRE(response.result() == rav::http::status::ok);
+            return boost::json::parse(response.body()).at("activation");
+        };
+
+        // An absolute activation is staged until the requested time, which is reported as the activation time
+        auto requested = rav::ptp::LocalClock {}.now();
+        requested.add_seconds(3600.0);
+        const auto requested_time = rav::nmos::Timestamp(requested).to_string();
+        auto response = patch({
+            {"master_enable", true},
+            {"activation", {{"mode", "activate_scheduled_absolute"}, {"requested_time", requested_time}}},
+        });
+        REQUIRE(response.result() == rav::http::status::accepted);
+        auto activation = boost::json::parse(response.body()).at("activation");
+        REQUIRE(activation.at("mode").as_string() == "activate_scheduled_absolute");
+        REQUIRE(activation.at("requested_time").as_string() == requested_time);
+        REQUIRE(activation.at("activation_time").as_string() == requested_time);
+        REQUIRE(get_activation("staged") == activation);
+        REQUIRE(get_activation("active").at("mode").is_null());
+        REQUIRE(test_receiver.applied_patch_requests.empty());
+        REQUIRE_FALSE(receiver.subscription.active);
+
+        // A null mode cancels the scheduled activation
+        response = patch({{"activation", {{"mode", nullptr}}}});
+        REQUIRE(response.result() == rav::http::status::ok);
+        REQUIRE(test_receiver.calls_to_cancel == 1);
+        activation = get_activation("staged");
+        REQUIRE(activation.at("mode").is_null());
+        REQUIRE(activation.at("requested_time").is_null());
+        REQUIRE(activation.at("activation_time").is_null());
+        REQUIRE(test_receiver.applied_patch_requests.size() == 1);
+        REQUIRE_FALSE(receiver.subscription.active);
+
+        // A relative activation takes place the requested time after the request was received
+        const auto before = rav::ptp::LocalClock {}.now();
+        response = patch({
+            {"master_enable", true},
+            {"activation", {{"mode", "activate_scheduled_relative"}, {"requested_time", "0:100000000"}}},
+        });
+        const auto after = rav::ptp::LocalClock {}.now();
+        REQUIRE(response.result() == rav::http::status::accepted);
+        activation = boost::json::parse(response.body()).at("activation");
+        REQUIRE(activation.at("mode").as_string() == "activate_scheduled_relative");
+        REQUIRE(activation.at("requested_time").as_string() == "0:100000000");
+        const auto activation_time = boost::json::value_to<rav::nmos::Timestamp>(activation.at("activation_time"));
+        auto earliest = before;
+        earliest.add_seconds(0.1);
+        auto latest = after;
+        latest.add_seconds(0.1);
+        REQUIRE(activation_time >= rav::nmos::Timestamp(earliest));
+        REQUIRE(activation_time <= rav::nmos::Timestamp(latest));
+        REQUIRE(get_activation("staged") == activation);
+
+        // Once the time arrived, the activation moves from the staged endpoint to the active endpoint
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (receiver.staged_activation.mode.has_value() && std::chrono::steady_clock::now() < deadline) {
+            io_context.run_one_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(get_activation("staged").at("mode").is_null());
+        activation = get_activation("active");
+        REQUIRE(activation.at("mode").as_string() == "activate_scheduled_relative");
+        REQUIRE(activation.at("requested_time").as_string() == "0:100000000");
+        REQUIRE(boost::json::value_to<rav::nmos::Timestamp>(activation.at("activation_time")) >= activation_time);
+        REQUIRE(test_receiver.applied_patch_requests.size() == 2);
+        REQUIRE(receiver.subscription.active);
+
+        // Invalid times are refused without staging anything
+        const auto refused = [&](const boost::json::value& requested_activation) {
+            const auto refused_response = patch({{"master_enable", false}, {"activation", requested_activation}});
+            return refused_response.result() == rav::http::status::bad_request;
+        };
+        REQUIRE(refused({{"mode", "activate_scheduled_absolute"}}));
+        REQUIRE(refused({{"mode", "activate_scheduled_relative"}, {"requested_time", nullptr}}));
+        REQUIRE(refused({{"mode", "activate_scheduled_absolute"}, {"requested_time", "not a time"}}));
+        REQUIRE(refused({{"mode", "activate_scheduled_relative"}, {"requested_time", "0:1000000000"}}));
+        REQUIRE(refused({{"mode", "activate_scheduled_relative"}, {"requested_time", 100}}));
+        REQUIRE(refused({{"mode", "activate_later"}, {"requested_time", "0:0"}}));
+        REQUIRE(get_activation("staged").at("mode").is_null());
+        REQUIRE(test_receiver.applied_patch_requests.size() == 2);
+        REQUIRE(receiver.subscription.active);
+
+        // An immediate activation is reported in the response only
+        response = patch({{"master_enable", false}, {"activation", {{"mode", "activate_immediate"}}}});
+        REQUIRE(response.result() == rav::http::status::ok);
+        REQUIRE(boost::json::parse(response.body()).at("activation").at("mode").as_string() == "activate_immediate");
+        REQUIRE(get_activation("staged").at("mode").is_null());
+        REQUIRE(get_activation("active").at("mode").as_string() == "activate_immediate");
+        REQUIRE_FALSE(receiver.subscription.active);
+
+        REQUIRE(node.remove_receiver(&receiver));
+        REQUIRE(node.remove_device(&device));
+    }
+
+    SECTION("Bulk requests over HTTP") {
+        boost::asio::io_context io_context;
+        rav::ptp::Instance ptp_instance(io_context);
+        rav::nmos::Node node(io_context, ptp_instance, std::make_unique<NodeTestRegistryBrowser>(), std::make_unique<NodeTestHttpClient>());
+        start_p2p(node);
+
+        int calls_to_begin = 0;
+        int calls_to_end = 0;
+        node.on_bulk_request_begin = [&] {
+            REQUIRE(calls_to_begin == calls_to_end);
+            calls_to_begin++;
+        };
+        node.on_bulk_request_end = [&] {
+            calls_to_end++;
+            REQUIRE(calls_to_begin == calls_to_end);
+        };
+
+        rav::nmos::Device device;
+        device.id = boost::uuids::random_generator()();
+        REQUIRE(node.add_or_update_device(&device));
+        NodeTestReceiver first(io_context, device.id);
+        NodeTestReceiver second(io_context, device.id);
+        REQUIRE(node.add_or_update_receiver(&first.receiver));
+        REQUIRE(node.add_or_update_receiver(&second.receiver));
+
+        const auto post = [&](const std::string_view resources, std::string body) {
+            return http_request(io_context, node, rav::http::verb::post, fmt::format("/x-nmos/connection/v1.1/bulk/{}", resources), body);
+        };
+
+        const auto first_id = boost::uuids::to_string(first.receiver.id);
+        const auto second_id = boost::uuids::to_string(second.receiver.id);
+        const auto unknown_id = boost::uuids::to_string(boost::uuids::random_generator()());
+        auto requested = rav::ptp::LocalClock {}.now();
+        requested.add_seconds(3600.0);
+
+        // Every entry is applied on its own and reports its own status, in the order of the request
+        const boost::json::array request {
+            {{"id", first_id}, {"params", {{"master_enable", true}}}},
+            {{"id", second_id},
+             {"params",
+              {{"master_enable", true},
+               {"activation",
+                {{"mode", "activate_scheduled_absolute"}, {"requested_time", rav::nmos::Timestamp(requested).to_string()}}}}}},
+            {{"id", unknown_id}, {"params", {{"master_enable", true}}}},
+            {{"params", {{"master_enable", true}}}},
+            {{"id", first_id}},
+            {{"id", "not-a-uuid"}, {"params", {{"master_enable", true}}}},
+            {{"id", first_id}, {"params", {{"unexpected", true}}}},
+            {{"id", first_id}, {"params", {{"activation", {{"mode", "activate_scheduled_relative"}}}}}},
+            42,
+        };
+        auto response = post("receivers", boost::json::serialize(request));
+        REQUIRE(response.result() == rav::http::status::ok);
+        const auto results = boost::json::parse(response.body()).as_array();
+        REQUIRE(results.size() == request.size());
+
+        const std::array<std::pair<std::string, unsigned>, 9> expected {{
+            {first_id, 200},
+            {second_id, 202},
+            {unknown_id, 404},
+            {"", 400},
+            {"", 400},
+            {"not-a-uuid", 400},
+            {first_id, 400},
+            {first_id, 400},
+            {"", 400},
+        }};
+        for (size_t i = 0; i < expected.size(); ++i) {
+            INFO("Entry " << i);
+            REQUIRE(results[i].at("id").as_string() == expected[i].first);
+            REQUIRE(results[i].at("code").to_number<unsigned>() == expected[i].second);
+            if (expected[i].second >= 400) {
+                REQUIRE(results[i].at("error").is_string());
+                REQUIRE(results[i].at("debug").is_string());
+            }
+        }
+
+        // The bulk request is bracketed once, no matter how many entries failed
+        REQUIRE(calls_to_begin == 1);
+        REQUIRE(calls_to_end == 1);
+        REQUIRE(first.receiver.subscription.active);
+        REQUIRE(first.applied_patch_requests.size() == 1);
+        REQUIRE(second.receiver.staged_activation.mode == rav::nmos::Activation::Mode::activate_scheduled_absolute);
+        REQUIRE(second.applied_patch_requests.empty());
+        REQUIRE_FALSE(second.receiver.subscription.active);
+
+        // A body which isn't an array is refused as a whole, without bracketing
+        REQUIRE(post("receivers", boost::json::serialize(request.front())).result() == rav::http::status::bad_request);
+        REQUIRE(post("receivers", "[{").result() == rav::http::status::bad_request);
+        REQUIRE(post("receivers", "").result() == rav::http::status::bad_request);
+        REQUIRE(calls_to_begin == 1);
+        REQUIRE(calls_to_end == 1);
+
+        response = post("receivers", "[]");
+        REQUIRE(response.result() == rav::http::status::ok);
+        REQUIRE(boost::json::parse(response.body()).as_array().empty());
+        REQUIRE(calls_to_begin == 2);
+        REQUIRE(calls_to_end == 2);
+
+        // The ids of the senders are looked up among the senders only
+        response = post("senders", boost::json::serialize(boost::json::array {{{"id", first_id}, {"params", {{"master_enable", true}}}}}));
+        REQUIRE(response.result() == rav::http::status::ok);
+        const auto sender_results = boost::json::parse(response.body()).as_array();
+        REQUIRE(sender_results.size() == 1);
+        REQUIRE(sender_results[0].at("code").to_number<unsigned>() == 404);
+        REQUIRE(calls_to_begin == 3);
+        REQUIRE(calls_to_end == 3);
+
+        // Bulk resources only support POST
+        for (const auto* resources : {"receivers", "senders"}) {
+            response = http_request(io_context, node, rav::http::verb::get, fmt::format("/x-nmos/connection/v1.1/bulk/{}", resources));
+            REQUIRE(response.result() == rav::http::status::method_not_allowed);
+        }
+        REQUIRE(calls_to_begin == 3);
+
+        REQUIRE(node.remove_receiver(&first.receiver));
+        REQUIRE(node.remove_receiver(&second.receiver));
+        REQUIRE(node.remove_device(&device));
+    }
+
     SECTION("JSON") {
         rav::nmos::Node::Configuration config;
         config.id = boost::uuids::random_generator()();
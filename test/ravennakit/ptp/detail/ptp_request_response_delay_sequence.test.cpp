@@ -62,4 +62,19 @@ TEST_CASE("rav::ptp::RequestResponseDelaySequence") {
         auto mean_delay = seq.calculate_mean_path_delay();
         REQUIRE(rav::is_within(mean_delay,1.5, 0.0));
     }
+
+    SECTION("Send time handed back after sending") {
+        rav::ptp::SyncMessage sync_message;
+        sync_message.receive_timestamp = rav::ptp::Timestamp(11, 0);
+
+        rav::ptp::RequestResponseDelaySequence seq(sync_message);
+        seq.schedule_delay_req_message_send({});
+
+        seq.set_delay_req_sending();
+        REQUIRE(seq.get_state() == rav::ptp::RequestResponseDelaySequence::state::delay_req_sending);
+        REQUIRE_FALSE(seq.get_delay_req_scheduled_send_time().has_value());
+
+        seq.set_delay_req_sent_time(rav::ptp::Timestamp(12, 0));
+        REQUIRE(seq.get_state() == rav::ptp::RequestResponseDelaySequence::state::awaiting_delay_resp);
+    }
 }
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/ptp/detail/ptp_unicast_negotiation.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <deque>
+
+namespace {
+
+/**
+ * Stands in for a unicast master. Receives the signaling messages in wire format, keeps track of the grants and replies
+ * like a master would.
+ */
+struct StandInMaster {
+    boost::asio::ip::address_v4 address = boost::asio::ip::make_address_v4("192.168.1.1");
+    rav::ptp::PortIdentity port_identity {{{0x00, 0x1d, 0xc1, 0xff, 0xfe, 0x00, 0x00, 0x01}}, 1};
+    int8_t fastest_log_inter_message_period {-7};  // Requests for faster rates are denied
+    uint32_t max_duration {300};
+    bool renewal_invited {true};
+    bool reachable {true};
+
+    std::vector<rav::ptp::UnicastNegotiationTlv> received;
+    std::map<rav::ptp::MessageType, int8_t> grants;
+
+    std::optional<rav::ptp::SignalingMessage> receive(const rav::ByteBuffer& buffer) {
+        const rav::BufferView data(buffer.data(), buffer.size());
+        const auto header = rav::ptp::MessageHeader::from_data(data);
+        REQUIRE(header);
+        REQUIRE(header->message_type == rav::ptp::MessageType::signaling);
+        REQUIRE(header->flags.unicast_flag);
+        const auto message = rav::ptp::SignalingMessage::from_data(*header, data.subview(rav::ptp::MessageHeader::k_header_size));
+        REQUIRE(message);
+
+        if (!reachable) {
+            received.insert(received.end(), message->tlvs.begin(), message->tlvs.end());
+            return std::nullopt;
+        }
+
+        rav::ptp::SignalingMessage reply;
+        reply.header.source_port_identity = port_identity;
+        reply.target_port_identity = header->source_port_identity;
+
+        for (auto& tlv : message->tlvs) {
+            received.push_back(tlv);
+            switch (tlv.tlv_type) {
+                case rav::ptp::TlvType::request_unicast_transmission: {
+                    rav::ptp::UnicastNegotiationTlv grant;
+                    grant.tlv_type = rav::ptp::TlvType::grant_unicast_transmission;
+                    grant.message_type = tlv.message_type;
+                    grant.log_inter_message_period = tlv.log_inter_message_period;
+                    if (tlv.log_inter_message_period >= fastest_log_inter_message_period) {
+                        grant.duration_field = std::min(tlv.duration_field, max_duration);
+                        grant.renewal_invited = renewal_invited;
+                        grants[tlv.message_type] = tlv.log_inter_message_period;
+                    }
+                    reply.tlvs.push_back(grant);
+                    break;
+                }
+                case rav::ptp::TlvType::cancel_unicast_transmission: {
+                    grants.erase(tlv.message_type);
+                    reply.tlvs.push_back({rav::ptp::TlvType::acknowledge_cancel_unicast_transmission, tlv.message_type, 0, 0, false});
+                    break;
+                }
+                case rav::ptp::TlvType::grant_unicast_transmission:
+                case rav::ptp::TlvType::acknowledge_cancel_unicast_transmission:
+                default:
+                    break;
+            }
+        }
+
+        if (reply.tlvs.empty()) {
+            return std::nullopt;
+        }
+        return reply;
+    }
+
+    [[nodiscard]] size_t count(const rav::ptp::TlvType type, const rav::ptp::MessageType message_type) const {
+        return static_cast<size_t>(std::count_if(received.begin(), received.end(), [&](const auto& tlv) {
+            return tlv.tlv_type == type && tlv.message_type == message_type;
+        }));
+    }
+};
+
+rav::ptp::SignalingMessage to_wire_and_back(const rav::ptp::SignalingMessage& message) {
+    rav::ByteBuffer buffer;
+    message.write_to(buffer);
+    const rav::BufferView data(buffer.data(), buffer.size());
+    const auto header = rav::ptp::MessageHeader::from_data(data);
+    REQUIRE(header);
+    const auto result = rav::ptp::SignalingMessage::from_data(*header, data.subview(rav::ptp::MessageHeader::k_header_size));
+    REQUIRE(result);
+    return *result;
+}
+
+/**
+ * Connects a UnicastNegotiation with a StandInMaster in-process.
+ */
+struct Fixture {
+    using Clock = rav::ptp::UnicastNegotiation::Clock;
+
+    rav::ptp::PortIdentity port_identity {{{0x00, 0x1d, 0xc1, 0xff, 0xfe, 0x00, 0x00, 0x02}}, 1};
+    StandInMaster master;
+    std::deque<std::pair<boost::asio::ip::address_v4, rav::ByteBuffer>> outbox;
+    rav::ptp::UnicastNegotiation negotiation {
+        port_identity,
+        [this](const boost::asio::ip::address_v4& destination, const rav::ptp::SignalingMessage& message) {
+            rav::ByteBuffer buffer;
+            message.write_to(buffer);
+            outbox.emplace_back(destination, std::move(buffer));
+        }
+    };
+    Clock::time_point now {};
+
+    rav::ptp::UnicastMaster master_config() const {
+        rav::ptp::UnicastMaster config;
+        config.address = master.address;
+        config.log_announce_interval = 0;
+        config.log_sync_interval = -3;
+        config.log_delay_resp_interval = -3;
+        config.duration = 60;
+        return config;
+    }
+
+    /// Delivers all pending messages in both directions.
+    void deliver() {
+        while (!outbox.empty()) {
+            auto [destination, buffer] = std::move(outbox.front());
+            outbox.pop_front();
+            REQUIRE(destination == master.address);
+            if (auto reply = master.receive(buffer)) {
+                negotiation.handle_signaling_message(master.address, to_wire_and_back(*reply), now);
+            }
+        }
+    }
+
+    void advance(const Clock::duration duration) {
+        now += duration;
+        negotiation.process(now);
+        deliver();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("rav::ptp::UnicastNegotiation") {
+    using rav::ptp::MessageType;
+    using rav::ptp::TlvType;
+
+    Fixture f;
+    f.negotiation.set_masters({f.master_config()}, f.now);
+
+    SECTION("Requests Announce, Sync and Delay_Resp from the master") {
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+        f.advance({});
+
+        REQUIRE(f.master.received.size() == 3);
+        REQUIRE(f.master.received[0].tlv_type == TlvType::request_unicast_transmission);
+        REQUIRE(f.master.received[0].message_type == MessageType::announce);
+        REQUIRE(f.master.received[0].log_inter_message_period == 0);
+        REQUIRE(f.master.received[0].duration_field == 60);
+        REQUIRE(f.master.received[1].message_type == MessageType::sync);
+        REQUIRE(f.master.received[1].log_inter_message_period == -3);
+        REQUIRE(f.master.received[2].message_type == MessageType::delay_resp);
+
+        for (auto type : rav::ptp::UnicastNegotiation::k_message_types) {
+            REQUIRE(f.negotiation.is_granted(f.master.address, type));
+        }
+        REQUIRE(f.negotiation.get_granted_log_inter_message_period(f.master.address, MessageType::sync) == -3);
+        REQUIRE(f.negotiation.find_granted_master(f.master.port_identity, MessageType::delay_resp) == f.master.address);
+        REQUIRE_FALSE(f.negotiation.find_granted_master(f.port_identity, MessageType::delay_resp));
+    }
+
+    SECTION("Doesn't request again while granted") {
+        f.advance({});
+        f.master.received.clear();
+        f.advance(std::chrono::seconds(29));
+        REQUIRE(f.master.received.empty());
+    }
+
+    SECTION("Renews grants halfway their duration") {
+        f.advance({});
+        f.master.received.clear();
+        f.advance(std::chrono::seconds(30));
+        REQUIRE(f.master.count(TlvType::request_unicast_transmission, MessageType::sync) == 1);
+
+        // Keeps the grant going past the original duration
+        for (int i = 0; i < 100; ++i) {
+            f.advance(std::chrono::seconds(1));
+        }
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+
+    SECTION("Requests again when a grant without renewal invitation expires") {
+        f.master.renewal_invited = false;
+        f.advance({});
+        f.master.received.clear();
+        f.advance(std::chrono::seconds(59));
+        REQUIRE(f.master.received.empty());
+        f.advance(std::chrono::seconds(1));
+        REQUIRE(f.master.count(TlvType::request_unicast_transmission, MessageType::sync) == 1);
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+
+    SECTION("Grants expire when the master stops responding") {
+        f.advance({});
+        f.master.reachable = false;
+        f.advance(std::chrono::seconds(59));
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+        f.advance(std::chrono::seconds(1));
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+
+        // Requests are retried, but not more often than the retry interval
+        f.master.received.clear();
+        f.advance(std::chrono::seconds(1));
+        REQUIRE(f.master.count(TlvType::request_unicast_transmission, MessageType::sync) == 0);
+        f.advance(std::chrono::seconds(1));
+        REQUIRE(f.master.count(TlvType::request_unicast_transmission, MessageType::sync) == 1);
+    }
+
+    SECTION("Uses the granted duration of the master") {
+        f.master.max_duration = 10;
+        f.advance({});
+        f.master.reachable = false;
+        f.advance(std::chrono::seconds(10));
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+
+    SECTION("Falls back to a lower rate when denied") {
+        f.master.fastest_log_inter_message_period = -1;
+        f.advance({});
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::announce));
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+
+        for (int i = 0; i < 2; ++i) {
+            f.advance(rav::ptp::UnicastNegotiation::k_request_retry_interval);
+        }
+        REQUIRE(f.negotiation.get_granted_log_inter_message_period(f.master.address, MessageType::sync) == -1);
+        REQUIRE(f.negotiation.get_granted_log_inter_message_period(f.master.address, MessageType::delay_resp) == -1);
+        REQUIRE(f.master.grants[MessageType::sync] == -1);
+    }
+
+    SECTION("Stops falling back at the maximum period") {
+        f.master.fastest_log_inter_message_period = 10;
+        for (int i = 0; i < 20; ++i) {
+            f.advance(rav::ptp::UnicastNegotiation::k_request_retry_interval);
+        }
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+        REQUIRE(f.master.received.back().log_inter_message_period == rav::ptp::UnicastNegotiation::k_max_log_inter_message_period);
+    }
+
+    SECTION("Acknowledges a cancel from the master and requests again later") {
+        f.advance({});
+
+        rav::ptp::SignalingMessage cancel;
+        cancel.header.source_port_identity = f.master.port_identity;
+        cancel.target_port_identity = f.port_identity;
+        cancel.tlvs.push_back({TlvType::cancel_unicast_transmission, MessageType::sync, 0, 0, false});
+        f.negotiation.handle_signaling_message(f.master.address, to_wire_and_back(cancel), f.now);
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::announce));
+
+        f.master.received.clear();
+        f.deliver();
+        REQUIRE(f.master.count(TlvType::acknowledge_cancel_unicast_transmission, MessageType::sync) == 1);
+
+        f.advance(rav::ptp::UnicastNegotiation::k_request_retry_interval);
+        REQUIRE(f.master.count(TlvType::request_unicast_transmission, MessageType::sync) == 1);
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+
+    SECTION("Cancels grants when the master is removed") {
+        f.advance({});
+        REQUIRE(f.master.grants.size() == 3);
+        f.negotiation.set_masters({}, f.now);
+        f.deliver();
+        REQUIRE(f.master.count(TlvType::cancel_unicast_transmission, MessageType::sync) == 1);
+        REQUIRE(f.master.grants.empty());
+        REQUIRE(f.negotiation.empty());
+    }
+
+    SECTION("Requests again when the rate of a master changes") {
+        f.advance({});
+        auto config = f.master_config();
+        config.log_sync_interval = -2;
+        f.negotiation.set_masters({config}, f.now);
+        f.advance({});
+        REQUIRE(f.negotiation.get_granted_log_inter_message_period(f.master.address, MessageType::sync) == -2);
+        REQUIRE(f.master.grants[MessageType::sync] == -2);
+    }
+
+    SECTION("Keeps grants when the masters are set unchanged") {
+        f.advance({});
+        f.master.received.clear();
+        f.negotiation.set_masters({f.master_config()}, f.now);
+        f.advance({});
+        REQUIRE(f.master.received.empty());
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+
+    SECTION("Denies requests from the master") {
+        rav::ptp::SignalingMessage request;
+        request.header.source_port_identity = f.master.port_identity;
+        request.target_port_identity = f.port_identity;
+        request.tlvs.push_back({TlvType::request_unicast_transmission, MessageType::sync, -3, 60, false});
+        f.negotiation.handle_signaling_message(f.master.address, request, f.now);
+        REQUIRE(f.outbox.size() == 1);
+
+        const rav::BufferView data(f.outbox.front().second.data(), f.outbox.front().second.size());
+        const auto header = rav::ptp::MessageHeader::from_data(data);
+        REQUIRE(header);
+        const auto reply = rav::ptp::SignalingMessage::from_data(*header, data.subview(rav::ptp::MessageHeader::k_header_size));
+        REQUIRE(reply);
+        REQUIRE(reply->tlvs.size() == 1);
+        REQUIRE(reply->tlvs[0].tlv_type == TlvType::grant_unicast_transmission);
+        REQUIRE(reply->tlvs[0].duration_field == 0);
+    }
+
+    SECTION("Ignores messages from unknown masters and for other ports") {
+        rav::ptp::SignalingMessage grant;
+        grant.header.source_port_identity = f.master.port_identity;
+        grant.target_port_identity = f.port_identity;
+        grant.tlvs.push_back({TlvType::grant_unicast_transmission, MessageType::sync, -3, 60, true});
+
+        f.negotiation.handle_signaling_message(boost::asio::ip::make_address_v4("192.168.1.2"), grant, f.now);
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+
+        grant.target_port_identity.port_number = 2;
+        f.negotiation.handle_signaling_message(f.master.address, grant, f.now);
+        REQUIRE_FALSE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+
+        grant.target_port_identity.port_number = rav::ptp::PortIdentity::k_port_number_all;
+        f.negotiation.handle_signaling_message(f.master.address, grant, f.now);
+        REQUIRE(f.negotiation.is_granted(f.master.address, MessageType::sync));
+    }
+}
@@ -63,4 +63,43 @@ TEST_CASE("rav::ptp::AnnounceMessage") {
         REQUIRE(announce->steps_removed == 0x1b1c);
         REQUIRE(announce->time_source == rav::ptp::TimeSource::ptp);
     }
+
+    SECTION("Pack") {
+        rav::ptp::AnnounceMessage announce;
+        announce.header.message_type = rav::ptp::MessageType::announce;
+        announce.header.version = {2, 1};
+        announce.header.message_length = rav::ptp::MessageHeader::k_header_size + rav::ptp::AnnounceMessage::k_message_size;
+        announce.origin_timestamp = rav::ptp::Timestamp(0x010203040506, 0x0708090a);
+        announce.current_utc_offset = 37;
+        announce.grandmaster_priority1 = 128;
+        announce.grandmaster_clock_quality.clock_class = 6;
+        announce.grandmaster_clock_quality.clock_accuracy = rav::ptp::ClockAccuracy::lt_25_ns;
+        announce.grandmaster_clock_quality.offset_scaled_log_variance = 0x4e5d;
+        announce.grandmaster_priority2 = 127;
+        announce.grandmaster_identity.data = {0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a};
+        announce.steps_removed = 1;
+        announce.time_source = rav::ptp::TimeSource::gnss;
+
+        rav::ByteBuffer buffer;
+        announce.write_to(buffer);
+        REQUIRE(buffer.size() == rav::ptp::MessageHeader::k_header_size + rav::ptp::AnnounceMessage::k_message_size);
+
+        const rav::BufferView<const uint8_t> data(buffer.data(), buffer.size());
+        const auto header = rav::ptp::MessageHeader::from_data(data);
+        REQUIRE(header);
+        const auto unpacked = rav::ptp::AnnounceMessage::from_data(*header, data.subview(rav::ptp::MessageHeader::k_header_size));
+        REQUIRE(unpacked);
+        REQUIRE(unpacked->header.message_type == rav::ptp::MessageType::announce);
+        REQUIRE(unpacked->origin_timestamp.raw_seconds() == 0x010203040506);
+        REQUIRE(unpacked->origin_timestamp.raw_nanoseconds() == 0x0708090a);
+        REQUIRE(unpacked->current_utc_offset == announce.current_utc_offset);
+        REQUIRE(unpacked->grandmaster_priority1 == announce.grandmaster_priority1);
+        REQUIRE(unpacked->grandmaster_clock_quality.clock_class == 6);
+        REQUIRE(unpacked->grandmaster_clock_quality.clock_accuracy == rav::ptp::ClockAccuracy::lt_25_ns);
+        REQUIRE(unpacked->grandmaster_clock_quality.offset_scaled_log_variance == 0x4e5d);
+        REQUIRE(unpacked->grandmaster_priority2 == announce.grandmaster_priority2);
+        REQUIRE(unpacked->grandmaster_identity == announce.grandmaster_identity);
+        REQUIRE(unpacked->steps_removed == announce.steps_removed);
+        REQUIRE(unpacked->time_source == announce.time_source);
+    }
 }
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/ptp/messages/ptp_signaling_message.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+rav::ptp::SignalingMessage parse(const rav::ByteBuffer& buffer) {
+    const rav::BufferView data(buffer.data(), buffer.size());
+    const auto header = rav::ptp::MessageHeader::from_data(data);
+    REQUIRE(header);
+    auto message = rav::ptp::SignalingMessage::from_data(*header, data.subview(rav::ptp::MessageHeader::k_header_size));
+    REQUIRE(message);
+    return *message;
+}
+
+}  // namespace
+
+TEST_CASE("rav::ptp::SignalingMessage") {
+    SECTION("Pack and unpack") {
+        rav::ptp::SignalingMessage message;
+        message.header.source_port_identity.clock_identity.data = {1, 2, 3, 4, 5, 6, 7, 8};
+        message.header.source_port_identity.port_number = 1;
+        message.header.sequence_id = 42;
+        message.target_port_identity.clock_identity.data = {8, 7, 6, 5, 4, 3, 2, 1};
+        message.target_port_identity.port_number = 2;
+        message.tlvs.push_back(
+            {rav::ptp::TlvType::request_unicast_transmission, rav::ptp::MessageType::sync, -3, 60, false}
+        );
+        message.tlvs.push_back({rav::ptp::TlvType::grant_unicast_transmission, rav::ptp::MessageType::announce, 1, 300, true});
+        message.tlvs.push_back({rav::ptp::TlvType::cancel_unicast_transmission, rav::ptp::MessageType::delay_resp, 0, 0, false});
+        message.tlvs.push_back(
+            {rav::ptp::TlvType::acknowledge_cancel_unicast_transmission, rav::ptp::MessageType::delay_resp, 0, 0, false}
+        );
+
+        rav::ByteBuffer buffer;
+        message.write_to(buffer);
+        REQUIRE(buffer.size() == 34 + 10 + 10 + 12 + 6 + 6);
+
+        auto result = parse(buffer);
+        REQUIRE(result.header.message_type == rav::ptp::MessageType::signaling);
+        REQUIRE(result.header.message_length == buffer.size());
+        REQUIRE(result.header.log_message_interval == 0x7f);
+        REQUIRE(result.header.sequence_id.value() == 42);
+        REQUIRE(result.header.source_port_identity == message.header.source_port_identity);
+        REQUIRE(result.target_port_identity == message.target_port_identity);
+        REQUIRE(result.tlvs == message.tlvs);
+    }
+
+    SECTION("Grant TLV wire format") {
+        rav::ptp::SignalingMessage message;
+        message.tlvs.push_back({rav::ptp::TlvType::grant_unicast_transmission, rav::ptp::MessageType::sync, -4, 0x01020304, true});
+
+        rav::ByteBuffer buffer;
+        message.write_to(buffer);
+        REQUIRE(buffer.size() == 56);
+
+        constexpr std::array<uint8_t, 12> expected {0x00, 0x05, 0x00, 0x08, 0x00, 0xfc, 0x01, 0x02, 0x03, 0x04, 0x00, 0x01};
+        REQUIRE(std::memcmp(buffer.data() + 44, expected.data(), expected.size()) == 0);
+    }
+
+    SECTION("Unknown TLVs are skipped") {
+        constexpr std::array<const uint8_t, 24> data {
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x00, 0x01,  // Target port identity
+            0x80, 0x01, 0x00, 0x02, 0xaa, 0xbb,                          // Unknown TLV
+            0x00, 0x06, 0x00, 0x02, 0xb0, 0x00,                          // Cancel announce
+            0x00, 0x00,                                                  // Trailing padding
+        };
+        const auto message = rav::ptp::SignalingMessage::from_data({}, rav::BufferView(data));
+        REQUIRE(message);
+        REQUIRE(message->target_port_identity.port_number == 1);
+        REQUIRE(message->tlvs.size() == 1);
+        REQUIRE(message->tlvs[0].tlv_type == rav::ptp::TlvType::cancel_unicast_transmission);
+        REQUIRE(message->tlvs[0].message_type == rav::ptp::MessageType::announce);
+    }
+
+    SECTION("Truncated TLV") {
+        constexpr std::array<const uint8_t, 18> data {
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x00, 0x01,  // Target port identity
+            0x00, 0x05, 0x00, 0x08, 0x00, 0xfc, 0x01, 0x02,              // Grant, cut short
+        };
+        const auto message = rav::ptp::SignalingMessage::from_data({}, rav::BufferView(data));
+        REQUIRE_FALSE(message);
+        REQUIRE(message.error() == rav::ptp::Error::invalid_message_length);
+    }
+
+    SECTION("Too short") {
+        constexpr std::array<const uint8_t, 8> data {};
+        REQUIRE_FALSE(rav::ptp::SignalingMessage::from_data({}, rav::BufferView(data)));
+    }
+}
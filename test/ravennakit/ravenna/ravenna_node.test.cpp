@@ -25,11 +25,32 @@
 #include "ravenna_receiver.test.hpp"
 #include "ravenna_sender.test.hpp"
 #include "ravennakit/ravenna/ravenna_node.hpp"
+#include "ravennakit/core/net/http/http_client.hpp"
+#include "ravennakit/core/util/trace.hpp"
 #include "../core/net/interfaces/network_interface_config.test.hpp"
 #include "../nmos/nmos_node.test.hpp"
 
 #include <catch2/catch_all.hpp>
 
+#include <set>
+
+namespace {
+
+/// Requests given target from the local HTTP server at given port.
+boost::beast::http::response<boost::beast::http::string_body> http_get(const uint16_t port, const std::string_view target) {
+    boost::asio::io_context io_context;
+    rav::HttpClient client(io_context, boost::asio::ip::make_address("127.0.0.1"), port);
+    boost::beast::http::response<boost::beast::http::string_body> result;
+    client.get_async(target, [&result](auto response) {
+        REQUIRE(response.has_value());
+        result = std::move(*response);
+    });
+    io_context.run();
+    return result;
+}
+
+}  // namespace
+
 TEST_CASE("rav::RavennaNode") {
     rav::AudioFormat audio_format;
     audio_format.encoding = rav::AudioEncoding::pcm_s24;
@@ -133,5 +154,87 @@ TEST_CASE("rav::RavennaNode") {
         rav::test_ravenna_receiver_configuration_json(receiver2, json_receivers.at(1).at("configuration"));
     }
 
+    SECTION("Batch provisioning") {
+        const auto receiver_ids = ravenna_node.create_receivers({receiver1, receiver2}).get().value();
+        REQUIRE(receiver_ids.size() == 2);
+        REQUIRE(receiver_ids[0].is_valid());
+        REQUIRE(receiver_ids[1].is_valid());
+        REQUIRE(receiver_ids[0] != receiver_ids[1]);
+
+        const auto sender_ids = ravenna_node.create_senders({sender1, sender2}).get().value();
+        REQUIRE(sender_ids.size() == 2);
+
+        auto json = ravenna_node.to_boost_json().get();
+        REQUIRE(json.at("receivers").as_array().size() == 4);
+        REQUIRE(json.at("senders").as_array().size() == 4);
+
+        // None of the senders is created when one of the configurations is invalid
+        auto invalid_sender = sender2;
+        invalid_sender.destinations.clear();
+        REQUIRE_FALSE(ravenna_node.create_senders({sender1, invalid_sender}).get().has_value());
+        REQUIRE(ravenna_node.to_boost_json().get().at("senders").as_array().size() == 4);
+
+        // Also when the configuration is only invalid once the sender is enabled
+        auto invalid_enabled_sender = sender2;
+        invalid_enabled_sender.enabled = true;
+        invalid_enabled_sender.audio_format = {};
+        REQUIRE_FALSE(ravenna_node.create_senders({sender1, invalid_enabled_sender}).get().has_value());
+        REQUIRE(ravenna_node.to_boost_json().get().at("senders").as_array().size() == 4);
+
+        ravenna_node.remove_receivers({receiver_ids[0], receiver_ids[1], id1}).get();
+        ravenna_node.remove_senders(sender_ids).get();
+
+        json = ravenna_node.to_boost_json().get();
+        REQUIRE(json.at("receivers").as_array().size() == 1);
+        REQUIRE(json.at("senders").as_array().size() == 2);
+    }
+
+    SECTION("Bulk salvo of receivers") {
+        const auto num_receivers_before = ravenna_node.to_boost_json().get().at("receivers").as_array().size();
+
+        std::vector<rav::RavennaReceiver::Configuration> configurations(64, receiver1);
+        for (size_t i = 0; i < configurations.size(); ++i) {
+            configurations[i].session_name = fmt::format("Receiver {}", i + 3);
+        }
+
+        const auto receiver_ids = ravenna_node.create_receivers(configurations).get().value();
+        REQUIRE(receiver_ids.size() == configurations.size());
+        REQUIRE(std::set<rav::Id>(receiver_ids.begin(), receiver_ids.end()).size() == receiver_ids.size());
+        REQUIRE(
+            ravenna_node.to_boost_json().get().at("receivers").as_array().size() == num_receivers_before + configurations.size()
+        );
+
+        ravenna_node.remove_receivers(receiver_ids).get();
+        REQUIRE(ravenna_node.to_boost_json().get().at("receivers").as_array().size() == num_receivers_before);
+    }
+
+    SECTION("Metrics over HTTP") {
+        // The route is added after the catch-all route of the NMOS node, which must not shadow it
+        const auto response = http_get(node_config.api_port, "/metrics");
+        REQUIRE(response.result() == boost::beast::http::status::ok);
+        REQUIRE(response[boost::beast::http::field::content_type] == rav::metrics::PrometheusWriter::k_content_type);
+        REQUIRE(response.body() == ravenna_node.get_metrics().get());
+    }
+
+    SECTION("Trace over HTTP") {
+        RAV_TRACE_SET_THREAD_NAME("ravenna_node_test");
+        RAV_TRACE_MESSAGE("ravenna_node_test_message");
+
+        const auto response = http_get(node_config.api_port, "/trace");
+        REQUIRE(response.result() == boost::beast::http::status::ok);
+        REQUIRE(response[boost::beast::http::field::content_type] == "application/json");
+
+        const auto json = boost::json::parse(response.body());
+        const auto& events = json.at("traceEvents").as_array();
+        const auto contains_event = [&events](const std::string_view name) {
+            return std::any_of(events.begin(), events.end(), [name](const boost::json::value& event) {
+                return event.at("name") == "thread_name" ? event.at("args").at("name") == name : event.at("name") == name;
+            });
+        };
+        REQUIRE(contains_event("ravenna_node_test_message"));
+        REQUIRE(contains_event("ravenna_node_test"));
+        REQUIRE(contains_event("ravenna_node_maintenance"));  // Registered by the node
+    }
+
 #endif
 }
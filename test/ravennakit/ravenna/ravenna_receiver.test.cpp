@@ -140,6 +140,10 @@ TEST_CASE("rav::RavennaReceiver") {
         config.auto_update_sdp = true;
         config.enabled = false;
         config.delay_frames = 480;
+        config.adaptive_delay = true;
+        config.asrc = true;
+        config.shared_buffer_name = "receiver_1";
+        config.share_ingest = true;
         config.sdp =
             rav::sdp::parse_session_description("v=0\r\no=- 1731086923289383 0 IN IP4 192.168.4.8\r\n").value();
 
@@ -164,6 +168,10 @@ TEST_CASE("rav::RavennaReceiver") {
         config.auto_update_sdp = true;
         config.enabled = false;
         config.delay_frames = 480;
+        config.adaptive_delay = true;
+        config.asrc = true;
+        config.shared_buffer_name = "receiver_1";
+        config.share_ingest = true;
         config.sdp =
             rav::sdp::parse_session_description("v=0\r\no=- 1731086923289383 0 IN IP4 192.168.4.8\r\n").value();
 
@@ -201,5 +209,9 @@ void rav::test_ravenna_receiver_configuration_json(
     REQUIRE(json.at("auto_update_sdp") == config.auto_update_sdp);
     REQUIRE(json.at("enabled") == config.enabled);
     REQUIRE(json.at("delay_frames") == config.delay_frames);
+    REQUIRE(json.at("adaptive_delay") == config.adaptive_delay);
+    REQUIRE(json.at("asrc") == config.asrc);
+    REQUIRE(json.at("shared_buffer_name").as_string() == config.shared_buffer_name);
+    REQUIRE(json.at("share_ingest") == config.share_ingest);
     REQUIRE(json.at("sdp").as_string() == rav::sdp::to_string(config.sdp));
 }
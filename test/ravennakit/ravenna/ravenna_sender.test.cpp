@@ -28,8 +28,40 @@
 #include "../core/audio/audio_format.test.hpp"
 #include "ravenna_sender.test.hpp"
 
+#include "ravennakit/rtsp/rtsp_client.hpp"
+
 #include <catch2/catch_all.hpp>
 
+namespace {
+
+/**
+ * Sends a DESCRIBE request to the given path of the RTSP server and parses the SDP from the response.
+ */
+rav::sdp::SessionDescription
+describe(boost::asio::io_context& io_context, const rav::rtsp::Server& rtsp_server, const std::string& path) {
+    std::optional<std::string> sdp_text;
+    rav::rtsp::Client client(io_context);
+    client.on_connect_event = [&client, &path](const rav::rtsp::Connection::ConnectEvent&) {
+        client.async_describe(path);
+    };
+    client.on_response_event = [&sdp_text](const rav::rtsp::Connection::ResponseEvent& event) {
+        REQUIRE(event.rtsp_response.status_code == 200);
+        sdp_text = event.rtsp_response.data;
+    };
+    client.async_connect("127.0.0.1", rtsp_server.port());
+
+    io_context.restart();
+    while (!sdp_text.has_value() && io_context.run_one_for(std::chrono::seconds(5)) > 0) {}
+    REQUIRE(sdp_text.has_value());
+
+    auto sdp = rav::sdp::parse_session_description(*sdp_text);
+    REQUIRE(sdp.has_value());
+    REQUIRE(sdp->media_descriptions.size() == 1);
+    return std::move(*sdp);
+}
+
+}  // namespace
+
 TEST_CASE("rav::RavennaSender") {
     std::vector<rav::RavennaSender::Destination> destinations;
     destinations.push_back({0, boost::asio::ip::udp::endpoint(boost::asio::ip::make_address("239.0.0.1"), 5005), true});
@@ -56,6 +88,7 @@ TEST_CASE("rav::RavennaSender") {
     config.session_name = "Session name";
     config.ttl = 15;
     config.destinations = destinations;
+    config.shared_buffer_name = "sender_1";
 
     test_ravenna_sender_configuration_json(config, boost::json::value_from(config));
 
@@ -73,6 +106,89 @@ TEST_CASE("rav::RavennaSender") {
     rav::RavennaSender sender2(rtp_audio_sender, advertiser.get(), rtsp_server, ptp_instance, rav::Id {2}, 2, {});
     REQUIRE(sender2.restore_from_json(sender_json));
     rav::test_ravenna_sender_json(sender2, sender_json);
+
+    SECTION("DESCRIBE reflects every change to the SDP inputs") {
+        rav::RavennaSender enabled_sender(rtp_audio_sender, nullptr, rtsp_server, ptp_instance, rav::Id {3}, 3, {});
+        auto enabled_config = config;
+        enabled_config.enabled = true;
+        REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+
+        const auto path = fmt::format("/by-id/{}", rav::Id {3}.to_string());
+        const auto initial = describe(io_context, rtsp_server, path);
+        REQUIRE(initial.origin.session_id == "3");
+        REQUIRE(initial.session_name == "Session name");
+        REQUIRE(rav::sdp::to_string(initial).value() == rav::sdp::to_string(describe(io_context, rtsp_server, path)).value());
+
+        SECTION("Session name") {
+            enabled_config.session_name = "Other session name";
+            REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+            REQUIRE(describe(io_context, rtsp_server, path).session_name == "Other session name");
+        }
+
+        SECTION("Destination") {
+            enabled_config.destinations[0].endpoint.address(boost::asio::ip::make_address("239.0.0.3"));
+            REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.media_descriptions[0].connection_infos.at(0).address == "239.0.0.3");
+        }
+
+        SECTION("Payload type") {
+            enabled_config.payload_type = 99;
+            REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.media_descriptions[0].formats.at(0).payload_type == 99);
+        }
+
+        SECTION("Audio format") {
+            enabled_config.audio_format.sample_rate = 48000;
+            enabled_config.audio_format.num_channels = 8;
+            REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.media_descriptions[0].formats.at(0).clock_rate == 48000);
+            REQUIRE(sdp.media_descriptions[0].formats.at(0).num_channels == 8);
+        }
+
+        SECTION("Packet time") {
+            enabled_config.packet_time = rav::aes67::PacketTime::ms_4();
+            REQUIRE(enabled_sender.set_configuration(enabled_config).has_value());
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.media_descriptions[0].ptime != initial.media_descriptions[0].ptime);
+            REQUIRE(sdp.media_descriptions[0].ravenna_framecount == enabled_config.packet_time.framecount(44100));
+        }
+
+        SECTION("Session ID") {
+            auto json = enabled_sender.to_boost_json();
+            json["session_id"] = 42;
+            REQUIRE(enabled_sender.restore_from_json(json).has_value());
+            REQUIRE(describe(io_context, rtsp_server, path).origin.session_id == "42");
+        }
+
+        SECTION("PTP grandmaster") {
+            rav::ptp::ParentDs parent;
+            parent.grandmaster_identity.data = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+            enabled_sender.ptp_parent_changed(parent);
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.reference_clock.has_value());
+            REQUIRE(sdp.reference_clock->gmid_ == parent.grandmaster_identity.to_string());
+        }
+
+        SECTION("Network interface") {
+            const rav::NetworkInterface* network_interface = nullptr;
+            for (auto& it : rav::NetworkInterfaceList::get_system_interfaces().get_interfaces()) {
+                if (!it.get_first_ipv4_address().is_unspecified()) {
+                    network_interface = &it;
+                    break;
+                }
+            }
+            REQUIRE(network_interface != nullptr);
+
+            rav::NetworkInterfaceConfig network_interface_config;
+            network_interface_config.set_interface(rav::rank::primary, network_interface->get_identifier());
+            enabled_sender.set_network_interface_config(network_interface_config);
+            const auto sdp = describe(io_context, rtsp_server, path);
+            REQUIRE(sdp.origin.unicast_address == network_interface->get_first_ipv4_address().to_string());
+        }
+    }
 }
 
 void rav::test_ravenna_sender_json(const RavennaSender& sender, const boost::json::value& json) {
@@ -107,6 +223,7 @@ void rav::test_ravenna_sender_configuration_json(const RavennaSender::Configurat
     REQUIRE(json.at("ttl") == config.ttl);
     REQUIRE(json.at("payload_type") == config.payload_type);
     REQUIRE(json.at("enabled") == config.enabled);
+    REQUIRE(json.at("shared_buffer_name").as_string() == config.shared_buffer_name);
     test_ravenna_sender_destinations_json(config.destinations, json.at("destinations"));
     test_audio_format_json(config.audio_format, json.at("audio_format"));
     test_packet_time_json(config.packet_time, json.at("packet_time"));
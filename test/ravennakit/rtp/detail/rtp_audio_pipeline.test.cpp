@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_audio_pipeline.hpp"
+#include "ravennakit/core/audio/audio_buffer.hpp"
+#include "ravennakit/core/audio/audio_data.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <random>
+
+namespace {
+
+/// Checks that the pipeline produces exactly the same output as AudioData::convert.
+template<class T>
+void check_against_audio_data(const rav::AudioEncoding encoding, const uint32_t num_channels, const bool generic) {
+    constexpr size_t k_num_frames = 48;
+
+    const rav::AudioFormat format {
+        rav::AudioFormat::ByteOrder::be, encoding, rav::AudioFormat::ChannelOrdering::interleaved, 48000, num_channels
+    };
+    const auto pipeline = generic ? rav::rtp::AudioPipeline::get_generic(format) : rav::rtp::AudioPipeline::get(format);
+    REQUIRE(pipeline.is_valid());
+
+    std::mt19937 rng(num_channels);
+
+    // Decode
+    std::vector<uint8_t> payload(k_num_frames * format.bytes_per_frame());
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+    for (auto& byte : payload) {
+        byte = static_cast<uint8_t>(byte_distribution(rng));
+    }
+
+    rav::AudioBuffer<float> expected(num_channels, k_num_frames);
+    rav::AudioData::convert<T, rav::AudioData::ByteOrder::Be, rav::AudioData::Interleaving::Interleaved, float, rav::AudioData::ByteOrder::Ne>(
+        reinterpret_cast<const T*>(payload.data()), k_num_frames, num_channels, expected.data()
+    );
+
+    rav::AudioBuffer<float> decoded(num_channels, k_num_frames);
+    pipeline.decode(payload.data(), k_num_frames, num_channels, decoded.data());
+    REQUIRE(decoded == expected);
+
+    // Encode, including samples which need clamping
+    rav::AudioBuffer<float> samples(num_channels, k_num_frames);
+    std::uniform_real_distribution<float> sample_distribution(-1.2f, 1.2f);
+    for (uint32_t ch = 0; ch < num_channels; ++ch) {
+        for (size_t frame = 0; frame < k_num_frames; ++frame) {
+            samples[ch][frame] = sample_distribution(rng);
+        }
+    }
+
+    std::vector<uint8_t> expected_payload(payload.size());
+    rav::AudioData::convert<float, rav::AudioData::ByteOrder::Ne, T, rav::AudioData::ByteOrder::Be, rav::AudioData::Interleaving::Interleaved>(
+        samples.data(), k_num_frames, num_channels, reinterpret_cast<T*>(expected_payload.data()), 0, 0
+    );
+
+    std::vector<uint8_t> encoded(payload.size());
+    pipeline.encode(samples.data(), k_num_frames, num_channels, encoded.data());
+    REQUIRE(encoded == expected_payload);
+}
+
+}  // namespace
+
+TEST_CASE("rav::rtp::AudioPipeline") {
+    SECTION("Lookup") {
+        rav::AudioFormat format {rav::AudioFormat::ByteOrder::be, rav::AudioEncoding::pcm_s24, rav::AudioFormat::ChannelOrdering::interleaved, 48000, 8};
+        REQUIRE(rav::rtp::AudioPipeline::get(format).specialized);
+
+        format.sample_rate = 96000;
+        REQUIRE(rav::rtp::AudioPipeline::get(format).specialized);
+
+        format.num_channels = 5;
+        REQUIRE(rav::rtp::AudioPipeline::get(format).is_valid());
+        REQUIRE_FALSE(rav::rtp::AudioPipeline::get(format).specialized);
+
+        format.encoding = rav::AudioEncoding::pcm_f32;
+        REQUIRE_FALSE(rav::rtp::AudioPipeline::get(format).is_valid());
+    }
+
+    SECTION("L16 matches AudioData") {
+        for (const auto num_channels : {1u, 2u, 3u, 8u, 16u, 32u, 64u}) {
+            check_against_audio_data<int16_t>(rav::AudioEncoding::pcm_s16, num_channels, false);
+            check_against_audio_data<int16_t>(rav::AudioEncoding::pcm_s16, num_channels, true);
+        }
+    }
+
+    SECTION("L24 matches AudioData") {
+        for (const auto num_channels : {1u, 2u, 3u, 8u, 16u, 32u, 64u}) {
+            check_against_audio_data<rav::int24_t>(rav::AudioEncoding::pcm_s24, num_channels, false);
+            check_against_audio_data<rav::int24_t>(rav::AudioEncoding::pcm_s24, num_channels, true);
+        }
+    }
+}
@@ -23,8 +23,11 @@
  */
 
 #include "ravennakit/rtp/detail/rtp_audio_receiver.hpp"
+#include "ravennakit/core/audio/audio_buffer.hpp"
 #include "ravennakit/core/net/interfaces/network_interface_list.hpp"
+#include "ravennakit/core/random.hpp"
 #include "ravennakit/core/util/defer.hpp"
+#include "ravennakit/ptp/ptp_local_clock.hpp"
 
 #include <catch2/catch_all.hpp>
 
@@ -104,12 +107,14 @@ TEST_CASE("rav::rtp::Receiver") {
         auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
 
         // Sockets
-        REQUIRE(decltype(receiver->sockets)::capacity() == rav::rtp::AudioReceiver::k_max_num_sessions);
+        REQUIRE(receiver->sockets.capacity() == rav::rtp::AudioReceiver::k_max_num_sessions);
         REQUIRE(receiver->sockets.size() == rav::rtp::AudioReceiver::k_max_num_sessions);
 
         // Streams
-        REQUIRE(decltype(receiver->readers)::capacity() == rav::rtp::AudioReceiver::k_max_num_readers);
+        REQUIRE(receiver->readers.capacity() == rav::rtp::AudioReceiver::k_max_num_readers);
         REQUIRE(receiver->readers.size() == rav::rtp::AudioReceiver::k_max_num_readers);
+        REQUIRE(receiver->num_reader_slots_in_use == 0);
+        REQUIRE(receiver->num_socket_slots_in_use == 0);
     }
 
     SECTION("Binding a UDP socket to the any address") {
@@ -431,10 +436,11 @@ TEST_CASE("rav::rtp::Receiver") {
         SECTION("Swap interfaces") {
             std::swap(interface_addresses[0], interface_addresses[1]);
             REQUIRE(receiver->set_interfaces(interface_addresses));
+            // The groups which are no longer used are left before the new ones are joined
             REQUIRE(membership_changes.size() == 6);
             REQUIRE(membership_changes[2] == std::tuple(false, 5004, multicast_addr_pri, interface_address_pri));
-            REQUIRE(membership_changes[3] == std::tuple(true, 5004, multicast_addr_pri, interface_address_sec));
-            REQUIRE(membership_changes[4] == std::tuple(false, 5004, multicast_addr_sec, interface_address_sec));
+            REQUIRE(membership_changes[3] == std::tuple(false, 5004, multicast_addr_sec, interface_address_sec));
+            REQUIRE(membership_changes[4] == std::tuple(true, 5004, multicast_addr_pri, interface_address_sec));
             REQUIRE(membership_changes[5] == std::tuple(true, 5004, multicast_addr_sec, interface_address_pri));
         }
 
@@ -492,4 +498,1517 @@ TEST_CASE("rav::rtp::Receiver") {
 
         REQUIRE(receiver->remove_reader(rav::Id(1)));
     }
+
+    SECTION("Update reader") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        const auto multicast_addr_a = boost::asio::ip::make_address_v4("239.0.0.1");
+        const auto multicast_addr_b = boost::asio::ip::make_address_v4("239.0.0.2");
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+
+        rav::rtp::AudioReceiver::StreamInfo stream_a {
+            rav::rtp::Session {multicast_addr_a, 5004, 5005},
+            rav::rtp::Filter {multicast_addr_a},
+            48,
+        };
+
+        rav::rtp::AudioReceiver::StreamInfo stream_b {
+            rav::rtp::Session {multicast_addr_b, 5006, 5007},
+            rav::rtp::Filter {multicast_addr_b},
+            48,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream_a}};
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address};
+
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        const auto id = rav::Id(1);
+        REQUIRE(receiver->add_reader(id, parameters, interface_addresses));
+
+        rav::Defer remove_reader([&] {
+            REQUIRE(receiver->remove_reader(id));
+        });
+
+        REQUIRE(membership_changes.size() == 1);
+        REQUIRE(membership_changes[0] == std::tuple(true, 5004, multicast_addr_a, interface_address));
+
+        auto& reader = receiver->readers[0];
+        REQUIRE(reader.id == id);
+        reader.most_recent_ts = rav::WrappingUint32(1234);
+
+        SECTION("Swap session") {
+            parameters.streams[0] = stream_b;
+            REQUIRE(receiver->update_reader(id, parameters, interface_addresses));
+
+            REQUIRE(membership_changes.size() == 3);
+            REQUIRE(membership_changes[1] == std::tuple(false, 5004, multicast_addr_a, interface_address));
+            REQUIRE(membership_changes[2] == std::tuple(true, 5006, multicast_addr_b, interface_address));
+            REQUIRE(count_open_sockets(*receiver) == 1);
+            REQUIRE(reader.streams[0].session == stream_b.session);
+
+            // The buffered audio should be kept
+            REQUIRE(reader.most_recent_ts == rav::WrappingUint32(1234));
+
+            // The new session has an unrelated timestamp base. Packets of the previous session which are still in the fifo
+            // are dropped, and the reader restarts at the first packet of the new session.
+            auto& stream = reader.streams[0];
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.data_len = static_cast<uint16_t>(48 * audio_format.bytes_per_frame());
+            packet.timestamp = 1235;
+            packet.generation = stream.session_generation.load() - 1;
+            REQUIRE(stream.packets.push(packet));
+            packet.timestamp = 1'000'000;
+            packet.generation = stream.session_generation.load();
+            REQUIRE(stream.packets.push(packet));
+
+            std::vector<uint8_t> buffer(48 * audio_format.bytes_per_frame());
+            const auto ts = receiver->read_data_realtime(id, buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+            REQUIRE(ts == 1'000'000);
+            REQUIRE(reader.most_recent_ts == rav::WrappingUint32(1'000'047));
+            REQUIRE(reader.audio_thread_metrics.packets_too_late.get() == 0);
+        }
+
+        SECTION("Add a redundant session") {
+            parameters.streams[1] = stream_b;
+            REQUIRE(receiver->update_reader(id, parameters, {interface_address, interface_address}));
+
+            REQUIRE(membership_changes.size() == 2);
+            REQUIRE(membership_changes[1] == std::tuple(true, 5006, multicast_addr_b, interface_address));
+            REQUIRE(count_open_sockets(*receiver) == 2);
+            REQUIRE(reader.most_recent_ts == rav::WrappingUint32(1234));
+
+            // The timeline continues with the first session
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.data_len = static_cast<uint16_t>(48 * audio_format.bytes_per_frame());
+            packet.timestamp = 1235;
+            packet.generation = reader.streams[0].session_generation.load();
+            REQUIRE(reader.streams[0].packets.push(packet));
+
+            std::vector<uint8_t> buffer(48 * audio_format.bytes_per_frame());
+            std::ignore = receiver->read_data_realtime(id, buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+            REQUIRE(reader.most_recent_ts == rav::WrappingUint32(1282));
+        }
+
+        SECTION("Unchanged parameters") {
+            REQUIRE(receiver->update_reader(id, parameters, interface_addresses));
+            REQUIRE(membership_changes.size() == 1);
+        }
+
+        SECTION("A different audio format can't be updated in place") {
+            auto other = parameters;
+            other.audio_format.sample_rate = 44100;
+            REQUIRE_FALSE(receiver->update_reader(id, other, interface_addresses));
+        }
+
+        SECTION("A different packet time can't be updated in place") {
+            auto other = parameters;
+            other.streams[0].packet_time_frames = 6;
+            REQUIRE_FALSE(receiver->update_reader(id, other, interface_addresses));
+            REQUIRE(membership_changes.size() == 1);
+        }
+
+        SECTION("An unknown reader can't be updated") {
+            REQUIRE_FALSE(receiver->update_reader(rav::Id(2), parameters, interface_addresses));
+        }
+    }
+
+    SECTION("Update readers") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        const auto multicast_addr_a = boost::asio::ip::make_address_v4("239.0.0.1");
+        const auto multicast_addr_b = boost::asio::ip::make_address_v4("239.0.0.2");
+        const auto multicast_addr_c = boost::asio::ip::make_address_v4("239.0.0.3");
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address};
+
+        const auto make_parameters = [&](const boost::asio::ip::address_v4& address) {
+            rav::rtp::AudioReceiver::StreamInfo stream {
+                rav::rtp::Session {address, 5004, 5005},
+                rav::rtp::Filter {address},
+                48,
+            };
+            return rav::rtp::AudioReceiver::ReaderParameters {audio_format, {stream}};
+        };
+
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        const auto id_1 = rav::Id(1);
+        const auto id_2 = rav::Id(2);
+        REQUIRE(receiver->add_reader(id_1, make_parameters(multicast_addr_a), interface_addresses));
+        REQUIRE(receiver->add_reader(id_2, make_parameters(multicast_addr_b), interface_addresses));
+        REQUIRE(membership_changes.size() == 2);
+        receiver->readers[0].most_recent_ts = rav::WrappingUint32(1234);
+
+        SECTION("Swapping the groups of two readers doesn't leave or join") {
+            const auto results = receiver->update_readers({
+                {id_1, make_parameters(multicast_addr_b), interface_addresses},
+                {id_2, make_parameters(multicast_addr_a), interface_addresses},
+            });
+            REQUIRE(results == std::vector<bool> {true, true});
+            REQUIRE(membership_changes.size() == 2);
+            REQUIRE(receiver->readers[0].streams[0].session.connection_address == multicast_addr_b);
+            REQUIRE(receiver->readers[1].streams[0].session.connection_address == multicast_addr_a);
+            REQUIRE(receiver->readers[0].most_recent_ts == rav::WrappingUint32(1234));
+            REQUIRE(count_open_sockets(*receiver) == 1);
+        }
+
+        SECTION("Only unused groups are left and only new groups are joined") {
+            const auto results = receiver->update_readers({
+                {id_1, make_parameters(multicast_addr_b), interface_addresses},
+                {id_2, make_parameters(multicast_addr_c), interface_addresses},
+            });
+            REQUIRE(results == std::vector<bool> {true, true});
+            REQUIRE(membership_changes.size() == 4);
+            REQUIRE(membership_changes[2] == std::tuple(false, 5004, multicast_addr_a, interface_address));
+            REQUIRE(membership_changes[3] == std::tuple(true, 5004, multicast_addr_c, interface_address));
+        }
+
+        SECTION("Updates which can't be applied in place are skipped") {
+            auto other = make_parameters(multicast_addr_c);
+            other.audio_format.sample_rate = 44100;
+            const auto results = receiver->update_readers({
+                {id_1, other, interface_addresses},
+                {id_2, make_parameters(multicast_addr_c), interface_addresses},
+                {rav::Id(3), make_parameters(multicast_addr_c), interface_addresses},
+            });
+            REQUIRE(results == std::vector<bool> {false, true, false});
+            REQUIRE(receiver->readers[0].streams[0].session.connection_address == multicast_addr_a);
+            REQUIRE(receiver->readers[1].streams[0].session.connection_address == multicast_addr_c);
+        }
+
+        SECTION("Collected updates are applied on commit") {
+            receiver->begin_reader_updates();
+            REQUIRE(receiver->update_reader(id_1, make_parameters(multicast_addr_c), interface_addresses));
+            REQUIRE(receiver->update_reader(id_1, make_parameters(multicast_addr_b), interface_addresses));
+            REQUIRE(receiver->update_reader(id_2, make_parameters(multicast_addr_a), interface_addresses));
+
+            // The check happens right away, the update later
+            auto other = make_parameters(multicast_addr_c);
+            other.audio_format.sample_rate = 44100;
+            REQUIRE_FALSE(receiver->update_reader(id_2, other, interface_addresses));
+            REQUIRE(receiver->readers[0].streams[0].session.connection_address == multicast_addr_a);
+
+            REQUIRE(receiver->commit_reader_updates());
+            REQUIRE(membership_changes.size() == 2);
+            REQUIRE(receiver->readers[0].streams[0].session.connection_address == multicast_addr_b);
+            REQUIRE(receiver->readers[1].streams[0].session.connection_address == multicast_addr_a);
+            REQUIRE_FALSE(receiver->commit_reader_updates());
+        }
+
+        SECTION("Removing a reader drops its collected update") {
+            receiver->begin_reader_updates();
+            REQUIRE(receiver->update_reader(id_1, make_parameters(multicast_addr_c), interface_addresses));
+            REQUIRE(receiver->remove_reader(id_1));
+            REQUIRE(receiver->commit_reader_updates());
+            REQUIRE(membership_changes.size() == 3);
+            REQUIRE(membership_changes[2] == std::tuple(false, 5004, multicast_addr_a, interface_address));
+        }
+
+        SECTION("Readers added and removed during a batch join and leave on commit") {
+            receiver->begin_reader_updates();
+            REQUIRE(receiver->remove_reader(id_1));
+            REQUIRE(receiver->add_reader(rav::Id(3), make_parameters(multicast_addr_a), interface_addresses));
+            REQUIRE(receiver->add_reader(rav::Id(4), make_parameters(multicast_addr_c), interface_addresses));
+            REQUIRE(receiver->add_reader(rav::Id(5), make_parameters(multicast_addr_c), interface_addresses));
+            REQUIRE(count_valid_readers(*receiver) == 4);
+            REQUIRE(membership_changes.size() == 2);
+
+            // Group a moved from reader 1 to reader 3, group c is joined once for readers 4 and 5
+            REQUIRE(receiver->commit_reader_updates());
+            REQUIRE(membership_changes.size() == 3);
+            REQUIRE(membership_changes[2] == std::tuple(true, 5004, multicast_addr_c, interface_address));
+
+            receiver->begin_reader_updates();
+            REQUIRE(receiver->remove_reader(rav::Id(3)));
+            REQUIRE(receiver->remove_reader(rav::Id(4)));
+            REQUIRE(receiver->remove_reader(rav::Id(5)));
+            REQUIRE(receiver->commit_reader_updates());
+            REQUIRE(membership_changes.size() == 5);
+            REQUIRE(membership_changes[3] == std::tuple(false, 5004, multicast_addr_a, interface_address));
+            REQUIRE(membership_changes[4] == std::tuple(false, 5004, multicast_addr_c, interface_address));
+        }
+
+        SECTION("The socket of a port stays open until the batch is committed") {
+            receiver->begin_reader_updates();
+            REQUIRE(receiver->remove_reader(id_1));
+            REQUIRE(receiver->remove_reader(id_2));
+            REQUIRE(count_open_sockets(*receiver) == 1);
+            REQUIRE(membership_changes.size() == 2);
+            REQUIRE(receiver->commit_reader_updates());
+            REQUIRE(count_open_sockets(*receiver) == 0);
+            REQUIRE(membership_changes.size() == 4);
+        }
+
+        std::ignore = receiver->remove_reader(id_1);
+        std::ignore = receiver->remove_reader(id_2);
+        REQUIRE(count_open_sockets(*receiver) == 0);
+    }
+
+    SECTION("Provision the maximum number of readers in a batch") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address};
+
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        // Every reader gets its own group and port, and with that its own socket
+        const auto make_parameters = [&](const size_t index) {
+            const boost::asio::ip::address_v4 address(0xef010001 + static_cast<uint32_t>(index));  // 239.1.0.1 and up
+            const auto port = static_cast<uint16_t>(5004 + index * 2);
+            rav::rtp::AudioReceiver::StreamInfo stream {
+                rav::rtp::Session {address, port, static_cast<uint16_t>(port + 1)},
+                rav::rtp::Filter {address},
+                48,
+            };
+            return rav::rtp::AudioReceiver::ReaderParameters {audio_format, {stream}};
+        };
+
+        constexpr size_t k_num_readers = rav::rtp::AudioReceiver::k_max_num_readers;
+        STATIC_REQUIRE(k_num_readers >= 256);
+
+        receiver->begin_reader_updates();
+        for (size_t i = 0; i < k_num_readers; ++i) {
+            REQUIRE(receiver->add_reader(rav::Id(i + 1), make_parameters(i), interface_addresses));
+        }
+        REQUIRE_FALSE(receiver->add_reader(rav::Id(k_num_readers + 1), make_parameters(0), interface_addresses));
+        REQUIRE(membership_changes.empty());
+        REQUIRE(receiver->commit_reader_updates());
+
+        REQUIRE(count_valid_readers(*receiver) == k_num_readers);
+        REQUIRE(count_open_sockets(*receiver) == k_num_readers);
+        REQUIRE(membership_changes.size() == k_num_readers);
+        REQUIRE(receiver->num_reader_slots_in_use == k_num_readers);
+        REQUIRE(receiver->num_socket_slots_in_use == k_num_readers);
+
+        // Releasing the last slots shrinks the range which the network and audio threads visit
+        REQUIRE(receiver->remove_reader(rav::Id(k_num_readers)));
+        REQUIRE(receiver->num_reader_slots_in_use == k_num_readers - 1);
+        REQUIRE(receiver->num_socket_slots_in_use == k_num_readers - 1);
+
+        receiver->begin_reader_updates();
+        for (size_t i = 0; i < k_num_readers - 1; ++i) {
+            REQUIRE(receiver->remove_reader(rav::Id(i + 1)));
+        }
+        REQUIRE(receiver->commit_reader_updates());
+
+        REQUIRE(count_valid_readers(*receiver) == 0);
+        REQUIRE(count_open_sockets(*receiver) == 0);
+        REQUIRE(membership_changes.size() == k_num_readers * 2);
+        REQUIRE(receiver->num_reader_slots_in_use == 0);
+        REQUIRE(receiver->num_socket_slots_in_use == 0);
+    }
+
+    SECTION("Update many readers in one salvo") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address};
+
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        const auto group_address = [](const size_t index) {
+            return boost::asio::ip::address_v4(0xef010001 + static_cast<uint32_t>(index));  // 239.1.0.1 and up
+        };
+
+        const auto make_parameters = [&](const size_t group_index) {
+            const auto address = group_address(group_index);
+            rav::rtp::AudioReceiver::StreamInfo stream {
+                rav::rtp::Session {address, 5004, 5005},
+                rav::rtp::Filter {address},
+                48,
+            };
+            return rav::rtp::AudioReceiver::ReaderParameters {audio_format, {stream}};
+        };
+
+        constexpr size_t k_num_readers = 64;
+        for (size_t i = 0; i < k_num_readers; ++i) {
+            REQUIRE(receiver->add_reader(rav::Id(i + 1), make_parameters(i), interface_addresses));
+            receiver->readers[i].most_recent_ts = rav::WrappingUint32(static_cast<uint32_t>(i));
+        }
+        REQUIRE(membership_changes.size() == k_num_readers);
+
+        // Every reader moves to the group of the next one, and the last one to a new group
+        std::vector<rav::rtp::AudioReceiver::ReaderUpdate> updates;
+        for (size_t i = 0; i < k_num_readers; ++i) {
+            updates.push_back({rav::Id(i + 1), make_parameters(i + 1), interface_addresses});
+        }
+        const auto results = receiver->update_readers(updates);
+        REQUIRE(results == std::vector<bool>(k_num_readers, true));
+
+        // Only the group which is no longer used is left and only the new group is joined
+        REQUIRE(membership_changes.size() == k_num_readers + 2);
+        REQUIRE(membership_changes[k_num_readers] == std::tuple(false, 5004, group_address(0), interface_address));
+        REQUIRE(membership_changes[k_num_readers + 1] == std::tuple(true, 5004, group_address(k_num_readers), interface_address));
+
+        // The readers were updated in place
+        for (size_t i = 0; i < k_num_readers; ++i) {
+            REQUIRE(receiver->readers[i].id == rav::Id(i + 1));
+            REQUIRE(receiver->readers[i].streams[0].session.connection_address == group_address(i + 1));
+            REQUIRE(receiver->readers[i].most_recent_ts == rav::WrappingUint32(static_cast<uint32_t>(i)));
+        }
+        REQUIRE(count_open_sockets(*receiver) == 1);
+
+        for (size_t i = 0; i < k_num_readers; ++i) {
+            REQUIRE(receiver->remove_reader(rav::Id(i + 1)));
+        }
+        REQUIRE(membership_changes.size() == k_num_readers * 2 + 2);
+    }
+
+    SECTION("Shards") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        REQUIRE(receiver->get_num_shards() == 1);
+        REQUIRE_FALSE(receiver->set_num_shards(0));
+        REQUIRE_FALSE(receiver->set_num_shards(rav::rtp::AudioReceiver::k_max_num_shards + 1));
+        REQUIRE(receiver->set_num_shards(2));
+        REQUIRE(receiver->get_num_shards() == 2);
+
+        const auto multicast_addr_a = boost::asio::ip::make_address_v4("239.0.0.1");
+        const auto multicast_addr_b = boost::asio::ip::make_address_v4("239.0.0.2");
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address, interface_address};
+
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        const rav::rtp::AudioReceiver::StreamInfo stream_a {
+            rav::rtp::Session {multicast_addr_a, 5004, 5005},
+            rav::rtp::Filter {multicast_addr_a},
+            48,
+        };
+
+        const rav::rtp::AudioReceiver::StreamInfo stream_b {
+            rav::rtp::Session {multicast_addr_b, 5006, 5007},
+            rav::rtp::Filter {multicast_addr_b},
+            48,
+        };
+
+        auto find_reader = [&](const rav::Id id) -> rav::rtp::AudioReceiver::Reader& {
+            for (auto& reader : receiver->readers) {
+                if (reader.id == id) {
+                    return reader;
+                }
+            }
+            FAIL("Reader not found");
+            return receiver->readers[0];
+        };
+
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream_a}}, interface_addresses));
+        REQUIRE(receiver->add_reader(rav::Id(2), {audio_format, {stream_b}}, interface_addresses));
+
+        rav::Defer remove_readers([&] {
+            std::ignore = receiver->remove_reader(rav::Id(1));
+            std::ignore = receiver->remove_reader(rav::Id(2));
+            std::ignore = receiver->remove_reader(rav::Id(3));
+            REQUIRE(count_open_sockets(*receiver) == 0);
+        });
+
+        // The readers are distributed over the shards
+        REQUIRE(find_reader(rav::Id(1)).shard == 0);
+        REQUIRE(find_reader(rav::Id(2)).shard == 1);
+
+        for (auto& socket : receiver->sockets) {
+            if (socket.port == 5004) {
+                REQUIRE(socket.shard == 0);
+            } else if (socket.port == 5006) {
+                REQUIRE(socket.shard == 1);
+            }
+        }
+
+        REQUIRE_FALSE(receiver->set_num_shards(1));
+
+        SECTION("A reader sharing a port ends up in the shard of that port") {
+            REQUIRE(receiver->add_reader(rav::Id(3), {audio_format, {stream_b}}, interface_addresses));
+            REQUIRE(find_reader(rav::Id(3)).shard == 1);
+            REQUIRE(count_open_sockets(*receiver) == 2);
+        }
+
+        SECTION("A reader can't use ports which are read by different shards") {
+            REQUIRE_FALSE(receiver->add_reader(rav::Id(3), {audio_format, {stream_a, stream_b}}, interface_addresses));
+        }
+
+        SECTION("A reader can't be updated in place to a port of another shard") {
+            REQUIRE_FALSE(receiver->update_reader(rav::Id(2), {audio_format, {stream_a}}, interface_addresses));
+            REQUIRE(find_reader(rav::Id(2)).streams[0].session == stream_b.session);
+        }
+
+        SECTION("Reading a shard doesn't touch the readers of other shards") {
+            receiver->read_incoming_packets(0);
+            receiver->read_incoming_packets(1);
+            receiver->read_incoming_packets();
+            REQUIRE(receiver->shards[0].last_time_maintenance > 0);
+            REQUIRE(receiver->shards[1].last_time_maintenance > 0);
+        }
+    }
+
+    SECTION("AF_PACKET rings") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        if (!receiver->enable_packet_mmap({})) {
+            WARN("AF_PACKET is not available, which requires CAP_NET_RAW");
+            return;
+        }
+        REQUIRE_FALSE(receiver->enable_io_uring({}));
+
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        const rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {loopback, 5104, 5105},
+            rav::rtp::Filter {loopback},
+            48,
+        };
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream}}, {loopback}));
+        REQUIRE_FALSE(receiver->enable_packet_mmap({}));
+
+        auto& entry = receiver->shards[0].packet_mmap[0];
+        REQUIRE(entry.ring != nullptr);
+        REQUIRE(entry.interface == loopback);
+
+        // A minimal RTP packet: version 2, sequence number 1, timestamp 48 and 4 bytes of payload
+        const std::array<uint8_t, 16> packet {0x80, 98, 0, 1, 0, 0, 0, 48, 0, 0, 0, 1, 1, 2, 3, 4};
+        boost::asio::ip::udp::socket tx(io_context, {loopback, 0});
+        tx.send_to(boost::asio::buffer(packet), {loopback, 5104});
+
+        auto& reader_stream = receiver->readers[0].streams[0];
+        for (int i = 0; i < 1000 && reader_stream.network_thread_metrics.packets_received.get() == 0; ++i) {
+            receiver->read_incoming_packets();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(reader_stream.network_thread_metrics.packets_received.get() == 1);
+
+        auto received = reader_stream.packets.pop();
+        REQUIRE(received.has_value());
+        REQUIRE(received->seq == 1);
+        REQUIRE(received->timestamp == 48);
+        REQUIRE(received->data_len == 4);
+
+        // The socket only joins the multicast groups and drops the datagrams
+        for (auto& ctx : receiver->sockets) {
+            if (ctx.port == 5104) {
+                REQUIRE(ctx.socket.available() == 0);
+            }
+        }
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(entry.ring == nullptr);
+    }
+
+    SECTION("Shared buffer") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        const rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {loopback, 5204, 5205},
+            rav::rtp::Filter {loopback},
+            2,
+        };
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream}}, {loopback}));
+
+        const auto name = "ravennakit_test_" + std::to_string(rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+        std::shared_ptr buffer = rav::rtp::SharedAudioBuffer::create(name, audio_format, 480);
+        REQUIRE(buffer != nullptr);
+
+        auto other_format = audio_format;
+        other_format.num_channels = 1;
+        std::shared_ptr mono_buffer = rav::rtp::SharedAudioBuffer::create(name + "_mono", other_format, 480);
+        REQUIRE(mono_buffer != nullptr);
+
+        REQUIRE_FALSE(receiver->set_shared_buffer(rav::Id(2), buffer));
+        REQUIRE_FALSE(receiver->set_shared_buffer(rav::Id(1), mono_buffer));
+        REQUIRE(receiver->set_shared_buffer(rav::Id(1), buffer));
+
+        // Another process opens the buffer by name
+        auto client = rav::rtp::SharedAudioBuffer::open(name);
+        REQUIRE(client != nullptr);
+        REQUIRE_FALSE(client->get_write_position().has_value());
+
+        // Version 2, sequence number 1, timestamp 48 and 2 frames of payload
+        const std::array<uint8_t, 24> packet {0x80, 98, 0, 1, 0, 0, 0, 48, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        boost::asio::ip::udp::socket tx(io_context, {loopback, 0});
+        tx.send_to(boost::asio::buffer(packet), {loopback, 5204});
+
+        // The payload is exported by the network thread, without anybody reading from the receiver
+        for (int i = 0; i < 1000 && !client->get_write_position().has_value(); ++i) {
+            receiver->read_incoming_packets();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const auto position = client->get_write_position();
+        REQUIRE(position.has_value());
+        REQUIRE(position->end_timestamp == 50);
+
+        std::array<uint8_t, 12> frames {};
+        REQUIRE(client->read(48, frames.data(), frames.size()));
+        REQUIRE(frames == std::array<uint8_t, 12> {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+        // Stops exporting
+        REQUIRE(receiver->set_shared_buffer(rav::Id(1), nullptr));
+        REQUIRE(receiver->readers[0].shared_buffer == nullptr);
+
+        REQUIRE(receiver->set_shared_buffer(rav::Id(1), buffer));
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(buffer.use_count() == 1);
+    }
+
+    SECTION("Cost accounting") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        const rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {loopback, 5214, 5215},
+            rav::rtp::Filter {loopback},
+            2,
+        };
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream}}, {loopback}));
+
+        REQUIRE_FALSE(receiver->get_reader_cost(rav::Id(2)).has_value());
+        auto cost = receiver->get_reader_cost(rav::Id(1));
+        REQUIRE(cost.has_value());
+        REQUIRE(cost->read.count == 0);
+        REQUIRE(cost->maintenance.count == 0);
+        REQUIRE(cost->packet_processing[0].count == 0);
+
+        // Polling without packets is not accounted to the socket
+        receiver->read_incoming_packets();
+        REQUIRE(receiver->sockets[0].receive_cost.get_snapshot().count == 0);
+
+        // Version 2, sequence number 1, timestamp 48 and 2 frames of payload
+        const std::array<uint8_t, 24> packet {0x80, 98, 0, 1, 0, 0, 0, 48, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        boost::asio::ip::udp::socket tx(io_context, {loopback, 0});
+        tx.send_to(boost::asio::buffer(packet), {loopback, 5214});
+
+        for (int i = 0; i < 1000 && receiver->get_reader_cost(rav::Id(1))->packet_processing[0].count == 0; ++i) {
+            receiver->read_incoming_packets();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(receiver->get_reader_cost(rav::Id(1))->packet_processing[0].count == 1);
+        REQUIRE(receiver->sockets[0].receive_cost.get_snapshot().count == 1);
+
+        std::array<uint8_t, 12> frames {};
+        std::ignore = receiver->read_data_realtime(rav::Id(1), frames.data(), frames.size(), 48, std::nullopt);
+        cost = receiver->get_reader_cost(rav::Id(1));
+        REQUIRE(cost->read.count == 1);
+        REQUIRE(cost->maintenance.count == 1);
+        REQUIRE(cost->read.total_ns >= cost->maintenance.total_ns);
+
+        rav::metrics::PrometheusWriter writer;
+        receiver->collect_metrics(writer);
+        const auto output = writer.to_string();
+        REQUIRE(output.find("rav_rtp_reader_read_cost_us_count{reader=\"1\"} 1") != std::string::npos);
+        REQUIRE(output.find("rav_rtp_socket_receive_cost_us_count{port=\"5214\"} 1") != std::string::npos);
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE_FALSE(receiver->get_reader_cost(rav::Id(1)).has_value());
+    }
+
+    SECTION("Payloads bigger than the packet buffer are discarded") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        const rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {loopback, 5224, 5225},
+            rav::rtp::Filter {loopback},
+            48,
+        };
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream}}, {loopback}));
+
+        // Version 2, sequence number 1, timestamp 48 and one byte more payload than fits a packet buffer
+        std::vector<uint8_t> packet(12 + rav::aes67::constants::k_max_payload + 1, 0);
+        packet[0] = 0x80;
+        packet[1] = 98;
+        packet[3] = 1;
+        packet[7] = 48;
+        packet[11] = 1;
+        boost::asio::ip::udp::socket tx(io_context, {loopback, 0});
+        tx.send_to(boost::asio::buffer(packet), {loopback, 5224});
+
+        auto& metrics = receiver->readers[0].streams[0].network_thread_metrics;
+        for (int i = 0; i < 1000 && metrics.packets_discarded.get() == 0; ++i) {
+            receiver->read_incoming_packets();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(metrics.packets_discarded.get() == 1);
+        REQUIRE(metrics.packets_received.get() == 0);
+        REQUIRE_FALSE(receiver->readers[0].streams[0].packets.pop().has_value());
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+    }
+
+    SECTION("Payloads bigger than the packet buffer are discarded when receiving through io_uring") {
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        if (!receiver->enable_io_uring({})) {
+            WARN("io_uring is not available");
+            return;
+        }
+
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        const rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {loopback, 5226, 5227},
+            rav::rtp::Filter {loopback},
+            48,
+        };
+        REQUIRE(receiver->add_reader(rav::Id(1), {audio_format, {stream}}, {loopback}));
+
+        // Version 2, sequence number 1, timestamp 48 and one byte more payload than fits a packet buffer
+        std::vector<uint8_t> packet(12 + rav::aes67::constants::k_max_payload + 1, 0);
+        packet[0] = 0x80;
+        packet[1] = 98;
+        packet[3] = 1;
+        packet[7] = 48;
+        packet[11] = 1;
+        boost::asio::ip::udp::socket tx(io_context, {loopback, 0});
+        tx.send_to(boost::asio::buffer(packet), {loopback, 5226});
+
+        auto& metrics = receiver->readers[0].streams[0].network_thread_metrics;
+        for (int i = 0; i < 1000 && metrics.packets_discarded.get() == 0; ++i) {
+            receiver->read_incoming_packets();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(metrics.packets_discarded.get() == 1);
+        REQUIRE(metrics.packets_received.get() == 0);
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+    }
+
+    SECTION("Memory arena") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        std::shared_ptr<rav::MemoryArena> arena = rav::MemoryArena::create({4 * 1024 * 1024});
+        REQUIRE(arena != nullptr);
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+        REQUIRE(receiver->set_memory_arena(arena));
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            48,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+
+        const auto bytes_allocated = arena->bytes_allocated();
+        REQUIRE(bytes_allocated > 0);
+
+        auto& reader = receiver->readers.at(0);
+        REQUIRE(arena->owns(reader.read_audio_data_buffer.data()));
+        REQUIRE_FALSE(receiver->set_memory_arena(nullptr));
+
+        // Adding the reader again reuses the memory it held on to
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(arena->bytes_allocated() == bytes_allocated);
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+
+        // Without an arena the buffers are released and allocated from the heap
+        REQUIRE(receiver->set_memory_arena(nullptr));
+        REQUIRE(arena->bytes_allocated() == 0);
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(arena->bytes_allocated() == 0);
+        REQUIRE_FALSE(arena->owns(reader.read_audio_data_buffer.data()));
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+    }
+
+    SECTION("Adaptive delay") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+
+        REQUIRE_FALSE(receiver->set_adaptive_delay(rav::Id(2), std::nullopt));
+        REQUIRE_FALSE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {10, 5, 0}));
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {0, 200, 0}));
+
+        auto& reader = receiver->readers.at(0);
+        REQUIRE(reader.id == rav::Id(1));
+
+        // Simulate 10 packets arriving (frames 0 to 479)
+        for (uint16_t i = 0; i < 10; ++i) {
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.timestamp = i * k_packet_time_frames;
+            packet.seq = i;
+            packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+            REQUIRE(reader.streams.at(0).packets.push(packet));
+        }
+
+        std::vector<uint8_t> buffer(k_packet_time_frames * audio_format.bytes_per_frame());
+
+        // The delay (479 - 47 = 432) is above the maximum, so the reader should skip a frame on every read
+        auto ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+        REQUIRE(ts == 0);
+        REQUIRE(receiver->get_delay(rav::Id(1)) == 432);
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+        REQUIRE(ts == 49);
+        REQUIRE(receiver->get_delay(rav::Id(1)) == 383);
+        REQUIRE(reader.audio_thread_metrics.frames_skipped.get() == 2);
+        REQUIRE(reader.audio_thread_metrics.frames_repeated.get() == 0);
+
+        // The delay (479 - 145 = 334) is below the minimum, so the reader should repeat a frame on every read
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {400, 480, 0}));
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+        REQUIRE(ts == 98);
+        REQUIRE(receiver->get_delay(rav::Id(1)) == 334);
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), std::nullopt, std::nullopt);
+        REQUIRE(ts == 145);
+        REQUIRE(reader.audio_thread_metrics.frames_repeated.get() == 2);
+
+        // Reading beyond the most recent frame fails, regardless of the delay
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {0, 480, 0}));
+        std::vector<uint8_t> large_buffer(400 * audio_format.bytes_per_frame());
+        REQUIRE_FALSE(receiver->read_data_realtime(rav::Id(1), large_buffer.data(), large_buffer.size(), std::nullopt, std::nullopt));
+
+        // Reading at an explicit timestamp keeps the frames skipped so far (479 - 239 = 240 is above the maximum)
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {0, 200, 0}));
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), 192, std::nullopt);
+        REQUIRE(ts == 192);
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), 240, std::nullopt);
+        REQUIRE(ts == 241);
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), 288, std::nullopt);
+        REQUIRE(ts == 290);
+
+        // A buffer smaller than a frame reads nothing, and a single frame is never repeated, since that would stall the reader
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {400, 480, 0}));
+        const auto frames_repeated = reader.audio_thread_metrics.frames_repeated.get();
+        const auto bytes_per_frame = audio_format.bytes_per_frame();
+        REQUIRE_FALSE(receiver->read_data_realtime(rav::Id(1), buffer.data(), bytes_per_frame - 1, std::nullopt, std::nullopt));
+        const auto first = receiver->read_data_realtime(rav::Id(1), buffer.data(), bytes_per_frame, std::nullopt, std::nullopt);
+        REQUIRE(first.has_value());
+        ts = receiver->read_data_realtime(rav::Id(1), buffer.data(), bytes_per_frame, std::nullopt, std::nullopt);
+        REQUIRE(ts == *first + 1);
+        REQUIRE(reader.audio_thread_metrics.frames_repeated.get() == frames_repeated);
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+    }
+
+    SECTION("Adaptive delay keeps the decoded output continuous") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {0, 200, 0}));
+
+        auto& reader = receiver->readers.at(0);
+
+        // A ramp which rises by 1/32768 per frame (256 in 24 bit)
+        for (uint16_t i = 0; i < 10; ++i) {
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.timestamp = i * k_packet_time_frames;
+            packet.seq = i;
+            packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+            for (uint32_t frame = 0; frame < k_packet_time_frames; ++frame) {
+                const auto value = (packet.timestamp + frame) * 256;
+                for (uint32_t ch = 0; ch < audio_format.num_channels; ++ch) {
+                    auto* sample = packet.payload.data() + (frame * audio_format.num_channels + ch) * 3;
+                    sample[0] = static_cast<uint8_t>(value >> 16);
+                    sample[1] = static_cast<uint8_t>(value >> 8);
+                    sample[2] = static_cast<uint8_t>(value);
+                }
+            }
+            REQUIRE(reader.streams.at(0).packets.push(packet));
+        }
+
+        rav::AudioBuffer<float> buffer(audio_format.num_channels, k_packet_time_frames);
+        std::vector<std::vector<float>> output(audio_format.num_channels);
+        const auto read = [&] {
+            REQUIRE(receiver->read_audio_data_realtime(rav::Id(1), buffer, std::nullopt, std::nullopt));
+            for (size_t ch = 0; ch < buffer.num_channels(); ++ch) {
+                output[ch].insert(output[ch].end(), buffer[ch], buffer[ch] + buffer.num_frames());
+            }
+        };
+
+        // Skips a frame on every read, like in the section above
+        read();
+        read();
+        REQUIRE(reader.audio_thread_metrics.frames_skipped.get() == 2);
+
+        // Repeats a frame on every read
+        REQUIRE(receiver->set_adaptive_delay(rav::Id(1), rav::rtp::AudioReceiver::AdaptiveDelayParameters {400, 480, 0}));
+        read();
+        read();
+        REQUIRE(reader.audio_thread_metrics.frames_repeated.get() == 2);
+
+        // Without spreading, the ramp would stall for a frame at a repeat and jump two frames at a skip. Spread over the
+        // read, every step stays within a frame plus or minus 1/48.
+        constexpr auto k_step = 1.0f / 32768.0f;
+        for (auto& samples : output) {
+            REQUIRE(samples.front() == 0.0f);
+            for (size_t i = 1; i < samples.size(); ++i) {
+                const auto step = (samples[i] - samples[i - 1]) / k_step;
+                REQUIRE(step > 47.0f / 48.0f - 1e-3f);
+                REQUIRE(step < 49.0f / 48.0f + 1e-3f);
+            }
+        }
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+    }
+
+    SECTION("Shared ingest") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        parameters.share_ingest = true;
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(receiver->add_reader(rav::Id(2), parameters, interface_addresses));
+        REQUIRE(receiver->add_reader(rav::Id(3), parameters, interface_addresses));
+
+        auto other_parameters = parameters;
+        other_parameters.streams[0].session.rtp_port = 5006;
+        REQUIRE(receiver->add_reader(rav::Id(4), other_parameters, interface_addresses));
+
+        // Sharing is opt-in
+        auto unshared_parameters = parameters;
+        unshared_parameters.share_ingest = false;
+        REQUIRE(receiver->add_reader(rav::Id(5), unshared_parameters, interface_addresses));
+
+        // The readers of the same stream tap the first one, which is the only one holding a receive buffer
+        auto& source = receiver->readers.at(0);
+        auto& tap = receiver->readers.at(1);
+        REQUIRE(tap.source == &source);
+        REQUIRE(receiver->readers.at(2).source == &source);
+        REQUIRE(receiver->readers.at(3).source == nullptr);
+        REQUIRE(receiver->readers.at(4).source == nullptr);
+        REQUIRE(source.receive_buffer.get_capacity_frames() > 0);
+        REQUIRE(tap.receive_buffer.get_capacity_frames() == 0);
+        REQUIRE(multicast_group_membership_changes.size() == 2);
+
+        // Pushes packets of which every byte is the sequence number plus one
+        uint16_t seq = 0;
+        const auto push_packets = [&](rav::rtp::AudioReceiver::Reader& reader, const uint16_t num_packets) {
+            for (uint16_t i = 0; i < num_packets; ++i, ++seq) {
+                rav::rtp::AudioReceiver::PacketBuffer packet {};
+                packet.timestamp = seq * k_packet_time_frames;
+                packet.seq = seq;
+                packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+                std::fill_n(packet.payload.begin(), packet.data_len, static_cast<uint8_t>(seq + 1));
+                REQUIRE(reader.streams.at(0).packets.push(packet));
+            }
+        };
+
+        std::vector<uint8_t> buffer(k_packet_time_frames * audio_format.bytes_per_frame());
+        const auto filled_with = [&buffer](const uint8_t value) {
+            return std::all_of(buffer.begin(), buffer.end(), [value](const uint8_t byte) {
+                return byte == value;
+            });
+        };
+
+        // A tap has no data until its source received packets
+        REQUIRE_FALSE(receiver->read_data_realtime(rav::Id(2), buffer.data(), buffer.size(), std::nullopt, std::nullopt));
+
+        push_packets(source, 10);
+
+        REQUIRE(receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+        REQUIRE(filled_with(1));
+
+        // The first read of a tap starts at the most recent packet, like the first read of a reader starts at its first
+        // packet. Reading doesn't clear the data, so every reader can read at its own position.
+        REQUIRE(receiver->read_data_realtime(rav::Id(2), buffer.data(), buffer.size(), std::nullopt, std::nullopt) == 432);
+        REQUIRE(filled_with(10));
+        REQUIRE(receiver->read_data_realtime(rav::Id(3), buffer.data(), buffer.size(), 0, std::nullopt) == 432);
+        REQUIRE(receiver->read_data_realtime(rav::Id(3), buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+        REQUIRE(filled_with(1));
+
+        // The streams of a tap are those of its source
+        source.streams.at(0).state = rav::rtp::AudioReceiver::StreamState::receiving;
+        REQUIRE(receiver->get_stream_state(rav::Id(2), 0) == rav::rtp::AudioReceiver::StreamState::receiving);
+
+        // A packet which is late for the source is still received for the taps which read further behind
+        push_packets(source, 1);
+        rav::rtp::AudioReceiver::PacketBuffer late_packet {};
+        late_packet.timestamp = k_packet_time_frames;
+        late_packet.seq = 1;
+        late_packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+        std::fill_n(late_packet.payload.begin(), late_packet.data_len, uint8_t {0x7f});
+        REQUIRE(source.streams.at(0).packets.push(late_packet));
+        REQUIRE(receiver->read_data_realtime(rav::Id(1), buffer.data(), buffer.size(), 96, std::nullopt) == 96);
+        REQUIRE(source.audio_thread_metrics.packets_too_late.get() == 1);
+        REQUIRE(receiver->read_data_realtime(rav::Id(2), buffer.data(), buffer.size(), 48, std::nullopt) == 48);
+        REQUIRE(filled_with(0x7f));
+
+        // The streams of readers which share their ingest can't be changed in place
+        REQUIRE_FALSE(receiver->update_reader(rav::Id(2), other_parameters, interface_addresses));
+        REQUIRE_FALSE(receiver->update_reader(rav::Id(1), other_parameters, interface_addresses));
+        REQUIRE(receiver->update_reader(rav::Id(2), parameters, interface_addresses));
+        REQUIRE_FALSE(receiver->update_reader(rav::Id(5), parameters, interface_addresses));
+
+        // When the source is removed, the first tap takes over its ingest and the other taps follow
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(tap.source == nullptr);
+        REQUIRE(receiver->readers.at(2).source == &tap);
+        REQUIRE(tap.receive_buffer.get_capacity_frames() > 0);
+        REQUIRE(multicast_group_membership_changes.size() == 2);
+
+        REQUIRE(receiver->read_data_realtime(rav::Id(2), buffer.data(), buffer.size(), 144, std::nullopt) == 144);
+        REQUIRE(filled_with(4));
+        push_packets(tap, 1);
+        REQUIRE(receiver->read_data_realtime(rav::Id(3), buffer.data(), buffer.size(), 528, std::nullopt) == 528);
+        REQUIRE(filled_with(12));
+
+        // A packet which is late for a reader without taps is dropped
+        auto& unshared = receiver->readers.at(4);
+        REQUIRE_FALSE(unshared.has_taps.load());
+        REQUIRE(tap.has_taps.load());
+        push_packets(unshared, 3);
+        REQUIRE(receiver->read_data_realtime(rav::Id(5), buffer.data(), buffer.size(), 576, std::nullopt) == 576);
+        REQUIRE(receiver->read_data_realtime(rav::Id(5), buffer.data(), buffer.size(), 624, std::nullopt) == 624);
+        late_packet.timestamp = 576;
+        late_packet.seq = 12;
+        REQUIRE(unshared.streams.at(0).packets.push(late_packet));
+        REQUIRE(receiver->read_data_realtime(rav::Id(5), buffer.data(), buffer.size(), 672, std::nullopt) == 672);
+        REQUIRE(unshared.audio_thread_metrics.packets_too_late.get() == 1);
+        REQUIRE(receiver->read_data_realtime(rav::Id(5), buffer.data(), buffer.size(), 576, std::nullopt) == 576);
+        REQUIRE(filled_with(13));
+
+        REQUIRE(receiver->remove_reader(rav::Id(2)));
+        REQUIRE(receiver->readers.at(2).source == nullptr);
+        REQUIRE_FALSE(receiver->readers.at(2).has_taps.load());
+        REQUIRE(receiver->remove_reader(rav::Id(3)));
+        REQUIRE(receiver->remove_reader(rav::Id(4)));
+        REQUIRE(receiver->remove_reader(rav::Id(5)));
+        REQUIRE(multicast_group_membership_changes.size() == 4);
+    }
+
+    SECTION("Readers of the same stream can be read from different threads") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+        constexpr uint16_t k_num_packets = 1000;
+        constexpr uint16_t k_max_packets_ahead = 8;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        // Without share_ingest every reader moves its own packets, so the readers don't touch each other's state
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(receiver->add_reader(rav::Id(2), parameters, interface_addresses));
+        REQUIRE(receiver->readers.at(0).source == nullptr);
+        REQUIRE(receiver->readers.at(1).source == nullptr);
+
+        struct ReadResult {
+            std::atomic<uint16_t> num_reads {0};
+            uint16_t num_mismatches {0};
+        };
+        std::array<ReadResult, 2> results;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+        // Every byte of a packet is its sequence number plus one, and every read covers exactly one packet
+        const auto read = [&](const rav::Id id, ReadResult& result) {
+            std::vector<uint8_t> buffer(k_packet_time_frames * audio_format.bytes_per_frame());
+            while (result.num_reads < k_num_packets && std::chrono::steady_clock::now() < deadline) {
+                const auto ts = receiver->read_data_realtime(id, buffer.data(), buffer.size(), std::nullopt, 0);
+                if (!ts.has_value()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto expected = static_cast<uint8_t>(*ts / k_packet_time_frames + 1);
+                if (!std::all_of(buffer.begin(), buffer.end(), [expected](const uint8_t byte) {
+                        return byte == expected;
+                    })) {
+                    ++result.num_mismatches;
+                }
+                ++result.num_reads;
+            }
+        };
+
+        std::thread first_thread(read, rav::Id(1), std::ref(results[0]));
+        std::thread second_thread(read, rav::Id(2), std::ref(results[1]));
+
+        for (uint16_t seq = 0; seq < k_num_packets && std::chrono::steady_clock::now() < deadline;) {
+            // Don't run further ahead than the receive buffers can hold
+            if (seq >= k_max_packets_ahead + std::min(results[0].num_reads.load(), results[1].num_reads.load())) {
+                std::this_thread::yield();
+                continue;
+            }
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.timestamp = static_cast<uint32_t>(seq) * k_packet_time_frames;
+            packet.seq = seq;
+            packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+            std::fill_n(packet.payload.begin(), packet.data_len, static_cast<uint8_t>(seq + 1));
+            for (size_t i = 0; i < 2; ++i) {
+                REQUIRE(receiver->readers.at(i).streams.at(0).packets.push(packet));
+            }
+            ++seq;
+        }
+
+        first_thread.join();
+        second_thread.join();
+
+        for (auto& result : results) {
+            REQUIRE(result.num_reads == k_num_packets);
+            REQUIRE(result.num_mismatches == 0);
+        }
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(receiver->remove_reader(rav::Id(2)));
+    }
+
+    SECTION("Readers which share their ingest can be read from different threads") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+        constexpr uint16_t k_num_packets = 1000;
+        constexpr uint16_t k_max_packets_ahead = 8;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        // Both threads move the packets of the source into its receive buffer, and read from it
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        parameters.share_ingest = true;
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+        REQUIRE(receiver->add_reader(rav::Id(2), parameters, interface_addresses));
+        auto& source = receiver->readers.at(0);
+        REQUIRE(receiver->readers.at(1).source == &source);
+
+        // Every byte of a packet is its sequence number plus one, and every read covers exactly one packet
+        const auto push_packet = [&](const uint16_t seq) {
+            rav::rtp::AudioReceiver::PacketBuffer packet {};
+            packet.timestamp = static_cast<uint32_t>(seq) * k_packet_time_frames;
+            packet.seq = seq;
+            packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+            std::fill_n(packet.payload.begin(), packet.data_len, static_cast<uint8_t>(seq + 1));
+            REQUIRE(source.streams.at(0).packets.push(packet));
+        };
+
+        struct ReadResult {
+            std::atomic<uint16_t> num_reads {0};
+            uint16_t num_mismatches {0};
+        };
+        std::array<ReadResult, 2> results;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+        // Places the read position of the tap at the first packet, which is the most recent one at that point
+        std::vector<uint8_t> first_buffer(k_packet_time_frames * audio_format.bytes_per_frame());
+        push_packet(0);
+        REQUIRE(receiver->read_data_realtime(rav::Id(1), first_buffer.data(), first_buffer.size(), std::nullopt, 0) == 0);
+        REQUIRE(receiver->read_data_realtime(rav::Id(2), first_buffer.data(), first_buffer.size(), std::nullopt, 0) == 0);
+        results[0].num_reads = 1;
+        results[1].num_reads = 1;
+
+        const auto read = [&](const rav::Id id, ReadResult& result) {
+            std::vector<uint8_t> buffer(k_packet_time_frames * audio_format.bytes_per_frame());
+            while (result.num_reads < k_num_packets && std::chrono::steady_clock::now() < deadline) {
+                const auto ts = receiver->read_data_realtime(id, buffer.data(), buffer.size(), std::nullopt, 0);
+                if (!ts.has_value()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto expected = static_cast<uint8_t>(*ts / k_packet_time_frames + 1);
+                if (*ts != static_cast<uint32_t>(result.num_reads) * k_packet_time_frames
+                    || !std::all_of(buffer.begin(), buffer.end(), [expected](const uint8_t byte) {
+                           return byte == expected;
+                       })) {
+                    ++result.num_mismatches;
+                }
+                ++result.num_reads;
+            }
+        };
+
+        std::thread source_thread(read, rav::Id(1), std::ref(results[0]));
+        std::thread tap_thread(read, rav::Id(2), std::ref(results[1]));
+
+        for (uint16_t seq = 1; seq < k_num_packets && std::chrono::steady_clock::now() < deadline;) {
+            // Don't run further ahead than the receive buffer can hold
+            if (seq >= k_max_packets_ahead + std::min(results[0].num_reads.load(), results[1].num_reads.load())) {
+                std::this_thread::yield();
+                continue;
+            }
+            push_packet(seq);
+            ++seq;
+        }
+
+        source_thread.join();
+        tap_thread.join();
+
+        for (auto& result : results) {
+            REQUIRE(result.num_reads == k_num_packets);
+            REQUIRE(result.num_mismatches == 0);
+        }
+        REQUIRE(source.audio_thread_metrics.packets_too_late.get() == 0);
+
+        // A read which overlaps with a read on another thread fails instead of waiting for it
+        {
+            const auto guard = source.ingest_lock.try_lock_exclusive();
+            REQUIRE(guard);
+            const auto& tap_metrics = receiver->readers.at(1).audio_thread_metrics;
+            const auto reads_without_data = tap_metrics.reads_without_data.get();
+            REQUIRE_FALSE(receiver->read_data_realtime(rav::Id(2), first_buffer.data(), first_buffer.size(), std::nullopt, 0));
+            REQUIRE(tap_metrics.reads_without_data.get() == reads_without_data + 1);
+        }
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE(receiver->remove_reader(rav::Id(2)));
+    }
+
+    SECTION("ASRC") {
+        const auto multicast_addr = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto src_addr = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {boost::asio::ip::address_v4::loopback()};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector multicast_group_membership_changes;
+        setup_receiver_multicast_hooks(*receiver, multicast_group_membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+
+        rav::rtp::AudioReceiver::StreamInfo stream {
+            rav::rtp::Session {multicast_addr, 5004, 5005},
+            rav::rtp::Filter {multicast_addr, src_addr, rav::sdp::FilterMode::include},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters {audio_format, {stream}};
+        REQUIRE(receiver->add_reader(rav::Id(1), parameters, interface_addresses));
+
+        REQUIRE_FALSE(receiver->set_asrc(rav::Id(2), std::nullopt));
+        REQUIRE_FALSE(receiver->set_asrc(rav::Id(1), rav::rtp::AudioReceiver::AsrcParameters {10, 1000}));
+        REQUIRE_FALSE(receiver->set_asrc(rav::Id(1), rav::rtp::AudioReceiver::AsrcParameters {200, 0}));
+        REQUIRE_FALSE(receiver->set_asrc(rav::Id(1), rav::rtp::AudioReceiver::AsrcParameters {200, 20'000}));
+        REQUIRE(receiver->set_asrc(rav::Id(1), rav::rtp::AudioReceiver::AsrcParameters {200, 1000}));
+
+        auto& reader = receiver->readers.at(0);
+        REQUIRE(reader.id == rav::Id(1));
+
+        // Pushes packets with every sample set to 0.5
+        uint16_t seq = 0;
+        const auto push_packets = [&](const uint16_t num_packets) {
+            for (uint16_t i = 0; i < num_packets; ++i, ++seq) {
+                rav::rtp::AudioReceiver::PacketBuffer packet {};
+                packet.timestamp = seq * k_packet_time_frames;
+                packet.seq = seq;
+                packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+                for (size_t j = 0; j < packet.data_len; j += 3) {
+                    packet.payload[j] = 0x40;
+                }
+                REQUIRE(reader.streams.at(0).packets.push(packet));
+            }
+        };
+
+        rav::AudioBuffer<float> buffer(audio_format.num_channels, k_packet_time_frames);
+
+        // Nothing received yet
+        REQUIRE_FALSE(receiver->read_audio_data_realtime(rav::Id(1), buffer, std::nullopt, std::nullopt));
+
+        // The first read places the read position at the target fill level, which includes the history of the resampler
+        push_packets(10);
+        constexpr auto k_history = rav::AudioResampler::k_num_taps - 1;
+        auto ts = receiver->read_audio_data_realtime(rav::Id(1), buffer, 0, std::nullopt);  // The timestamp is ignored
+        REQUIRE(ts == 480 - 200 + rav::AudioResampler::k_num_taps / 2 - 1);
+        auto status = receiver->get_asrc_status(rav::Id(1));
+        REQUIRE(status.has_value());
+        REQUIRE_THAT(status->fill_frames, Catch::Matchers::WithinAbs(200.0, 1e-9));
+        REQUIRE_THAT(status->ratio_deviation_ppm, Catch::Matchers::WithinAbs(0.0, 1e-9));
+        REQUIRE(status->num_resets == 0);
+        REQUIRE(reader.next_ts_to_read == rav::WrappingUint32(480 - 200 + k_history + k_packet_time_frames));
+
+        // Below the target the stream is consumed slower
+        ts = receiver->read_audio_data_realtime(rav::Id(1), buffer, std::nullopt, std::nullopt);
+        REQUIRE(ts == 480 - 200 + rav::AudioResampler::k_num_taps / 2 - 1 + k_packet_time_frames);
+        status = receiver->get_asrc_status(rav::Id(1));
+        REQUIRE_THAT(status->fill_frames, Catch::Matchers::WithinAbs(152.0, 1e-9));
+        REQUIRE(status->ratio_deviation_ppm < 0.0);
+
+        // Above the target the stream is consumed faster
+        push_packets(5);
+        REQUIRE(receiver->read_audio_data_realtime(rav::Id(1), buffer, std::nullopt, std::nullopt));
+        status = receiver->get_asrc_status(rav::Id(1));
+        REQUIRE_THAT(status->fill_frames, Catch::Matchers::WithinAbs(344.0, 0.1));
+        REQUIRE(status->ratio_deviation_ppm > 0.0);
+        REQUIRE(status->num_resets == 0);
+
+        // Past the history of the resampler the signal comes through unchanged
+        for (size_t ch = 0; ch < buffer.num_channels(); ++ch) {
+            for (size_t i = 0; i < buffer.num_frames(); ++i) {
+                REQUIRE_THAT(buffer[ch][i], Catch::Matchers::WithinAbs(0.5, 1e-4));
+            }
+        }
+
+        // An underrun resets the fill level
+        rav::AudioBuffer<float> large_buffer(audio_format.num_channels, 1024);
+        REQUIRE(receiver->read_audio_data_realtime(rav::Id(1), large_buffer, std::nullopt, std::nullopt));
+        status = receiver->get_asrc_status(rav::Id(1));
+        REQUIRE(status->num_resets == 1);
+        REQUIRE_THAT(status->fill_frames, Catch::Matchers::WithinAbs(200.0, 1e-9));
+
+        // A different channel count can't be read
+        rav::AudioBuffer<float> mono_buffer(1, k_packet_time_frames);
+        REQUIRE_FALSE(receiver->read_audio_data_realtime(rav::Id(1), mono_buffer, std::nullopt, std::nullopt));
+
+        // Without the ASRC the timestamp is used again
+        REQUIRE(receiver->set_asrc(rav::Id(1), std::nullopt));
+        REQUIRE(receiver->read_audio_data_realtime(rav::Id(1), buffer, 96, std::nullopt) == 96);
+
+        REQUIRE(receiver->remove_reader(rav::Id(1)));
+        REQUIRE_FALSE(receiver->get_asrc_status(rav::Id(1)).has_value());
+    }
+
+    SECTION("Scheduled update") {
+        const auto multicast_addr_a = boost::asio::ip::make_address_v4("239.1.2.3");
+        const auto multicast_addr_b = boost::asio::ip::make_address_v4("239.1.2.4");
+        const auto interface_address = boost::asio::ip::make_address_v4("192.168.1.1");
+        rav::rtp::AudioReceiver::ArrayOfAddresses interface_addresses {interface_address};
+
+        auto receiver = std::make_unique<rav::rtp::AudioReceiver>(io_context);
+        MulticastMembershipChangesVector membership_changes;
+        setup_receiver_multicast_hooks(*receiver, membership_changes);
+
+        constexpr uint16_t k_packet_time_frames = 48;
+        const auto id = rav::Id(1);
+
+        rav::rtp::AudioReceiver::StreamInfo stream_a {
+            rav::rtp::Session {multicast_addr_a, 5004, 5005},
+            rav::rtp::Filter {multicast_addr_a},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::StreamInfo stream_b {
+            rav::rtp::Session {multicast_addr_b, 5004, 5005},
+            rav::rtp::Filter {multicast_addr_b},
+            k_packet_time_frames,
+        };
+
+        rav::rtp::AudioReceiver::ReaderParameters parameters_a {audio_format, {stream_a}};
+        rav::rtp::AudioReceiver::ReaderParameters parameters_b {audio_format, {stream_b}};
+        REQUIRE(receiver->add_reader(id, parameters_a, interface_addresses));
+
+        // Fills the stream with packets of frames 0 to 479, with every byte set to given value
+        const auto push_packets = [&](rav::rtp::AudioReceiver::Reader& reader, const uint8_t value) {
+            for (uint16_t i = 0; i < 10; ++i) {
+                rav::rtp::AudioReceiver::PacketBuffer packet {};
+                packet.timestamp = i * k_packet_time_frames;
+                packet.seq = i;
+                packet.data_len = static_cast<uint16_t>(k_packet_time_frames * audio_format.bytes_per_frame());
+                std::fill_n(packet.payload.begin(), packet.data_len, value);
+                REQUIRE(reader.streams.at(0).packets.push(packet));
+            }
+        };
+
+        auto& current = receiver->readers.at(0);
+        auto& staged = receiver->readers.at(1);
+        push_packets(current, 0xaa);
+
+        const auto bytes_per_frame = audio_format.bytes_per_frame();
+        std::vector<uint8_t> buffer(k_packet_time_frames * bytes_per_frame);
+
+        SECTION("Switches at the activation timestamp") {
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 100));
+            REQUIRE(receiver->has_scheduled_update(id));
+            REQUIRE(staged.id == id);
+            REQUIRE(staged.activation == rav::rtp::AudioReceiver::Activation::staged);
+            REQUIRE(staged.streams[0].session == stream_b.session);
+            REQUIRE(membership_changes.size() == 2);
+            REQUIRE(membership_changes[1] == std::tuple(true, 5004, multicast_addr_b, interface_address));
+            push_packets(staged, 0xbb);
+
+            // The stats and state are those of the current slot
+            REQUIRE(receiver->get_stream_state(id, 0) == rav::rtp::AudioReceiver::StreamState::inactive);
+
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xaa; }));
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 48, std::nullopt) == 48);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xaa; }));
+            REQUIRE_FALSE(receiver->complete_scheduled_update(id).has_value());
+
+            // Frames 96 to 99 come from the current slot, frames 100 to 143 from the staged slot
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 96, std::nullopt) == 96);
+            const auto split = buffer.begin() + 4 * bytes_per_frame;
+            REQUIRE(std::all_of(buffer.begin(), split, [](auto b) { return b == 0xaa; }));
+            REQUIRE(std::all_of(split, buffer.end(), [](auto b) { return b == 0xbb; }));
+            REQUIRE(current.activation == rav::rtp::AudioReceiver::Activation::retired);
+            REQUIRE(staged.activation == rav::rtp::AudioReceiver::Activation::active);
+
+            // Reading continues from the new slot
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), std::nullopt, std::nullopt) == 144);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xbb; }));
+
+            REQUIRE(receiver->complete_scheduled_update(id) == 100);
+            REQUIRE_FALSE(receiver->has_scheduled_update(id));
+            REQUIRE_FALSE(current.id.is_valid());
+            REQUIRE(membership_changes.size() == 3);
+            REQUIRE(membership_changes[2] == std::tuple(false, 5004, multicast_addr_a, interface_address));
+            REQUIRE(count_valid_readers(*receiver) == 1);
+            REQUIRE(count_open_sockets(*receiver) == 1);
+        }
+
+        SECTION("The ASRC continues in the staged slot") {
+            REQUIRE(receiver->set_asrc(id, rav::rtp::AudioReceiver::AsrcParameters {200, 1000}));
+            rav::AudioBuffer<float> audio(audio_format.num_channels, k_packet_time_frames);
+            REQUIRE(receiver->read_audio_data_realtime(id, audio, std::nullopt, std::nullopt));
+            REQUIRE(current.next_ts_to_read == rav::WrappingUint32(359));
+
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 400));
+            push_packets(staged, 0xbb);
+
+            // The input of the second read (frames 359 to 406) contains the activation timestamp
+            REQUIRE(receiver->read_audio_data_realtime(id, audio, std::nullopt, std::nullopt));
+            REQUIRE(staged.activation == rav::rtp::AudioReceiver::Activation::active);
+            REQUIRE(staged.asrc.parameters.has_value());
+            REQUIRE(staged.asrc.primed);
+            REQUIRE_FALSE(current.asrc.parameters.has_value());
+
+            REQUIRE(receiver->read_audio_data_realtime(id, audio, std::nullopt, std::nullopt));
+            REQUIRE(receiver->get_asrc_status(id)->num_resets == 0);
+            REQUIRE(receiver->complete_scheduled_update(id) == 400);
+        }
+
+        SECTION("An activation timestamp in the past switches on the next read") {
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 10));
+            push_packets(staged, 0xbb);
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 48, std::nullopt) == 48);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xbb; }));
+            REQUIRE(receiver->complete_scheduled_update(id) == 48);
+        }
+
+        SECTION("A missing stream switches to silence") {
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 24));
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+            const auto split = buffer.begin() + 24 * bytes_per_frame;
+            REQUIRE(std::all_of(buffer.begin(), split, [](auto b) { return b == 0xaa; }));
+            REQUIRE(std::all_of(split, buffer.end(), [](auto b) { return b == 0; }));
+            REQUIRE(receiver->complete_scheduled_update(id) == 24);
+        }
+
+        SECTION("Cancel") {
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 100));
+            REQUIRE(receiver->cancel_scheduled_update(id));
+            REQUIRE_FALSE(receiver->has_scheduled_update(id));
+            REQUIRE_FALSE(staged.id.is_valid());
+            REQUIRE(membership_changes.size() == 3);
+            REQUIRE(membership_changes[2] == std::tuple(false, 5004, multicast_addr_b, interface_address));
+
+            // The current slot keeps being read past the activation timestamp
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 96, std::nullopt) == 96);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xaa; }));
+            REQUIRE(current.activation == rav::rtp::AudioReceiver::Activation::active);
+            REQUIRE_FALSE(receiver->cancel_scheduled_update(id));
+        }
+
+        SECTION("Rescheduling replaces the staged slot") {
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 100));
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, 200));
+            REQUIRE(count_valid_readers(*receiver) == 2);
+            push_packets(staged, 0xbb);
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 0, std::nullopt) == 0);
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), 96, std::nullopt) == 96);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xaa; }));
+        }
+
+        SECTION("Switches at a PTP activation time") {
+            // A clock stepped to an arbitrary point in the timescale of the grand master
+            rav::ptp::LocalClock clock;
+            clock.step(-1'234'567.0);
+
+            auto activation_time = clock.now();
+            activation_time.add_seconds(10.0);
+            const auto activation_timestamp = activation_time.to_rtp_timestamp32(audio_format.sample_rate);
+
+            REQUIRE(receiver->schedule_reader_update(id, parameters_b, interface_addresses, activation_timestamp));
+
+            // Packets from 96 frames before the activation time onwards
+            const auto base = activation_timestamp - 96;
+            current.streams.at(0).packets.pop_all();
+            for (auto [reader, value] : {std::pair {&current, 0xaa}, std::pair {&staged, 0xbb}}) {
+                for (uint32_t i = 0; i < 4; ++i) {
+                    rav::rtp::AudioReceiver::PacketBuffer packet {};
+                    packet.timestamp = base + i * k_packet_time_frames;
+                    packet.seq = static_cast<uint16_t>(i);
+                    packet.data_len = static_cast<uint16_t>(k_packet_time_frames * bytes_per_frame);
+                    std::fill_n(packet.payload.begin(), packet.data_len, static_cast<uint8_t>(value));
+                    REQUIRE(reader->streams.at(0).packets.push(packet));
+                }
+            }
+
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), base, std::nullopt) == base);
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), base + 48, std::nullopt) == base + 48);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xaa; }));
+            REQUIRE(receiver->read_data_realtime(id, buffer.data(), buffer.size(), base + 96, std::nullopt) == base + 96);
+            REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) { return b == 0xbb; }));
+
+            // The RTP timestamp of the switch maps back onto the requested activation time
+            const auto activated_at = receiver->complete_scheduled_update(id);
+            REQUIRE(activated_at == activation_timestamp);
+            const auto reconstructed = clock.now().from_rtp_timestamp32(*activated_at, audio_format.sample_rate);
+            REQUIRE(std::abs((reconstructed - activation_time).total_seconds_double()) < 1.0 / audio_format.sample_rate);
+        }
+
+        SECTION("A different audio format can't be scheduled") {
+            auto other = parameters_b;
+            other.audio_format.sample_rate = 44100;
+            REQUIRE_FALSE(receiver->schedule_reader_update(id, other, interface_addresses, 100));
+            REQUIRE_FALSE(receiver->schedule_reader_update(rav::Id(2), parameters_b, interface_addresses, 100));
+            REQUIRE(count_valid_readers(*receiver) == 1);
+        }
+
+        // Also releases the slots of a scheduled update
+        REQUIRE(receiver->remove_reader(id));
+        REQUIRE(count_valid_readers(*receiver) == 0);
+        REQUIRE(count_open_sockets(*receiver) == 0);
+    }
 }
@@ -0,0 +1,481 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_audio_sender.hpp"
+#include "ravennakit/core/random.hpp"
+#include "ravennakit/core/util/defer.hpp"
+#include "ravennakit/rtp/rtp_packet_view.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+struct ReceivedPacket {
+    uint8_t payload_type {};
+    uint16_t sequence_number {};
+    uint32_t timestamp {};
+    uint32_t ssrc {};
+};
+
+[[nodiscard]] std::vector<ReceivedPacket> receive_all(rav::udp_socket& socket) {
+    std::vector<ReceivedPacket> packets;
+    std::array<uint8_t, rav::aes67::constants::k_mtu> buffer {};
+    while (socket.available() > 0) {
+        rav::udp_endpoint sender_endpoint;
+        const auto size = socket.receive_from(boost::asio::buffer(buffer), sender_endpoint);
+        const rav::rtp::PacketView view(buffer.data(), size);
+        REQUIRE(view.validate());
+        packets.push_back({view.payload_type(), view.sequence_number(), view.timestamp(), view.ssrc()});
+    }
+    return packets;
+}
+
+}  // namespace
+
+TEST_CASE("rav::rtp::AudioSender") {
+    boost::asio::io_context io_context;
+
+    const rav::AudioFormat audio_format {
+        rav::AudioFormat::ByteOrder::be,
+        rav::AudioEncoding::pcm_s24,
+        rav::AudioFormat::ChannelOrdering::interleaved,
+        48000,
+        2,
+    };
+
+    constexpr uint32_t k_packet_time_frames = 48;
+
+    SECTION("Update writer") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx_a(io_context, rav::udp_endpoint(loopback, 0));
+        rav::udp_socket rx_b(io_context, rav::udp_endpoint(loopback, 0));
+
+        rav::rtp::AudioSender sender(io_context);
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx_a.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        const auto id = rav::Id(1);
+        REQUIRE(sender.add_writer(id, parameters, {}));
+
+        rav::Defer remove_writer([&] {
+            REQUIRE(sender.remove_writer(id));
+        });
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        uint32_t timestamp = 0;
+        auto send_packets = [&](const size_t num_packets) {
+            for (size_t i = 0; i < num_packets; ++i) {
+                REQUIRE(sender.send_data_realtime(id, rav::BufferView<const uint8_t>(audio.data(), audio.size()), timestamp));
+                timestamp += k_packet_time_frames;
+                sender.send_outgoing_packets();
+            }
+        };
+
+        send_packets(4);
+        const auto before = receive_all(rx_a);
+        REQUIRE(before.size() == 3);  // The last packet is sent once the next one is started
+        REQUIRE(before.back().payload_type == 98);
+
+        SECTION("Swap destination and payload type") {
+            parameters.destinations[0] = rav::udp_endpoint(loopback, rx_b.local_endpoint().port());
+            parameters.payload_type = 99;
+            parameters.ttl = 5;
+            REQUIRE(sender.update_writer(id, parameters, {}));
+
+            send_packets(4);
+            REQUIRE(receive_all(rx_a).empty());
+
+            const auto after = receive_all(rx_b);
+            REQUIRE(after.size() == 4);
+
+            // The stream continues where it left off
+            REQUIRE(after.front().ssrc == before.back().ssrc);
+            REQUIRE(after.front().sequence_number == static_cast<uint16_t>(before.back().sequence_number + 1));
+            REQUIRE(after.front().timestamp == before.back().timestamp + k_packet_time_frames);
+            REQUIRE(after.back().payload_type == 99);
+        }
+
+        SECTION("Scheduled update") {
+            // The packets from 192 on (the first packet starting at or after 190) use the new parameters
+            parameters.destinations[0] = rav::udp_endpoint(loopback, rx_b.local_endpoint().port());
+            parameters.payload_type = 99;
+            REQUIRE(sender.schedule_writer_update(id, parameters, {}, 190));
+            REQUIRE(sender.has_scheduled_update(id));
+            REQUIRE_FALSE(sender.complete_scheduled_update(id).has_value());
+
+            send_packets(4);
+            const auto old = receive_all(rx_a);
+            REQUIRE(old.size() == 1);
+            REQUIRE(old.front().timestamp == 144);
+            const auto after = receive_all(rx_b);
+            REQUIRE(after.size() == 3);
+            REQUIRE(after.front().timestamp == 192);
+            REQUIRE(after.front().payload_type == 99);
+            REQUIRE(after.front().sequence_number == static_cast<uint16_t>(old.front().sequence_number + 1));
+            REQUIRE(sender.complete_scheduled_update(id) == 192);
+            REQUIRE_FALSE(sender.has_scheduled_update(id));
+            REQUIRE_FALSE(sender.cancel_scheduled_update(id));
+        }
+
+        SECTION("Cancel a scheduled update") {
+            parameters.destinations[0] = rav::udp_endpoint(loopback, rx_b.local_endpoint().port());
+            REQUIRE(sender.schedule_writer_update(id, parameters, {}, 1000));
+            REQUIRE(sender.cancel_scheduled_update(id));
+            REQUIRE_FALSE(sender.has_scheduled_update(id));
+
+            send_packets(30);
+            REQUIRE(receive_all(rx_a).size() == 30);
+            REQUIRE(receive_all(rx_b).empty());
+        }
+
+        SECTION("A different audio format can't be updated in place") {
+            parameters.audio_format.sample_rate = 44100;
+            REQUIRE_FALSE(sender.update_writer(id, parameters, {}));
+            REQUIRE_FALSE(sender.schedule_writer_update(id, parameters, {}, 0));
+        }
+
+        SECTION("A different packet time can't be updated in place") {
+            parameters.packet_time_frames = 96;
+            REQUIRE_FALSE(sender.update_writer(id, parameters, {}));
+        }
+
+        SECTION("An unknown writer can't be updated") {
+            REQUIRE_FALSE(sender.update_writer(rav::Id(2), parameters, {}));
+        }
+    }
+    SECTION("Memory arena") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+
+        std::shared_ptr<rav::MemoryArena> arena = rav::MemoryArena::create({1024 * 1024});
+        REQUIRE(arena != nullptr);
+
+        rav::rtp::AudioSender sender(io_context);
+        REQUIRE(sender.set_memory_arena(arena));
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        REQUIRE(sender.add_writer(rav::Id(1), parameters, {}));
+
+        const auto bytes_allocated = arena->bytes_allocated();
+        REQUIRE(bytes_allocated > 0);
+        REQUIRE_FALSE(sender.set_memory_arena(nullptr));
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        for (uint32_t timestamp = 0; timestamp < 4 * k_packet_time_frames; timestamp += k_packet_time_frames) {
+            REQUIRE(sender.send_data_realtime(rav::Id(1), rav::BufferView<const uint8_t>(audio.data(), audio.size()), timestamp));
+        }
+        sender.send_outgoing_packets();
+
+        const auto packets = receive_all(rx);
+        REQUIRE(packets.size() == 3);
+        REQUIRE(packets[0].payload_type == 98);
+        REQUIRE(packets[2].timestamp == 2 * k_packet_time_frames);
+
+        // Adding the writer again reuses the memory of the arena
+        REQUIRE(sender.remove_writer(rav::Id(1)));
+        REQUIRE(sender.add_writer(rav::Id(1), parameters, {}));
+        REQUIRE(arena->bytes_allocated() == bytes_allocated);
+        REQUIRE(sender.remove_writer(rav::Id(1)));
+
+        REQUIRE(sender.set_memory_arena(nullptr));
+        REQUIRE(arena->bytes_allocated() == 0);
+    }
+
+    SECTION("Maximum number of writers") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+
+        auto sender = std::make_unique<rav::rtp::AudioSender>(io_context);
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        constexpr size_t k_num_writers = rav::rtp::AudioSender::k_max_num_writers;
+        STATIC_REQUIRE(k_num_writers >= 256);
+
+        for (size_t i = 0; i < k_num_writers; ++i) {
+            REQUIRE(sender->add_writer(rav::Id(i + 1), parameters, {}));
+        }
+        REQUIRE_FALSE(sender->add_writer(rav::Id(k_num_writers + 1), parameters, {}));
+        REQUIRE(sender->num_writer_slots_in_use == k_num_writers);
+
+        // The last writer is reached by both the audio and the network thread
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        const auto last_id = rav::Id(k_num_writers);
+        REQUIRE(sender->send_data_realtime(last_id, rav::BufferView<const uint8_t>(audio.data(), audio.size()), 0));
+        REQUIRE(sender->send_data_realtime(last_id, rav::BufferView<const uint8_t>(audio.data(), audio.size()), k_packet_time_frames));
+        sender->send_outgoing_packets();
+        REQUIRE(receive_all(rx).size() == 1);
+
+        // Releasing the last slot shrinks the range which the network and audio threads visit
+        REQUIRE(sender->remove_writer(last_id));
+        REQUIRE(sender->num_writer_slots_in_use == k_num_writers - 1);
+        REQUIRE(sender->remove_writer(rav::Id(1)));
+        REQUIRE(sender->num_writer_slots_in_use == k_num_writers - 1);
+
+        for (size_t i = 1; i < k_num_writers - 1; ++i) {
+            REQUIRE(sender->remove_writer(rav::Id(i + 1)));
+        }
+        REQUIRE(sender->num_writer_slots_in_use == 0);
+    }
+
+    SECTION("Shards") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx_a(io_context, rav::udp_endpoint(loopback, 0));
+        rav::udp_socket rx_b(io_context, rav::udp_endpoint(loopback, 0));
+
+        rav::rtp::AudioSender sender(io_context);
+        REQUIRE(sender.get_num_shards() == 1);
+        REQUIRE_FALSE(sender.set_num_shards(0));
+        REQUIRE_FALSE(sender.set_num_shards(rav::rtp::AudioSender::k_max_num_shards + 1));
+        REQUIRE(sender.set_num_shards(2));
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx_a.local_endpoint().port());
+        REQUIRE(sender.add_writer(rav::Id(1), parameters, {}));
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx_b.local_endpoint().port());
+        REQUIRE(sender.add_writer(rav::Id(2), parameters, {}));
+
+        rav::Defer remove_writers([&] {
+            REQUIRE(sender.remove_writer(rav::Id(1)));
+            REQUIRE(sender.remove_writer(rav::Id(2)));
+        });
+
+        REQUIRE_FALSE(sender.set_num_shards(1));
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        for (uint32_t timestamp = 0; timestamp < 4 * k_packet_time_frames; timestamp += k_packet_time_frames) {
+            const rav::BufferView<const uint8_t> buffer(audio.data(), audio.size());
+            REQUIRE(sender.send_data_realtime(rav::Id(1), buffer, timestamp));
+            REQUIRE(sender.send_data_realtime(rav::Id(2), buffer, timestamp));
+        }
+
+        // Each shard only sends the packets of its own writers
+        sender.send_outgoing_packets(1);
+        REQUIRE(receive_all(rx_a).empty());
+        REQUIRE(receive_all(rx_b).size() == 3);
+
+        sender.send_outgoing_packets(0);
+        REQUIRE(receive_all(rx_a).size() == 3);
+        REQUIRE(receive_all(rx_b).empty());
+    }
+
+    SECTION("Byte order") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+
+        rav::rtp::AudioSender sender(io_context);
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        REQUIRE(sender.add_writer(rav::Id(1), parameters, {}));
+
+        rav::Defer remove_writer([&] {
+            REQUIRE(sender.remove_writer(rav::Id(1)));
+        });
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        for (size_t i = 0; i < audio.size(); ++i) {
+            audio[i] = static_cast<uint8_t>(i);
+        }
+
+        const rav::BufferView<const uint8_t> buffer(audio.data(), audio.size());
+        REQUIRE(sender.send_data_realtime(rav::Id(1), buffer, 0, rav::AudioFormat::ByteOrder::le));
+        REQUIRE(sender.send_data_realtime(rav::Id(1), buffer, k_packet_time_frames, rav::AudioFormat::ByteOrder::be));
+        REQUIRE(sender.send_data_realtime(rav::Id(1), buffer, 2 * k_packet_time_frames, rav::AudioFormat::ByteOrder::be));
+        sender.send_outgoing_packets();
+
+        std::array<uint8_t, rav::aes67::constants::k_mtu> packet {};
+        rav::udp_endpoint sender_endpoint;
+
+        // Little endian data is swapped into the big endian stream
+        auto size = rx.receive_from(boost::asio::buffer(packet), sender_endpoint);
+        rav::rtp::PacketView view(packet.data(), size);
+        REQUIRE(view.validate());
+        auto payload = view.payload_data();
+        REQUIRE(payload.size() == audio.size());
+        REQUIRE(payload[0] == audio[2]);
+        REQUIRE(payload[1] == audio[1]);
+        REQUIRE(payload[2] == audio[0]);
+        REQUIRE(payload[3] == audio[5]);
+
+        // Data in the byte order of the stream is sent as is
+        size = rx.receive_from(boost::asio::buffer(packet), sender_endpoint);
+        view = rav::rtp::PacketView(packet.data(), size);
+        REQUIRE(view.validate());
+        payload = view.payload_data();
+        REQUIRE(std::equal(payload.data(), payload.data() + payload.size(), audio.begin(), audio.end()));
+    }
+
+    SECTION("Shared buffer") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+
+        rav::rtp::AudioSender sender(io_context);
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        const auto id = rav::Id(1);
+        REQUIRE(sender.add_writer(id, parameters, {}));
+
+        rav::Defer remove_writer([&] {
+            REQUIRE(sender.remove_writer(id));
+        });
+
+        const auto name = "ravennakit_test_" + std::to_string(rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+        std::shared_ptr buffer = rav::rtp::SharedAudioBuffer::create(name, audio_format, 480);
+        REQUIRE(buffer != nullptr);
+        std::shared_ptr small_buffer = rav::rtp::SharedAudioBuffer::create(name + "_small", audio_format, 10);
+        REQUIRE(small_buffer != nullptr);
+
+        REQUIRE_FALSE(sender.set_shared_buffer(rav::Id(2), buffer));
+        REQUIRE_FALSE(sender.set_shared_buffer(id, small_buffer));
+        REQUIRE(sender.set_shared_buffer(id, buffer));
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        for (size_t i = 0; i < audio.size(); ++i) {
+            audio[i] = static_cast<uint8_t>(i);
+        }
+        const rav::BufferView<const uint8_t> audio_view(audio.data(), audio.size());
+
+        // The audio thread can't feed the writer anymore
+        REQUIRE_FALSE(sender.send_data_realtime(id, audio_view, 0));
+
+        // Another process writes into the buffer, the packets start at the frames written after the first poll
+        auto client = rav::rtp::SharedAudioBuffer::open(name);
+        REQUIRE(client != nullptr);
+        client->write(0, audio_view);
+        sender.send_outgoing_packets();
+        REQUIRE(receive_all(rx).empty());
+
+        client->write(k_packet_time_frames, audio_view);
+        client->write(2 * k_packet_time_frames, audio_view);
+        sender.send_outgoing_packets();
+
+        std::array<uint8_t, rav::aes67::constants::k_mtu> packet {};
+        rav::udp_endpoint sender_endpoint;
+        auto size = rx.receive_from(boost::asio::buffer(packet), sender_endpoint);
+        const rav::rtp::PacketView view(packet.data(), size);
+        REQUIRE(view.validate());
+        REQUIRE(view.timestamp() == k_packet_time_frames);
+        REQUIRE(view.payload_type() == 98);
+        const auto payload = view.payload_data();
+        REQUIRE(std::equal(payload.data(), payload.data() + payload.size(), audio.begin(), audio.end()));
+
+        auto received = receive_all(rx);
+        REQUIRE(received.size() == 1);
+        REQUIRE(received[0].timestamp == 2 * k_packet_time_frames);
+        REQUIRE(received[0].sequence_number == static_cast<uint16_t>(view.sequence_number() + 1));
+
+        // A jump of the timestamps restarts the packets at the frames written next
+        client->write(10'000, audio_view);
+        sender.send_outgoing_packets();
+        REQUIRE(receive_all(rx).empty());
+        client->write(10'000 + k_packet_time_frames, audio_view);
+        sender.send_outgoing_packets();
+        received = receive_all(rx);
+        REQUIRE(received.size() == 1);
+        REQUIRE(received[0].timestamp == 10'000 + k_packet_time_frames);
+
+        // Feeding from the audio thread again
+        REQUIRE(sender.set_shared_buffer(id, nullptr));
+        REQUIRE(sender.send_data_realtime(id, audio_view, 0));
+        REQUIRE(sender.send_data_realtime(id, audio_view, k_packet_time_frames));
+        sender.send_outgoing_packets();
+        received = receive_all(rx);
+        REQUIRE(received.size() == 1);
+        REQUIRE(received[0].timestamp == 0);
+    }
+
+    SECTION("Cost accounting") {
+        const auto loopback = boost::asio::ip::address_v4::loopback();
+        rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+
+        rav::rtp::AudioSender sender(io_context);
+
+        rav::rtp::AudioSender::WriterParameters parameters;
+        parameters.audio_format = audio_format;
+        parameters.destinations[0] = rav::udp_endpoint(loopback, rx.local_endpoint().port());
+        parameters.packet_time_frames = k_packet_time_frames;
+        parameters.payload_type = 98;
+
+        const auto id = rav::Id(1);
+        REQUIRE(sender.add_writer(id, parameters, {}));
+
+        rav::Defer remove_writer([&] {
+            REQUIRE(sender.remove_writer(id));
+        });
+
+        REQUIRE_FALSE(sender.get_writer_cost(rav::Id(2)).has_value());
+
+        auto cost = sender.get_writer_cost(id);
+        REQUIRE(cost.has_value());
+        REQUIRE(cost->schedule.count == 0);
+        REQUIRE(cost->send.count == 0);
+
+        // Polling without packets is not accounted
+        sender.send_outgoing_packets();
+        REQUIRE(sender.get_writer_cost(id)->send.count == 0);
+
+        std::vector<uint8_t> audio(k_packet_time_frames * audio_format.bytes_per_frame());
+        const rav::BufferView<const uint8_t> audio_view(audio.data(), audio.size());
+        REQUIRE(sender.send_data_realtime(id, audio_view, 0));
+        REQUIRE(sender.send_data_realtime(id, audio_view, k_packet_time_frames));
+        sender.send_outgoing_packets();
+        REQUIRE(receive_all(rx).size() == 1);
+
+        cost = sender.get_writer_cost(id);
+        REQUIRE(cost->schedule.count == 2);
+        REQUIRE(cost->send.count == 1);
+        REQUIRE(cost->send.max_ns > 0);
+
+        rav::metrics::PrometheusWriter writer;
+        sender.collect_metrics(writer);
+        REQUIRE(writer.to_string().find("rav_rtp_writer_send_cost_us_count{writer=\"1\"} 1") != std::string::npos);
+    }
+}
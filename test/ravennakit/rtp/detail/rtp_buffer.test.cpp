@@ -138,4 +138,53 @@ TEST_CASE("rav::rtp::Ringbuffer") {
         buffer.read(2, output.data(), output.size(), true);
         REQUIRE(output == std::array<uint8_t, 8> {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0});
     }
+
+    SECTION("Read received data") {
+        rav::rtp::Ringbuffer buffer;
+        buffer.resize(4, 2);
+        REQUIRE(buffer.get_capacity_frames() == 4);
+
+        std::array<const uint8_t, 8> input = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8};
+        std::array<uint8_t, 8> output = {};
+
+        buffer.write(2, rav::BufferView(input.data(), input.size()));
+        buffer.read_received(2, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8});
+
+        // The data is not cleared by reading
+        buffer.read_received(2, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8});
+
+        // Frames which were not written yet read as the ground value
+        buffer.read_received(4, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {0x5, 0x6, 0x7, 0x8, 0x0, 0x0, 0x0, 0x0});
+        buffer.read_received(0, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {0x0, 0x0, 0x0, 0x0, 0x1, 0x2, 0x3, 0x4});
+
+        // As do frames which were overwritten
+        std::array<const uint8_t, 4> next = {0x9, 0xa, 0xb, 0xc};
+        buffer.write(6, rav::BufferView(next.data(), next.size()));
+        buffer.read_received(2, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {0x0, 0x0, 0x0, 0x0, 0x5, 0x6, 0x7, 0x8});
+        buffer.read_received(20, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 8> {});
+
+        buffer.release();
+        REQUIRE(buffer.get_capacity_frames() == 0);
+    }
+
+    SECTION("Write byte swapped with wraparound") {
+        rav::rtp::Ringbuffer buffer;
+        buffer.resize(4, 4);
+
+        std::array<const uint8_t, 12> input = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb, 0xc};
+        std::array<uint8_t, 12> output = {};
+
+        const rav::BufferView buffer_view(input.data(), input.size());
+        buffer.write_byte_swapped(2, buffer_view, 2);
+        REQUIRE(buffer.get_next_ts().value() == 5);
+
+        buffer.read(2, output.data(), output.size());
+        REQUIRE(output == std::array<uint8_t, 12> {0x2, 0x1, 0x4, 0x3, 0x6, 0x5, 0x8, 0x7, 0xa, 0x9, 0xc, 0xb});
+    }
 }
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_io_uring.hpp"
+#include "ravennakit/aes67/aes67_constants.hpp"
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/net/sockets/extended_udp_socket.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+#if RAV_ENABLE_IO_URING
+
+namespace {
+
+/// Calls fn until it returns true or a second has passed.
+template<class Fn>
+[[nodiscard]] bool wait_for(Fn&& fn) {
+    const auto deadline = rav::clock::now_monotonic_high_resolution_ns() + 1'000'000'000;
+    while (rav::clock::now_monotonic_high_resolution_ns() < deadline) {
+        if (fn()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("rav::rtp::IoUringReceiveRing") {
+    auto ring = rav::rtp::IoUringReceiveRing::create({});
+    if (ring == nullptr) {
+        WARN("io_uring is not supported by this kernel");
+        return;
+    }
+
+    boost::asio::io_context io_context;
+    const auto loopback = boost::asio::ip::address_v4::loopback();
+
+    rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+    rx.set_option(boost::asio::detail::socket_option::integer<IPPROTO_IP, IP_RECVDSTADDR_PKTINFO>(1));
+    const auto rx_port = rx.local_endpoint().port();
+
+    rav::udp_socket tx(io_context, rav::udp_endpoint(loopback, 0));
+
+    ring->arm(0, 1, rx.native_handle(), rx_port);
+
+    std::array<rav::rtp::IoUringReceiveRing::Packet, 8> packets;
+    REQUIRE(ring->receive(packets.data(), packets.size()) == 0);
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        const std::array<uint8_t, 4> data {i, 2, 3, 4};
+        tx.send_to(boost::asio::buffer(data), rav::udp_endpoint(loopback, rx_port));
+    }
+
+    std::vector<std::vector<uint8_t>> received;
+    REQUIRE(wait_for([&] {
+        const auto num_packets = ring->receive(packets.data(), packets.size());
+        for (size_t i = 0; i < num_packets; ++i) {
+            REQUIRE(packets[i].src_endpoint == tx.local_endpoint());
+            REQUIRE(packets[i].dst_endpoint == rav::udp_endpoint(loopback, rx_port));
+            received.emplace_back(packets[i].data, packets[i].data + packets[i].size);
+        }
+        return received.size() == 3;
+    }));
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        REQUIRE(received[i] == std::vector<uint8_t> {i, 2, 3, 4});
+    }
+
+    SECTION("Nothing is received after disarming") {
+        ring->disarm(0);
+        REQUIRE(ring->receive(packets.data(), packets.size()) == 0);
+
+        tx.send_to(boost::asio::buffer(std::array<uint8_t, 4> {}), rav::udp_endpoint(loopback, rx_port));
+        REQUIRE_FALSE(wait_for([&] {
+            return ring->receive(packets.data(), packets.size()) > 0;
+        }));
+        REQUIRE(rx.available() == 4);  // The datagram is left in the socket
+    }
+
+    SECTION("Datagrams bigger than the MTU are dropped") {
+        const std::vector<uint8_t> jumbo(rav::aes67::constants::k_mtu + 1, 1);
+        tx.send_to(boost::asio::buffer(jumbo), rav::udp_endpoint(loopback, rx_port));
+        tx.send_to(boost::asio::buffer(std::array<uint8_t, 4> {5, 6, 7, 8}), rav::udp_endpoint(loopback, rx_port));
+
+        received.clear();
+        REQUIRE(wait_for([&] {
+            const auto num_packets = ring->receive(packets.data(), packets.size());
+            for (size_t i = 0; i < num_packets; ++i) {
+                received.emplace_back(packets[i].data, packets[i].data + packets[i].size);
+            }
+            return !received.empty();
+        }));
+        REQUIRE(received.size() == 1);
+        REQUIRE(received[0] == std::vector<uint8_t> {5, 6, 7, 8});
+    }
+}
+
+TEST_CASE("rav::rtp::IoUringSendRing") {
+    auto ring = rav::rtp::IoUringSendRing::create({});
+    if (ring == nullptr) {
+        WARN("io_uring is not supported by this kernel");
+        return;
+    }
+
+    boost::asio::io_context io_context;
+    const auto loopback = boost::asio::ip::address_v4::loopback();
+
+    rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+    rav::udp_socket tx(io_context, rav::udp_endpoint(loopback, 0));
+
+    const std::array<uint8_t, 4> data {1, 2, 3, 4};
+    for (uint64_t tag = 0; tag < 3; ++tag) {
+        REQUIRE(ring->send(tx.native_handle(), data.data(), data.size(), rx.local_endpoint(), tag));
+    }
+
+    SECTION("Too big datagrams are rejected") {
+        std::vector<uint8_t> big(rav::rtp::IoUringSendRing::k_buffer_size + 1);
+        REQUIRE_FALSE(ring->send(tx.native_handle(), big.data(), big.size(), rx.local_endpoint(), 3));
+    }
+
+    ring->submit();
+
+    std::vector<rav::rtp::IoUringSendRing::Completion> completed;
+    std::array<rav::rtp::IoUringSendRing::Completion, 8> completions;
+    REQUIRE(wait_for([&] {
+        const auto num_completions = ring->complete(completions.data(), completions.size());
+        completed.insert(completed.end(), completions.begin(), completions.begin() + static_cast<std::ptrdiff_t>(num_completions));
+        return completed.size() == 3;
+    }));
+
+    for (uint64_t tag = 0; tag < 3; ++tag) {
+        REQUIRE(completed[tag].tag == tag);
+        REQUIRE(completed[tag].result == 4);
+    }
+
+    std::array<uint8_t, 16> buffer {};
+    for (size_t i = 0; i < 3; ++i) {
+        REQUIRE(rx.receive(boost::asio::buffer(buffer)) == 4);
+        REQUIRE(std::equal(data.begin(), data.end(), buffer.begin()));
+    }
+}
+
+#else
+
+TEST_CASE("rav::rtp::IoUringReceiveRing") {
+    REQUIRE(rav::rtp::IoUringReceiveRing::create({}) == nullptr);
+    REQUIRE(rav::rtp::IoUringSendRing::create({}) == nullptr);
+}
+
+#endif
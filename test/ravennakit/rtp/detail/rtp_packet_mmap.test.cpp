@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/detail/rtp_packet_mmap.hpp"
+#include "ravennakit/aes67/aes67_constants.hpp"
+#include "ravennakit/core/clock.hpp"
+#include "ravennakit/core/platform.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+#if RAV_LINUX
+
+namespace {
+
+/// Calls fn until it returns true or the timeout has passed.
+template<class Fn>
+[[nodiscard]] bool wait_for(Fn&& fn, const uint64_t timeout_ms = 1000) {
+    const auto deadline = rav::clock::now_monotonic_high_resolution_ns() + timeout_ms * 1'000'000;
+    while (rav::clock::now_monotonic_high_resolution_ns() < deadline) {
+        if (fn()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("rav::rtp::PacketMmapReceiveRing") {
+    const auto loopback = boost::asio::ip::address_v4::loopback();
+
+    auto ring = rav::rtp::PacketMmapReceiveRing::create(loopback, {});
+    if (ring == nullptr) {
+        WARN("AF_PACKET is not available, which requires CAP_NET_RAW");
+        return;
+    }
+
+    boost::asio::io_context io_context;
+    rav::udp_socket rx(io_context, rav::udp_endpoint(loopback, 0));
+    rav::udp_socket other(io_context, rav::udp_endpoint(loopback, 0));
+    rav::udp_socket tx(io_context, rav::udp_endpoint(loopback, 0));
+    REQUIRE(rav::rtp::attach_drop_all_filter(rx));
+
+    const auto rx_endpoint = rx.local_endpoint();
+    const auto other_endpoint = other.local_endpoint();
+
+    std::array<rav::rtp::PacketMmapReceiveRing::Packet, 8> packets;
+    std::vector<std::vector<uint8_t>> received;
+    const auto receive_all = [&] {
+        const auto num_packets = ring->receive(packets.data(), packets.size());
+        for (size_t i = 0; i < num_packets; ++i) {
+            REQUIRE(packets[i].src_endpoint == tx.local_endpoint());
+            REQUIRE(packets[i].dst_endpoint == rx_endpoint);
+            REQUIRE(packets[i].recv_time <= rav::clock::now_monotonic_high_resolution_ns());
+            received.emplace_back(packets[i].data, packets[i].data + packets[i].size);
+        }
+        return false;
+    };
+
+    SECTION("Nothing is received before the destinations are set") {
+        tx.send_to(boost::asio::buffer(std::array<uint8_t, 4> {}), rx_endpoint);
+        REQUIRE_FALSE(wait_for(receive_all, 50));
+        REQUIRE(received.empty());
+    }
+
+    SECTION("Only datagrams to the destinations are received") {
+        REQUIRE(ring->set_destinations({rx_endpoint}));
+
+        for (uint8_t i = 0; i < 3; ++i) {
+            const std::array<uint8_t, 4> data {i, 2, 3, 4};
+            tx.send_to(boost::asio::buffer(data), rx_endpoint);
+            tx.send_to(boost::asio::buffer(data), other_endpoint);
+        }
+
+        REQUIRE(wait_for([&] {
+            std::ignore = receive_all();
+            return received.size() >= 3;
+        }));
+        REQUIRE_FALSE(wait_for(receive_all, 50));
+
+        REQUIRE(received.size() == 3);
+        for (uint8_t i = 0; i < 3; ++i) {
+            REQUIRE(received[i] == std::vector<uint8_t> {i, 2, 3, 4});
+        }
+
+        REQUIRE(rx.available() == 0);  // Dropped by the filter
+        REQUIRE(other.available() > 0);
+    }
+
+    SECTION("Datagrams bigger than the MTU are dropped") {
+        REQUIRE(ring->set_destinations({rx_endpoint}));
+
+        const std::vector<uint8_t> jumbo(rav::aes67::constants::k_mtu + 1, 1);
+        tx.send_to(boost::asio::buffer(jumbo), rx_endpoint);
+        tx.send_to(boost::asio::buffer(std::array<uint8_t, 4> {1, 2, 3, 4}), rx_endpoint);
+
+        REQUIRE(wait_for([&] {
+            std::ignore = receive_all();
+            return !received.empty();
+        }));
+        REQUIRE_FALSE(wait_for(receive_all, 50));
+        REQUIRE(received.size() == 1);
+        REQUIRE(received[0] == std::vector<uint8_t> {1, 2, 3, 4});
+    }
+
+    SECTION("Many destinations") {
+        std::vector<rav::udp_endpoint> destinations;
+        for (uint16_t port = 1; port <= 300; ++port) {
+            destinations.emplace_back(boost::asio::ip::make_address_v4("239.1.2.3"), port);
+            destinations.emplace_back(boost::asio::ip::make_address_v4("239.1.2.4"), port);
+        }
+        destinations.push_back(rx_endpoint);
+        REQUIRE(ring->set_destinations(destinations));
+
+        tx.send_to(boost::asio::buffer(std::array<uint8_t, 4> {1, 2, 3, 4}), rx_endpoint);
+        REQUIRE(wait_for([&] {
+            std::ignore = receive_all();
+            return received.size() == 1;
+        }));
+    }
+}
+
+#else
+
+TEST_CASE("rav::rtp::PacketMmapReceiveRing") {
+    REQUIRE(rav::rtp::PacketMmapReceiveRing::create({}, {}) == nullptr);
+}
+
+#endif
@@ -81,4 +81,24 @@ TEST_CASE("rav::rtp::Packet") {
             REQUIRE(stream.exhausted());
         }
     }
+
+    SECTION("Encode an RTP packet into memory") {
+        rav::rtp::Packet packet;
+        packet.payload_type(0xff);
+        packet.sequence_number(0x0012);
+        packet.set_timestamp(0x00003456);
+        packet.ssrc(0x0000789a);
+
+        const std::vector<uint8_t> payload = {0x01, 0x02, 0x03, 0x04, 0x05};
+
+        rav::ByteBuffer expected;
+        packet.encode(payload.data(), payload.size(), expected);
+
+        std::array<uint8_t, 17> buffer {};
+        REQUIRE(packet.encode(payload.data(), payload.size(), buffer.data(), buffer.size()) == 17);
+        REQUIRE(std::memcmp(buffer.data(), expected.data(), expected.size()) == 0);
+
+        // The packet doesn't fit
+        REQUIRE(packet.encode(payload.data(), payload.size(), buffer.data(), buffer.size() - 1) == 0);
+    }
 }
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/rtp/rtp_shared_audio_buffer.hpp"
+#include "ravennakit/core/random.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+namespace {
+
+std::string get_unique_name() {
+    return "ravennakit_test_" + std::to_string(rav::Random().get_random_int(0, std::numeric_limits<int>::max()));
+}
+
+rav::AudioFormat get_test_format() {
+    return {rav::AudioFormat::ByteOrder::be, rav::AudioEncoding::pcm_s16, rav::AudioFormat::ChannelOrdering::interleaved, 48000, 1};
+}
+
+/// Writes frames of which both bytes hold the low byte of the timestamp of the frame.
+void write_frames(rav::rtp::SharedAudioBuffer& buffer, const uint32_t timestamp, const uint32_t num_frames) {
+    std::vector<uint8_t> data(num_frames * 2);
+    for (uint32_t i = 0; i < num_frames; ++i) {
+        data[i * 2] = static_cast<uint8_t>(timestamp + i);
+        data[i * 2 + 1] = static_cast<uint8_t>(timestamp + i);
+    }
+    buffer.write(timestamp, rav::BufferView(data.data(), data.size()).const_view());
+}
+
+}  // namespace
+
+TEST_CASE("rav::rtp::SharedAudioBuffer") {
+    SECTION("Invalid arguments") {
+        REQUIRE(rav::rtp::SharedAudioBuffer::create(get_unique_name(), {}, 8) == nullptr);
+        REQUIRE(rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 0) == nullptr);
+        REQUIRE(rav::rtp::SharedAudioBuffer::open(get_unique_name()) == nullptr);
+    }
+
+    SECTION("Open a shared memory which doesn't contain a buffer") {
+        const auto name = get_unique_name();
+        auto memory = rav::SharedMemory::create(name, 4096);
+        REQUIRE(memory != nullptr);
+        REQUIRE(rav::rtp::SharedAudioBuffer::open(name) == nullptr);
+    }
+
+    SECTION("Create and open") {
+        const auto name = get_unique_name();
+        auto buffer = rav::rtp::SharedAudioBuffer::create(name, get_test_format(), 8);
+        REQUIRE(buffer != nullptr);
+        REQUIRE(buffer->get_name() == name);
+        REQUIRE(buffer->get_capacity_frames() == 8);
+        REQUIRE(buffer->get_audio_format() == get_test_format());
+        REQUIRE_FALSE(buffer->get_write_position().has_value());
+
+        auto client = rav::rtp::SharedAudioBuffer::open(name);
+        REQUIRE(client != nullptr);
+        REQUIRE(client->get_capacity_frames() == 8);
+        REQUIRE(client->get_audio_format() == get_test_format());
+        REQUIRE_FALSE(client->get_write_position().has_value());
+    }
+
+    SECTION("Write and read") {
+        auto buffer = rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 8);
+        REQUIRE(buffer != nullptr);
+        auto client = rav::rtp::SharedAudioBuffer::open(buffer->get_name());
+        REQUIRE(client != nullptr);
+
+        write_frames(*buffer, 100, 4);
+        const auto position = client->get_write_position();
+        REQUIRE(position.has_value());
+        REQUIRE(position->generation == 1);
+        REQUIRE(position->end_timestamp == 104);
+        REQUIRE(client->get_write_time_ns() > 0);
+
+        std::array<uint8_t, 4> output {};
+        REQUIRE(client->read(102, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 4> {102, 102, 103, 103});
+
+        // Not written yet
+        REQUIRE_FALSE(client->read(103, output.data(), output.size()));
+
+        // Wraps around the end of the buffer
+        write_frames(*buffer, 104, 4);
+        write_frames(*buffer, 108, 2);
+        REQUIRE(client->get_write_position()->end_timestamp == 110);
+        REQUIRE(client->read(103, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 4> {103, 103, 104, 104});
+        REQUIRE(client->read(108, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 4> {108, 108, 109, 109});
+
+        // Older than the capacity
+        REQUIRE_FALSE(client->read(101, output.data(), output.size()));
+        REQUIRE(client->read(102, output.data(), output.size()));
+    }
+
+    SECTION("Frames which were skipped are cleared") {
+        auto buffer = rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 8);
+        REQUIRE(buffer != nullptr);
+
+        write_frames(*buffer, 0, 8);
+        write_frames(*buffer, 10, 2);
+        REQUIRE(buffer->get_write_position()->end_timestamp == 12);
+
+        std::array<uint8_t, 8> output {};
+        REQUIRE(buffer->read(7, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 8> {7, 7, 0, 0, 0, 0, 10, 10});
+
+        // A late packet fills the gap without moving the position
+        write_frames(*buffer, 8, 2);
+        REQUIRE(buffer->get_write_position()->end_timestamp == 12);
+        REQUIRE(buffer->read(7, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 8> {7, 7, 8, 8, 9, 9, 10, 10});
+    }
+
+    SECTION("A jump of the timestamps starts a new generation") {
+        auto buffer = rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 8);
+        REQUIRE(buffer != nullptr);
+
+        write_frames(*buffer, 100, 4);
+        auto region = buffer->get_readable_region(100, 4);
+        REQUIRE(region.has_value());
+        REQUIRE(region->generation == 1);
+
+        write_frames(*buffer, 50, 2);
+        const auto position = buffer->get_write_position();
+        REQUIRE(position->generation == 2);
+        REQUIRE(position->end_timestamp == 52);
+        REQUIRE_FALSE(buffer->is_valid(100, 1));
+
+        std::array<uint8_t, 4> output {};
+        REQUIRE_FALSE(buffer->read(100, output.data(), output.size()));
+        REQUIRE(buffer->read(50, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 4> {50, 50, 51, 51});
+
+        // The data of the previous generation was cleared
+        REQUIRE(buffer->read(46, output.data(), output.size()));
+        REQUIRE(output == std::array<uint8_t, 4> {});
+    }
+
+    SECTION("Zero copy access") {
+        auto buffer = rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 8);
+        REQUIRE(buffer != nullptr);
+        auto client = rav::rtp::SharedAudioBuffer::open(buffer->get_name());
+        REQUIRE(client != nullptr);
+
+        auto write_region = buffer->prepare_write(6, 4);
+        REQUIRE(write_region.part1.size() == 4);
+        REQUIRE(write_region.part2.size() == 4);
+        std::fill_n(write_region.part1.data(), 4, 0x11);
+        std::fill_n(write_region.part2.data(), 4, 0x22);
+
+        REQUIRE_FALSE(client->get_readable_region(6, 4).has_value());  // Not committed yet
+        buffer->commit_write();
+
+        const auto region = client->get_readable_region(6, 4);
+        REQUIRE(region.has_value());
+        REQUIRE(region->part1.size() == 4);
+        REQUIRE(region->part2.size() == 4);
+        REQUIRE(region->part1[0] == 0x11);
+        REQUIRE(region->part2[3] == 0x22);
+        REQUIRE(client->is_valid(6, region->generation));
+
+        // Claiming the region for writing invalidates it for the reader, even before the write is committed
+        std::ignore = buffer->prepare_write(10, 6);
+        REQUIRE(client->get_readable_region(6, 4).has_value());
+        REQUIRE_FALSE(client->is_valid(6, region->generation));
+        buffer->commit_write();
+        REQUIRE_FALSE(client->get_readable_region(6, 4).has_value());
+        REQUIRE(client->get_readable_region(8, 4).has_value());
+    }
+
+    SECTION("Concurrent writer and reader") {
+        auto buffer = rav::rtp::SharedAudioBuffer::create(get_unique_name(), get_test_format(), 64);
+        REQUIRE(buffer != nullptr);
+        auto client = rav::rtp::SharedAudioBuffer::open(buffer->get_name());
+        REQUIRE(client != nullptr);
+
+        constexpr uint32_t k_num_frames = 200'000;
+        std::thread writer([&buffer] {
+            for (uint32_t ts = 0; ts < k_num_frames; ts += 16) {
+                write_frames(*buffer, ts, 16);
+            }
+        });
+
+        // Every successful read must be consistent, reads of frames which are being overwritten must fail
+        size_t num_reads = 0;
+        std::array<uint8_t, 32> output {};
+        while (true) {
+            const auto position = client->get_write_position();
+            if (!position) {
+                continue;
+            }
+            const auto ts = position->end_timestamp - 48;
+            if (client->read(ts, output.data(), output.size())) {
+                for (uint32_t i = 0; i < 16; ++i) {
+                    REQUIRE(output[i * 2] == static_cast<uint8_t>(ts + i));
+                }
+                num_reads++;
+            }
+            if (position->end_timestamp >= k_num_frames) {
+                break;
+            }
+        }
+        writer.join();
+        REQUIRE(num_reads > 0);
+    }
+}
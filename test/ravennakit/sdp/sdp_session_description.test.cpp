@@ -23,18 +23,32 @@
  */
 
 #include "ravennakit/sdp/sdp_session_description.hpp"
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
 
 #include <catch2/catch_all.hpp>
 
 #include "ravennakit/core/util.hpp"
 
 TEST_CASE("rav::sdp::SessionDescription") {
+    // Every test runs against both the owning and the view entry point of the parser
+    const auto through_view = GENERATE(false, true);
+    const auto parse = [through_view](const std::string& text) -> tl::expected<rav::sdp::SessionDescription, std::string> {
+        if (!through_view) {
+            return rav::sdp::parse_session_description(text);
+        }
+        auto view = rav::sdp::parse_session_description_view(text);
+        if (!view) {
+            return tl::unexpected(view.error());
+        }
+        return rav::sdp::to_session_description(*view);
+    };
+
     SECTION("Test crlf delimited string") {
         constexpr auto crlf =
             "v=0\r\n"
             "o=- 13 0 IN IP4 192.168.15.52\r\n"
             "s=Anubis_610120_13\r\n";
-        auto result = rav::sdp::parse_session_description(crlf);
+        auto result = parse(crlf);
         REQUIRE(result);
         REQUIRE(result->version == 0);
     }
@@ -44,14 +58,14 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "v=0\n"
             "o=- 13 0 IN IP4 192.168.15.52\n"
             "s=Anubis_610120_13\n";
-        auto result = rav::sdp::parse_session_description(n);
+        auto result = parse(n);
         REQUIRE(result);
         REQUIRE(result->version == 0);
     }
 
     SECTION("Test string without newline") {
         constexpr auto str = "bbb";
-        auto result = rav::sdp::parse_session_description(str);
+        auto result = parse(str);
         REQUIRE_FALSE(result);
     }
 
@@ -79,7 +93,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=recvonly\r\n"
             "a=midi-pre2:50040 0,0;0,1\r\n";
 
-        auto result = rav::sdp::parse_session_description(k_anubis_sdp);
+        auto result = parse(k_anubis_sdp);
         REQUIRE(result);
 
         SECTION("Parse a description from an Anubis") {
@@ -91,7 +105,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
                 "v=1\r\n"
                 "o=- 13 0 IN IP4 192.168.15.52\r\n"
                 "s=Anubis_610120_13\r\n";
-            REQUIRE_FALSE(rav::sdp::parse_session_description(sdp));
+            REQUIRE_FALSE(parse(sdp));
         }
 
         SECTION("Test origin") {
@@ -234,7 +248,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=ts-refclk:ptp=IEEE1588-2008:39-A7-94-FF-FE-07-CB-D0:0\n"
             "a=mediaclk:direct=963214424\n";
 
-        auto result = rav::sdp::parse_session_description(k_aes67_sdp);
+        auto result = parse(k_aes67_sdp);
         REQUIRE(result);
         auto session = *result;
         REQUIRE(session.version == 0);
@@ -295,7 +309,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=ts-refclk:ptp=IEEE1588-2008:39-A7-94-FF-FE-07-CB-D0:0\n"
             "a=mediaclk:direct=2216659908\n";
 
-        auto result = rav::sdp::parse_session_description(k_aes67_sdp);
+        auto result = parse(k_aes67_sdp);
         if (!result) {
             FAIL(result.error());
         }
@@ -368,7 +382,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=recvonly\r\n"
             "a=midi-pre2:50040 0,0;0,1\r\n";
 
-        auto result = rav::sdp::parse_session_description(k_anubis_sdp);
+        auto result = parse(k_anubis_sdp);
         REQUIRE(result);
 
         SECTION("Session level source filter") {
@@ -431,7 +445,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=recvonly\r\n"
             "a=midi-pre2:50040 0,0;0,1\r\n";
 
-        auto result = rav::sdp::parse_session_description(k_anubis_sdp);
+        auto result = parse(k_anubis_sdp);
         REQUIRE(result);
 
         SECTION("Unknown attributes on session") {
@@ -769,7 +783,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=recvonly\r\n"
             "a=midi-pre2:50040 0,0;0,1\r\n";
 
-        auto result = rav::sdp::parse_session_description(k_anubis_sdp);
+        auto result = parse(k_anubis_sdp);
         REQUIRE(result);
 
         // Slightly different order
@@ -834,7 +848,7 @@ TEST_CASE("rav::sdp::SessionDescription") {
             "a=ts-refclk:ptp=IEEE1588-2008:00-0B-72-FF-FE-07-DC-FC:0\r\n"
             "a=mediaclk:direct=0\r\n";
 
-        auto result = rav::sdp::parse_session_description(k_mic8_sdp);
+        auto result = parse(k_mic8_sdp);
         REQUIRE(result);
 
         SECTION("Test origin") {
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Project: RAVENNAKIT (RAVENNA / AES67 / ST2110-30 SDK)
+ * Copyright (c) 2024-2025 Sound on Digital
+ *
+ * This file is part of RAVENNAKIT.
+ *
+ * RAVENNAKIT is dual-licensed:
+ *   1) Under the terms of the GNU Affero General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version (the "AGPL License"); and
+ *   2) Under a commercial license from Sound on Digital, for customers who
+ *      cannot (or do not wish to) comply with the AGPL License terms.
+ *
+ * If you obtained this file under the AGPL License, you may redistribute it
+ * and/or modify it under the terms of the AGPL License. See the LICENSE
+ * file in the project root for details.
+ *
+ * For commercial licensing, support, and other inquiries, please visit:
+ *
+ *     https://ravennakit.com
+ *
+ */
+
+#include "ravennakit/sdp/sdp_session_description_view.hpp"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+constexpr auto k_anubis_sdp =
+    "v=0\r\n"
+    "o=- 13 0 IN IP4 192.168.15.52\r\n"
+    "s=Anubis_610120_13\r\n"
+    "c=IN IP4 239.1.15.52/15\r\n"
+    "t=0 0\r\n"
+    "a=clock-domain:PTPv2 0\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-51-9E-F7:0\r\n"
+    "a=mediaclk:direct=0\r\n"
+    "m=audio 5004 RTP/AVP 98\r\n"
+    "c=IN IP4 239.1.15.52/15\r\n"
+    "a=rtpmap:98 L16/48000/2\r\n"
+    "a=source-filter: incl IN IP4 239.1.15.52 192.168.15.52\r\n"
+    "a=clock-domain:PTPv2 0\r\n"
+    "a=sync-time:0\r\n"
+    "a=framecount:48\r\n"
+    "a=palign:0\r\n"
+    "a=ptime:1\r\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-51-9E-F7:0\r\n"
+    "a=mediaclk:direct=0\r\n"
+    "a=recvonly\r\n"
+    "a=midi-pre2:50040 0,0;0,1\r\n";
+
+constexpr auto k_aes67_sdp =
+    "v=0\n"
+    "o=- 1311738121 1311738121 IN IP4 192.168.1.1\n"
+    "s=Stage left I/O\n"
+    "c=IN IP4 239.0.0.1/32\n"
+    "t=0 0\n"
+    "m=audio 5004 RTP/AVP 96\n"
+    "i=Channels 1-8\n"
+    "a=rtpmap:96 L24/48000/8\n"
+    "a=recvonly\n"
+    "a=ptime:0.125\n"
+    "a=ts-refclk:ptp=IEEE1588-2008:39-A7-94-FF-FE-07-CB-D0:0\n"
+    "a=mediaclk:direct=963214424\n";
+
+}  // namespace
+
+TEST_CASE("rav::sdp::SessionDescriptionView") {
+    SECTION("Description from Anubis") {
+        auto result = rav::sdp::parse_session_description_view(k_anubis_sdp);
+        REQUIRE(result);
+
+        REQUIRE(result->version == 0);
+        REQUIRE(result->session_name == "Anubis_610120_13");
+        REQUIRE(result->origin.session_id == "13");
+        REQUIRE(result->origin.unicast_address.text == "192.168.15.52");
+        REQUIRE(result->origin.unicast_address.address == boost::asio::ip::make_address("192.168.15.52"));
+        REQUIRE(result->connection_info.has_value());
+        REQUIRE(result->connection_info->address.address == boost::asio::ip::make_address("239.1.15.52"));
+        REQUIRE(result->connection_info->ttl == 15);
+        REQUIRE(result->ravenna_clock_domain.has_value());
+        REQUIRE(result->reference_clock.has_value());
+        REQUIRE(result->reference_clock->gmid == "00-1D-C1-FF-FE-51-9E-F7");
+        REQUIRE(result->reference_clock->domain == 0);
+
+        REQUIRE(result->media_descriptions.size() == 1);
+        const auto& media = result->media_descriptions[0];
+        REQUIRE(media.media_type == "audio");
+        REQUIRE(media.port == 5004);
+        REQUIRE(media.protocol == "RTP/AVP");
+        REQUIRE(media.formats.size() == 1);
+        REQUIRE(media.formats[0].payload_type == 98);
+        REQUIRE(media.formats[0].encoding_name == "L16");
+        REQUIRE(media.formats[0].clock_rate == 48000);
+        REQUIRE(media.formats[0].num_channels == 2);
+        REQUIRE(media.connection_infos.size() == 1);
+        REQUIRE(media.ptime == 1.f);
+        REQUIRE(media.ravenna_framecount == 48);
+        REQUIRE(media.ravenna_sync_time == 0);
+        REQUIRE(media.media_direction == rav::sdp::MediaDirection::recvonly);
+        REQUIRE(media.source_filters.size() == 1);
+        REQUIRE(media.source_filters[0].mode == rav::sdp::FilterMode::include);
+        REQUIRE(media.source_filters[0].dest_address.address == boost::asio::ip::make_address("239.1.15.52"));
+        REQUIRE(media.source_filters[0].src_list.size() == 1);
+        REQUIRE(media.source_filters[0].src_list[0].address == boost::asio::ip::make_address("192.168.15.52"));
+        REQUIRE(media.attributes.size() == 2);
+        REQUIRE(media.attributes[0].key == "palign");
+        REQUIRE(media.attributes[0].value == "0");
+        REQUIRE(media.attributes[1].key == "midi-pre2");
+        REQUIRE(media.attributes[1].value == "50040 0,0;0,1");
+    }
+
+    SECTION("Description from AES67 spec") {
+        auto result = rav::sdp::parse_session_description_view(k_aes67_sdp);
+        REQUIRE(result);
+        REQUIRE(result->media_descriptions.size() == 1);
+        const auto& media = result->media_descriptions[0];
+        REQUIRE(media.session_information == "Channels 1-8");
+        REQUIRE(media.ptime == 0.125f);
+        REQUIRE(media.reference_clock.has_value());
+        REQUIRE(media.reference_clock->ptp_version == rav::sdp::ReferenceClock::PtpVersion::IEEE_1588_2008);
+        REQUIRE(media.media_clock.has_value());
+        REQUIRE(media.media_clock->offset == 963214424);
+    }
+
+    SECTION("Views point into the original text") {
+        const std::string text = k_anubis_sdp;
+        auto result = rav::sdp::parse_session_description_view(text);
+        REQUIRE(result);
+        REQUIRE(result->session_name.data() >= text.data());
+        REQUIRE(result->session_name.data() < text.data() + text.size());
+    }
+
+    SECTION("Invalid input") {
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("bbb"));
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("v=1\r\n"));
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("v=0\r\nm=audio 5004 RTP/AVP 98\r\na=rtpmap:96 L24/48000/2\r\n"));
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("v=0\r\nm=audio 5004 RTP/AVP 98\r\na=ptime:-1\r\n"));
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("v=0\r\nc=IN IP7 239.1.15.52\r\n"));
+        REQUIRE_FALSE(rav::sdp::parse_session_description_view("v=0\r\na=group:LS 1 2\r\n"));
+    }
+}